@@ -39,6 +39,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/timestepping/SimulatorReport.cpp
   opm/simulators/flow/countGlobalCells.cpp
   opm/simulators/flow/KeywordValidation.cpp
+  opm/simulators/flow/partitionCells.cpp
   opm/simulators/flow/SimulatorFullyImplicitBlackoilEbos.cpp
   opm/simulators/flow/ValidationFunctions.cpp
   opm/simulators/linalg/ExtractParallelGridInformationToISTL.cpp
@@ -59,10 +60,17 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/timestepping/SimulatorTimer.cpp
   opm/simulators/timestepping/SimulatorTimerInterface.cpp
   opm/simulators/timestepping/gatherConvergenceReport.cpp
+  opm/simulators/utils/CacheFile.cpp
   opm/simulators/utils/DeferredLogger.cpp
+  opm/simulators/utils/GeometricPartition.cpp
   opm/simulators/utils/gatherDeferredLogger.cpp
+  opm/simulators/utils/MemoryRegistry.cpp
+  opm/simulators/utils/MetricsExporter.cpp
+  opm/simulators/utils/NumaFirstTouch.cpp
   opm/simulators/utils/ParallelFileMerger.cpp
   opm/simulators/utils/ParallelRestart.cpp
+  opm/simulators/utils/PartitionCache.cpp
+  opm/simulators/utils/TimingRegistry.cpp
   opm/simulators/wells/ALQState.cpp
   opm/simulators/wells/BlackoilWellModelGeneric.cpp
   opm/simulators/wells/GasLiftCommon.cpp
@@ -71,8 +79,10 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/wells/GasLiftStage2.cpp
   opm/simulators/wells/GlobalWellInfo.cpp
   opm/simulators/wells/GroupState.cpp
+  opm/simulators/wells/GroupTree.cpp
   opm/simulators/wells/MultisegmentWellEval.cpp
   opm/simulators/wells/MultisegmentWellGeneric.cpp
+  opm/simulators/wells/NetworkPressureSolver.cpp
   opm/simulators/wells/ParallelWellInfo.cpp
   opm/simulators/wells/PerfData.cpp
   opm/simulators/wells/SegmentState.cpp
@@ -95,6 +105,7 @@ list (APPEND MAIN_SOURCE_FILES
 
 if(CUDA_FOUND)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/cuda/cusparseSolverBackend.cu)
+  list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/cuda/cuCPR.cu)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/cuda/cuWellContributions.cu)
 endif()
 if(OPENCL_FOUND)
@@ -105,12 +116,17 @@ if(OPENCL_FOUND)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/opencl/BISAI.cpp)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/opencl/CPR.cpp)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/opencl/opencl.cpp)
+  list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/opencl/OpenclBufferPool.cpp)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/opencl/openclKernels.cpp)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/opencl/OpenclMatrix.cpp)
+  list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/opencl/OpenclSellMatrix.cpp)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/opencl/Preconditioner.cpp)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/opencl/openclSolverBackend.cpp)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/opencl/openclWellContributions.cpp)
 endif()
+if(CUDA_FOUND OR OPENCL_FOUND)
+  list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/CprCreation.cpp)
+endif()
 if(CUDA_FOUND OR OPENCL_FOUND OR HAVE_FPGA OR HAVE_AMGCL)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/WellContributions.cpp)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/Matrix.cpp)
@@ -129,42 +145,62 @@ if(HAVE_AMGCL)
   endif()
 endif()
 if(MPI_FOUND)
-  list(APPEND MAIN_SOURCE_FILES opm/simulators/utils/ParallelEclipseState.cpp
-                                opm/simulators/utils/ParallelSerialization.cpp)
+  list(APPEND MAIN_SOURCE_FILES opm/simulators/utils/DeckCache.cpp
+                                opm/simulators/utils/ParallelEclipseState.cpp
+                                opm/simulators/utils/ParallelSerialization.cpp
+                                opm/simulators/utils/ParallelSolutionWriter.cpp)
 endif()
 
 # originally generated with the command:
 # find tests -name '*.cpp' -a ! -wholename '*/not-unit/*' -printf '\t%p\n' | sort
 list (APPEND TEST_SOURCE_FILES
   tests/test_ALQState.cpp
+  tests/test_aquifercheckpoint.cpp
   tests/test_blackoil_amg.cpp
+  tests/test_blockspmv.cpp
   tests/test_convergencereport.cpp
   tests/test_deferredlogger.cpp
   tests/test_ecl_output.cc
   tests/test_eclinterregflows.cpp
   tests/test_equil.cc
   tests/test_flexiblesolver.cpp
+  tests/test_GeometricPartition.cpp
   tests/test_glift1.cpp
   tests/test_graphcoloring.cpp
   tests/test_GroupState.cpp
+  tests/test_grouptree.cpp
   tests/test_invert.cpp
   tests/test_keyword_validator.cpp
+  tests/test_memoryregistry.cpp
+  tests/test_metricsexporter.cpp
   tests/test_milu.cpp
+  tests/test_msrsb.cpp
+  tests/test_mswelltreelu.cpp
+  tests/test_multirhsbicgstab.cpp
   tests/test_multmatrixtransposed.cpp
+  tests/test_networkpressuresolver.cpp
   tests/test_norne_pvt.cpp
+  tests/test_numafirsttouch.cpp
   tests/test_parallelwellinfo.cpp
+  tests/test_partitionCells.cpp
+  tests/test_PartitionCache.cpp
   tests/test_preconditionerfactory.cpp
   tests/test_relpermdiagnostics.cpp
+  tests/test_residualnormhistory.cpp
+  tests/test_standardwellbatch.cpp
   tests/test_stoppedwells.cpp
+  tests/test_timestepcontrol.cpp
   tests/test_timer.cpp
   tests/test_vfpproperties.cpp
+  tests/test_wellhelpers.cpp
   tests/test_wellmodel.cpp
   tests/test_wellprodindexcalculator.cpp
   tests/test_wellstate.cpp
   )
 
 if(MPI_FOUND)
-  list(APPEND TEST_SOURCE_FILES tests/test_parallelistlinformation.cpp
+  list(APPEND TEST_SOURCE_FILES tests/test_DeckCache.cpp
+                                tests/test_parallelistlinformation.cpp
                                 tests/test_ParallelRestart.cpp)
 endif()
 if(CUDA_FOUND)
@@ -172,6 +208,7 @@ if(CUDA_FOUND)
 endif()
 if(OPENCL_FOUND)
   list(APPEND TEST_SOURCE_FILES tests/test_openclSolver.cpp)
+  list(APPEND TEST_SOURCE_FILES tests/test_openclSellMatrix.cpp)
   list(APPEND TEST_SOURCE_FILES tests/test_solvetransposed3x3.cpp)
   list(APPEND TEST_SOURCE_FILES tests/test_csrToCscOffsetMap.cpp)
 endif()
@@ -215,7 +252,9 @@ list (APPEND TEST_DATA_FILES
   tests/rhs3rep.txt
   tests/options_flexiblesolver.json
   tests/options_flexiblesolver_simple.json
+  tests/options_flexiblesolver_pipelined.json
   tests/GLIFT1.DATA
+  tests/AQUFETP_CHECKPOINT.DATA
   tests/include/flowl_b_vfp.ecl
   tests/include/flowl_c_vfp.ecl
   tests/include/permx_model5.grdecl
@@ -238,6 +277,8 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/flow/FlowMainEbos.hpp
   opm/simulators/flow/Main.hpp
   opm/simulators/flow/NonlinearSolverEbos.hpp
+  opm/simulators/flow/partitionCells.hpp
+  opm/simulators/flow/ResidualNormHistory.hpp
   opm/simulators/flow/SimulatorFullyImplicitBlackoilEbos.hpp
   opm/simulators/flow/KeywordValidation.hpp
   opm/simulators/flow/ValidationFunctions.hpp
@@ -260,6 +301,8 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/bda/opencl/BILU0.hpp
   opm/simulators/linalg/bda/BlockedMatrix.hpp
   opm/simulators/linalg/bda/opencl/CPR.hpp
+  opm/simulators/linalg/bda/CprCreation.hpp
+  opm/simulators/linalg/bda/cuda/cuCPR.hpp
   opm/simulators/linalg/bda/cuda/cuda_header.hpp
   opm/simulators/linalg/bda/cuda/cusparseSolverBackend.hpp
   opm/simulators/linalg/bda/opencl/ChowPatelIlu.hpp
@@ -271,7 +314,9 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/bda/ILUReorder.hpp
   opm/simulators/linalg/bda/opencl/opencl.hpp
   opm/simulators/linalg/bda/opencl/openclKernels.hpp
+  opm/simulators/linalg/bda/opencl/OpenclBufferPool.hpp
   opm/simulators/linalg/bda/opencl/OpenclMatrix.hpp
+  opm/simulators/linalg/bda/opencl/OpenclSellMatrix.hpp
   opm/simulators/linalg/bda/opencl/Preconditioner.hpp
   opm/simulators/linalg/bda/opencl/openclSolverBackend.hpp
   opm/simulators/linalg/bda/opencl/openclWellContributions.hpp
@@ -279,18 +324,27 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/bda/MultisegmentWellContribution.hpp
   opm/simulators/linalg/bda/WellContributions.hpp
   opm/simulators/linalg/amgcpr.hh
+  opm/simulators/linalg/BlockSpMV.hpp
   opm/simulators/linalg/twolevelmethodcpr.hh
   opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp
   opm/simulators/linalg/FlexibleSolver.hpp
   opm/simulators/linalg/FlexibleSolver_impl.hpp
+  opm/simulators/linalg/FloatMatrixOperator.hpp
   opm/simulators/linalg/FlowLinearSolverParameters.hpp
   opm/simulators/linalg/GraphColoring.hpp
+  opm/simulators/linalg/HaloExchange.hpp
+  opm/simulators/linalg/HyprePreconditioner.hpp
   opm/simulators/linalg/ISTLSolverEbos.hpp
   opm/simulators/linalg/MatrixBlock.hpp
   opm/simulators/linalg/MatrixMarketSpecializations.hpp
+  opm/simulators/linalg/MsrsbPreconditioner.hpp
+  opm/simulators/linalg/MultiRhsBiCGSTAB.hpp
   opm/simulators/linalg/OwningBlockPreconditioner.hpp
   opm/simulators/linalg/OwningTwoLevelPreconditioner.hpp
   opm/simulators/linalg/ParallelOverlappingILU0.hpp
+  opm/simulators/linalg/PipelinedBiCGSTABSolver.hpp
+  opm/simulators/linalg/RecyclingSolver.hpp
+  opm/simulators/linalg/RedundantCoarseSolver.hpp
   opm/simulators/linalg/ParallelRestrictedAdditiveSchwarz.hpp
   opm/simulators/linalg/ParallelIstlInformation.hpp
   opm/simulators/linalg/PressureSolverPolicy.hpp
@@ -298,9 +352,11 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/PreconditionerFactory.hpp
   opm/simulators/linalg/PreconditionerWithUpdate.hpp
   opm/simulators/linalg/PropertyTree.hpp
+  opm/simulators/linalg/TimedScalarProduct.hpp
   opm/simulators/linalg/WellOperators.hpp
   opm/simulators/linalg/WriteSystemMatrixHelper.hpp
   opm/simulators/linalg/findOverlapRowsAndColumns.hpp
+  opm/simulators/linalg/extractPressureMatrix.hpp
   opm/simulators/linalg/getQuasiImpesWeights.hpp
   opm/simulators/linalg/setupPropertyTree.hpp
   opm/simulators/timestepping/AdaptiveSimulatorTimer.hpp
@@ -312,13 +368,23 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/timestepping/SimulatorTimerInterface.hpp
   opm/simulators/timestepping/gatherConvergenceReport.hpp
   opm/simulators/utils/ParallelFileMerger.hpp
+  opm/simulators/utils/CacheFile.hpp
+  opm/simulators/utils/CheckpointStream.hpp
+  opm/simulators/utils/DeckCache.hpp
   opm/simulators/utils/DeferredLoggingErrorHelpers.hpp
   opm/simulators/utils/DeferredLogger.hpp
   opm/simulators/utils/gatherDeferredLogger.hpp
+  opm/simulators/utils/GeometricPartition.hpp
+  opm/simulators/utils/MemoryRegistry.hpp
+  opm/simulators/utils/MetricsExporter.hpp
   opm/simulators/utils/moduleVersion.hpp
+  opm/simulators/utils/NumaFirstTouch.hpp
   opm/simulators/utils/ParallelEclipseState.hpp
   opm/simulators/utils/ParallelRestart.hpp
+  opm/simulators/utils/PartitionCache.hpp
+  opm/simulators/utils/ParallelSolutionWriter.hpp
   opm/simulators/utils/PropsCentroidsDataHandle.hpp
+  opm/simulators/utils/TimingRegistry.hpp
   opm/simulators/utils/VectorVectorDataHandle.hpp
   opm/simulators/wells/ALQState.hpp
   opm/simulators/wells/BlackoilWellModel.hpp
@@ -332,9 +398,12 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/GasLiftWellState.hpp
   opm/simulators/wells/GlobalWellInfo.hpp
   opm/simulators/wells/GroupState.hpp
+  opm/simulators/wells/GroupTree.hpp
   opm/simulators/wells/MSWellHelpers.hpp
+  opm/simulators/wells/MSWellTreeLU.hpp
   opm/simulators/wells/MultisegmentWell.hpp
   opm/simulators/wells/MultisegmentWell_impl.hpp
+  opm/simulators/wells/NetworkPressureSolver.hpp
   opm/simulators/wells/ParallelWellInfo.hpp
   opm/simulators/wells/PerfData.hpp
   opm/simulators/wells/PerforationData.hpp
@@ -344,6 +413,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/RegionAverageCalculator.hpp
   opm/simulators/wells/SingleWellState.hpp
   opm/simulators/wells/StandardWell.hpp
+  opm/simulators/wells/StandardWellBatch.hpp
   opm/simulators/wells/StandardWell_impl.hpp
   opm/simulators/wells/TargetCalculator.hpp
   opm/simulators/wells/VFPHelpers.hpp
@@ -361,5 +431,7 @@ list (APPEND PUBLIC_HEADER_FILES
   )
 
 list (APPEND EXAMPLE_SOURCE_FILES
+  examples/linearsolverbench.cpp
   examples/printvfp.cpp
+  examples/wellkernelbench.cpp
   )
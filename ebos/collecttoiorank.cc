@@ -41,6 +41,7 @@
 #include <cassert>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -798,6 +799,34 @@ public:
     { this->globalInterRegFlows_.read(buffer); }
 };
 
+// Packs the data of several handles into one message per process, so that
+// all output data is sent to the I/O rank in a single exchange.
+class PackUnPackOutputData : public P2PCommunicatorType::DataHandleInterface
+{
+    std::vector<P2PCommunicatorType::DataHandleInterface*> handles_;
+
+public:
+    explicit PackUnPackOutputData(std::vector<P2PCommunicatorType::DataHandleInterface*> handles)
+        : handles_(std::move(handles))
+    {}
+
+    // pack all data associated with link
+    void pack(int link, MessageBufferType& buffer)
+    {
+        for (auto* handle : handles_) {
+            handle->pack(link, buffer);
+        }
+    }
+
+    // unpack all data associated with link, in the order it was packed
+    void unpack(int link, MessageBufferType& buffer)
+    {
+        for (auto* handle : handles_) {
+            handle->unpack(link, buffer);
+        }
+    }
+};
+
 template <class Grid, class EquilGrid, class GridView>
 CollectDataToIORank<Grid,EquilGrid,GridView>::
 CollectDataToIORank(const Grid& grid, const EquilGrid* equilGrid,
@@ -1000,14 +1029,20 @@ collect(const data::Solution& localCellData,
         this->isIORank()
     };
 
-    toIORankComm_.exchange(packUnpackCellData);
-    toIORankComm_.exchange(packUnpackWellData);
-    toIORankComm_.exchange(packUnpackGroupAndNetworkData);
-    toIORankComm_.exchange(packUnpackBlockData);
-    toIORankComm_.exchange(packUnpackWBPData);
-    toIORankComm_.exchange(packUnpackAquiferData);
-    toIORankComm_.exchange(packUnpackWellTestState);
-    toIORankComm_.exchange(packUnpackInterRegFlows);
+    // one message per process, rather than one round of messages per
+    // kind of data
+    PackUnPackOutputData packUnpackOutputData {{
+        &packUnpackCellData,
+        &packUnpackWellData,
+        &packUnpackGroupAndNetworkData,
+        &packUnpackBlockData,
+        &packUnpackWBPData,
+        &packUnpackAquiferData,
+        &packUnpackWellTestState,
+        &packUnpackInterRegFlows
+    }};
+    toIORankComm_.exchange(packUnpackOutputData);
+    updateMemoryAccount_();
 
 #ifndef NDEBUG
     // make sure every process is on the same page
@@ -1015,6 +1050,22 @@ collect(const data::Solution& localCellData,
 #endif
 }
 
+template <class Grid, class EquilGrid, class GridView>
+void CollectDataToIORank<Grid,EquilGrid,GridView>::
+updateMemoryAccount_()
+{
+    std::size_t bytes = memoryBytes(globalCartesianIndex_) + memoryBytes(localIndexMap_)
+        + memoryBytes(globalRanks_) + memoryBytes(localIdxToGlobalIdx_)
+        + memoryBytes(sortedCartesianIdx_);
+    for (const auto& indexMap : indexMaps_) {
+        bytes += memoryBytes(indexMap);
+    }
+    for (const auto& [name, cellData] : globalCellData_) {
+        bytes += memoryBytes(cellData.data);
+    }
+    memory_.set(bytes);
+}
+
 template <class Grid, class EquilGrid, class GridView>
 int CollectDataToIORank<Grid,EquilGrid,GridView>::
 localIdxToGlobalIdx(unsigned localIdx) const
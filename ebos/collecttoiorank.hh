@@ -33,6 +33,8 @@
 
 #include <opm/grid/common/p2pcommunicator.hh>
 
+#include <opm/simulators/utils/MemoryRegistry.hpp>
+
 #include <ebos/eclinterregflows.hh>
 
 #include <map>
@@ -122,6 +124,9 @@ public:
     bool isCartIdxOnThisRank(int cartIdx) const;
 
 protected:
+    /// Update the memory account with the global cell data and the index maps.
+    void updateMemoryAccount_();
+
     P2PCommunicatorType toIORankComm_;
     EclInterRegFlowMap globalInterRegFlows_;
     IndexMapType globalCartesianIndex_;
@@ -140,6 +145,7 @@ protected:
     ///
     /// non-empty only when running in parallel
     std::vector<int> sortedCartesianIdx_;
+    MemoryAccount memory_{MemoryRegistry::Owner::OutputGather};
 };
 
 } // end namespace Opm
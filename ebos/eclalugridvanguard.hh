@@ -29,10 +29,17 @@
 
 #include "eclbasevanguard.hh"
 #include "alucartesianindexmapper.hh"
+#include "eclgenericcpgridvanguard.hh"
 
 #include <dune/alugrid/grid.hh>
 #include <dune/alugrid/common/fromtogridfactory.hh>
 #include <opm/grid/CpGrid.hpp>
+#include <opm/input/eclipse/Schedule/Schedule.hpp>
+#include <opm/input/eclipse/Schedule/Well/Well.hpp>
+
+#include <set>
+#include <utility>
+#include <vector>
 
 namespace Opm {
 template <class TypeTag>
@@ -151,12 +158,27 @@ public:
      * \brief Distribute the simulation grid over multiple processes
      *
      * (For parallel simulation runs.)
+     *
+     * With one of the geometric partition methods the cells are distributed like
+     * the cells of a CpGrid, keeping the wells together unless distributed wells
+     * are enabled. Otherwise the internal partitioner of ALUGrid is used.
      */
     void loadBalance()
     {
+        ScopedTimer timer(TimingRegistry::Region::LoadBalance);
         auto gridView = grid().leafGridView();
         auto dataHandle = cartesianIndexMapper_->dataHandle(gridView);
-        grid().loadBalance(*dataHandle);
+#if HAVE_MPI
+        if (isGeometricPartitionMethod(this->partitionMethod())) {
+            CartesianDestinations destinations(geometricDestinations_(), gridView,
+                                               *cartesianIndexMapper_);
+            grid().repartition(destinations, *dataHandle);
+        }
+        else
+#endif
+        {
+            grid().loadBalance(*dataHandle);
+        }
 
         // communicate non-interior cells values
         grid().communicate(*dataHandle,
@@ -190,6 +212,64 @@ public:
         return this->cellCentroids_(cartesianIndexMapper_.get());
     }
 protected:
+#if HAVE_MPI
+    // destination process of the elements for Grid::repartition(), given by their
+    // Cartesian index
+    class CartesianDestinations
+    {
+    public:
+        CartesianDestinations(std::vector<int> destinations,
+                              const GridView& gridView,
+                              const CartesianIndexMapper& cartesianIndexMapper)
+            : destinations_(std::move(destinations))
+            , gridView_(gridView)
+            , cartesianIndexMapper_(cartesianIndexMapper)
+        {}
+
+        // the partition is computed once, before the grid is distributed
+        bool repartition()
+        { return true; }
+
+        template <class Element>
+        int operator()(const Element& element) const
+        {
+            const int cartesianIdx = cartesianIndexMapper_.cartesianIndex(gridView_.indexSet().index(element));
+            return destinations_[cartesianIdx];
+        }
+
+        // let ALUGrid find the processes which send elements
+        bool importRanks(std::set<int>&) const
+        { return false; }
+
+    private:
+        std::vector<int> destinations_;
+        const GridView& gridView_;
+        const CartesianIndexMapper& cartesianIndexMapper_;
+    };
+
+    // the process of every Cartesian cell after the geometric partitioning of the
+    // EQUIL grid on the root, -1 for the inactive cells
+    std::vector<int> geometricDestinations_() const
+    {
+        const auto& comm = grid().comm();
+        std::vector<int> destinations;
+        if (comm.rank() == 0) {
+            const auto parts = geometricParts(*equilGrid_, this->schedule().getWellsatEnd(),
+                                              this->enableDistributedWells(),
+                                              this->partitionMethod(), comm.size());
+            destinations.resize(cartesianDimension_[0] * cartesianDimension_[1] * cartesianDimension_[2], -1);
+            for (std::size_t cellIdx = 0; cellIdx < parts.size(); ++cellIdx) {
+                destinations[cartesianCellId_[cellIdx]] = parts[cellIdx];
+            }
+        }
+        int size = destinations.size();
+        comm.broadcast(&size, 1, 0);
+        destinations.resize(size);
+        comm.broadcast(destinations.data(), size, 0);
+        return destinations;
+    }
+#endif
+
     void createGrids_()
     {
         // we use separate grid objects: one for the calculation of the initial condition
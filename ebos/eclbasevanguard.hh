@@ -38,9 +38,12 @@
 #include <opm/input/eclipse/EclipseState/Aquifer/NumericalAquifer/NumericalAquiferCell.hpp>
 #include <opm/input/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/simulators/flow/BlackoilModelParametersEbos.hpp>
+#include <opm/simulators/utils/GeometricPartition.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
 
 #include <array>
 #include <optional>
+#include <stdexcept>
 #include <unordered_set>
 #include <vector>
 
@@ -69,6 +72,10 @@ struct EclStrictParsing {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct EclDeckCacheFile {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct SchedRestart {
     using type = UndefinedProperty;
 };
@@ -99,11 +106,26 @@ struct ZoltanImbalanceTol {
     using type = UndefinedProperty;
 };
 
+template<class TypeTag, class MyTypeTag>
+struct NumOverlap {
+    using type = UndefinedProperty;
+};
+
 template<class TypeTag, class MyTypeTag>
 struct AllowDistributedWells {
     using type = UndefinedProperty;
 };
 
+template<class TypeTag, class MyTypeTag>
+struct PartitionCacheFile {
+    using type = UndefinedProperty;
+};
+
+template<class TypeTag, class MyTypeTag>
+struct PartitionMethod {
+    using type = UndefinedProperty;
+};
+
 template<class TypeTag>
 struct IgnoreKeywords<TypeTag, TTag::EclBaseVanguard> {
     static constexpr auto value = "";
@@ -113,6 +135,10 @@ struct EclDeckFileName<TypeTag, TTag::EclBaseVanguard> {
     static constexpr auto value = "";
 };
 template<class TypeTag>
+struct EclDeckCacheFile<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr auto value = "";
+};
+template<class TypeTag>
 struct EclOutputInterval<TypeTag, TTag::EclBaseVanguard> {
     static constexpr int value = -1;
 };
@@ -146,11 +172,26 @@ struct ZoltanImbalanceTol<TypeTag, TTag::EclBaseVanguard> {
     static constexpr double value = 1.1;
 };
 
+template<class TypeTag>
+struct NumOverlap<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr int value = 1;
+};
+
 template<class TypeTag>
 struct AllowDistributedWells<TypeTag, TTag::EclBaseVanguard> {
     static constexpr bool value = false;
 };
 
+template<class TypeTag>
+struct PartitionCacheFile<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr auto value = "";
+};
+
+template<class TypeTag>
+struct PartitionMethod<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr auto value = "zoltan";
+};
+
 template<class T1, class T2>
 struct UseMultisegmentWell;
 
@@ -199,6 +240,8 @@ public:
     {
         EWOMS_REGISTER_PARAM(TypeTag, std::string, EclDeckFileName,
                              "The name of the file which contains the ECL deck to be simulated");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, EclDeckCacheFile,
+                             "The name of a binary cache of the parsed deck, written if it does not match the deck files and read otherwise");
         EWOMS_REGISTER_PARAM(TypeTag, int, EclOutputInterval,
                              "The number of report steps that ought to be skipped between two writes of ECL results");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableOpmRstFile,
@@ -217,8 +260,14 @@ public:
                              "Perform partitioning for parallel runs on a single process.");
         EWOMS_REGISTER_PARAM(TypeTag, double, ZoltanImbalanceTol,
                              "Tolerable imbalance of the loadbalancing provided by Zoltan (default: 1.1).");
+        EWOMS_REGISTER_PARAM(TypeTag, int, NumOverlap,
+                             "Number of layers of overlap cells added to the domain of each process (default: 1).");
         EWOMS_REGISTER_PARAM(TypeTag, bool, AllowDistributedWells,
                              "Allow the perforations of a well to be distributed to interior of multiple processes");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, PartitionCacheFile,
+                             "The name of a cache of the partition of the grid, written if it does not match the grid, the wells, the number of processes and the partitioning parameters and read otherwise");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, PartitionMethod,
+                             "Method to partition the grid for parallel runs: zoltan (graph partitioner, the internal partitioner of ALUGrid for an ALUGrid), rcb (recursive coordinate bisection of the cell centroids), columns (bisection of the areal columns, such that every column is on one process) or wells (like columns, but the columns connected by a well are on one process)");
         // register here for the use in the tests without BlackoildModelParametersEbos
         EWOMS_REGISTER_PARAM(TypeTag, bool, UseMultisegmentWell, "Use the well model for multi-segment wells instead of the one for single-segment wells");
 
@@ -234,11 +283,21 @@ public:
         : ParentType(simulator)
     {
         fileName_ = EWOMS_GET_PARAM(TypeTag, std::string, EclDeckFileName);
+        deckCacheFile_ = EWOMS_GET_PARAM(TypeTag, std::string, EclDeckCacheFile);
         edgeWeightsMethod_   = Dune::EdgeWeightMethod(EWOMS_GET_PARAM(TypeTag, int, EdgeWeightsMethod));
         ownersFirst_ = EWOMS_GET_PARAM(TypeTag, bool, OwnerCellsFirst);
         serialPartitioning_ = EWOMS_GET_PARAM(TypeTag, bool, SerialPartitioning);
         zoltanImbalanceTol_ = EWOMS_GET_PARAM(TypeTag, double, ZoltanImbalanceTol);
+        numOverlap_ = EWOMS_GET_PARAM(TypeTag, int, NumOverlap);
+        if (numOverlap_ < 1) {
+            throw std::invalid_argument("NumOverlap must be at least 1");
+        }
         enableDistributedWells_ = EWOMS_GET_PARAM(TypeTag, bool, AllowDistributedWells);
+        partitionCacheFile_ = EWOMS_GET_PARAM(TypeTag, std::string, PartitionCacheFile);
+        partitionMethod_ = EWOMS_GET_PARAM(TypeTag, std::string, PartitionMethod);
+        if (partitionMethod_ != "zoltan" && !isGeometricPartitionMethod(partitionMethod_)) {
+            throw std::invalid_argument("Unknown PartitionMethod " + partitionMethod_);
+        }
         ignoredKeywords_ = EWOMS_GET_PARAM(TypeTag, std::string, IgnoreKeywords);
         eclStrictParsing_ = EWOMS_GET_PARAM(TypeTag, bool, EclStrictParsing);
         int output_param = EWOMS_GET_PARAM(TypeTag, int, EclOutputInterval);
@@ -434,7 +493,10 @@ protected:
 
     void callImplementationInit()
     {
-        asImp_().createGrids_();
+        {
+            ScopedTimer timer(TimingRegistry::Region::GridCreation);
+            asImp_().createGrids_();
+        }
         asImp_().filterConnections_();
         std::string outputDir = EWOMS_GET_PARAM(TypeTag, std::string, OutputDir);
         bool enableEclCompatFile = !EWOMS_GET_PARAM(TypeTag, bool, EnableOpmRstFile);
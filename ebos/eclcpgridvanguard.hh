@@ -131,12 +131,15 @@ public:
      */
     void loadBalance()
     {
+        ScopedTimer timer(TimingRegistry::Region::LoadBalance);
 #if HAVE_MPI
         this->doLoadBalance_(this->edgeWeightsMethod(), this->ownersFirst(),
                              this->serialPartitioning(), this->enableDistributedWells(),
-                             this->zoltanImbalanceTol(), this->gridView(),
+                             this->zoltanImbalanceTol(), this->numOverlap(),
+                             this->gridView(),
                              this->schedule(), this->centroids_,
-                             this->eclState(), this->parallelWells_);
+                             this->eclState(), this->parallelWells_,
+                             this->partitionCacheFile(), this->partitionMethod());
 #endif
 
         this->updateGridView_();
@@ -177,6 +180,7 @@ protected:
                                                     this->cellCentroids(),
                                                     getPropValue<TypeTag, Properties::EnableEnergy>(),
                                                     getPropValue<TypeTag, Properties::EnableDiffusion>()));
+        ScopedTimer timer(TimingRegistry::Region::Transmissibilities);
         globalTrans_->update(false);
     }
 
@@ -28,10 +28,18 @@
 #include <ebos/eclmpiserializer.hh>
 #endif
 
+#include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/common/utility/ActiveGridCells.hpp>
 #include <opm/grid/cpgrid/GridHelpers.hpp>
+#include <opm/input/eclipse/EclipseState/EclipseConfig.hpp>
+#include <opm/input/eclipse/EclipseState/IOConfig/IOConfig.hpp>
+#include <opm/input/eclipse/Schedule/MSW/WellSegments.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
+#include <opm/input/eclipse/Schedule/Well/Well.hpp>
+#include <opm/input/eclipse/Schedule/Well/WellConnections.hpp>
+#include <opm/simulators/utils/GeometricPartition.hpp>
 #include <opm/simulators/utils/ParallelEclipseState.hpp>
+#include <opm/simulators/utils/PartitionCache.hpp>
 #include <opm/simulators/utils/PropsCentroidsDataHandle.hpp>
 #include <opm/simulators/utils/ParallelSerialization.hpp>
 
@@ -46,14 +54,167 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <numeric>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace Opm {
 
 std::optional<std::function<std::vector<int> (const Dune::CpGrid&)>> externalLoadBalancer;
 
+#if HAVE_MPI
+namespace {
+
+/// Log how the work of the wells is distributed over the processes.
+///
+/// The partitioner balances the cells only, while the wells are kept
+/// together on as few processes as possible. The work of a well is
+/// estimated by the number of its connections plus the number of
+/// segments of a multisegment well.
+void reportWellWorkBalance(const Dune::CpGrid& grid,
+                           const std::vector<Well>& wells,
+                           const EclGenericVanguard::ParallelWellStruct& parallelWells,
+                           const double zoltanImbalanceTol)
+{
+    std::array<double,3> local{static_cast<double>(grid.size(0)), 0.0, 0.0};
+    auto& [cells, num_wells, well_work] = local;
+    for (const auto& well : wells) {
+        const std::pair<std::string,bool> value{well.name(), true};
+        const auto candidate = std::lower_bound(parallelWells.begin(), parallelWells.end(), value);
+        if (candidate == parallelWells.end() || *candidate != value) {
+            continue;
+        }
+        num_wells += 1.0;
+        well_work += well.getConnections().size();
+        if (well.isMultiSegment()) {
+            well_work += well.getSegments().size();
+        }
+    }
+
+    const auto& comm = grid.comm();
+    std::vector<double> all(comm.rank() == 0 ? 3 * comm.size() : 0);
+    comm.gather(local.data(), all.data(), 3, 0);
+    if (comm.rank() != 0) {
+        return;
+    }
+
+    double total_work = 0.0;
+    double max_work = 0.0;
+    int max_rank = 0;
+    std::ostringstream table;
+    table << "Well work per process (rank: cells, wells, connections and segments)";
+    for (int rank = 0; rank < comm.size(); ++rank) {
+        const double work = all[3 * rank + 2];
+        table << fmt::format("\n  {:>5}: {:>10} {:>6} {:>8}", rank, all[3 * rank],
+                             all[3 * rank + 1], work);
+        total_work += work;
+        if (work > max_work) {
+            max_work = work;
+            max_rank = rank;
+        }
+    }
+    OpmLog::debug(table.str());
+
+    const double mean_work = total_work / comm.size();
+    if (mean_work > 0.0 && max_work > zoltanImbalanceTol * mean_work) {
+        OpmLog::info(fmt::format("The wells are not balanced over the processes, process {} "
+                                 "holds {:.2f} times the average well work",
+                                 max_rank, max_work / mean_work));
+    }
+}
+
+/// Gather the process of every cell of the global grid on the root.
+///
+/// The processes own the interior cells of the distributed view. The
+/// result is indexed like the cells of globalGrid, which is only given on
+/// the root, and empty on the other processes.
+std::vector<int> gatherPartition(const Dune::CpGrid& grid,
+                                 const Dune::CpGrid* globalGrid)
+{
+    std::vector<int> owned;
+    const auto& gridView = grid.leafGridView();
+    for (const auto& element : elements(gridView, Dune::Partitions::interior)) {
+        owned.push_back(grid.globalCell()[gridView.indexSet().index(element)]);
+    }
+
+    const auto& comm = grid.comm();
+    int numOwned = owned.size();
+    std::vector<int> sizes(comm.rank() == 0 ? comm.size() : 0);
+    comm.gather(&numOwned, sizes.data(), 1, 0);
+
+    std::vector<int> offsets(sizes.size() + 1, 0);
+    std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+    std::vector<int> all(offsets.back());
+    comm.gatherv(owned.data(), numOwned, all.data(), sizes.data(), offsets.data(), 0);
+
+    std::vector<int> parts;
+    if (comm.rank() == 0) {
+        const auto& globalCell = globalGrid->globalCell();
+        const auto cartesianSize = globalGrid->logicalCartesianSize();
+        std::vector<int> cartesianPart(cartesianSize[0] * cartesianSize[1] * cartesianSize[2], -1);
+        for (int rank = 0; rank < comm.size(); ++rank) {
+            for (int i = offsets[rank]; i < offsets[rank + 1]; ++i) {
+                cartesianPart[all[i]] = rank;
+            }
+        }
+        parts.resize(globalCell.size());
+        std::transform(globalCell.begin(), globalCell.end(), parts.begin(),
+                       [&cartesianPart](const int cartesianIdx)
+                       { return cartesianPart[cartesianIdx]; });
+    }
+    return parts;
+}
+
+} // anonymous namespace
+
+std::vector<int> geometricParts(const Dune::CpGrid& grid,
+                                const std::vector<Well>& wells,
+                                const bool enableDistributedWells,
+                                const std::string& method,
+                                const int numParts)
+{
+    const auto& gridView = grid.leafGridView();
+    const auto& globalCell = grid.globalCell();
+    const auto cartesianSize = grid.logicalCartesianSize();
+    const int arealSize = cartesianSize[0] * cartesianSize[1];
+
+    std::vector<std::array<double, 3>> centroids(globalCell.size());
+    std::vector<int> columns(globalCell.size());
+    for (const auto& element : elements(gridView)) {
+        const auto idx = gridView.indexSet().index(element);
+        const auto center = element.geometry().center();
+        centroids[idx] = {center[0], center[1], center[2]};
+        columns[idx] = globalCell[idx] % arealSize;
+    }
+
+    std::vector<std::vector<int>> wellCells;
+    if (!enableDistributedWells) {
+        std::vector<int> activeCell(arealSize * cartesianSize[2], -1);
+        for (std::size_t idx = 0; idx < globalCell.size(); ++idx) {
+            activeCell[globalCell[idx]] = idx;
+        }
+        for (const auto& well : wells) {
+            auto& cells = wellCells.emplace_back();
+            for (const auto& connection : well.getConnections()) {
+                const int cell = activeCell[connection.global_index()];
+                if (cell >= 0) {
+                    cells.push_back(cell);
+                }
+            }
+        }
+    }
+
+    return geometricPartition(method, centroids, columns, wellCells, numParts);
+}
+
+#endif
+
 template<class ElementMapper, class GridView, class Scalar>
 EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::EclGenericCpGridVanguard()
 {
@@ -78,21 +239,55 @@ void EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::doLoadBalance_(Dun
                                                                              bool serialPartitioning,
                                                                              bool enableDistributedWells,
                                                                              double zoltanImbalanceTol,
+                                                                             int numOverlap,
                                                                              const GridView& gridv,
                                                                              const Schedule& schedule,
                                                                              std::vector<double>& centroids,
                                                                              EclipseState& eclState1,
-                                                                             EclGenericVanguard::ParallelWellStruct& parallelWells)
+                                                                             EclGenericVanguard::ParallelWellStruct& parallelWells,
+                                                                             const std::string& partitionCacheFile,
+                                                                             const std::string& partitionMethod)
 {
     int mpiSize = 1;
     MPI_Comm_size(grid_->comm(), &mpiSize);
 
     if (mpiSize > 1) {
+        const auto wells = schedule.getWellsatEnd();
+        int loadBalancerSet = externalLoadBalancer.has_value();
+        grid_->comm().broadcast(&loadBalancerSet, 1, 0);
+        const bool geometric = !loadBalancerSet && isGeometricPartitionMethod(partitionMethod);
+
+        // A partition cached by an earlier run of the same setup replaces
+        // the graph partitioner.
+        PartitionCacheKey cacheKey;
+        std::optional<std::vector<int>> cachedParts;
+        int useCachedParts = 0;
+        if (!loadBalancerSet && !geometric && !partitionCacheFile.empty()) {
+            if (grid_->comm().rank() == 0) {
+                cacheKey = partitionCacheKey(mpiSize, grid_->globalCell(), wells,
+                                             edgeWeightsMethod, zoltanImbalanceTol,
+                                             enableDistributedWells);
+                cachedParts = loadPartitionCache(partitionCacheFile, cacheKey);
+                useCachedParts = cachedParts.has_value();
+                if (useCachedParts) {
+                    OpmLog::info("Using the partition cached in " + partitionCacheFile);
+                }
+            }
+            grid_->comm().broadcast(&useCachedParts, 1, 0);
+        }
+
         // the CpGrid's loadBalance() method likes to have the transmissibilities as
         // its edge weights. since this is (kind of) a layering violation and
         // transmissibilities are relatively expensive to compute, we only do it if
-        // more than a single process is involved in the simulation.
-        if (grid_->size(0))
+        // more than a single process is involved in the simulation. The global
+        // transmissibilities are computed on the root process only, so they are
+        // skipped if neither the edge weights nor the TRAN and NNC output of the
+        // INIT and EGRID files need them.
+        const bool transEdgeWeights = !loadBalancerSet && !geometric && !useCachedParts &&
+            edgeWeightsMethod != Dune::EdgeWeightMethod::uniformEdgeWgt;
+        const auto& ioConfig = eclState1.cfg().io();
+        const bool transOutput = ioConfig.getWriteINITFile() || ioConfig.getWriteEGRIDFile();
+        if (grid_->size(0) && (transEdgeWeights || transOutput))
         {
             this->allocTrans();
         }
@@ -103,9 +298,7 @@ void EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::doLoadBalance_(Dun
         const auto& gridView = grid_->leafGridView();
         unsigned numFaces = grid_->numFaces();
         std::vector<double> faceTrans;
-        int loadBalancerSet = externalLoadBalancer.has_value();
-        grid_->comm().broadcast(&loadBalancerSet, 1, 0);
-        if (!loadBalancerSet){
+        if (transEdgeWeights) {
             faceTrans.resize(numFaces, 0.0);
             ElementMapper elemMapper(gridv, Dune::mcmgElementLayout());
             auto elemIt = gridView.template begin</*codim=*/0>();
@@ -132,8 +325,6 @@ void EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::doLoadBalance_(Dun
 
         //distribute the grid and switch to the distributed view.
         {
-            const auto wells = schedule.getWellsatEnd();
-
             try
             {
                 auto& eclState = dynamic_cast<ParallelEclipseState&>(eclState1);
@@ -153,13 +344,30 @@ void EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::doLoadBalance_(Dun
                     {
                         parts =  (*externalLoadBalancer)(*grid_);
                     }
-                    parallelWells = std::get<1>(grid_->loadBalance(handle, parts, &wells, ownersFirst, false, 1));
+                    parallelWells = std::get<1>(grid_->loadBalance(handle, parts, &wells, ownersFirst, false, numOverlap));
+                }
+                else if (geometric)
+                {
+                    std::vector<int> parts;
+                    if (grid_->comm().rank() == 0)
+                    {
+                        parts = geometricParts(*grid_, wells, enableDistributedWells, partitionMethod, mpiSize);
+                    }
+                    parallelWells = std::get<1>(grid_->loadBalance(handle, parts, &wells, ownersFirst, false, numOverlap));
+                }
+                else if (useCachedParts)
+                {
+                    std::vector<int> parts;
+                    if (cachedParts) {
+                        parts = std::move(*cachedParts);
+                    }
+                    parallelWells = std::get<1>(grid_->loadBalance(handle, parts, &wells, ownersFirst, false, numOverlap));
                 }
                 else
                 {
                     parallelWells =
                         std::get<1>(grid_->loadBalance(handle, edgeWeightsMethod, &wells, serialPartitioning,
-                                                       faceTrans.data(), ownersFirst, false, 1, true, zoltanImbalanceTol,
+                                                       faceTrans.empty() ? nullptr : faceTrans.data(), ownersFirst, false, numOverlap, true, zoltanImbalanceTol,
                                                        enableDistributedWells));
                 }
             }
@@ -173,6 +381,20 @@ void EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::doLoadBalance_(Dun
             }
         }
         grid_->switchToDistributedView();
+        reportWellWorkBalance(*grid_, wells, parallelWells, zoltanImbalanceTol);
+
+        if (!loadBalancerSet && !geometric && !useCachedParts && !partitionCacheFile.empty()) {
+            auto parts = gatherPartition(*grid_, equilGrid_.get());
+            if (grid_->comm().rank() == 0) {
+                try {
+                    writePartitionCache(partitionCacheFile, cacheKey, parts);
+                }
+                catch (const std::exception& e) {
+                    OpmLog::warning(fmt::format("Could not write the partition cache file {}: {}",
+                                                partitionCacheFile, e.what()));
+                }
+            }
+        }
 
         // Calling Schedule::filterConnections would remove any perforated
         // cells that exist only on other ranks even in the case of distributed wells
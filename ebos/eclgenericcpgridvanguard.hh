@@ -31,6 +31,8 @@
 #include <opm/grid/CpGrid.hpp>
 
 #include <functional>
+#include <string>
+#include <vector>
 
 namespace Opm {
 
@@ -39,6 +41,21 @@ namespace Opm {
 /// If it is set then this will be used during loadbalance.
 extern std::optional<std::function<std::vector<int> (const Dune::CpGrid&)>> externalLoadBalancer;
 
+#if HAVE_MPI
+class Well;
+
+/// \brief Partition the cells of an undistributed grid with one of the methods of
+///        geometricPartition()
+///
+/// The wells are only kept together if they must not be distributed. Also used by
+/// the vanguards of the other grids, which hold the undistributed grid as a CpGrid.
+std::vector<int> geometricParts(const Dune::CpGrid& grid,
+                                const std::vector<Well>& wells,
+                                bool enableDistributedWells,
+                                const std::string& method,
+                                int numParts);
+#endif
+
 template<class ElementMapper, class GridView, class Scalar>
 class EclGenericCpGridVanguard {
 protected:
@@ -111,10 +128,13 @@ protected:
     void doLoadBalance_(Dune::EdgeWeightMethod edgeWeightsMethod,
                         bool ownersFirst, bool serialPartitioning,
                         bool enableDistributedWells, double zoltanImbalanceTol,
+                        int numOverlap,
                         const GridView& gridv, const Schedule& schedule,
                         std::vector<double>& centroids,
                         EclipseState& eclState,
-                        EclGenericVanguard::ParallelWellStruct& parallelWells);
+                        EclGenericVanguard::ParallelWellStruct& parallelWells,
+                        const std::string& partitionCacheFile,
+                        const std::string& partitionMethod);
 
     void distributeFieldProps_(EclipseState& eclState);
 #endif
@@ -602,13 +602,16 @@ addRftDataToWells(data::Wells& wellDatas, size_t reportStepNum)
             continue;
         }
 
+        // the cell data was only collected for the wells with RFT or PLT
+        // output at this step
+        if (!rft_config.rft(well.name()) && !rft_config.plt(well.name())) {
+            continue;
+        }
+
         //add data infrastructure for shut wells
         if (!wellDatas.count(well.name())) {
             data::Well wellData;
 
-            if (!rft_config.active())
-                continue;
-
             wellData.connections.resize(well.getConnections().size());
             size_t count = 0;
             for (const auto& connection: well.getConnections()) {
@@ -823,36 +826,6 @@ setRestart(const data::Solution& sol,
         cCalcite_[elemIdx] = sol.data("CALCITE")[globalDofIndex];
 }
 
-template<class FluidSystem,class Scalar>
-typename EclGenericOutputBlackoilModule<FluidSystem,Scalar>::ScalarBuffer
-EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
-regionSum(const ScalarBuffer& property,
-          const std::vector<int>& regionId,
-          size_t maxNumberOfRegions,
-          const Comm& comm)
-{
-        ScalarBuffer totals(maxNumberOfRegions, 0.0);
-
-        if (property.empty())
-            return totals;
-
-        assert(regionId.size() == property.size());
-        for (size_t j = 0; j < regionId.size(); ++j) {
-            const int regionIdx = regionId[j] - 1;
-            // the cell is not attributed to any region. ignore it!
-            if (regionIdx < 0)
-                continue;
-
-            assert(regionIdx < static_cast<int>(maxNumberOfRegions));
-            totals[regionIdx] += property[j];
-        }
-
-        for (size_t i = 0; i < maxNumberOfRegions; ++i)
-            totals[i] = comm.sum(totals[i]);
-
-        return totals;
-    }
-
 template<class FluidSystem, class Scalar>
 void EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
 doAllocBuffers(unsigned bufferSize,
@@ -913,8 +886,8 @@ doAllocBuffers(unsigned bufferSize,
     }
 
     // Well RFT data
-    if (!substep) {
-        const auto& rft_config = schedule_[reportStepNum].rft_config();
+    const auto& rft_config = schedule_[reportStepNum].rft_config();
+    if (!substep && rft_config.active()) {
         for (const auto& well: schedule_.getWells(reportStepNum)) {
 
             // don't bother with wells not on this process
@@ -922,8 +895,11 @@ doAllocBuffers(unsigned bufferSize,
                 continue;
             }
 
-            if (!rft_config.active())
+            // only the connection cells of the wells which request RFT or
+            // PLT output at this step
+            if (!rft_config.rft(well.name()) && !rft_config.plt(well.name())) {
                 continue;
+            }
 
             for (const auto& connection: well.getConnections()) {
                 const size_t i = size_t(connection.getI());
@@ -943,6 +919,10 @@ doAllocBuffers(unsigned bufferSize,
         }
     }
 
+    // release the field data of the previous restart step, such that
+    // processElement() only fills the arrays that are written at this step
+    this->clearRestartBuffers_();
+
     // field data should be allocated
     // 1) when we want to restart
     // 2) when it is ask for by the user via restartConfig
@@ -1125,15 +1105,46 @@ doAllocBuffers(unsigned bufferSize,
         }
     }
 
-    failedCellsPb_.clear();
-    failedCellsPd_.clear();
-
     // Not supported in flow legacy
     if (false)
         saturatedOilFormationVolumeFactor_.resize(bufferSize, 0.0);
     if (false)
         oilSaturationPressure_.resize(bufferSize, 0.0);
 
+    updateMemoryAccount_();
+}
+
+template<class FluidSystem, class Scalar>
+void EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
+updateMemoryAccount_()
+{
+    std::size_t bytes = 0;
+    for (const auto* buffer : {&gasFormationVolumeFactor_, &hydrocarbonPoreVolume_,
+                               &pressureTimesPoreVolume_, &pressureTimesHydrocarbonVolume_,
+                               &dynamicPoreVolume_, &oilPressure_, &temperature_, &rs_, &rv_,
+                               &overburdenPressure_, &oilSaturationPressure_, &sSol_,
+                               &cPolymer_, &cFoam_, &cSalt_, &pSalt_, &permFact_, &extboX_,
+                               &extboY_, &extboZ_, &mFracOil_, &mFracGas_, &mFracCo2_, &soMax_,
+                               &pcSwMdcOw_, &krnSwMdcOw_, &pcSwMdcGo_, &krnSwMdcGo_, &ppcw_,
+                               &gasDissolutionFactor_, &oilVaporizationFactor_,
+                               &bubblePointPressure_, &dewPointPressure_,
+                               &rockCompPorvMultiplier_, &swMax_, &minimumOilPressure_,
+                               &saturatedOilFormationVolumeFactor_, &rockCompTransMultiplier_,
+                               &cMicrobes_, &cOxygen_, &cUrea_, &cBiofilm_, &cCalcite_}) {
+        bytes += memoryBytes(*buffer);
+    }
+    for (const auto* buffers : {&saturation_, &invB_, &density_, &viscosity_, &relativePermeability_}) {
+        for (const auto& buffer : *buffers) {
+            bytes += memoryBytes(buffer);
+        }
+    }
+    for (const auto& buffer : tracerConcentrations_) {
+        bytes += memoryBytes(buffer);
+    }
+    for (const auto& [phase, buffer] : fip_) {
+        bytes += memoryBytes(buffer);
+    }
+    memory_.set(bytes);
 }
 
 template<class FluidSystem, class Scalar>
@@ -1392,6 +1403,36 @@ outputCumulativeReport_(const ScalarBuffer& wellCum,
     OpmLog::note(ss.str());
 }
 
+template<class FluidSystem,class Scalar>
+void EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
+clearRestartBuffers_()
+{
+    for (auto* buffer : {&oilPressure_, &temperature_, &rs_, &rv_,
+                         &sSol_, &cPolymer_, &cFoam_, &cSalt_, &pSalt_, &permFact_,
+                         &extboX_, &extboY_, &extboZ_, &mFracOil_, &mFracGas_, &mFracCo2_,
+                         &cMicrobes_, &cOxygen_, &cUrea_, &cBiofilm_, &cCalcite_,
+                         &soMax_, &pcSwMdcOw_, &krnSwMdcOw_, &pcSwMdcGo_, &krnSwMdcGo_,
+                         &ppcw_, &gasDissolutionFactor_, &oilVaporizationFactor_,
+                         &bubblePointPressure_, &dewPointPressure_,
+                         &rockCompPorvMultiplier_, &rockCompTransMultiplier_,
+                         &swMax_, &minimumOilPressure_, &overburdenPressure_})
+    {
+        buffer->clear();
+    }
+
+    for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+        saturation_[phaseIdx].clear();
+        invB_[phaseIdx].clear();
+        density_[phaseIdx].clear();
+        viscosity_[phaseIdx].clear();
+        relativePermeability_[phaseIdx].clear();
+    }
+
+    tracerConcentrations_.clear();
+    failedCellsPb_.clear();
+    failedCellsPd_.clear();
+}
+
 template<class FluidSystem,class Scalar>
 bool EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
 isOutputCreationDirective_(const std::string& keyword)
@@ -1602,15 +1643,6 @@ outputFipresvLogImpl(const Inplace& inplace) const
     }
 }
 
-template<class FluidSystem,class Scalar>
-int EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
-regionMax(const std::vector<int>& region,
-          const Comm& comm)
-{
-    const auto max_value = region.empty() ? 0 : *std::max_element(region.begin(), region.end());
-    return comm.max(max_value);
-}
-
 template<class FluidSystem,class Scalar>
 void EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
 update(Inplace& inplace,
@@ -1629,51 +1661,77 @@ update(Inplace& inplace,
 }
 
 template<class FluidSystem,class Scalar>
-void EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
-makeRegionSum(Inplace& inplace,
-              const std::string& region_name,
-              const Comm& comm) const
+Inplace EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
+accumulateRegionSums(const Comm& comm)
 {
-    const auto& region = this->regions_.at(region_name);
-    const std::size_t ntFip = this->regionMax(region, comm);
+    Inplace inplace;
 
-    auto update_inplace =
-        [&inplace, &region, &region_name, &comm, ntFip, this]
-        (const Inplace::Phase       phase,
-         const std::vector<Scalar>& value)
-    {
-        update(inplace, region_name, phase, ntFip,
-               this->regionSum(value, region, ntFip, comm));
+    // the cell quantities that are summed per region
+    std::vector<std::pair<Inplace::Phase, const ScalarBuffer*>> quantities {
+        {Inplace::Phase::PressurePV, &this->pressureTimesPoreVolume_},
+        {Inplace::Phase::HydroCarbonPV, &this->hydrocarbonPoreVolume_},
+        {Inplace::Phase::PressureHydroCarbonPV, &this->pressureTimesHydrocarbonVolume_},
+        {Inplace::Phase::DynamicPoreVolume, &this->dynamicPoreVolume_},
     };
+    for (const auto& phase : Inplace::phases()) {
+        auto fipPos = this->fip_.find(phase);
+        if (fipPos != this->fip_.end()) {
+            quantities.emplace_back(phase, &fipPos->second);
+        }
+    }
+    const std::size_t numQuantities = quantities.size();
 
-    update_inplace(Inplace::Phase::PressurePV,
-                   this->pressureTimesPoreVolume_);
+    // Sum all quantities of all region sets locally, with one block of
+    // region totals per region set and quantity, and reduce them over the
+    // processes at once rather than one region at a time.
+    std::vector<int> numRegions;
+    for (const auto& region : this->regions_) {
+        const auto& id = region.second;
+        numRegions.push_back(id.empty() ? 0 : *std::max_element(id.begin(), id.end()));
+    }
+    comm.max(numRegions.data(), numRegions.size());
 
-    update_inplace(Inplace::Phase::HydroCarbonPV,
-                   this->hydrocarbonPoreVolume_);
+    std::vector<std::size_t> offsets {0};
+    for (const int ntFip : numRegions) {
+        offsets.push_back(offsets.back() + numQuantities * ntFip);
+    }
+    ScalarBuffer totals(offsets.back(), 0.0);
 
-    update_inplace(Inplace::Phase::PressureHydroCarbonPV,
-                   this->pressureTimesHydrocarbonVolume_);
+    std::size_t regionSetIdx = 0;
+    for (const auto& region : this->regions_) {
+        const auto& regionId = region.second;
+        const std::size_t ntFip = numRegions[regionSetIdx];
+        Scalar* regionTotals = totals.data() + offsets[regionSetIdx];
+        for (std::size_t q = 0; q < numQuantities; ++q) {
+            const auto& property = *quantities[q].second;
+            if (property.empty())
+                continue;
 
-    update_inplace(Inplace::Phase::DynamicPoreVolume,
-                   this->dynamicPoreVolume_);
+            assert(regionId.size() == property.size());
+            Scalar* quantityTotals = regionTotals + q * ntFip;
+            for (std::size_t j = 0; j < regionId.size(); ++j) {
+                const int regionIdx = regionId[j] - 1;
+                // the cell is not attributed to any region. ignore it!
+                if (regionIdx < 0)
+                    continue;
 
-    for (const auto& phase : Inplace::phases()) {
-        auto fipPos = this->fip_.find(phase);
-        if (fipPos != this->fip_.end()) {
-            update_inplace(phase, fipPos->second);
+                assert(regionIdx < static_cast<int>(ntFip));
+                quantityTotals[regionIdx] += property[j];
+            }
         }
+        ++regionSetIdx;
     }
-}
-
-template<class FluidSystem,class Scalar>
-Inplace EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
-accumulateRegionSums(const Comm& comm)
-{
-    Inplace inplace;
+    comm.sum(totals.data(), totals.size());
 
+    regionSetIdx = 0;
     for (const auto& region : this->regions_) {
-        makeRegionSum(inplace, region.first, comm);
+        const std::size_t ntFip = numRegions[regionSetIdx];
+        for (std::size_t q = 0; q < numQuantities; ++q) {
+            const auto begin = totals.begin() + offsets[regionSetIdx] + q * ntFip;
+            update(inplace, region.first, quantities[q].first, ntFip,
+                   ScalarBuffer(begin, begin + ntFip));
+        }
+        ++regionSetIdx;
     }
 
     // The first time the outputFipLog function is run we store the inplace values in
@@ -45,6 +45,8 @@
 
 #include <ebos/eclinterregflows.hh>
 
+#include <opm/simulators/utils/MemoryRegistry.hpp>
+
 namespace Opm {
 
 namespace data { class Solution; }
@@ -308,6 +310,9 @@ protected:
                         const bool enableHysteresis,
                         unsigned numTracers);
 
+    /// Update the memory account with the sizes of the cell data buffers.
+    void updateMemoryAccount_();
+
     void fipUnitConvert_(std::unordered_map<Inplace::Phase, Scalar>& fip) const;
 
     void pressureUnitConvert_(Scalar& pav) const;
@@ -331,10 +336,6 @@ protected:
 
     void outputFipresvLogImpl(const Inplace& inplace) const;
 
-    void makeRegionSum(Inplace& inplace,
-                       const std::string& region_name,
-                       const Comm& comm) const;
-
     Inplace accumulateRegionSums(const Comm& comm);
 
     void updateSummaryRegionValues(const Inplace& inplace,
@@ -343,6 +344,8 @@ protected:
 
     static bool isOutputCreationDirective_(const std::string& keyword);
 
+    void clearRestartBuffers_();
+
     static Scalar pressureAverage_(const Scalar& pressurePvHydrocarbon,
                                    const Scalar& pvHydrocarbon,
                                    const Scalar& pressurePv,
@@ -354,15 +357,6 @@ protected:
                                          const ScalarBuffer& pressurePv,
                                          const ScalarBuffer& pv,
                                          bool hydrocarbon);
-    // Sum Fip values over regions.
-    static ScalarBuffer regionSum(const ScalarBuffer& property,
-                                  const std::vector<int>& regionId,
-                                  const std::size_t maxNumberOfRegions,
-                                  const Comm& comm);
-
-    static int regionMax(const std::vector<int>& region,
-                         const Comm& comm);
-
     static void update(Inplace& inplace,
                        const std::string& region_name,
                        const Inplace::Phase phase,
@@ -465,6 +459,7 @@ protected:
     std::map<std::size_t , double> wbpData_;
 
     std::optional<Inplace> initialInplace_;
+    MemoryAccount memory_{MemoryRegistry::Owner::OutputBuffers};
 };
 
 } // namespace Opm
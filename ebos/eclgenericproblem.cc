@@ -35,6 +35,8 @@
 #include <opm/grid/CpGrid.hpp>
 #include <opm/grid/polyhedralgrid.hh>
 
+#include <opm/simulators/utils/NumaFirstTouch.hpp>
+
 #if HAVE_DUNE_FEM
 #include <dune/fem/gridpart/adaptiveleafgridpart.hh>
 #include <dune/fem/gridpart/common/gridpart2gridview.hh>
@@ -282,6 +284,25 @@ updatePlmixnum_()
     updateNum("PLMIXNUM", plmixnum_);
 }
 
+template<class GridView, class FluidSystem, class Scalar>
+void EclGenericProblem<GridView,FluidSystem,Scalar>::
+firstTouchCellData_()
+{
+    for (auto& porosity : referencePorosity_)
+        firstTouch(porosity, hugePages_);
+    firstTouch(pvtnum_, hugePages_);
+    firstTouch(satnum_, hugePages_);
+    firstTouch(miscnum_, hugePages_);
+    firstTouch(plmixnum_, hugePages_);
+    firstTouch(rockTableIdx_, hugePages_);
+    for (auto* cellData : {&maxOilSaturation_, &maxPolymerAdsorption_, &maxWaterSaturation_,
+                           &minOilPressure_, &overburdenPressure_, &polymerConcentration_,
+                           &polymerMoleWeight_, &solventSaturation_, &microbialConcentration_,
+                           &oxygenConcentration_, &ureaConcentration_, &biofilmConcentration_,
+                           &calciteConcentration_, &lastRv_, &convectiveDrs_, &lastRs_})
+        firstTouch(*cellData, hugePages_);
+}
+
 template<class GridView, class FluidSystem, class Scalar>
 bool EclGenericProblem<GridView,FluidSystem,Scalar>::
 vapparsActive(int episodeIdx) const
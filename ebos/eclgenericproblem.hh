@@ -129,6 +129,12 @@ public:
     void setPorosity(Scalar poro, unsigned elementIdx, unsigned timeIdx = 0)
     { referencePorosity_[timeIdx][elementIdx] = poro; }
 
+    /*!
+     * \brief Returns the reference porosities of all elements, for in place updates
+     */
+    Scalar* referencePorosityData(unsigned timeIdx = 0)
+    { return referencePorosity_[timeIdx].data(); }
+
     /*!
      * \brief Returns the initial solvent saturation for a given a cell index
      */
@@ -213,6 +219,20 @@ public:
 
     bool vapparsActive(int episodeIdx) const;
 
+    /*!
+     * \brief Returns true if the large arrays are to be placed on the NUMA
+     *        domains of the threads processing them.
+     */
+    bool numaFirstTouch() const
+    { return numaFirstTouch_; }
+
+    /*!
+     * \brief Returns true if the arrays placed by first touch are to be
+     *        backed by transparent huge pages.
+     */
+    bool hugePages() const
+    { return hugePages_; }
+
 protected:
     bool drsdtActive_(int episodeIdx) const;
     bool drvdtActive_(int episodeIdx) const;
@@ -228,15 +248,6 @@ protected:
     bool shouldWriteOutput() const
     { return true; }
 
-    /*!
-     * \brief Returns true if an eWoms restart file should be written to disk.
-     *
-     * The EclProblem does not write any restart files using the ad-hoc format, only ones
-     * using the ECL format.
-     */
-    bool shouldWriteRestartFile() const
-    { return false; }
-
     bool beginEpisode_(bool enableExperiments,
                        int episodeIdx);
     void beginTimeStep_(bool enableExperiments,
@@ -269,6 +280,9 @@ protected:
                                                   bool enablePolymerMolarWeight,
                                                   bool enableMICP);
 
+    // place the per-cell arrays on the threads of the cells
+    void firstTouchCellData_();
+
     void updatePvtnum_();
     void updateSatnum_();
     void updateMiscnum_();
@@ -324,6 +338,9 @@ protected:
     unsigned maxFails_;
     Scalar minTimeStepSize_;
 
+    bool numaFirstTouch_ = false;
+    bool hugePages_ = false;
+
 private:
     template<class T>
     void updateNum(const std::string& name, std::vector<T>& numbers);
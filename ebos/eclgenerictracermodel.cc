@@ -26,6 +26,7 @@
 
 #include <opm/simulators/linalg/PropertyTree.hpp>
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/MultiRhsBiCGSTAB.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/grid/CpGrid.hpp>
 #include <opm/grid/polyhedralgrid.hh>
@@ -52,6 +53,7 @@
 #include <set>
 #include <stdexcept>
 #include <functional>
+#include <tuple>
 #include <array>
 #include <string>
 
@@ -257,62 +259,30 @@ doInit(bool rst, size_t numGridDof,
 }
 
 template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
-bool EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
-linearSolve_(const TracerMatrix& M, TracerVector& x, TracerVector& b)
+struct EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::TracerSolver
 {
-#if ! DUNE_VERSION_NEWER(DUNE_COMMON, 2,7)
-    Dune::FMatrixPrecision<Scalar>::set_singular_limit(1.e-30);
-    Dune::FMatrixPrecision<Scalar>::set_absolute_limit(1.e-30);
-#endif
-    x = 0.0;
-    Scalar tolerance = 1e-2;
-    int maxIter = 100;
-
-    int verbosity = 0;
-    PropertyTree prm;
-    prm.put("maxiter", maxIter);
-    prm.put("tol", tolerance);
-    prm.put("verbosity", verbosity);
-    prm.put("solver", std::string("bicgstab"));
-    prm.put("preconditioner.type", std::string("ParOverILU0"));
-
+    const TracerMatrix* matrix = nullptr;
 #if HAVE_MPI
-    if(gridView_.grid().comm().size() > 1)
-    {
-        auto [tracerOperator, solver] =
-            createParallelFlexibleSolver<TracerVector>(gridView_.grid(), M, prm);
-        (void) tracerOperator;
-
-        Dune::InverseOperatorResult result;
-        solver->apply(x, b, result);
-
-        // return the result of the solver
-        return result.converged;
-    }
-    else
-    {
+    using Operator = typename TracerSolverSelector<TracerMatrix,TracerVector>::TracerOperator;
+    std::unique_ptr<Operator> parallelOperator;
+    std::unique_ptr<typename TracerSolverSelector<TracerMatrix,TracerVector>::type> parallelSolver;
 #endif
-        using TracerSolver = Dune::BiCGSTABSolver<TracerVector>;
-        using TracerOperator = Dune::MatrixAdapter<TracerMatrix,TracerVector,TracerVector>;
-        using TracerScalarProduct = Dune::SeqScalarProduct<TracerVector>;
-        using TracerPreconditioner = Dune::SeqILU< TracerMatrix,TracerVector,TracerVector>;
-
-        TracerOperator tracerOperator(M);
-        TracerScalarProduct tracerScalarProduct;
-        TracerPreconditioner tracerPreconditioner(M, 0, 1); // results in ILU0
-
-        TracerSolver solver (tracerOperator, tracerScalarProduct,
-                             tracerPreconditioner, tolerance, maxIter,
-                             verbosity);
+    std::unique_ptr<MultiRhsBiCGSTAB<TracerMatrix>> sequentialSolver;
+};
 
-        Dune::InverseOperatorResult result;
-        solver.apply(x, b, result);
+template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
+EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
+~EclGenericTracerModel() = default;
 
-        // return the result of the solver
-        return result.converged;
-#if HAVE_MPI
-    }
-#endif
+template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
+bool EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
+linearSolve_(const TracerMatrix& M, TracerVector& x, TracerVector& b)
+{
+    std::vector<TracerVector> xs(1, x);
+    std::vector<TracerVector> bs(1, b);
+    const bool converged = linearSolveBatchwise_(M, xs, bs);
+    x = std::move(xs.front());
+    return converged;
 }
 
 template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
@@ -326,20 +296,33 @@ linearSolveBatchwise_(const TracerMatrix& M, std::vector<TracerVector>& x, std::
     Scalar tolerance = 1e-2;
     int maxIter = 100;
 
-    int verbosity = 0;
-    PropertyTree prm;
-    prm.put("maxiter", maxIter);
-    prm.put("tol", tolerance);
-    prm.put("verbosity", verbosity);
-    prm.put("solver", std::string("bicgstab"));
-    prm.put("preconditioner.type", std::string("ParOverILU0"));
+    // The matrix is allocated once, hence the solvers are only created for
+    // the first solve and their preconditioners updated for the later ones.
+    const bool reuse = tracerSolver_ && tracerSolver_->matrix == &M;
+    if (!reuse) {
+        tracerSolver_ = std::make_unique<TracerSolver>();
+        tracerSolver_->matrix = &M;
+    }
 
 #if HAVE_MPI
     if(gridView_.grid().comm().size() > 1)
     {
-        auto [tracerOperator, solver] =
-            createParallelFlexibleSolver<TracerVector>(gridView_.grid(), M, prm);
-        (void) tracerOperator;
+        auto& solver = tracerSolver_->parallelSolver;
+        if (!solver) {
+            int verbosity = 0;
+            PropertyTree prm;
+            prm.put("maxiter", maxIter);
+            prm.put("tol", tolerance);
+            prm.put("verbosity", verbosity);
+            prm.put("solver", std::string("bicgstab"));
+            prm.put("preconditioner.type", std::string("ParOverILU0"));
+
+            std::tie(tracerSolver_->parallelOperator, solver) =
+                createParallelFlexibleSolver<TracerVector>(gridView_.grid(), M, prm);
+        } else {
+            solver->preconditioner().update();
+        }
+
         bool converged = true;
         for (size_t nrhs =0; nrhs < b.size(); ++nrhs) {
             x[nrhs] = 0.0;
@@ -352,32 +335,100 @@ linearSolveBatchwise_(const TracerMatrix& M, std::vector<TracerVector>& x, std::
     else
     {
 #endif
-        using TracerSolver = Dune::BiCGSTABSolver<TracerVector>;
-        using TracerOperator = Dune::MatrixAdapter<TracerMatrix,TracerVector,TracerVector>;
-        using TracerScalarProduct = Dune::SeqScalarProduct<TracerVector>;
-        using TracerPreconditioner = Dune::SeqILU< TracerMatrix,TracerVector,TracerVector>;
+        if (upwindSweep_(M, x, b)) {
+            return true;
+        }
 
-        TracerOperator tracerOperator(M);
-        TracerScalarProduct tracerScalarProduct;
-        TracerPreconditioner tracerPreconditioner(M, 0, 1); // results in ILU0
+        // The right hand sides share the matrix sweeps and the ILU0 factorisation.
+        auto& solver = tracerSolver_->sequentialSolver;
+        if (!solver) {
+            solver = std::make_unique<MultiRhsBiCGSTAB<TracerMatrix>>(M);
+        } else {
+            solver->update(M);
+        }
+        return solver->solve(x, b, tolerance, maxIter);
+#if HAVE_MPI
+    }
+#endif
+}
 
-        TracerSolver solver (tracerOperator, tracerScalarProduct,
-                             tracerPreconditioner, tolerance, maxIter,
-                             verbosity);
+template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
+bool EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
+upwindSweep_(const TracerMatrix& M, std::vector<TracerVector>& x, const std::vector<TracerVector>& b) const
+{
+    // With upstream weighting the entry (J, I) is nonzero only if I is
+    // upstream of J. If the flow field has no cycles, the matrix is
+    // triangular with the cells in topological order of the flow.
+    const size_t n = M.N();
+    std::vector<unsigned> numUpstream(n, 0);
+    std::vector<unsigned> downstreamBegin(n + 1, 0);
+    for (auto row = M.begin(); row != M.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            if (col.index() != row.index() && (*col)[0][0] != 0.0) {
+                ++numUpstream[row.index()];
+                ++downstreamBegin[col.index() + 1];
+            }
+        }
+    }
+    for (size_t I = 0; I < n; ++I) {
+        downstreamBegin[I + 1] += downstreamBegin[I];
+    }
+    std::vector<unsigned> downstream(downstreamBegin.back());
+    auto pos = downstreamBegin;
+    for (auto row = M.begin(); row != M.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            if (col.index() != row.index() && (*col)[0][0] != 0.0) {
+                downstream[pos[col.index()]++] = row.index();
+            }
+        }
+    }
 
-        bool converged = true;
-        for (size_t nrhs =0; nrhs < b.size(); ++nrhs) {
-            x[nrhs] = 0.0;
-            Dune::InverseOperatorResult result;
-            solver.apply(x[nrhs], b[nrhs], result);
-            converged = (converged && result.converged);
+    std::vector<unsigned> order;
+    order.reserve(n);
+    for (size_t I = 0; I < n; ++I) {
+        if (numUpstream[I] == 0) {
+            order.push_back(I);
+        }
+    }
+    for (size_t k = 0; k < order.size(); ++k) {
+        const unsigned I = order[k];
+        for (unsigned d = downstreamBegin[I]; d < downstreamBegin[I + 1]; ++d) {
+            if (--numUpstream[downstream[d]] == 0) {
+                order.push_back(downstream[d]);
+            }
         }
+    }
+    if (order.size() < n) {
+        return false;
+    }
 
-        // return the result of the solver
-        return converged;
-#if HAVE_MPI
+    for (size_t nrhs = 0; nrhs < b.size(); ++nrhs) {
+        x[nrhs].resize(n);
     }
-#endif
+    for (const unsigned I : order) {
+        Scalar diag = 0.0;
+        for (size_t nrhs = 0; nrhs < b.size(); ++nrhs) {
+            x[nrhs][I][0] = b[nrhs][I][0];
+        }
+        const auto& row = M[I];
+        for (auto col = row.begin(); col != row.end(); ++col) {
+            const Scalar a = (*col)[0][0];
+            if (col.index() == I) {
+                diag = a;
+            } else if (a != 0.0) {
+                for (size_t nrhs = 0; nrhs < b.size(); ++nrhs) {
+                    x[nrhs][I][0] -= a * x[nrhs][col.index()][0];
+                }
+            }
+        }
+        if (diag == 0.0) {
+            return false;
+        }
+        for (size_t nrhs = 0; nrhs < b.size(); ++nrhs) {
+            x[nrhs][I][0] /= diag;
+        }
+    }
+    return true;
 }
 
 #if HAVE_DUNE_FEM
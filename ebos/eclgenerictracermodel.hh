@@ -37,6 +37,7 @@
 
 #include <dune/common/version.hh>
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -52,6 +53,9 @@ public:
     using TracerVector = Dune::BlockVector<Dune::FieldVector<Scalar,1>>;
     using CartesianIndexMapper = Dune::CartesianIndexMapper<Grid>;
     static const int dimWorld = Grid::dimensionworld;
+
+    ~EclGenericTracerModel();
+
     /*!
      * \brief Return the number of tracers considered by the tracerModel.
      */
@@ -96,6 +100,14 @@ protected:
 
     bool linearSolveBatchwise_(const TracerMatrix& M, std::vector<TracerVector>& x, std::vector<TracerVector>& b);
 
+    // Solve by substitution in the order of the flow, false if the flow has cycles.
+    bool upwindSweep_(const TracerMatrix& M, std::vector<TracerVector>& x, const std::vector<TracerVector>& b) const;
+
+    // The solvers are kept between the solves, only the values of the
+    // tracer matrix change.
+    struct TracerSolver;
+    std::unique_ptr<TracerSolver> tracerSolver_;
+
     const GridView& gridView_;
     const EclipseState& eclState_;
     const CartesianIndexMapper& cartMapper_;
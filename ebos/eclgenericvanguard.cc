@@ -299,7 +299,7 @@ void EclGenericVanguard::init()
     readDeck(EclGenericVanguard::comm(), fileName_, deck_, eclState_, eclSchedule_, udqState_, actionState_, wtestState_,
              eclSummaryConfig_, std::move(errorGuard), python,
              std::move(parseContext_), /* initFromRestart = */ false,
-             /* checkDeck = */ enableExperiments_, outputInterval_);
+             /* checkDeck = */ enableExperiments_, outputInterval_, deckCacheFile_);
 
     if (EclGenericVanguard::externalUDQState_)
         this->udqState_ = std::move(EclGenericVanguard::externalUDQState_);
@@ -365,6 +365,14 @@ void EclGenericVanguard::init()
     }
 }
 
+void EclGenericVanguard::resetRunState()
+{
+    // the states are assigned in place since the simulator keeps references to them
+    *this->summaryState_ = SummaryState( TimeService::from_time_t(this->eclSchedule_->getStartTime()) );
+    *this->udqState_ = UDQState( this->eclSchedule_->getUDQConfig(0).params().undefinedValue() );
+    *this->actionState_ = Action::State();
+}
+
 bool EclGenericVanguard::drsdtconEnabled() const
 {
   for (const auto& schIt : this->schedule()) {
@@ -233,6 +233,13 @@ public:
         return *this->wtestState_.release();
     }
 
+    /*!
+     * \brief Reset the summary, UDQ and action states to the start of the schedule.
+     *
+     * This is used to run the same case again without setting up the grid anew.
+     */
+    void resetRunState();
+
 
     /*!
      * \brief Returns the name of the case.
@@ -268,12 +275,32 @@ public:
     double zoltanImbalanceTol() const
     { return zoltanImbalanceTol_; }
 
+    /*!
+     * \brief Number of layers of overlap cells of each process.
+     */
+    int numOverlap() const
+    { return numOverlap_; }
+
     /*!
      * \brief Whether perforations of a well might be distributed.
      */
     bool enableDistributedWells() const
     { return enableDistributedWells_; }
 
+    /*!
+     * \brief Name of the file caching the partition of the grid, empty if
+     *        the partition is not cached.
+     */
+    const std::string& partitionCacheFile() const
+    { return partitionCacheFile_; }
+
+    /*!
+     * \brief Method used to partition the grid, "zoltan" or one of the
+     *        geometric methods.
+     */
+    const std::string& partitionMethod() const
+    { return partitionMethod_; }
+
     /*!
      * \brief Returns vector with name and whether the has local perforated cells
      *        for all wells.
@@ -322,11 +349,15 @@ protected:
 
     std::string caseName_;
     std::string fileName_;
+    std::string deckCacheFile_;
     Dune::EdgeWeightMethod edgeWeightsMethod_;
     bool ownersFirst_;
     bool serialPartitioning_;
     double zoltanImbalanceTol_;
+    int numOverlap_;
     bool enableDistributedWells_;
+    std::string partitionCacheFile_;
+    std::string partitionMethod_;
     std::string ignoredKeywords_;
     bool eclStrictParsing_;
     std::optional<int> outputInterval_;
@@ -40,6 +40,7 @@
 #include <opm/input/eclipse/Schedule/SummaryState.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQState.hpp>
 #include <opm/input/eclipse/Units/UnitSystem.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
 
 #include <dune/grid/common/mcmgmapper.hh>
 
@@ -53,7 +54,12 @@
 #include <mpi.h>
 #endif
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -126,6 +132,30 @@ getInterRegFlowsAsMap(const Opm::EclInterRegFlowMap& map)
     return maps;
 }
 
+// Round the values to the given relative precision by clearing the trailing
+// bits of their mantissas. The arrays stay readable as they are, and the
+// many equal trailing bits make the files compress much better.
+void roundToPrecision(std::vector<double>& values, const double relativePrecision)
+{
+    const int keepBits = std::clamp(static_cast<int>(std::ceil(-std::log2(relativePrecision))), 1, 52);
+    const int dropBits = 52 - keepBits;
+    if (dropBits == 0) {
+        return;
+    }
+
+    const std::uint64_t half = std::uint64_t{1} << (dropBits - 1);
+    const std::uint64_t mask = ~((std::uint64_t{1} << dropBits) - 1);
+    for (auto& value : values) {
+        if (!std::isfinite(value)) {
+            continue;
+        }
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = (bits + half) & mask;
+        std::memcpy(&value, &bits, sizeof(bits));
+    }
+}
+
 struct EclWriteTasklet : public Opm::TaskletInterface
 {
     Opm::Action::State actionState_;
@@ -138,6 +168,8 @@ struct EclWriteTasklet : public Opm::TaskletInterface
     double secondsElapsed_;
     Opm::RestartValue restartValue_;
     bool writeDoublePrecision_;
+    double restartPrecision_;
+    std::function<void()> finished_;
 
     explicit EclWriteTasklet(const Opm::Action::State& actionState,
                              const Opm::WellTestState& wtestState,
@@ -148,7 +180,9 @@ struct EclWriteTasklet : public Opm::TaskletInterface
                              bool isSubStep,
                              double secondsElapsed,
                              Opm::RestartValue restartValue,
-                             bool writeDoublePrecision)
+                             bool writeDoublePrecision,
+                             double restartPrecision,
+                             std::function<void()> finished)
         : actionState_(actionState)
         , wtestState_(wtestState)
         , summaryState_(summaryState)
@@ -157,22 +191,35 @@ struct EclWriteTasklet : public Opm::TaskletInterface
         , reportStepNum_(reportStepNum)
         , isSubStep_(isSubStep)
         , secondsElapsed_(secondsElapsed)
-        , restartValue_(restartValue)
+        , restartValue_(std::move(restartValue))
         , writeDoublePrecision_(writeDoublePrecision)
+        , restartPrecision_(restartPrecision)
+        , finished_(std::move(finished))
     { }
 
     // callback to eclIO serial writeTimeStep method
     void run()
     {
-        eclIO_.writeTimeStep(actionState_,
-                             wtestState_,
-                             summaryState_,
-                             udqState_,
-                             reportStepNum_,
-                             isSubStep_,
-                             secondsElapsed_,
-                             restartValue_,
-                             writeDoublePrecision_);
+        try {
+            if (restartPrecision_ > 0.0) {
+                for (auto& entry : restartValue_.solution) {
+                    roundToPrecision(entry.second.data, restartPrecision_);
+                }
+            }
+            eclIO_.writeTimeStep(actionState_,
+                                 wtestState_,
+                                 summaryState_,
+                                 udqState_,
+                                 reportStepNum_,
+                                 isSubStep_,
+                                 secondsElapsed_,
+                                 restartValue_,
+                                 writeDoublePrecision_);
+        } catch (...) {
+            finished_();
+            throw;
+        }
+        finished_();
     }
 };
 
@@ -191,6 +238,7 @@ EclGenericWriter(const Schedule& schedule,
                  const Dune::CartesianIndexMapper<Grid>& cartMapper,
                  const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper,
                  bool enableAsyncOutput,
+                 int maxPendingOutput,
                  bool enableEsmry )
     : collectToIORank_(grid,
                        equilGrid,
@@ -229,6 +277,7 @@ EclGenericWriter(const Schedule& schedule,
     int numWorkerThreads = 0;
     if (enableAsyncOutput && collectToIORank_.isIORank())
         numWorkerThreads = 1;
+    maxPendingOutput_ = std::max(maxPendingOutput, 1);
     taskletRunner_.reset(new TaskletRunner(numWorkerThreads));
 }
 
@@ -244,7 +293,7 @@ template<class Grid, class EquilGrid, class GridView, class ElementMapper, class
 void EclGenericWriter<Grid,EquilGrid,GridView,ElementMapper,Scalar>::
 writeInit()
 {
-    if (collectToIORank_.isIORank()) {
+    if (collectToIORank_.isIORank() && this->writesInitialFiles()) {
         std::map<std::string, std::vector<int> > integerVectors;
         if (collectToIORank_.isParallel())
             integerVectors.emplace("MPI_RANK", collectToIORank_.globalRanks());
@@ -254,6 +303,14 @@ writeInit()
     }
 }
 
+template<class Grid, class EquilGrid, class GridView, class ElementMapper, class Scalar>
+bool EclGenericWriter<Grid,EquilGrid,GridView,ElementMapper,Scalar>::
+writesInitialFiles() const
+{
+    const auto& ioConfig = eclState_.cfg().io();
+    return ioConfig.getWriteINITFile() || ioConfig.getWriteEGRIDFile();
+}
+
 template<class Grid, class EquilGrid, class GridView, class ElementMapper, class Scalar>
 data::Solution EclGenericWriter<Grid,EquilGrid,GridView,ElementMapper,Scalar>::
 computeTrans_(const std::unordered_map<int,int>& cartesianToActive) const
@@ -427,8 +484,10 @@ doWriteOutput(const int                     reportStepNum,
               const std::vector<Scalar>& thresholdPressure,
               Scalar curTime,
               Scalar nextStepSize,
-              bool doublePrecision)
+              bool doublePrecision,
+              double restartPrecision)
 {
+    ScopedTimer writeTimer(TimingRegistry::Region::OutputWrite);
     const auto isParallel = this->collectToIORank_.isParallel();
 
     RestartValue restartValue {
@@ -461,12 +520,25 @@ doWriteOutput(const int                     reportStepNum,
         actionState,
         isParallel ? this->collectToIORank_.globalWellTestState() : std::move(localWTestState),
         summaryState, udqState, *this->eclIO_,
-        reportStepNum, isSubStep, curTime, std::move(restartValue), doublePrecision);
-
-    // then, make sure that the previous I/O request has been completed
-    // and the number of incomplete tasklets does not increase between
-    // time steps
-    this->taskletRunner_->barrier();
+        reportStepNum, isSubStep, curTime, std::move(restartValue), doublePrecision,
+        restartPrecision,
+        [this]()
+        {
+            std::lock_guard<std::mutex> lock(this->pendingOutputMutex_);
+            --this->numPendingOutput_;
+            this->pendingOutputFinished_.notify_all();
+        });
+
+    // then, wait until fewer than the allowed number of I/O requests are
+    // pending. The tasklets run in order on a single worker thread, and only
+    // the memory held by the queued results limits how far the simulation
+    // may run ahead of the output
+    {
+        std::unique_lock<std::mutex> lock(this->pendingOutputMutex_);
+        this->pendingOutputFinished_.wait(lock, [this]()
+        { return this->numPendingOutput_ < this->maxPendingOutput_; });
+        ++this->numPendingOutput_;
+    }
 
     // finally, start a new output writing job
     this->taskletRunner_->dispatch(std::move(eclWriteTasklet));
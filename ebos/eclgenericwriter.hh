@@ -34,8 +34,10 @@
 #include <opm/models/parallel/tasklets.hh>
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
 
+#include <condition_variable>
 #include <cstddef>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -79,12 +81,17 @@ public:
                      const Dune::CartesianIndexMapper<Grid>& cartMapper,
                      const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper,
                      bool enableAsyncOutput,
+                     int maxPendingOutput,
                      bool enableEsmry);
 
     const EclipseIO& eclIO() const;
 
     void writeInit();
 
+    /// Whether writeInit() writes an INIT or EGRID file and hence needs
+    /// the global transmissibilities.
+    bool writesInitialFiles() const;
+
     void setTransmissibilities(const TransmissibilityType* globalTrans)
     {
         globalTrans_ = globalTrans;
@@ -116,7 +123,8 @@ protected:
                        const std::vector<Scalar>& thresholdPressure,
                        Scalar curTime,
                        Scalar nextStepSize,
-                       bool doublePrecision);
+                       bool doublePrecision,
+                       double restartPrecision);
 
     void evalSummary(int reportStepNum,
                      Scalar curTime,
@@ -141,6 +149,11 @@ protected:
     const SummaryConfig& summaryConfig_;
     std::unique_ptr<EclipseIO> eclIO_;
     std::unique_ptr<TaskletRunner> taskletRunner_;
+    // write tasklets that have been dispatched but not completed yet
+    std::mutex pendingOutputMutex_;
+    std::condition_variable pendingOutputFinished_;
+    int numPendingOutput_ = 0;
+    int maxPendingOutput_ = 1;
     Scalar restartTimeStepSize_;
     const TransmissibilityType* globalTrans_ = nullptr;
     const Dune::CartesianIndexMapper<Grid>& cartMapper_;
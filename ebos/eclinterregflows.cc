@@ -148,6 +148,18 @@ addConnection(const Cell& source,
     }
 }
 
+bool
+Opm::EclInterRegFlowMap::
+isInterRegionConnection(const int activeIndex1,
+                        const int activeIndex2) const
+{
+    return std::any_of(this->regionMaps_.begin(), this->regionMaps_.end(),
+                       [activeIndex1, activeIndex2](const auto& regionMap)
+                       {
+                           return regionMap.isInterRegionConnection(activeIndex1, activeIndex2);
+                       });
+}
+
 void Opm::EclInterRegFlowMap::compress()
 {
     for (auto& regionMap : this->regionMaps_) {
@@ -98,6 +98,17 @@ namespace Opm {
         /// Mostly intended for summary output purposes.
         const data::InterRegFlowMap& getInterRegFlows() const;
 
+        /// Whether or not two cells are in different regions.
+        ///
+        /// \param[in] activeIndex1 Active index of first cell on local rank.
+        ///
+        /// \param[in] activeIndex2 Active index of second cell on local rank.
+        bool isInterRegionConnection(const int activeIndex1,
+                                     const int activeIndex2) const
+        {
+            return this->region_[activeIndex1] != this->region_[activeIndex2];
+        }
+
         /// Retrieve maximum FIP region ID on local MPI rank.
         std::size_t getLocalMaxRegionID() const;
 
@@ -258,6 +269,16 @@ namespace Opm {
         /// Mostly intended for summary output purposes.
         std::vector<data::InterRegFlowMap> getInterRegFlows() const;
 
+        /// Whether or not two cells are in different regions of at least
+        /// one region definition array.  Connections for which this is
+        /// false do not contribute to any of the flow maps.
+        ///
+        /// \param[in] activeIndex1 Active index of first cell on local rank.
+        ///
+        /// \param[in] activeIndex2 Active index of second cell on local rank.
+        bool isInterRegionConnection(const int activeIndex1,
+                                     const int activeIndex2) const;
+
         /// Retrieve maximum FIP region ID on local MPI rank.
         std::vector<std::size_t> getLocalMaxRegionID() const;
 
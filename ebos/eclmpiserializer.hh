@@ -24,7 +24,12 @@
 #include <dune/common/version.hh>
 #include <opm/simulators/utils/ParallelRestart.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
 #include <optional>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -75,6 +80,15 @@ public:
     template <typename T, bool complexType = true>
     void vector(std::vector<T>& data)
     {
+        if constexpr (!complexType && is_contiguous_scalar<T>::value) {
+            size_t size = data.size();
+            (*this)(size);
+            if (m_op == Operation::UNPACK)
+                data.resize(size);
+            contiguous(data.data(), data.size());
+            return;
+        }
+
         auto handle = [&](auto& d)
         {
             for (auto& it : d) {
@@ -108,6 +122,13 @@ public:
     {
         using T = typename Array::value_type;
 
+        if constexpr (!complexType && is_std_array<Array>::value && is_contiguous_scalar<T>::value) {
+            size_t size = data.size();
+            (*this)(size);
+            contiguous(data.data(), data.size());
+            return;
+        }
+
         auto handle = [&](auto& d) {
             for (auto& it : d) {
                 if constexpr (is_pair<T>::value)
@@ -422,6 +443,198 @@ public:
         }
     }
 
+    //! \brief Returns the serialized representation of data.
+    //! \tparam T Type of class to serialize
+    //! \param data Class to serialize
+    template<class T>
+    std::vector<char> serialized(T& data)
+    {
+        pack(data);
+        m_buffer.resize(m_position);
+        std::vector<char> result;
+        result.swap(m_buffer);
+        return result;
+    }
+
+    //! \brief De-serialize data from its serialized representation.
+    //! \tparam T Type of class to de-serialize
+    //! \param data Class to de-serialize
+    //! \param buffer Serialized representation, as returned by serialized()
+    template<class T>
+    void fromSerialized(T& data, std::vector<char> buffer)
+    {
+        m_buffer.swap(buffer);
+        unpack(data);
+        std::vector<char>().swap(m_buffer);
+    }
+
+    //! \brief Send the changes of data on the root process to the others.
+    //!
+    //! \details Only the byte ranges of the serialized representation which
+    //!          differ from \p previous are broadcast, and the other
+    //!          processes apply them to \p previous before de-serializing.
+    //!          The full representation is broadcast if the size changed.
+    //! \tparam T Type of class to broadcast
+    //! \param data Class to broadcast
+    //! \param previous Serialized representation of data before the change,
+    //!                 which must be the same on all processes
+    template<class T>
+    void broadcastChanges(T& data, std::vector<char> previous)
+    {
+        if (m_comm.size() == 1)
+            return;
+
+        // header: status, buffer size, number of changed ranges
+        enum : size_t { Delta = 0, Full = 1, Failed = std::numeric_limits<size_t>::max() };
+        std::array<size_t, 3> header{Delta, 0, 0};
+        std::vector<size_t> ranges;
+        std::vector<char> bytes;
+
+        if (m_comm.rank() == 0) {
+            try {
+                pack(data);
+                header[1] = m_position;
+                if (static_cast<size_t>(m_position) != previous.size()) {
+                    header[0] = Full;
+                } else {
+                    // Ranges separated by less than a few bytes are merged.
+                    const size_t gap = 64;
+                    size_t i = 0;
+                    while (i < previous.size()) {
+                        if (m_buffer[i] == previous[i]) {
+                            ++i;
+                            continue;
+                        }
+                        const size_t begin = i;
+                        size_t end = i + 1;
+                        for (size_t j = end; j < previous.size() && j < end + gap; ++j) {
+                            if (m_buffer[j] != previous[j])
+                                end = j + 1;
+                        }
+                        ranges.push_back(begin);
+                        ranges.push_back(end - begin);
+                        bytes.insert(bytes.end(), m_buffer.begin() + begin, m_buffer.begin() + end);
+                        i = end;
+                    }
+                    header[2] = ranges.size() / 2;
+                }
+            } catch (...) {
+                header[0] = Failed;
+                m_comm.broadcast(header.data(), header.size(), 0);
+                throw;
+            }
+        }
+
+        m_comm.broadcast(header.data(), header.size(), 0);
+        if (header[0] == Failed) {
+            throw std::runtime_error("Error detected in parallel serialization");
+        }
+
+        if (header[0] == Full) {
+            m_buffer.resize(header[1]);
+            m_comm.broadcast(m_buffer.data(), header[1], 0);
+        } else {
+            ranges.resize(2 * header[2]);
+            m_comm.broadcast(ranges.data(), ranges.size(), 0);
+            size_t numBytes = 0;
+            for (size_t r = 0; r < header[2]; ++r)
+                numBytes += ranges[2 * r + 1];
+            bytes.resize(numBytes);
+            m_comm.broadcast(bytes.data(), numBytes, 0);
+            if (m_comm.rank() != 0) {
+                auto src = bytes.begin();
+                for (size_t r = 0; r < header[2]; ++r) {
+                    std::copy(src, src + ranges[2 * r + 1], previous.begin() + ranges[2 * r]);
+                    src += ranges[2 * r + 1];
+                }
+                m_buffer.swap(previous);
+            }
+        }
+
+        if (m_comm.rank() != 0)
+            unpack(data);
+        std::vector<char>().swap(m_buffer);
+    }
+
+#if HAVE_MPI
+    //! \brief Serialize on root process, de-serialize on the others with
+    //! one copy of the serialized data per compute node.
+    //!
+    //! \details The data is broadcast to the first process of each node
+    //!          only, which places it in an MPI-3 shared memory window.
+    //!          The other processes of the node de-serialize from that
+    //!          window rather than receiving their own message.
+    //! \tparam T Type of class to broadcast
+    //! \param data Class to broadcast
+    template<class T>
+    void broadcastNodeShared(T& data)
+    {
+        if (m_comm.size() == 1)
+            return;
+
+        MPI_Comm comm = m_comm;
+        const int rank = m_comm.rank();
+        MPI_Comm nodeComm;
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+        int nodeRank = 0;
+        MPI_Comm_rank(nodeComm, &nodeRank);
+        MPI_Comm leaderComm;
+        MPI_Comm_split(comm, nodeRank == 0 ? 0 : MPI_UNDEFINED, rank, &leaderComm);
+
+        auto freeComms = [&nodeComm, &leaderComm]()
+        {
+            if (leaderComm != MPI_COMM_NULL)
+                MPI_Comm_free(&leaderComm);
+            MPI_Comm_free(&nodeComm);
+        };
+
+        if (rank == 0) {
+            try {
+                pack(data);
+                m_packSize = m_position;
+            } catch (...) {
+                m_packSize = std::numeric_limits<size_t>::max();
+                m_comm.broadcast(&m_packSize, 1, 0);
+                freeComms();
+                throw;
+            }
+        }
+        m_comm.broadcast(&m_packSize, 1, 0);
+        if (m_packSize == std::numeric_limits<size_t>::max()) {
+            freeComms();
+            throw std::runtime_error("Error detected in parallel serialization");
+        }
+
+        char* shared = nullptr;
+        MPI_Win window;
+        MPI_Win_allocate_shared(static_cast<MPI_Aint>(nodeRank == 0 ? m_packSize : 0), 1, MPI_INFO_NULL,
+                                nodeComm, &shared, &window);
+        if (nodeRank != 0) {
+            MPI_Aint size;
+            int dispUnit;
+            MPI_Win_shared_query(window, 0, &size, &dispUnit, &shared);
+        }
+
+        MPI_Win_fence(0, window);
+        if (nodeRank == 0) {
+            if (rank == 0)
+                std::copy(m_buffer.begin(), m_buffer.begin() + m_packSize, shared);
+            MPI_Bcast(shared, static_cast<int>(m_packSize), MPI_CHAR, 0, leaderComm);
+        }
+        MPI_Win_fence(0, window);
+
+        if (rank != 0) {
+            m_buffer.assign(shared, shared + m_packSize);
+        }
+        MPI_Win_free(&window);
+        freeComms();
+
+        if (rank != 0)
+            unpack(data);
+        std::vector<char>().swap(m_buffer);
+    }
+#endif
+
     //! \brief Returns current position in buffer.
     size_t position() const
     {
@@ -491,6 +704,49 @@ protected:
         constexpr static bool value = true;
     };
 
+    //! \brief Predicate for std::array.
+    template<class T>
+    struct is_std_array {
+        constexpr static bool value = false;
+    };
+
+    template<class T1, std::size_t N>
+    struct is_std_array<std::array<T1,N>> {
+        constexpr static bool value = true;
+    };
+
+    //! \brief Predicate for values which are packed as one block when stored
+    //!        contiguously.
+    template<class T>
+    struct is_contiguous_scalar {
+        constexpr static bool value = (std::is_arithmetic<T>::value || std::is_enum<T>::value)
+                                      && !std::is_same<T,bool>::value;
+    };
+
+    //! \brief (De-)serialization of n contiguous scalars with a single
+    //!        MPI call, rather than one call per element.
+    template<class T>
+    void contiguous(T* data, std::size_t n)
+    {
+#if HAVE_MPI
+        const auto type = Dune::MPITraits<T>::getType();
+        if (m_op == Operation::PACKSIZE) {
+            int size = 0;
+            MPI_Pack_size(static_cast<int>(n), type, m_comm, &size);
+            m_packSize += size;
+        } else if (m_op == Operation::PACK) {
+            MPI_Pack(data, static_cast<int>(n), type, m_buffer.data(),
+                     m_buffer.size(), &m_position, m_comm);
+        } else if (m_op == Operation::UNPACK) {
+            MPI_Unpack(m_buffer.data(), m_buffer.size(), &m_position, data,
+                       static_cast<int>(n), type, m_comm);
+        }
+#else
+        (void) data;
+        (void) n;
+#endif
+    }
+
     //! \brief Predicate for std::optional.
     template<class T>
     struct is_optional {
@@ -35,6 +35,9 @@
 
 #include <opm/material/common/Unused.hpp>
 
+#include <utility>
+#include <vector>
+
 namespace Opm::Properties {
 
 template<class TypeTag, class MyTypeTag>
@@ -57,6 +60,10 @@ template<class TypeTag, class MyTypeTag>
 struct EclNewtonRelaxedTolerance {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct EclNewtonMaxPrimaryVariableSwitches {
+    using type = UndefinedProperty;
+};
 
 } // namespace Opm::Properties
 
@@ -102,6 +109,7 @@ public:
         relaxedTolerance_ = EWOMS_GET_PARAM(TypeTag, Scalar, EclNewtonRelaxedTolerance);
 
         numStrictIterations_ = EWOMS_GET_PARAM(TypeTag, int, EclNewtonStrictIterations);
+        maxPrimaryVariableSwitches_ = EWOMS_GET_PARAM(TypeTag, int, EclNewtonMaxPrimaryVariableSwitches);
     }
 
     /*!
@@ -129,6 +137,11 @@ public:
                              "The maximum error which the volumetric residual "
                              "may exhibit if it is in a 'relaxed' "
                              "region during a strict iteration.");
+        EWOMS_REGISTER_PARAM(TypeTag, int, EclNewtonMaxPrimaryVariableSwitches,
+                             "The number of times the primary variables of a cell "
+                             "may switch during a time step. Further switches are "
+                             "rejected, and the cell keeps its values of the last "
+                             "iteration. 0 for no limit.");
     }
 
     /*!
@@ -244,6 +257,59 @@ public:
                                         +std::to_string(double(newtonMaxError)));
     }
 
+    /*!
+     * \brief Update the solution, counting the cells whose primary variables
+     *        switch, and keeping cells which switched too often in their state.
+     */
+    void update_(SolutionVector& nextSolution,
+                 const SolutionVector& currentSolution,
+                 const GlobalEqVector& solutionUpdate,
+                 const GlobalEqVector& currentResidual)
+    {
+        if (this->numIterations() == 0 || switchCount_.size() != nextSolution.size()) {
+            switchCount_.assign(nextSolution.size(), 0);
+        }
+        numSwitchedCells_ = 0;
+        numFrozenCells_ = 0;
+        ParentType::update_(nextSolution, currentSolution, solutionUpdate, currentResidual);
+    }
+
+    void updatePrimaryVariables_(unsigned globalDofIdx,
+                                 PrimaryVariables& nextValue,
+                                 const PrimaryVariables& currentValue,
+                                 const EqVector& update,
+                                 const EqVector& currentResidual)
+    {
+        // the next and the current solution are usually the same object
+        const auto meaning = currentValue.primaryVarsMeaning();
+        const bool mayFreeze = maxPrimaryVariableSwitches_ > 0
+            && switchCount_[globalDofIdx] >= maxPrimaryVariableSwitches_;
+        const PrimaryVariables previousValue = mayFreeze ? currentValue : PrimaryVariables();
+
+        ParentType::updatePrimaryVariables_(globalDofIdx, nextValue, currentValue, update, currentResidual);
+
+        if (nextValue.primaryVarsMeaning() == meaning) {
+            return;
+        }
+        const bool isLocal = this->model().isLocalDof(globalDofIdx);
+        if (mayFreeze) {
+            nextValue = previousValue;
+            numFrozenCells_ += isLocal;
+            return;
+        }
+        ++switchCount_[globalDofIdx];
+        numSwitchedCells_ += isLocal;
+    }
+
+    /*!
+     * \brief The number of interior cells whose primary variables switched in
+     *        the last update, and of those which were kept from switching.
+     */
+    std::pair<long int, long int> primaryVariableSwitches() const
+    {
+        return {numSwitchedCells_, numFrozenCells_};
+    }
+
     void endIteration_(SolutionVector& nextSolution,
                        const SolutionVector& currentSolution)
     {
@@ -264,6 +330,12 @@ private:
     Scalar sumTolerance_;
 
     int numStrictIterations_;
+
+    int maxPrimaryVariableSwitches_;
+    // number of switches of every cell during the current time step
+    std::vector<int> switchCount_;
+    long int numSwitchedCells_ = 0;
+    long int numFrozenCells_ = 0;
 };
 } // namespace Opm
 
@@ -32,7 +32,9 @@
 #include <optional>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <opm/models/blackoil/blackoilproperties.hh>
 
@@ -106,6 +108,7 @@ class EclOutputBlackOilModule : public EclGenericOutputBlackoilModule<GetPropTyp
     using Scalar = GetPropType<TypeTag, Properties::Scalar>;
     using Evaluation = GetPropType<TypeTag, Properties::Evaluation>;
     using ElementContext = GetPropType<TypeTag, Properties::ElementContext>;
+    using ExtensiveQuantities = GetPropType<TypeTag, Properties::ExtensiveQuantities>;
     using MaterialLaw = GetPropType<TypeTag, Properties::MaterialLaw>;
     using MaterialLawParams = GetPropType<TypeTag, Properties::MaterialLawParams>;
     using FluidSystem = GetPropType<TypeTag, Properties::FluidSystem>;
@@ -156,6 +159,18 @@ public:
             }
         }
 
+        // Resolve the block keywords once, such that processElement() only
+        // visits the block vectors of its own cell.
+        for (auto& [key, value] : this->blockData_) {
+            const auto quantity = blockQuantity_(key.first);
+            if (quantity == BlockQuantity::Unhandled) {
+                OpmLog::warning("Unhandled output keyword",
+                                "Keyword '" + key.first + "' is unhandled for output to file.");
+                continue;
+            }
+            this->blockEntries_[key.second - 1].emplace_back(quantity, &value);
+        }
+
         for (const auto& global_index : wbp_index_list) {
             if (collectToIORank.isCartIdxOnThisRank(global_index - 1))
                 this->wbpData_[global_index] = 0.0;
@@ -397,6 +412,9 @@ public:
                 }
                 catch (const NumericalIssue&) {
                     const auto cartesianIdx = elemCtx.simulator().vanguard().grid().globalCell()[globalDofIdx];
+#ifdef _OPENMP
+#pragma omp critical
+#endif
                     this->failedCellsPb_.push_back(cartesianIdx);
                 }
             }
@@ -406,6 +424,9 @@ public:
                 }
                 catch (const NumericalIssue&) {
                     const auto cartesianIdx = elemCtx.simulator().vanguard().grid().globalCell()[globalDofIdx];
+#ifdef _OPENMP
+#pragma omp critical
+#endif
                     this->failedCellsPd_.push_back(cartesianIdx);
                 }
             }
@@ -505,67 +526,11 @@ public:
 
             // Adding block data
             const auto cartesianIdx = elemCtx.simulator().vanguard().grid().globalCell()[globalDofIdx];
-            for (auto& val: this->blockData_) {
-                const auto& key = val.first;
-                int cartesianIdxBlock = key.second - 1;
-                if (cartesianIdx == cartesianIdxBlock) {
-                    if ((key.first == "BWSAT") || (key.first == "BSWAT"))
-                        val.second = getValue(fs.saturation(waterPhaseIdx));
-                    else if ((key.first == "BGSAT") || (key.first == "BSGAS"))
-                        val.second = getValue(fs.saturation(gasPhaseIdx));
-                    else if ((key.first == "BOSAT") || (key.first == "BSOIL"))
-                        val.second = getValue(fs.saturation(oilPhaseIdx));
-                    else if ((key.first == "BPR") || (key.first == "BPRESSUR")){
-                        if (FluidSystem::phaseIsActive(oilPhaseIdx)) 
-                            val.second = getValue(fs.pressure(oilPhaseIdx));
-                        else if (FluidSystem::phaseIsActive(gasPhaseIdx)) 
-                            val.second = getValue(fs.pressure(gasPhaseIdx));
-                        else if (FluidSystem::phaseIsActive(waterPhaseIdx)) 
-                            val.second = getValue(fs.pressure(waterPhaseIdx));
-                    }
-                    else if ((key.first == "BTCNFHEA") || (key.first == "BTEMP")){
-                        if (FluidSystem::phaseIsActive(oilPhaseIdx)) 
-                            val.second = getValue(fs.temperature(oilPhaseIdx));
-                        else if (FluidSystem::phaseIsActive(gasPhaseIdx)) 
-                            val.second = getValue(fs.temperature(gasPhaseIdx));
-                        else if (FluidSystem::phaseIsActive(waterPhaseIdx)) 
-                            val.second = getValue(fs.temperature(waterPhaseIdx));
-                    }
-                    else if (key.first == "BWKR" || key.first == "BKRW")
-                        val.second = getValue(intQuants.relativePermeability(waterPhaseIdx));
-                    else if (key.first == "BGKR" || key.first == "BKRG")
-                        val.second = getValue(intQuants.relativePermeability(gasPhaseIdx));
-                    else if (key.first == "BOKR" || key.first == "BKRO")
-                        val.second = getValue(intQuants.relativePermeability(oilPhaseIdx));
-                    else if (key.first == "BKROG") {
-                        const auto& materialParams = problem.materialLawParams(elemCtx, dofIdx, /* timeIdx = */ 0);
-                        const auto krog = MaterialLaw::template relpermOilInOilGasSystem<Evaluation>(materialParams, fs);
-                        val.second = getValue(krog);
-                    }
-                    else if (key.first == "BKROW") {
-                        const auto& materialParams = problem.materialLawParams(elemCtx, dofIdx, /* timeIdx = */ 0);
-                        const auto krow = MaterialLaw::template relpermOilInOilWaterSystem<Evaluation>(materialParams, fs);
-                        val.second = getValue(krow);
-                    }
-                    else if (key.first == "BWPC")
-                        val.second = getValue(fs.pressure(oilPhaseIdx)) - getValue(fs.pressure(waterPhaseIdx));
-                    else if (key.first == "BGPC")
-                        val.second = getValue(fs.pressure(gasPhaseIdx)) - getValue(fs.pressure(oilPhaseIdx));
-                    else if (key.first == "BWPR")
-                        val.second = getValue(fs.pressure(waterPhaseIdx));
-                    else if (key.first == "BGPR")
-                        val.second = getValue(fs.pressure(gasPhaseIdx));
-                    else if (key.first == "BVWAT" || key.first == "BWVIS")
-                        val.second = getValue(fs.viscosity(waterPhaseIdx));
-                    else if (key.first == "BVGAS" || key.first == "BGVIS")
-                        val.second = getValue(fs.viscosity(gasPhaseIdx));
-                    else if (key.first == "BVOIL" || key.first == "BOVIS")
-                        val.second = getValue(fs.viscosity(oilPhaseIdx));
-                    else {
-                        std::string logstring = "Keyword '";
-                        logstring.append(key.first);
-                        logstring.append("' is unhandled for output to file.");
-                        OpmLog::warning("Unhandled output keyword", logstring);
+            if (!this->blockEntries_.empty()) {
+                auto entries = this->blockEntries_.find(cartesianIdx);
+                if (entries != this->blockEntries_.end()) {
+                    for (const auto& [quantity, value] : entries->second) {
+                        *value = blockValue_(quantity, elemCtx, dofIdx);
                     }
                 }
             }
@@ -616,7 +581,8 @@ public:
      \endcode
      *
      * \param[in] elemCtx Primary lookup structure for per-cell/element
-     *    dynamic information.
+     *    dynamic information.  Only the stencil and the intensive
+     *    quantities need to be up to date.
      *
      * \param[in] activeIndex Mapping from cell/elements to linear indices
      *    on local MPI rank.
@@ -650,8 +616,21 @@ public:
             const auto left  = identifyCell(stencil.element(face.interiorIndex()));
             const auto right = identifyCell(stencil.element(face.exteriorIndex()));
 
+            // connections within all regions contribute nothing
+            if (! this->interRegionFlows_.isInterRegionConnection(left.activeIndex,
+                                                                  right.activeIndex))
+            {
+                continue;
+            }
+
+            // only the fluxes across region boundaries are needed, so they
+            // are evaluated here instead of updating all the extensive
+            // quantities of the element context
+            auto extQuant = ExtensiveQuantities{};
+            extQuant.update(elemCtx, scvfIdx, timeIdx);
+
             const auto rates = this->
-                getComponentSurfaceRates(elemCtx, face.area(), scvfIdx, timeIdx);
+                getComponentSurfaceRates(elemCtx, extQuant, face.area(), timeIdx);
 
             this->interRegionFlows_.addConnection(left, right, rates);
         }
@@ -887,7 +866,10 @@ private:
      * \param[in] elemCtx Primary lookup structure for per-cell/element
      *    dynamic information.
      *
-     * \param[in] scvfIdx Linear index of current interior bulk connection.
+     * \param[in] extQuant Extensive quantities of the current interior
+     *    bulk connection.
+     *
+     * \param[in] faceArea Area of the current interior bulk connection.
      *
      * \param[in] timeIdx Historical time-point at which to evaluate dynamic
      *    quantities (e.g., reciprocal FVF or dissolved gas concentration).
@@ -896,17 +878,15 @@ private:
      * \return Surface level component flow rates.
      */
     data::InterRegFlowMap::FlowRates
-    getComponentSurfaceRates(const ElementContext& elemCtx,
-                             const Scalar          faceArea,
-                             const std::size_t     scvfIdx,
-                             const std::size_t     timeIdx) const
+    getComponentSurfaceRates(const ElementContext&      elemCtx,
+                             const ExtensiveQuantities& extQuant,
+                             const Scalar               faceArea,
+                             const std::size_t          timeIdx) const
     {
         using Component = data::InterRegFlowMap::Component;
 
         auto rates = data::InterRegFlowMap::FlowRates{};
 
-        const auto& extQuant = elemCtx.extensiveQuantities(scvfIdx, timeIdx);
-
         const auto alpha = getValue(extQuant.extrusionFactor()) * faceArea;
 
         if (FluidSystem::phaseIsActive(oilPhaseIdx)) {
@@ -980,7 +960,102 @@ private:
         return rates;
     }
 
+    enum class BlockQuantity {
+        WaterSaturation, GasSaturation, OilSaturation,
+        Pressure, Temperature,
+        WaterRelPerm, GasRelPerm, OilRelPerm, OilGasRelPerm, OilWaterRelPerm,
+        WaterCapPressure, GasCapPressure, WaterPressure, GasPressure,
+        WaterViscosity, GasViscosity, OilViscosity,
+        Unhandled
+    };
+
+    static BlockQuantity blockQuantity_(const std::string& keyword)
+    {
+        static const std::unordered_map<std::string, BlockQuantity> quantities {
+            {"BWSAT", BlockQuantity::WaterSaturation}, {"BSWAT", BlockQuantity::WaterSaturation},
+            {"BGSAT", BlockQuantity::GasSaturation}, {"BSGAS", BlockQuantity::GasSaturation},
+            {"BOSAT", BlockQuantity::OilSaturation}, {"BSOIL", BlockQuantity::OilSaturation},
+            {"BPR", BlockQuantity::Pressure}, {"BPRESSUR", BlockQuantity::Pressure},
+            {"BTCNFHEA", BlockQuantity::Temperature}, {"BTEMP", BlockQuantity::Temperature},
+            {"BWKR", BlockQuantity::WaterRelPerm}, {"BKRW", BlockQuantity::WaterRelPerm},
+            {"BGKR", BlockQuantity::GasRelPerm}, {"BKRG", BlockQuantity::GasRelPerm},
+            {"BOKR", BlockQuantity::OilRelPerm}, {"BKRO", BlockQuantity::OilRelPerm},
+            {"BKROG", BlockQuantity::OilGasRelPerm},
+            {"BKROW", BlockQuantity::OilWaterRelPerm},
+            {"BWPC", BlockQuantity::WaterCapPressure},
+            {"BGPC", BlockQuantity::GasCapPressure},
+            {"BWPR", BlockQuantity::WaterPressure},
+            {"BGPR", BlockQuantity::GasPressure},
+            {"BVWAT", BlockQuantity::WaterViscosity}, {"BWVIS", BlockQuantity::WaterViscosity},
+            {"BVGAS", BlockQuantity::GasViscosity}, {"BGVIS", BlockQuantity::GasViscosity},
+            {"BVOIL", BlockQuantity::OilViscosity}, {"BOVIS", BlockQuantity::OilViscosity},
+        };
+        auto pos = quantities.find(keyword);
+        return pos == quantities.end() ? BlockQuantity::Unhandled : pos->second;
+    }
+
+    // the phase whose pressure or temperature the block vectors report
+    static unsigned blockPhaseIdx_()
+    {
+        if (FluidSystem::phaseIsActive(oilPhaseIdx))
+            return oilPhaseIdx;
+        else if (FluidSystem::phaseIsActive(gasPhaseIdx))
+            return gasPhaseIdx;
+        return waterPhaseIdx;
+    }
+
+    double blockValue_(const BlockQuantity quantity, const ElementContext& elemCtx, unsigned dofIdx) const
+    {
+        const auto& intQuants = elemCtx.intensiveQuantities(dofIdx, /*timeIdx=*/0);
+        const auto& fs = intQuants.fluidState();
+        switch (quantity) {
+        case BlockQuantity::WaterSaturation:
+            return getValue(fs.saturation(waterPhaseIdx));
+        case BlockQuantity::GasSaturation:
+            return getValue(fs.saturation(gasPhaseIdx));
+        case BlockQuantity::OilSaturation:
+            return getValue(fs.saturation(oilPhaseIdx));
+        case BlockQuantity::Pressure:
+            return getValue(fs.pressure(blockPhaseIdx_()));
+        case BlockQuantity::Temperature:
+            return getValue(fs.temperature(blockPhaseIdx_()));
+        case BlockQuantity::WaterRelPerm:
+            return getValue(intQuants.relativePermeability(waterPhaseIdx));
+        case BlockQuantity::GasRelPerm:
+            return getValue(intQuants.relativePermeability(gasPhaseIdx));
+        case BlockQuantity::OilRelPerm:
+            return getValue(intQuants.relativePermeability(oilPhaseIdx));
+        case BlockQuantity::OilGasRelPerm: {
+            const auto& materialParams = elemCtx.problem().materialLawParams(elemCtx, dofIdx, /* timeIdx = */ 0);
+            return getValue(MaterialLaw::template relpermOilInOilGasSystem<Evaluation>(materialParams, fs));
+        }
+        case BlockQuantity::OilWaterRelPerm: {
+            const auto& materialParams = elemCtx.problem().materialLawParams(elemCtx, dofIdx, /* timeIdx = */ 0);
+            return getValue(MaterialLaw::template relpermOilInOilWaterSystem<Evaluation>(materialParams, fs));
+        }
+        case BlockQuantity::WaterCapPressure:
+            return getValue(fs.pressure(oilPhaseIdx)) - getValue(fs.pressure(waterPhaseIdx));
+        case BlockQuantity::GasCapPressure:
+            return getValue(fs.pressure(gasPhaseIdx)) - getValue(fs.pressure(oilPhaseIdx));
+        case BlockQuantity::WaterPressure:
+            return getValue(fs.pressure(waterPhaseIdx));
+        case BlockQuantity::GasPressure:
+            return getValue(fs.pressure(gasPhaseIdx));
+        case BlockQuantity::WaterViscosity:
+            return getValue(fs.viscosity(waterPhaseIdx));
+        case BlockQuantity::GasViscosity:
+            return getValue(fs.viscosity(gasPhaseIdx));
+        case BlockQuantity::OilViscosity:
+            return getValue(fs.viscosity(oilPhaseIdx));
+        case BlockQuantity::Unhandled:
+            break;
+        }
+        return 0.0;
+    }
+
     const Simulator& simulator_;
+    // the block vectors of every cell on this process, by Cartesian index
+    std::unordered_map<int, std::vector<std::pair<BlockQuantity, double*>>> blockEntries_;
 };
 
 } // namespace Opm
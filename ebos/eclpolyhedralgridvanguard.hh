@@ -34,6 +34,8 @@
 
 #include <opm/grid/polyhedralgrid.hh>
 
+#include <stdexcept>
+
 namespace Opm {
 template <class TypeTag>
 class EclPolyhedralGridVanguard;
@@ -147,7 +149,13 @@ public:
      * (For parallel simulation runs.)
      */
     void loadBalance()
-    { /* do nothing: PolyhedralGrid is not parallel! */ }
+    {
+        // PolyhedralGrid is not parallel, every process would simulate the whole model
+        if (EclGenericVanguard::comm().size() > 1) {
+            throw std::runtime_error("The polyhedral grid does not support parallel runs, "
+                                     "use the corner-point grid to distribute the model");
+        }
+    }
 
     /*!
      * \brief Returns the object which maps a global element index of the simulation grid
@@ -69,8 +69,10 @@
 #include <opm/core/props/satfunc/RelpermDiagnostics.hpp>
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
+#include <opm/simulators/utils/gatherDeferredLogger.hpp>
 #include <opm/simulators/utils/ParallelSerialization.hpp>
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
 
 #include <opm/models/utils/pffgridvector.hh>
 #include <opm/models/blackoil/blackoilmodel.hh>
@@ -95,6 +97,8 @@
 #include <opm/input/eclipse/Schedule/Action/ActionContext.hpp>
 #include <opm/input/eclipse/Schedule/Action/ActionX.hpp>
 #include <opm/input/eclipse/Schedule/Action/State.hpp>
+#include <opm/input/eclipse/Schedule/SummaryState.hpp>
+#include <opm/input/eclipse/Schedule/UDQ/UDQState.hpp>
 #include <opm/common/utility/TimeService.hpp>
 #include <opm/material/common/ConditionalStorage.hpp>
 
@@ -102,14 +106,20 @@
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
 
+#include <opm/output/data/Aquifer.hpp>
 #include <opm/output/eclipse/EclipseIO.hpp>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <array>
+#include <chrono>
 #include <set>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <exception>
+#include <future>
+#include <stdexcept>
 
 namespace Opm {
 template <class TypeTag>
@@ -154,6 +164,12 @@ struct RestartWritingInterval {
     using type = UndefinedProperty;
 };
 
+// The wall clock time in seconds between writing two restart files
+template<class TypeTag, class MyTypeTag>
+struct RestartWallClockInterval {
+    using type = UndefinedProperty;
+};
+
 // Enable partial compensation of systematic mass losses via the source term of the next time
 // step
 template<class TypeTag, class MyTypeTag>
@@ -212,6 +228,18 @@ template<class TypeTag, class MyTypeTag>
 struct OutputMode {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct EnableNumaFirstTouch {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EnableHugePages {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct RelpermDiagnosticsMode {
+    using type = UndefinedProperty;
+};
 
 // Set the problem property
 template<class TypeTag>
@@ -402,6 +430,12 @@ struct EclNewtonRelaxedTolerance<TypeTag, TTag::EclBaseProblem> {
     static constexpr type value = 1e9;
 };
 
+// do not limit how often the primary variables of a cell may switch during a time step
+template<class TypeTag>
+struct EclNewtonMaxPrimaryVariableSwitches<TypeTag, TTag::EclBaseProblem> {
+    static constexpr int value = 0;
+};
+
 // Ignore the maximum error mass for early termination of the newton method.
 template<class TypeTag>
 struct NewtonMaxError<TypeTag, TTag::EclBaseProblem> {
@@ -441,6 +475,11 @@ template<class TypeTag>
 struct EnableAsyncEclOutput<TypeTag, TTag::EclBaseProblem> {
     static constexpr bool value = true;
 };
+// Let the simulation run ahead of the asynchronous ECL output by one step
+template<class TypeTag>
+struct EclMaxPendingOutput<TypeTag, TTag::EclBaseProblem> {
+    static constexpr int value = 2;
+};
 // Write ESMRY file for fast loading of summary data
 template<class TypeTag>
 struct EnableEsmry<TypeTag, TTag::EclBaseProblem> {
@@ -453,6 +492,18 @@ struct EclOutputDoublePrecision<TypeTag, TTag::EclBaseProblem> {
     static constexpr bool value = false;
 };
 
+// By default, the restart files keep the full precision of the results
+template<class TypeTag>
+struct EclRestartPrecision<TypeTag, TTag::EclBaseProblem> {
+    static constexpr double value = 0.0;
+};
+
+// By default, the cell arrays are gathered to the I/O rank for the restart file
+template<class TypeTag>
+struct EclParallelSolutionOutput<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = false;
+};
+
 // The default location for the ECL output files
 template<class TypeTag>
 struct OutputDir<TypeTag, TTag::EclBaseProblem> {
@@ -498,6 +549,14 @@ struct RestartWritingInterval<TypeTag, TTag::EclBaseProblem> {
     static constexpr int value = 0xffffff; // disable
 };
 
+// Write a restart (*.ers) file whenever this many seconds of wall clock time passed
+// since the last one, 0 to disable
+template<class TypeTag>
+struct RestartWallClockInterval<TypeTag, TTag::EclBaseProblem> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
+
 // Drift compensation is an experimental feature, i.e., systematic errors in the
 // conservation quantities are only compensated for
 // as default if experimental mode is enabled.
@@ -579,6 +638,18 @@ template<class TypeTag>
 struct OutputMode<TypeTag, TTag::EclBaseProblem> {
     static constexpr auto value = "all";
 };
+template<class TypeTag>
+struct EnableNumaFirstTouch<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct EnableHugePages<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct RelpermDiagnosticsMode<TypeTag, TTag::EclBaseProblem> {
+    static constexpr auto value = "full";
+};
 
 } // namespace Opm::Properties
 
@@ -655,6 +726,7 @@ class EclProblem : public GetPropType<TypeTag, Properties::BaseProblem>
     using IntensiveQuantities = GetPropType<TypeTag, Properties::IntensiveQuantities>;
     using EclWellModel = GetPropType<TypeTag, Properties::EclWellModel>;
     using EclAquiferModel = GetPropType<TypeTag, Properties::EclAquiferModel>;
+    using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
 
     using SolventModule = BlackOilSolventModule<TypeTag>;
     using PolymerModule = BlackOilPolymerModule<TypeTag>;
@@ -676,7 +748,6 @@ public:
     using EclGenericProblem<GridView,FluidSystem,Scalar>::briefDescription;
     using EclGenericProblem<GridView,FluidSystem,Scalar>::helpPreamble;
     using EclGenericProblem<GridView,FluidSystem,Scalar>::shouldWriteOutput;
-    using EclGenericProblem<GridView,FluidSystem,Scalar>::shouldWriteRestartFile;
     using EclGenericProblem<GridView,FluidSystem,Scalar>::maxTimeIntegrationFailures;
     using EclGenericProblem<GridView,FluidSystem,Scalar>::minTimeStepSize;
 
@@ -699,6 +770,8 @@ public:
                              "Tell the output writer to use double precision. Useful for 'perfect' restarts");
         EWOMS_REGISTER_PARAM(TypeTag, unsigned, RestartWritingInterval,
                              "The frequencies of which time steps are serialized to disk");
+        EWOMS_REGISTER_PARAM(TypeTag, Scalar, RestartWallClockInterval,
+                             "The wall clock time in seconds after which the next time step is serialized to disk, 0 to disable");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EclEnableDriftCompensation,
                              "Enable partial compensation of systematic mass losses via the source term of the next time step");
         if constexpr (enableExperiments)
@@ -712,6 +785,16 @@ public:
                              "Honor some aspects of the TUNING keyword from the ECL deck.");
         EWOMS_REGISTER_PARAM(TypeTag, std::string, OutputMode,
                              "Specify which messages are going to be printed. Valid values are: none, log, all (default)");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnableNumaFirstTouch,
+                             "Place the per-cell arrays, the Jacobian and the residual on the NUMA domains "
+                             "of the threads processing them, after they are created");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnableHugePages,
+                             "Back the arrays placed by --enable-numa-first-touch with transparent huge pages");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, RelpermDiagnosticsMode,
+                             "Checks of the saturation functions at startup. Valid values are: "
+                             "full (default) checks the tables and the scaled endpoints of every cell, "
+                             "deferred checks the tables and the cells in a background thread while the "
+                             "first report step runs, tables only checks the tables");
 
     }
 
@@ -811,10 +894,33 @@ public:
         this->maxTimeStepSize_ = EWOMS_GET_PARAM(TypeTag, Scalar, MaxTimeStepSize);
         this->maxTimeStepAfterWellEvent_ = EWOMS_GET_PARAM(TypeTag, Scalar, EclMaxTimeStepSizeAfterWellEvent);
         this->restartShrinkFactor_ = EWOMS_GET_PARAM(TypeTag, Scalar, EclRestartShrinkFactor);
+        restartWritingInterval_ = EWOMS_GET_PARAM(TypeTag, unsigned, RestartWritingInterval);
+        restartWallClockInterval_ = EWOMS_GET_PARAM(TypeTag, Scalar, RestartWallClockInterval);
+        lastRestartWriteTime_ = std::chrono::steady_clock::now();
         this->maxFails_ = EWOMS_GET_PARAM(TypeTag, unsigned, MaxTimeStepDivisions);
+        this->numaFirstTouch_ = EWOMS_GET_PARAM(TypeTag, bool, EnableNumaFirstTouch);
+        this->hugePages_ = EWOMS_GET_PARAM(TypeTag, bool, EnableHugePages);
 
-        RelpermDiagnostics relpermDiagnostics;
-        relpermDiagnostics.diagnosis(vanguard.eclState(), vanguard.cartesianIndexMapper());
+        const std::string relpermMode = EWOMS_GET_PARAM(TypeTag, std::string, RelpermDiagnosticsMode);
+        if (relpermMode != "full" && relpermMode != "deferred" && relpermMode != "tables") {
+            throw std::invalid_argument("Unknown relperm diagnostics mode " + relpermMode
+                                        + ", valid are full, deferred and tables");
+        }
+        relpermDiagnostics_ = std::make_unique<RelpermDiagnostics>();
+        if (relpermDiagnostics_->tableDiagnosis(vanguard.eclState())) {
+            if (relpermMode == "full") {
+                logRelpermCellDiagnostics_(relpermDiagnostics_->cellDiagnosis(vanguard.eclState(),
+                                                                              vanguard.cartesianIndexMapper(),
+                                                                              /*threaded=*/true));
+            }
+            else if (relpermMode == "deferred") {
+                // a single thread, the other threads belong to the simulation
+                relpermCellDiagnostics_ = std::async(std::launch::async,
+                    [this, &eclState = vanguard.eclState(), &mapper = vanguard.cartesianIndexMapper()]() {
+                        return relpermDiagnostics_->cellDiagnosis(eclState, mapper, /*threaded=*/false);
+                    });
+            }
+        }
     }
 
     /*!
@@ -867,14 +973,20 @@ public:
         this->readRockParameters_(simulator.vanguard().cellCenterDepths());
         readMaterialParameters_();
         readThermalParameters_();
-        transmissibilities_.finishInit();
+        {
+            ScopedTimer timer(TimingRegistry::Region::Transmissibilities);
+            transmissibilities_.finishInit();
+        }
 
         const auto& initconfig = eclState.getInitConfig();
         tracerModel_.init(initconfig.restartRequested());
-        if (initconfig.restartRequested())
-            readEclRestartSolution_();
-        else
-            readInitialCondition_();
+        {
+            ScopedTimer timer(TimingRegistry::Region::InitialCondition);
+            if (initconfig.restartRequested())
+                readEclRestartSolution_();
+            else
+                readInitialCondition_();
+        }
         tracerModel_.prepareTracerBatches();
 
         updatePffDofData_();
@@ -930,18 +1042,22 @@ public:
         }
 
         // write the static output files (EGRID, INIT, SMSPEC, etc.)
-        if (enableEclOutput_) {
+        if (enableEclOutput_ && eclWriter_->writesInitialFiles()) {
             if (simulator.vanguard().grid().comm().size() > 1) {
                 if (simulator.vanguard().grid().comm().rank() == 0)
                     eclWriter_->setTransmissibilities(&simulator.vanguard().globalTransmissibility());
             } else
                 eclWriter_->setTransmissibilities(&simulator.problem().eclTransmissibilities());
 
+            ScopedTimer timer(TimingRegistry::Region::WriteInit);
             eclWriter_->writeInit();
         }
 
         simulator.vanguard().releaseGlobalTransmissibilities();
 
+        if (this->numaFirstTouch_)
+            this->firstTouchCellData_();
+
         // after finishing the initialization and writing the initial solution, we move
         // to the first "real" episode/report step
         // for restart the episode index and start is already set
@@ -951,6 +1067,216 @@ public:
         }
     }
 
+    /*!
+     * \brief Reset the problem to the start of the schedule, to run the case again.
+     *
+     * The grid and the parsed input are kept. The rock and fluid parameters, the
+     * initial condition and the well model are set up anew, the initial solution must
+     * be applied afterwards. The reference porosities and the permeabilities can be
+     * scaled by a factor per element, an empty vector leaves them as given by the
+     * input. The connection factors of the wells are not affected by the
+     * permeabilities.
+     *
+     * Restarted runs, tracers and schedules which are modified by ACTIONX or WELPI
+     * are rejected, their states are not reset.
+     */
+    void resetState(const std::vector<Scalar>& porosityMultipliers,
+                    const std::vector<Scalar>& permeabilityMultipliers)
+    {
+        auto& simulator = this->simulator();
+        const auto& eclState = simulator.vanguard().eclState();
+        const auto& schedule = simulator.vanguard().schedule();
+        const std::size_t numDof = this->model().numGridDof();
+
+        if (eclState.getInitConfig().restartRequested())
+            throw std::logic_error("The state of a restarted run cannot be reset");
+        if (eclState.tracer().size() > 0)
+            throw std::logic_error("The state of a run with tracers cannot be reset");
+        for (std::size_t reportStep = 0; reportStep < schedule.size(); ++reportStep) {
+            if (!schedule[reportStep].actions().empty()
+                || schedule[reportStep].events().hasEvent(ScheduleEvents::WELL_PRODUCTIVITY_INDEX))
+                throw std::logic_error("The state of a run cannot be reset if ACTIONX or WELPI modify the schedule");
+        }
+        if ((!porosityMultipliers.empty() && porosityMultipliers.size() != numDof)
+            || (!permeabilityMultipliers.empty() && permeabilityMultipliers.size() != numDof))
+            throw std::invalid_argument("The multipliers must be given for all "
+                                        + std::to_string(numDof) + " elements");
+
+        simulator.vanguard().resetRunState();
+        wellModel_.resetState();
+
+        simulator.setTime(0.0, /*stepIdx=*/0);
+        simulator.setEpisodeIndex(-1);
+        simulator.setEpisodeLength(0.0);
+
+        // the extrema of the previous run, these are only grown by resize()
+        this->lastRs_.clear();
+        this->lastRv_.clear();
+        this->maxOilSaturation_.clear();
+        this->maxWaterSaturation_.clear();
+        this->minOilPressure_.clear();
+
+        this->initDRSDT_(numDof, this->episodeIndex());
+        this->readRockParameters_(simulator.vanguard().cellCenterDepths());
+        readMaterialParameters_();
+        readThermalParameters_();
+        if (!porosityMultipliers.empty()) {
+            for (std::size_t dofIdx = 0; dofIdx < numDof; ++dofIdx)
+                this->referencePorosity_[/*timeIdx=*/0][dofIdx] *= porosityMultipliers[dofIdx];
+            this->referencePorosity_[1] = this->referencePorosity_[0];
+        }
+        if (!permeabilityMultipliers.empty() || permeabilityPerturbed_) {
+            transmissibilities_.setPermeabilityMultipliers(permeabilityMultipliers);
+            transmissibilities_.update(true);
+            permeabilityPerturbed_ = !permeabilityMultipliers.empty();
+        }
+        readInitialCondition_();
+        updatePffDofData_();
+
+        if constexpr (getPropValue<TypeTag, Properties::EnablePolymer>())
+            this->maxPolymerAdsorption_.assign(numDof, 0.0);
+
+        if (enableDriftCompensation_)
+            drift_ = 0.0;
+
+        // the writer is released by finalizeOutput(). The INIT file of the first run
+        // is kept, it does not show the perturbations.
+        if (!eclWriter_)
+            eclWriter_.reset(new EclWriterType(simulator));
+
+        simulator.startNextEpisode(schedule.seconds(0));
+        simulator.setEpisodeIndex(0);
+    }
+
+    /*!
+     * \brief The dynamic state of a run at the end of a report step.
+     *
+     * It is kept in memory by checkpoint(), restoreCheckpoint() continues the run
+     * from there, possibly several times.
+     */
+    struct Checkpoint
+    {
+        Scalar time;
+        int timeStepIdx;
+        Scalar timeStepSize;
+        int episodeIdx;
+        Scalar episodeStartTime;
+        Scalar episodeLength;
+        SolutionVector solution;
+        typename EclWellModel::Checkpoint wells;
+        data::Aquifers aquifers;
+        std::vector<typename EclTracerModel<TypeTag>::TracerVector> tracers;
+        SummaryState summaryState{TimeService::from_time_t(0)};
+        UDQState udqState{0.0};
+        Action::State actionState;
+        std::array<std::vector<Scalar>, 2> referencePorosity;
+        std::vector<Scalar> lastRs;
+        std::vector<Scalar> lastRv;
+        std::vector<Scalar> maxOilSaturation;
+        std::vector<Scalar> maxWaterSaturation;
+        std::vector<Scalar> minOilPressure;
+        std::vector<Scalar> maxPolymerAdsorption;
+        // the hysteresis parameters of the material laws of the elements
+        std::vector<Scalar> pcSwMdcOw;
+        std::vector<Scalar> krnSwMdcOw;
+        std::vector<Scalar> pcSwMdcGo;
+        std::vector<Scalar> krnSwMdcGo;
+        GlobalEqVector drift;
+    };
+
+    /*!
+     * \brief Copy the dynamic state of the run at the end of a report step.
+     *
+     * The group guide rates and the output files are not part of the checkpoint.
+     */
+    Checkpoint checkpoint() const
+    {
+        const auto& simulator = this->simulator();
+        const auto& vanguard = simulator.vanguard();
+        // the state of the wells has no default
+        Checkpoint cp{simulator.time(),
+                      simulator.timeStepIndex(),
+                      simulator.timeStepSize(),
+                      simulator.episodeIndex(),
+                      simulator.episodeStartTime(),
+                      simulator.episodeLength(),
+                      this->model().solution(/*timeIdx=*/0),
+                      wellModel_.checkpoint()};
+        if (enableAquifers_)
+            cp.aquifers = aquiferModel_.aquiferData();
+        cp.tracers = tracerModel_.tracerConcentrations();
+        cp.summaryState = vanguard.summaryState();
+        cp.udqState = vanguard.udqState();
+        cp.actionState = vanguard.actionState();
+        cp.referencePorosity = this->referencePorosity_;
+        cp.lastRs = this->lastRs_;
+        cp.lastRv = this->lastRv_;
+        cp.maxOilSaturation = this->maxOilSaturation_;
+        cp.maxWaterSaturation = this->maxWaterSaturation_;
+        cp.minOilPressure = this->minOilPressure_;
+        cp.maxPolymerAdsorption = this->maxPolymerAdsorption_;
+        if (materialLawManager_->enableHysteresis()) {
+            const std::size_t numDof = this->model().numGridDof();
+            if (FluidSystem::phaseIsActive(oilPhaseIdx) && FluidSystem::phaseIsActive(waterPhaseIdx)) {
+                cp.pcSwMdcOw.resize(numDof);
+                cp.krnSwMdcOw.resize(numDof);
+                for (std::size_t elemIdx = 0; elemIdx < numDof; ++elemIdx)
+                    materialLawManager_->oilWaterHysteresisParams(cp.pcSwMdcOw[elemIdx], cp.krnSwMdcOw[elemIdx], elemIdx);
+            }
+            if (FluidSystem::phaseIsActive(oilPhaseIdx) && FluidSystem::phaseIsActive(gasPhaseIdx)) {
+                cp.pcSwMdcGo.resize(numDof);
+                cp.krnSwMdcGo.resize(numDof);
+                for (std::size_t elemIdx = 0; elemIdx < numDof; ++elemIdx)
+                    materialLawManager_->gasOilHysteresisParams(cp.pcSwMdcGo[elemIdx], cp.krnSwMdcGo[elemIdx], elemIdx);
+            }
+        }
+        if (enableDriftCompensation_)
+            cp.drift = drift_;
+        return cp;
+    }
+
+    /*!
+     * \brief Continue the run from a checkpoint of this run.
+     *
+     * The next time step starts from the end of the report step of the checkpoint.
+     */
+    void restoreCheckpoint(const Checkpoint& cp)
+    {
+        auto& simulator = this->simulator();
+        auto& vanguard = simulator.vanguard();
+        simulator.setTime(cp.time, cp.timeStepIdx);
+        simulator.setTimeStepSize(cp.timeStepSize);
+        simulator.startNextEpisode(cp.episodeStartTime, cp.episodeLength);
+        simulator.setEpisodeIndex(cp.episodeIdx);
+
+        wellModel_.restoreCheckpoint(cp.wells);
+        if (enableAquifers_)
+            aquiferModel_.initFromRestart(cp.aquifers);
+        tracerModel_.setTracerConcentrations(cp.tracers);
+        // the states are assigned in place since the simulator keeps references to them
+        vanguard.summaryState() = cp.summaryState;
+        vanguard.udqState() = cp.udqState;
+        vanguard.actionState() = cp.actionState;
+        this->referencePorosity_ = cp.referencePorosity;
+        this->lastRs_ = cp.lastRs;
+        this->lastRv_ = cp.lastRv;
+        this->maxOilSaturation_ = cp.maxOilSaturation;
+        this->maxWaterSaturation_ = cp.maxWaterSaturation;
+        this->minOilPressure_ = cp.minOilPressure;
+        this->maxPolymerAdsorption_ = cp.maxPolymerAdsorption;
+        for (std::size_t elemIdx = 0; elemIdx < cp.pcSwMdcOw.size(); ++elemIdx)
+            materialLawManager_->setOilWaterHysteresisParams(cp.pcSwMdcOw[elemIdx], cp.krnSwMdcOw[elemIdx], elemIdx);
+        for (std::size_t elemIdx = 0; elemIdx < cp.pcSwMdcGo.size(); ++elemIdx)
+            materialLawManager_->setGasOilHysteresisParams(cp.pcSwMdcGo[elemIdx], cp.krnSwMdcGo[elemIdx], elemIdx);
+        if (enableDriftCompensation_)
+            drift_ = cp.drift;
+
+        // the next time step copies the solution to the previous time level
+        this->model().solution(/*timeIdx=*/0) = cp.solution;
+        this->model().solution(/*timeIdx=*/1) = cp.solution;
+        this->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+    }
+
     void prefetch(const Element& elem) const
     { pffDofData_.prefetch(elem); }
 
@@ -994,6 +1320,32 @@ public:
             aquiferModel_.serialize(res);
     }
 
+    /*!
+     * \brief Returns true if an eWoms restart file should be written to disk.
+     *
+     * This is the case every RestartWritingInterval time steps, and once
+     * RestartWallClockInterval seconds passed since the last restart file.
+     * Each process writes its own file.
+     */
+    bool shouldWriteRestartFile() const
+    {
+        const auto timeStepIdx = static_cast<unsigned>(this->simulator().timeStepIndex());
+        bool write = restartWritingInterval_ > 0 && (timeStepIdx + 1) % restartWritingInterval_ == 0;
+
+        if (restartWallClockInterval_ > 0.0) {
+            const std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - lastRestartWriteTime_;
+            // the clocks of the processes differ slightly, all of them must write
+            const int due = elapsed.count() >= restartWallClockInterval_;
+            write = write || this->gridView().comm().max(due) > 0;
+        }
+
+        if (write)
+            lastRestartWriteTime_ = std::chrono::steady_clock::now();
+
+        return write;
+    }
+
     int episodeIndex() const
     {
         return std::max(this->simulator().episodeIndex(), 0);
@@ -1020,8 +1372,8 @@ public:
             // implications on e.g., the solution of the simulation.)
             const auto& miniDeck = schedule[episodeIdx].geo_keywords();
             const auto& cc = simulator.vanguard().grid().comm();
-            eclState.apply_schedule_keywords( miniDeck );
-            eclBroadcast(cc, eclState.getTransMult() );
+            eclBroadcastUpdate(cc, eclState.getTransMult(),
+                               [&eclState, &miniDeck]() { eclState.apply_schedule_keywords( miniDeck ); });
 
             // re-compute all quantities which may possibly be affected.
             transmissibilities_.update(true);
@@ -1072,17 +1424,11 @@ public:
                              this->simulator().timeStepSize(),
                              this->simulator().endTime());
 
-        // update maximum water saturation and minimum pressure
-        // used when ROCKCOMP is activated
-        const bool invalidateFromMaxWaterSat = updateMaxWaterSaturation_();
-        const bool invalidateFromMinPressure = updateMinPressure_();
-
-        // update hysteresis and max oil saturation used in vappars
-        const bool invalidateFromHyst = updateHysteresis_();
-        const bool invalidateFromMaxOilSat = updateMaxOilSaturation_();
+        // update maximum water saturation and minimum pressure used when ROCKCOMP is
+        // activated, the hysteresis and the max oil saturation used in vappars
+        const bool invalidateIntensiveQuantities = updateExplicitQuantities_();
 
         // the derivatives may have change
-        bool invalidateIntensiveQuantities = invalidateFromMaxWaterSat || invalidateFromMinPressure || invalidateFromHyst || invalidateFromMaxOilSat;
         if (invalidateIntensiveQuantities)
             this->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
 
@@ -1192,6 +1538,11 @@ public:
         if (enableAquifers_)
             aquiferModel_.endEpisode();
 
+        // the deferred cell checks are logged after the first report step
+        if (relpermCellDiagnostics_.valid()) {
+            logRelpermCellDiagnostics_(relpermCellDiagnostics_.get());
+        }
+
         int episodeIdx = this->episodeIndex();
         // check if we're finished ...
         if (episodeIdx + 1 >= static_cast<int>(schedule.size() - 1)) {
@@ -1286,8 +1637,8 @@ public:
 
         if (sim_update.tran_update) {
             const auto& keywords = schedule[report_step].geo_keywords();
-            ecl_state.apply_schedule_keywords( keywords );
-            eclBroadcast(comm, ecl_state.getTransMult() );
+            eclBroadcastUpdate(comm, ecl_state.getTransMult(),
+                               [&ecl_state, &keywords]() { ecl_state.apply_schedule_keywords( keywords ); });
 
             // re-compute transmissibility
             transmissibilities_.update(true);
@@ -1307,6 +1658,11 @@ public:
         if (actions.empty())
             return;
 
+        // the actions may change the field properties read by the deferred
+        // relperm checks
+        if (relpermCellDiagnostics_.valid())
+            relpermCellDiagnostics_.wait();
+
         Action::Context context( summaryState, schedule[reportStep].wlist_manager() );
         auto now = TimeStampUTC( schedule.getStartTime() ) + std::chrono::duration<double>(sim_time);
         std::string ts;
@@ -1461,10 +1817,29 @@ public:
 
     /*!
      * \copydoc BlackOilBaseProblem::thresholdPressure
+     *
+     * This resolves the regions and faults of both elements, the flux evaluation
+     * uses the per face values of the overload taking an execution context.
      */
     Scalar thresholdPressure(unsigned elem1Idx, unsigned elem2Idx) const
     { return thresholdPressures_.thresholdPressure(elem1Idx, elem2Idx); }
 
+    /*!
+     * \brief Returns the threshold pressure of the face between the center degree of
+     *        freedom of a stencil and one of its neighbors.
+     *
+     * This is the same value as thresholdPressure(elem1Idx, elem2Idx), but it is taken
+     * from the prefetch friendly per face data.
+     */
+    template <class Context>
+    Scalar thresholdPressure(const Context& context,
+                             [[maybe_unused]] unsigned fromDofLocalIdx,
+                             unsigned toDofLocalIdx) const
+    {
+        assert(fromDofLocalIdx == 0);
+        return pffDofData_.get(context.element(), toDofLocalIdx).thresholdPressure;
+    }
+
     const EclThresholdPressure<TypeTag>& thresholdPressure() const
     { return thresholdPressures_; }
 
@@ -1505,6 +1880,19 @@ public:
         return this->simulator().vanguard().cellCenterDepth(globalSpaceIdx);
     }
 
+    /*!
+     * \brief Returns the depth of the center degree of freedom of a stencil minus the
+     *        depth of one of its neighbors [m]
+     */
+    template <class Context>
+    Scalar dofCenterDepthDifference(const Context& context,
+                                    [[maybe_unused]] unsigned fromDofLocalIdx,
+                                    unsigned toDofLocalIdx) const
+    {
+        assert(fromDofLocalIdx == 0);
+        return pffDofData_.get(context.element(), toDofLocalIdx).depthDifference;
+    }
+
 
     /*!
      * \copydoc BlackoilProblem::rockCompressibility
@@ -1874,12 +2262,17 @@ public:
         // initialize the wells. Note that this needs to be done after initializing the
         // intrinsic permeabilities and the after applying the initial solution because
         // the well model uses these...
-        wellModel_.init();
+        {
+            ScopedTimer timer(TimingRegistry::Region::WellSetup);
+            wellModel_.init();
+        }
 
         // let the object for threshold pressures initialize itself. this is done only at
         // this point, because determining the threshold pressures may require to access
         // the initial solution.
         thresholdPressures_.finishInit();
+        // the threshold pressures of the faces are part of the prefetch friendly data
+        updatePffDofData_();
 
         updateCompositionChangeLimits_();
 
@@ -1890,7 +2283,9 @@ public:
     /*!
      * \copydoc FvBaseProblem::source
      *
-     * For this problem, the source term of all components is 0 everywhere.
+     * The source terms are the rates of the wells and the aquifers, and the
+     * drift compensation. Different degrees of freedom may be evaluated
+     * concurrently by the threads of the linearizer.
      */
     template <class Context>
     void source(RateVector& rate,
@@ -2085,6 +2480,17 @@ public:
     }
 
 private:
+    // The cells of every process are checked, the warnings are logged in the
+    // order of the processes by the first one. Collective.
+    void logRelpermCellDiagnostics_(const DeferredLogger& local)
+    {
+        const auto& comm = this->simulator().vanguard().grid().comm();
+        DeferredLogger global = gatherDeferredLogger(local, comm);
+        if (comm.rank() == 0) {
+            global.logMessages();
+        }
+    }
+
     // update the parameters needed for DRSDT and DRVDT
     void updateCompositionChangeLimits_()
     {
@@ -2093,26 +2499,29 @@ private:
         const auto& simulator = this->simulator();
         int episodeIdx = this->episodeIndex();
 
+        const bool updateConvectiveDrs = this->drsdtConvective_(episodeIdx);
+        const bool updateLastRs = this->drsdtActive_(episodeIdx);
+        const bool updateLastRv = this->drvdtActive_(episodeIdx);
+        if (!updateConvectiveDrs && !updateLastRs && !updateLastRv)
+            return;
+
+        const auto& vanguard = simulator.vanguard();
+        const auto& oilVaporizationControl = vanguard.schedule()[episodeIdx].oilvap();
+        Scalar g = this->gravity_[dim - 1];
+
         OPM_BEGIN_PARALLEL_TRY_CATCH();
-        if (this->drsdtConvective_(episodeIdx)) {
-            // This implements the convective DRSDT as described in
-            // Sandve et al. "Convective dissolution in field scale CO2 storage simulations using the OPM Flow simulator"
-            // Submitted to TCCS 11, 2021
-            Scalar g = this->gravity_[dim - 1];
-            ElementContext elemCtx(simulator);
-            const auto& vanguard = simulator.vanguard();
-            auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-            const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++elemIt) {
-                const Element& elem = *elemIt;
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+        forEachElementIntensiveQuantities_([&](unsigned compressedDofIdx, const IntensiveQuantities& iq)
+        {
+            const auto& fs = iq.fluidState();
+            using FluidState = typename std::decay<decltype(fs)>::type;
+
+            if (updateConvectiveDrs) {
+                // This implements the convective DRSDT as described in
+                // Sandve et al. "Convective dissolution in field scale CO2 storage simulations using the OPM Flow simulator"
+                // Submitted to TCCS 11, 2021
                 const DimMatrix& perm = intrinsicPermeability(compressedDofIdx);
                 const Scalar permz = perm[dim - 1][dim - 1]; // The Z permeability
                 Scalar distZ = vanguard.cellThickness(compressedDofIdx);
-                const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& fs = iq.fluidState();
                 Scalar t = getValue(fs.temperature(FluidSystem::oilPhaseIdx));
                 Scalar p = getValue(fs.pressure(FluidSystem::oilPhaseIdx));
                 Scalar so = getValue(fs.saturation(FluidSystem::oilPhaseIdx));
@@ -2129,157 +2538,134 @@ private:
                 // i.e. we only allow for fingers moving downward
                 this->convectiveDrs_[compressedDofIdx] = permz * rssat * max(0.0, deltaDensity) * g / ( so * visc * distZ * poro);
             }
-        }
-
-        if (this->drsdtActive_(episodeIdx)) {
-            ElementContext elemCtx(simulator);
-            const auto& vanguard = simulator.vanguard();
-            auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-            const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++elemIt) {
-                const Element& elem = *elemIt;
-
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-                unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& fs = iq.fluidState();
-
-                using FluidState = typename std::decay<decltype(fs)>::type;
 
+            if (updateLastRs) {
                 int pvtRegionIdx = this->pvtRegionIndex(compressedDofIdx);
-                const auto& oilVaporizationControl = simulator.vanguard().schedule()[episodeIdx].oilvap();
                 if (oilVaporizationControl.getOption(pvtRegionIdx) || fs.saturation(gasPhaseIdx) > freeGasMinSaturation_)
                     this->lastRs_[compressedDofIdx] =
                         BlackOil::template getRs_<FluidSystem,
                                                   FluidState,
-                                                 Scalar>(fs, iq.pvtRegionIndex());
+                                                  Scalar>(fs, iq.pvtRegionIndex());
                 else
                     this->lastRs_[compressedDofIdx] = std::numeric_limits<Scalar>::infinity();
             }
-        }
-
-        // update the "last Rv" values for all elements, including the ones in the ghost
-        // and overlap regions
-        if (this->drvdtActive_(episodeIdx)) {
-            ElementContext elemCtx(simulator);
-            const auto& vanguard = simulator.vanguard();
-            auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-            const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++elemIt) {
-                const Element& elem = *elemIt;
-
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-                unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& fs = iq.fluidState();
-
-                using FluidState = typename std::decay<decltype(fs)>::type;
 
+            // update the "last Rv" values for all elements, including the ones in the ghost
+            // and overlap regions
+            if (updateLastRv) {
                 this->lastRv_[compressedDofIdx] =
                     BlackOil::template getRv_<FluidSystem,
                                               FluidState,
                                               Scalar>(fs, iq.pvtRegionIndex());
             }
-        }
+        });
         OPM_END_PARALLEL_TRY_CATCH("EclProblem::_updateCompositionLayers() failed: ", this->simulator().vanguard().grid().comm());
     }
 
-    bool updateMaxOilSaturation_()
+    // update the quantities which are explicit in time at the beginning of a time
+    // step in a single pass over the grid: the maximum water saturation and the
+    // minimum pressure of ROCKCOMP, the hysteresis parameters of the material laws and
+    // the maximum oil saturation of VAPPARS. returns whether any of them is active, in
+    // which case the intensive quantities need to be updated.
+    bool updateExplicitQuantities_()
     {
-        const auto& simulator = this->simulator();
-        int episodeIdx = this->episodeIndex();
-
+        // water compaction is activated in ROCKCOMP
+        const bool updateMaxWaterSat = !this->maxWaterSaturation_.empty();
+        // IRREVERS option is used in ROCKCOMP
+        const bool updateMinPressure = !this->minOilPressure_.empty();
+        const bool updateHyst = materialLawManager_->enableHysteresis();
         // we use VAPPARS
-        if (this->vapparsActive(episodeIdx)) {
-            ElementContext elemCtx(simulator);
-            const auto& vanguard = simulator.vanguard();
-            auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-            const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-            OPM_BEGIN_PARALLEL_TRY_CATCH();
-            for (; elemIt != elemEndIt; ++elemIt) {
-                const Element& elem = *elemIt;
+        const bool updateMaxOilSat = this->vapparsActive(this->episodeIndex());
 
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+        if (!updateMaxWaterSat && !updateMinPressure && !updateHyst && !updateMaxOilSat)
+            return false;
 
-                unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& fs = iq.fluidState();
+        if (updateMaxWaterSat)
+            this->maxWaterSaturation_[/*timeIdx=*/1] = this->maxWaterSaturation_[/*timeIdx=*/0];
 
-                Scalar So = decay<Scalar>(fs.saturation(oilPhaseIdx));
+        // we need to update the hysteresis data for _all_ elements (i.e., not just the
+        // interior ones) to avoid desynchronization of the processes in the parallel case!
+        OPM_BEGIN_PARALLEL_TRY_CATCH();
+        forEachElementIntensiveQuantities_([&](unsigned compressedDofIdx, const IntensiveQuantities& iq)
+        {
+            const auto& fs = iq.fluidState();
 
-                this->maxOilSaturation_[compressedDofIdx] = std::max(this->maxOilSaturation_[compressedDofIdx], So);
+            if (updateMaxWaterSat) {
+                Scalar Sw = decay<Scalar>(fs.saturation(waterPhaseIdx));
+                this->maxWaterSaturation_[compressedDofIdx] = std::max(this->maxWaterSaturation_[compressedDofIdx], Sw);
             }
-            OPM_END_PARALLEL_TRY_CATCH("EclProblem::updateMayOilSaturation() failed:", vanguard.grid().comm());
-            // we need to invalidate the intensive quantities cache here because the
-            // derivatives of Rs and Rv will most likely have changed
-            return true;
-        }
 
-        return false;
-    }
-
-    bool updateMaxWaterSaturation_()
-    {
-        // water compaction is activated in ROCKCOMP
-        if (this->maxWaterSaturation_.empty())
-            return false;
-
-        this->maxWaterSaturation_[/*timeIdx=*/1] = this->maxWaterSaturation_[/*timeIdx=*/0];
-        ElementContext elemCtx(this->simulator());
-        const auto& vanguard = this->simulator().vanguard();
-        auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-        const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-        OPM_BEGIN_PARALLEL_TRY_CATCH();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const Element& elem = *elemIt;
-
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            if (updateMinPressure) {
+                this->minOilPressure_[compressedDofIdx] =
+                    std::min(this->minOilPressure_[compressedDofIdx],
+                             getValue(fs.pressure(oilPhaseIdx)));
+            }
 
-            unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& fs = iq.fluidState();
+            if (updateHyst)
+                materialLawManager_->updateHysteresis(fs, compressedDofIdx);
 
-            Scalar Sw = decay<Scalar>(fs.saturation(waterPhaseIdx));
-            this->maxWaterSaturation_[compressedDofIdx] = std::max(this->maxWaterSaturation_[compressedDofIdx], Sw);
-        }
-        OPM_END_PARALLEL_TRY_CATCH("EclProblem::updateMayWaterSaturation() failed: ", vanguard.grid().comm());
+            if (updateMaxOilSat) {
+                Scalar So = decay<Scalar>(fs.saturation(oilPhaseIdx));
+                this->maxOilSaturation_[compressedDofIdx] = std::max(this->maxOilSaturation_[compressedDofIdx], So);
+            }
+        });
+        OPM_END_PARALLEL_TRY_CATCH("EclProblem::updateExplicitQuantities_() failed: ", this->simulator().vanguard().grid().comm());
 
+        // if VAPPARS is used, the derivatives of Rs and Rv will most likely have changed
         return true;
     }
 
-    bool updateMinPressure_()
+    // call func(compressedDofIdx, intQuants) for all elements, including the ones in
+    // the ghost and overlap regions. if the intensive quantities of all elements are
+    // cached, the cached ones are used and the elements are distributed over the
+    // threads. otherwise, they are evaluated through an element context.
+    template <class Func>
+    void forEachElementIntensiveQuantities_(Func&& func) const
     {
-        // IRREVERS option is used in ROCKCOMP
-        if (this->minOilPressure_.empty())
-            return false;
-
-        OPM_BEGIN_PARALLEL_TRY_CATCH();
-        ElementContext elemCtx(this->simulator());
-        const auto& vanguard = this->simulator().vanguard();
-        auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-        const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const Element& elem = *elemIt;
+        const auto& model = this->model();
+        const auto& gridView = this->simulator().vanguard().gridView();
+        const int numElements = gridView.size(/*codim=*/0);
+
+        bool haveCachedIntQuants = true;
+        for (int elemIdx = 0; elemIdx < numElements && haveCachedIntQuants; ++elemIdx)
+            haveCachedIntQuants = model.cachedIntensiveQuantities(elemIdx, /*timeIdx=*/0) != nullptr;
+
+        if (!haveCachedIntQuants) {
+            ElementContext elemCtx(this->simulator());
+            auto elemIt = gridView.template begin</*codim=*/0>();
+            const auto& elemEndIt = gridView.template end</*codim=*/0>();
+            for (; elemIt != elemEndIt; ++elemIt) {
+                const Element& elem = *elemIt;
 
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                elemCtx.updatePrimaryStencil(elem);
+                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
 
-            unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& iq = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& fs = iq.fluidState();
+                func(elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0),
+                     elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0));
+            }
+            return;
+        }
 
-            this->minOilPressure_[compressedDofIdx] =
-                std::min(this->minOilPressure_[compressedDofIdx],
-                         getValue(fs.pressure(oilPhaseIdx)));
+        // exceptions must not escape the parallel region, the first one is rethrown
+        // by the calling thread.
+        std::exception_ptr exceptionPtr = nullptr;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+            try {
+                func(elemIdx, *model.cachedIntensiveQuantities(elemIdx, /*timeIdx=*/0));
+            }
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                if (!exceptionPtr)
+                    exceptionPtr = std::current_exception();
+            }
         }
-        OPM_END_PARALLEL_TRY_CATCH("EclProblem::updateMinPressure_() failed: ", this->simulator().vanguard().grid().comm());
-        return true;
+        if (exceptionPtr)
+            std::rethrow_exception(exceptionPtr);
     }
 
     void readMaterialParameters_()
@@ -2737,56 +3123,16 @@ private:
         }
     }
 
-    // update the hysteresis parameters of the material laws for the whole grid
-    bool updateHysteresis_()
-    {
-        if (!materialLawManager_->enableHysteresis())
-            return false;
-
-        // we need to update the hysteresis data for _all_ elements (i.e., not just the
-        // interior ones) to avoid desynchronization of the processes in the parallel case!
-        const auto& simulator = this->simulator();
-        ElementContext elemCtx(simulator);
-        const auto& vanguard = simulator.vanguard();
-        auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-        const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-        OPM_BEGIN_PARALLEL_TRY_CATCH();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const Element& elem = *elemIt;
-
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-            unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-            materialLawManager_->updateHysteresis(intQuants.fluidState(), compressedDofIdx);
-        }
-        OPM_END_PARALLEL_TRY_CATCH("EclProblem::updateHyteresis_(): ", vanguard.grid().comm());
-        return true;
-    }
-
     void updateMaxPolymerAdsorption_()
     {
         // we need to update the max polymer adsoption data for all elements
-        const auto& simulator = this->simulator();
-        ElementContext elemCtx(simulator);
-        const auto& vanguard = simulator.vanguard();
-        auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-        const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
         OPM_BEGIN_PARALLEL_TRY_CATCH();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const Element& elem = *elemIt;
-
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-            unsigned compressedDofIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-
+        forEachElementIntensiveQuantities_([this](unsigned compressedDofIdx, const IntensiveQuantities& intQuants)
+        {
             this->maxPolymerAdsorption_[compressedDofIdx] = std::max(this->maxPolymerAdsorption_[compressedDofIdx],
                                                                      scalarValue(intQuants.polymerAdsorption()));
-        }
-        OPM_END_PARALLEL_TRY_CATCH("EclProblem::updateMaxPolymerAdsorption_(): ", vanguard.grid().comm());
+        });
+        OPM_END_PARALLEL_TRY_CATCH("EclProblem::updateMaxPolymerAdsorption_(): ", this->simulator().vanguard().grid().comm());
     }
 
     struct PffDofData_
@@ -2795,6 +3141,8 @@ private:
         ConditionalStorage<enableEnergy, Scalar> thermalHalfTransOut;
         ConditionalStorage<enableDiffusion, Scalar> diffusivity;
         Scalar transmissibility;
+        Scalar thresholdPressure;
+        Scalar depthDifference;
     };
 
     // update the prefetch friendly data object
@@ -2807,11 +3155,14 @@ private:
             -> void
         {
             const auto& elementMapper = this->model().elementMapper();
+            const auto& vanguard = this->simulator().vanguard();
 
             unsigned globalElemIdx = elementMapper.index(stencil.entity(localDofIdx));
             if (localDofIdx != 0) {
                 unsigned globalCenterElemIdx = elementMapper.index(stencil.entity(/*dofIdx=*/0));
                 dofData.transmissibility = transmissibilities_.transmissibility(globalCenterElemIdx, globalElemIdx);
+                dofData.thresholdPressure = thresholdPressures_.thresholdPressure(globalCenterElemIdx, globalElemIdx);
+                dofData.depthDifference = vanguard.cellCenterDepth(globalCenterElemIdx) - vanguard.cellCenterDepth(globalElemIdx);
 
                 if constexpr (enableEnergy) {
                     *dofData.thermalHalfTransIn = transmissibilities_.thermalHalfTrans(globalCenterElemIdx, globalElemIdx);
@@ -3018,8 +3369,14 @@ private:
 
     constexpr static Scalar freeGasMinSaturation_ = 1e-7;
 
+    unsigned restartWritingInterval_;
+    Scalar restartWallClockInterval_;
+    mutable std::chrono::steady_clock::time_point lastRestartWriteTime_;
+
     bool enableDriftCompensation_;
     GlobalEqVector drift_;
+    // whether the transmissibilities were computed from perturbed permeabilities
+    bool permeabilityPerturbed_ = false;
 
     EclWellModel wellModel_;
     bool enableAquifers_;
@@ -3028,6 +3385,10 @@ private:
     bool enableEclOutput_;
     std::unique_ptr<EclWriterType> eclWriter_;
 
+    std::unique_ptr<RelpermDiagnostics> relpermDiagnostics_;
+    // destroyed first, waits for the deferred checks which use the diagnostics
+    std::future<DeferredLogger> relpermCellDiagnostics_;
+
     PffGridVector<GridView, Stencil, PffDofData_, DofMapper> pffDofData_;
     TracerModel tracerModel_;
 
@@ -30,9 +30,12 @@
 
 #include <ebos/eclgenerictracermodel.hh>
 
+#include <opm/models/parallel/threadedentityiterator.hh>
 #include <opm/models/utils/propertysystem.hh>
 #include <opm/simulators/utils/VectorVectorDataHandle.hpp>
 
+#include <array>
+#include <exception>
 #include <string>
 #include <vector>
 
@@ -175,11 +178,33 @@ public:
         if (this->numTracers()==0)
             return;
 
+        updateFlowCache_();
         advanceTracerFields(wat_);
         advanceTracerFields(oil_);
         advanceTracerFields(gas_);
     }
 
+    /*!
+     * \brief The concentrations of all tracers, e.g. for a checkpoint of the run.
+     */
+    const std::vector<TracerVector>& tracerConcentrations() const
+    { return this->tracerConcentration_; }
+
+    /*!
+     * \brief Set the concentrations of all tracers at the end of a time step.
+     */
+    void setTracerConcentrations(const std::vector<TracerVector>& concentrations)
+    {
+        this->tracerConcentration_ = concentrations;
+        // the batches solve for copies of the concentrations
+        for (auto* tr : {&wat_, &oil_, &gas_}) {
+            for (int tIdx = 0; tIdx < tr->numTracer(); ++tIdx) {
+                tr->concentration_[tIdx] = concentrations[tr->idx_[tIdx]];
+                tr->concentrationInitial_[tIdx] = concentrations[tr->idx_[tIdx]];
+            }
+        }
+    }
+
     /*!
      * \brief This method writes the complete state of all tracer
      *        to the hard disk.
@@ -275,74 +300,44 @@ protected:
         for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx)
             tr.residual_[tIdx] = 0.0;
 
-        ElementContext elemCtx(simulator_);
-        auto elemIt = simulator_.gridView().template begin</*codim=*/0>();
-        auto elemEndIt = simulator_.gridView().template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++ elemIt) {
-            elemCtx.updateAll(*elemIt);
-
-            size_t I = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timIdx=*/0);
-
-            if (elemIt->partitionType() != Dune::InteriorEntity)
+        const auto& cache = flowCache_;
+        const auto& volume = cache.volume[tr.phaseIdx_];
+        const auto& volume1 = cache.volume1[tr.phaseIdx_];
+        const auto& faceFlux = cache.faceFlux[tr.phaseIdx_];
+        const auto& faceIsUp = cache.faceIsUp[tr.phaseIdx_];
+        const Scalar dt = simulator_.timeStepSize();
+        for (size_t I = 0; I < cache.interior.size(); ++I) {
+            if (!cache.interior[I])
             {
                 // Dirichlet boundary conditions needed for the parallel matrix
                 (*this->tracerMatrix_)[I][I][0][0] = 1.;
                 continue;
             }
 
-            Scalar extrusionFactor =
-                    elemCtx.intensiveQuantities(/*dofIdx=*/ 0, /*timeIdx=*/0).extrusionFactor();
-            Valgrind::CheckDefined(extrusionFactor);
-            assert(isfinite(extrusionFactor));
-            assert(extrusionFactor > 0.0);
-            Scalar scvVolume =
-                    elemCtx.stencil(/*timeIdx=*/0).subControlVolume(/*dofIdx=*/ 0).volume()
-                    * extrusionFactor;
-            Scalar dt = elemCtx.simulator().timeStepSize();
-
-            size_t I1 = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timIdx=*/1);
-
-            std::vector<Scalar> storageOfTimeIndex1(tr.numTracer());
-            if (elemCtx.enableStorageCache()) {
-                for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                    storageOfTimeIndex1[tIdx] = tr.storageOfTimeIndex1_[tIdx][I];
-                }
-            }
-            else {
-                Scalar fVolume1;
-                computeVolume_(fVolume1, tr.phaseIdx_, elemCtx, 0, /*timIdx=*/1);
-                for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                    storageOfTimeIndex1[tIdx] = fVolume1*tr.concentrationInitial_[tIdx][I1];
-                }
-            }
-
-            TracerEvaluation fVolume;
-            computeVolume_(fVolume, tr.phaseIdx_, elemCtx, 0, /*timIdx=*/0);
+            const Scalar scvVolume = cache.scvVolume[I];
             for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                Scalar storageOfTimeIndex0 = fVolume.value()*tr.concentration_[tIdx][I];
-                Scalar localStorage = (storageOfTimeIndex0 - storageOfTimeIndex1[tIdx]) * scvVolume/dt;
+                Scalar storageOfTimeIndex1 = volume1.empty()
+                    ? tr.storageOfTimeIndex1_[tIdx][I]
+                    : volume1[I]*tr.concentrationInitial_[tIdx][I];
+                Scalar storageOfTimeIndex0 = volume[I]*tr.concentration_[tIdx][I];
+                Scalar localStorage = (storageOfTimeIndex0 - storageOfTimeIndex1) * scvVolume/dt;
                 tr.residual_[tIdx][I][0] += localStorage; //residual + flux
             }
-            (*this->tracerMatrix_)[I][I][0][0] += fVolume.derivative(0) * scvVolume/dt;
+            (*this->tracerMatrix_)[I][I][0][0] += volume[I] * scvVolume/dt;
 
-            size_t numInteriorFaces = elemCtx.numInteriorFaces(/*timIdx=*/0);
-            for (unsigned scvfIdx = 0; scvfIdx < numInteriorFaces; scvfIdx++) {
-                TracerEvaluation flux;
-                const auto& face = elemCtx.stencil(0).interiorFace(scvfIdx);
-                unsigned j = face.exteriorIndex();
-                unsigned J = elemCtx.globalSpaceIndex(/*dofIdx=*/ j, /*timIdx=*/0);
-                bool isUpF;
-                computeFlux_(flux, isUpF, tr.phaseIdx_, elemCtx, scvfIdx, 0);
+            for (unsigned faceIdx = cache.faceBegin[I]; faceIdx < cache.faceEnd[I]; ++faceIdx) {
+                const unsigned J = cache.faceNeighbor[faceIdx];
+                const Scalar flux = faceFlux[faceIdx];
+                const bool isUpF = faceIsUp[faceIdx];
                 int globalUpIdx = isUpF ? I : J;
                 for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                    tr.residual_[tIdx][I][0] += flux.value()*tr.concentration_[tIdx][globalUpIdx]; //residual + flux
+                    tr.residual_[tIdx][I][0] += flux*tr.concentration_[tIdx][globalUpIdx]; //residual + flux
                 }
                 if (isUpF) {
-                    (*this->tracerMatrix_)[J][I][0][0] = -flux.derivative(0);
-                    (*this->tracerMatrix_)[I][I][0][0] += flux.derivative(0);
+                    (*this->tracerMatrix_)[J][I][0][0] = -flux;
+                    (*this->tracerMatrix_)[I][I][0][0] += flux;
                 }
             }
-
         }
 
         // Wells  terms
@@ -385,6 +380,130 @@ protected:
                                           Dune::ForwardCommunication);
     }
 
+    // Store the pore volumes and face fluxes of the converged flow solution
+    // for the phases that carry tracers, such that the tracer equations of
+    // all phases are assembled from a single pass over the grid.
+    void updateFlowCache_()
+    {
+        std::vector<int> phases;
+        for (const auto* tr : {&wat_, &oil_, &gas_}) {
+            if (tr->numTracer() > 0)
+                phases.push_back(tr->phaseIdx_);
+        }
+
+        const size_t numGridDof = simulator_.model().numGridDof();
+        const bool storageCache = simulator_.model().enableStorageCache();
+        auto& cache = flowCache_;
+        cache.interior.assign(numGridDof, false);
+        cache.scvVolume.assign(numGridDof, 0.0);
+        cache.faceBegin.assign(numGridDof, 0);
+        cache.faceEnd.assign(numGridDof, 0);
+        cache.faceNeighbor.clear();
+        for (const int phaseIdx : phases) {
+            cache.volume[phaseIdx].assign(numGridDof, 0.0);
+            cache.volume1[phaseIdx].assign(storageCache ? 0 : numGridDof, 0.0);
+            cache.faceFlux[phaseIdx].clear();
+            cache.faceIsUp[phaseIdx].clear();
+        }
+
+        // Every element writes its own entries, hence the elements can be
+        // distributed over the threads. The first pass counts the faces of
+        // each cell to find where they are stored.
+        forEachInteriorElement_([&cache](const ElementContext& elemCtx)
+        {
+            const size_t I = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timIdx=*/0);
+            cache.faceEnd[I] = elemCtx.numInteriorFaces(/*timIdx=*/0);
+        }, /*updateAll=*/false);
+
+        unsigned numFaces = 0;
+        for (size_t I = 0; I < numGridDof; ++I) {
+            cache.faceBegin[I] = numFaces;
+            numFaces += cache.faceEnd[I];
+            cache.faceEnd[I] = numFaces;
+        }
+        cache.faceNeighbor.resize(numFaces);
+        for (const int phaseIdx : phases) {
+            cache.faceFlux[phaseIdx].resize(numFaces);
+            cache.faceIsUp[phaseIdx].resize(numFaces);
+        }
+
+        forEachInteriorElement_([this, &cache, &phases, storageCache](const ElementContext& elemCtx)
+        {
+            size_t I = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timIdx=*/0);
+            cache.interior[I] = true;
+
+            Scalar extrusionFactor =
+                    elemCtx.intensiveQuantities(/*dofIdx=*/ 0, /*timeIdx=*/0).extrusionFactor();
+            Valgrind::CheckDefined(extrusionFactor);
+            assert(isfinite(extrusionFactor));
+            assert(extrusionFactor > 0.0);
+            cache.scvVolume[I] =
+                    elemCtx.stencil(/*timeIdx=*/0).subControlVolume(/*dofIdx=*/ 0).volume()
+                    * extrusionFactor;
+
+            for (const int phaseIdx : phases) {
+                computeVolume_(cache.volume[phaseIdx][I], phaseIdx, elemCtx, 0, /*timIdx=*/0);
+                if (!storageCache) {
+                    size_t I1 = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timIdx=*/1);
+                    computeVolume_(cache.volume1[phaseIdx][I1], phaseIdx, elemCtx, 0, /*timIdx=*/1);
+                }
+            }
+
+            size_t numInteriorFaces = elemCtx.numInteriorFaces(/*timIdx=*/0);
+            for (unsigned scvfIdx = 0; scvfIdx < numInteriorFaces; scvfIdx++) {
+                const auto& face = elemCtx.stencil(0).interiorFace(scvfIdx);
+                unsigned j = face.exteriorIndex();
+                const unsigned faceIdx = cache.faceBegin[I] + scvfIdx;
+                cache.faceNeighbor[faceIdx] = elemCtx.globalSpaceIndex(/*dofIdx=*/ j, /*timIdx=*/0);
+                for (const int phaseIdx : phases) {
+                    TracerEvaluation flux;
+                    bool isUpF;
+                    computeFlux_(flux, isUpF, phaseIdx, elemCtx, scvfIdx, 0);
+                    cache.faceFlux[phaseIdx][faceIdx] = flux.value();
+                    cache.faceIsUp[phaseIdx][faceIdx] = isUpF;
+                }
+            }
+        }, /*updateAll=*/true);
+    }
+
+    // Call func for the element context of every interior element, using
+    // all threads. With updateAll false, only the stencil is updated.
+    template <class Func>
+    void forEachInteriorElement_(Func func, bool updateAll)
+    {
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(simulator_.gridView());
+        std::exception_ptr exceptionPtr = nullptr;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ElementContext elemCtx(simulator_);
+            auto elemIt = threadedElemIt.beginParallel();
+            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                if (elemIt->partitionType() != Dune::InteriorEntity)
+                    continue;
+
+                try {
+                    if (updateAll)
+                        elemCtx.updateAll(*elemIt);
+                    else
+                        elemCtx.updateStencil(*elemIt);
+                    func(elemCtx);
+                }
+                catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                    exceptionPtr = std::current_exception();
+                    threadedElemIt.setFinished();
+                }
+            }
+        }
+        if (exceptionPtr) {
+            std::rethrow_exception(exceptionPtr);
+        }
+    }
+
     template <class TrRe>
     void updateStorageCache(TrRe & tr)
     {
@@ -513,6 +632,20 @@ protected:
     TracerBatch<TracerVector> wat_;
     TracerBatch<TracerVector> oil_;
     TracerBatch<TracerVector> gas_;
+
+    // Quantities of the converged flow solution, see updateFlowCache_().
+    struct FlowCache {
+        std::vector<char> interior;
+        std::vector<Scalar> scvVolume;
+        std::array<std::vector<Scalar>, numPhases> volume; // at time index 0
+        std::array<std::vector<Scalar>, numPhases> volume1; // at time index 1, empty with storage cache
+        std::vector<unsigned> faceBegin; // faces of cell I are [faceBegin[I], faceEnd[I])
+        std::vector<unsigned> faceEnd;
+        std::vector<unsigned> faceNeighbor;
+        std::array<std::vector<Scalar>, numPhases> faceFlux;
+        std::array<std::vector<char>, numPhases> faceIsUp;
+    };
+    FlowCache flowCache_;
 };
 
 } // namespace Opm
@@ -36,6 +36,8 @@
 #include <opm/input/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/input/eclipse/Units/Units.hpp>
 
+#include <opm/models/parallel/threadedentityiterator.hh>
+
 #if HAVE_DUNE_FEM
 #include <dune/fem/gridpart/adaptiveleafgridpart.hh>
 #include <dune/fem/gridpart/common/gridpart2gridview.hh>
@@ -47,38 +49,11 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <exception>
 #include <sstream>
 #include <stdexcept>
-
-namespace {
-
-constexpr unsigned elemIdxShift = 32; // bits
-
-std::uint64_t isId(std::uint32_t elemIdx1, std::uint32_t elemIdx2)
-{
-    std::uint32_t elemAIdx = std::min(elemIdx1, elemIdx2);
-    std::uint64_t elemBIdx = std::max(elemIdx1, elemIdx2);
-
-    return (elemBIdx<<elemIdxShift) + elemAIdx;
-}
-
-std::pair<std::uint32_t, std::uint32_t> isIdReverse(const std::uint64_t& id)
-{
-    // Assigning an unsigned integer to a narrower type discards the most significant bits.
-    // See "The C programming language", section A.6.2.
-    // NOTE that the ordering of element A and B may have changed
-    std::uint32_t elemAIdx = id;
-    std::uint32_t elemBIdx = (id - elemAIdx) >> elemIdxShift;
-
-    return std::make_pair(elemAIdx, elemBIdx);
-}
-
-std::uint64_t directionalIsId(std::uint32_t elemIdx1, std::uint32_t elemIdx2)
-{
-    return (std::uint64_t(elemIdx1)<<elemIdxShift) + elemIdx2;
-}
-
-}
+#include <string>
+#include <type_traits>
 
 namespace Opm {
 
@@ -107,7 +82,7 @@ template<class Grid, class GridView, class ElementMapper, class Scalar>
 Scalar EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 transmissibility(unsigned elemIdx1, unsigned elemIdx2) const
 {
-    return trans_.at(isId(elemIdx1, elemIdx2));
+    return trans_[faceIndex_(elemIdx1, elemIdx2)];
 }
 
 template<class Grid, class GridView, class ElementMapper, class Scalar>
@@ -121,7 +96,7 @@ template<class Grid, class GridView, class ElementMapper, class Scalar>
 Scalar EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 thermalHalfTrans(unsigned insideElemIdx, unsigned outsideElemIdx) const
 {
-    return thermalHalfTrans_.at(directionalIsId(insideElemIdx, outsideElemIdx));
+    return thermalHalfTrans_[directionalFaceIndex_(insideElemIdx, outsideElemIdx)];
 }
 
 template<class Grid, class GridView, class ElementMapper, class Scalar>
@@ -138,7 +113,7 @@ diffusivity(unsigned elemIdx1, unsigned elemIdx2) const
     if (diffusivity_.empty())
         return 0.0;
 
-    return diffusivity_.at(isId(elemIdx1, elemIdx2));
+    return diffusivity_[faceIndex_(elemIdx1, elemIdx2)];
 
 }
 
@@ -181,27 +156,24 @@ update(bool global)
                 axisCentroids[axisIdx][elemIdx][dimIdx] = centroid[dimIdx];
     }
 
-    // reserving some space in the hashmap upfront saves quite a bit of time because
-    // resizes are costly for hashmaps and there would be quite a few of them if we
-    // would not have a rough idea of how large the final map will be (the rough idea
-    // is a conforming Cartesian grid).
-    trans_.clear();
-    trans_.reserve(numElements*3*1.05);
+    // the face values are stored in flat arrays, indexed by the position of the face
+    // in the neighbour lists of the elements.
+    buildFaceIndices_(elemMapper);
+    const std::size_t numFaces = neighbours_.size();
+    trans_.assign(numFaces, 0.0);
 
     transBoundary_.clear();
 
     // if energy is enabled, let's do the same for the "thermal half transmissibilities"
     if (enableEnergy_) {
-        thermalHalfTrans_.clear();
-        thermalHalfTrans_.reserve(numElements*6*1.05);
+        thermalHalfTrans_.assign(2*numFaces, 0.0);
 
         thermalHalfTransBoundary_.clear();
     }
 
     // if diffusion is enabled, let's do the same for the "diffusivity"
     if (updateDiffusivity) {
-        diffusivity_.clear();
-        diffusivity_.reserve(numElements*3*1.05);
+        diffusivity_.assign(numFaces, 0.0);
         extractPorosity_();
     }
 
@@ -217,254 +189,283 @@ update(bool global)
         comm.broadcast(&useSmallestMultiplier, 1, 0);
     }
 
-    // compute the transmissibilities for all intersections
-    elemIt = gridView_.template begin</*codim=*/ 0>();
-    for (; elemIt != elemEndIt; ++elemIt) {
-        const auto& elem = *elemIt;
-        unsigned elemIdx = elemMapper.index(elem);
-
-        auto isIt = gridView_.ibegin(elem);
-        const auto& isEndIt = gridView_.iend(elem);
-        unsigned boundaryIsIdx = 0;
-        for (; isIt != isEndIt; ++ isIt) {
-            // store intersection, this might be costly
-            const auto& intersection = *isIt;
-
-            // deal with grid boundaries
-            if (intersection.boundary()) {
-                // compute the transmissibilty for the boundary intersection
-                const auto& geometry = intersection.geometry();
-                const auto& faceCenterInside = geometry.center();
-
-                auto faceAreaNormal = intersection.centerUnitOuterNormal();
-                faceAreaNormal *= geometry.volume();
-
-                Scalar transBoundaryIs;
-                computeHalfTrans_(transBoundaryIs,
-                                  faceAreaNormal,
-                                  intersection.indexInInside(),
-                                  distanceVector_(faceCenterInside,
-                                                  intersection.indexInInside(),
-                                                  elemIdx,
-                                                  axisCentroids),
-                                  permeability_[elemIdx]);
-
-                // normally there would be two half-transmissibilities that would be
-                // averaged. on the grid boundary there only is the half
-                // transmissibility of the interior element.
-                transBoundary_[std::make_pair(elemIdx, boundaryIsIdx)] = transBoundaryIs;
-
-                // for boundary intersections we also need to compute the thermal
-                // half transmissibilities
-                if (enableEnergy_) {
-                    Scalar transBoundaryEnergyIs;
-                    computeHalfDiffusivity_(transBoundaryEnergyIs,
-                                            faceAreaNormal,
-                                            distanceVector_(faceCenterInside,
-                                                            intersection.indexInInside(),
-                                                            elemIdx,
-                                                            axisCentroids),
-                                            1.0);
-                    thermalHalfTransBoundary_[std::make_pair(elemIdx, boundaryIsIdx)] =
-                        transBoundaryEnergyIs;
+    // compute the transmissibilities for all intersections. Every face is computed once,
+    // from the element with the smaller Cartesian index, and it has its own entries in
+    // the face arrays. Hence the elements can be distributed over the threads, only the
+    // maps of the boundary faces are shared.
+    ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView_);
+    std::exception_ptr exceptionPtr = nullptr;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        auto threadElemIt = threadedElemIt.beginParallel();
+        for (; !threadedElemIt.isFinished(threadElemIt); threadElemIt = threadedElemIt.increment()) {
+            try {
+                const auto& elem = *threadElemIt;
+                unsigned elemIdx = elemMapper.index(elem);
+
+                auto isIt = gridView_.ibegin(elem);
+                const auto& isEndIt = gridView_.iend(elem);
+                unsigned boundaryIsIdx = 0;
+                for (; isIt != isEndIt; ++ isIt) {
+                    // store intersection, this might be costly
+                    const auto& intersection = *isIt;
+
+                    // deal with grid boundaries
+                    if (intersection.boundary()) {
+                        // compute the transmissibilty for the boundary intersection
+                        const auto& geometry = intersection.geometry();
+                        const auto& faceCenterInside = geometry.center();
+
+                        auto faceAreaNormal = intersection.centerUnitOuterNormal();
+                        faceAreaNormal *= geometry.volume();
+
+                        Scalar transBoundaryIs;
+                        computeHalfTrans_(transBoundaryIs,
+                                          faceAreaNormal,
+                                          intersection.indexInInside(),
+                                          distanceVector_(faceCenterInside,
+                                                          intersection.indexInInside(),
+                                                          elemIdx,
+                                                          axisCentroids),
+                                          permeability_[elemIdx]);
+
+                        // normally there would be two half-transmissibilities that would be
+                        // averaged. on the grid boundary there only is the half
+                        // transmissibility of the interior element.
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                        transBoundary_[std::make_pair(elemIdx, boundaryIsIdx)] = transBoundaryIs;
+
+                        // for boundary intersections we also need to compute the thermal
+                        // half transmissibilities
+                        if (enableEnergy_) {
+                            Scalar transBoundaryEnergyIs;
+                            computeHalfDiffusivity_(transBoundaryEnergyIs,
+                                                    faceAreaNormal,
+                                                    distanceVector_(faceCenterInside,
+                                                                    intersection.indexInInside(),
+                                                                    elemIdx,
+                                                                    axisCentroids),
+                                                    1.0);
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                            thermalHalfTransBoundary_[std::make_pair(elemIdx, boundaryIsIdx)] =
+                                transBoundaryEnergyIs;
+                        }
+
+                        ++ boundaryIsIdx;
+                        continue;
+                    }
+
+                    if (!intersection.neighbor()) {
+                        // elements can be on process boundaries, i.e. they are not on the
+                        // domain boundary yet they don't have neighbors.
+                        ++ boundaryIsIdx;
+                        continue;
+                    }
+
+                    const auto& outsideElem = intersection.outside();
+                    unsigned outsideElemIdx = elemMapper.index(outsideElem);
+
+                    unsigned insideCartElemIdx = cartMapper_.cartesianIndex(elemIdx);
+                    unsigned outsideCartElemIdx = cartMapper_.cartesianIndex(outsideElemIdx);
+
+                    // we only need to calculate a face's transmissibility
+                    // once...
+                    if (insideCartElemIdx > outsideCartElemIdx)
+                        continue;
+
+                    // local indices of the faces of the inside and
+                    // outside elements which contain the intersection
+                    int insideFaceIdx  = intersection.indexInInside();
+                    int outsideFaceIdx = intersection.indexInOutside();
+
+                    if (insideFaceIdx == -1) {
+                        // NNC. Set zero transmissibility, as it will be
+                        // *added to* by applyNncToGridTrans_() later.
+                        assert(outsideFaceIdx == -1);
+                        trans_[faceIndex_(elemIdx, outsideElemIdx)] = 0.0;
+                        continue;
+                    }
+
+                    DimVector faceCenterInside;
+                    DimVector faceCenterOutside;
+                    DimVector faceAreaNormal;
+
+                    typename std::is_same<Grid, Dune::CpGrid>::type isCpGrid;
+                    computeFaceProperties(intersection,
+                                          elemIdx,
+                                          insideFaceIdx,
+                                          outsideElemIdx,
+                                          outsideFaceIdx,
+                                          faceCenterInside,
+                                          faceCenterOutside,
+                                          faceAreaNormal,
+                                          isCpGrid);
+
+                    Scalar halfTrans1;
+                    Scalar halfTrans2;
+
+                    computeHalfTrans_(halfTrans1,
+                                      faceAreaNormal,
+                                      insideFaceIdx,
+                                      distanceVector_(faceCenterInside,
+                                                      intersection.indexInInside(),
+                                                      elemIdx,
+                                                      axisCentroids),
+                                      permeability_[elemIdx]);
+                    computeHalfTrans_(halfTrans2,
+                                      faceAreaNormal,
+                                      outsideFaceIdx,
+                                      distanceVector_(faceCenterOutside,
+                                                      intersection.indexInOutside(),
+                                                      outsideElemIdx,
+                                                      axisCentroids),
+                                      permeability_[outsideElemIdx]);
+
+                    applyNtg_(halfTrans1, insideFaceIdx, elemIdx, ntg);
+                    applyNtg_(halfTrans2, outsideFaceIdx, outsideElemIdx, ntg);
+
+                    // convert half transmissibilities to full face
+                    // transmissibilities using the harmonic mean
+                    Scalar trans;
+                    if (std::abs(halfTrans1) < 1e-30 || std::abs(halfTrans2) < 1e-30)
+                        // avoid division by zero
+                        trans = 0.0;
+                    else
+                        trans = 1.0 / (1.0/halfTrans1 + 1.0/halfTrans2);
+
+                    // apply the full face transmissibility multipliers
+                    // for the inside ...
+
+                    if (useSmallestMultiplier)
+                    {
+                        // Currently PINCH(4) is never queries and hence  PINCH(4) == TOPBOT is assumed
+                        // and in this branch PINCH(5) == ALL holds
+                        applyAllZMultipliers_(trans, insideFaceIdx, outsideFaceIdx, insideCartElemIdx,
+                                              outsideCartElemIdx, transMult, cartDims,
+                                              /* pinchTop= */ false);
+                    }
+                    else
+                    {
+                        applyMultipliers_(trans, insideFaceIdx, insideCartElemIdx, transMult);
+                        // ... and outside elements
+                        applyMultipliers_(trans, outsideFaceIdx, outsideCartElemIdx, transMult);
+                    }
+
+                    // apply the region multipliers (cf. the MULTREGT keyword)
+                    FaceDir::DirEnum faceDir;
+                    switch (insideFaceIdx) {
+                    case 0:
+                    case 1:
+                        faceDir = FaceDir::XPlus;
+                        break;
+
+                    case 2:
+                    case 3:
+                        faceDir = FaceDir::YPlus;
+                        break;
+
+                    case 4:
+                    case 5:
+                        faceDir = FaceDir::ZPlus;
+                        break;
+
+                    default:
+                        throw std::logic_error("Could not determine a face direction");
+                    }
+
+                    trans *= transMult.getRegionMultiplier(insideCartElemIdx,
+                                                           outsideCartElemIdx,
+                                                           faceDir);
+
+                    trans_[faceIndex_(elemIdx, outsideElemIdx)] = trans;
+
+                    // update the "thermal half transmissibility" for the intersection
+                    if (enableEnergy_) {
+
+                        Scalar halfDiffusivity1;
+                        Scalar halfDiffusivity2;
+
+                        computeHalfDiffusivity_(halfDiffusivity1,
+                                                faceAreaNormal,
+                                                distanceVector_(faceCenterInside,
+                                                                intersection.indexInInside(),
+                                                                elemIdx,
+                                                                axisCentroids),
+                                                1.0);
+                        computeHalfDiffusivity_(halfDiffusivity2,
+                                                faceAreaNormal,
+                                                distanceVector_(faceCenterOutside,
+                                                                intersection.indexInOutside(),
+                                                                outsideElemIdx,
+                                                                axisCentroids),
+                                                1.0);
+                        //TODO Add support for multipliers
+                        thermalHalfTrans_[directionalFaceIndex_(elemIdx, outsideElemIdx)] = halfDiffusivity1;
+                        thermalHalfTrans_[directionalFaceIndex_(outsideElemIdx, elemIdx)] = halfDiffusivity2;
+                   }
+
+                    // update the "diffusive half transmissibility" for the intersection
+                    if (updateDiffusivity) {
+
+                        Scalar halfDiffusivity1;
+                        Scalar halfDiffusivity2;
+
+                        computeHalfDiffusivity_(halfDiffusivity1,
+                                                faceAreaNormal,
+                                                distanceVector_(faceCenterInside,
+                                                                intersection.indexInInside(),
+                                                                elemIdx,
+                                                                axisCentroids),
+                                                porosity_[elemIdx]);
+                        computeHalfDiffusivity_(halfDiffusivity2,
+                                                faceAreaNormal,
+                                                distanceVector_(faceCenterOutside,
+                                                                intersection.indexInOutside(),
+                                                                outsideElemIdx,
+                                                                axisCentroids),
+                                                porosity_[outsideElemIdx]);
+
+                        applyNtg_(halfDiffusivity1, insideFaceIdx, elemIdx, ntg);
+                        applyNtg_(halfDiffusivity2, outsideFaceIdx, outsideElemIdx, ntg);
+
+                        //TODO Add support for multipliers
+                        Scalar diffusivity;
+                        if (std::abs(halfDiffusivity1) < 1e-30 || std::abs(halfDiffusivity2) < 1e-30)
+                            // avoid division by zero
+                            diffusivity = 0.0;
+                        else
+                            diffusivity = 1.0 / (1.0/halfDiffusivity1 + 1.0/halfDiffusivity2);
+
+
+                        diffusivity_[faceIndex_(elemIdx, outsideElemIdx)] = diffusivity;
+                   }
                 }
-
-                ++ boundaryIsIdx;
-                continue;
-            }
-
-            if (!intersection.neighbor()) {
-                // elements can be on process boundaries, i.e. they are not on the
-                // domain boundary yet they don't have neighbors.
-                ++ boundaryIsIdx;
-                continue;
-            }
-
-            const auto& outsideElem = intersection.outside();
-            unsigned outsideElemIdx = elemMapper.index(outsideElem);
-
-            unsigned insideCartElemIdx = cartMapper_.cartesianIndex(elemIdx);
-            unsigned outsideCartElemIdx = cartMapper_.cartesianIndex(outsideElemIdx);
-
-            // we only need to calculate a face's transmissibility
-            // once...
-            if (insideCartElemIdx > outsideCartElemIdx)
-                continue;
-
-            // local indices of the faces of the inside and
-            // outside elements which contain the intersection
-            int insideFaceIdx  = intersection.indexInInside();
-            int outsideFaceIdx = intersection.indexInOutside();
-
-            if (insideFaceIdx == -1) {
-                // NNC. Set zero transmissibility, as it will be
-                // *added to* by applyNncToGridTrans_() later.
-                assert(outsideFaceIdx == -1);
-                trans_[isId(elemIdx, outsideElemIdx)] = 0.0;
-                continue;
-            }
-
-            DimVector faceCenterInside;
-            DimVector faceCenterOutside;
-            DimVector faceAreaNormal;
-
-            typename std::is_same<Grid, Dune::CpGrid>::type isCpGrid;
-            computeFaceProperties(intersection,
-                                  elemIdx,
-                                  insideFaceIdx,
-                                  outsideElemIdx,
-                                  outsideFaceIdx,
-                                  faceCenterInside,
-                                  faceCenterOutside,
-                                  faceAreaNormal,
-                                  isCpGrid);
-
-            Scalar halfTrans1;
-            Scalar halfTrans2;
-
-            computeHalfTrans_(halfTrans1,
-                              faceAreaNormal,
-                              insideFaceIdx,
-                              distanceVector_(faceCenterInside,
-                                              intersection.indexInInside(),
-                                              elemIdx,
-                                              axisCentroids),
-                              permeability_[elemIdx]);
-            computeHalfTrans_(halfTrans2,
-                              faceAreaNormal,
-                              outsideFaceIdx,
-                              distanceVector_(faceCenterOutside,
-                                              intersection.indexInOutside(),
-                                              outsideElemIdx,
-                                              axisCentroids),
-                              permeability_[outsideElemIdx]);
-
-            applyNtg_(halfTrans1, insideFaceIdx, elemIdx, ntg);
-            applyNtg_(halfTrans2, outsideFaceIdx, outsideElemIdx, ntg);
-
-            // convert half transmissibilities to full face
-            // transmissibilities using the harmonic mean
-            Scalar trans;
-            if (std::abs(halfTrans1) < 1e-30 || std::abs(halfTrans2) < 1e-30)
-                // avoid division by zero
-                trans = 0.0;
-            else
-                trans = 1.0 / (1.0/halfTrans1 + 1.0/halfTrans2);
-
-            // apply the full face transmissibility multipliers
-            // for the inside ...
-
-            if (useSmallestMultiplier)
-            {
-                // Currently PINCH(4) is never queries and hence  PINCH(4) == TOPBOT is assumed
-                // and in this branch PINCH(5) == ALL holds
-                applyAllZMultipliers_(trans, insideFaceIdx, outsideFaceIdx, insideCartElemIdx,
-                                      outsideCartElemIdx, transMult, cartDims,
-                                      /* pinchTop= */ false);
-            }
-            else
-            {
-                applyMultipliers_(trans, insideFaceIdx, insideCartElemIdx, transMult);
-                // ... and outside elements
-                applyMultipliers_(trans, outsideFaceIdx, outsideCartElemIdx, transMult);
             }
-
-            // apply the region multipliers (cf. the MULTREGT keyword)
-            FaceDir::DirEnum faceDir;
-            switch (insideFaceIdx) {
-            case 0:
-            case 1:
-                faceDir = FaceDir::XPlus;
-                break;
-
-            case 2:
-            case 3:
-                faceDir = FaceDir::YPlus;
-                break;
-
-            case 4:
-            case 5:
-                faceDir = FaceDir::ZPlus;
-                break;
-
-            default:
-                throw std::logic_error("Could not determine a face direction");
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                exceptionPtr = std::current_exception();
+                threadedElemIt.setFinished();
             }
-
-            trans *= transMult.getRegionMultiplier(insideCartElemIdx,
-                                                   outsideCartElemIdx,
-                                                   faceDir);
-
-            trans_[isId(elemIdx, outsideElemIdx)] = trans;
-
-            // update the "thermal half transmissibility" for the intersection
-            if (enableEnergy_) {
-
-                Scalar halfDiffusivity1;
-                Scalar halfDiffusivity2;
-
-                computeHalfDiffusivity_(halfDiffusivity1,
-                                        faceAreaNormal,
-                                        distanceVector_(faceCenterInside,
-                                                        intersection.indexInInside(),
-                                                        elemIdx,
-                                                        axisCentroids),
-                                        1.0);
-                computeHalfDiffusivity_(halfDiffusivity2,
-                                        faceAreaNormal,
-                                        distanceVector_(faceCenterOutside,
-                                                        intersection.indexInOutside(),
-                                                        outsideElemIdx,
-                                                        axisCentroids),
-                                        1.0);
-                //TODO Add support for multipliers
-                thermalHalfTrans_[directionalIsId(elemIdx, outsideElemIdx)] = halfDiffusivity1;
-                thermalHalfTrans_[directionalIsId(outsideElemIdx, elemIdx)] = halfDiffusivity2;
-           }
-
-            // update the "diffusive half transmissibility" for the intersection
-            if (updateDiffusivity) {
-
-                Scalar halfDiffusivity1;
-                Scalar halfDiffusivity2;
-
-                computeHalfDiffusivity_(halfDiffusivity1,
-                                        faceAreaNormal,
-                                        distanceVector_(faceCenterInside,
-                                                        intersection.indexInInside(),
-                                                        elemIdx,
-                                                        axisCentroids),
-                                        porosity_[elemIdx]);
-                computeHalfDiffusivity_(halfDiffusivity2,
-                                        faceAreaNormal,
-                                        distanceVector_(faceCenterOutside,
-                                                        intersection.indexInOutside(),
-                                                        outsideElemIdx,
-                                                        axisCentroids),
-                                        porosity_[outsideElemIdx]);
-
-                applyNtg_(halfDiffusivity1, insideFaceIdx, elemIdx, ntg);
-                applyNtg_(halfDiffusivity2, outsideFaceIdx, outsideElemIdx, ntg);
-
-                //TODO Add support for multipliers
-                Scalar diffusivity;
-                if (std::abs(halfDiffusivity1) < 1e-30 || std::abs(halfDiffusivity2) < 1e-30)
-                    // avoid division by zero
-                    diffusivity = 0.0;
-                else
-                    diffusivity = 1.0 / (1.0/halfDiffusivity1 + 1.0/halfDiffusivity2);
-
-
-                diffusivity_[isId(elemIdx, outsideElemIdx)] = diffusivity;
-           }
         }
     }
+    if (exceptionPtr) {
+        std::rethrow_exception(exceptionPtr);
+    }
 
     // potentially overwrite and/or modify  transmissibilities based on input from deck
     updateFromEclState_(global);
 
-    // Create mapping from global to local index
-    std::unordered_map<std::size_t,int> globalToLocal;
+    // Create mapping from global to local index, indexed by the Cartesian index
+    // such that the lookup for each NNC is a plain array access
+    std::vector<int> globalToLocal(cartMapper_.cartesianSize(), -1);
 
     // loop over all elements (global grid) and store Cartesian index
     elemIt = grid_.leafGridView().template begin<0>();
@@ -479,6 +480,95 @@ update(bool global)
 
     //remove very small non-neighbouring transmissibilities
     removeSmallNonCartesianTransmissibilities_();
+
+    // a node of a std::map holds the value and three pointers and the colour
+    const auto mapBytes = [](const auto& map) {
+        using Value = typename std::decay_t<decltype(map)>::value_type;
+        return map.size() * (sizeof(Value) + 4 * sizeof(void*));
+    };
+    memory_.set(memoryBytes(permeability_) + memoryBytes(permeabilityMultipliers_)
+                + memoryBytes(porosity_) + memoryBytes(neighbourOffsets_)
+                + memoryBytes(neighbours_) + memoryBytes(trans_)
+                + memoryBytes(thermalHalfTrans_) + memoryBytes(diffusivity_)
+                + mapBytes(transBoundary_) + mapBytes(thermalHalfTransBoundary_));
+}
+
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+buildFaceIndices_(const ElementMapper& elemMapper)
+{
+    const unsigned numElements = elemMapper.size();
+
+    // the neighbours with a larger index of every element, sorted
+    std::vector<std::vector<unsigned>> larger(numElements);
+    auto elemIt = gridView_.template begin</*codim=*/ 0>();
+    const auto& elemEndIt = gridView_.template end</*codim=*/ 0>();
+    for (; elemIt != elemEndIt; ++elemIt) {
+        const auto& elem = *elemIt;
+        const unsigned elemIdx = elemMapper.index(elem);
+        auto isIt = gridView_.ibegin(elem);
+        const auto& isEndIt = gridView_.iend(elem);
+        for (; isIt != isEndIt; ++ isIt) {
+            const auto& intersection = *isIt;
+            if (!intersection.neighbor())
+                continue;
+
+            const unsigned outsideElemIdx = elemMapper.index(intersection.outside());
+            if (elemIdx < outsideElemIdx)
+                larger[elemIdx].push_back(outsideElemIdx);
+            else if (outsideElemIdx < elemIdx)
+                larger[outsideElemIdx].push_back(elemIdx);
+        }
+    }
+
+    neighbourOffsets_.assign(numElements + 1, 0);
+    for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+        auto& nbs = larger[elemIdx];
+        std::sort(nbs.begin(), nbs.end());
+        nbs.erase(std::unique(nbs.begin(), nbs.end()), nbs.end());
+        neighbourOffsets_[elemIdx + 1] = neighbourOffsets_[elemIdx] + nbs.size();
+    }
+
+    neighbours_.clear();
+    neighbours_.reserve(neighbourOffsets_.back());
+    for (const auto& nbs : larger)
+        neighbours_.insert(neighbours_.end(), nbs.begin(), nbs.end());
+}
+
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+std::optional<std::size_t> EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+findFace_(unsigned elemIdx1, unsigned elemIdx2) const
+{
+    const unsigned low = std::min(elemIdx1, elemIdx2);
+    const unsigned high = std::max(elemIdx1, elemIdx2);
+    if (low == high || low + 1 >= neighbourOffsets_.size())
+        return std::nullopt;
+
+    const auto begin = neighbours_.begin() + neighbourOffsets_[low];
+    const auto end = neighbours_.begin() + neighbourOffsets_[low + 1];
+    const auto it = std::lower_bound(begin, end, high);
+    if (it == end || *it != high)
+        return std::nullopt;
+
+    return it - neighbours_.begin();
+}
+
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+std::size_t EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+faceIndex_(unsigned elemIdx1, unsigned elemIdx2) const
+{
+    const auto faceIdx = findFace_(elemIdx1, elemIdx2);
+    if (!faceIdx)
+        throw std::out_of_range("No intersection between the elements "
+                                + std::to_string(elemIdx1) + " and " + std::to_string(elemIdx2));
+    return *faceIdx;
+}
+
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+std::size_t EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+directionalFaceIndex_(unsigned insideElemIdx, unsigned outsideElemIdx) const
+{
+    return 2*faceIndex_(insideElemIdx, outsideElemIdx) + (insideElemIdx < outsideElemIdx ? 0 : 1);
 }
 
 template<class Grid, class GridView, class ElementMapper, class Scalar>
@@ -513,6 +603,8 @@ extractPermeability_()
             permeability_[dofIdx][0][0] = permxData[dofIdx];
             permeability_[dofIdx][1][1] = permyData[dofIdx];
             permeability_[dofIdx][2][2] = permzData[dofIdx];
+            if (!permeabilityMultipliers_.empty())
+                permeability_[dofIdx] *= permeabilityMultipliers_[dofIdx];
         }
 
         // for now we don't care about non-diagonal entries
@@ -545,19 +637,22 @@ void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 removeSmallNonCartesianTransmissibilities_()
 {
     const auto& cartDims = cartMapper_.cartesianDimensions();
-    for (auto&& trans: trans_) {
-        if (trans.second < transmissibilityThreshold_) {
-            const auto& id = trans.first;
-            const auto& elements = isIdReverse(id);
-            int gc1 = std::min(cartMapper_.cartesianIndex(elements.first), cartMapper_.cartesianIndex(elements.second));
-            int gc2 = std::max(cartMapper_.cartesianIndex(elements.first), cartMapper_.cartesianIndex(elements.second));
+    const unsigned numElements = neighbourOffsets_.size() - 1;
+    for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+        for (auto faceIdx = neighbourOffsets_[elemIdx]; faceIdx < neighbourOffsets_[elemIdx + 1]; ++faceIdx) {
+            if (trans_[faceIdx] >= transmissibilityThreshold_)
+                continue;
+
+            const unsigned outsideElemIdx = neighbours_[faceIdx];
+            int gc1 = std::min(cartMapper_.cartesianIndex(elemIdx), cartMapper_.cartesianIndex(outsideElemIdx));
+            int gc2 = std::max(cartMapper_.cartesianIndex(elemIdx), cartMapper_.cartesianIndex(outsideElemIdx));
 
             // only adjust the NNCs
             if (gc2 - gc1 == 1 || gc2 - gc1 == cartDims[0] || gc2 - gc1 == cartDims[0]*cartDims[1])
                 continue;
 
             //remove transmissibilities less than the threshold (by default 1e-6 in the deck's unit system)
-            trans.second = 0.0;
+            trans_[faceIdx] = 0.0;
         }
     }
 }
@@ -676,22 +771,22 @@ createTransmissibilityArrays_(const std::array<bool,3>& is_tran)
             if (gc1 > gc2)
                 continue; // we only need to handle each connection once, thank you.
 
-            auto isID = isId(c1, c2);
+            const auto faceIdx = faceIndex_(c1, c2);
 
             if (gc2 - gc1 == 1 && cartDims[0] > 1) {
                 if (is_tran[0])
                     // set simulator internal transmissibilities to values from inputTranx
-                     trans[0][c1] = trans_[isID];
+                     trans[0][c1] = trans_[faceIdx];
             }
             else if (gc2 - gc1 == cartDims[0] && cartDims[1] > 1) {
                 if (is_tran[1])
                     // set simulator internal transmissibilities to values from inputTrany
-                     trans[1][c1] = trans_[isID];
+                     trans[1][c1] = trans_[faceIdx];
             }
             else if (gc2 - gc1 == cartDims[0]*cartDims[1]) {
                 if (is_tran[2])
                     // set simulator internal transmissibilities to values from inputTranz
-                     trans[2][c1] = trans_[isID];
+                     trans[2][c1] = trans_[faceIdx];
             }
             //else.. We don't support modification of NNC at the moment.
         }
@@ -736,22 +831,22 @@ resetTransmissibilityFromArrays_(const std::array<bool,3>& is_tran,
             if (gc1 > gc2)
                 continue; // we only need to handle each connection once, thank you.
 
-            auto isID = isId(c1, c2);
+            const auto faceIdx = faceIndex_(c1, c2);
 
             if (gc2 - gc1 == 1 && cartDims[0] > 1) {
                 if (is_tran[0])
                     // set simulator internal transmissibilities to values from inputTranx
-                    trans_[isID] = trans[0][c1];
+                    trans_[faceIdx] = trans[0][c1];
             }
             else if (gc2 - gc1 == cartDims[0] && cartDims[1] > 1) {
                 if (is_tran[1])
                     // set simulator internal transmissibilities to values from inputTrany
-                    trans_[isID] = trans[1][c1];
+                    trans_[faceIdx] = trans[1][c1];
             }
             else if (gc2 - gc1 == cartDims[0]*cartDims[1]) {
                 if (is_tran[2])
                     // set simulator internal transmissibilities to values from inputTranz
-                    trans_[isID] = trans[2][c1];
+                    trans_[faceIdx] = trans[2][c1];
             }
             //else.. We don't support modification of NNC at the moment.
         }
@@ -803,7 +898,7 @@ computeFaceProperties(const Intersection& intersection,
 template<class Grid, class GridView, class ElementMapper, class Scalar>
 std::tuple<std::vector<NNCdata>, std::vector<NNCdata>>
 EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
-applyNncToGridTrans_(const std::unordered_map<std::size_t,int>& cartesianToCompressed)
+applyNncToGridTrans_(const std::vector<int>& cartesianToCompressed)
 {
     // First scale NNCs with EDITNNC.
     std::vector<NNCdata> unprocessedNnc;
@@ -812,13 +907,32 @@ applyNncToGridTrans_(const std::unordered_map<std::size_t,int>& cartesianToCompr
     if (nnc_input.empty())
         return std::make_tuple(processedNnc, unprocessedNnc);
 
-    for (const auto& nncEntry : nnc_input) {
+    const auto compressedIndex = [&cartesianToCompressed](const std::size_t cartIdx)
+    {
+        return cartIdx < cartesianToCompressed.size() ? cartesianToCompressed[cartIdx] : -1;
+    };
+
+    // The faces of the NNCs are searched for in parallel. They are applied in
+    // the order of the input, such that NNCs on the same face are summed up
+    // in the same order with any number of threads.
+    const auto numNnc = nnc_input.size();
+    std::vector<std::optional<std::size_t>> nncFaces(numNnc);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (std::size_t nncIdx = 0; nncIdx < numNnc; ++nncIdx) {
+        const int idx1 = compressedIndex(nnc_input[nncIdx].cell1);
+        const int idx2 = compressedIndex(nnc_input[nncIdx].cell2);
+        if (idx1 >= 0 && idx2 >= 0)
+            nncFaces[nncIdx] = findFace_(idx1, idx2);
+    }
+
+    for (std::size_t nncIdx = 0; nncIdx < numNnc; ++nncIdx) {
+        const auto& nncEntry = nnc_input[nncIdx];
         auto c1 = nncEntry.cell1;
         auto c2 = nncEntry.cell2;
-        auto lowIt = cartesianToCompressed.find(c1);
-        auto highIt = cartesianToCompressed.find(c2);
-        int low = (lowIt == cartesianToCompressed.end())? -1 : lowIt->second;
-        int high = (highIt == cartesianToCompressed.end())? -1 : highIt->second;
+        int low = compressedIndex(c1);
+        int high = compressedIndex(c2);
 
         if (low > high)
             std::swap(low, high);
@@ -836,9 +950,9 @@ applyNncToGridTrans_(const std::unordered_map<std::size_t,int>& cartesianToCompr
             continue;
         }
 
-        auto candidate = trans_.find(isId(low, high));
+        const auto& candidate = nncFaces[nncIdx];
 
-        if (candidate == trans_.end())
+        if (!candidate)
             // This NNC is not resembled by the grid. Save it for later
             // processing with local cell values
             unprocessedNnc.push_back(nncEntry);
@@ -846,7 +960,7 @@ applyNncToGridTrans_(const std::unordered_map<std::size_t,int>& cartesianToCompr
             // NNC is represented by the grid and might be a neighboring connection
             // In this case the transmissibilty is added to the value already
             // set or computed.
-            candidate->second += nncEntry.trans;
+            trans_[*candidate] += nncEntry.trans;
             processedNnc.push_back(nncEntry);
         }
     }
@@ -855,7 +969,7 @@ applyNncToGridTrans_(const std::unordered_map<std::size_t,int>& cartesianToCompr
 
 template<class Grid, class GridView, class ElementMapper, class Scalar>
 void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
-applyEditNncToGridTrans_(const std::unordered_map<std::size_t,int>& globalToLocal)
+applyEditNncToGridTrans_(const std::vector<int>& globalToLocal)
 {
     const auto& nnc_input = eclState_.getInputNNC();
     const auto& editNnc = nnc_input.edit();
@@ -889,23 +1003,21 @@ applyEditNncToGridTrans_(const std::unordered_map<std::size_t,int>& globalToLoca
     while (nnc != end) {
         auto c1 = nnc->cell1;
         auto c2 = nnc->cell2;
-        auto lowIt = globalToLocal.find(c1);
-        auto highIt = globalToLocal.find(c2);
+        auto low = c1 < globalToLocal.size() ? globalToLocal[c1] : -1;
+        auto high = c2 < globalToLocal.size() ? globalToLocal[c2] : -1;
 
-        if (lowIt == globalToLocal.end() || highIt == globalToLocal.end()) {
+        if (low < 0 || high < 0) {
             print_warning(*nnc);
             ++nnc;
             warning_count++;
             continue;
         }
 
-        auto low = lowIt->second, high = highIt->second;
-
         if (low > high)
             std::swap(low, high);
 
-        auto candidate = trans_.find(isId(low, high));
-        if (candidate == trans_.end()) {
+        auto candidate = findFace_(low, high);
+        if (!candidate) {
             print_warning(*nnc);
             ++nnc;
             warning_count++;
@@ -913,7 +1025,7 @@ applyEditNncToGridTrans_(const std::unordered_map<std::size_t,int>& globalToLoca
         else {
             // NNC exists
             while (nnc!= end && c1==nnc->cell1 && c2==nnc->cell2) {
-                candidate->second *= nnc->trans;
+                trans_[*candidate] *= nnc->trans;
                 ++nnc;
             }
         }
@@ -29,15 +29,17 @@
 #define EWOMS_ECL_TRANSMISSIBILITY_HH
 
 #include <opm/grid/common/CartesianIndexMapper.hpp>
+#include <opm/simulators/utils/MemoryRegistry.hpp>
 
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
 
 #include <array>
 #include <map>
+#include <optional>
 #include <tuple>
 #include <vector>
-#include <unordered_map>
+#include <utility>
 #include <functional>
 
 namespace Opm {
@@ -69,6 +71,15 @@ public:
     const DimMatrix& permeability(unsigned elemIdx) const
     { return permeability_[elemIdx]; }
 
+    /*!
+     * \brief Scale the permeabilities of the ecl state by a factor per element.
+     *
+     * The factors are applied by the next calls of update(); an empty vector removes
+     * them. This is used to perturb the members of an ensemble.
+     */
+    void setPermeabilityMultipliers(std::vector<Scalar> multipliers)
+    { permeabilityMultipliers_ = std::move(multipliers); }
+
     /*!
      * \brief Return the transmissibility for the intersection between two elements.
      */
@@ -132,6 +143,18 @@ protected:
 
     void removeSmallNonCartesianTransmissibilities_();
 
+    /// \brief Set up the neighbour lists that index the face arrays.
+    void buildFaceIndices_(const ElementMapper& elemMapper);
+
+    /// \brief Position of the face between two elements in the face arrays, if any.
+    std::optional<std::size_t> findFace_(unsigned elemIdx1, unsigned elemIdx2) const;
+
+    /// \brief Position of the face between two elements, throws if there is none.
+    std::size_t faceIndex_(unsigned elemIdx1, unsigned elemIdx2) const;
+
+    /// \brief Position of a face in the arrays of directional face values.
+    std::size_t directionalFaceIndex_(unsigned insideElemIdx, unsigned outsideElemIdx) const;
+
     /// \brief Apply the Multipliers for the case PINCH(4)==TOPBOT
     ///
     /// \param pinchTop Whether PINCH(5) is TOP, otherwise ALL is assumed.
@@ -195,10 +218,10 @@ protected:
      *         inactive cells are omitted in these vectors.
      */
     std::tuple<std::vector<NNCdata>, std::vector<NNCdata>>
-    applyNncToGridTrans_(const std::unordered_map<std::size_t,int>& cartesianToCompressed);
+    applyNncToGridTrans_(const std::vector<int>& cartesianToCompressed);
 
     /// \brief Multiplies the grid transmissibilities according to EDITNNC.
-    void applyEditNncToGridTrans_(const std::unordered_map<std::size_t,int>& globalToLocal);
+    void applyEditNncToGridTrans_(const std::vector<int>& globalToLocal);
 
     void extractPermeability_();
 
@@ -231,8 +254,15 @@ protected:
                    const std::vector<double>& ntg) const;
 
     std::vector<DimMatrix> permeability_;
+    std::vector<Scalar> permeabilityMultipliers_;
     std::vector<Scalar> porosity_;
-    std::unordered_map<std::uint64_t, Scalar> trans_;
+    // For every element, the neighbours with a larger index in compressed sparse row
+    // format. The values of a face are stored at the position of the face in
+    // neighbours_, directional values at twice that position (from the element with
+    // the smaller index) and the next one.
+    std::vector<std::size_t> neighbourOffsets_;
+    std::vector<unsigned> neighbours_;
+    std::vector<Scalar> trans_;
     const EclipseState& eclState_;
     const GridView& gridView_;
     const Dune::CartesianIndexMapper<Grid>& cartMapper_;
@@ -243,8 +273,9 @@ protected:
     std::map<std::pair<unsigned, unsigned>, Scalar> thermalHalfTransBoundary_;
     bool enableEnergy_;
     bool enableDiffusivity_;
-    std::unordered_map<std::uint64_t, Scalar> thermalHalfTrans_;
-    std::unordered_map<std::uint64_t, Scalar> diffusivity_;
+    std::vector<Scalar> thermalHalfTrans_;
+    std::vector<Scalar> diffusivity_;
+    MemoryAccount memory_{MemoryRegistry::Owner::Transmissibilities};
 };
 
 } // namespace Opm
@@ -32,16 +32,26 @@
 #include <ebos/eclgenericwriter.hh>
 #include <ebos/ecloutputblackoilmodule.hh>
 
+#include <opm/models/parallel/threadedentityiterator.hh>
+
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 #include <opm/simulators/utils/ParallelRestart.hpp>
+#if HAVE_MPI
+#include <opm/simulators/utils/ParallelSolutionWriter.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
+#endif
 
 #include <opm/input/eclipse/Units/UnitSystem.hpp>
 
 #include <dune/grid/common/partitionset.hh>
 
+#include <algorithm>
+#include <cstdio>
+#include <exception>
 #include <limits>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace Opm::Properties {
 
@@ -58,9 +68,21 @@ struct EclOutputDoublePrecision {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct EclRestartPrecision {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EclMaxPendingOutput {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct EnableEsmry {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct EclParallelSolutionOutput {
+    using type = UndefinedProperty;
+};
 
 } // namespace Opm::Properties
 
@@ -116,8 +138,17 @@ public:
 
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableAsyncEclOutput,
                              "Write the ECL-formated results in a non-blocking way (i.e., using a separate thread).");
+        EWOMS_REGISTER_PARAM(TypeTag, double, EclRestartPrecision,
+                             "Round the cell arrays of the restart files to this relative precision, so that "
+                             "they compress better. Zero keeps the full precision.");
+        EWOMS_REGISTER_PARAM(TypeTag, int, EclMaxPendingOutput,
+                             "The maximum number of report and substeps whose asynchronous ECL output may be pending "
+                             "before the simulation waits for the writer thread.");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableEsmry,
                              "Write ESMRY file for fast loading of summary data.");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EclParallelSolutionOutput,
+                             "Let every process also write its cells of the solution to a PSOL file of the report step, "
+                             "without gathering them to the I/O rank. The restart file keeps the cell arrays.");
     }
 
     // The Simulator object should preferably have been const - the
@@ -132,7 +163,9 @@ public:
                    simulator.vanguard().gridView(),
                    simulator.vanguard().cartesianIndexMapper(),
                    simulator.vanguard().grid().comm().rank() == 0 ? &simulator.vanguard().equilCartesianIndexMapper() : nullptr,
-                   EWOMS_GET_PARAM(TypeTag, bool, EnableAsyncEclOutput), EWOMS_GET_PARAM(TypeTag, bool, EnableEsmry))
+                   EWOMS_GET_PARAM(TypeTag, bool, EnableAsyncEclOutput),
+                   EWOMS_GET_PARAM(TypeTag, int, EclMaxPendingOutput),
+                   EWOMS_GET_PARAM(TypeTag, bool, EnableEsmry))
         , simulator_(simulator)
     {
         this->eclOutputModule_ = std::make_unique<EclOutputBlackOilModule<TypeTag>>(simulator, this->wbp_index_list_, this->collectToIORank_);
@@ -192,6 +225,7 @@ public:
         }
 
         if (this->collectToIORank_.isParallel()) {
+            ScopedTimer gatherTimer(TimingRegistry::Region::OutputGather);
             OPM_BEGIN_PARALLEL_TRY_CATCH()
 
             this->collectToIORank_.collect({},
@@ -301,7 +335,14 @@ public:
             this->eclOutputModule_->addRftDataToWells(localWellData, reportStepNum);
         }
 
+        if (this->collectToIORank_.isParallel() && !localCellData.empty() &&
+            EWOMS_GET_PARAM(TypeTag, bool, EclParallelSolutionOutput))
+        {
+            this->writeParallelSolution(reportStepNum, localCellData);
+        }
+
         if (this->collectToIORank_.isParallel()) {
+            ScopedTimer gatherTimer(TimingRegistry::Region::OutputGather);
             this->collectToIORank_.collect(localCellData,
                                            eclOutputModule_->getBlockData(),
                                            eclOutputModule_->getWBPData(),
@@ -326,7 +367,8 @@ public:
                                 this->summaryState(),
                                 simulator_.problem().thresholdPressure().data(),
                                 curTime, nextStepSize,
-                                EWOMS_GET_PARAM(TypeTag, bool, EclOutputDoublePrecision));
+                                EWOMS_GET_PARAM(TypeTag, bool, EclOutputDoublePrecision),
+                                EWOMS_GET_PARAM(TypeTag, double, EclRestartPrecision));
         }
     }
 
@@ -376,11 +418,15 @@ public:
         {
             SummaryState& summaryState = simulator_.vanguard().summaryState();
             Action::State& actionState = simulator_.vanguard().actionState();
+            // every process only receives the solution of its own cells
+            std::vector<int> globalIndices(numElements);
+            for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+                globalIndices[elemIdx] = this->collectToIORank_.localIdxToGlobalIdx(elemIdx);
+            }
             auto restartValues = loadParallelRestart(this->eclIO_.get(), actionState, summaryState, solutionKeys, extraKeys,
-                                                     gridView.grid().comm());
+                                                     globalIndices, gridView.grid().comm());
             for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
-                unsigned globalIdx = this->collectToIORank_.localIdxToGlobalIdx(elemIdx);
-                eclOutputModule_->setRestart(restartValues.solution, elemIdx, globalIdx);
+                eclOutputModule_->setRestart(restartValues.solution, elemIdx, elemIdx);
             }
 
             auto& tracer_model = simulator_.problem().tracerModel();
@@ -388,8 +434,7 @@ public:
                 const auto& tracer_name = tracer_model.fname(tracer_index);
                 const auto& tracer_solution = restartValues.solution.data(tracer_name);
                 for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
-                    unsigned globalIdx = this->collectToIORank_.localIdxToGlobalIdx(elemIdx);
-                    tracer_model.setTracerConcentration(tracer_index, globalIdx, tracer_solution[globalIdx]);
+                    tracer_model.setTracerConcentration(tracer_index, elemIdx, tracer_solution[elemIdx]);
                 }
             }
 
@@ -437,6 +482,38 @@ private:
     const Schedule& schedule() const
     { return simulator_.vanguard().schedule(); }
 
+    // Every process writes the cell arrays of its interior cells straight
+    // into the PSOL file of the report step, which readParallelSolution()
+    // reads back. The arrays are still gathered for the restart file, from
+    // which a run is restarted.
+    void writeParallelSolution(const int reportStepNum, const data::Solution& localCellData)
+    {
+#if HAVE_MPI
+        const auto& gridView = simulator_.vanguard().gridView();
+        std::vector<int> localIndex;
+        std::vector<int> globalIndex;
+        int numGlobalCells = 0;
+        for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+            const int idx = simulator_.model().elementMapper().index(elem);
+            localIndex.push_back(idx);
+            globalIndex.push_back(this->collectToIORank_.localIdxToGlobalIdx(idx));
+            numGlobalCells = std::max(numGlobalCells, globalIndex.back() + 1);
+        }
+        numGlobalCells = gridView.comm().max(numGlobalCells);
+
+        const auto& ioConfig = eclState().getIOConfig();
+        char step[8];
+        std::snprintf(step, sizeof(step), "%04d", reportStepNum);
+        const std::string filename = ioConfig.getOutputDir() + "/" +
+            ioConfig.getBaseName() + ".PSOL" + step;
+        ::Opm::writeParallelSolution(gridView.comm(), filename, localCellData,
+                                     localIndex, globalIndex, numGlobalCells);
+#else
+        static_cast<void>(reportStepNum);
+        static_cast<void>(localCellData);
+#endif
+    }
+
     void prepareLocalCellData(const bool isSubStep,
                               const int  reportStepNum)
     {
@@ -447,18 +524,35 @@ private:
         eclOutputModule_->allocBuffers(numElements, reportStepNum,
                                       isSubStep, log, /*isRestart*/ false);
 
-        ElementContext elemCtx(simulator_);
-        ElementIterator elemIt = gridView.template begin</*codim=*/0>();
-
-        const ElementIterator& elemEndIt = gridView.template end</*codim=*/0>();
+        // every element writes its own entries of the cell arrays, hence the
+        // elements can be distributed over the threads
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView);
+        std::exception_ptr exceptionPtr = nullptr;
         OPM_BEGIN_PARALLEL_TRY_CATCH();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const Element& elem = *elemIt;
-
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-            eclOutputModule_->processElement(elemCtx);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ElementContext elemCtx(simulator_);
+            auto elemIt = threadedElemIt.beginParallel();
+            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                try {
+                    elemCtx.updatePrimaryStencil(*elemIt);
+                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+
+                    eclOutputModule_->processElement(elemCtx);
+                }
+                catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                    exceptionPtr = std::current_exception();
+                    threadedElemIt.setFinished();
+                }
+            }
+        }
+        if (exceptionPtr) {
+            std::rethrow_exception(exceptionPtr);
         }
         OPM_END_PARALLEL_TRY_CATCH("EclWriter::prepareLocalCellData() failed: ", simulator_.vanguard().grid().comm())
     }
@@ -483,12 +577,37 @@ private:
 
         this->eclOutputModule_->initializeFluxData();
 
+        // The regions do not change during the run, so the elements with a
+        // face between different regions are identified once. The others
+        // contribute nothing and their fluxes need not be computed.
+        const auto& interRegFlows = this->eclOutputModule_->getInterRegFlows();
+        if (this->hasInterRegionFace_.empty()) {
+            this->hasInterRegionFace_.assign(gridView.size(/*codim=*/0), false);
+            for (const auto& elem : elements(gridView, Dune::Partitions::interiorBorder)) {
+                const auto elemIdx = activeIndex(elem);
+                for (const auto& intersection : intersections(gridView, elem)) {
+                    if (intersection.neighbor() &&
+                        interRegFlows.isInterRegionConnection(elemIdx, activeIndex(intersection.outside())))
+                    {
+                        this->hasInterRegionFace_[elemIdx] = true;
+                        break;
+                    }
+                }
+            }
+        }
+
         OPM_BEGIN_PARALLEL_TRY_CATCH();
 
         for (const auto& elem : elements(gridView, Dune::Partitions::interiorBorder)) {
+            if (! this->hasInterRegionFace_[activeIndex(elem)]) {
+                continue;
+            }
+
+            // the intensive quantities come from the cache of the last
+            // linearization, the fluxes of the faces between regions are
+            // evaluated by the output module itself
             elemCtx.updateStencil(elem);
             elemCtx.updateIntensiveQuantities(timeIdx);
-            elemCtx.updateExtensiveQuantities(timeIdx);
 
             this->eclOutputModule_->processFluxes(elemCtx, activeIndex, cartesianIndex);
         }
@@ -502,6 +621,7 @@ private:
     Simulator& simulator_;
     std::unique_ptr<EclOutputBlackOilModule<TypeTag>> eclOutputModule_;
     Scalar restartTimeStepSize_;
+    std::vector<bool> hasInterRegionFace_;
 };
 } // namespace Opm
 
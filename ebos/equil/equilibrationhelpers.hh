@@ -39,8 +39,15 @@
 #include <opm/input/eclipse/EclipseState/InitConfig/Equil.hpp>
 #include <opm/common/utility/numeric/RootFinders.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <vector>
 
 
 /*
@@ -77,6 +84,9 @@
   const int phase2,
   const int cell,
   const double targetPc)
+
+  template <class FluidSystem, class MaterialLaw, class MaterialLawManager>
+  class PcInverseTables;
   } // namespace Equil
   } // namespace Opm
 
@@ -927,6 +937,170 @@ double satFromSumOfPcs(const MaterialLawManager& materialLawManager,
     return root;
 }
 
+/// Sampled capillary pressure curves of the saturation function classes
+/// met during an equilibration, used to narrow the search intervals of the
+/// inversions done by satFromPc() and satFromSumOfPcs().
+///
+/// Cells of the same saturation region whose scaled end points coincide
+/// share their capillary pressure curves.  The curve of such a class is
+/// sampled the second time the class is met, and later inversions for the
+/// class only need to refine the root within a single sampling interval,
+/// and a tabulated curve is linear or close to linear there.  The result
+/// does not depend on the classification.  A sampling interval which does
+/// not bracket the root of the cell's own curve falls back to the full
+/// saturation range.
+template <class FluidSystem, class MaterialLaw, class MaterialLawManager>
+class PcInverseTables
+{
+public:
+    /// Compute saturation of some phase corresponding to a given
+    /// capillary pressure, see satFromPc().
+    double satFromPc(const MaterialLawManager& materialLawManager,
+                     const int phase,
+                     const int cell,
+                     const double targetPc,
+                     const bool increasing = false)
+    {
+        const double s0 = increasing ? maxSaturations<FluidSystem>(materialLawManager, phase, cell) : minSaturations<FluidSystem>(materialLawManager, phase, cell);
+        const double s1 = increasing ? minSaturations<FluidSystem>(materialLawManager, phase, cell) : maxSaturations<FluidSystem>(materialLawManager, phase, cell);
+
+        const PcEq<FluidSystem, MaterialLaw, MaterialLawManager> f(materialLawManager, phase, cell, targetPc);
+        const double f0 = f(s0);
+        const double f1 = f(s1);
+        if (!std::isfinite(f0 + f1))
+            throw std::logic_error(fmt::format("The capillary pressure values {} and {} are not finite", f0, f1));
+
+        if (f0 <= 0.0)
+            return s0;
+        else if (f1 >= 0.0)
+            return s1;
+
+        return this->invert(classKey(materialLawManager, phase, -1, cell, increasing),
+                            f, targetPc, s0, s1);
+    }
+
+    /// Compute saturation of some phase corresponding to a given sum of
+    /// two capillary pressures, see satFromSumOfPcs().
+    double satFromSumOfPcs(const MaterialLawManager& materialLawManager,
+                           const int phase1,
+                           const int phase2,
+                           const int cell,
+                           const double targetPc)
+    {
+        const double s0 = minSaturations<FluidSystem>(materialLawManager, phase1, cell);
+        const double s1 = maxSaturations<FluidSystem>(materialLawManager, phase1, cell);
+
+        const PcEqSum<FluidSystem, MaterialLaw, MaterialLawManager> f(materialLawManager, phase1, phase2, cell, targetPc);
+        const double f0 = f(s0);
+        const double f1 = f(s1);
+        if (f0 <= 0.0)
+            return s0;
+        else if (f1 >= 0.0)
+            return s1;
+
+        return this->invert(classKey(materialLawManager, phase1, phase2, cell, false),
+                            f, targetPc, s0, s1);
+    }
+
+private:
+    /// Saturation region, phases, direction and scaled end points of a cell.
+    using Key = std::array<double, 16>;
+
+    struct Curve
+    {
+        int uses = 0;
+        std::vector<double> sat;
+        std::vector<double> pc;
+    };
+
+    /// Number of samples of a curve.
+    static constexpr int numSamples = 65;
+
+    /// Number of classes kept, cells with per-cell end points are not
+    /// worth sampling.
+    static constexpr std::size_t maxClasses = 4096;
+
+    static Key classKey(const MaterialLawManager& materialLawManager,
+                        const int phase1,
+                        const int phase2,
+                        const int cell,
+                        const bool increasing)
+    {
+        const auto& eps = materialLawManager.oilWaterScaledEpsInfoDrainage(cell);
+        return {
+            static_cast<double>(materialLawManager.satnumRegionIdx(cell)),
+            static_cast<double>(phase1), static_cast<double>(phase2),
+            increasing ? 1.0 : 0.0,
+            eps.Swl, eps.Swcr, eps.Swu, eps.Sowcr,
+            eps.Sgl, eps.Sgcr, eps.Sgu, eps.Sogcr,
+            eps.maxPcow, eps.maxPcgo,
+            eps.pcowLeverettFactor, eps.pcgoLeverettFactor,
+        };
+    }
+
+    /// Root of f(s) = pc(s) - targetPc in [s0, s1], with f(s0) > 0 and
+    /// f(s1) < 0.
+    template <class PcFunction>
+    double invert(const Key& key,
+                  const PcFunction& f,
+                  const double targetPc,
+                  const double s0,
+                  const double s1)
+    {
+        auto curvePos = this->curves_.find(key);
+        if (curvePos == this->curves_.end() && this->curves_.size() < maxClasses) {
+            curvePos = this->curves_.emplace(key, Curve{}).first;
+        }
+
+        if (curvePos != this->curves_.end()) {
+            auto& curve = curvePos->second;
+            if (++curve.uses == 2) {
+                curve.sat.resize(numSamples);
+                curve.pc.resize(numSamples);
+                for (int i = 0; i < numSamples; ++i) {
+                    curve.sat[i] = s0 + (s1 - s0) * i / (numSamples - 1);
+                    curve.pc[i] = f(curve.sat[i]) + targetPc;
+                    if (i > 0) {
+                        curve.pc[i] = std::min(curve.pc[i], curve.pc[i - 1]);
+                    }
+                }
+            }
+
+            if (!curve.pc.empty()) {
+                // First sample at or below the target, the curve decreases from s0 to s1.
+                const auto pos = std::lower_bound(curve.pc.begin() + 1, curve.pc.end(),
+                                                  targetPc, std::greater<double>());
+                if (pos != curve.pc.end()) {
+                    const auto k = std::distance(curve.pc.begin(), pos);
+                    const double sa = curve.sat[k - 1];
+                    const double sb = curve.sat[k];
+                    const double fb = f(sb);
+                    if (fb == 0.0) {
+                        return sb;
+                    }
+                    if (f(sa) > 0.0 && fb < 0.0) {
+                        return solve(f, sa, sb);
+                    }
+                }
+            }
+        }
+
+        return solve(f, s0, s1);
+    }
+
+    template <class PcFunction>
+    static double solve(const PcFunction& f, const double s0, const double s1)
+    {
+        const double tol = 1e-10;
+        // should at least converge in 2 times bisection but some safety here:
+        const int maxIter = -2*static_cast<int>(std::log2(tol)) + 10;
+        int usedIterations = -1;
+        return RegulaFalsiBisection<ThrowOnError>::solve(f, s0, s1, maxIter, tol, usedIterations);
+    }
+
+    std::map<Key, Curve> curves_;
+};
+
 /// Compute saturation from depth. Used for constant capillary pressure function
 template <class FluidSystem, class MaterialLaw, class MaterialLawManager>
 double satFromDepth(const MaterialLawManager& materialLawManager,
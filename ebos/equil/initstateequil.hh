@@ -59,6 +59,8 @@
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <exception>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
@@ -865,9 +867,13 @@ public:
         , press_    (rhs.press_)
     {
         // Note: We don't need to do anything to the 'fluidState_' here.
-        this->setEvaluationPoint(*rhs.evalPt_.position,
-                                 *rhs.evalPt_.region,
-                                 *rhs.evalPt_.ptable);
+        // The source has no evaluation point before its first call to
+        // deriveSaturations().
+        if (rhs.evalPt_.position != nullptr) {
+            this->setEvaluationPoint(*rhs.evalPt_.position,
+                                     *rhs.evalPt_.region,
+                                     *rhs.evalPt_.ptable);
+        }
     }
 
     /// Disabled assignment operator.
@@ -972,6 +978,10 @@ private:
     /// Evaluated capillary pressures from current set of material laws.
     std::array<double, FluidSystem::numPhases> matLawCapPress_;
 
+    /// Sampled capillary pressure curves for the inversions of this
+    /// object.  Each copy keeps its own curves.
+    mutable PcInverseTables<FluidSystem, MaterialLaw, MaterialLawManager> pcInverse_;
+
     /// Capture the input evaluation point information in internal state.
     ///
     /// \param[in] x Specific geometric point (depth within a specific cell).
@@ -1249,7 +1259,7 @@ fixUnphysicalTransition()
         sw = this->applySwatInit(pcgw, sw);
     }
 
-    sw = satFromSumOfPcs<FluidSystem, MaterialLaw>
+    sw = this->pcInverse_.satFromSumOfPcs
         (this->matLawMgr_, this->waterPos(), this->gasPos(),
          this->evalPt_.position->cell, pcgw);
     sg = 1.0 - sw;
@@ -1420,7 +1430,7 @@ invertCapPress(const double   pc,
                const PhaseIdx phasePos,
                const bool     isincr) const
 {
-    return satFromPc<FluidSystem, MaterialLaw>
+    return this->pcInverse_.satFromPc
         (this->matLawMgr_, static_cast<int>(phasePos),
          this->evalPt_.position->cell, pc, isincr);
 }
@@ -1992,8 +2002,12 @@ private:
         }
     }
 
-    template <class CellRange, class EquilibrationMethod>
+    // The cells are independent of each other, hence they are distributed over the
+    // threads. Every thread evaluates the saturations with its own copy of the phase
+    // saturation calculator, and it only writes the entries of its own cells.
+    template <class CellRange, class PhaseSat, class EquilibrationMethod>
     void cellLoop(const CellRange&      cells,
+                  const PhaseSat&       psat,
                   EquilibrationMethod&& eqmethod)
     {
         const auto oilPos = FluidSystem::oilPhaseIdx;
@@ -2004,33 +2018,61 @@ private:
         const auto gasActive = FluidSystem::phaseIsActive(gasPos);
         const auto watActive = FluidSystem::phaseIsActive(watPos);
 
-        auto pressures   = Details::PhaseQuantityValue{};
-        auto saturations = Details::PhaseQuantityValue{};
-        auto Rs          = 0.0;
-        auto Rv          = 0.0;
+        const auto cellsBegin = std::begin(cells);
+        const int numCells = std::distance(cellsBegin, std::end(cells));
+        std::exception_ptr exceptionPtr = nullptr;
 
-        for (const auto& cell : cells) {
-            eqmethod(cell, pressures, saturations, Rs, Rv);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            auto threadPsat  = psat;
+            auto pressures   = Details::PhaseQuantityValue{};
+            auto saturations = Details::PhaseQuantityValue{};
+            auto Rs          = 0.0;
+            auto Rv          = 0.0;
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int i = 0; i < numCells; ++i) {
+                try {
+                    const auto cell = cellsBegin[i];
+                    eqmethod(cell, threadPsat, pressures, saturations, Rs, Rv);
+
+                    if (oilActive) {
+                        this->pp_ [oilPos][cell] = pressures.oil;
+                        this->sat_[oilPos][cell] = saturations.oil;
+                    }
 
-            if (oilActive) {
-                this->pp_ [oilPos][cell] = pressures.oil;
-                this->sat_[oilPos][cell] = saturations.oil;
-            }
+                    if (gasActive) {
+                        this->pp_ [gasPos][cell] = pressures.gas;
+                        this->sat_[gasPos][cell] = saturations.gas;
+                    }
 
-            if (gasActive) {
-                this->pp_ [gasPos][cell] = pressures.gas;
-                this->sat_[gasPos][cell] = saturations.gas;
-            }
+                    if (watActive) {
+                        this->pp_ [watPos][cell] = pressures.water;
+                        this->sat_[watPos][cell] = saturations.water;
+                    }
 
-            if (watActive) {
-                this->pp_ [watPos][cell] = pressures.water;
-                this->sat_[watPos][cell] = saturations.water;
+                    if (oilActive && gasActive) {
+                        this->rs_[cell] = Rs;
+                        this->rv_[cell] = Rv;
+                    }
+                }
+                catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                    if (!exceptionPtr) {
+                        exceptionPtr = std::current_exception();
+                    }
+                }
             }
+        }
 
-            if (oilActive && gasActive) {
-                this->rs_[cell] = Rs;
-                this->rv_[cell] = Rv;
-            }
+        if (exceptionPtr) {
+            std::rethrow_exception(exceptionPtr);
         }
     }
 
@@ -2038,13 +2080,14 @@ private:
     void equilibrateCellCentres(const CellRange&         cells,
                                 const EquilReg&          eqreg,
                                 const PressTable&        ptable,
-                                PhaseSat&                psat)
+                                const PhaseSat&          psat)
     {
         using CellPos = typename PhaseSat::Position;
         using CellID  = std::remove_cv_t<std::remove_reference_t<
             decltype(std::declval<CellPos>().cell)>>;
-        this->cellLoop(cells, [this, &eqreg,  &ptable, &psat]
+        this->cellLoop(cells, psat, [this, &eqreg, &ptable]
             (const CellID                 cell,
+             PhaseSat&                    psat,
              Details::PhaseQuantityValue& pressures,
              Details::PhaseQuantityValue& saturations,
              double&                      Rs,
@@ -2072,14 +2115,15 @@ private:
                                const EquilReg&   eqreg,
                                const int         acc,
                                const PressTable& ptable,
-                               PhaseSat&         psat)
+                               const PhaseSat&   psat)
     {
         using CellPos = typename PhaseSat::Position;
         using CellID  = std::remove_cv_t<std::remove_reference_t<
             decltype(std::declval<CellPos>().cell)>>;
 
-        this->cellLoop(cells, [this, acc, &eqreg, &ptable, &psat]
+        this->cellLoop(cells, psat, [this, acc, &eqreg, &ptable]
             (const CellID                 cell,
+             PhaseSat&                    psat,
              Details::PhaseQuantityValue& pressures,
              Details::PhaseQuantityValue& saturations,
              double&                      Rs,
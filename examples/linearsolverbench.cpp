@@ -0,0 +1,234 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Runs the FlexibleSolver configurations of flow on linear systems written
+// by --linear-solver-verbosity > 10, and prints the setup time, the solve
+// time, the iterations and the memory used by the solver for each of them.
+//
+// Usage: linearsolverbench [options] <matrix> <rhs> [<matrix> <rhs> ...]
+//   --block-size=N       size of the matrix blocks, 1 to 6 (default 3)
+//   --pressure-index=N   index of the pressure in a block (default 0)
+//   --config=C           ilu0, cpr_quasiimpes, cpr_trueimpes, amg or a JSON file,
+//                        may be repeated (default all of the named ones)
+//   --repeat=N           number of solves of every system (default 1)
+
+#include <config.h>
+
+#include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/FlowLinearSolverParameters.hpp>
+#include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+#include <opm/simulators/linalg/setupPropertyTree.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/matrixmarket.hh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+
+struct Options
+{
+    int blockSize = 3;
+    int pressureIndex = 0;
+    int repeat = 1;
+    std::vector<std::string> configs;
+    std::vector<std::pair<std::string, std::string>> systems;
+};
+
+struct Result
+{
+    double setupTime = 0.0;
+    double solveTime = 0.0;
+    int iterations = 0;
+    bool converged = true;
+    double memory = 0.0;
+};
+
+// Resident set size of the process in MB, zero where /proc is not available.
+double residentMemory()
+{
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0;
+    long resident = 0;
+    if (!(statm >> pages >> resident)) {
+        return 0.0;
+    }
+    return resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+double secondsSince(const std::chrono::steady_clock::time_point start)
+{
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+template <class T>
+void readSystemFile(T& object, const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Could not read " + filename);
+    }
+    Dune::readMatrixMarket(object, file);
+}
+
+template <int bz>
+void benchmark(const Options& options)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bz, bz>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
+    using Operator = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+
+    std::cout << fmt::format("{:<40} {:<20} {:>10} {:>10} {:>8} {:>10}\n",
+                             "System", "Configuration", "Setup (s)", "Solve (s)", "Iter", "Mem (MB)");
+    for (const auto& [matrixFile, rhsFile] : options.systems) {
+        Matrix matrix;
+        Vector rhs;
+        readSystemFile(matrix, matrixFile);
+        readSystemFile(rhs, rhsFile);
+        if (matrix.N() != rhs.size()) {
+            throw std::runtime_error("The sizes of " + matrixFile + " and " + rhsFile + " do not match");
+        }
+
+        for (const auto& config : options.configs) {
+            Opm::FlowLinearSolverParameters param;
+            param.linsolver_ = config;
+            auto prm = Opm::setupPropertyTree(param, false, false);
+
+            // The true IMPES weights need the storage terms of the simulator,
+            // a dumped system only supports the quasi-IMPES ones.
+            using namespace std::string_literals;
+            const auto precType = prm.get("preconditioner.type"s, "cpr"s);
+            std::function<Vector()> weightsCalculator;
+            if (precType == "cpr" || precType == "cprt") {
+                prm.put("preconditioner.weight_type", "quasiimpes"s);
+                const bool transpose = precType == "cprt";
+                weightsCalculator = [&matrix, transpose, p = options.pressureIndex]() {
+                    return Opm::Amg::getQuasiImpesWeights<Matrix, Vector>(matrix, p, transpose);
+                };
+            }
+
+            Result result;
+            for (int rep = 0; rep < options.repeat; ++rep) {
+                const double memoryBefore = residentMemory();
+                auto start = std::chrono::steady_clock::now();
+                Operator op(matrix);
+                Dune::FlexibleSolver<Matrix, Vector> solver(op, prm, weightsCalculator,
+                                                            options.pressureIndex);
+                result.setupTime += secondsSince(start);
+                result.memory = std::max(result.memory, residentMemory() - memoryBefore);
+
+                Vector x(rhs.size());
+                x = 0.0;
+                Vector b(rhs);
+                Dune::InverseOperatorResult res;
+                start = std::chrono::steady_clock::now();
+                solver.apply(x, b, res);
+                result.solveTime += secondsSince(start);
+                result.iterations += res.iterations;
+                result.converged = result.converged && res.converged;
+            }
+
+            std::cout << fmt::format("{:<40} {:<20} {:>10.4f} {:>10.4f} {:>8} {:>10.1f}{}\n",
+                                     matrixFile, config,
+                                     result.setupTime / options.repeat,
+                                     result.solveTime / options.repeat,
+                                     result.iterations / options.repeat,
+                                     result.memory,
+                                     result.converged ? "" : "  not converged");
+        }
+    }
+}
+
+Options parseOptions(int argc, char** argv)
+{
+    Options options;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&arg](const std::string& option) {
+            return arg.substr(option.size());
+        };
+        if (arg.rfind("--block-size=", 0) == 0) {
+            options.blockSize = std::stoi(value("--block-size="));
+        } else if (arg.rfind("--pressure-index=", 0) == 0) {
+            options.pressureIndex = std::stoi(value("--pressure-index="));
+        } else if (arg.rfind("--repeat=", 0) == 0) {
+            options.repeat = std::max(std::stoi(value("--repeat=")), 1);
+        } else if (arg.rfind("--config=", 0) == 0) {
+            options.configs.push_back(value("--config="));
+        } else if (arg.rfind("--", 0) == 0) {
+            throw std::invalid_argument("Unknown option " + arg);
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty() || files.size() % 2 != 0) {
+        throw std::invalid_argument("Expected pairs of matrix and right hand side files");
+    }
+    for (std::size_t i = 0; i < files.size(); i += 2) {
+        options.systems.emplace_back(files[i], files[i + 1]);
+    }
+    if (options.configs.empty()) {
+        options.configs = {"ilu0", "cpr_quasiimpes", "cpr_trueimpes", "amg"};
+    }
+    return options;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    try {
+        const Options options = parseOptions(argc, argv);
+        switch (options.blockSize) {
+        case 1: benchmark<1>(options); break;
+        case 2: benchmark<2>(options); break;
+        case 3: benchmark<3>(options); break;
+        case 4: benchmark<4>(options); break;
+        case 5: benchmark<5>(options); break;
+        case 6: benchmark<6>(options); break;
+        default:
+            throw std::invalid_argument("Block size must be between 1 and 6");
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "linearsolverbench: " << e.what() << '\n'
+                  << "Usage: linearsolverbench [--block-size=N] [--pressure-index=N] [--config=C]... "
+                  << "[--repeat=N] <matrix> <rhs> [<matrix> <rhs> ...]\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,254 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Timings of the well model kernels that can run without a simulator, on
+// synthetic fields of 10 to 10000 wells. Every kernel is repeated until it
+// has run for at least the minimum time, and the mean time of one pass over
+// all wells and of one well is printed.
+//
+// Usage: wellkernelbench [minimum time per kernel in seconds, default 0.2]
+
+#include <config.h>
+
+#include <opm/input/eclipse/Schedule/VFPProdTable.hpp>
+#include <opm/simulators/wells/MSWellTreeLU.hpp>
+#include <opm/simulators/wells/NetworkPressureSolver.hpp>
+#include <opm/simulators/wells/VFPProdProperties.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+double minTime = 0.2;
+
+// Keeps the compiler from dropping the evaluations whose results are unused.
+volatile double sink = 0.0;
+
+// Runs kernel until minTime has passed, and prints the mean time of a run.
+template <class Kernel>
+void run(const std::string& name, const int numWells, Kernel&& kernel)
+{
+    using Clock = std::chrono::steady_clock;
+    int runs = 0;
+    const auto start = Clock::now();
+    std::chrono::duration<double> elapsed{0.0};
+    do {
+        kernel();
+        ++runs;
+        elapsed = Clock::now() - start;
+    } while (elapsed.count() < minTime);
+    const double perRun = elapsed.count() / runs;
+    std::cout << fmt::format("{:<32} {:>8} {:>14.3f} {:>14.3f} {:>10}\n",
+                             name, numWells, perRun * 1.0e6, perRun * 1.0e9 / numWells, runs);
+}
+
+// A production table with a bhp that increases with the rates and the thp.
+Opm::VFPProdTable makeTable()
+{
+    const std::vector<double> flo {0.0, 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1};
+    const std::vector<double> thp {10.0e5, 20.0e5, 40.0e5, 80.0e5};
+    const std::vector<double> wfr {0.0, 0.5, 1.0, 2.0, 5.0};
+    const std::vector<double> gfr {0.0, 50.0, 100.0, 200.0, 500.0};
+    const std::vector<double> alq {0.0, 1.0, 2.0};
+    std::vector<double> data;
+    data.reserve(thp.size() * wfr.size() * gfr.size() * alq.size() * flo.size());
+    for (const double t : thp) {
+        for (const double w : wfr) {
+            for (const double g : gfr) {
+                for (const double a : alq) {
+                    for (const double f : flo) {
+                        data.push_back(t + 1.0e5 * (1.0 + w) * (1.0 + 1.0e-3 * g) * (1.0 + 2.0e3 * f) - 1.0e4 * a);
+                    }
+                }
+            }
+        }
+    }
+    return Opm::VFPProdTable(1, 1000.0,
+                             Opm::VFPProdTable::FLO_TYPE::FLO_OIL,
+                             Opm::VFPProdTable::WFR_TYPE::WFR_WOR,
+                             Opm::VFPProdTable::GFR_TYPE::GFR_GOR,
+                             Opm::VFPProdTable::ALQ_TYPE::ALQ_UNDEF,
+                             flo, thp, wfr, gfr, alq, data);
+}
+
+void benchmarkVfp(const std::vector<int>& numWells)
+{
+    const auto table = makeTable();
+    Opm::VFPProdProperties properties;
+    properties.addTable(table);
+
+    for (const int n : numWells) {
+        // Every well has its own rates, which change a little between the calls.
+        std::vector<int> ids(n, 1);
+        std::vector<double> aqua(n), liquid(n), vapour(n), thp(n, 30.0e5), alq(n, 0.5);
+        for (int w = 0; w < n; ++w) {
+            liquid[w] = 0.001 + 0.09 * (w % 97) / 97.0;
+            aqua[w] = liquid[w] * (w % 7) * 0.5;
+            vapour[w] = liquid[w] * (w % 11) * 40.0;
+        }
+        std::vector<Opm::VFPProdProperties::EvaluationCache> caches(n);
+        double sum = 0.0;
+        int step = 0;
+
+        run("VFPProdProperties::bhp", n, [&]() {
+            const double scale = 1.0 + 1.0e-4 * (++step % 10);
+            for (int w = 0; w < n; ++w) {
+                sum += properties.bhp(1, scale * aqua[w], scale * liquid[w], scale * vapour[w], thp[w], alq[w]);
+            }
+        });
+        run("VFPProdProperties::bhp cached", n, [&]() {
+            const double scale = 1.0 + 1.0e-4 * (++step % 10);
+            for (int w = 0; w < n; ++w) {
+                sum += properties.bhp(1, scale * aqua[w], scale * liquid[w], scale * vapour[w],
+                                       thp[w], alq[w], caches[w]);
+            }
+        });
+        run("VFPProdProperties::bhp batch", n, [&]() {
+            sum += properties.bhp(ids, aqua, liquid, vapour, thp, alq, caches)[0];
+        });
+        sink = sum;
+    }
+}
+
+// Multisegment wells of numSegments segments, a tubing with two laterals.
+void benchmarkMSWells(const std::vector<int>& numWells, const int numSegments)
+{
+    constexpr int bs = 4;
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bs, bs>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bs>>;
+
+    std::vector<int> outlets(numSegments);
+    const int tubing = numSegments / 3;
+    for (int seg = 0; seg < numSegments; ++seg) {
+        if (seg == 0) {
+            outlets[seg] = -1;
+        } else if (seg == tubing + 1) {
+            outlets[seg] = tubing / 2;
+        } else if (seg == 2 * tubing + 1) {
+            outlets[seg] = tubing;
+        } else {
+            outlets[seg] = seg - 1;
+        }
+    }
+
+    Matrix D(numSegments, numSegments, 3 * numSegments, Matrix::row_wise);
+    for (auto row = D.createbegin(); row != D.createend(); ++row) {
+        const int seg = row.index();
+        row.insert(seg);
+        if (outlets[seg] >= 0) {
+            row.insert(outlets[seg]);
+        }
+        for (int inlet = 0; inlet < numSegments; ++inlet) {
+            if (outlets[inlet] == seg) {
+                row.insert(inlet);
+            }
+        }
+    }
+    for (auto row = D.begin(); row != D.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            *col = -0.1;
+            if (row.index() == col.index()) {
+                for (int i = 0; i < bs; ++i) {
+                    (*col)[i][i] = 10.0;
+                }
+            }
+        }
+    }
+    Vector b(numSegments);
+    b = 1.0;
+
+    for (const int n : numWells) {
+        std::vector<Opm::MSWellTreeLU<Matrix, Vector>> solvers(n);
+        for (auto& solver : solvers) {
+            solver.analyze(outlets, D);
+        }
+        Vector x(numSegments);
+        run(fmt::format("MSWellTreeLU {} segments", numSegments), n, [&]() {
+            for (auto& solver : solvers) {
+                solver.factorize(D);
+                x = b;
+                solver.solve(x);
+            }
+        });
+    }
+}
+
+// A network with a manifold per ten wells, the wells are the leaves.
+void benchmarkNetwork(const std::vector<int>& numWells)
+{
+    using Solver = Opm::NetworkPressureSolver;
+
+    const auto branch = [](const int node, const Solver::Rates& rates, const double up_press) {
+        const double total = rates[0] + rates[1] + rates[2];
+        return up_press + (1.0e6 + 1.0e4 * (node % 10)) * total * total;
+    };
+
+    for (const int n : numWells) {
+        const int numManifolds = (n + 9) / 10;
+        std::vector<Solver::Node> nodes(1 + numManifolds + n);
+        nodes[0].fixed_pressure = 20.0e5;
+        for (int m = 0; m < numManifolds; ++m) {
+            nodes[1 + m].parent = 0;
+        }
+        for (int w = 0; w < n; ++w) {
+            auto& leaf = nodes[1 + numManifolds + w];
+            leaf.parent = 1 + w / 10;
+            leaf.reference_pressure = 30.0e5;
+            leaf.inflow = {0.001, 0.002, 0.003};
+            leaf.inflow_derivative = {-1.0e-9, -1.0e-9, -2.0e-9};
+        }
+        Solver solver(nodes, branch);
+        std::vector<double> pressures(nodes.size(), 25.0e5);
+        run("NetworkPressureSolver::solve", n, [&]() {
+            std::vector<double> p = pressures;
+            solver.solve(p, 1.0e-3, 20);
+        });
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) {
+        minTime = std::atof(argv[1]);
+    }
+
+    const std::vector<int> numWells {10, 100, 1000, 10000};
+    std::cout << fmt::format("{:<32} {:>8} {:>14} {:>14} {:>10}\n",
+                             "Kernel", "Wells", "Time (us)", "Per well (ns)", "Runs");
+    benchmarkVfp(numWells);
+    benchmarkMSWells(numWells, 30);
+    // The network Jacobian is dense, larger fields take too long.
+    benchmarkNetwork({10, 100, 1000});
+
+    return EXIT_SUCCESS;
+}
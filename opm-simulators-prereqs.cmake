@@ -10,6 +10,7 @@ set (opm-simulators_CONFIG_VAR
   HAVE_OPENCL_HPP
   HAVE_FPGA
   HAVE_AMGCL
+  HAVE_HYPRE
   HAVE_VEXCL
   HAVE_SUITESPARSE_UMFPACK_H
   HAVE_DUNE_ISTL
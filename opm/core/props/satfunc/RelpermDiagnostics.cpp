@@ -39,6 +39,15 @@
 #include <opm/grid/CpGrid.hpp>
 #include <opm/grid/polyhedralgrid.hh>
 
+#include <array>
+#include <exception>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace Opm{
 
     bool RelpermDiagnostics::phaseCheck_(const EclipseState& es)
@@ -729,65 +738,129 @@ namespace Opm{
         }
     }
 
-    template <class CartesianIndexMapper>
-    void RelpermDiagnostics::diagnosis(const EclipseState& eclState,
-                                       const CartesianIndexMapper& cartesianIndexMapper)
+    bool RelpermDiagnostics::tableDiagnosis(const EclipseState& eclState)
     {
         OpmLog::info("\n===============Saturation Functions Diagnostics===============\n");
         bool doDiagnostics = phaseCheck_(eclState);
         if (!doDiagnostics) // no diagnostics needed for single phase problems
-            return;
+            return false;
         satFamilyCheck_(eclState);
         tableCheck_(eclState);
         unscaledEndPointsCheck_(eclState);
-        scaledEndPointsCheck_(eclState, cartesianIndexMapper);
+        return true;
+    }
+
+    template <class CartesianIndexMapper>
+    void RelpermDiagnostics::diagnosis(const EclipseState& eclState,
+                                       const CartesianIndexMapper& cartesianIndexMapper)
+    {
+        if (tableDiagnosis(eclState)) {
+            cellDiagnosis(eclState, cartesianIndexMapper, /*threaded=*/true).logMessages();
+        }
+    }
+
+    template <class CartesianIndexMapper>
+    DeferredLogger RelpermDiagnostics::cellDiagnosis(const EclipseState& eclState,
+                                                     const CartesianIndexMapper& cartesianIndexMapper,
+                                                     const bool threaded) const
+    {
+        const int nc = cartesianIndexMapper.compressedSize();
+        const EclEpsGridProperties epsGridProperties(eclState, false);
+        DeferredLogger logger;
+        int numThreads = 1;
+#ifdef _OPENMP
+        if (threaded) {
+            numThreads = omp_get_max_threads();
+        }
+#else
+        static_cast<void>(threaded);
+#endif
+        if (numThreads == 1) {
+            scaledEndPointsCheck_(eclState, epsGridProperties, cartesianIndexMapper, 0, nc, logger);
+            return logger;
+        }
+
+        // Every thread checks a contiguous range of cells, so appending the
+        // warnings of the threads in order keeps the order of the cells.
+        std::vector<DeferredLogger> threadLoggers(numThreads);
+        std::exception_ptr exceptionPtr = nullptr;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(numThreads)
+#endif
+        {
+#ifdef _OPENMP
+            const int thread = omp_get_thread_num();
+#else
+            const int thread = 0;
+#endif
+            const int begin = static_cast<long long>(nc) * thread / numThreads;
+            const int end = static_cast<long long>(nc) * (thread + 1) / numThreads;
+            try {
+                scaledEndPointsCheck_(eclState, epsGridProperties, cartesianIndexMapper,
+                                      begin, end, threadLoggers[thread]);
+            }
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                exceptionPtr = std::current_exception();
+            }
+        }
+        if (exceptionPtr) {
+            std::rethrow_exception(exceptionPtr);
+        }
+        for (const auto& threadLogger : threadLoggers) {
+            logger.appendMessages(threadLogger);
+        }
+        return logger;
     }
 
     template <class CartesianIndexMapper>
     void RelpermDiagnostics::scaledEndPointsCheck_(const EclipseState& eclState,
-                                                   const CartesianIndexMapper& cartesianIndexMapper)
+                                                   const EclEpsGridProperties& epsGridProperties,
+                                                   const CartesianIndexMapper& cartesianIndexMapper,
+                                                   const int begin, const int end,
+                                                   DeferredLogger& logger) const
     {
         // All end points are subject to round-off errors, checks should account for it
         const float tolerance = 1e-6;
-        const int nc = cartesianIndexMapper.compressedSize();
         const bool threepoint = eclState.runspec().endpointScaling().threepoint();
-        scaledEpsInfo_.resize(nc);
-        EclEpsGridProperties epsGridProperties(eclState, false);
         const std::string tag = "Scaled endpoints";
-        for (int c = 0; c < nc; ++c) {
-            const std::string satnumIdx = std::to_string(epsGridProperties.satRegion(c));
-            std::string cellIdx;
-            {
+        EclEpsScalingPointsInfo<double> scaledEpsInfo;
+        for (int c = begin; c < end; ++c) {
+            // the location of the cell is only needed for the warnings
+            auto location = [&epsGridProperties, &cartesianIndexMapper, c]() {
                 std::array<int, 3> ijk;
                 cartesianIndexMapper.cartesianCoordinate(c, ijk);
-                cellIdx = "(" + std::to_string(ijk[0]) + ", " +
+                return "(" + std::to_string(ijk[0]) + ", " +
                     std::to_string(ijk[1]) + ", " +
-                    std::to_string(ijk[2]) + ")";
-            }
-            scaledEpsInfo_[c].extractScaled(eclState, epsGridProperties, c);
+                    std::to_string(ijk[2]) + ") SATNUM = " +
+                    std::to_string(epsGridProperties.satRegion(c));
+            };
+            scaledEpsInfo.extractScaled(eclState, epsGridProperties, c);
 
             // SGU <= 1.0 - SWL
-            if (scaledEpsInfo_[c].Sgu > (1.0 - scaledEpsInfo_[c].Swl + tolerance)) {
-                const std::string msg = "For scaled endpoints input, cell" + cellIdx + " SATNUM = " + satnumIdx + ", SGU exceed 1.0 - SWL";
-                OpmLog::warning(tag, msg);
+            if (scaledEpsInfo.Sgu > (1.0 - scaledEpsInfo.Swl + tolerance)) {
+                const std::string msg = "For scaled endpoints input, cell" + location() + ", SGU exceed 1.0 - SWL";
+                logger.warning(tag, msg);
             }
 
             // SGL <= 1.0 - SWU
-            if (scaledEpsInfo_[c].Sgl > (1.0 - scaledEpsInfo_[c].Swu + tolerance)) {
-                const std::string msg = "For scaled endpoints input, cell" + cellIdx + " SATNUM = " + satnumIdx + ", SGL exceed 1.0 - SWU";
-                OpmLog::warning(tag, msg);
+            if (scaledEpsInfo.Sgl > (1.0 - scaledEpsInfo.Swu + tolerance)) {
+                const std::string msg = "For scaled endpoints input, cell" + location() + ", SGL exceed 1.0 - SWU";
+                logger.warning(tag, msg);
             }
 
             if (threepoint && fluidSystem_ == FluidSystem::BlackOil) {
                 // Mobilility check.
-                if ((scaledEpsInfo_[c].Sowcr + scaledEpsInfo_[c].Swcr) >= (1.0 + tolerance)) {
-                    const std::string msg = "For scaled endpoints input, cell" + cellIdx + " SATNUM = " + satnumIdx + ", SOWCR + SWCR exceed 1.0";
-                    OpmLog::warning(tag, msg);
+                if ((scaledEpsInfo.Sowcr + scaledEpsInfo.Swcr) >= (1.0 + tolerance)) {
+                    const std::string msg = "For scaled endpoints input, cell" + location() + ", SOWCR + SWCR exceed 1.0";
+                    logger.warning(tag, msg);
                 }
 
-            if ((scaledEpsInfo_[c].Sogcr + scaledEpsInfo_[c].Sgcr + scaledEpsInfo_[c].Swl) >= (1.0 + tolerance)) {
-                    const std::string msg = "For scaled endpoints input, cell" + cellIdx + " SATNUM = " + satnumIdx + ", SOGCR + SGCR + SWL exceed 1.0";
-                    OpmLog::warning(tag, msg);
+                if ((scaledEpsInfo.Sogcr + scaledEpsInfo.Sgcr + scaledEpsInfo.Swl) >= (1.0 + tolerance)) {
+                    const std::string msg = "For scaled endpoints input, cell" + location() + ", SOGCR + SGCR + SWL exceed 1.0";
+                    logger.warning(tag, msg);
                 }
             }
         }
@@ -795,7 +868,7 @@ namespace Opm{
 
 #define INSTANCE_DIAGNOSIS(...) \
     template void RelpermDiagnostics::diagnosis<Dune::CartesianIndexMapper<__VA_ARGS__>>(const EclipseState&, const Dune::CartesianIndexMapper<__VA_ARGS__>&); \
-    template void RelpermDiagnostics::scaledEndPointsCheck_<Dune::CartesianIndexMapper<__VA_ARGS__>>(const EclipseState&, const Dune::CartesianIndexMapper<__VA_ARGS__>&);
+    template DeferredLogger RelpermDiagnostics::cellDiagnosis<Dune::CartesianIndexMapper<__VA_ARGS__>>(const EclipseState&, const Dune::CartesianIndexMapper<__VA_ARGS__>&, bool) const;
 
     INSTANCE_DIAGNOSIS(Dune::CpGrid)
     INSTANCE_DIAGNOSIS(Dune::PolyhedralGrid<3,3>)
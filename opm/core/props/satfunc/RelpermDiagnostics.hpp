@@ -28,6 +28,7 @@
 #endif // HAVE_CONFIG_H
 
 #include <opm/material/fluidmatrixinteractions/EclEpsScalingPoints.hpp>
+#include <opm/simulators/utils/DeferredLogger.hpp>
 
 namespace Opm {
 
@@ -54,6 +55,23 @@ namespace Opm {
         void diagnosis(const EclipseState& eclState,
                        const CartesianIndexMapper& cartesianIndexMapper);
 
+        ///Checks of the saturation tables and their endpoints, the
+        ///messages are logged directly.
+        ///\return false for single phase runs, which need no
+        ///        cell-wise checks.
+        bool tableDiagnosis(const EclipseState& eclState);
+
+        ///Checks of the scaled endpoints of the cells of the mapper,
+        ///to be called after tableDiagnosis(). The cells are split
+        ///over the threads if threaded is true. Does not change the
+        ///object, so it can run in another thread while the tables
+        ///are no longer checked.
+        ///\return the warnings in the order of the cells.
+        template <class CartesianIndexMapper>
+        DeferredLogger cellDiagnosis(const EclipseState& eclState,
+                                     const CartesianIndexMapper& cartesianIndexMapper,
+                                     bool threaded) const;
+
     private:
         enum FluidSystem {
             OilWater,
@@ -74,7 +92,6 @@ namespace Opm {
         SaturationFunctionFamily satFamily_;
 
         std::vector<EclEpsScalingPointsInfo<double> > unscaledEpsInfo_;
-        std::vector<EclEpsScalingPointsInfo<double> > scaledEpsInfo_;
 
 
         ///Check the phase that used.
@@ -90,9 +107,13 @@ namespace Opm {
         ///Check endpoints in the saturation tables.
         void unscaledEndPointsCheck_(const EclipseState& eclState);
 
+        ///Check the scaled endpoints of the cells [begin, end).
         template <class CartesianIndexMapper>
         void scaledEndPointsCheck_(const EclipseState& eclState,
-                                   const CartesianIndexMapper& cartesianIndexMapper);
+                                   const EclEpsGridProperties& epsGridProperties,
+                                   const CartesianIndexMapper& cartesianIndexMapper,
+                                   int begin, int end,
+                                   DeferredLogger& logger) const;
 
         ///For every table, need to deal with case by case.
         void swofTableCheck_(const SwofTable& swofTables,
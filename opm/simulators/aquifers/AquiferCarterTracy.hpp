@@ -57,6 +57,19 @@ public:
         , aquct_data_(aquct_data)
     {}
 
+    void beginTimeStep()
+    {
+        Base::beginTimeStep();
+
+        // Reported in the output only. They are set here rather than in the
+        // assembly, which may evaluate the connections concurrently.
+        this->dimensionless_time_ = this->ebos_simulator_.time() / this->Tc_;
+        this->dimensionless_pressure_ =
+            linearInterpolation(this->aquct_data_.dimensionless_time,
+                                this->aquct_data_.dimensionless_pressure,
+                                this->dimensionless_time_);
+    }
+
     void endTimeStep() override
     {
         for (const auto& q : this->Qai_) {
@@ -117,15 +130,29 @@ protected:
         this->rhow_ = this->aquct_data_.waterDensity();
     }
 
+    void writeTypeState(std::ostream& os) const override
+    {
+        writeCheckpointValue(os, this->fluxValue_);
+    }
+
+    void readTypeState(std::istream& is) override
+    {
+        this->fluxValue_ = readCheckpointValue(is);
+
+        // The initial pressure may have been computed from the equilibrium
+        // with the reservoir, which calculateAquiferCondition() skips now.
+        if (! this->aquct_data_.initial_pressure.has_value()) {
+            this->aquct_data_.initial_pressure = this->pa0_;
+            const auto& tables = this->ebos_simulator_.vanguard()
+                .eclState().getTableManager();
+            this->aquct_data_.finishInitialisation(tables);
+        }
+    }
+
     std::pair<Scalar, Scalar>
-    getInfluenceTableValues(const Scalar td_plus_dt)
+    getInfluenceTableValues(const Scalar td_plus_dt) const
     {
         // We use the opm-common numeric linear interpolator
-        this->dimensionless_pressure_ =
-            linearInterpolation(this->aquct_data_.dimensionless_time,
-                                this->aquct_data_.dimensionless_pressure,
-                                this->dimensionless_time_);
-
         const auto PItd =
             linearInterpolation(this->aquct_data_.dimensionless_time,
                                 this->aquct_data_.dimensionless_pressure,
@@ -152,14 +179,14 @@ protected:
 
     // This function implements Eqs 5.8 and 5.9 of the EclipseTechnicalDescription
     std::pair<Scalar, Scalar>
-    calculateEqnConstants(const int idx, const Simulator& simulator)
+    calculateEqnConstants(const int idx, const Simulator& simulator) const
     {
         const Scalar td_plus_dt = (simulator.timeStepSize() + simulator.time()) / this->Tc_;
-        this->dimensionless_time_ = simulator.time() / this->Tc_;
+        const Scalar td = simulator.time() / this->Tc_;
 
         const auto [PItd, PItdprime] = this->getInfluenceTableValues(td_plus_dt);
 
-        const auto denom = this->Tc_ * (PItd - this->dimensionless_time_*PItdprime);
+        const auto denom = this->Tc_ * (PItd - td*PItdprime);
         const auto a = (this->beta_*dpai(idx) - this->fluxValue_*PItdprime) / denom;
         const auto b = this->beta_ / denom;
 
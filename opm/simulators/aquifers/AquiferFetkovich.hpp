@@ -107,6 +107,25 @@ protected:
         this->rhow_ = this->aqufetp_data_.waterDensity();
     }
 
+    void writeTypeState(std::ostream& os) const override
+    {
+        writeCheckpointValue(os, this->aquifer_pressure_);
+    }
+
+    void readTypeState(std::istream& is) override
+    {
+        this->aquifer_pressure_ = readCheckpointValue(is);
+
+        // The initial pressure may have been computed from the equilibrium
+        // with the reservoir, which calculateAquiferCondition() skips now.
+        if (! this->aqufetp_data_.initial_pressure.has_value()) {
+            this->aqufetp_data_.initial_pressure = this->pa0_;
+            const auto& tables = this->ebos_simulator_.vanguard()
+                .eclState().getTableManager();
+            this->aqufetp_data_.finishInitialisation(tables);
+        }
+    }
+
     inline Eval dpai(int idx)
     {
         const auto gdz =
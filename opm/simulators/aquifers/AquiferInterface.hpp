@@ -27,6 +27,7 @@
 
 #include <opm/output/data/Aquifer.hpp>
 
+#include <opm/simulators/utils/CheckpointStream.hpp>
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 
 #include <opm/material/common/MathToolbox.hpp>
@@ -37,8 +38,12 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <istream>
 #include <limits>
 #include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -111,6 +116,40 @@ public:
         initQuantities();
     }
 
+    // Write the state of the aquifer to a checkpoint of the simulation.
+    void writeState(std::ostream& os) const
+    {
+        os << ' ' << this->aquiferID();
+        writeCheckpointValue(os, this->W_flux_.value());
+        writeCheckpointValue(os, this->pa0_);
+        writeCheckpointValue(os, this->rhow_);
+        this->writeTypeState(os);
+    }
+
+    // Restore the state written by writeState(), in place of
+    // initialSolutionApplied().
+    void readState(std::istream& is)
+    {
+        int id = -1;
+        is >> id;
+        if (id != this->aquiferID()) {
+            throw std::runtime_error("The checkpoint does not match aquifer " +
+                                     std::to_string(this->aquiferID()));
+        }
+        const Scalar volume = readCheckpointValue(is);
+        this->pa0_ = readCheckpointValue(is);
+        const Scalar rhow = readCheckpointValue(is);
+        this->readTypeState(is);
+
+        this->solution_set_from_restart_ = true;
+        this->initQuantities();
+
+        // The volume of the checkpoint is the one of this process already,
+        // unlike the volume of a restart file which initQuantities() rescales.
+        this->W_flux_ = volume;
+        this->rhow_ = rhow;
+    }
+
     void beginTimeStep()
     {
         ElementContext elemCtx(ebos_simulator_);
@@ -165,6 +204,11 @@ public:
         return this->connections_.size();
     }
 
+    // Index of the connection of a cell on this process, -1 if it has none.
+    int connectionIndex(const unsigned cellIdx) const {
+        return this->cellToConnectionIdx_[cellIdx];
+    }
+
     int aquiferID() const { return this->aquiferID_; }
 
 protected:
@@ -377,6 +421,10 @@ protected:
 
     virtual void assignRestartData(const data::AquiferData& xaq) = 0;
 
+    // The state of the aquifer type in the checkpoints.
+    virtual void writeTypeState(std::ostream& os) const = 0;
+    virtual void readTypeState(std::istream& is) = 0;
+
     virtual void calculateInflowRate(int idx, const Simulator& simulator) = 0;
 
     virtual void calculateAquiferCondition() = 0;
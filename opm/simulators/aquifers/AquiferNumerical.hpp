@@ -25,11 +25,16 @@
 
 #include <opm/input/eclipse/EclipseState/Aquifer/NumericalAquifer/SingleNumericalAquifer.hpp>
 
+#include <opm/simulators/utils/CheckpointStream.hpp>
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -46,6 +51,8 @@ public:
     using BlackoilIndices = GetPropType<TypeTag, Properties::Indices>;
 
     using GridView = GetPropType<TypeTag, Properties::GridView>;
+    using ElementMapper = GetPropType<TypeTag, Properties::ElementMapper>;
+    using Element = typename GridView::template Codim<0>::Entity;
     using MaterialLaw = GetPropType<TypeTag, Properties::MaterialLaw>;
 
     enum { dimWorld = GridView::dimensionworld };
@@ -82,7 +89,7 @@ public:
         }
 
         if (aquifer_on_process) {
-            this->checkConnectsToReservoir();
+            this->collectInteriorCells();
         }
     }
 
@@ -137,6 +144,36 @@ public:
         this->cumulative_flux_ = 0.;
     }
 
+    // Write the state of the aquifer to a checkpoint of the simulation.
+    void writeState(std::ostream& os) const
+    {
+        os << ' ' << this->aquiferID();
+        writeCheckpointValue(os, this->pressure_);
+        writeCheckpointValue(os, this->flux_rate_);
+        writeCheckpointValue(os, this->cumulative_flux_);
+        writeCheckpointValues(os, this->init_pressure_);
+    }
+
+    // Restore the state written by writeState(), in place of
+    // initialSolutionApplied().
+    void readState(std::istream& is)
+    {
+        int id = -1;
+        is >> id;
+        if (id != this->aquiferID()) {
+            throw std::runtime_error("The checkpoint does not match aquifer " +
+                                     std::to_string(this->aquiferID()));
+        }
+        this->pressure_ = readCheckpointValue(is);
+        this->flux_rate_ = readCheckpointValue(is);
+        this->cumulative_flux_ = readCheckpointValue(is);
+        if (!readCheckpointValues(is, this->init_pressure_)) {
+            throw std::runtime_error("The checkpoint does not match the cells of aquifer " +
+                                     std::to_string(this->aquiferID()));
+        }
+        this->solution_set_from_restart_ = true;
+    }
+
     int aquiferID() const
     {
         return static_cast<int>(this->id_);
@@ -156,6 +193,11 @@ private:
     // TODO: maybe unordered_map can also do the work to save memory?
     std::vector<int> cell_to_aquifer_cell_idx_;
 
+    // The interior elements of the aquifer cells on this process, and the
+    // position of the cell connecting to the reservoir among them, if any.
+    std::vector<Element> interior_cells_;
+    int connecting_cell_ {-1};
+
     inline bool co2store_() const
     {
         return ebos_simulator_.vanguard().eclState().runspec().co2Storage();
@@ -169,26 +211,24 @@ private:
         return FluidSystem::waterPhaseIdx;
     }
 
-    void checkConnectsToReservoir()
+    // Collect the aquifer cells once, such that the pressure and flux updates
+    // do not need to visit every element of the grid.
+    void collectInteriorCells()
     {
-        ElementContext elem_ctx(this->ebos_simulator_);
-        auto elemIt = std::find_if(this->ebos_simulator_.gridView().template begin</*codim=*/0>(),
-                                   this->ebos_simulator_.gridView().template end</*codim=*/0>(),
-            [&elem_ctx, this](const auto& elem) -> bool
-        {
-            elem_ctx.updateStencil(elem);
-
-            const auto cell_index = elem_ctx
-                .globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-
-            return this->cell_to_aquifer_cell_idx_[cell_index] == 0;
-        });
-
-        assert ((elemIt != this->ebos_simulator_.gridView().template end</*codim=*/0>())
-                && "Internal error locating numerical aquifer's connecting cell");
+        const auto& gridView = this->ebos_simulator_.gridView();
+        ElementMapper elem_mapper(gridView, Dune::mcmgElementLayout());
+        for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+            const int idx = this->cell_to_aquifer_cell_idx_[elem_mapper.index(elem)];
+            if (idx < 0) {
+                continue;
+            }
+            if (idx == 0) {
+                this->connecting_cell_ = this->interior_cells_.size();
+            }
+            this->interior_cells_.push_back(elem);
+        }
 
-        this->connects_to_reservoir_ =
-            elemIt->partitionType() == Dune::InteriorEntity;
+        this->connects_to_reservoir_ = this->connecting_cell_ >= 0;
     }
 
     double calculateAquiferPressure() const
@@ -203,23 +243,13 @@ private:
         double sum_watervolume = 0.;
 
         ElementContext  elem_ctx(this->ebos_simulator_);
-        const auto& gridView = this->ebos_simulator_.gridView();
-        auto elemIt = gridView.template begin</*codim=*/0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/0>();
         OPM_BEGIN_PARALLEL_TRY_CATCH();
 
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
-            if (elem.partitionType() != Dune::InteriorEntity) {
-                continue;
-            }
+        for (const auto& elem : this->interior_cells_) {
             elem_ctx.updatePrimaryStencil(elem);
 
             const size_t cell_index = elem_ctx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
             const int idx = this->cell_to_aquifer_cell_idx_[cell_index];
-            if (idx < 0) {
-                continue;
-            }
 
             elem_ctx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
             const auto& iq0 = elem_ctx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
@@ -258,60 +288,45 @@ private:
             return aquifer_flux;
         }
 
+        // we only need the first aquifer cell
         ElementContext elem_ctx(this->ebos_simulator_);
-        const auto& gridView = this->ebos_simulator_.gridView();
-        auto elemIt = gridView.template begin</*codim=*/0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
-            if (elem.partitionType() != Dune::InteriorEntity) {
-                continue;
-            }
-            // elem_ctx.updatePrimaryStencil(elem);
-            elem_ctx.updateStencil(elem);
-
-            const std::size_t cell_index = elem_ctx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const int idx = this->cell_to_aquifer_cell_idx_[cell_index];
-            // we only need the first aquifer cell
-            if (idx != 0) {
+        const auto& elem = this->interior_cells_[this->connecting_cell_];
+        // elem_ctx.updatePrimaryStencil(elem);
+        elem_ctx.updateStencil(elem);
+
+        const std::size_t cell_index = elem_ctx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+        elem_ctx.updateAllIntensiveQuantities();
+        elem_ctx.updateAllExtensiveQuantities();
+
+        const std::size_t num_interior_faces = elem_ctx.numInteriorFaces(/*timeIdx*/ 0);
+        // const auto &problem = elem_ctx.problem();
+        const auto& stencil = elem_ctx.stencil(0);
+        // const auto& inQuants = elem_ctx.intensiveQuantities(0, /*timeIdx*/ 0);
+
+        for (std::size_t face_idx = 0; face_idx < num_interior_faces; ++face_idx) {
+            const auto& face = stencil.interiorFace(face_idx);
+            // dof index
+            const std::size_t i = face.interiorIndex();
+            const std::size_t j = face.exteriorIndex();
+            // compressed index
+            // const size_t I = stencil.globalSpaceIndex(i);
+            const std::size_t J = stencil.globalSpaceIndex(j);
+
+            assert(stencil.globalSpaceIndex(i) == cell_index);
+
+            // we do not consider the flux within aquifer cells
+            // we only need the flux to the connections
+            if (this->cell_to_aquifer_cell_idx_[J] > 0) {
                 continue;
             }
-            elem_ctx.updateAllIntensiveQuantities();
-            elem_ctx.updateAllExtensiveQuantities();
-
-            const std::size_t num_interior_faces = elem_ctx.numInteriorFaces(/*timeIdx*/ 0);
-            // const auto &problem = elem_ctx.problem();
-            const auto& stencil = elem_ctx.stencil(0);
-            // const auto& inQuants = elem_ctx.intensiveQuantities(0, /*timeIdx*/ 0);
-
-            for (std::size_t face_idx = 0; face_idx < num_interior_faces; ++face_idx) {
-                const auto& face = stencil.interiorFace(face_idx);
-                // dof index
-                const std::size_t i = face.interiorIndex();
-                const std::size_t j = face.exteriorIndex();
-                // compressed index
-                // const size_t I = stencil.globalSpaceIndex(i);
-                const std::size_t J = stencil.globalSpaceIndex(j);
-
-                assert(stencil.globalSpaceIndex(i) == cell_index);
-
-                // we do not consider the flux within aquifer cells
-                // we only need the flux to the connections
-                if (this->cell_to_aquifer_cell_idx_[J] > 0) {
-                    continue;
-                }
-                const auto& exQuants = elem_ctx.extensiveQuantities(face_idx, /*timeIdx*/ 0);
-                const double water_flux = Toolbox::value(exQuants.volumeFlux(this->phaseIdx_()));
-
-                const std::size_t up_id = water_flux >= 0.0 ? i : j;
-                const auto& intQuantsIn = elem_ctx.intensiveQuantities(up_id, 0);
-                const double invB = Toolbox::value(intQuantsIn.fluidState().invB(this->phaseIdx_()));
-                const double face_area = face.area();
-                aquifer_flux += water_flux * invB * face_area;
-            }
-
-            // we only need to handle the first aquifer cell, we can exit loop here
-            break;
+            const auto& exQuants = elem_ctx.extensiveQuantities(face_idx, /*timeIdx*/ 0);
+            const double water_flux = Toolbox::value(exQuants.volumeFlux(this->phaseIdx_()));
+
+            const std::size_t up_id = water_flux >= 0.0 ? i : j;
+            const auto& intQuantsIn = elem_ctx.intensiveQuantities(up_id, 0);
+            const double invB = Toolbox::value(intQuantsIn.fluidState().invB(this->phaseIdx_()));
+            const double face_area = face.area();
+            aquifer_flux += water_flux * invB * face_area;
         }
 
         return aquifer_flux;
@@ -92,7 +92,9 @@ public:
     void beginEpisode();
     void beginTimeStep();
     void beginIteration();
-    // add the water rate due to aquifers to the source term.
+    // add the water rate due to aquifers to the source term. Only the
+    // connection of the cell is updated, so different cells may be
+    // added concurrently.
     template <class Context>
     void addToSource(RateVector& rates, const Context& context, unsigned spaceIdx, unsigned timeIdx) const;
     void endIteration();
@@ -123,6 +125,12 @@ protected:
     mutable std::vector<AquiferFetkovich_object> aquifers_Fetkovich;
     std::vector<AquiferNumerical<TypeTag>> aquifers_numerical;
 
+    // The analytic aquifers connected to every cell, those of cell c are
+    // cellAquifers_[cellAquiferBegin_[c]] up to cellAquifers_[cellAquiferBegin_[c + 1]].
+    std::vector<unsigned> cellAquiferBegin_;
+    std::vector<AquiferInterface<TypeTag>*> cellAquifers_;
+    void initCellAquifers();
+
     // This initialization function is used to connect the parser objects with the ones needed by AquiferCarterTracy
     void init();
 
@@ -55,6 +55,38 @@ BlackoilAquiferModel<TypeTag>::initialSolutionApplied()
             aquifer.initialSolutionApplied();
         }
     }
+
+    initCellAquifers();
+}
+
+template <typename TypeTag>
+void
+BlackoilAquiferModel<TypeTag>::initCellAquifers()
+{
+    std::vector<AquiferInterface<TypeTag>*> aquifers;
+    for (auto& aquifer : aquifers_CarterTracy) {
+        aquifers.push_back(&aquifer);
+    }
+    for (auto& aquifer : aquifers_Fetkovich) {
+        aquifers.push_back(&aquifer);
+    }
+
+    cellAquiferBegin_.clear();
+    cellAquifers_.clear();
+    if (aquifers.empty()) {
+        return;
+    }
+
+    const unsigned numCells = simulator_.gridView().size(/*codim=*/0);
+    cellAquiferBegin_.assign(numCells + 1, 0);
+    for (unsigned cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+        for (auto* aquifer : aquifers) {
+            if (aquifer->connectionIndex(cellIdx) >= 0) {
+                cellAquifers_.push_back(aquifer);
+            }
+        }
+        cellAquiferBegin_[cellIdx + 1] = cellAquifers_.size();
+    }
 }
 
 template <typename TypeTag>
@@ -114,15 +146,13 @@ BlackoilAquiferModel<TypeTag>::addToSource(RateVector& rates,
                                            unsigned spaceIdx,
                                            unsigned timeIdx) const
 {
-    if (aquiferCarterTracyActive()) {
-        for (auto& aquifer : aquifers_CarterTracy) {
-            aquifer.addToSource(rates, context, spaceIdx, timeIdx);
-        }
+    if (cellAquiferBegin_.empty()) {
+        return;
     }
-    if (aquiferFetkovichActive()) {
-        for (auto& aquifer : aquifers_Fetkovich) {
-            aquifer.addToSource(rates, context, spaceIdx, timeIdx);
-        }
+
+    const unsigned cellIdx = context.globalSpaceIndex(spaceIdx, timeIdx);
+    for (unsigned i = cellAquiferBegin_[cellIdx]; i < cellAquiferBegin_[cellIdx + 1]; ++i) {
+        cellAquifers_[i]->addToSource(rates, context, spaceIdx, timeIdx);
     }
 }
 
@@ -161,19 +191,57 @@ BlackoilAquiferModel<TypeTag>::endEpisode()
 template <typename TypeTag>
 template <class Restarter>
 void
-BlackoilAquiferModel<TypeTag>::serialize(Restarter& /* res */)
+BlackoilAquiferModel<TypeTag>::serialize(Restarter& res)
 {
-    // TODO (?)
-    throw std::logic_error("BlackoilAquiferModel::serialize() is not yet implemented");
+    res.serializeSectionBegin("BlackoilAquiferModel");
+    auto& os = res.serializeStream();
+    os << this->aquifers_CarterTracy.size()
+       << ' ' << this->aquifers_Fetkovich.size()
+       << ' ' << this->aquifers_numerical.size();
+    for (const auto& aquifer : this->aquifers_CarterTracy) {
+        aquifer.writeState(os);
+    }
+    for (const auto& aquifer : this->aquifers_Fetkovich) {
+        aquifer.writeState(os);
+    }
+    for (const auto& aquifer : this->aquifers_numerical) {
+        aquifer.writeState(os);
+    }
+    res.serializeSectionEnd();
 }
 
 template <typename TypeTag>
 template <class Restarter>
 void
-BlackoilAquiferModel<TypeTag>::deserialize(Restarter& /* res */)
+BlackoilAquiferModel<TypeTag>::deserialize(Restarter& res)
 {
-    // TODO (?)
-    throw std::logic_error("BlackoilAquiferModel::deserialize() is not yet implemented");
+    // The state of the checkpoint replaces the initialization in
+    // initialSolutionApplied(), which is not called on a restart.
+    res.deserializeSectionBegin("BlackoilAquiferModel");
+    auto& is = res.deserializeStream();
+    std::size_t numCarterTracy = 0, numFetkovich = 0, numNumerical = 0;
+    is >> numCarterTracy >> numFetkovich >> numNumerical;
+    if (numCarterTracy != this->aquifers_CarterTracy.size() ||
+        numFetkovich != this->aquifers_Fetkovich.size() ||
+        numNumerical != this->aquifers_numerical.size())
+    {
+        throw std::runtime_error("The checkpoint does not match the aquifers of the deck");
+    }
+    for (auto& aquifer : this->aquifers_CarterTracy) {
+        aquifer.readState(is);
+    }
+    for (auto& aquifer : this->aquifers_Fetkovich) {
+        aquifer.readState(is);
+    }
+    for (auto& aquifer : this->aquifers_numerical) {
+        aquifer.readState(is);
+    }
+    if (!is) {
+        throw std::runtime_error("The aquifer state of the checkpoint could not be read");
+    }
+    res.deserializeSectionEnd();
+
+    initCellAquifers();
 }
 
 // Initialize the aquifers in the deck
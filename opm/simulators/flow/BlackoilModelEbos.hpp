@@ -36,6 +36,7 @@
 #include <opm/simulators/wells/WellConnectionAuxiliaryModule.hpp>
 #include <opm/simulators/flow/countGlobalCells.hpp>
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
 
 #include <opm/grid/UnstructuredGrid.h>
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
@@ -66,6 +67,7 @@
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <utility>
 #include <vector>
 #include <algorithm>
 
@@ -163,6 +165,8 @@ namespace Opm {
         using Simulator = GetPropType<TypeTag, Properties::Simulator>;
         using Grid = GetPropType<TypeTag, Properties::Grid>;
         using ElementContext = GetPropType<TypeTag, Properties::ElementContext>;
+        using IntensiveQuantities = GetPropType<TypeTag, Properties::IntensiveQuantities>;
+        using ThreadManager = GetPropType<TypeTag, Properties::ThreadManager>;
         using SparseMatrixAdapter = GetPropType<TypeTag, Properties::SparseMatrixAdapter>;
         using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
         using PrimaryVariables = GetPropType<TypeTag, Properties::PrimaryVariables>;
@@ -233,6 +237,7 @@ namespace Opm {
         {
             // compute global sum of number of cells
             global_nc_ = detail::countGlobalCells(grid_);
+            setupInteriorCells_();
             convergence_reports_.reserve(300); // Often insufficient, but avoids frequent moves.
         }
 
@@ -252,9 +257,14 @@ namespace Opm {
             // update the solution variables in ebos
             if ( timer.lastStepFailed() ) {
                 ebosSimulator_.model().updateFailed();
+                if (param_.interpolate_after_chop_) {
+                    interpolateAfterChop_(timer.currentStepLength());
+                }
             } else {
                 ebosSimulator_.model().advanceTimeLevel();
             }
+            have_best_iterate_ = false;
+            last_step_length_ = timer.currentStepLength();
 
             // Set the timestep size, episode index, and non-linear iteration index
             // for ebos explicitly. ebos needs to know the report step/episode index
@@ -329,6 +339,9 @@ namespace Opm {
             {
                 auto convrep = getConvergence(timer, iteration,residual_norms);
                 report.converged = convrep.converged()  && iteration > nonlinear_solver.minIter();;
+                if (param_.interpolate_after_chop_) {
+                    recordIterate_(iteration, residual_norms);
+                }
                 ConvergenceReport::Severity severity = convrep.severityOfWorstFailure();
                 convergence_reports_.back().report.push_back(std::move(convrep));
 
@@ -340,7 +353,13 @@ namespace Opm {
                 }
             }
             report.update_time += perfTimer.stop();
-            residual_norms_history_.push_back(residual_norms);
+            residual_norms_history_.push(residual_norms);
+            if (!report.converged && nonlinear_solver.detectDivergence(residual_norms_history_)) {
+                failureReport_ += report;
+                const std::string msg = "Solver convergence failure - Residual grew by more than a factor "
+                    + std::to_string(nonlinear_solver.divergenceFactor()) + " in the last two iterations.";
+                OPM_THROW_NOLOG(TooManyIterations, msg);
+            }
             if (!report.converged) {
                 perfTimer.reset();
                 perfTimer.start();
@@ -362,7 +381,12 @@ namespace Opm {
                     wellModel().linearize(ebosSimulator().model().linearizer().jacobian(),
                                           ebosSimulator().model().linearizer().residual());
 
+                    const double residual_norm = residual_norms.empty() ? 0.0
+                        : *std::max_element(residual_norms.begin(), residual_norms.end());
+                    ebosSimulator_.model().newtonMethod().linearSolver().setNonlinearResidual(iteration, residual_norm);
+                    setInitialGuess(x, iteration, residual_norm, timer.currentStepLength());
                     solveJacobianSystem(x);
+                    storeUpdate(x, iteration, residual_norm, timer.currentStepLength());
                     report.linear_solve_setup_time += linear_solve_setup_time_;
                     report.linear_solve_time += perfTimer.stop();
                     report.total_linear_iterations += linearIterationsLastSolve();
@@ -388,7 +412,7 @@ namespace Opm {
                     // Stabilize the nonlinear update.
                     bool isOscillate = false;
                     bool isStagnate = false;
-                    nonlinear_solver.detectOscillations(residual_norms_history_, iteration, isOscillate, isStagnate);
+                    nonlinear_solver.detectOscillations(residual_norms_history_, isOscillate, isStagnate);
                     if (isOscillate) {
                         current_relaxation_ -= nonlinear_solver.relaxIncrement();
                         current_relaxation_ = std::max(current_relaxation_, nonlinear_solver.relaxMax());
@@ -438,12 +462,18 @@ namespace Opm {
         SimulatorReportSingle assembleReservoir(const SimulatorTimerInterface& /* timer */,
                                                 const int iterationIdx)
         {
+            ScopedTimer assemblyTimer(TimingRegistry::Region::Assembly);
+
             // -------- Mass balance equations --------
             ebosSimulator_.model().newtonMethod().setIterationIndex(iterationIdx);
             ebosSimulator_.problem().beginIteration();
             ebosSimulator_.model().linearizer().linearizeDomain();
             ebosSimulator_.problem().endIteration();
 
+            // The reservoir matrix is complete, an accelerator may start copying it
+            // while the convergence check and the well linearization are done.
+            ebosSimulator_.model().newtonMethod().linearSolver().prefetchMatrix(ebosSimulator_.model().linearizer().jacobian());
+
             return wellModel().lastReport();
         }
 
@@ -453,16 +483,12 @@ namespace Opm {
             Scalar resultDelta = 0.0;
             Scalar resultDenom = 0.0;
 
-            const auto& elemMapper = ebosSimulator_.model().elementMapper();
-            const auto& gridView = ebosSimulator_.gridView();
-            auto elemIt = gridView.template begin</*codim=*/0>();
-            const auto& elemEndIt = gridView.template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++elemIt) {
-                const auto& elem = *elemIt;
-                if (elem.partitionType() != Dune::InteriorEntity)
-                    continue;
-
-                unsigned globalElemIdx = elemMapper.index(elem);
+            const int numInteriorCells = interiorCells_.size();
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:resultDelta,resultDenom)
+#endif
+            for (int i = 0; i < numInteriorCells; ++i) {
+                const unsigned globalElemIdx = interiorCells_[i];
                 const auto& priVarsNew = ebosSimulator_.model().solution(/*timeIdx=*/0)[globalElemIdx];
 
                 Scalar pressureNew;
@@ -528,8 +554,10 @@ namespace Opm {
                 }
             }
 
-            resultDelta = gridView.comm().sum(resultDelta);
-            resultDenom = gridView.comm().sum(resultDenom);
+            Scalar results[2] = { resultDelta, resultDenom };
+            grid_.comm().sum(results, 2);
+            resultDelta = results[0];
+            resultDenom = results[1];
 
             if (resultDenom > 0.0)
                 return resultDelta/resultDenom;
@@ -543,17 +571,51 @@ namespace Opm {
             return ebosSimulator_.model().newtonMethod().linearSolver().iterations ();
         }
 
+        /// Set the initial guess of the linear solve according to
+        /// --linear-solver-initial-guess.
+        /// 0: zero.
+        /// 1: the update of the previous Newton iteration, scaled by the ratio of
+        ///    the current and previous residual norms, and zero in the first iteration.
+        /// 2: as 1, and in the first iteration the first update of the previous
+        ///    time step, scaled by the ratio of the time step lengths.
+        void setInitialGuess(BVector& x, const int iteration,
+                             const double residual_norm, const double dt) const
+        {
+            x = 0.0;
+            if (iteration > 0) {
+                if (param_.linear_solver_initial_guess_ > 0 && last_update_residual_norm_ > 0.0
+                    && last_update_.size() == x.size()) {
+                    x.axpy(residual_norm / last_update_residual_norm_, last_update_);
+                }
+            } else if (param_.linear_solver_initial_guess_ > 1 && first_update_dt_ > 0.0
+                       && first_update_.size() == x.size()) {
+                x.axpy(dt / first_update_dt_, first_update_);
+            }
+        }
+
+        /// Keep the solution of the linear solve for the initial guess of later solves.
+        void storeUpdate(const BVector& x, const int iteration,
+                         const double residual_norm, const double dt)
+        {
+            if (param_.linear_solver_initial_guess_ == 0) {
+                return;
+            }
+            last_update_ = x;
+            last_update_residual_norm_ = residual_norm;
+            if (iteration == 0 && param_.linear_solver_initial_guess_ > 1) {
+                first_update_ = x;
+                first_update_dt_ = dt;
+            }
+        }
+
         /// Solve the Jacobian system Jx = r where J is the Jacobian and
-        /// r is the residual.
+        /// r is the residual. On input x is the initial guess.
         void solveJacobianSystem(BVector& x)
         {
 
             auto& ebosJac = ebosSimulator_.model().linearizer().jacobian();
             auto& ebosResid = ebosSimulator_.model().linearizer().residual();
 
-            // set initial guess
-            x = 0.0;
-
             auto& ebosSolver = ebosSimulator_.model().newtonMethod().linearSolver();
             Dune::Timer perfTimer;
             perfTimer.start();
@@ -571,11 +633,56 @@ namespace Opm {
 
 
         /// Apply an update to the primary variables.
+        /// Remember the current Newton iterate if it has the smallest residual
+        /// of the time step so far, and a smaller one than the old solution.
+        void recordIterate_(const int iteration, const std::vector<double>& residual_norms)
+        {
+            const double norm = residual_norms.empty() ? 0.0
+                : *std::max_element(residual_norms.begin(), residual_norms.end());
+            if (iteration == 0) {
+                // the first iterate is the old solution
+                initial_residual_norm_ = norm;
+                return;
+            }
+            if (std::isfinite(norm) && norm < initial_residual_norm_ &&
+                (!have_best_iterate_ || norm < best_iterate_residual_norm_)) {
+                best_iterate_ = ebosSimulator_.model().solution(/*timeIdx=*/0);
+                best_iterate_residual_norm_ = norm;
+                have_best_iterate_ = true;
+            }
+        }
+
+        /// Move the old solution towards the best iterate of the failed step,
+        /// proportionally to the size of the chopped step. Cells whose primary
+        /// variables were switched in between keep the old solution.
+        void interpolateAfterChop_(const double dt)
+        {
+            if (!have_best_iterate_ || last_step_length_ <= 0.0) {
+                return;
+            }
+            const double weight = std::clamp(dt / last_step_length_, 0.0, 1.0);
+            SolutionVector& solution = ebosSimulator_.model().solution(/*timeIdx=*/0);
+            for (std::size_t dofIdx = 0; dofIdx < solution.size(); ++dofIdx) {
+                auto& priVars = solution[dofIdx];
+                const auto& target = best_iterate_[dofIdx];
+                if (priVars.primaryVarsMeaning() != target.primaryVarsMeaning() ||
+                    priVars.primaryVarsMeaningBrine() != target.primaryVarsMeaningBrine()) {
+                    continue;
+                }
+                for (std::size_t eqIdx = 0; eqIdx < priVars.size(); ++eqIdx) {
+                    priVars[eqIdx] += weight * (target[eqIdx] - priVars[eqIdx]);
+                }
+            }
+            ebosSimulator_.model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+        }
+
         void updateSolution(const BVector& dx)
         {
             auto& ebosNewtonMethod = ebosSimulator_.model().newtonMethod();
             SolutionVector& solution = ebosSimulator_.model().solution(/*timeIdx=*/0);
 
+            reportQuiescentCells_(dx, solution);
+
             ebosNewtonMethod.update_(/*nextSolution=*/solution,
                                      /*curSolution=*/solution,
                                      /*update=*/dx,
@@ -587,6 +694,40 @@ namespace Opm {
             ebosSimulator_.model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
         }
 
+        /// Log the fraction of the interior cells whose primary variables are
+        /// (almost) unchanged by a Newton update. Their local Jacobian blocks
+        /// and residuals would not need a new linearization in the next
+        /// iteration.
+        void reportQuiescentCells_(const BVector& dx, const SolutionVector& solution) const
+        {
+            constexpr Scalar tolerance = 1.0e-6;
+            long int quiescent = 0;
+            const int numInteriorCells = interiorCells_.size();
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:quiescent)
+#endif
+            for (int i = 0; i < numInteriorCells; ++i) {
+                const unsigned cell = interiorCells_[i];
+                bool changed = false;
+                for (int pvIdx = 0; pvIdx < numEq && !changed; ++pvIdx) {
+                    // the pressure update is relative, the others are absolute
+                    const Scalar scale = pvIdx == Indices::pressureSwitchIdx
+                        ? std::abs(solution[cell][pvIdx]) : 1.0;
+                    changed = std::abs(dx[cell][pvIdx]) > tolerance * scale;
+                }
+                if (!changed) {
+                    ++quiescent;
+                }
+            }
+
+            long int counts[2] = { quiescent, numInteriorCells };
+            grid_.comm().sum(counts, 2);
+            if (terminal_output_ && counts[1] > 0) {
+                OpmLog::debug("Newton update left " + std::to_string(counts[0]) + " of "
+                              + std::to_string(counts[1]) + " cells unchanged");
+            }
+        }
+
         /// Return true if output to cout is wanted.
         bool terminalOutputEnabled() const
         {
@@ -624,11 +765,15 @@ namespace Opm {
                 sumBuffer.push_back( pvSum );
                 sumBuffer.push_back( numAquiferPvSum );
 
-                // compute global sum
-                comm.sum( sumBuffer.data(), sumBuffer.size() );
+                {
+                    ScopedTimer reductionTimer(TimingRegistry::Region::ConvergenceReduction);
 
-                // compute global max
-                comm.max( maxBuffer.data(), maxBuffer.size() );
+                    // compute global sum
+                    comm.sum( sumBuffer.data(), sumBuffer.size() );
+
+                    // compute global max
+                    comm.max( maxBuffer.data(), maxBuffer.size() );
+                }
 
                 // restore values to local variables
                 for( int compIdx = 0, buffIdx = 0; compIdx < numComp; ++compIdx, ++buffIdx )
@@ -654,6 +799,11 @@ namespace Opm {
         }
 
         /// \brief Get reservoir quantities on this process needed for convergence calculations.
+        ///
+        /// All quantities are accumulated in a single pass over the interior cells.
+        /// If the intensive quantity cache is up to date, the pass is distributed
+        /// over the threads of the process and each thread accumulates into its own
+        /// buffers which are combined at the end.
         /// \return A pair of the local pore volume of interior cells and the pore volumes
         ///         of the cells associated with a numerical aquifer.
         std::tuple<double,double> localConvergenceData(std::vector<Scalar>& R_sum,
@@ -663,122 +813,63 @@ namespace Opm {
             double pvSumLocal = 0.0;
             double numAquiferPvSumLocal = 0.0;
             const auto& ebosModel = ebosSimulator_.model();
-            const auto& ebosProblem = ebosSimulator_.problem();
-
-            const auto& ebosResid = ebosSimulator_.model().linearizer().residual();
 
-            ElementContext elemCtx(ebosSimulator_);
-            const auto& gridView = ebosSimulator().gridView();
-            const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
             OPM_BEGIN_PARALLEL_TRY_CATCH();
 
-            for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
-                 elemIt != elemEndIt;
-                 ++elemIt)
-            {
-                const auto& elem = *elemIt;
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                const unsigned cell_idx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& fs = intQuants.fluidState();
-
-                const double pvValue = ebosProblem.referencePorosity(cell_idx, /*timeIdx=*/0) * ebosModel.dofTotalVolume( cell_idx );
-                pvSumLocal += pvValue;
-
-                if (isNumericalAquiferCell(gridView.grid(), elem))
-                {
-                    numAquiferPvSumLocal += pvValue;
+            const bool haveCachedIntQuants = interiorCells_.empty() ||
+                ebosModel.cachedIntensiveQuantities(interiorCells_.front(), /*timeIdx=*/0) != nullptr;
+
+            if (haveCachedIntQuants) {
+                const int numThreads = ThreadManager::maxThreads();
+                const int numComp = R_sum.size();
+                std::vector<std::vector<Scalar>> threadRSum(numThreads, std::vector<Scalar>(numComp, 0.0));
+                std::vector<std::vector<Scalar>> threadMaxCoeff(numThreads, maxCoeff);
+                std::vector<std::vector<Scalar>> threadBAvg(numThreads, std::vector<Scalar>(numComp, 0.0));
+                std::vector<double> threadPvSum(numThreads, 0.0);
+                std::vector<double> threadNumAquiferPvSum(numThreads, 0.0);
+
+                const int numInteriorCells = interiorCells_.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+                for (int i = 0; i < numInteriorCells; ++i) {
+                    const int threadId = ThreadManager::threadId();
+                    const unsigned cell_idx = interiorCells_[i];
+                    addCellConvergenceData_(cell_idx,
+                                            *ebosModel.cachedIntensiveQuantities(cell_idx, /*timeIdx=*/0),
+                                            isNumericalAquiferCell_[i],
+                                            threadRSum[threadId], threadMaxCoeff[threadId],
+                                            threadBAvg[threadId], threadPvSum[threadId],
+                                            threadNumAquiferPvSum[threadId]);
                 }
 
-                for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx)
-                {
-                    if (!FluidSystem::phaseIsActive(phaseIdx)) {
-                        continue;
+                for (int threadId = 0; threadId < numThreads; ++threadId) {
+                    for (int compIdx = 0; compIdx < numComp; ++compIdx) {
+                        R_sum[compIdx] += threadRSum[threadId][compIdx];
+                        B_avg[compIdx] += threadBAvg[threadId][compIdx];
+                        maxCoeff[compIdx] = std::max(maxCoeff[compIdx], threadMaxCoeff[threadId][compIdx]);
                     }
-
-                    const unsigned compIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
-
-                    B_avg[ compIdx ] += 1.0 / fs.invB(phaseIdx).value();
-                    const auto R2 = ebosResid[cell_idx][compIdx];
-
-                    R_sum[ compIdx ] += R2;
-                    maxCoeff[ compIdx ] = std::max( maxCoeff[ compIdx ], std::abs( R2 ) / pvValue );
-                }
-
-                if constexpr (has_solvent_) {
-                    B_avg[ contiSolventEqIdx ] += 1.0 / intQuants.solventInverseFormationVolumeFactor().value();
-                    const auto R2 = ebosResid[cell_idx][contiSolventEqIdx];
-                    R_sum[ contiSolventEqIdx ] += R2;
-                    maxCoeff[ contiSolventEqIdx ] = std::max( maxCoeff[ contiSolventEqIdx ], std::abs( R2 ) / pvValue );
-                }
-                if constexpr (has_extbo_) {
-                    B_avg[ contiZfracEqIdx ] += 1.0 / fs.invB(FluidSystem::gasPhaseIdx).value();
-                    const auto R2 = ebosResid[cell_idx][contiZfracEqIdx];
-                    R_sum[ contiZfracEqIdx ] += R2;
-                    maxCoeff[ contiZfracEqIdx ] = std::max( maxCoeff[ contiZfracEqIdx ], std::abs( R2 ) / pvValue );
-                }
-                if constexpr (has_polymer_) {
-                    B_avg[ contiPolymerEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
-                    const auto R2 = ebosResid[cell_idx][contiPolymerEqIdx];
-                    R_sum[ contiPolymerEqIdx ] += R2;
-                    maxCoeff[ contiPolymerEqIdx ] = std::max( maxCoeff[ contiPolymerEqIdx ], std::abs( R2 ) / pvValue );
-                }
-                if constexpr (has_foam_) {
-                    B_avg[ contiFoamEqIdx ] += 1.0 / fs.invB(FluidSystem::gasPhaseIdx).value();
-                    const auto R2 = ebosResid[cell_idx][contiFoamEqIdx];
-                    R_sum[ contiFoamEqIdx ] += R2;
-                    maxCoeff[ contiFoamEqIdx ] = std::max( maxCoeff[ contiFoamEqIdx ], std::abs( R2 ) / pvValue );
+                    pvSumLocal += threadPvSum[threadId];
+                    numAquiferPvSumLocal += threadNumAquiferPvSum[threadId];
                 }
-                if constexpr (has_brine_) {
-                    B_avg[ contiBrineEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
-                    const auto R2 = ebosResid[cell_idx][contiBrineEqIdx];
-                    R_sum[ contiBrineEqIdx ] += R2;
-                    maxCoeff[ contiBrineEqIdx ] = std::max( maxCoeff[ contiBrineEqIdx ], std::abs( R2 ) / pvValue );
-                }
-
-                if constexpr (has_polymermw_) {
-                    static_assert(has_polymer_);
-
-                    B_avg[contiPolymerMWEqIdx] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
-                    // the residual of the polymer molecular equation is scaled down by a 100, since molecular weight
-                    // can be much bigger than 1, and this equation shares the same tolerance with other mass balance equations
-                    // TODO: there should be a more general way to determine the scaling-down coefficient
-                    const auto R2 = ebosResid[cell_idx][contiPolymerMWEqIdx] / 100.;
-                    R_sum[contiPolymerMWEqIdx] += R2;
-                    maxCoeff[contiPolymerMWEqIdx] = std::max( maxCoeff[contiPolymerMWEqIdx], std::abs( R2 ) / pvValue );
-                }
-
-                if constexpr (has_energy_) {
-                    B_avg[ contiEnergyEqIdx ] += 1.0;
-                    const auto R2 = ebosResid[cell_idx][contiEnergyEqIdx];
-                    R_sum[ contiEnergyEqIdx ] += R2;
-                    maxCoeff[ contiEnergyEqIdx ] = std::max( maxCoeff[ contiEnergyEqIdx ], std::abs( R2 ) / pvValue );
+            }
+            else {
+                // The intensive quantities must be evaluated on the fly, which the
+                // element context only supports from a single thread.
+                ElementContext elemCtx(ebosSimulator_);
+                const auto& elemMapper = ebosModel.elementMapper();
+                const auto& gridView = ebosSimulator().gridView();
+                // the elements are visited in the order of interiorCells_
+                std::size_t i = 0;
+                for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+                    const unsigned cell_idx = elemMapper.index(elem);
+                    addCellConvergenceData_(cell_idx,
+                                            convergenceIntensiveQuantities_(elemCtx, elem, cell_idx),
+                                            isNumericalAquiferCell_[i++],
+                                            R_sum, maxCoeff, B_avg,
+                                            pvSumLocal, numAquiferPvSumLocal);
                 }
-
-                if constexpr (has_micp_) {
-                    B_avg[ contiMicrobialEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
-                    const auto R1 = ebosResid[cell_idx][contiMicrobialEqIdx];
-                    R_sum[ contiMicrobialEqIdx ] += R1;
-                    maxCoeff[ contiMicrobialEqIdx ] = std::max( maxCoeff[ contiMicrobialEqIdx ], std::abs( R1 ) / pvValue );
-                    B_avg[ contiOxygenEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
-                    const auto R2 = ebosResid[cell_idx][contiOxygenEqIdx];
-                    R_sum[ contiOxygenEqIdx ] += R2;
-                    maxCoeff[ contiOxygenEqIdx ] = std::max( maxCoeff[ contiOxygenEqIdx ], std::abs( R2 ) / pvValue );
-                    B_avg[ contiUreaEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
-                    const auto R3 = ebosResid[cell_idx][contiUreaEqIdx];
-                    R_sum[ contiUreaEqIdx ] += R3;
-                    maxCoeff[ contiUreaEqIdx ] = std::max( maxCoeff[ contiUreaEqIdx ], std::abs( R3 ) / pvValue );
-                    B_avg[ contiBiofilmEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
-                    const auto R4 = ebosResid[cell_idx][contiBiofilmEqIdx];
-                    R_sum[ contiBiofilmEqIdx ] += R4;
-                    maxCoeff[ contiBiofilmEqIdx ] = std::max( maxCoeff[ contiBiofilmEqIdx ], std::abs( R4 ) / pvValue );
-                    B_avg[ contiCalciteEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
-                    const auto R5 = ebosResid[cell_idx][contiCalciteEqIdx];
-                    R_sum[ contiCalciteEqIdx ] += R5;
-                    maxCoeff[ contiCalciteEqIdx ] = std::max( maxCoeff[ contiCalciteEqIdx ], std::abs( R5 ) / pvValue );
             }
-          }
 
             OPM_END_PARALLEL_TRY_CATCH("BlackoilModelEbos::localConvergenceData() failed: ", grid_.comm());
 
@@ -792,29 +883,182 @@ namespace Opm {
             return {pvSumLocal, numAquiferPvSumLocal};
         }
 
+        /// \brief Add the convergence contributions of a single interior cell.
+        void addCellConvergenceData_(const unsigned cell_idx,
+                                     const IntensiveQuantities& intQuants,
+                                     const bool isNumericalAquifer,
+                                     std::vector<Scalar>& R_sum,
+                                     std::vector<Scalar>& maxCoeff,
+                                     std::vector<Scalar>& B_avg,
+                                     double& pvSumLocal,
+                                     double& numAquiferPvSumLocal) const
+        {
+            const auto& ebosModel = ebosSimulator_.model();
+            const auto& ebosProblem = ebosSimulator_.problem();
+            const auto& ebosResid = ebosModel.linearizer().residual();
+            const auto& fs = intQuants.fluidState();
+
+            const double pvValue = ebosProblem.referencePorosity(cell_idx, /*timeIdx=*/0) * ebosModel.dofTotalVolume( cell_idx );
+            pvSumLocal += pvValue;
+
+            if (isNumericalAquifer)
+            {
+                numAquiferPvSumLocal += pvValue;
+            }
+
+            for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx)
+            {
+                if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                    continue;
+                }
+
+                const unsigned compIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
+
+                B_avg[ compIdx ] += 1.0 / fs.invB(phaseIdx).value();
+                const auto R2 = ebosResid[cell_idx][compIdx];
+
+                R_sum[ compIdx ] += R2;
+                maxCoeff[ compIdx ] = std::max( maxCoeff[ compIdx ], std::abs( R2 ) / pvValue );
+            }
+
+            if constexpr (has_solvent_) {
+                B_avg[ contiSolventEqIdx ] += 1.0 / intQuants.solventInverseFormationVolumeFactor().value();
+                const auto R2 = ebosResid[cell_idx][contiSolventEqIdx];
+                R_sum[ contiSolventEqIdx ] += R2;
+                maxCoeff[ contiSolventEqIdx ] = std::max( maxCoeff[ contiSolventEqIdx ], std::abs( R2 ) / pvValue );
+            }
+            if constexpr (has_extbo_) {
+                B_avg[ contiZfracEqIdx ] += 1.0 / fs.invB(FluidSystem::gasPhaseIdx).value();
+                const auto R2 = ebosResid[cell_idx][contiZfracEqIdx];
+                R_sum[ contiZfracEqIdx ] += R2;
+                maxCoeff[ contiZfracEqIdx ] = std::max( maxCoeff[ contiZfracEqIdx ], std::abs( R2 ) / pvValue );
+            }
+            if constexpr (has_polymer_) {
+                B_avg[ contiPolymerEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
+                const auto R2 = ebosResid[cell_idx][contiPolymerEqIdx];
+                R_sum[ contiPolymerEqIdx ] += R2;
+                maxCoeff[ contiPolymerEqIdx ] = std::max( maxCoeff[ contiPolymerEqIdx ], std::abs( R2 ) / pvValue );
+            }
+            if constexpr (has_foam_) {
+                B_avg[ contiFoamEqIdx ] += 1.0 / fs.invB(FluidSystem::gasPhaseIdx).value();
+                const auto R2 = ebosResid[cell_idx][contiFoamEqIdx];
+                R_sum[ contiFoamEqIdx ] += R2;
+                maxCoeff[ contiFoamEqIdx ] = std::max( maxCoeff[ contiFoamEqIdx ], std::abs( R2 ) / pvValue );
+            }
+            if constexpr (has_brine_) {
+                B_avg[ contiBrineEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
+                const auto R2 = ebosResid[cell_idx][contiBrineEqIdx];
+                R_sum[ contiBrineEqIdx ] += R2;
+                maxCoeff[ contiBrineEqIdx ] = std::max( maxCoeff[ contiBrineEqIdx ], std::abs( R2 ) / pvValue );
+            }
+
+            if constexpr (has_polymermw_) {
+                static_assert(has_polymer_);
+
+                B_avg[contiPolymerMWEqIdx] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
+                // the residual of the polymer molecular equation is scaled down by a 100, since molecular weight
+                // can be much bigger than 1, and this equation shares the same tolerance with other mass balance equations
+                // TODO: there should be a more general way to determine the scaling-down coefficient
+                const auto R2 = ebosResid[cell_idx][contiPolymerMWEqIdx] / 100.;
+                R_sum[contiPolymerMWEqIdx] += R2;
+                maxCoeff[contiPolymerMWEqIdx] = std::max( maxCoeff[contiPolymerMWEqIdx], std::abs( R2 ) / pvValue );
+            }
+
+            if constexpr (has_energy_) {
+                B_avg[ contiEnergyEqIdx ] += 1.0;
+                const auto R2 = ebosResid[cell_idx][contiEnergyEqIdx];
+                R_sum[ contiEnergyEqIdx ] += R2;
+                maxCoeff[ contiEnergyEqIdx ] = std::max( maxCoeff[ contiEnergyEqIdx ], std::abs( R2 ) / pvValue );
+            }
+
+            if constexpr (has_micp_) {
+                B_avg[ contiMicrobialEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
+                const auto R1 = ebosResid[cell_idx][contiMicrobialEqIdx];
+                R_sum[ contiMicrobialEqIdx ] += R1;
+                maxCoeff[ contiMicrobialEqIdx ] = std::max( maxCoeff[ contiMicrobialEqIdx ], std::abs( R1 ) / pvValue );
+                B_avg[ contiOxygenEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
+                const auto R2 = ebosResid[cell_idx][contiOxygenEqIdx];
+                R_sum[ contiOxygenEqIdx ] += R2;
+                maxCoeff[ contiOxygenEqIdx ] = std::max( maxCoeff[ contiOxygenEqIdx ], std::abs( R2 ) / pvValue );
+                B_avg[ contiUreaEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
+                const auto R3 = ebosResid[cell_idx][contiUreaEqIdx];
+                R_sum[ contiUreaEqIdx ] += R3;
+                maxCoeff[ contiUreaEqIdx ] = std::max( maxCoeff[ contiUreaEqIdx ], std::abs( R3 ) / pvValue );
+                B_avg[ contiBiofilmEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
+                const auto R4 = ebosResid[cell_idx][contiBiofilmEqIdx];
+                R_sum[ contiBiofilmEqIdx ] += R4;
+                maxCoeff[ contiBiofilmEqIdx ] = std::max( maxCoeff[ contiBiofilmEqIdx ], std::abs( R4 ) / pvValue );
+                B_avg[ contiCalciteEqIdx ] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
+                const auto R5 = ebosResid[cell_idx][contiCalciteEqIdx];
+                R_sum[ contiCalciteEqIdx ] += R5;
+                maxCoeff[ contiCalciteEqIdx ] = std::max( maxCoeff[ contiCalciteEqIdx ], std::abs( R5 ) / pvValue );
+            }
+        }
+
+        /// A candidate for the cells with the largest CNV errors.
+        struct WorstCellEntry
+        {
+            double value = -1.0;
+            int cell = -1;
+            int rank = 0;
+        };
+
+        /// \brief Insert a cell into the list of the cells with the largest errors,
+        ///        ordered by decreasing error, if its error is large enough.
+        static void insertWorstCell_(WorstCellEntry* worst, const int numWorst,
+                                     const WorstCellEntry& entry)
+        {
+            if (!(entry.value > worst[numWorst - 1].value)) {
+                return;
+            }
+            int pos = numWorst - 1;
+            for (; pos > 0 && worst[pos - 1].value < entry.value; --pos) {
+                worst[pos] = worst[pos - 1];
+            }
+            worst[pos] = entry;
+        }
+
         /// \brief Compute the total pore volume of cells violating CNV that are not part
         ///        of a numerical aquifer.
-        double computeCnvErrorPv(const std::vector<Scalar>& B_avg, double dt)
+        ///
+        /// The same pass finds the cells with the largest CNV errors of each
+        /// equation, with their cartesian indices, on all processes.
+        double computeCnvErrorPv(const std::vector<Scalar>& B_avg, double dt,
+                                 std::vector<ConvergenceReport::WorstCell>& worstCells)
         {
             double errorPV{};
+            long int errorCells{};
             const auto& ebosModel = ebosSimulator_.model();
             const auto& ebosProblem = ebosSimulator_.problem();
             const auto& ebosResid = ebosSimulator_.model().linearizer().residual();
-            const auto& gridView = ebosSimulator().gridView();
-            ElementContext elemCtx(ebosSimulator_);
+
+            // The worst cells of every equation, by thread.
+            const int numWorst = std::max(param_.num_worst_cells_, 0);
+            const int numWorstThreads = numWorst > 0 ? ThreadManager::maxThreads() : 0;
+            std::vector<std::vector<WorstCellEntry>> threadWorst(numWorstThreads,
+                                                                 std::vector<WorstCellEntry>(numEq * numWorst));
 
             OPM_BEGIN_PARALLEL_TRY_CATCH();
 
-            for (const auto& elem: elements(gridView, Dune::Partitions::interiorBorder))
+            // Only the residual and the pore volume are needed here, so there is
+            // no need to evaluate the intensive quantities of the cells. The
+            // cells of the interior and the border partitions are checked.
+            const int numInteriorCells = interiorCells_.size();
+            const int numCells = numInteriorCells + borderCells_.size();
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:errorPV,errorCells)
+#endif
+            for (int i = 0; i < numCells; ++i)
             {
+                const bool interior = i < numInteriorCells;
                 // Skip cells of numerical Aquifer
-                if (isNumericalAquiferCell(gridView.grid(), elem))
+                if (interior ? isNumericalAquiferCell_[i]
+                             : isNumericalAquiferBorderCell_[i - numInteriorCells])
                 {
                     continue;
                 }
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                const unsigned cell_idx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+                const unsigned cell_idx = interior ? interiorCells_[i]
+                                                   : borderCells_[i - numInteriorCells];
                 const double pvValue = ebosProblem.referencePorosity(cell_idx, /*timeIdx=*/0) * ebosModel.dofTotalVolume( cell_idx );
                 const auto& cellResidual = ebosResid[cell_idx];
                 bool cnvViolated = false;
@@ -824,17 +1068,79 @@ namespace Opm {
                     using std::abs;
                     Scalar CNV = cellResidual[eqIdx] * dt * B_avg[eqIdx] / pvValue;
                     cnvViolated = cnvViolated || (abs(CNV) > param_.tolerance_cnv_);
+                    if (numWorst > 0) {
+                        auto* worst = threadWorst[ThreadManager::threadId()].data() + eqIdx * numWorst;
+                        insertWorstCell_(worst, numWorst, {abs(CNV), static_cast<int>(cell_idx), 0});
+                    }
                 }
 
                 if (cnvViolated)
                 {
                     errorPV += pvValue;
+                    ++errorCells;
                 }
             }
 
             OPM_END_PARALLEL_TRY_CATCH("BlackoilModelEbos::ComputeCnvError() failed: ", grid_.comm());
 
-            return grid_.comm().sum(errorPV);
+            // One reduction for both, the cell count is exact in a double.
+            double errorSums[2] = { errorPV, static_cast<double>(errorCells) };
+            grid_.comm().sum(errorSums, 2);
+            cnv_violating_cells_ = static_cast<long int>(errorSums[1]);
+
+            worstCells.clear();
+            if (numWorst > 0) {
+                gatherWorstCells_(threadWorst, numWorst, worstCells);
+            }
+            return errorSums[0];
+        }
+
+        /// \brief Merge the worst cells found by the threads of all processes.
+        void gatherWorstCells_(const std::vector<std::vector<WorstCellEntry>>& threadWorst,
+                               const int numWorst,
+                               std::vector<ConvergenceReport::WorstCell>& worstCells) const
+        {
+            const int numValues = numEq * numWorst;
+            std::vector<WorstCellEntry> worst(numValues);
+            for (const auto& tw : threadWorst) {
+                for (int i = 0; i < numValues; ++i) {
+                    if (tw[i].cell >= 0) {
+                        insertWorstCell_(worst.data() + (i / numWorst) * numWorst, numWorst, tw[i]);
+                    }
+                }
+            }
+
+            // Exchange the errors and cartesian indices of the local worst
+            // cells, the indices are exact in a double.
+            const auto& comm = grid_.comm();
+            std::vector<double> local(2 * numValues);
+            for (int i = 0; i < numValues; ++i) {
+                local[2 * i] = worst[i].value;
+                local[2 * i + 1] = worst[i].cell < 0 ? -1.0
+                    : static_cast<double>(ebosSimulator_.vanguard().cartesianIndex(worst[i].cell));
+            }
+            std::vector<double> all(2 * numValues * comm.size());
+            if (comm.size() > 1) {
+                comm.allgather(local.data(), local.size(), all.data());
+            } else {
+                all = local;
+            }
+
+            std::fill(worst.begin(), worst.end(), WorstCellEntry{});
+            for (int rank = 0; rank < comm.size(); ++rank) {
+                const double* values = all.data() + 2 * numValues * rank;
+                for (int i = 0; i < numValues; ++i) {
+                    if (values[2 * i + 1] >= 0.0) {
+                        insertWorstCell_(worst.data() + (i / numWorst) * numWorst, numWorst,
+                                         {values[2 * i], static_cast<int>(values[2 * i + 1]), rank});
+                    }
+                }
+            }
+            for (int i = 0; i < numValues; ++i) {
+                if (worst[i].cell >= 0) {
+                    worstCells.emplace_back(i / numWorst, worst[i].cell, worst[i].rank, worst[i].value);
+                }
+            }
         }
 
         ConvergenceReport getReservoirConvergence(const double dt,
@@ -855,8 +1161,10 @@ namespace Opm {
                                      numAquiferPvSumLocal,
                                      R_sum, maxCoeff, B_avg);
 
-            auto cnvErrorPvFraction = computeCnvErrorPv(B_avg, dt);
+            std::vector<ConvergenceReport::WorstCell> worstCells;
+            auto cnvErrorPvFraction = computeCnvErrorPv(B_avg, dt, worstCells);
             cnvErrorPvFraction /= (pvSum - numAquiferPvSum);
+            cnv_violating_pv_fraction_ = cnvErrorPvFraction;
 
             const double tol_mb  = param_.tolerance_mb_;
             // Default value of relaxed_max_pv_fraction_ is 1 and
@@ -980,11 +1288,40 @@ namespace Opm {
                 ss.precision(oprec);
                 ss.flags(oflags);
                 OpmLog::debug(ss.str());
+
+                if (!report.converged() && !worstCells.empty()) {
+                    OpmLog::debug(worstCellsMessage_(worstCells, compNames));
+                }
             }
+            report.setWorstCells(worstCells);
 
             return report;
         }
 
+        /// \brief The cells with the largest CNV errors by equation, with
+        ///        their one-based cartesian coordinates.
+        std::string worstCellsMessage_(const std::vector<ConvergenceReport::WorstCell>& worstCells,
+                                       const std::vector<std::string>& compNames) const
+        {
+            const auto& dims = ebosSimulator_.vanguard().cartesianDimensions();
+            std::ostringstream ss;
+            ss.precision(3);
+            ss.setf(std::ios::scientific);
+            ss << "    Largest CNV errors:";
+            int phase = -1;
+            for (const auto& wc : worstCells) {
+                if (wc.phase() != phase) {
+                    phase = wc.phase();
+                    ss << "\n      " << compNames[phase] << ":";
+                }
+                ss << " (" << wc.cell() % dims[0] + 1
+                   << "," << (wc.cell() / dims[0]) % dims[1] + 1
+                   << "," << wc.cell() / (dims[0] * dims[1]) + 1
+                   << ")@" << wc.rank() << " " << wc.value();
+            }
+            return ss.str();
+        }
+
         /// Compute convergence based on total mass balance (tol_mb) and maximum
         /// residual mass balance (tol_cnv).
         /// \param[in]   timer       simulation timer
@@ -999,6 +1336,18 @@ namespace Opm {
             auto report = getReservoirConvergence(timer.currentStepLength(), iteration, B_avg, residual_norms);
             report += wellModel().getWellConvergence(B_avg);
 
+            // Cells whose primary variables switched in the update of the last iteration.
+            if (iteration > 0) {
+                const auto [switched, frozen] = ebosSimulator_.model().newtonMethod().primaryVariableSwitches();
+                long int counts[2] = { switched, frozen };
+                grid_.comm().sum(counts, 2);
+                report.setPrimaryVariableSwitches(counts[0], counts[1]);
+                if (terminal_output_ && counts[1] > 0) {
+                    OpmLog::debug("    Primary variable switch rejected in " + std::to_string(counts[1])
+                                  + " cells which switched too often");
+                }
+            }
+
             return report;
         }
 
@@ -1049,6 +1398,21 @@ namespace Opm {
             return convergence_reports_;
         }
 
+        /// Number of cells violating the strict CNV tolerance, and the fraction of
+        /// the pore volume held by them, at the last convergence check. If a failed
+        /// time step leaves only a few such cells, the step is limited locally.
+        std::pair<long int, double> cnvViolations() const
+        {
+            return {cnv_violating_cells_, cnv_violating_pv_fraction_};
+        }
+
+        /// The CNV residuals of the nonlinear iterations of the current (or
+        /// last) time step.
+        const ResidualNormHistory& residualNormsHistory() const
+        {
+            return residual_norms_history_;
+        }
+
     protected:
         // ---------  Data members  ---------
 
@@ -1075,11 +1439,40 @@ namespace Opm {
         /// \brief The number of cells of the global grid.
         long int global_nc_;
 
-        std::vector<std::vector<double>> residual_norms_history_;
+        ResidualNormHistory residual_norms_history_;
         double current_relaxation_;
         BVector dx_old_;
 
+        // The last linear solution and the residual norm it was computed for, and the
+        // first linear solution of the last time step and its length, used for the
+        // initial guess of the linear solves.
+        BVector last_update_;
+        double last_update_residual_norm_ = 0.0;
+        BVector first_update_;
+        double first_update_dt_ = 0.0;
+
+        // Newton iterate of the current time step with the smallest residual,
+        // the target of the initial guess of a chopped step.
+        SolutionVector best_iterate_;
+        double best_iterate_residual_norm_ = 0.0;
+        double initial_residual_norm_ = 0.0;
+        bool have_best_iterate_ = false;
+        double last_step_length_ = 0.0;
+
+        long int cnv_violating_cells_ = 0;
+        double cnv_violating_pv_fraction_ = 0.0;
+
         std::vector<StepReport> convergence_reports_;
+
+        /// \brief Indices of the interior cells of this process.
+        std::vector<unsigned> interiorCells_;
+        /// \brief Whether the corresponding interior cell belongs to a numerical aquifer.
+        std::vector<char> isNumericalAquiferCell_;
+        /// \brief Indices of the border cells of this process, which the CNV
+        /// violation count includes.
+        std::vector<unsigned> borderCells_;
+        /// \brief Whether the corresponding border cell belongs to a numerical aquifer.
+        std::vector<char> isNumericalAquiferBorderCell_;
     public:
         /// return the StandardWells object
         BlackoilWellModel<TypeTag>&
@@ -1099,6 +1492,50 @@ namespace Opm {
         }
 
     private:
+        /// \brief Intensive quantities of a cell for the convergence check.
+        ///
+        /// The linearizer has just evaluated the intensive quantities of all cells,
+        /// so they are taken from the model's cache whenever it is up to date.
+        /// Only if the cache is disabled or invalid are they recomputed.
+        template<class Element>
+        const IntensiveQuantities& convergenceIntensiveQuantities_(ElementContext& elemCtx,
+                                                                   const Element& elem,
+                                                                   const unsigned cell_idx) const
+        {
+            const auto* cachedIntQuants =
+                ebosSimulator_.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/0);
+            if (cachedIntQuants) {
+                return *cachedIntQuants;
+            }
+
+            elemCtx.updatePrimaryStencil(elem);
+            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            return elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+        }
+
+        /// \brief Collect the interior and border cells of this process.
+        ///
+        /// The local grid does not change during the simulation, hence the
+        /// convergence and relative change reductions can run over this flat
+        /// list instead of iterating the grid elements each time.
+        void setupInteriorCells_()
+        {
+            const auto& elemMapper = ebosSimulator_.model().elementMapper();
+            const auto& gridView = ebosSimulator_.gridView();
+            interiorCells_.clear();
+            isNumericalAquiferCell_.clear();
+            for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+                interiorCells_.push_back(elemMapper.index(elem));
+                isNumericalAquiferCell_.push_back(isNumericalAquiferCell(gridView.grid(), elem));
+            }
+            borderCells_.clear();
+            isNumericalAquiferBorderCell_.clear();
+            for (const auto& elem : elements(gridView, Dune::Partitions::border)) {
+                borderCells_.push_back(elemMapper.index(elem));
+                isNumericalAquiferBorderCell_.push_back(isNumericalAquiferCell(gridView.grid(), elem));
+            }
+        }
+
         template<class T>
         bool isNumericalAquiferCell(const Dune::CpGrid& grid, const T& elem)
         {
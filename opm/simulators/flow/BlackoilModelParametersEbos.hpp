@@ -100,6 +100,18 @@ struct UseUpdateStabilization {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct InterpolateAfterChop {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct LinearSolverInitialGuess {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct NumWorstCells {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct MatrixAddWellContributions {
     using type = UndefinedProperty;
 };
@@ -157,10 +169,26 @@ struct MaxInnerIterWells {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct ThreadedWellAssembly {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct AlternativeWellRateInit {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct GasLiftGradientTolerance {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct NetworkCoupledSolve {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct LazyWellPotentials {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct MaximumNumberOfWellSwitches {
     using type = UndefinedProperty;
 };
@@ -240,6 +268,18 @@ struct UseUpdateStabilization<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = true;
 };
 template<class TypeTag>
+struct InterpolateAfterChop<TypeTag, TTag::FlowModelParameters> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct LinearSolverInitialGuess<TypeTag, TTag::FlowModelParameters> {
+    static constexpr int value = 0;
+};
+template<class TypeTag>
+struct NumWorstCells<TypeTag, TTag::FlowModelParameters> {
+    static constexpr int value = 3;
+};
+template<class TypeTag>
 struct MatrixAddWellContributions<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = false;
 };
@@ -270,10 +310,27 @@ struct ShutUnsolvableWells<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = false;
 };
 template<class TypeTag>
+struct ThreadedWellAssembly<TypeTag, TTag::FlowModelParameters> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
 struct AlternativeWellRateInit<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = true;
 };
 template<class TypeTag>
+struct GasLiftGradientTolerance<TypeTag, TTag::FlowModelParameters> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
+template<class TypeTag>
+struct NetworkCoupledSolve<TypeTag, TTag::FlowModelParameters> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct LazyWellPotentials<TypeTag, TTag::FlowModelParameters> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
 struct StrictOuterIterWells<TypeTag, TTag::FlowModelParameters> {
     static constexpr int value = 99;
 };
@@ -381,6 +438,10 @@ namespace Opm
         /// Maximum inner iteration number for standard wells
         int max_inner_iter_wells_;
 
+        /// Whether to assemble the equations of the wells, evaluate their gas
+        /// lift gradients and compute their PI values in parallel with OpenMP
+        bool threaded_well_assembly_;
+
         /// Maximum iteration number of the well equation solution
         int max_welleq_iter_;
 
@@ -400,6 +461,19 @@ namespace Opm
         /// Try to detect oscillation or stagnation.
         bool use_update_stabilization_;
 
+        /// Start a chopped time step from an interpolation between the old
+        /// solution and the best Newton iterate of the failed step.
+        bool interpolate_after_chop_;
+
+        /// Initial guess of the linear solves, 0: zero, 1: the scaled previous
+        /// Newton update, 2: as 1, and the first update of the previous time step
+        /// scaled by the time step length in the first Newton iteration.
+        int linear_solver_initial_guess_;
+
+        /// Number of cells with the largest CNV error of each equation which
+        /// are reported by the convergence check, 0 to disable.
+        int num_worst_cells_;
+
         /// Whether to use MultisegmentWell to handle multisegment wells
         /// it is something temporary before the multisegment well model is considered to be
         /// well developed and tested.
@@ -448,11 +522,15 @@ namespace Opm
             max_niter_inner_well_iter_ = EWOMS_GET_PARAM(TypeTag, int, MaxNewtonIterationsWithInnerWellIterations);
             shut_unsolvable_wells_ = EWOMS_GET_PARAM(TypeTag, bool, ShutUnsolvableWells);
             max_inner_iter_wells_ = EWOMS_GET_PARAM(TypeTag, int, MaxInnerIterWells);
+            threaded_well_assembly_ = EWOMS_GET_PARAM(TypeTag, bool, ThreadedWellAssembly);
             maxSinglePrecisionTimeStep_ = EWOMS_GET_PARAM(TypeTag, Scalar, MaxSinglePrecisionDays) *24*60*60;
             max_strict_iter_ = EWOMS_GET_PARAM(TypeTag, int, MaxStrictIter);
             solve_welleq_initially_ = EWOMS_GET_PARAM(TypeTag, bool, SolveWelleqInitially);
             update_equations_scaling_ = EWOMS_GET_PARAM(TypeTag, bool, UpdateEquationsScaling);
             use_update_stabilization_ = EWOMS_GET_PARAM(TypeTag, bool, UseUpdateStabilization);
+            interpolate_after_chop_ = EWOMS_GET_PARAM(TypeTag, bool, InterpolateAfterChop);
+            linear_solver_initial_guess_ = EWOMS_GET_PARAM(TypeTag, int, LinearSolverInitialGuess);
+            num_worst_cells_ = EWOMS_GET_PARAM(TypeTag, int, NumWorstCells);
             matrix_add_well_contributions_ = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
             check_well_operability_ = EWOMS_GET_PARAM(TypeTag, bool, EnableWellOperabilityCheck);
             check_well_operability_iter_ = EWOMS_GET_PARAM(TypeTag, bool, EnableWellOperabilityCheckIter);
@@ -484,13 +562,20 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, int, MaxNewtonIterationsWithInnerWellIterations, "Maximum newton iterations with inner well iterations");
             EWOMS_REGISTER_PARAM(TypeTag, bool, ShutUnsolvableWells, "Shut unsolvable wells");
             EWOMS_REGISTER_PARAM(TypeTag, int, MaxInnerIterWells, "Maximum number of inner iterations for standard wells");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, ThreadedWellAssembly, "Distribute the assembly and the initial solution of the well equations, the evaluation of the gas lift gradients, the PI calculation and the multisegment well systems in the linear solver over the OpenMP threads");
             EWOMS_REGISTER_PARAM(TypeTag, bool, AlternativeWellRateInit, "Use alternative well rate initialization procedure");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, NetworkCoupledSolve, "Solve the pressures of all network nodes simultaneously, using the response of the group rates to the node pressures of the previous iterations");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, LazyWellPotentials, "Only recompute the potentials of wells in prediction mode at the end of a time step if they are needed for group control, guide rates, economic limits, gas lift or output");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, GasLiftGradientTolerance, "Relative change of the oil and gas rates of a gas lift well below which its gradients from the previous optimization are reused, 0 disables the reuse");
             EWOMS_REGISTER_PARAM(TypeTag, Scalar, RegularizationFactorMsw, "Regularization factor for ms wells");
             EWOMS_REGISTER_PARAM(TypeTag, Scalar, MaxSinglePrecisionDays, "Maximum time step size where single precision floating point arithmetic can be used solving for the linear systems of equations");
             EWOMS_REGISTER_PARAM(TypeTag, int, MaxStrictIter, "Maximum number of Newton iterations before relaxed tolerances are used for the CNV convergence criterion");
             EWOMS_REGISTER_PARAM(TypeTag, bool, SolveWelleqInitially, "Fully solve the well equations before each iteration of the reservoir model");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UpdateEquationsScaling, "Update scaling factors for mass balance equations during the run");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseUpdateStabilization, "Try to detect and correct oscillations or stagnation during the Newton method");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, InterpolateAfterChop, "Start a chopped time step from the old solution moved towards the Newton iterate of the failed step with the smallest residual");
+            EWOMS_REGISTER_PARAM(TypeTag, int, LinearSolverInitialGuess, "Initial guess of the linear solves. Valid options are 0: zero, 1: the previous Newton update scaled by the ratio of the residual norms, 2: as 1, and in the first Newton iteration the first update of the previous time step scaled by the ratio of the time step lengths");
+            EWOMS_REGISTER_PARAM(TypeTag, int, NumWorstCells, "Number of cells with the largest CNV error of each equation to report in the convergence check, 0 to disable");
             EWOMS_REGISTER_PARAM(TypeTag, bool, MatrixAddWellContributions, "Explicitly specify the influences of wells between cells in the Jacobian and preconditioner matrices");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableWellOperabilityCheck, "Enable the well operability checking");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableWellOperabilityCheckIter, "Enable the well operability checking during iterations");
@@ -29,6 +29,8 @@
 #include <opm/simulators/utils/ParallelFileMerger.hpp>
 #include <opm/simulators/utils/moduleVersion.hpp>
 #include <opm/simulators/utils/ParallelEclipseState.hpp>
+#include <opm/simulators/utils/MemoryRegistry.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
 
 #include <opm/input/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/input/eclipse/EclipseState/IOConfig/IOConfig.hpp>
@@ -38,6 +40,7 @@
 
 #include <fmt/format.h>
 #include <filesystem>
+#include <vector>
 
 #if HAVE_DUNE_FEM
 #include <dune/fem/misc/mpimanager.hh>
@@ -59,6 +62,10 @@ template<class TypeTag, class MyTypeTag>
 struct EnableLoggingFalloutWarning {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct EnableJsonStartupReport {
+    using type = UndefinedProperty;
+};
 
 // TODO: enumeration parameters. we use strings for now.
 template<class TypeTag>
@@ -74,6 +81,10 @@ template<class TypeTag>
 struct OutputInterval<TypeTag, TTag::EclFlowProblem> {
     static constexpr int value = 1;
 };
+template<class TypeTag>
+struct EnableJsonStartupReport<TypeTag, TTag::EclFlowProblem> {
+    static constexpr bool value = false;
+};
 
 } // namespace Opm::Properties
 
@@ -125,6 +136,8 @@ namespace Opm
                                  "Specify the number of report steps between two consecutive writes of restart data");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableLoggingFalloutWarning,
                                  "Developer option to see whether logging was on non-root processors. In that case it will be appended to the *.DBG or *.PRT files");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, EnableJsonStartupReport,
+                                 "Write the time of every process in the startup phases to the STARTUP.json file");
 
             Simulator::registerParameters();
 
@@ -174,6 +187,7 @@ namespace Opm
             // the default eWoms checkpoint/restart mechanism does not work with flow
             EWOMS_HIDE_PARAM(TypeTag, RestartTime);
             EWOMS_HIDE_PARAM(TypeTag, RestartWritingInterval);
+            EWOMS_HIDE_PARAM(TypeTag, RestartWallClockInterval);
             // hide all vtk related it is not currently possible to do this dependet on if the vtk writing is used
             //if(not(EWOMS_GET_PARAM(TypeTag,bool,EnableVtkOutput))){
                 EWOMS_HIDE_PARAM(TypeTag, VtkWriteOilFormationVolumeFactor);
@@ -338,6 +352,48 @@ namespace Opm
             return report.success.exit_status;
         }
 
+        // Called from Python to run the case again, after executeStepsCleanup()
+        // or in the middle of a run. The grid, the transmissibilities and the
+        // parsed input are kept, see EclProblem::resetState() for the
+        // multipliers and the runs which cannot be reset.
+        int executeReset(const std::vector<Scalar>& porosityMultipliers,
+                         const std::vector<Scalar>& permeabilityMultipliers)
+        {
+            auto& model = ebosSimulator_->model();
+            ebosSimulator_->problem().resetState(porosityMultipliers, permeabilityMultipliers);
+            // the well model adds itself again when the initial solution is applied
+            model.clearAuxiliaryModules();
+            model.applyInitialSolution();
+            TimingRegistry::reset();
+            createSimulator();
+            return runSimulatorInit();
+        }
+
+        // The state of a run at the end of a report step, kept in memory to
+        // continue the run from there, possibly several times.
+        struct Checkpoint
+        {
+            typename Problem::Checkpoint problem;
+            SimulatorTimer timer;
+            double suggestedNextStep;
+        };
+
+        // Called from Python between executeStep() calls.
+        Checkpoint checkpoint() const
+        {
+            return {ebosSimulator_->problem().checkpoint(), *simtimer_,
+                    simulator_->suggestedNextStep()};
+        }
+
+        // Called from Python to continue the run from a checkpoint, before
+        // executeStepsCleanup().
+        void restoreCheckpoint(const Checkpoint& checkpoint)
+        {
+            ebosSimulator_->problem().restoreCheckpoint(checkpoint.problem);
+            *simtimer_ = checkpoint.timer;
+            simulator_->setSuggestedNextStep(checkpoint.suggestedNextStep);
+        }
+
         // Print an ASCII-art header to the PRT and DEBUG files.
         // \return Whether unkown keywords were seen during parsing.
         static void printPRTHeader(bool output_cout)
@@ -401,6 +457,7 @@ namespace Opm
                 setupParallelism();
                 setupEbosSimulator();
                 createSimulator();
+                reportStartupTimings_();
 
                 // if run, do the actual work, else just initialize
                 int exitCode = (this->*runOrInitFunc)();
@@ -431,6 +488,22 @@ namespace Opm
             }
         }
 
+        // Print the time of the startup phases, collective.
+        void reportStartupTimings_()
+        {
+            std::string jsonFile;
+            if (EWOMS_GET_PARAM(TypeTag, bool, EnableJsonStartupReport)) {
+                const auto& ioConfig = eclState().getIOConfig();
+                jsonFile = ioConfig.getOutputDir() + "/" + ioConfig.getBaseName() + ".STARTUP.json";
+            }
+            const std::string timings = TimingRegistry::startupReport(EclGenericVanguard::comm(), jsonFile);
+            const std::string memory = MemoryRegistry::report(EclGenericVanguard::comm());
+            if (this->output_cout_) {
+                OpmLog::info("\nStartup timings over the processes:\n" + timings
+                             + "\nMemory over the processes after startup:\n" + memory);
+            }
+        }
+
         void executeCleanup_() {
             // clean up
             mergeParallelLogFiles();
@@ -463,7 +536,7 @@ namespace Opm
             // force closing of all log files.
             OpmLog::removeAllBackends();
 
-            if (mpi_rank_ != 0 || mpi_size_ < 2 || !this->output_files_) {
+            if (mpi_size_ < 2 || !this->output_files_) {
                 return;
             }
 
@@ -482,10 +555,21 @@ namespace Opm
             {
                 basename = uppercase(deck_filename.filename().string());
             }
+
+            // Every process removes its own files that need not be merged,
+            // which usually leaves nothing for the root process to merge.
+            const bool showFallout = EWOMS_GET_PARAM(TypeTag, bool, EnableLoggingFalloutWarning);
+            if (mpi_rank_ != 0) {
+                detail::removeRankLogFiles(output_path, basename, mpi_rank_, showFallout);
+            }
+            EclGenericVanguard::comm().barrier();
+            if (mpi_rank_ != 0) {
+                return;
+            }
+
             std::for_each(fs::directory_iterator(output_path),
                           fs::directory_iterator(),
-                          detail::ParallelFileMerger(output_path, basename,
-                                                     EWOMS_GET_PARAM(TypeTag, bool, EnableLoggingFalloutWarning)));
+                          detail::ParallelFileMerger(output_path, basename, showFallout));
         }
 
         void setupEbosSimulator()
@@ -566,6 +650,10 @@ namespace Opm
         // Output summary after simulation has completed
         void runSimulatorAfterSim_(SimulatorReport &report)
         {
+            // collective, the timings of all processes are reduced
+            const std::string timings = TimingRegistry::report(EclGenericVanguard::comm(),
+                                                                 report.success.total_time);
+            const std::string memory = MemoryRegistry::report(EclGenericVanguard::comm());
             if (this->output_cout_) {
                 std::ostringstream ss;
                 ss << "\n\n================    End of simulation     ===============\n\n";
@@ -577,6 +665,8 @@ namespace Opm
 #endif
                 ss << fmt::format("Threads per MPI process: {:9}\n", threads);
                 report.reportFullyImplicit(ss);
+                ss << "\nTimings over the processes:\n" << timings;
+                ss << "\nMemory over the processes:\n" << memory;
                 OpmLog::info(ss.str());
                 const std::string dir = eclState().getIOConfig().getOutputDir();
                 namespace fs = ::std::filesystem;
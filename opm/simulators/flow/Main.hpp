@@ -56,7 +56,9 @@
 #include <opm/models/utils/parametersystem.hh>
 
 #include <opm/simulators/flow/FlowMainEbos.hpp>
+#include <opm/simulators/utils/MemoryRegistry.hpp>
 #include <opm/simulators/utils/readDeck.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
 
 #if HAVE_DUNE_FEM
 #include <dune/fem/misc/mpimanager.hh>
@@ -468,9 +470,16 @@ private:
             if (output_param >= 0)
                 outputInterval = output_param;
 
-            readDeck(EclGenericVanguard::comm(), deckFilename, deck_, eclipseState_, schedule_, udqState_, actionState_, wtestState_,
-                     summaryConfig_, nullptr, python, std::move(parseContext),
-                     init_from_restart_file, outputCout_, outputInterval);
+            {
+                ScopedTimer timer(TimingRegistry::Region::ReadDeck);
+                const long long residentBefore = MemoryRegistry::residentBytes();
+                readDeck(EclGenericVanguard::comm(), deckFilename, deck_, eclipseState_, schedule_, udqState_, actionState_, wtestState_,
+                         summaryConfig_, nullptr, python, std::move(parseContext),
+                         init_from_restart_file, outputCout_, outputInterval,
+                         EWOMS_GET_PARAM(PreTypeTag, std::string, EclDeckCacheFile));
+                MemoryRegistry::add(MemoryRegistry::Owner::Input,
+                                    std::max(0LL, static_cast<long long>(MemoryRegistry::residentBytes()) - residentBefore));
+            }
 
             setupTime_ = externalSetupTimer.elapsed();
             outputFiles_ = (outputMode != FileOutputMode::OUTPUT_NONE);
@@ -30,6 +30,7 @@
 #include <opm/models/utils/propertysystem.hh>
 #include <opm/models/utils/basicproperties.hh>
 #include <opm/common/Exceptions.hpp>
+#include <opm/simulators/flow/ResidualNormHistory.hpp>
 
 #include <dune/common/fmatrix.hh>
 #include <dune/istl/bcrsmatrix.hh>
@@ -57,6 +58,10 @@ template<class TypeTag, class MyTypeTag>
 struct NewtonRelaxationType{
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct FlowNewtonDivergenceFactor {
+    using type = UndefinedProperty;
+};
 
 template<class TypeTag>
 struct NewtonMaxRelax<TypeTag, TTag::FlowNonLinearSolver> {
@@ -75,6 +80,11 @@ template<class TypeTag>
 struct NewtonRelaxationType<TypeTag, TTag::FlowNonLinearSolver> {
     static constexpr auto value = "dampen";
 };
+template<class TypeTag>
+struct FlowNewtonDivergenceFactor<TypeTag, TTag::FlowNonLinearSolver> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 100.0;
+};
 
 } // namespace Opm::Properties
 
@@ -105,6 +115,7 @@ class WellState;
             double relaxRelTol_;
             int maxIter_; // max nonlinear iterations
             int minIter_; // min nonlinear iterations
+            double divergenceFactor_; // growth of the residual which chops the time step early
 
             SolverParameters()
             {
@@ -115,6 +126,7 @@ class WellState;
                 relaxMax_ = EWOMS_GET_PARAM(TypeTag, Scalar, NewtonMaxRelax);
                 maxIter_ = EWOMS_GET_PARAM(TypeTag, int, FlowNewtonMaxIterations);
                 minIter_ = EWOMS_GET_PARAM(TypeTag, int, FlowNewtonMinIterations);
+                divergenceFactor_ = EWOMS_GET_PARAM(TypeTag, Scalar, FlowNewtonDivergenceFactor);
 
                 const auto& relaxationTypeString = EWOMS_GET_PARAM(TypeTag, std::string, NewtonRelaxationType);
                 if (relaxationTypeString == "dampen") {
@@ -132,6 +144,7 @@ class WellState;
                 EWOMS_REGISTER_PARAM(TypeTag, int, FlowNewtonMaxIterations, "The maximum number of Newton iterations per time step used by flow");
                 EWOMS_REGISTER_PARAM(TypeTag, int, FlowNewtonMinIterations, "The minimum number of Newton iterations per time step used by flow");
                 EWOMS_REGISTER_PARAM(TypeTag, std::string, NewtonRelaxationType, "The type of relaxation used by flow's Newton method");
+                EWOMS_REGISTER_PARAM(TypeTag, Scalar, FlowNewtonDivergenceFactor, "Give up a time step when the largest residual grew in each of the last two Newton iterations, by more than this factor in total. Zero disables the check");
             }
 
             void reset()
@@ -143,6 +156,7 @@ class WellState;
                 relaxRelTol_ = 0.2;
                 maxIter_ = 10;
                 minIter_ = 1;
+                divergenceFactor_ = 100.0;
             }
 
         };
@@ -275,15 +289,15 @@ class WellState;
         { return *model_; }
 
         /// Detect oscillation or stagnation in a given residual history.
-        void detectOscillations(const std::vector<std::vector<double>>& residualHistory,
-                                const int it, bool& oscillate, bool& stagnate) const
+        void detectOscillations(const ResidualNormHistory& residualHistory,
+                                bool& oscillate, bool& stagnate) const
         {
             // The detection of oscillation in two primary variable results in the report of the detection
             // of oscillation for the solver.
             // Only the saturations are used for oscillation detection for the black oil model.
             // Stagnate is not used for any treatment here.
 
-            if ( it < 2 ) {
+            if ( residualHistory.size() < 3 ) {
                 oscillate = false;
                 stagnate = false;
                 return;
@@ -291,9 +305,9 @@ class WellState;
 
             stagnate = true;
             int oscillatePhase = 0;
-            const std::vector<double>& F0 = residualHistory[it];
-            const std::vector<double>& F1 = residualHistory[it - 1];
-            const std::vector<double>& F2 = residualHistory[it - 2];
+            const double* F0 = residualHistory.norms(0);
+            const double* F1 = residualHistory.norms(1);
+            const double* F2 = residualHistory.norms(2);
             for (int p= 0; p < model_->numPhases(); ++p){
                 const double d1 = std::abs((F0[p] - F2[p]) / F0[p]);
                 const double d2 = std::abs((F0[p] - F1[p]) / F0[p]);
@@ -308,6 +322,14 @@ class WellState;
             oscillate = (oscillatePhase > 1);
         }
 
+        /// Whether the Newton iterations are visibly diverging, such that the
+        /// time step should be chopped without using up maxIter() iterations.
+        bool detectDivergence(const ResidualNormHistory& residualHistory) const
+        {
+            return param_.divergenceFactor_ > 0.0
+                && residualHistory.size() > minIter()
+                && residualHistory.diverging(param_.divergenceFactor_);
+        }
 
         /// Apply a stabilization to dx, depending on dxOld and relaxation parameters.
         /// Implemention for Dune block vectors.
@@ -374,6 +396,10 @@ class WellState;
         int minIter() const
         { return param_.minIter_; }
 
+        /// The growth of the residual which chops the time step early.
+        double divergenceFactor() const
+        { return param_.divergenceFactor_; }
+
         /// Set parameters to override those given at construction time.
         void setParameters(const SolverParameters& param)
         { param_ = param; }
@@ -0,0 +1,114 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_RESIDUALNORMHISTORY_HEADER_INCLUDED
+#define OPM_RESIDUALNORMHISTORY_HEADER_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Opm
+{
+
+/// The residual norms of the nonlinear iterations of a time step.
+///
+/// The norms by equation are only kept for the last few iterations, in a
+/// ring buffer which is allocated once, as the oscillation detection of
+/// the nonlinear solver does not look further back. The largest norm of
+/// every iteration is kept for the whole time step.
+class ResidualNormHistory
+{
+public:
+    /// Number of iterations of which the norms by equation are kept.
+    static constexpr int capacity = 3;
+
+    /// Forget all iterations, but keep the storage.
+    void clear()
+    {
+        maxNorms_.clear();
+    }
+
+    /// Add the norms by equation of the next iteration. All iterations
+    /// of a time step must have the same number of norms.
+    void push(const std::vector<double>& norms)
+    {
+        if (maxNorms_.empty()) {
+            numNorms_ = norms.size();
+            norms_.resize(capacity * numNorms_);
+        }
+        assert(norms.size() == numNorms_);
+        std::copy(norms.begin(), norms.end(), norms_.begin() + slot(size()) * numNorms_);
+        maxNorms_.push_back(norms.empty() ? 0.0 : *std::max_element(norms.begin(), norms.end()));
+    }
+
+    /// Number of iterations added since the last clear().
+    int size() const
+    {
+        return maxNorms_.size();
+    }
+
+    /// Number of norms of each iteration.
+    std::size_t numNorms() const
+    {
+        return numNorms_;
+    }
+
+    /// The norms by equation of the iteration added \p back iterations
+    /// before the last one, which must be less than min(size(), capacity).
+    const double* norms(const int back = 0) const
+    {
+        assert(back >= 0 && back < std::min(size(), capacity));
+        return norms_.data() + slot(size() - 1 - back) * numNorms_;
+    }
+
+    /// The largest norm of every iteration.
+    const std::vector<double>& maxNorms() const
+    {
+        return maxNorms_;
+    }
+
+    /// Whether the largest norm grew in each of the last capacity - 1
+    /// iterations, by more than \p factor in total.
+    bool diverging(const double factor) const
+    {
+        if (size() < capacity) {
+            return false;
+        }
+        const auto first = maxNorms_.end() - capacity;
+        return std::is_sorted(first, maxNorms_.end(), std::less_equal<double>())
+            && maxNorms_.back() > factor * *first;
+    }
+
+private:
+    static int slot(const int iteration)
+    {
+        return iteration % capacity;
+    }
+
+    std::size_t numNorms_ = 0;
+    std::vector<double> norms_;
+    std::vector<double> maxNorms_;
+};
+
+} // namespace Opm
+
+#endif // OPM_RESIDUALNORMHISTORY_HEADER_INCLUDED
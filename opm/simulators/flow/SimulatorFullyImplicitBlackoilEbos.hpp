@@ -27,12 +27,21 @@
 #include <opm/simulators/flow/BlackoilModelParametersEbos.hpp>
 #include <opm/simulators/wells/WellState.hpp>
 #include <opm/simulators/aquifers/BlackoilAquiferModel.hpp>
+#include <opm/simulators/utils/MemoryRegistry.hpp>
+#include <opm/simulators/utils/MetricsExporter.hpp>
 #include <opm/simulators/utils/moduleVersion.hpp>
 #include <opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp>
 #include <opm/grid/utility/StopWatch.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
 
+#include <fmt/format.h>
+
+#include <fstream>
+#include <memory>
+#include <tuple>
+#include <vector>
+
 namespace Opm::Properties {
 
 template<class TypeTag, class MyTypeTag>
@@ -43,6 +52,18 @@ template<class TypeTag, class MyTypeTag>
 struct EnableTuning {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct LoadImbalanceThreshold {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EnableJsonStepReports {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct MetricsFile {
+    using type = UndefinedProperty;
+};
 
 template<class TypeTag>
 struct EnableTerminalOutput<TypeTag, TTag::EclFlowProblem> {
@@ -56,6 +77,19 @@ template<class TypeTag>
 struct EnableTuning<TypeTag, TTag::EclFlowProblem> {
     static constexpr bool value = false;
 };
+template<class TypeTag>
+struct LoadImbalanceThreshold<TypeTag, TTag::EclFlowProblem> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
+template<class TypeTag>
+struct EnableJsonStepReports<TypeTag, TTag::EclFlowProblem> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct MetricsFile<TypeTag, TTag::EclFlowProblem> {
+    static constexpr auto value = "";
+};
 
 } // namespace Opm::Properties
 
@@ -72,6 +106,7 @@ class SimulatorFullyImplicitBlackoilEbos
 {
 public:
     using Simulator = GetPropType<TypeTag, Properties::Simulator>;
+    using Scalar = GetPropType<TypeTag, Properties::Scalar>;
     using Grid = GetPropType<TypeTag, Properties::Grid>;
     using FluidSystem = GetPropType<TypeTag, Properties::FluidSystem>;
     using ElementContext = GetPropType<TypeTag, Properties::ElementContext>;
@@ -123,6 +158,14 @@ public:
         const auto& comm = grid().comm();
         terminalOutput_ = EWOMS_GET_PARAM(TypeTag, bool, EnableTerminalOutput);
         terminalOutput_ = terminalOutput_ && (comm.rank() == 0);
+        loadImbalanceThreshold_ = EWOMS_GET_PARAM(TypeTag, Scalar, LoadImbalanceThreshold);
+
+        jsonStepReports_ = EWOMS_GET_PARAM(TypeTag, bool, EnableJsonStepReports);
+        if (jsonStepReports_ && comm.rank() == 0) {
+            const auto& ioConfig = eclState().getIOConfig();
+            const auto filename = ioConfig.getOutputDir() + "/" + ioConfig.getBaseName() + ".INFOSTEP.jsonl";
+            jsonStepReportStream_ = std::make_unique<std::ofstream>(filename);
+        }
     }
 
     static void registerParameters()
@@ -137,6 +180,12 @@ public:
                              "Use adaptive time stepping between report steps");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableTuning,
                              "Honor some aspects of the TUNING keyword.");
+        EWOMS_REGISTER_PARAM(TypeTag, Scalar, LoadImbalanceThreshold,
+                             "Warn when the largest assembly and linear solver setup time of a process in a report step exceeds this multiple of the average. Zero disables the check");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnableJsonStepReports,
+                             "Write a JSON object per time step, with its iteration counts and the minimum, maximum and mean of its timings over the processes, to the INFOSTEP.jsonl file");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, MetricsFile,
+                             "Replace this file after every substep with a JSON object of the progress of the run: the simulated time, substep rate, failed substeps, iteration counts, the maximum and mean over the processes of the timed regions and the resident memory. Empty (default) disables it");
     }
 
     /// Run the simulation.
@@ -187,6 +236,16 @@ public:
                 adaptiveTimeStepping_->setSuggestedNextStep(ebosSimulator_.timeStepSize());
             }
         }
+
+        const std::string metricsFile = EWOMS_GET_PARAM(TypeTag, std::string, MetricsFile);
+        if (!metricsFile.empty()) {
+            metricsExporter_ = std::make_unique<MetricsExporter>(grid().comm(), metricsFile, timer.totalTime());
+            if (adaptiveTimeStepping_) {
+                adaptiveTimeStepping_->setSubstepCallback([this](const SimulatorReportSingle& substep) {
+                    metricsExporter_->update(substep, ebosSimulator_.episodeIndex());
+                });
+            }
+        }
     }
 
     bool runStep(SimulatorTimer& timer)
@@ -227,6 +286,7 @@ public:
 
         // Run a multiple steps of the solver depending on the time step control.
         solverTimer_->start();
+        const double localWorkBefore = localWork_();
 
         auto solver = createSolver(wellModel_());
 
@@ -259,12 +319,17 @@ public:
                 events.hasEvent(ScheduleEvents::WELL_STATUS_CHANGE);
             auto stepReport = adaptiveTimeStepping_->step(timer, *solver, event, nullptr);
             report_ += stepReport;
+            writeJsonStepReports_(stepReport.stepreports, solver->model().stepReports());
             //Pass simulation report to eclwriter for summary output
             ebosSimulator_.problem().setSimulationReport(report_);
         } else {
             // solve for complete report step
             auto stepReport = solver->step(timer);
             report_ += stepReport;
+            if (metricsExporter_) {
+                metricsExporter_->update(stepReport, timer.currentStepNum());
+            }
+            writeJsonStepReports_({stepReport}, solver->model().stepReports());
             if (terminalOutput_) {
                 std::ostringstream ss;
                 stepReport.reportStep(ss);
@@ -288,6 +353,15 @@ public:
         // update timing.
         report_.success.solver_time += solverTimer_->secsSinceStart();
 
+        checkLoadImbalance_(timer, localWork_() - localWorkBefore);
+
+        // collective
+        const std::string memory = MemoryRegistry::report(grid().comm());
+        if (terminalOutput_) {
+            OpmLog::debug("Memory over the processes at report step "
+                          + std::to_string(timer.currentStepNum()) + ":\n" + memory);
+        }
+
         // Increment timer, remember well state.
         ++timer;
 
@@ -307,6 +381,20 @@ public:
         return true;
     }
 
+    /// The size of the next time step suggested by the adaptive time
+    /// stepping, negative if it is disabled.
+    double suggestedNextStep() const
+    {
+        return adaptiveTimeStepping_ ? adaptiveTimeStepping_->suggestedNextStep() : -1.0;
+    }
+
+    void setSuggestedNextStep(const double dt)
+    {
+        if (adaptiveTimeStepping_) {
+            adaptiveTimeStepping_->setSuggestedNextStep(dt);
+        }
+    }
+
     SimulatorReport finalize()
     {
         // make sure all output is written to disk before run is finished
@@ -357,6 +445,71 @@ protected:
     WellModel& wellModel_()
     { return ebosSimulator_.problem().wellModel(); }
 
+    // Time spent in work that is local to a process, the linear solve
+    // itself is excluded as its collectives even out the times.
+    double localWork_() const
+    {
+        return report_.success.assemble_time + report_.success.linear_solve_setup_time
+            + report_.failure.assemble_time + report_.failure.linear_solve_setup_time;
+    }
+
+    void checkLoadImbalance_(const SimulatorTimer& timer, const double localWork) const
+    {
+        const auto& comm = grid().comm();
+        if (loadImbalanceThreshold_ <= 0.0 || comm.size() == 1) {
+            return;
+        }
+
+        const double maxWork = comm.max(localWork);
+        const double meanWork = comm.sum(localWork) / comm.size();
+        if (terminalOutput_ && meanWork > 0.0 && maxWork > loadImbalanceThreshold_ * meanWork) {
+            OpmLog::warning("Load imbalance",
+                            fmt::format("Report step {}: the slowest process spent {:.2f} times the average "
+                                        "time in assembly and linear solver setup ({:.2f} s against {:.2f} s)",
+                                        timer.currentStepNum(), maxWork / meanWork, maxWork, meanWork));
+        }
+    }
+
+    // The processes take the same time steps, hence the statistics of the
+    // timings of all steps of a report step are reduced at once. Every
+    // attempted step has a convergence report of the model, the last ones
+    // belong to these steps.
+    void writeJsonStepReports_(const std::vector<SimulatorReportSingle>& reports,
+                               const std::vector<typename Model::StepReport>& convergenceReports)
+    {
+        if (!jsonStepReports_ || reports.empty()) {
+            return;
+        }
+
+        using Timings = SimulatorReportSingle::Timings;
+        const auto& comm = grid().comm();
+        std::vector<Timings> min, max, mean;
+        for (const auto& report : reports) {
+            min.push_back(report.timings());
+        }
+        max = mean = min;
+        const int size = reports.size() * std::tuple_size_v<Timings>;
+        comm.min(min.front().data(), size);
+        comm.max(max.front().data(), size);
+        comm.sum(mean.front().data(), size);
+
+        if (jsonStepReportStream_) {
+            const bool haveConvergence = convergenceReports.size() >= reports.size();
+            const std::size_t firstConvergence = convergenceReports.size() - reports.size();
+            const std::vector<ConvergenceReport::WorstCell> noWorstCells;
+            for (std::size_t i = 0; i < reports.size(); ++i) {
+                for (auto& t : mean[i]) {
+                    t /= comm.size();
+                }
+                const auto* lastIteration = haveConvergence && !convergenceReports[firstConvergence + i].report.empty()
+                    ? &convergenceReports[firstConvergence + i].report.back() : nullptr;
+                reports[i].reportJson(*jsonStepReportStream_, min[i], max[i], mean[i],
+                                      lastIteration ? lastIteration->worstCells() : noWorstCells);
+            }
+            jsonStepReportStream_->flush();
+        }
+    }
+
     const WellModel& wellModel_() const
     { return ebosSimulator_.problem().wellModel(); }
 
@@ -376,6 +529,10 @@ protected:
     std::unique_ptr<time::StopWatch> solverTimer_;
     std::unique_ptr<time::StopWatch> totalTimer_;
     std::unique_ptr<TimeStepper> adaptiveTimeStepping_;
+    Scalar loadImbalanceThreshold_ = 0.0;
+    bool jsonStepReports_ = false;
+    std::unique_ptr<std::ofstream> jsonStepReportStream_;
+    std::unique_ptr<MetricsExporter> metricsExporter_;
 };
 
 } // namespace Opm
@@ -0,0 +1,62 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/flow/partitionCells.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace Opm
+{
+
+std::pair<std::vector<int>, int>
+partitionCellsSimple(const int num_cells, const int num_domains)
+{
+    if (num_cells <= 0) {
+        return { {}, 0 };
+    }
+    const int num_parts = std::clamp(num_domains, 1, num_cells);
+
+    // The first (num_cells % num_parts) subdomains get one extra cell.
+    const int base = num_cells / num_parts;
+    const int extra = num_cells % num_parts;
+    std::vector<int> partition(num_cells);
+    int cell = 0;
+    for (int domain = 0; domain < num_parts; ++domain) {
+        const int size = base + (domain < extra ? 1 : 0);
+        std::fill_n(partition.begin() + cell, size, domain);
+        cell += size;
+    }
+    assert(cell == num_cells);
+    return { partition, num_parts };
+}
+
+std::vector<std::vector<int>>
+domainCells(const std::vector<int>& partition, const int num_domains)
+{
+    std::vector<std::vector<int>> cells(num_domains);
+    for (std::size_t cell = 0; cell < partition.size(); ++cell) {
+        assert(partition[cell] >= 0 && partition[cell] < num_domains);
+        cells[partition[cell]].push_back(cell);
+    }
+    return cells;
+}
+
+} // namespace Opm
@@ -0,0 +1,45 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARTITIONCELLS_HEADER_INCLUDED
+#define OPM_PARTITIONCELLS_HEADER_INCLUDED
+
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// Partition the cells of a process into subdomains of contiguous cell indices.
+///
+/// The subdomains differ in size by at most one cell. For grids whose cell
+/// ordering follows the logical Cartesian structure the subdomains are slabs
+/// of the grid.
+///
+/// \param[in] num_cells     number of (interior) cells to partition
+/// \param[in] num_domains   requested number of subdomains, limited to [1, num_cells]
+/// \return                  the subdomain of every cell, and the number of subdomains
+std::pair<std::vector<int>, int> partitionCellsSimple(const int num_cells, const int num_domains);
+
+/// Cells of every subdomain of a partition, in increasing order.
+std::vector<std::vector<int>> domainCells(const std::vector<int>& partition, const int num_domains);
+
+} // namespace Opm
+
+#endif // OPM_PARTITIONCELLS_HEADER_INCLUDED
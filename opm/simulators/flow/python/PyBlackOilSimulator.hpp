@@ -38,22 +38,42 @@ private:
     using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
 
 public:
+    using Checkpoint = Opm::FlowMainEbos<TypeTag>::Checkpoint;
+
     PyBlackOilSimulator( const std::string& deckFilename);
     PyBlackOilSimulator(
         std::shared_ptr<Opm::Deck> deck,
         std::shared_ptr<Opm::EclipseState> state,
         std::shared_ptr<Opm::Schedule> schedule,
         std::shared_ptr<Opm::SummaryConfig> summary_config);
+    ~PyBlackOilSimulator();
+    Checkpoint checkpoint();
     py::array_t<double> getPorosity();
+    py::array_t<double> getPorosityView();
+    py::array_t<double> getPressure();
+    py::array_t<double> getSaturation(const std::string& phase);
+    py::array_t<double> getRs();
+    py::array_t<double> getRv();
+    py::array_t<double> getWellRates(const std::string& well);
+    void restoreCheckpoint(const Checkpoint& checkpoint);
+    int reset(
+        py::array_t<double, py::array::c_style | py::array::forcecast> porosityMultipliers,
+        py::array_t<double, py::array::c_style | py::array::forcecast> permeabilityMultipliers);
     int run();
     void setPorosity(
          py::array_t<double, py::array::c_style | py::array::forcecast> array);
+    void setWellTargets(
+        const std::vector<std::string>& wells, const std::string& control,
+        py::array_t<double, py::array::c_style | py::array::forcecast> targets);
     int step();
     int stepInit();
     int stepCleanup();
     const Opm::FlowMainEbos<TypeTag>& getFlowMainEbos() const;
 
 private:
+    PyMaterialState<TypeTag>& getMaterialState() const;
+    py::array_t<double> readOnlyView(const double* data, std::size_t size, std::ptrdiff_t stride);
+
     const std::string deckFilename_;
     bool hasRunInit_ = false;
     bool hasRunCleanup_ = false;
@@ -22,6 +22,7 @@
 
 #include <opm/models/utils/propertysystem.hh>
 
+#include <cstddef>
 #include <exception>
 #include <iostream>
 #include <map>
@@ -48,7 +49,25 @@ namespace Opm::Pybind
         std::unique_ptr<double []> getCellVolumes( std::size_t *size);
         std::unique_ptr<double []> getPorosity( std::size_t *size);
         void setPorosity(const double *poro, std::size_t size);
+
+        // The reference porosity of the cells, without a copy. Writing to
+        // it has the same effect as setPorosity().
+        double* getPorosityView( std::size_t *size);
+
+        // Views of a quantity of the cached intensive quantities of the cells,
+        // without a copy. The values of consecutive cells are *stride bytes
+        // apart, and they change in place when the solution is updated.
+        const double* getPressureView( std::size_t *size, std::ptrdiff_t *stride);
+        const double* getSaturationView(unsigned phaseIdx, std::size_t *size, std::ptrdiff_t *stride);
+        const double* getRsView( std::size_t *size, std::ptrdiff_t *stride);
+        const double* getRvView( std::size_t *size, std::ptrdiff_t *stride);
     private:
+        using IntensiveQuantities = GetPropType<TypeTag, Opm::Properties::IntensiveQuantities>;
+
+        template <class Getter>
+        const double* intensiveQuantityView_(
+            const Getter& getter, std::size_t *size, std::ptrdiff_t *stride);
+
         Simulator *ebosSimulator_;
     };
 
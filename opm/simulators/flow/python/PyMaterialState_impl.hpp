@@ -66,4 +66,94 @@ setPorosity(const double *poro, std::size_t size)
         problem.setPorosity(poro[dofIdx], dofIdx);
     }
 }
+template <class TypeTag>
+double*
+PyMaterialState<TypeTag>::
+getPorosityView( std::size_t *size)
+{
+    Problem &problem = ebosSimulator_->problem();
+    *size = ebosSimulator_->model().numGridDof();
+    return problem.referencePorosityData(/*timeIdx*/0);
+}
+
+template <class TypeTag>
+template <class Getter>
+const double*
+PyMaterialState<TypeTag>::
+intensiveQuantityView_(const Getter& getter, std::size_t *size, std::ptrdiff_t *stride)
+{
+    Model &model = ebosSimulator_->model();
+    *size = model.numGridDof();
+    // The cache is one array of the intensive quantities of all cells.
+    const IntensiveQuantities* first = model.cachedIntensiveQuantities(0, /*timeIdx*/0);
+    if (*size == 0 || first == nullptr) {
+        throw std::runtime_error("Cannot create a view, the intensive quantities are not cached");
+    }
+    const double* value = &getter(*first).value();
+    const char* begin = reinterpret_cast<const char*>(first);
+    const char* field = reinterpret_cast<const char*>(value);
+    if (field < begin || field + sizeof(double) > begin + sizeof(IntensiveQuantities)) {
+        // e.g. the Rs of a fluid state without dissolved gas
+        throw std::runtime_error("Cannot create a view, the quantity is not stored per cell");
+    }
+    *stride = sizeof(IntensiveQuantities);
+    return value;
+}
+
+template <class TypeTag>
+const double*
+PyMaterialState<TypeTag>::
+getPressureView( std::size_t *size, std::ptrdiff_t *stride)
+{
+    // the same phase pressure as the PRESSURE output
+    unsigned phaseIdx = FluidSystem::oilPhaseIdx;
+    if (!FluidSystem::phaseIsActive(phaseIdx)) {
+        phaseIdx = FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)
+            ? FluidSystem::gasPhaseIdx : FluidSystem::waterPhaseIdx;
+    }
+    return intensiveQuantityView_(
+        [phaseIdx](const IntensiveQuantities& iq) -> const auto&
+        { return iq.fluidState().pressure(phaseIdx); },
+        size, stride);
+}
+
+template <class TypeTag>
+const double*
+PyMaterialState<TypeTag>::
+getSaturationView(unsigned phaseIdx, std::size_t *size, std::ptrdiff_t *stride)
+{
+    if (phaseIdx >= FluidSystem::numPhases || !FluidSystem::phaseIsActive(phaseIdx)) {
+        throw std::runtime_error("Cannot create a saturation view of an inactive phase");
+    }
+    return intensiveQuantityView_(
+        [phaseIdx](const IntensiveQuantities& iq) -> const auto&
+        { return iq.fluidState().saturation(phaseIdx); },
+        size, stride);
+}
+
+template <class TypeTag>
+const double*
+PyMaterialState<TypeTag>::
+getRsView( std::size_t *size, std::ptrdiff_t *stride)
+{
+    if (!FluidSystem::enableDissolvedGas()) {
+        throw std::runtime_error("Cannot create a view of Rs, the case has no dissolved gas");
+    }
+    return intensiveQuantityView_(
+        [](const IntensiveQuantities& iq) -> const auto& { return iq.fluidState().Rs(); },
+        size, stride);
+}
+
+template <class TypeTag>
+const double*
+PyMaterialState<TypeTag>::
+getRvView( std::size_t *size, std::ptrdiff_t *stride)
+{
+    if (!FluidSystem::enableVaporizedOil()) {
+        throw std::runtime_error("Cannot create a view of Rv, the case has no vaporized oil");
+    }
+    return intensiveQuantityView_(
+        [](const IntensiveQuantities& iq) -> const auto& { return iq.fluidState().Rv(); },
+        size, stride);
+}
 } //namespace Opm::Pybind
@@ -0,0 +1,181 @@
+/*
+  Copyright 2021 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_BLOCKSPMV_HEADER_INCLUDED
+#define OPM_BLOCKSPMV_HEADER_INCLUDED
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define OPM_BLOCKSPMV_AVX2 1
+#endif
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace Opm
+{
+namespace detail
+{
+
+    //! Minimum number of block rows for distributing a product over threads.
+    constexpr std::size_t blockSpMVMinRowsPerThread = 1024;
+
+    /// \brief Compute the product of one block row with x.
+    ///
+    /// The block size is a compile time constant, hence the inner loops
+    /// are completely unrolled. The partial sums of the whole row are kept
+    /// in registers and only written once.
+    /// \tparam add If true y += alpha * (A x)_i, otherwise y = (A x)_i.
+    template <bool add, class Block, class Row, class X, class YBlock, class K>
+    inline void blockRowProduct(const Row& row, const X& x, [[maybe_unused]] const K alpha, YBlock& y)
+    {
+        constexpr int rows = Block::rows;
+        constexpr int cols = Block::cols;
+        // Accumulate in the precision of x for matrices stored in lower precision.
+        using Field = std::common_type_t<typename Block::field_type, typename X::field_type>;
+
+#if OPM_BLOCKSPMV_AVX2
+        if constexpr (rows == 4 && cols == 4 && std::is_same_v<typename Block::field_type, double>
+                      && std::is_same_v<typename X::field_type, double>)
+        {
+            // one register per block row, FieldMatrix stores rows contiguously
+            __m256d acc0 = _mm256_setzero_pd();
+            __m256d acc1 = _mm256_setzero_pd();
+            __m256d acc2 = _mm256_setzero_pd();
+            __m256d acc3 = _mm256_setzero_pd();
+            for (auto col = row.begin(), cend = row.end(); col != cend; ++col)
+            {
+                const double* a = &(*col)[0][0];
+                const __m256d xv = _mm256_loadu_pd(&x[col.index()][0]);
+                acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a), xv, acc0);
+                acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + 4), xv, acc1);
+                acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + 8), xv, acc2);
+                acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + 12), xv, acc3);
+            }
+            // horizontal sums of the four accumulators
+            const __m256d s01 = _mm256_hadd_pd(acc0, acc1);
+            const __m256d s23 = _mm256_hadd_pd(acc2, acc3);
+            const __m256d sum = _mm256_add_pd(_mm256_permute2f128_pd(s01, s23, 0x20),
+                                              _mm256_permute2f128_pd(s01, s23, 0x31));
+            double* yv = &y[0];
+            if constexpr (add)
+            {
+                _mm256_storeu_pd(yv, _mm256_fmadd_pd(_mm256_set1_pd(alpha), sum,
+                                                     _mm256_loadu_pd(yv)));
+            }
+            else
+            {
+                _mm256_storeu_pd(yv, sum);
+            }
+            return;
+        }
+#endif
+        std::array<Field, rows> acc{};
+        for (auto col = row.begin(), cend = row.end(); col != cend; ++col)
+        {
+            const auto& a = *col;
+            const auto& xj = x[col.index()];
+            for (int i = 0; i < rows; ++i)
+            {
+                for (int j = 0; j < cols; ++j)
+                {
+                    acc[i] += a[i][j] * xj[j];
+                }
+            }
+        }
+        for (int i = 0; i < rows; ++i)
+        {
+            if constexpr (add)
+            {
+                y[i] += alpha * acc[i];
+            }
+            else
+            {
+                y[i] = acc[i];
+            }
+        }
+    }
+
+    template <bool add, class M, class X, class Y>
+    void blockSpMV(const M& A, const X& x, Y& y, const typename X::field_type alpha,
+                   const std::size_t numRows)
+    {
+        using Block = typename M::block_type;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(numRows > 2 * blockSpMVMinRowsPerThread)
+#endif
+        for (std::size_t i = 0; i < numRows; ++i)
+        {
+            blockRowProduct<add, Block>(A[i], x, alpha, y[i]);
+        }
+    }
+
+    /// \brief y = A x, or y += alpha A x if add, for the block rows of A listed in rows.
+    template <bool add, class M, class X, class Y, class Rows>
+    void blockSpMVRows(const M& A, const X& x, Y& y, const typename X::field_type alpha,
+                       const Rows& rows)
+    {
+        using Block = typename M::block_type;
+        const std::size_t numRows = rows.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(numRows > 2 * blockSpMVMinRowsPerThread)
+#endif
+        for (std::size_t k = 0; k < numRows; ++k)
+        {
+            const std::size_t i = rows[k];
+            blockRowProduct<add, Block>(A[i], x, alpha, y[i]);
+        }
+    }
+
+    /// \brief y = A x for the first numRows block rows of A.
+    ///
+    /// Drop in replacement for A.mv(x, y) on BCRSMatrix with small dense blocks.
+    /// For 4x4 double blocks explicit AVX2 code is used if the compiler targets it.
+    template <class M, class X, class Y>
+    void blockMv(const M& A, const X& x, Y& y, const std::size_t numRows)
+    {
+        blockSpMV<false>(A, x, y, 1.0, numRows);
+    }
+
+    /// \brief y = A x.
+    template <class M, class X, class Y>
+    void blockMv(const M& A, const X& x, Y& y)
+    {
+        blockMv(A, x, y, A.N());
+    }
+
+    /// \brief y += alpha A x for the first numRows block rows of A.
+    template <class M, class X, class Y>
+    void blockUsmv(const typename X::field_type alpha, const M& A, const X& x, Y& y,
+                   const std::size_t numRows)
+    {
+        blockSpMV<true>(A, x, y, alpha, numRows);
+    }
+
+    /// \brief y += alpha A x.
+    template <class M, class X, class Y>
+    void blockUsmv(const typename X::field_type alpha, const M& A, const X& x, Y& y)
+    {
+        blockUsmv(alpha, A, x, y, A.N());
+    }
+
+} // namespace detail
+} // namespace Opm
+
+#endif // OPM_BLOCKSPMV_HEADER_INCLUDED
@@ -28,6 +28,15 @@
 #include <dune/istl/solver.hh>
 #include <dune/istl/paamg/pinfo.hh>
 
+#include <memory>
+#include <vector>
+
+namespace Opm
+{
+template <class X>
+class RecyclingSolver;
+}
+
 namespace Dune
 {
 
@@ -65,9 +74,23 @@ public:
 
     virtual void apply(VectorType& x, VectorType& rhs, double reduction, Dune::InverseOperatorResult& res) override;
 
+    /// Solve from the initial guess in x, with the residual reduction measured
+    /// relative to the right hand side instead of the initial residual, such
+    /// that a good initial guess saves iterations.
+    void applyFromInitialGuess(VectorType& x, VectorType& rhs, Dune::InverseOperatorResult& res);
+
+    void applyFromInitialGuess(VectorType& x, VectorType& rhs, double reduction, Dune::InverseOperatorResult& res);
+
     /// Access the contained preconditioner.
     AbstractPrecondType& preconditioner();
 
+    /// Take the solutions kept for recycling ("recycle" > 0), e.g. to hand
+    /// them to a new solver of the same system. Empty without recycling.
+    std::vector<VectorType> releaseRecycledSolutions();
+
+    /// Set the solutions kept for recycling, ignored without recycling.
+    void setRecycledSolutions(std::vector<VectorType> solutions);
+
     virtual Dune::SolverCategory::Category category() const override;
 
 private:
@@ -84,7 +107,8 @@ private:
                       const std::function<VectorType()> weightsCalculator, const Dune::Amg::SequentialInformation&,
                       std::size_t pressureIndex);
 
-    void initSolver(const Opm::PropertyTree& prm, const bool is_iorank);
+    template <class Comm>
+    void initSolver(const Opm::PropertyTree& prm, const Comm& comm);
 
     // Main initialization routine.
     // Call with Comm == Dune::Amg::SequentialInformation to get a serial solver.
@@ -100,6 +124,8 @@ private:
     std::shared_ptr<AbstractPrecondType> preconditioner_;
     std::shared_ptr<AbstractScalarProductType> scalarproduct_;
     std::shared_ptr<AbstractSolverType> linsolver_;
+    std::shared_ptr<Opm::RecyclingSolver<VectorType>> recycling_solver_;
+    double tol_ = 1e-2;
 };
 
 } // namespace Dune
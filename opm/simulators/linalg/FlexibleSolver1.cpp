@@ -22,3 +22,4 @@
 #include <opm/simulators/linalg/FlexibleSolver_impl.hpp>
 
 INSTANTIATE_FLEXIBLESOLVER(1);
+INSTANTIATE_FLEXIBLESOLVER_FLOAT_PRESSURE();
@@ -24,7 +24,10 @@
 #include <opm/simulators/linalg/matrixblock.hh>
 #include <opm/simulators/linalg/ilufirstelement.hh>
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/PipelinedBiCGSTABSolver.hpp>
 #include <opm/simulators/linalg/PreconditionerFactory.hpp>
+#include <opm/simulators/linalg/RecyclingSolver.hpp>
+#include <opm/simulators/linalg/TimedScalarProduct.hpp>
 
 #include <dune/common/fmatrix.hh>
 #include <dune/istl/bcrsmatrix.hh>
@@ -76,6 +79,32 @@ namespace Dune
         linsolver_->apply(x, rhs, reduction, res);
     }
 
+    template <class MatrixType, class VectorType>
+    void
+    FlexibleSolver<MatrixType, VectorType>::
+    applyFromInitialGuess(VectorType& x, VectorType& rhs, Dune::InverseOperatorResult& res)
+    {
+        applyFromInitialGuess(x, rhs, tol_, res);
+    }
+
+    template <class MatrixType, class VectorType>
+    void
+    FlexibleSolver<MatrixType, VectorType>::
+    applyFromInitialGuess(VectorType& x, VectorType& rhs, double reduction, Dune::InverseOperatorResult& res)
+    {
+        // The iterative solvers measure the reduction relative to the residual
+        // of the initial guess, make it relative to the right hand side instead.
+        if (scalarproduct_->norm(x) > 0.0) {
+            VectorType r(rhs);
+            linearoperator_for_solver_->applyscaleadd(-1.0, x, r);
+            const double def = scalarproduct_->norm(r);
+            if (def > 0.0) {
+                reduction *= scalarproduct_->norm(rhs) / def;
+            }
+        }
+        linsolver_->apply(x, rhs, reduction, res);
+    }
+
     /// Access the contained preconditioner.
     template <class MatrixType, class VectorType>
     auto
@@ -85,6 +114,27 @@ namespace Dune
         return *preconditioner_;
     }
 
+    template <class MatrixType, class VectorType>
+    std::vector<VectorType>
+    FlexibleSolver<MatrixType, VectorType>::
+    releaseRecycledSolutions()
+    {
+        if (recycling_solver_) {
+            return recycling_solver_->releaseVectors();
+        }
+        return {};
+    }
+
+    template <class MatrixType, class VectorType>
+    void
+    FlexibleSolver<MatrixType, VectorType>::
+    setRecycledSolutions(std::vector<VectorType> solutions)
+    {
+        if (recycling_solver_) {
+            recycling_solver_->setVectors(std::move(solutions));
+        }
+    }
+
     template <class MatrixType, class VectorType>
     Dune::SolverCategory::Category
     FlexibleSolver<MatrixType, VectorType>::
@@ -114,7 +164,8 @@ namespace Dune
                                                                                     weightsCalculator,
                                                                                     comm,
                                                                                     pressureIndex);
-        scalarproduct_ = Dune::createScalarProduct<VectorType, Comm>(comm, op.category());
+        scalarproduct_ = std::make_shared<Opm::TimedScalarProduct<VectorType>>(
+            Dune::createScalarProduct<VectorType, Comm>(comm, op.category()));
         linearoperator_for_precond_ = op_prec;
     }
 
@@ -141,11 +192,14 @@ namespace Dune
     }
 
     template <class MatrixType, class VectorType>
+    template <class Comm>
     void
     FlexibleSolver<MatrixType, VectorType>::
-    initSolver(const Opm::PropertyTree& prm, const bool is_iorank)
+    initSolver(const Opm::PropertyTree& prm, const Comm& comm)
     {
+        const bool is_iorank = comm.communicator().rank() == 0;
         const double tol = prm.get<double>("tol", 1e-2);
+        tol_ = tol;
         const int maxiter = prm.get<int>("maxiter", 200);
         const int verbosity = is_iorank ? prm.get<int>("verbosity", 0) : 0;
         const std::string solver_type = prm.get<std::string>("solver", "bicgstab");
@@ -156,6 +210,13 @@ namespace Dune
                                                                   tol, // desired residual reduction factor
                                                                   maxiter, // maximum number of iterations
                                                                   verbosity));
+        } else if (solver_type == "pipelinedbicgstab") {
+            linsolver_.reset(new Opm::PipelinedBiCGSTABSolver<VectorType>(*linearoperator_for_solver_,
+                                                                          *preconditioner_,
+                                                                          Opm::PipelinedScalarProducts<VectorType>(comm),
+                                                                          tol, // desired residual reduction factor
+                                                                          maxiter, // maximum number of iterations
+                                                                          verbosity));
         } else if (solver_type == "loopsolver") {
             linsolver_.reset(new Dune::LoopSolver<VectorType>(*linearoperator_for_solver_,
                                                               *scalarproduct_,
@@ -174,12 +235,27 @@ namespace Dune
                                                                         verbosity));
 #if HAVE_SUITESPARSE_UMFPACK
         } else if (solver_type == "umfpack") {
-            bool dummy = false;
-            linsolver_.reset(new Dune::UMFPack<MatrixType>(linearoperator_for_solver_->getmat(), verbosity, dummy));
+            if constexpr (std::is_same_v<typename VectorType::field_type, double>) {
+                bool dummy = false;
+                linsolver_.reset(new Dune::UMFPack<MatrixType>(linearoperator_for_solver_->getmat(), verbosity, dummy));
+            } else {
+                OPM_THROW(std::invalid_argument, "Properties: Solver umfpack is only supported in double precision.");
+            }
 #endif
         } else {
             OPM_THROW(std::invalid_argument, "Properties: Solver " << solver_type << " not known.");
         }
+
+        // Optionally recycle the solutions of the last solves.
+        const int recycle = prm.get<int>("recycle", 0);
+        if (recycle > 0) {
+            recycling_solver_ = std::make_shared<Opm::RecyclingSolver<VectorType>>(*linearoperator_for_solver_,
+                                                                                   *scalarproduct_,
+                                                                                   linsolver_,
+                                                                                   tol,
+                                                                                   recycle);
+            linsolver_ = recycling_solver_;
+        }
     }
 
 
@@ -196,7 +272,7 @@ namespace Dune
          std::size_t pressureIndex)
     {
         initOpPrecSp(op, prm, weightsCalculator, comm, pressureIndex);
-        initSolver(prm, comm.communicator().rank() == 0);
+        initSolver(prm, comm);
     }
 
 } // namespace Dune
@@ -211,6 +287,10 @@ using BM = Dune::BCRSMatrix<Dune::FieldMatrix<double, N, N>>;
 template <int N>
 using OBM = Dune::BCRSMatrix<Opm::MatrixBlock<double, N, N>>;
 
+// Single precision pressure systems used by CPR.
+using BVFloat1 = Dune::BlockVector<Dune::FieldVector<float, 1>>;
+using BMFloat1 = Dune::BCRSMatrix<Dune::FieldMatrix<float, 1, 1>>;
+
 #if HAVE_MPI
 
 using Comm = Dune::OwnerOverlapCopyCommunication<int, int>;
@@ -233,12 +313,23 @@ template Dune::FlexibleSolver<OBM<N>, BV<N>>::FlexibleSolver(AbstractOperatorTyp
                                                              const std::function<BV<N>()>& weightsCalculator, \
 std::size_t);
 
+#define INSTANTIATE_FLEXIBLESOLVER_FLOAT_PRESSURE()                                                               \
+template class Dune::FlexibleSolver<BMFloat1, BVFloat1>;                                                          \
+template Dune::FlexibleSolver<BMFloat1, BVFloat1>::FlexibleSolver(AbstractOperatorType& op,                       \
+                                                                  const Comm& comm,                               \
+                                                                  const Opm::PropertyTree& prm,                   \
+                                                                  const std::function<BVFloat1()>& weightsCalculator, \
+std::size_t);
+
 #else // HAVE_MPI
 
 #define INSTANTIATE_FLEXIBLESOLVER(N)                  \
 template class Dune::FlexibleSolver<BM<N>, BV<N>>;     \
 template class Dune::FlexibleSolver<OBM<N>, BV<N>>;
 
+#define INSTANTIATE_FLEXIBLESOLVER_FLOAT_PRESSURE()    \
+template class Dune::FlexibleSolver<BMFloat1, BVFloat1>;
+
 #endif // HAVE_MPI
 
 
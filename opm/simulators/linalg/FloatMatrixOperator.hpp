@@ -0,0 +1,115 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FLOATMATRIXOPERATOR_HEADER_INCLUDED
+#define OPM_FLOATMATRIXOPERATOR_HEADER_INCLUDED
+
+#include <opm/simulators/linalg/BlockSpMV.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/paamg/pinfo.hh>
+
+#include <type_traits>
+
+namespace Opm
+{
+
+/// \brief Linear operator applying a single precision copy of a matrix.
+///
+/// Meant for the residual updates inside preconditioners, which only need
+/// an approximation of the operator, while the double precision matrix is
+/// still used for the residual of the linear solver. Reading half the bytes
+/// per nonzero makes these memory bound products faster. The copy has the
+/// sparsity pattern of the matrix and is refreshed by updateValues(). In
+/// the parallel case the result is projected like in
+/// Dune::OverlappingSchwarzOperator.
+template <class Matrix, class X, class Comm = Dune::Amg::SequentialInformation>
+class FloatMatrixOperator : public Dune::LinearOperator<X, X>
+{
+public:
+    using FloatBlock = Dune::FieldMatrix<float, Matrix::block_type::rows, Matrix::block_type::cols>;
+    using FloatMatrix = Dune::BCRSMatrix<FloatBlock>;
+    using field_type = typename X::field_type;
+
+    explicit FloatMatrixOperator(const Matrix& A, const Comm* comm = nullptr)
+        : A_(A)
+        , Af_(A.N(), A.M(), A.nonzeroes(), FloatMatrix::row_wise)
+        , comm_(comm)
+    {
+        for (auto row = Af_.createbegin(), rend = Af_.createend(); row != rend; ++row) {
+            for (auto col = A_[row.index()].begin(), cend = A_[row.index()].end(); col != cend; ++col) {
+                row.insert(col.index());
+            }
+        }
+        updateValues();
+    }
+
+    /// Copy the current values of the matrix, which must keep its pattern.
+    void updateValues()
+    {
+        auto frow = Af_.begin();
+        for (auto row = A_.begin(), rend = A_.end(); row != rend; ++row, ++frow) {
+            auto fcol = frow->begin();
+            for (auto col = row->begin(), cend = row->end(); col != cend; ++col, ++fcol) {
+                for (int i = 0; i < FloatBlock::rows; ++i) {
+                    for (int j = 0; j < FloatBlock::cols; ++j) {
+                        (*fcol)[i][j] = (*col)[i][j];
+                    }
+                }
+            }
+        }
+    }
+
+    void apply(const X& x, X& y) const override
+    {
+        detail::blockMv(Af_, x, y);
+        project(y);
+    }
+
+    void applyscaleadd(field_type alpha, const X& x, X& y) const override
+    {
+        detail::blockUsmv(alpha, Af_, x, y);
+        project(y);
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return isSequential ? Dune::SolverCategory::sequential : Dune::SolverCategory::overlapping;
+    }
+
+private:
+    static constexpr bool isSequential = std::is_same_v<Comm, Dune::Amg::SequentialInformation>;
+
+    void project([[maybe_unused]] X& y) const
+    {
+        if constexpr (!isSequential) {
+            comm_->project(y);
+        }
+    }
+
+    const Matrix& A_;
+    FloatMatrix Af_;
+    const Comm* comm_;
+};
+
+} // namespace Opm
+
+#endif // OPM_FLOATMATRIXOPERATOR_HEADER_INCLUDED
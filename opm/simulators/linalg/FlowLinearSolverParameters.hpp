@@ -50,6 +50,10 @@ struct LinearSolverReduction {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct LinearSolverMaxReduction {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct IluRelaxation {
     using type = UndefinedProperty;
 };
@@ -62,6 +66,18 @@ struct LinearSolverRestart {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct LinearSolverRecycle {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct LinearSolverOverlapHaloExchange {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct LinearSolverFallback {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct FlowLinearSolverVerbosity {
     using type = UndefinedProperty;
 };
@@ -82,6 +98,10 @@ struct IluReorderSpheres {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct IluReorderRcm {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct UseGmres {
     using type = UndefinedProperty;
 };
@@ -106,6 +126,10 @@ struct CprMaxEllIter {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct CprRedundantCoarseSolve {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct CprEllSolvetype {
     using type = UndefinedProperty;
 };
@@ -134,6 +158,38 @@ struct OpenclIluReorder {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct OpenclAsyncUpload {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct OpenclAutotuneCache {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct OpenclProgramCache {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct OpenclConvergenceCheckInterval {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct OpenclSellFormat {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct OpenclIluFloat {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct AmgclReuseSetup {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct AmgclRebuildInterval {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct FpgaBitstream {
     using type = UndefinedProperty;
 };
@@ -144,6 +200,11 @@ struct LinearSolverReduction<TypeTag, TTag::FlowIstlSolverParams> {
     static constexpr type value = 1e-2;
 };
 template<class TypeTag>
+struct LinearSolverMaxReduction<TypeTag, TTag::FlowIstlSolverParams> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
+template<class TypeTag>
 struct IluRelaxation<TypeTag, TTag::FlowIstlSolverParams> {
     using type = GetPropType<TypeTag, Scalar>;
     static constexpr type value = 0.9;
@@ -157,6 +218,18 @@ struct LinearSolverRestart<TypeTag, TTag::FlowIstlSolverParams> {
     static constexpr int value = 40;
 };
 template<class TypeTag>
+struct LinearSolverRecycle<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr int value = 0;
+};
+template<class TypeTag>
+struct LinearSolverOverlapHaloExchange<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct LinearSolverFallback<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
 struct FlowLinearSolverVerbosity<TypeTag, TTag::FlowIstlSolverParams> {
     static constexpr int value = 0;
 };
@@ -177,6 +250,10 @@ struct IluReorderSpheres<TypeTag, TTag::FlowIstlSolverParams> {
     static constexpr bool value = false;
 };
 template<class TypeTag>
+struct IluReorderRcm<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
 struct UseGmres<TypeTag, TTag::FlowIstlSolverParams> {
     static constexpr bool value = false;
 };
@@ -205,6 +282,10 @@ struct CprMaxEllIter<TypeTag, TTag::FlowIstlSolverParams> {
     static constexpr int value = 20;
 };
 template<class TypeTag>
+struct CprRedundantCoarseSolve<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
 struct CprEllSolvetype<TypeTag, TTag::FlowIstlSolverParams> {
     static constexpr int value = 0;
 };
@@ -233,6 +314,38 @@ struct OpenclIluReorder<TypeTag, TTag::FlowIstlSolverParams> {
     static constexpr auto value = ""; // note: default value is chosen depending on the solver used
 };
 template<class TypeTag>
+struct OpenclAsyncUpload<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct OpenclAutotuneCache<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr auto value = "";
+};
+template<class TypeTag>
+struct OpenclProgramCache<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr auto value = "";
+};
+template<class TypeTag>
+struct OpenclConvergenceCheckInterval<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr int value = 1;
+};
+template<class TypeTag>
+struct OpenclSellFormat<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct OpenclIluFloat<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct AmgclReuseSetup<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr int value = 0;
+};
+template<class TypeTag>
+struct AmgclRebuildInterval<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr int value = 0;
+};
+template<class TypeTag>
 struct FpgaBitstream<TypeTag, TTag::FlowIstlSolverParams> {
     static constexpr auto value = "";
 };
@@ -247,14 +360,19 @@ namespace Opm
     struct FlowLinearSolverParameters
     {
         double linear_solver_reduction_;
+        double linear_solver_max_reduction_;
         double ilu_relaxation_;
         int    linear_solver_maxiter_;
         int    linear_solver_restart_;
+        int    linear_solver_recycle_;
+        bool   linear_solver_overlap_halo_exchange_;
+        bool   linear_solver_fallback_;
         int    linear_solver_verbosity_;
         int    ilu_fillin_level_;
         MILU_VARIANT   ilu_milu_;
         bool   ilu_redblack_;
         bool   ilu_reorder_sphere_;
+        bool   ilu_reorder_rcm_;
         bool   newton_use_gmres_;
         bool   require_full_sparsity_pattern_;
         bool   ignoreConvergenceFailure_;
@@ -265,7 +383,16 @@ namespace Opm
         int opencl_platform_id_;
         int cpr_max_ell_iter_ = 20;
         int cpr_reuse_setup_ = 0;
+        bool cpr_redundant_coarse_solve_ = false;
         std::string opencl_ilu_reorder_;
+        bool opencl_async_upload_;
+        std::string opencl_autotune_cache_;
+        std::string opencl_program_cache_;
+        int opencl_convergence_check_interval_;
+        bool opencl_sell_format_;
+        bool opencl_ilu_float_;
+        int amgcl_reuse_setup_;
+        int amgcl_rebuild_interval_;
         std::string fpga_bitstream_;
 
         template <class TypeTag>
@@ -273,25 +400,39 @@ namespace Opm
         {
             // TODO: these parameters have undocumented non-trivial dependencies
             linear_solver_reduction_ = EWOMS_GET_PARAM(TypeTag, double, LinearSolverReduction);
+            linear_solver_max_reduction_ = EWOMS_GET_PARAM(TypeTag, double, LinearSolverMaxReduction);
             ilu_relaxation_ = EWOMS_GET_PARAM(TypeTag, double, IluRelaxation);
             linear_solver_maxiter_ = EWOMS_GET_PARAM(TypeTag, int, LinearSolverMaxIter);
             linear_solver_restart_ = EWOMS_GET_PARAM(TypeTag, int, LinearSolverRestart);
+            linear_solver_recycle_ = EWOMS_GET_PARAM(TypeTag, int, LinearSolverRecycle);
+            linear_solver_overlap_halo_exchange_ = EWOMS_GET_PARAM(TypeTag, bool, LinearSolverOverlapHaloExchange);
+            linear_solver_fallback_ = EWOMS_GET_PARAM(TypeTag, bool, LinearSolverFallback);
             linear_solver_verbosity_ = EWOMS_GET_PARAM(TypeTag, int, FlowLinearSolverVerbosity);
             ilu_fillin_level_ = EWOMS_GET_PARAM(TypeTag, int, IluFillinLevel);
             ilu_milu_ = convertString2Milu(EWOMS_GET_PARAM(TypeTag, std::string, MiluVariant));
             ilu_redblack_ = EWOMS_GET_PARAM(TypeTag, bool, IluRedblack);
             ilu_reorder_sphere_ = EWOMS_GET_PARAM(TypeTag, bool, IluReorderSpheres);
+            ilu_reorder_rcm_ = EWOMS_GET_PARAM(TypeTag, bool, IluReorderRcm);
             newton_use_gmres_ = EWOMS_GET_PARAM(TypeTag, bool, UseGmres);
             require_full_sparsity_pattern_ = EWOMS_GET_PARAM(TypeTag, bool, LinearSolverRequireFullSparsityPattern);
             ignoreConvergenceFailure_ = EWOMS_GET_PARAM(TypeTag, bool, LinearSolverIgnoreConvergenceFailure);
             scale_linear_system_ = EWOMS_GET_PARAM(TypeTag, bool, ScaleLinearSystem);
             cpr_max_ell_iter_  =  EWOMS_GET_PARAM(TypeTag, int, CprMaxEllIter);
             cpr_reuse_setup_  =  EWOMS_GET_PARAM(TypeTag, int, CprReuseSetup);
+            cpr_redundant_coarse_solve_ = EWOMS_GET_PARAM(TypeTag, bool, CprRedundantCoarseSolve);
             linsolver_ = EWOMS_GET_PARAM(TypeTag, std::string, Linsolver);
             accelerator_mode_ = EWOMS_GET_PARAM(TypeTag, std::string, AcceleratorMode);
             bda_device_id_ = EWOMS_GET_PARAM(TypeTag, int, BdaDeviceId);
             opencl_platform_id_ = EWOMS_GET_PARAM(TypeTag, int, OpenclPlatformId);
             opencl_ilu_reorder_ = EWOMS_GET_PARAM(TypeTag, std::string, OpenclIluReorder);
+            opencl_async_upload_ = EWOMS_GET_PARAM(TypeTag, bool, OpenclAsyncUpload);
+            opencl_autotune_cache_ = EWOMS_GET_PARAM(TypeTag, std::string, OpenclAutotuneCache);
+            opencl_program_cache_ = EWOMS_GET_PARAM(TypeTag, std::string, OpenclProgramCache);
+            opencl_convergence_check_interval_ = EWOMS_GET_PARAM(TypeTag, int, OpenclConvergenceCheckInterval);
+            opencl_sell_format_ = EWOMS_GET_PARAM(TypeTag, bool, OpenclSellFormat);
+            opencl_ilu_float_ = EWOMS_GET_PARAM(TypeTag, bool, OpenclIluFloat);
+            amgcl_reuse_setup_ = EWOMS_GET_PARAM(TypeTag, int, AmgclReuseSetup);
+            amgcl_rebuild_interval_ = EWOMS_GET_PARAM(TypeTag, int, AmgclRebuildInterval);
             fpga_bitstream_ = EWOMS_GET_PARAM(TypeTag, std::string, FpgaBitstream);
         }
 
@@ -299,25 +440,39 @@ namespace Opm
         static void registerParameters()
         {
             EWOMS_REGISTER_PARAM(TypeTag, double, LinearSolverReduction, "The minimum reduction of the residual which the linear solver must achieve");
+            EWOMS_REGISTER_PARAM(TypeTag, double, LinearSolverMaxReduction, "If larger than the minimum reduction, adapt the reduction of every linear solve to the convergence of the Newton iterations (Eisenstat-Walker), between the minimum reduction and this value. 0 to use a fixed reduction");
             EWOMS_REGISTER_PARAM(TypeTag, double, IluRelaxation, "The relaxation factor of the linear solver's ILU preconditioner");
             EWOMS_REGISTER_PARAM(TypeTag, int, LinearSolverMaxIter, "The maximum number of iterations of the linear solver");
             EWOMS_REGISTER_PARAM(TypeTag, int, LinearSolverRestart, "The number of iterations after which GMRES is restarted");
+            EWOMS_REGISTER_PARAM(TypeTag, int, LinearSolverRecycle, "The number of previous linear solutions over which the residual is minimised before each linear solve. 0 to disable");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, LinearSolverOverlapHaloExchange, "Overlap the halo exchange of the parallel linear operator with the product of the interior rows. Only used with bicgstab, an ILU preconditioner and --matrix-add-well-contributions=false");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, LinearSolverFallback, "Retry a failed linear solve with stronger configurations before the time step is chopped: the configured solver with more fill-in and iterations, then GMRES with a larger restart, and a direct solver for small sequential systems. A JSON configuration gives its own under 'fallback.1', 'fallback.2', ...");
             EWOMS_REGISTER_PARAM(TypeTag, int, FlowLinearSolverVerbosity, "The verbosity level of the linear solver (0: off, 2: all)");
             EWOMS_REGISTER_PARAM(TypeTag, int, IluFillinLevel, "The fill-in level of the linear solver's ILU preconditioner");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, MiluVariant, "Specify which variant of the modified-ILU preconditioner ought to be used. Possible variants are: ILU (default, plain ILU), MILU_1 (lump diagonal with dropped row entries), MILU_2 (lump diagonal with the sum of the absolute values of the dropped row  entries), MILU_3 (if diagonal is positive add sum of dropped row entrires. Otherwise subtract them), MILU_4 (if diagonal is positive add sum of dropped row entrires. Otherwise do nothing");
             EWOMS_REGISTER_PARAM(TypeTag, bool, IluRedblack, "Use red-black partitioning for the ILU preconditioner");
             EWOMS_REGISTER_PARAM(TypeTag, bool, IluReorderSpheres, "Whether to reorder the entries of the matrix in the red-black ILU preconditioner in spheres starting at an edge. If false the original ordering is preserved in each color. Otherwise why try to ensure D4 ordering (in a 2D structured grid, the diagonal elements are consecutive).");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, IluReorderRcm, "Use a reverse Cuthill-McKee ordering of the interior cells in the ILU preconditioner and the ILU smoother of CPR to improve the cache reuse");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseGmres, "Use GMRES as the linear solver");
             EWOMS_REGISTER_PARAM(TypeTag, bool, LinearSolverRequireFullSparsityPattern, "Produce the full sparsity pattern for the linear solver");
             EWOMS_REGISTER_PARAM(TypeTag, bool, LinearSolverIgnoreConvergenceFailure, "Continue with the simulation like nothing happened after the linear solver did not converge");
             EWOMS_REGISTER_PARAM(TypeTag, bool, ScaleLinearSystem, "Scale linear system according to equation scale and primary variable types");
             EWOMS_REGISTER_PARAM(TypeTag, int, CprMaxEllIter, "MaxIterations of the elliptic pressure part of the cpr solver");
-            EWOMS_REGISTER_PARAM(TypeTag, int, CprReuseSetup, "Reuse preconditioner setup. Valid options are 0: recreate the preconditioner for every linear solve, 1: recreate once every timestep, 2: recreate if last linear solve took more than 10 iterations, 3: never recreate");
-            EWOMS_REGISTER_PARAM(TypeTag, std::string, Linsolver, "Configuration of solver. Valid options are: ilu0 (default), cpr (an alias for cpr_trueimpes), cpr_quasiimpes, cpr_trueimpes or amg. Alternatively, you can request a configuration to be read from a JSON file by giving the filename here, ending with '.json.'");
+            EWOMS_REGISTER_PARAM(TypeTag, int, CprReuseSetup, "Reuse preconditioner setup. Valid options are 0: recreate the preconditioner for every linear solve, 1: recreate once every timestep, 2: recreate if last linear solve took more than 10 iterations, 3: never recreate, 4: recreate when the measured cost of the additional linear iterations since the last setup exceeds the cost of a new setup");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, CprRedundantCoarseSolve, "Gather the coarsest level of the AMG of the cpr pressure system on all processes and solve it on each of them, instead of iterating on the distributed coarsest level");
+            EWOMS_REGISTER_PARAM(TypeTag, std::string, Linsolver, "Configuration of solver. Valid options are: ilu0 (default), cpr (an alias for cpr_trueimpes), cpr_quasiimpes, cpr_trueimpes, cpr_msrsb (true IMPES CPR with a multiscale pressure solver for screening runs, sequential only), amg, ras (restricted additive Schwarz with ILU(n) on the local domain including the overlap cells, see --num-overlap), and autotune for openclSolver in sequential runs, which picks the fastest of its preconditioners on the first linear system and uses ilu0 on the CPU. Alternatively, you can request a configuration to be read from a JSON file by giving the filename here, ending with '.json.'");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, AcceleratorMode, "Use GPU (cusparseSolver or openclSolver) or FPGA (fpgaSolver) as the linear solver, usage: '--accelerator-mode=[none|cusparse|opencl|fpga|amgcl]'");
             EWOMS_REGISTER_PARAM(TypeTag, int, BdaDeviceId, "Choose device ID for cusparseSolver or openclSolver, use 'nvidia-smi' or 'clinfo' to determine valid IDs");
             EWOMS_REGISTER_PARAM(TypeTag, int, OpenclPlatformId, "Choose platform ID for openclSolver, use 'clinfo' to determine valid platform IDs");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, OpenclIluReorder, "Choose the reordering strategy for ILU for openclSolver and fpgaSolver, usage: '--opencl-ilu-reorder=[level_scheduling|graph_coloring], level_scheduling behaves like Dune and cusparse, graph_coloring is more aggressive and likely to be faster, but is random-based and generally increases the number of linear solves and linear iterations significantly.");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, OpenclAsyncUpload, "Start copying the reservoir matrix to the device for openclSolver or cusparseSolver while the well equations are linearized. Only used with --matrix-add-well-contributions=false, and for openclSolver with --opencl-ilu-reorder=none");
+            EWOMS_REGISTER_PARAM(TypeTag, std::string, OpenclAutotuneCache, "File in which openclSolver stores the preconditioner chosen by --linsolver=autotune for a sparsity pattern, such that a rerun of the same case does not try all preconditioners again. Empty to disable");
+            EWOMS_REGISTER_PARAM(TypeTag, std::string, OpenclProgramCache, "Directory in which openclSolver stores the compiled OpenCL kernels for the device and driver in use, such that later runs skip compiling them. Empty to disable");
+            EWOMS_REGISTER_PARAM(TypeTag, int, OpenclConvergenceCheckInterval, "Number of iterations of openclSolver between the convergence checks halfway through an iteration, which each wait for the device. The check at the end of every iteration comes without extra synchronization and is always done");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, OpenclSellFormat, "Let openclSolver do the sparse matrix-vector products of the iterations with a sliced ELLPACK (SELL-C-sigma) copy of the matrix, which helps on matrices with rows of very different lengths. The copy costs memory on the device and a gather after every upload of the matrix");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, OpenclIluFloat, "Let the ilu0 preconditioner of openclSolver apply its factors in single precision, for GPUs with a low double precision throughput. The factorization and the BiCGStab iterations stay in double precision");
+            EWOMS_REGISTER_PARAM(TypeTag, int, AmgclReuseSetup, "Reuse the amgcl preconditioner of amgclSolver, only the system matrix is updated. Valid options are 0: recreate the preconditioner for every linear solve, 1: recreate once every timestep, 2: recreate if last linear solve took more than 10 iterations, 3: never recreate");
+            EWOMS_REGISTER_PARAM(TypeTag, int, AmgclRebuildInterval, "Recreate the amgcl preconditioner of amgclSolver after it has been reused for this many linear solves, regardless of --amgcl-reuse-setup. 0 to disable");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, FpgaBitstream, "Specify the bitstream file for fpgaSolver (including path), usage: '--fpga-bitstream=<filename>'");
         }
 
@@ -328,8 +483,12 @@ namespace Opm
         {
             newton_use_gmres_        = false;
             linear_solver_reduction_ = 1e-2;
+            linear_solver_max_reduction_ = 0.0;
             linear_solver_maxiter_   = 150;
             linear_solver_restart_   = 40;
+            linear_solver_recycle_   = 0;
+            linear_solver_overlap_halo_exchange_ = false;
+            linear_solver_fallback_ = false;
             linear_solver_verbosity_ = 0;
             require_full_sparsity_pattern_ = false;
             ignoreConvergenceFailure_ = false;
@@ -338,10 +497,19 @@ namespace Opm
             ilu_milu_                 = MILU_VARIANT::ILU;
             ilu_redblack_             = false;
             ilu_reorder_sphere_       = true;
+            ilu_reorder_rcm_          = false;
             accelerator_mode_         = "none";
             bda_device_id_            = 0;
             opencl_platform_id_       = 0;
             opencl_ilu_reorder_       = "";  // note: the default value is chosen depending on the solver used
+            opencl_async_upload_      = false;
+            opencl_autotune_cache_    = "";
+            opencl_program_cache_     = "";
+            opencl_convergence_check_interval_ = 1;
+            opencl_sell_format_       = false;
+            opencl_ilu_float_         = false;
+            amgcl_reuse_setup_        = 0;
+            amgcl_rebuild_interval_   = 0;
             fpga_bitstream_           = "";
         }
     };
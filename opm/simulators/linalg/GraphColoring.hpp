@@ -242,5 +242,84 @@ reorderVerticesSpheres(const std::vector<int>& colors, int noColors,
     }
     return indices;
 }
+
+/// \brief Reverse Cuthill-McKee ordering of the first vertices of a graph.
+///
+/// Neighbouring vertices get close indices, which reduces the bandwidth of
+/// the matrix and improves the cache reuse of the ILU. Every connected
+/// component is started at a vertex of minimal degree. Only the vertices
+/// [0, noReordered) are reordered, the others, e.g. ghost rows, keep their
+/// index.
+/// \param graph The graph to reorder. Must adhere to the graph interface of dune-istl.
+/// \param noReordered The number of leading vertices to reorder.
+/// \return The new index of each vertex.
+template<class Graph>
+std::vector<std::size_t>
+reorderVerticesReverseCuthillMcKee(const Graph& graph, std::size_t noReordered)
+{
+    using Vertex = typename Graph::VertexDescriptor;
+    std::vector<std::size_t> degrees(noReordered, 0);
+    for(std::size_t vertex = 0; vertex < noReordered; ++vertex)
+    {
+        for(auto edge = graph.beginEdges(vertex), endEdge = graph.endEdges(vertex);
+            edge != endEdge; ++edge)
+        {
+            const std::size_t target = edge.target();
+            if ( target < noReordered && target != vertex )
+            {
+                ++degrees[vertex];
+            }
+        }
+    }
+    auto byDegree = [&degrees](const Vertex& v1, const Vertex& v2)
+        {
+            return degrees[v1] < degrees[v2];
+        };
+
+    std::vector<Vertex> roots(noReordered);
+    std::iota(roots.begin(), roots.end(), Vertex(0));
+    std::stable_sort(roots.begin(), roots.end(), byDegree);
+
+    std::vector<Vertex> order;
+    order.reserve(noReordered);
+    std::vector<char> visited(noReordered, false);
+    std::vector<Vertex> neighbours;
+    for(const auto root: roots)
+    {
+        if ( visited[root] )
+        {
+            continue;
+        }
+        visited[root] = true;
+        std::size_t head = order.size();
+        order.push_back(root);
+        // breadth first search visiting the neighbours by ascending degree
+        while ( head < order.size() )
+        {
+            const auto current = order[head++];
+            neighbours.clear();
+            for(auto edge = graph.beginEdges(current), endEdge = graph.endEdges(current);
+                edge != endEdge; ++edge)
+            {
+                const std::size_t target = edge.target();
+                if ( target < noReordered && !visited[target] )
+                {
+                    visited[target] = true;
+                    neighbours.push_back(target);
+                }
+            }
+            std::stable_sort(neighbours.begin(), neighbours.end(), byDegree);
+            order.insert(order.end(), neighbours.begin(), neighbours.end());
+        }
+    }
+
+    std::vector<std::size_t> indices(graph.maxVertex() + 1);
+    std::iota(indices.begin(), indices.end(), std::size_t(0));
+    for(std::size_t i = 0; i < noReordered; ++i)
+    {
+        indices[order[i]] = noReordered - 1 - i;
+    }
+    return indices;
+}
 } // end namespace Opm
 #endif
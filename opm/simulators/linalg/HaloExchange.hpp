@@ -0,0 +1,139 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_HALOEXCHANGE_HEADER_INCLUDED
+#define OPM_HALOEXCHANGE_HEADER_INCLUDED
+
+#if HAVE_MPI
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <mpi.h>
+#include <dune/common/enumset.hh>
+#include <dune/common/parallel/interface.hh>
+#include <dune/istl/owneroverlapcopy.hh>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// \brief Non-blocking copy of the owner values of a vector to all its copies.
+///
+/// Does the same as OwnerOverlapCopyCommunication::copyOwnerToAll(), but
+/// split into start() and finish(), such that work not depending on the
+/// values of the copies can be done while the messages are in flight.
+/// The send and receive lists of the neighbours are set up once.
+template <class X>
+class HaloExchange
+{
+public:
+    using block_type = typename X::block_type;
+
+    template <class Comm>
+    explicit HaloExchange(const Comm& comm)
+        : communicator_(comm.communicator())
+    {
+        using AttributeSet = Dune::OwnerOverlapCopyAttributeSet::AttributeSet;
+        using OwnerSet = Dune::EnumItem<AttributeSet, Dune::OwnerOverlapCopyAttributeSet::owner>;
+        using AllSet = Dune::AllSet<AttributeSet>;
+
+        Dune::Interface interface(communicator_);
+        interface.build(comm.remoteIndices(), OwnerSet(), AllSet());
+        for (const auto& [rank, info] : interface.interfaces()) {
+            Neighbour neighbour;
+            neighbour.rank = rank;
+            neighbour.send.resize(info.first.size());
+            for (std::size_t i = 0; i < info.first.size(); ++i) {
+                neighbour.send[i] = info.first[i];
+            }
+            neighbour.recv.resize(info.second.size());
+            for (std::size_t i = 0; i < info.second.size(); ++i) {
+                neighbour.recv[i] = info.second[i];
+            }
+            neighbour.sendBuffer.resize(neighbour.send.size());
+            neighbour.recvBuffer.resize(neighbour.recv.size());
+            neighbours_.push_back(std::move(neighbour));
+        }
+        requests_.reserve(2 * neighbours_.size());
+    }
+
+    /// Post the messages carrying the owner values of x.
+    void start(const X& x)
+    {
+        requests_.clear();
+        for (auto& neighbour : neighbours_) {
+            if (!neighbour.recv.empty()) {
+                requests_.emplace_back();
+                MPI_Irecv(neighbour.recvBuffer.data(),
+                          neighbour.recvBuffer.size() * sizeof(block_type), MPI_BYTE,
+                          neighbour.rank, tag, communicator_, &requests_.back());
+            }
+        }
+        for (auto& neighbour : neighbours_) {
+            if (!neighbour.send.empty()) {
+                for (std::size_t i = 0; i < neighbour.send.size(); ++i) {
+                    neighbour.sendBuffer[i] = x[neighbour.send[i]];
+                }
+                requests_.emplace_back();
+                MPI_Isend(neighbour.sendBuffer.data(),
+                          neighbour.sendBuffer.size() * sizeof(block_type), MPI_BYTE,
+                          neighbour.rank, tag, communicator_, &requests_.back());
+            }
+        }
+    }
+
+    /// Wait for the messages posted by start() and store the received
+    /// values in the copies of x.
+    void finish(X& x)
+    {
+        MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+        requests_.clear();
+        for (const auto& neighbour : neighbours_) {
+            for (std::size_t i = 0; i < neighbour.recv.size(); ++i) {
+                x[neighbour.recv[i]] = neighbour.recvBuffer[i];
+            }
+        }
+    }
+
+private:
+    struct Neighbour
+    {
+        int rank;
+        std::vector<std::size_t> send;
+        std::vector<std::size_t> recv;
+        std::vector<block_type> sendBuffer;
+        std::vector<block_type> recvBuffer;
+    };
+
+    // Distinct from the tags of the DUNE communicators.
+    static constexpr int tag = 7261;
+
+    MPI_Comm communicator_;
+    std::vector<Neighbour> neighbours_;
+    std::vector<MPI_Request> requests_;
+};
+
+} // namespace Opm
+
+#endif // HAVE_MPI
+
+#endif // OPM_HALOEXCHANGE_HEADER_INCLUDED
@@ -0,0 +1,276 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_HYPREPRECONDITIONER_HEADER_INCLUDED
+#define OPM_HYPREPRECONDITIONER_HEADER_INCLUDED
+
+#if HAVE_HYPRE && HAVE_MPI
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+
+#include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/paamg/pinfo.hh>
+
+#include <HYPRE.h>
+#include <HYPRE_parcsr_ls.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Opm
+{
+
+/// \brief One V-cycle of hypre's BoomerAMG as preconditioner of a scalar system.
+///
+/// Meant for the pressure system of CPR. The rows owned by this process
+/// (all rows in the sequential case) are numbered contiguously across the
+/// processes and handed to hypre, the result is copied to the overlap.
+/// The BoomerAMG options are read from the property tree: "coarsen_type"
+/// (default 8, PMIS), "interp_type" (6, extended+i), "relax_type" (8,
+/// l1 Gauss-Seidel), "strong_threshold" (0.5), "agg_num_levels" (0),
+/// "max_levels" (25) and "max_iter" (1).
+template <class Matrix, class X, class Comm>
+class HyprePreconditioner : public Dune::PreconditionerWithUpdate<X, X>
+{
+public:
+    static_assert(Matrix::block_type::rows == 1 && Matrix::block_type::cols == 1,
+                  "The hypre preconditioner is only implemented for scalar matrices.");
+
+    HyprePreconditioner(const Matrix& A, const PropertyTree& prm, const Comm& comm)
+        : A_(A)
+        , prm_(prm)
+        , comm_(comm)
+    {
+        initializeHypre();
+        setupIndices();
+        setup();
+    }
+
+    ~HyprePreconditioner() override
+    {
+        destroy();
+        HYPRE_IJVectorDestroy(b_);
+        HYPRE_IJVectorDestroy(x_);
+    }
+
+    void pre(X&, X&) override
+    {
+    }
+
+    void apply(X& v, const X& d) override
+    {
+        for (std::size_t i = 0; i < owned_.size(); ++i) {
+            values_[i] = d[owned_[i]][0];
+        }
+        HYPRE_IJVectorSetValues(b_, owned_.size(), rows_.data(), values_.data());
+        std::fill(values_.begin(), values_.end(), 0.0);
+        HYPRE_IJVectorSetValues(x_, owned_.size(), rows_.data(), values_.data());
+
+        HYPRE_BoomerAMGSolve(solver_, parA_, parB_, parX_);
+
+        HYPRE_IJVectorGetValues(x_, owned_.size(), rows_.data(), values_.data());
+        v = 0;
+        for (std::size_t i = 0; i < owned_.size(); ++i) {
+            v[owned_[i]][0] = values_[i];
+        }
+        if constexpr (!isSequential) {
+            comm_.copyOwnerToAll(v, v);
+        }
+    }
+
+    void post(X&) override
+    {
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return isSequential ? Dune::SolverCategory::sequential : Dune::SolverCategory::overlapping;
+    }
+
+    void update() override
+    {
+        destroy();
+        setup();
+    }
+
+private:
+    static constexpr bool isSequential = std::is_same_v<Comm, Dune::Amg::SequentialInformation>;
+
+    static void initializeHypre()
+    {
+#if HYPRE_RELEASE_NUMBER >= 22000
+        static const bool initialized = [] { HYPRE_Init(); return true; }();
+        static_cast<void>(initialized);
+#endif
+    }
+
+    MPI_Comm communicator() const
+    {
+        if constexpr (isSequential) {
+            return MPI_COMM_SELF;
+        } else {
+            return comm_.communicator();
+        }
+    }
+
+    /// Number the owned rows contiguously, starting after the rows of the
+    /// processes with lower rank, and find the numbers of the other columns.
+    void setupIndices()
+    {
+        const std::size_t n = A_.N();
+        HYPRE_BigInt offset = 0;
+        if constexpr (isSequential) {
+            for (std::size_t i = 0; i < n; ++i) {
+                owned_.push_back(i);
+            }
+        } else {
+            std::vector<bool> isOwned(n, false);
+            for (const auto& index : comm_.indexSet()) {
+                if (index.local().attribute() == Dune::OwnerOverlapCopyAttributeSet::owner) {
+                    isOwned[index.local().local()] = true;
+                }
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                if (isOwned[i]) {
+                    owned_.push_back(i);
+                }
+            }
+            const auto& cc = comm_.communicator();
+            std::vector<int> counts(cc.size());
+            const int numOwned = owned_.size();
+            cc.allgather(&numOwned, 1, counts.data());
+            for (int p = 0; p < cc.rank(); ++p) {
+                offset += counts[p];
+            }
+        }
+
+        // Numbers of all local indices, exchanged like a vector to get
+        // the numbers of the copies.
+        X numbers(n);
+        numbers = -1.0;
+        for (std::size_t i = 0; i < owned_.size(); ++i) {
+            numbers[owned_[i]][0] = offset + i;
+        }
+        if constexpr (!isSequential) {
+            comm_.copyOwnerToAll(numbers, numbers);
+        }
+        columnNumbers_.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            columnNumbers_[i] = static_cast<HYPRE_BigInt>(numbers[i][0]);
+        }
+
+        ilower_ = offset;
+        iupper_ = offset + static_cast<HYPRE_BigInt>(owned_.size()) - 1;
+        rows_.resize(owned_.size());
+        for (std::size_t i = 0; i < owned_.size(); ++i) {
+            rows_[i] = offset + i;
+        }
+        values_.resize(owned_.size());
+
+        createVector(b_, parB_);
+        createVector(x_, parX_);
+    }
+
+    void createVector(HYPRE_IJVector& v, HYPRE_ParVector& par)
+    {
+        HYPRE_IJVectorCreate(communicator(), ilower_, iupper_, &v);
+        HYPRE_IJVectorSetObjectType(v, HYPRE_PARCSR);
+        HYPRE_IJVectorInitialize(v);
+        HYPRE_IJVectorAssemble(v);
+        HYPRE_IJVectorGetObject(v, reinterpret_cast<void**>(&par));
+    }
+
+    /// Copy the owned rows to hypre and set up BoomerAMG.
+    void setup()
+    {
+        HYPRE_IJMatrixCreate(communicator(), ilower_, iupper_, ilower_, iupper_, &ijA_);
+        HYPRE_IJMatrixSetObjectType(ijA_, HYPRE_PARCSR);
+        HYPRE_IJMatrixInitialize(ijA_);
+        std::vector<HYPRE_BigInt> cols;
+        std::vector<HYPRE_Real> vals;
+        for (std::size_t i = 0; i < owned_.size(); ++i) {
+            const auto& row = A_[owned_[i]];
+            cols.clear();
+            vals.clear();
+            for (auto col = row.begin(), cend = row.end(); col != cend; ++col) {
+                const auto number = columnNumbers_[col.index()];
+                if (number < 0) {
+                    OPM_THROW(std::logic_error, "hypre preconditioner: column " << col.index()
+                              << " has no owner");
+                }
+                cols.push_back(number);
+                vals.push_back((*col)[0][0]);
+            }
+            HYPRE_Int ncols = cols.size();
+            HYPRE_IJMatrixSetValues(ijA_, 1, &ncols, &rows_[i], cols.data(), vals.data());
+        }
+        HYPRE_IJMatrixAssemble(ijA_);
+        HYPRE_IJMatrixGetObject(ijA_, reinterpret_cast<void**>(&parA_));
+
+        HYPRE_BoomerAMGCreate(&solver_);
+        HYPRE_BoomerAMGSetPrintLevel(solver_, 0);
+        HYPRE_BoomerAMGSetCoarsenType(solver_, prm_.get<int>("coarsen_type", 8));
+        HYPRE_BoomerAMGSetInterpType(solver_, prm_.get<int>("interp_type", 6));
+        HYPRE_BoomerAMGSetRelaxType(solver_, prm_.get<int>("relax_type", 8));
+        HYPRE_BoomerAMGSetStrongThreshold(solver_, prm_.get<double>("strong_threshold", 0.5));
+        HYPRE_BoomerAMGSetAggNumLevels(solver_, prm_.get<int>("agg_num_levels", 0));
+        HYPRE_BoomerAMGSetMaxLevels(solver_, prm_.get<int>("max_levels", 25));
+        HYPRE_BoomerAMGSetMaxIter(solver_, prm_.get<int>("max_iter", 1));
+        HYPRE_BoomerAMGSetTol(solver_, 0.0);
+        HYPRE_BoomerAMGSetup(solver_, parA_, parB_, parX_);
+    }
+
+    void destroy()
+    {
+        HYPRE_BoomerAMGDestroy(solver_);
+        HYPRE_IJMatrixDestroy(ijA_);
+    }
+
+    const Matrix& A_;
+    PropertyTree prm_;
+    // The sequential information is stateless and may be a temporary.
+    std::conditional_t<isSequential, Comm, const Comm&> comm_;
+
+    std::vector<std::size_t> owned_;
+    std::vector<HYPRE_BigInt> columnNumbers_;
+    std::vector<HYPRE_BigInt> rows_;
+    std::vector<HYPRE_Real> values_;
+    HYPRE_BigInt ilower_ = 0;
+    HYPRE_BigInt iupper_ = -1;
+
+    HYPRE_Solver solver_;
+    HYPRE_IJMatrix ijA_;
+    HYPRE_ParCSRMatrix parA_;
+    HYPRE_IJVector b_;
+    HYPRE_IJVector x_;
+    HYPRE_ParVector parB_;
+    HYPRE_ParVector parX_;
+};
+
+} // namespace Opm
+
+#endif // HAVE_HYPRE && HAVE_MPI
+
+#endif // OPM_HYPREPRECONDITIONER_HEADER_INCLUDED
@@ -33,6 +33,14 @@
 #include <opm/simulators/linalg/findOverlapRowsAndColumns.hpp>
 #include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
 #include <opm/simulators/linalg/setupPropertyTree.hpp>
+#include <opm/simulators/utils/MemoryRegistry.hpp>
+#include <opm/simulators/utils/NumaFirstTouch.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
+
+#include <dune/common/timer.hh>
+
+#include <algorithm>
+#include <cmath>
 
 #if HAVE_CUDA || HAVE_OPENCL || HAVE_FPGA || HAVE_AMGCL
 #include <opm/simulators/linalg/bda/BdaBridge.hpp>
@@ -119,7 +127,7 @@ namespace Opm
             : simulator_(simulator),
               iterations_( 0 ),
               converged_(false),
-              matrix_()
+              matrix_(nullptr)
         {
             const bool on_io_rank = (simulator.gridView().comm().rank() == 0);
 #if HAVE_MPI
@@ -129,25 +137,64 @@ namespace Opm
             prm_ = setupPropertyTree(parameters_,
                                      EWOMS_PARAM_IS_SET(TypeTag, int, LinearSolverMaxIter),
                                      EWOMS_PARAM_IS_SET(TypeTag, int, CprMaxEllIter));
+            for (int i = 1; ; ++i) {
+                auto fallback = prm_.get_child_optional("fallback." + std::to_string(i));
+                if (!fallback) {
+                    break;
+                }
+                fallbacks_.push_back(*fallback);
+            }
 
 #if HAVE_CUDA || HAVE_OPENCL || HAVE_FPGA || HAVE_AMGCL
             {
                 std::string accelerator_mode = EWOMS_GET_PARAM(TypeTag, std::string, AcceleratorMode);
-                if ((simulator_.vanguard().grid().comm().size() > 1) && (accelerator_mode != "none")) {
-                    if (on_io_rank) {
-                        OpmLog::warning("Cannot use GPU or FPGA with MPI, GPU/FPGA are disabled");
+                int deviceID = EWOMS_GET_PARAM(TypeTag, int, BdaDeviceId);
+                std::string opencl_ilu_reorder = EWOMS_GET_PARAM(TypeTag, std::string, OpenclIluReorder);
+                const auto& gridComm = simulator_.vanguard().grid().comm();
+                if ((gridComm.size() > 1) && (accelerator_mode != "none")) {
+                    // Each process solves its part of the system on its own device, driven by the
+                    // openclSolver, or together with the other processes by amgcl::mpi. The wells
+                    // must be part of the matrix, since the halo exchange is only done for the
+                    // reservoir unknowns.
+                    if ((accelerator_mode != "opencl" && accelerator_mode != "amgcl")
+                        || !EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions)) {
+                        if (on_io_rank) {
+                            OpmLog::warning("With MPI only the opencl and amgcl accelerators with --matrix-add-well-contributions=true are supported, GPU/FPGA are disabled");
+                        }
+                        accelerator_mode = "none";
+                    } else if (accelerator_mode == "opencl") {
+                        if (on_io_rank && !opencl_ilu_reorder.empty() && opencl_ilu_reorder != "none") {
+                            OpmLog::warning("With MPI the opencl accelerator does not reorder the matrix, --opencl-ilu-reorder is ignored");
+                        }
+                        opencl_ilu_reorder = "none";
+#if HAVE_MPI
+                        // processes sharing a node use consecutive devices
+                        MPI_Comm nodeComm;
+                        MPI_Comm_split_type(gridComm, MPI_COMM_TYPE_SHARED, gridComm.rank(), MPI_INFO_NULL, &nodeComm);
+                        int nodeRank = 0;
+                        MPI_Comm_rank(nodeComm, &nodeRank);
+                        MPI_Comm_free(&nodeComm);
+                        deviceID += nodeRank;
+#endif
                     }
-                    accelerator_mode = "none";
                 }
                 const int platformID = EWOMS_GET_PARAM(TypeTag, int, OpenclPlatformId);
-                const int deviceID = EWOMS_GET_PARAM(TypeTag, int, BdaDeviceId);
                 const int maxit = EWOMS_GET_PARAM(TypeTag, int, LinearSolverMaxIter);
                 const double tolerance = EWOMS_GET_PARAM(TypeTag, double, LinearSolverReduction);
-                const std::string opencl_ilu_reorder = EWOMS_GET_PARAM(TypeTag, std::string, OpenclIluReorder);
                 const int linear_solver_verbosity = parameters_.linear_solver_verbosity_;
                 std::string fpga_bitstream = EWOMS_GET_PARAM(TypeTag, std::string, FpgaBitstream);
                 std::string linsolver = EWOMS_GET_PARAM(TypeTag, std::string, Linsolver);
-                bdaBridge.reset(new BdaBridge<Matrix, Vector, block_size>(accelerator_mode, fpga_bitstream, linear_solver_verbosity, maxit, tolerance, platformID, deviceID, opencl_ilu_reorder, linsolver));
+                bdaBridge.reset(new BdaBridge<Matrix, Vector, block_size>(accelerator_mode, fpga_bitstream, linear_solver_verbosity, maxit, tolerance, platformID, deviceID, opencl_ilu_reorder, linsolver, parameters_.opencl_program_cache_));
+                bdaBridge->setAutotuneCache(parameters_.opencl_autotune_cache_);
+                bdaBridge->setConvergenceCheckInterval(parameters_.opencl_convergence_check_interval_);
+                bdaBridge->setSellFormat(parameters_.opencl_sell_format_);
+                bdaBridge->setIluFloatFactors(parameters_.opencl_ilu_float_);
+                bdaBridge->setAmgclReuse(parameters_.amgcl_reuse_setup_, parameters_.amgcl_rebuild_interval_);
+                // the matrix is final after the domain linearization if neither the wells
+                // nor the reordering change it
+                asyncUpload_ = parameters_.opencl_async_upload_
+                    && ((accelerator_mode == "opencl" && opencl_ilu_reorder == "none") || accelerator_mode == "cusparse")
+                    && !EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
             }
 #else
             if (EWOMS_GET_PARAM(TypeTag, std::string, AcceleratorMode) != "none") {
@@ -180,6 +227,29 @@ namespace Opm
 
             interiorCellNum_ = detail::numMatrixRowsToUseInSolver(simulator_.vanguard().grid(), true);
 
+            // The operator can only take over the halo exchange of the preconditioner
+            // if every result of the preconditioner is passed through the operator.
+            if (parameters_.linear_solver_overlap_halo_exchange_ && isParallel()) {
+                const auto precType = prm_.get<std::string>("preconditioner.type", "");
+                if (!useWellConn_ && prm_.get<std::string>("solver", "") == "bicgstab"
+                    && (precType == "ParOverILU0" || precType == "ILU0" || precType == "ILUn")) {
+                    prm_.put("preconditioner.exchange_result", false);
+                    overlapHaloExchange_ = true;
+                } else if (on_io_rank) {
+                    OpmLog::warning("--linear-solver-overlap-halo-exchange is only supported with bicgstab, "
+                                    "an ILU preconditioner and --matrix-add-well-contributions=false, it is ignored");
+                }
+            }
+
+#if (HAVE_OPENCL || HAVE_AMGCL) && HAVE_MPI
+            if (isParallel() && bdaBridge->getUseGpu()) {
+                bdaBridge->setParallelInfo(interiorCellNum_,
+                                           [this](Vector& v) { comm_->copyOwnerToAll(v, v); },
+                                           [this](double v) { return comm_->communicator().sum(v); });
+                bdaBridge->setMpiCommunicator(comm_->communicator());
+            }
+#endif
+
             // Print parameters to PRT/DBG logs.
             if (on_io_rank) {
                 std::ostringstream os;
@@ -195,7 +265,7 @@ namespace Opm
 
         void prepare(const SparseMatrixAdapter& M, Vector& b)
         {
-            static bool firstcall = true;
+            const bool firstcall = (matrix_ == nullptr);
 #if HAVE_MPI
             if (firstcall && parallelInformation_.type() == typeid(ParallelISTLInformation)) {
                 // Parallel case.
@@ -212,6 +282,16 @@ namespace Opm
                 // to the original one with a deleter that does nothing.
                 // Outch! We need to be able to scale the linear system! Hence const_cast
                 matrix_ = const_cast<Matrix*>(&M.istlMatrix());
+                jacobianMemory_.set(matrixMemoryBytes(*matrix_));
+                if (simulator_.problem().numaFirstTouch()) {
+                    // The threaded products apply the rows with a static schedule,
+                    // but the master thread allocated them.
+                    const bool hugePages = simulator_.problem().hugePages();
+                    if (!firstTouchMatrix(*matrix_, hugePages)) {
+                        OpmLog::debug("The Jacobian is not stored in row order, it keeps its NUMA placement.");
+                    }
+                    firstTouchVector(b, hugePages);
+                }
             } else {
                 // Pointers should not change
                 if ( &(M.istlMatrix()) != matrix_ ) {
@@ -221,14 +301,30 @@ namespace Opm
             }
             rhs_ = &b;
 
-            if (isParallel() && prm_.get<std::string>("preconditioner.type") != "ParOverILU0") {
+            // The overlap rows are kept as assembled by the preconditioners
+            // solving on the whole local domain.
+            const auto precType = prm_.get<std::string>("preconditioner.type");
+            if (isParallel() && ((precType != "ParOverILU0" && precType != "RAS") || useAcceleratorInParallel())) {
                 makeOverlapRowsInvalid(getMatrix());
             }
             prepareFlexibleSolver();
-            firstcall = false;
         }
 
 
+        /// Start copying the matrix to the accelerator while the rest of the
+        /// system (wells, convergence check) is still being processed.
+        /// Does nothing unless --opencl-async-upload is used.
+        void prefetchMatrix(const SparseMatrixAdapter& M)
+        {
+#if HAVE_OPENCL || HAVE_CUDA
+            if (asyncUpload_) {
+                bdaBridge->prefetch_matrix(const_cast<Matrix*>(&M.istlMatrix()));
+            }
+#else
+            static_cast<void>(M);
+#endif
+        }
+
         void setResidual(Vector& /* b */) {
             // rhs_ = &b; // Must be handled in prepare() instead.
         }
@@ -242,6 +338,7 @@ namespace Opm
         }
 
         bool solve(Vector& x) {
+            ScopedTimer solveTimer(TimingRegistry::Region::LinearSolve);
             // Write linear system if asked for.
             const int verbosity = prm_.get<int>("verbosity", 0);
             const bool write_matrix = verbosity > 10;
@@ -273,6 +370,11 @@ namespace Opm
                 }
 #endif
 
+                // the amgcl hierarchy is rebuilt on the first Newton iteration of every timestep
+                if (parameters_.amgcl_reuse_setup_ == 1 && simulator_.model().newtonMethod().numIterations() == 0) {
+                    bdaBridge->forceAmgclRebuild();
+                }
+
                 // Const_cast needed since the CUDA stuff overwrites values for better matrix condition..
                 bdaBridge->solve_system(const_cast<Matrix*>(&getMatrix()), *rhs_, *wellContribs, result);
                 if (result.converged) {
@@ -294,7 +396,24 @@ namespace Opm
             // Otherwise, use flexible istl solver.
             if (!accelerator_was_used) {
                 assert(flexibleSolver_);
-                flexibleSolver_->apply(x, *rhs_, result);
+                // The solvers overwrite the right hand side with the residual.
+                if (!fallbacks_.empty()) {
+                    fallbackX_ = x;
+                    fallbackRhs_ = *rhs_;
+                }
+                Dune::Timer perfTimer;
+                perfTimer.start();
+                const double reduction = adaptiveReduction()
+                    ? reduction_ : prm_.get<double>("tol", parameters_.linear_solver_reduction_);
+                if (adaptiveReduction()) {
+                    flexibleSolver_->applyFromInitialGuess(x, *rhs_, reduction_, result);
+                } else {
+                    flexibleSolver_->applyFromInitialGuess(x, *rhs_, result);
+                }
+                recordSolveCost(result.iterations, reduction, perfTimer.stop());
+                if (!result.converged && !fallbacks_.empty()) {
+                    solveWithFallbacks(x, result);
+                }
             }
 
             // Check convergence, iterations etc.
@@ -313,6 +432,36 @@ namespace Opm
         /// \copydoc NewtonIterationBlackoilInterface::iterations
         int iterations () const { return iterations_; }
 
+        /// Choose the residual reduction of the next linear solve from the
+        /// progress of the Newton iterations, following choice 2 of Eisenstat
+        /// and Walker. The reduction is loose while the nonlinear residual
+        /// decreases slowly, and tightens as the iterations converge. It has no
+        /// effect unless --linear-solver-max-reduction exceeds the configured
+        /// reduction of the linear solver.
+        /// \param[in] iteration   Newton iteration of the time step
+        /// \param[in] norm        norm of the nonlinear residual at this iteration
+        void setNonlinearResidual(const int iteration, const double norm)
+        {
+            if (!adaptiveReduction()) {
+                return;
+            }
+            const double min_reduction = prm_.get<double>("tol", parameters_.linear_solver_reduction_);
+            const double max_reduction = parameters_.linear_solver_max_reduction_;
+            constexpr double gamma = 0.9;
+            double reduction = max_reduction;
+            if (iteration > 0 && lastNonlinearResidual_ > 0.0) {
+                const double ratio = norm / lastNonlinearResidual_;
+                reduction = gamma * ratio * ratio;
+                // Do not tighten too fast while the forcing terms are still large.
+                const double safeguard = gamma * reduction_ * reduction_;
+                if (safeguard > 0.1) {
+                    reduction = std::max(reduction, safeguard);
+                }
+            }
+            reduction_ = std::clamp(reduction, min_reduction, max_reduction);
+            lastNonlinearResidual_ = norm;
+        }
+
         /// \copydoc NewtonIterationBlackoilInterface::parallelInformation
         const std::any& parallelInformation() const { return parallelInformation_; }
 
@@ -332,6 +481,11 @@ namespace Opm
         typedef ParallelOverlappingILU0<Matrix,Vector,Vector,Comm> ParPreconditioner;
 #endif
 
+        bool adaptiveReduction() const
+        {
+            return parameters_.linear_solver_max_reduction_ > prm_.get<double>("tol", parameters_.linear_solver_reduction_);
+        }
+
         void checkConvergence( const Dune::InverseOperatorResult& result ) const
         {
             // store number of iterations
@@ -346,6 +500,15 @@ namespace Opm
         }
     protected:
 
+        /// Whether each process solves its part of the system on its own device.
+        bool useAcceleratorInParallel() const {
+#if (HAVE_OPENCL || HAVE_AMGCL) && HAVE_MPI
+            return isParallel() && bdaBridge->getUseGpu();
+#else
+            return false;
+#endif
+        }
+
         bool isParallel() const {
 #if HAVE_MPI
             return comm_->communicator().size() > 1;
@@ -354,45 +517,141 @@ namespace Opm
 #endif
         }
 
-        void prepareFlexibleSolver()
+        /// Retry a failed linear solve with the fallback configurations in
+        /// turn, from the same initial guess, until one of them converges.
+        /// A direct solver only sees the matrix, it is skipped unless the wells
+        /// are part of the matrix, and for parallel or large systems.
+        void solveWithFallbacks(Vector& x, Dune::InverseOperatorResult& result)
+        {
+            const bool on_io_rank = simulator_.gridView().comm().rank() == 0;
+            int iterations = result.iterations;
+            for (std::size_t i = 0; i < fallbacks_.size() && !result.converged; ++i) {
+                const auto& prm = fallbacks_[i];
+                if (prm.get<std::string>("solver", "") == "umfpack"
+                    && (isParallel() || !useWellConn_
+                        || getMatrix().N() > static_cast<std::size_t>(prm.get<int>("max_rows", 50000)))) {
+                    continue;
+                }
+                if (on_io_rank) {
+                    OpmLog::debug("Linear solver did not converge, retrying with fallback configuration "
+                                  + std::to_string(i + 1));
+                }
+                auto solver = createFlexibleSolver(prm);
+                x = fallbackX_;
+                Vector rhs(fallbackRhs_);
+                solver->applyFromInitialGuess(x, rhs, result);
+                iterations += result.iterations;
+            }
+            result.iterations = iterations;
+        }
+
+        /// Create a flexible solver for the configuration prm.
+        std::unique_ptr<FlexibleSolverType> createFlexibleSolver(const PropertyTree& prm)
         {
+            if (!linearOperatorForFlexibleSolver_) {
+                createLinearOperator();
+            }
+            std::function<Vector()> weightsCalculator = getWeightsCalculator(prm);
+#if HAVE_MPI
+            if (isParallel()) {
+                return std::make_unique<FlexibleSolverType>(*linearOperatorForFlexibleSolver_, *comm_, prm, weightsCalculator,
+                                                            pressureIndex);
+            }
+#endif
+            return std::make_unique<FlexibleSolverType>(*linearOperatorForFlexibleSolver_, prm, weightsCalculator,
+                                                        pressureIndex);
+        }
 
-            std::function<Vector()> weightsCalculator = getWeightsCalculator();
+        void prepareFlexibleSolver()
+        {
+            ScopedTimer setupTimer(TimingRegistry::Region::LinearSolverSetup);
 
+            Dune::Timer perfTimer;
+            perfTimer.start();
             if (shouldCreateSolver()) {
-                if (isParallel()) {
+                // The operators only refer to the matrix and the well model, which
+                // both stay the same objects during the whole simulation.
+                // Keep the recycled solutions, the system is still the same.
+                std::vector<Vector> recycledSolutions;
+                if (flexibleSolver_) {
+                    recycledSolutions = flexibleSolver_->releaseRecycledSolutions();
+                    flexibleSolver_.reset();
+                }
+                // The solver is mostly the preconditioner, which allocates
+                // in many places, hence its size is the largest growth of
+                // the resident memory while it is created.
+                const auto residentBefore = MemoryRegistry::residentBytes();
+                flexibleSolver_ = createFlexibleSolver(prm_);
+                const auto residentAfter = MemoryRegistry::residentBytes();
+                if (residentAfter > residentBefore + preconditionerMemory_.bytes()) {
+                    preconditionerMemory_.set(residentAfter - residentBefore);
+                }
+                flexibleSolver_->setRecycledSolutions(std::move(recycledSolutions));
+                setupCost_.time = perfTimer.stop();
+                setupCost_.iterationsPerDecade = -1.0;
+                setupCost_.extraCost = 0.0;
+            }
+            else
+            {
+                flexibleSolver_->preconditioner().update();
+            }
+        }
+
+        /// Create the linear operator used by the flexible solver.
+        void createLinearOperator()
+        {
+            if (isParallel()) {
 #if HAVE_MPI
-                    if (useWellConn_) {
-                        using ParOperatorType = Dune::OverlappingSchwarzOperator<Matrix, Vector, Vector, Comm>;
-                        linearOperatorForFlexibleSolver_ = std::make_unique<ParOperatorType>(getMatrix(), *comm_);
-                        flexibleSolver_ = std::make_unique<FlexibleSolverType>(*linearOperatorForFlexibleSolver_, *comm_, prm_, weightsCalculator,
-                                                                               pressureIndex);
+                if (useWellConn_) {
+                    using ParOperatorType = Dune::OverlappingSchwarzOperator<Matrix, Vector, Vector, Comm>;
+                    linearOperatorForFlexibleSolver_ = std::make_unique<ParOperatorType>(getMatrix(), *comm_);
+                } else {
+                    using ParOperatorType = WellModelGhostLastMatrixAdapter<Matrix, Vector, Vector, true>;
+                    wellOperator_ = std::make_unique<WellModelOperator>(simulator_.problem().wellModel());
+                    if (overlapHaloExchange_) {
+                        // The index set of comm_ is complete after the first prepare() and does not change.
+                        if (!haloExchange_) {
+                            haloExchange_ = std::make_shared<typename ParOperatorType::halo_exchange_type>(*comm_);
+                        }
+                        linearOperatorForFlexibleSolver_ = std::make_unique<ParOperatorType>(getMatrix(), *wellOperator_,
+                                                                                             interiorCellNum_, haloExchange_);
                     } else {
-                        using ParOperatorType = WellModelGhostLastMatrixAdapter<Matrix, Vector, Vector, true>;
-                        wellOperator_ = std::make_unique<WellModelOperator>(simulator_.problem().wellModel());
                         linearOperatorForFlexibleSolver_ = std::make_unique<ParOperatorType>(getMatrix(), *wellOperator_, interiorCellNum_);
-                        flexibleSolver_ = std::make_unique<FlexibleSolverType>(*linearOperatorForFlexibleSolver_, *comm_, prm_, weightsCalculator,
-                                                                               pressureIndex);
                     }
+                }
 #endif
+            } else {
+                if (useWellConn_) {
+                    using SeqOperatorType = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+                    linearOperatorForFlexibleSolver_ = std::make_unique<SeqOperatorType>(getMatrix());
                 } else {
-                    if (useWellConn_) {
-                        using SeqOperatorType = Dune::MatrixAdapter<Matrix, Vector, Vector>;
-                        linearOperatorForFlexibleSolver_ = std::make_unique<SeqOperatorType>(getMatrix());
-                        flexibleSolver_ = std::make_unique<FlexibleSolverType>(*linearOperatorForFlexibleSolver_, prm_, weightsCalculator,
-                                                                               pressureIndex);
-                    } else {
-                        using SeqOperatorType = WellModelMatrixAdapter<Matrix, Vector, Vector, false>;
-                        wellOperator_ = std::make_unique<WellModelOperator>(simulator_.problem().wellModel());
-                        linearOperatorForFlexibleSolver_ = std::make_unique<SeqOperatorType>(getMatrix(), *wellOperator_);
-                        flexibleSolver_ = std::make_unique<FlexibleSolverType>(*linearOperatorForFlexibleSolver_, prm_, weightsCalculator,
-                                                                               pressureIndex);
-                    }
+                    using SeqOperatorType = WellModelMatrixAdapter<Matrix, Vector, Vector, false>;
+                    wellOperator_ = std::make_unique<WellModelOperator>(simulator_.problem().wellModel());
+                    linearOperatorForFlexibleSolver_ = std::make_unique<SeqOperatorType>(getMatrix(), *wellOperator_);
                 }
             }
-            else
-            {
-                flexibleSolver_->preconditioner().update();
+        }
+
+
+        /// Record the cost of a linear solve with the current preconditioner
+        /// setup, as needed by the adaptive reuse policy. The solves may
+        /// ask for different residual reductions, see setNonlinearResidual(),
+        /// hence the iterations are compared per decade of reduction.
+        void recordSolveCost(const int iterations, const double reduction, const double solveTime)
+        {
+            const double decades = -std::log10(reduction);
+            if (iterations <= 0 || !(decades > 0.0)) {
+                return;
+            }
+            if (setupCost_.iterationsPerDecade < 0.0) {
+                // First solve after a setup, which is the baseline for later solves.
+                setupCost_.iterationsPerDecade = iterations / decades;
+                setupCost_.timePerIteration = solveTime / iterations;
+                return;
+            }
+            const double extraIterations = iterations - setupCost_.iterationsPerDecade * decades;
+            if (extraIterations > 0.0) {
+                setupCost_.extraCost += extraIterations * setupCost_.timePerIteration;
             }
         }
 
@@ -420,6 +679,13 @@ namespace Opm
                 return this->iterations() > 10;
             }
 
+            if (this->parameters_.cpr_reuse_setup_ == 4) {
+                // Recreate solver once the time spent on linear iterations beyond
+                // those needed right after the last setup exceeds the setup time,
+                // i.e., when a fresh setup is expected to pay for itself.
+                return setupCost_.extraCost > setupCost_.time;
+            }
+
             // Otherwise, do not recreate solver.
             assert(this->parameters_.cpr_reuse_setup_ == 3);
 
@@ -428,16 +694,16 @@ namespace Opm
 
 
         /// Return an appropriate weight function if a cpr preconditioner is asked for.
-        std::function<Vector()> getWeightsCalculator() const
+        std::function<Vector()> getWeightsCalculator(const PropertyTree& prm) const
         {
             std::function<Vector()> weightsCalculator;
 
             using namespace std::string_literals;
 
-            auto preconditionerType = prm_.get("preconditioner.type"s, "cpr"s);
+            auto preconditionerType = prm.get("preconditioner.type"s, "cpr"s);
             if (preconditionerType == "cpr" || preconditionerType == "cprt") {
                 const bool transpose = preconditionerType == "cprt";
-                const auto weightsType = prm_.get("preconditioner.weight_type"s, "quasiimpes"s);
+                const auto weightsType = prm.get("preconditioner.weight_type"s, "quasiimpes"s);
                 if (weightsType == "quasiimpes") {
                     // weights will be created as default in the solver
                     // assignment p = pressureIndex prevent compiler warning about
@@ -467,17 +733,14 @@ namespace Opm
         Vector getTrueImpesWeights(int pressureVarIndex) const
         {
             Vector weights(rhs_->size());
-            ElementContext elemCtx(simulator_);
-            Amg::getTrueImpesWeights(pressureVarIndex, weights, simulator_.vanguard().gridView(),
-                                     elemCtx, simulator_.model(),
-                                     ThreadManager::threadId());
+            Amg::getTrueImpesWeights<ElementContext>(pressureVarIndex, weights, simulator_);
             return weights;
         }
 
 
         /// Zero out off-diagonal blocks on rows corresponding to overlap cells
         /// Diagonal blocks on ovelap rows are set to diag(1.0).
-        void makeOverlapRowsInvalid(Matrix& matrix) const
+        void makeOverlapRowsInvalid(Matrix& matrix)
         {
             //value to set on diagonal
             const int numEq = Matrix::block_type::rows;
@@ -485,15 +748,24 @@ namespace Opm
             for (int eq = 0; eq < numEq; ++eq)
                 diag_block[eq][eq] = 1.0;
 
+            // The sparsity pattern never changes, hence the location of the
+            // diagonal blocks is looked up only once.
+            if (overlapRowDiagonals_.size() != overlapRows_.size()) {
+                overlapRowDiagonals_.clear();
+                overlapRowDiagonals_.reserve(overlapRows_.size());
+                for (const int lcell : overlapRows_) {
+                    overlapRowDiagonals_.push_back(&matrix[lcell][lcell]);
+                }
+            }
+
             //loop over precalculated overlap rows and columns
-            for (auto row = overlapRows_.begin(); row != overlapRows_.end(); row++ )
+            for (std::size_t i = 0; i < overlapRows_.size(); ++i)
                 {
-                    int lcell = *row;
                     // Zero out row.
-                    matrix[lcell] = 0.0;
+                    matrix[overlapRows_[i]] = 0.0;
 
                     //diagonal block set to diag(1.0).
-                    matrix[lcell][lcell] = diag_block;
+                    *overlapRowDiagonals_[i] = diag_block;
                 }
         }
 
@@ -520,15 +792,44 @@ namespace Opm
         std::unique_ptr<FlexibleSolverType> flexibleSolver_;
         std::unique_ptr<AbstractOperatorType> linearOperatorForFlexibleSolver_;
         std::unique_ptr<WellModelAsLinearOperator<WellModel, Vector, Vector>> wellOperator_;
+        MemoryAccount jacobianMemory_{MemoryRegistry::Owner::Jacobian};
+        MemoryAccount preconditionerMemory_{MemoryRegistry::Owner::Preconditioner};
         std::vector<int> overlapRows_;
+        std::vector<typename Matrix::block_type*> overlapRowDiagonals_;
         std::vector<int> interiorRows_;
         std::vector<std::set<int>> wellConnectionsGraph_;
 
         bool useWellConn_;
+        bool asyncUpload_ = false;
         size_t interiorCellNum_;
+        bool overlapHaloExchange_ = false;
+#if HAVE_MPI
+        std::shared_ptr<HaloExchange<Vector>> haloExchange_;
+#endif
+
+        /// Measured cost of the current preconditioner setup, used by the
+        /// adaptive reuse policy.
+        struct SetupCost
+        {
+            double time = 0.0; //!< Time of the last full setup.
+            double iterationsPerDecade = -1.0; //!< Iterations per decade of residual reduction of the first solve after the setup.
+            double timePerIteration = 0.0; //!< Time per iteration of that solve.
+            double extraCost = 0.0; //!< Accumulated time of additional iterations since.
+        };
+        SetupCost setupCost_;
+
+        // Residual reduction of the next linear solve and the nonlinear
+        // residual it was chosen from, see setNonlinearResidual().
+        double reduction_ = 1.0;
+        double lastNonlinearResidual_ = 0.0;
 
         FlowLinearSolverParameters parameters_;
         PropertyTree prm_;
+        // Configurations tried in turn when a linear solve fails, and the
+        // initial guess and right hand side they start from.
+        std::vector<PropertyTree> fallbacks_;
+        Vector fallbackX_;
+        Vector fallbackRhs_;
         bool scale_variables_;
 
         std::shared_ptr< CommunicationType > comm_;
@@ -0,0 +1,468 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MSRSBPRECONDITIONER_HEADER_INCLUDED
+#define OPM_MSRSBPRECONDITIONER_HEADER_INCLUDED
+
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/solvers.hh>
+#if HAVE_SUITESPARSE_UMFPACK
+#include <dune/istl/umfpack.hh>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <queue>
+#include <vector>
+
+namespace Opm
+{
+
+/// \brief Two-level preconditioner of a scalar system with the basis
+/// functions of the multiscale restriction-smoothed basis (MsRSB) method.
+///
+/// Meant for the pressure system of CPR in screening runs. The cells are
+/// grouped into coarse blocks of about "coarse_size" (default 64) cells,
+/// which are grown by a breadth-first search over the matrix graph. The
+/// basis function of a block starts as the indicator of the block and is
+/// smoothed by damped Jacobi iterations, "relaxation" (2/3), restricted to
+/// the block and its neighbouring blocks. After each iteration the basis
+/// functions are scaled to a partition of unity. The smoothing stops after
+/// "basis_iterations" (50) iterations or when no value changes by more than
+/// "basis_tolerance" (1e-3). The coarse system is the Galerkin product of
+/// the basis functions and the matrix, and is solved with UMFPack if
+/// available. The coarse correction is surrounded by "pre_smooth" (1) and
+/// "post_smooth" (1) ILU0 sweeps on the fine residual.
+///
+/// update() continues the smoothing from the basis functions of the previous
+/// matrix, which only needs a few iterations while the matrix changes slowly.
+template <class Matrix, class Vector>
+class MsrsbPreconditioner : public Dune::PreconditionerWithUpdate<Vector, Vector>
+{
+public:
+    static_assert(Matrix::block_type::rows == 1 && Matrix::block_type::cols == 1,
+                  "The multiscale preconditioner is only implemented for scalar matrices.");
+
+    MsrsbPreconditioner(const Matrix& A, const PropertyTree& prm)
+        : A_(A)
+        , coarse_size_(std::max(prm.get<int>("coarse_size", 64), 1))
+        , basis_iterations_(prm.get<int>("basis_iterations", 50))
+        , basis_tolerance_(prm.get<double>("basis_tolerance", 1e-3))
+        , relaxation_(prm.get<double>("relaxation", 2.0 / 3.0))
+        , pre_smooth_(prm.get<int>("pre_smooth", 1))
+        , post_smooth_(prm.get<int>("post_smooth", 1))
+    {
+        buildBlocks();
+        buildBasisPattern();
+        buildCoarseMatrix();
+        if (pre_smooth_ > 0 || post_smooth_ > 0) {
+            fine_ilu_ = std::make_unique<FineSmoother>(A_, 0, 1.0, MILU_VARIANT::ILU);
+        }
+        smoothBasis();
+        updateCoarseSystem();
+    }
+
+    void pre(Vector&, Vector&) override
+    {
+    }
+
+    void apply(Vector& v, const Vector& d) override
+    {
+        v = 0.0;
+        smooth(v, d, pre_smooth_);
+
+        // restriction of the residual with the basis functions
+        residual_ = d;
+        A_.mmv(v, residual_);
+        coarse_rhs_ = 0.0;
+        for (std::size_t cell = 0; cell < block_.size(); ++cell) {
+            const int b = block_[cell];
+            for (int k = 0; k < numBasis(b); ++k) {
+                coarse_rhs_[neighbours_[neighbour_start_[b] + k]][0] +=
+                    basis_[basis_start_[cell] + k] * residual_[cell][0];
+            }
+        }
+
+        solveCoarse();
+
+        // prolongation with the basis functions
+        for (std::size_t cell = 0; cell < block_.size(); ++cell) {
+            const int b = block_[cell];
+            for (int k = 0; k < numBasis(b); ++k) {
+                v[cell][0] += basis_[basis_start_[cell] + k] * coarse_x_[neighbours_[neighbour_start_[b] + k]][0];
+            }
+        }
+
+        smooth(v, d, post_smooth_);
+    }
+
+    void post(Vector&) override
+    {
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+    void update() override
+    {
+        smoothBasis();
+        updateCoarseSystem();
+        if (fine_ilu_) {
+            fine_ilu_->update();
+        }
+    }
+
+    /// Number of coarse blocks
+    int numBlocks() const
+    {
+        return num_blocks_;
+    }
+
+    /// Number of smoothing iterations of the basis functions by the last
+    /// constructor or update() call
+    int basisIterations() const
+    {
+        return last_iterations_;
+    }
+
+private:
+    using CoarseOperator = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+    using FineSmoother = ParallelOverlappingILU0<Matrix, Vector, Vector>;
+
+    int numBasis(const int block) const
+    {
+        return neighbour_start_[block + 1] - neighbour_start_[block];
+    }
+
+    void smooth(Vector& v, const Vector& d, const int sweeps)
+    {
+        for (int sweep = 0; sweep < sweeps; ++sweep) {
+            residual_ = d;
+            A_.mmv(v, residual_);
+            fine_ilu_->apply(correction_, residual_);
+            v += correction_;
+        }
+    }
+
+    // Grow the blocks from the first cell which is not in a block yet.
+    void buildBlocks()
+    {
+        const std::size_t n = A_.N();
+        block_.assign(n, -1);
+        num_blocks_ = 0;
+        std::queue<std::size_t> front;
+        for (std::size_t seed = 0; seed < n; ++seed) {
+            if (block_[seed] >= 0) {
+                continue;
+            }
+            front = {};
+            front.push(seed);
+            int size = 0;
+            while (!front.empty() && size < coarse_size_) {
+                const std::size_t cell = front.front();
+                front.pop();
+                if (block_[cell] >= 0) {
+                    continue;
+                }
+                block_[cell] = num_blocks_;
+                ++size;
+                for (auto col = A_[cell].begin(); col != A_[cell].end(); ++col) {
+                    if (block_[col.index()] < 0) {
+                        front.push(col.index());
+                    }
+                }
+            }
+            ++num_blocks_;
+        }
+    }
+
+    // The support of a basis function is its block and the neighbouring
+    // blocks, hence the cells of a block have the basis functions of the
+    // block and its neighbours. The neighbourship is made symmetric.
+    void buildBasisPattern()
+    {
+        std::vector<std::vector<int>> neighbours(num_blocks_);
+        for (std::size_t cell = 0; cell < block_.size(); ++cell) {
+            const int b = block_[cell];
+            neighbours[b].push_back(b);
+            for (auto col = A_[cell].begin(); col != A_[cell].end(); ++col) {
+                const int other = block_[col.index()];
+                if (other != b) {
+                    neighbours[b].push_back(other);
+                    neighbours[other].push_back(b);
+                }
+            }
+        }
+
+        neighbour_start_.assign(num_blocks_ + 1, 0);
+        neighbours_.clear();
+        for (int b = 0; b < num_blocks_; ++b) {
+            auto& nb = neighbours[b];
+            std::sort(nb.begin(), nb.end());
+            nb.erase(std::unique(nb.begin(), nb.end()), nb.end());
+            neighbours_.insert(neighbours_.end(), nb.begin(), nb.end());
+            neighbour_start_[b + 1] = neighbours_.size();
+        }
+
+        basis_start_.assign(block_.size() + 1, 0);
+        for (std::size_t cell = 0; cell < block_.size(); ++cell) {
+            basis_start_[cell + 1] = basis_start_[cell] + numBasis(block_[cell]);
+        }
+
+        // the basis functions start as the indicators of the blocks
+        basis_.assign(basis_start_.back(), 0.0);
+        for (std::size_t cell = 0; cell < block_.size(); ++cell) {
+            const int b = block_[cell];
+            const auto first = neighbours_.begin() + neighbour_start_[b];
+            const auto own = std::lower_bound(first, neighbours_.begin() + neighbour_start_[b + 1], b);
+            basis_[basis_start_[cell] + (own - first)] = 1.0;
+        }
+        next_basis_.resize(basis_.size());
+        position_.assign(num_blocks_, -1);
+    }
+
+    // The support of a basis function is the neighbourhood of its block,
+    // and the matrix couples the cells of neighbouring blocks, hence the
+    // coarse matrix couples a block to the blocks three neighbourships away.
+    void buildCoarseMatrix()
+    {
+        coarse_ = std::make_unique<Matrix>(num_blocks_, num_blocks_, Matrix::random);
+        auto expand = [this](const std::vector<std::vector<int>>& blocks) {
+            std::vector<std::vector<int>> expanded(num_blocks_);
+            for (int b = 0; b < num_blocks_; ++b) {
+                for (const int nb : blocks[b]) {
+                    expanded[b].insert(expanded[b].end(),
+                                       neighbours_.begin() + neighbour_start_[nb],
+                                       neighbours_.begin() + neighbour_start_[nb + 1]);
+                }
+                std::sort(expanded[b].begin(), expanded[b].end());
+                expanded[b].erase(std::unique(expanded[b].begin(), expanded[b].end()), expanded[b].end());
+            }
+            return expanded;
+        };
+        std::vector<std::vector<int>> pattern(num_blocks_);
+        for (int b = 0; b < num_blocks_; ++b) {
+            pattern[b].assign(neighbours_.begin() + neighbour_start_[b],
+                              neighbours_.begin() + neighbour_start_[b + 1]);
+        }
+        pattern = expand(expand(pattern));
+        for (int b = 0; b < num_blocks_; ++b) {
+            coarse_->setrowsize(b, pattern[b].size());
+        }
+        coarse_->endrowsizes();
+        for (int b = 0; b < num_blocks_; ++b) {
+            for (const int col : pattern[b]) {
+                coarse_->addindex(b, col);
+            }
+        }
+        coarse_->endindices();
+
+        block_cells_start_.assign(num_blocks_ + 1, 0);
+        for (const int b : block_) {
+            ++block_cells_start_[b + 1];
+        }
+        for (int b = 0; b < num_blocks_; ++b) {
+            block_cells_start_[b + 1] += block_cells_start_[b];
+        }
+        block_cells_.resize(block_.size());
+        auto next = block_cells_start_;
+        for (std::size_t cell = 0; cell < block_.size(); ++cell) {
+            block_cells_[next[block_[cell]]++] = cell;
+        }
+
+        coarse_rhs_.resize(num_blocks_);
+        coarse_x_.resize(num_blocks_);
+        coarse_row_.resize(num_blocks_);
+        residual_.resize(A_.N());
+        correction_.resize(A_.N());
+    }
+
+    void smoothBasis()
+    {
+        last_iterations_ = 0;
+        for (int it = 0; it < basis_iterations_; ++it) {
+            double max_change = 0.0;
+            for (std::size_t cell = 0; cell < block_.size(); ++cell) {
+                const int b = block_[cell];
+                const int first = neighbour_start_[b];
+                const int num = numBasis(b);
+                for (int k = 0; k < num; ++k) {
+                    position_[neighbours_[first + k]] = k;
+                }
+
+                double* next = &next_basis_[basis_start_[cell]];
+                std::fill(next, next + num, 0.0);
+                double diagonal = 0.0;
+                for (auto col = A_[cell].begin(); col != A_[cell].end(); ++col) {
+                    const std::size_t other = col.index();
+                    const double a = (*col)[0][0];
+                    if (other == cell) {
+                        diagonal = a;
+                    }
+                    const int ob = block_[other];
+                    for (int k = 0; k < numBasis(ob); ++k) {
+                        const int pos = position_[neighbours_[neighbour_start_[ob] + k]];
+                        if (pos >= 0) {
+                            next[pos] += a * basis_[basis_start_[other] + k];
+                        }
+                    }
+                }
+
+                // Jacobi step restricted to the supports, then back to a
+                // partition of unity
+                const double* current = &basis_[basis_start_[cell]];
+                double sum = 0.0;
+                for (int k = 0; k < num; ++k) {
+                    next[k] = diagonal != 0.0
+                        ? current[k] - relaxation_ * next[k] / diagonal
+                        : current[k];
+                    sum += next[k];
+                }
+                for (int k = 0; k < num; ++k) {
+                    if (sum != 0.0) {
+                        next[k] /= sum;
+                    }
+                    max_change = std::max(max_change, std::abs(next[k] - current[k]));
+                    position_[neighbours_[first + k]] = -1;
+                }
+            }
+            basis_.swap(next_basis_);
+            ++last_iterations_;
+            if (max_change < basis_tolerance_) {
+                break;
+            }
+        }
+    }
+
+    // Coarse matrix P^T A P, row b sums over the cells of the support of
+    // the basis function of block b.
+    void updateCoarseSystem()
+    {
+        for (int b = 0; b < num_blocks_; ++b) {
+            auto& row = (*coarse_)[b];
+            row = 0.0;
+            for (auto col = row.begin(); col != row.end(); ++col) {
+                coarse_row_[col.index()] = &(*col)[0][0];
+            }
+            for (int k = neighbour_start_[b]; k < neighbour_start_[b + 1]; ++k) {
+                const int nb = neighbours_[k];
+                // position of the basis function of b in the cells of nb
+                const auto first = neighbours_.begin() + neighbour_start_[nb];
+                const auto own = std::lower_bound(first, neighbours_.begin() + neighbour_start_[nb + 1], b) - first;
+                for (int c = block_cells_start_[nb]; c < block_cells_start_[nb + 1]; ++c) {
+                    const std::size_t cell = block_cells_[c];
+                    const double weight = basis_[basis_start_[cell] + own];
+                    if (weight == 0.0) {
+                        continue;
+                    }
+                    for (auto col = A_[cell].begin(); col != A_[cell].end(); ++col) {
+                        const std::size_t other = col.index();
+                        const double a = weight * (*col)[0][0];
+                        const int ob = block_[other];
+                        for (int j = 0; j < numBasis(ob); ++j) {
+                            *coarse_row_[neighbours_[neighbour_start_[ob] + j]] +=
+                                a * basis_[basis_start_[other] + j];
+                        }
+                    }
+                }
+            }
+        }
+
+#if HAVE_SUITESPARSE_UMFPACK
+        if (!coarse_solver_) {
+            coarse_solver_ = std::make_unique<Dune::UMFPack<Matrix>>(*coarse_, 0);
+        }
+        else {
+            coarse_solver_->setMatrix(*coarse_);
+        }
+#else
+        if (!coarse_solver_) {
+            coarse_operator_ = std::make_unique<CoarseOperator>(*coarse_);
+            coarse_ilu_ = std::make_unique<FineSmoother>(*coarse_, 0, 1.0, MILU_VARIANT::ILU);
+            coarse_solver_ = std::make_unique<Dune::BiCGSTABSolver<Vector>>(*coarse_operator_, *coarse_ilu_,
+                                                                           1e-8, 500, 0);
+        }
+        else {
+            coarse_ilu_->update();
+        }
+#endif
+    }
+
+    void solveCoarse()
+    {
+        Dune::InverseOperatorResult res;
+        coarse_x_ = 0.0;
+        // the solvers overwrite the right hand side
+        coarse_solver_->apply(coarse_x_, coarse_rhs_, res);
+    }
+
+    const Matrix& A_;
+    const int coarse_size_;
+    const int basis_iterations_;
+    const double basis_tolerance_;
+    const double relaxation_;
+    const int pre_smooth_;
+    const int post_smooth_;
+
+    // coarse block of every cell
+    std::vector<int> block_;
+    int num_blocks_ = 0;
+    // cells of every block
+    std::vector<int> block_cells_start_;
+    std::vector<std::size_t> block_cells_;
+    // sorted neighbour blocks of every block, including the block itself
+    std::vector<int> neighbour_start_;
+    std::vector<int> neighbours_;
+    // values of the basis functions of the neighbour blocks in every cell
+    std::vector<std::size_t> basis_start_;
+    std::vector<double> basis_;
+    std::vector<double> next_basis_;
+    // scratch space mapping a block to its basis position in a cell
+    std::vector<int> position_;
+    int last_iterations_ = 0;
+
+    std::unique_ptr<Matrix> coarse_;
+    std::vector<double*> coarse_row_;
+    Vector coarse_rhs_;
+    Vector coarse_x_;
+#if HAVE_SUITESPARSE_UMFPACK
+    std::unique_ptr<Dune::UMFPack<Matrix>> coarse_solver_;
+#else
+    std::unique_ptr<CoarseOperator> coarse_operator_;
+    std::unique_ptr<FineSmoother> coarse_ilu_;
+    std::unique_ptr<Dune::BiCGSTABSolver<Vector>> coarse_solver_;
+#endif
+
+    std::unique_ptr<FineSmoother> fine_ilu_;
+    Vector residual_;
+    Vector correction_;
+};
+
+} // namespace Opm
+
+#endif // OPM_MSRSBPRECONDITIONER_HEADER_INCLUDED
@@ -0,0 +1,347 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MULTIRHSBICGSTAB_HEADER_INCLUDED
+#define OPM_MULTIRHSBICGSTAB_HEADER_INCLUDED
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+/// \brief ILU0 preconditioned BiCGSTAB for several right hand sides of a scalar matrix.
+///
+/// The ILU0 factorisation is computed in the constructor and by update(), and
+/// it is shared by all solves in between. The right hand sides are solved with
+/// independent BiCGSTAB recurrences, but their vectors are stored interleaved,
+/// such that every sweep over the matrix and the ILU factors serves all of
+/// them. A right hand side that has converged, or whose recurrence broke down,
+/// is left out of the remaining updates.
+///
+/// The matrix type is a Dune::BCRSMatrix with 1x1 blocks, the vector type a
+/// Dune::BlockVector with blocks of size one.
+template <class Matrix>
+class MultiRhsBiCGSTAB
+{
+public:
+    using field_type = typename Matrix::field_type;
+
+    explicit MultiRhsBiCGSTAB(const Matrix& A)
+        : n_(A.N())
+    {
+        rowStart_.reserve(n_ + 1);
+        cols_.reserve(A.nonzeroes());
+        values_.reserve(A.nonzeroes());
+        rowStart_.push_back(0);
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                cols_.push_back(col.index());
+                values_.push_back((*col)[0][0]);
+            }
+            rowStart_.push_back(cols_.size());
+        }
+        factorize();
+    }
+
+    /// Recompute the factorisation for new values of a matrix with the sparsity
+    /// pattern that was given to the constructor.
+    void update(const Matrix& A)
+    {
+        auto value = values_.begin();
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                *value++ = (*col)[0][0];
+            }
+        }
+        factorize();
+    }
+
+    /// Solve A x[r] = b[r] for all r, starting from zero.
+    /// \param[out] x          the solutions, resized to the number of right hand sides
+    /// \param[in] b           the right hand sides
+    /// \param[in] reduction   relative reduction of the residual norm of a converged solution
+    /// \param[in] maxit       maximum number of iterations
+    /// \return                whether all right hand sides converged
+    template <class Vector>
+    bool solve(std::vector<Vector>& x, const std::vector<Vector>& b,
+               const double reduction, const int maxit)
+    {
+        const std::size_t k = b.size();
+        iterations_ = 0;
+        x.resize(k);
+        if (k == 0) {
+            return true;
+        }
+
+        std::vector<field_type> X(n_ * k, 0.0), R(n_ * k), P(n_ * k, 0.0), V(n_ * k, 0.0);
+        std::vector<field_type> Y(n_ * k), Z(n_ * k), T(n_ * k);
+        for (std::size_t i = 0; i < n_; ++i) {
+            for (std::size_t c = 0; c < k; ++c) {
+                R[i * k + c] = b[c][i];
+            }
+        }
+        const std::vector<field_type> Rt(R);
+
+        std::vector<char> active(k, 1);
+        std::vector<bool> converged(k, false);
+        std::vector<double> def0(k), rho(k), rhoOld(k, 1.0), alpha(k, 1.0), omega(k, 1.0), tmp(k), tmp2(k);
+        norms(R, active, def0);
+        std::size_t numActive = k;
+        for (std::size_t c = 0; c < k; ++c) {
+            if (def0[c] < 1e-30) {
+                converged[c] = true;
+                active[c] = 0;
+                --numActive;
+            }
+        }
+
+        // Deactivates the right hand sides whose residual norm is small enough.
+        auto checkConvergence = [&](const std::vector<field_type>& res) {
+            norms(res, active, tmp);
+            for (std::size_t c = 0; c < k; ++c) {
+                if (active[c] && tmp[c] <= reduction * def0[c]) {
+                    converged[c] = true;
+                    active[c] = 0;
+                    --numActive;
+                }
+            }
+        };
+
+        // Deactivates the right hand sides whose denominator vanished.
+        auto checkBreakdown = [&](const std::vector<double>& denom) {
+            for (std::size_t c = 0; c < k; ++c) {
+                if (active[c] && std::abs(denom[c]) < 1e-80) {
+                    active[c] = 0;
+                    --numActive;
+                }
+            }
+        };
+
+        for (int it = 1; it <= maxit && numActive > 0; ++it) {
+            iterations_ = it;
+
+            dots(Rt, R, active, rho);
+            checkBreakdown(rho);
+            std::vector<double> beta(k);
+            for (std::size_t c = 0; c < k; ++c) {
+                beta[c] = (rho[c] / rhoOld[c]) * (alpha[c] / omega[c]);
+            }
+            // p = r + beta * (p - omega * v)
+            for (std::size_t i = 0; i < n_ * k; i += k) {
+                for (std::size_t c = 0; c < k; ++c) {
+                    if (active[c]) {
+                        P[i + c] = R[i + c] + beta[c] * (P[i + c] - omega[c] * V[i + c]);
+                    }
+                }
+            }
+
+            applyPrec(P, Y, k);
+            mv(Y, V, k);
+            dots(Rt, V, active, tmp2);
+            checkBreakdown(tmp2);
+            for (std::size_t c = 0; c < k; ++c) {
+                alpha[c] = active[c] ? rho[c] / tmp2[c] : 0.0;
+            }
+            // x += alpha * y, s = r - alpha * v (stored in r)
+            for (std::size_t i = 0; i < n_ * k; i += k) {
+                for (std::size_t c = 0; c < k; ++c) {
+                    if (active[c]) {
+                        X[i + c] += alpha[c] * Y[i + c];
+                        R[i + c] -= alpha[c] * V[i + c];
+                    }
+                }
+            }
+            checkConvergence(R);
+            if (numActive == 0) {
+                break;
+            }
+
+            applyPrec(R, Z, k);
+            mv(Z, T, k);
+            dots(T, R, active, tmp);
+            dots(T, T, active, tmp2);
+            checkBreakdown(tmp2);
+            for (std::size_t c = 0; c < k; ++c) {
+                omega[c] = active[c] ? tmp[c] / tmp2[c] : 0.0;
+            }
+            // x += omega * z, r = s - omega * t
+            for (std::size_t i = 0; i < n_ * k; i += k) {
+                for (std::size_t c = 0; c < k; ++c) {
+                    if (active[c]) {
+                        X[i + c] += omega[c] * Z[i + c];
+                        R[i + c] -= omega[c] * T[i + c];
+                    }
+                }
+            }
+            checkConvergence(R);
+            checkBreakdown(omega);
+            rhoOld = rho;
+        }
+
+        for (std::size_t c = 0; c < k; ++c) {
+            x[c].resize(n_);
+            for (std::size_t i = 0; i < n_; ++i) {
+                x[c][i] = X[i * k + c];
+            }
+        }
+
+        bool allConverged = true;
+        for (std::size_t c = 0; c < k; ++c) {
+            allConverged = allConverged && converged[c];
+        }
+        return allConverged;
+    }
+
+    /// Number of iterations of the last call to solve()
+    int iterations() const
+    {
+        return iterations_;
+    }
+
+private:
+    // In place ILU0 of the values, the upper part keeps the inverse diagonal.
+    void factorize()
+    {
+        ilu_ = values_;
+        diag_.assign(n_, 0);
+        invDiag_.assign(n_, 0.0);
+        std::vector<std::ptrdiff_t> pos(n_, -1);
+        for (std::size_t i = 0; i < n_; ++i) {
+            bool hasDiag = false;
+            for (std::size_t p = rowStart_[i]; p < rowStart_[i + 1]; ++p) {
+                pos[cols_[p]] = p;
+                if (cols_[p] == i) {
+                    diag_[i] = p;
+                    hasDiag = true;
+                }
+            }
+            if (!hasDiag) {
+                throw std::runtime_error("MultiRhsBiCGSTAB: missing diagonal in row " + std::to_string(i));
+            }
+            for (std::size_t p = rowStart_[i]; p < diag_[i]; ++p) {
+                const std::size_t j = cols_[p];
+                ilu_[p] *= invDiag_[j];
+                for (std::size_t q = diag_[j] + 1; q < rowStart_[j + 1]; ++q) {
+                    if (pos[cols_[q]] >= 0) {
+                        ilu_[pos[cols_[q]]] -= ilu_[p] * ilu_[q];
+                    }
+                }
+            }
+            if (ilu_[diag_[i]] == 0.0) {
+                throw std::runtime_error("MultiRhsBiCGSTAB: zero pivot in row " + std::to_string(i));
+            }
+            invDiag_[i] = 1.0 / ilu_[diag_[i]];
+            for (std::size_t p = rowStart_[i]; p < rowStart_[i + 1]; ++p) {
+                pos[cols_[p]] = -1;
+            }
+        }
+    }
+
+    // y = A x for all k interleaved vectors
+    void mv(const std::vector<field_type>& x, std::vector<field_type>& y, const std::size_t k) const
+    {
+        for (std::size_t i = 0; i < n_; ++i) {
+            field_type* yi = &y[i * k];
+            for (std::size_t c = 0; c < k; ++c) {
+                yi[c] = 0.0;
+            }
+            for (std::size_t p = rowStart_[i]; p < rowStart_[i + 1]; ++p) {
+                const field_type a = values_[p];
+                const field_type* xj = &x[cols_[p] * k];
+                for (std::size_t c = 0; c < k; ++c) {
+                    yi[c] += a * xj[c];
+                }
+            }
+        }
+    }
+
+    // y = (LU)^{-1} x for all k interleaved vectors
+    void applyPrec(const std::vector<field_type>& x, std::vector<field_type>& y, const std::size_t k) const
+    {
+        for (std::size_t i = 0; i < n_; ++i) {
+            field_type* yi = &y[i * k];
+            for (std::size_t c = 0; c < k; ++c) {
+                yi[c] = x[i * k + c];
+            }
+            for (std::size_t p = rowStart_[i]; p < diag_[i]; ++p) {
+                const field_type l = ilu_[p];
+                const field_type* yj = &y[cols_[p] * k];
+                for (std::size_t c = 0; c < k; ++c) {
+                    yi[c] -= l * yj[c];
+                }
+            }
+        }
+        for (std::size_t i = n_; i-- > 0;) {
+            field_type* yi = &y[i * k];
+            for (std::size_t p = diag_[i] + 1; p < rowStart_[i + 1]; ++p) {
+                const field_type u = ilu_[p];
+                const field_type* yj = &y[cols_[p] * k];
+                for (std::size_t c = 0; c < k; ++c) {
+                    yi[c] -= u * yj[c];
+                }
+            }
+            for (std::size_t c = 0; c < k; ++c) {
+                yi[c] *= invDiag_[i];
+            }
+        }
+    }
+
+    void dots(const std::vector<field_type>& x, const std::vector<field_type>& y,
+              const std::vector<char>& active, std::vector<double>& result) const
+    {
+        const std::size_t k = active.size();
+        result.assign(k, 0.0);
+        for (std::size_t i = 0; i < n_ * k; i += k) {
+            for (std::size_t c = 0; c < k; ++c) {
+                result[c] += x[i + c] * y[i + c];
+            }
+        }
+        for (std::size_t c = 0; c < k; ++c) {
+            if (!active[c]) {
+                result[c] = 0.0;
+            }
+        }
+    }
+
+    void norms(const std::vector<field_type>& x, const std::vector<char>& active,
+               std::vector<double>& result) const
+    {
+        dots(x, x, active, result);
+        for (auto& r : result) {
+            r = std::sqrt(r);
+        }
+    }
+
+    std::size_t n_;
+    std::vector<std::size_t> rowStart_;
+    std::vector<std::size_t> cols_;
+    std::vector<field_type> values_;
+    std::vector<field_type> ilu_;
+    std::vector<std::size_t> diag_;
+    std::vector<field_type> invDiag_;
+    int iterations_ = 0;
+};
+
+} // namespace Opm
+
+#endif // OPM_MULTIRHSBICGSTAB_HEADER_INCLUDED
@@ -20,11 +20,13 @@
 #ifndef OPM_OWNINGTWOLEVELPRECONDITIONER_HEADER_INCLUDED
 #define OPM_OWNINGTWOLEVELPRECONDITIONER_HEADER_INCLUDED
 
+#include <opm/simulators/linalg/FloatMatrixOperator.hpp>
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
 #include <opm/simulators/linalg/PressureSolverPolicy.hpp>
 #include <opm/simulators/linalg/PressureTransferPolicy.hpp>
 #include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
 #include <opm/simulators/linalg/twolevelmethodcpr.hh>
+#include <opm/simulators/utils/TimingRegistry.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
 
@@ -33,6 +35,7 @@
 #include <dune/istl/paamg/amg.hh>
 
 #include <fstream>
+#include <memory>
 #include <type_traits>
 
 
@@ -73,10 +76,18 @@ std::ostream& operator<<(std::ostream& out,
 /// - Self-contained, because it owns its policy components.
 /// - Flexible, because it uses the runtime-flexible solver
 ///   and preconditioner factory.
+///
+/// The coarse pressure system and its solver use PressureScalar as
+/// field type, which may be lower than the precision of the fine system
+/// since the coarse correction is only used as a preconditioner.
+/// Likewise, the "matrix_precision" parameter selects whether the residual
+/// updates after the fine smoothing use the "double" (default) matrix or a
+/// "float" copy of it.
 template <class OperatorType,
           class VectorType,
           bool transpose = false,
-          class Communication = Dune::Amg::SequentialInformation>
+          class Communication = Dune::Amg::SequentialInformation,
+          class PressureScalar = double>
 class OwningTwoLevelPreconditioner : public Dune::PreconditionerWithUpdate<VectorType, VectorType>
 {
 public:
@@ -112,6 +123,7 @@ public:
             }
             Dune::writeMatrixMarket(weights_, outfile);
         }
+        setupFloatOperator();
     }
 
     OwningTwoLevelPreconditioner(const OperatorType& linearoperator, const Opm::PropertyTree& prm,
@@ -144,6 +156,7 @@ public:
             }
             Dune::writeMatrixMarket(weights_, outfile);
         }
+        setupFloatOperator();
     }
 
     virtual void pre(VectorType& x, VectorType& b) override
@@ -153,6 +166,7 @@ public:
 
     virtual void apply(VectorType& v, const VectorType& d) override
     {
+        ScopedTimer applyTimer(TimingRegistry::Region::CprApply);
         twolevel_method_.apply(v, d);
     }
 
@@ -163,7 +177,11 @@ public:
 
     virtual void update() override
     {
+        ScopedTimer setupTimer(TimingRegistry::Region::CprSetup);
         weights_ = weightsCalculator_();
+        if (floatOperator_) {
+            floatOperator_->updateValues();
+        }
         updateImpl(comm_);
     }
 
@@ -173,8 +191,8 @@ public:
     }
 
 private:
-    using PressureMatrixType = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
-    using PressureVectorType = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+    using PressureMatrixType = Dune::BCRSMatrix<Dune::FieldMatrix<PressureScalar, 1, 1>>;
+    using PressureVectorType = Dune::BlockVector<Dune::FieldVector<PressureScalar, 1>>;
     using SeqCoarseOperatorType = Dune::MatrixAdapter<PressureMatrixType, PressureVectorType, PressureVectorType>;
     using ParCoarseOperatorType
         = Dune::OverlappingSchwarzOperator<PressureMatrixType, PressureVectorType, PressureVectorType, Communication>;
@@ -188,6 +206,25 @@ private:
     using TwoLevelMethod
         = Dune::Amg::TwoLevelMethodCpr<OperatorType, CoarseSolverPolicy, Dune::Preconditioner<VectorType, VectorType>>;
 
+    using FloatOperatorType = Opm::FloatMatrixOperator<MatrixType, VectorType, Communication>;
+
+    void setupFloatOperator()
+    {
+        const auto precision = prm_.get<std::string>("matrix_precision", "double");
+        if (precision == "float") {
+            if constexpr (std::is_same_v<typename VectorType::field_type, double>) {
+                floatOperator_ = std::make_unique<FloatOperatorType>(linear_operator_.getmat(), comm_);
+                twolevel_method_.setResidualOperator(floatOperator_.get());
+            } else {
+                OPM_THROW(std::invalid_argument, "Properties: Matrix precision float is only supported"
+                          " for CPR of double precision systems.");
+            }
+        } else if (precision != "double") {
+            OPM_THROW(std::invalid_argument, "Properties: Matrix precision " << precision
+                      << " not supported for CPR. Please use double or float.");
+        }
+    }
+
     // Handling parallel vs serial instantiation of preconditioner factory.
     template <class Comm>
     void updateImpl(const Comm*)
@@ -215,6 +252,7 @@ private:
     CoarseSolverPolicy coarseSolverPolicy_;
     TwoLevelMethod twolevel_method_;
     Opm::PropertyTree prm_;
+    std::unique_ptr<FloatOperatorType> floatOperator_;
     Communication dummy_comm_;
 };
 
@@ -22,7 +22,9 @@
 
 #include <opm/simulators/linalg/GraphColoring.hpp>
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
 #include <opm/common/ErrorMacros.hpp>
+#include <dune/common/fmatrix.hh>
 #include <dune/common/version.hh>
 #include <dune/istl/preconditioner.hh>
 #include <dune/istl/ilu.hh>
@@ -30,11 +32,18 @@
 #include <dune/istl/paamg/graph.hh>
 #include <dune/istl/paamg/pinfo.hh>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
 #include <type_traits>
 #include <numeric>
 #include <limits>
+#include <memory>
 #include <cstddef>
 #include <string>
+#include <vector>
 
 namespace Opm
 {
@@ -98,9 +107,18 @@ class ParallelOverlappingILU0Args
     {
         return n_;
     }
+    void setFloatFactors(bool floatFactors)
+    {
+        floatFactors_ = floatFactors;
+    }
+    bool getFloatFactors() const
+    {
+        return floatFactors_;
+    }
  private:
     MILU_VARIANT milu_;
     int n_;
+    bool floatFactors_ = false;
 };
 } // end namespace Opm
 
@@ -137,12 +155,14 @@ struct ConstructionTraits<Opm::ParallelOverlappingILU0<Matrix,Domain,Range,Paral
 
     static inline ParallelOverlappingILU0Pointer construct(Arguments& args)
     {
-        return ParallelOverlappingILU0Pointer(
+        ParallelOverlappingILU0Pointer smoother(
                 new T(args.getMatrix(),
                       args.getComm(),
                       args.getArgs().getN(),
                       args.getArgs().relaxationFactor,
                       args.getArgs().getMilu()) );
+        smoother->setFloatFactors(args.getArgs().getFloatFactors());
+        return smoother;
     }
 
 #if ! DUNE_VERSION_NEWER(DUNE_ISTL, 2, 7)
@@ -339,9 +359,10 @@ namespace Opm
                             diagonal);
     }
 
+    //! Create the sparsity pattern of the ILU(n) factors of A in ILU.
     template<class M>
-    void milun_decomposition(const M& A, int n, MILU_VARIANT milu, M& ILU,
-                             Reorderer& ordering, Reorderer& inverseOrdering)
+    void milun_pattern(const M& A, int n, M& ILU,
+                       Reorderer& ordering, Reorderer& inverseOrdering)
     {
         using Map = std::map<std::size_t, int>;
 
@@ -396,7 +417,13 @@ namespace Opm
                 (*col)[0][0] = generationPair->second;
             }
         }
+    }
 
+    //! Copy the entries of A to the ILU(n) pattern created by milun_pattern()
+    //! and compute the decomposition.
+    template<class M>
+    void milun_numeric(const M& A, MILU_VARIANT milu, M& ILU, Reorderer& ordering)
+    {
         // copy Entries from A
         for(auto iter=A.begin(), iend = A.end(); iter != iend; ++iter)
         {
@@ -440,64 +467,213 @@ namespace Opm
         }
     }
 
-    //! Compute Blocked ILU0 decomposition, when we know junk ghost rows are located at the end of A
     template<class M>
-    void ghost_last_bilu0_decomposition (M& A, size_t interiorSize)
+    void milun_decomposition(const M& A, int n, MILU_VARIANT milu, M& ILU,
+                             Reorderer& ordering, Reorderer& inverseOrdering)
+    {
+        milun_pattern(A, n, ILU, ordering, inverseOrdering);
+        milun_numeric(A, milu, ILU, ordering);
+    }
+
+    //! Eliminate row i of A in a left looking blocked ILU0 decomposition with stored inverse.
+    //! Only rows with index less than i and present in row i are read.
+    template<class M>
+    void bilu0_decompose_row (M& A, typename M::size_type i)
     {
         // iterator types
-        typedef typename M::RowIterator rowiterator;
         typedef typename M::ColIterator coliterator;
         typedef typename M::block_type block;
 
-        // implement left looking variant with stored inverse
-        for (rowiterator i = A.begin(); i.index() < interiorSize; ++i)
+        auto& rowI = A[i];
+        // coliterator is diagonal after the following loop
+        coliterator endij=rowI.end();           // end of row i
+        coliterator ij;
+
+        // eliminate entries left of diagonal; store L factor
+        for (ij=rowI.begin(); ij.index()<i; ++ij)
         {
-            // coliterator is diagonal after the following loop
-            coliterator endij=(*i).end();           // end of row i
-            coliterator ij;
+            // find A_jj which eliminates A_ij
+            coliterator jj = A[ij.index()].find(ij.index());
+
+            // compute L_ij = A_jj^-1 * A_ij
+            (*ij).rightmultiply(*jj);
+
+            // modify row
+            coliterator endjk=A[ij.index()].end();    // end of row j
+            coliterator jk=jj; ++jk;
+            coliterator ik=ij; ++ik;
+            while (ik!=endij && jk!=endjk)
+                if (ik.index()==jk.index())
+                {
+                    block B(*jk);
+                    B.leftmultiply(*ij);
+                    *ik -= B;
+                    ++ik; ++jk;
+                }
+                else
+                {
+                    if (ik.index()<jk.index())
+                        ++ik;
+                    else
+                        ++jk;
+                }
+        }
+
+        // invert pivot and store it in A
+        if (ij==endij || ij.index()!=i)
+            DUNE_THROW(Dune::ISTLError,"diagonal entry missing");
+        try {
+            (*ij).invert();   // compute inverse of diagonal block
+        }
+        catch (Dune::FMatrixError & e) {
+            DUNE_THROW(Dune::ISTLError,"ILU failed to invert matrix block");
+        }
+    }
 
-            // eliminate entries left of diagonal; store L factor
-            for (ij=(*i).begin(); ij.index()<i.index(); ++ij)
+    //! Compute Blocked ILU0 decomposition, when we know junk ghost rows are located at the end of A
+    template<class M>
+    void ghost_last_bilu0_decomposition (M& A, size_t interiorSize)
+    {
+        for (typename M::size_type i = 0; i < interiorSize; ++i)
+        {
+            bilu0_decompose_row(A, i);
+        }
+    }
+
+    //! \brief Rows of a triangular factor grouped into independent levels.
+    //!
+    //! All rows in one level only depend on rows of previous levels, so
+    //! they can be eliminated or substituted concurrently. Rows of level l
+    //! are rows[start[l]] ... rows[start[l+1]-1].
+    struct LevelSets
+    {
+        std::size_t size() const
+        {
+            return start.empty() ? 0 : start.size() - 1;
+        }
+
+        void clear()
+        {
+            start.clear();
+            rows.clear();
+        }
+
+        std::vector<std::size_t> start;
+        std::vector<std::size_t> rows;
+    };
+
+    //! Group the rows 0, ..., n-1 by the levels given in level (counting sort,
+    //! keeps the original row order within each level).
+    inline void bucketLevels(const std::vector<std::size_t>& level,
+                             std::size_t noLevels, LevelSets& levels)
+    {
+        levels.start.assign(noLevels + 1, 0);
+        for (const auto l : level)
+        {
+            ++levels.start[l + 1];
+        }
+        std::partial_sum(levels.start.begin(), levels.start.end(), levels.start.begin());
+        levels.rows.resize(level.size());
+        std::vector<std::size_t> next(levels.start.begin(), levels.start.end() - 1);
+        for (std::size_t row = 0; row < level.size(); ++row)
+        {
+            levels.rows[next[level[row]]++] = row;
+        }
+    }
+
+    //! \brief Compute the level sets of the lower and upper triangular parts of A.
+    //!
+    //! Only the first interiorSize rows are considered, ghost rows at the end
+    //! are never updated and hence do not introduce dependencies.
+    template<class M>
+    void computeLevelSets(const M& A, std::size_t interiorSize,
+                          LevelSets& lower, LevelSets& upper)
+    {
+        lower.clear();
+        upper.clear();
+        if (interiorSize == 0)
+        {
+            return;
+        }
+
+        std::vector<std::size_t> level(interiorSize, 0);
+        std::size_t noLevels = 0;
+        // forward substitution: row i needs all rows j < i of its pattern
+        for (std::size_t i = 0; i < interiorSize; ++i)
+        {
+            std::size_t l = 0;
+            for (auto j = A[i].begin(), jend = A[i].end(); j != jend && j.index() < i; ++j)
             {
-                // find A_jj which eliminates A_ij
-                coliterator jj = A[ij.index()].find(ij.index());
-                
-                // compute L_ij = A_jj^-1 * A_ij
-                (*ij).rightmultiply(*jj);
-
-                // modify row
-                coliterator endjk=A[ij.index()].end();    // end of row j
-                coliterator jk=jj; ++jk;
-                coliterator ik=ij; ++ik;
-                while (ik!=endij && jk!=endjk)
-                    if (ik.index()==jk.index())
-                    {
-                        block B(*jk);
-                        B.leftmultiply(*ij);
-                        *ik -= B;
-                        ++ik; ++jk;
-                    }
-                    else
-                    {
-                        if (ik.index()<jk.index())
-                            ++ik;
-                        else
-                            ++jk;
-                    }
+                l = std::max(l, level[j.index()] + 1);
             }
+            level[i] = l;
+            noLevels = std::max(noLevels, l + 1);
+        }
+        bucketLevels(level, noLevels, lower);
 
-            // invert pivot and store it in A
-            if (ij.index()!=i.index())
-                DUNE_THROW(Dune::ISTLError,"diagonal entry missing");
-            try {
-                (*ij).invert();   // compute inverse of diagonal block
+        // backward substitution: row i needs all interior rows j > i of its pattern
+        noLevels = 0;
+        for (std::size_t i = interiorSize; i-- > 0; )
+        {
+            std::size_t l = 0;
+            for (auto j = A[i].begin(), jend = A[i].end(); j != jend; ++j)
+            {
+                if (j.index() > i && j.index() < interiorSize)
+                {
+                    l = std::max(l, level[j.index()] + 1);
+                }
             }
-            catch (Dune::FMatrixError & e) {
-                DUNE_THROW(Dune::ISTLError,"ILU failed to invert matrix block");
+            level[i] = l;
+            noLevels = std::max(noLevels, l + 1);
+        }
+        bucketLevels(level, noLevels, upper);
+    }
+
+    //! \brief Compute Blocked ILU0 decomposition of the interior rows level by level.
+    //!
+    //! The rows of each level are eliminated concurrently. Each row performs
+    //! exactly the same operations as in the sequential variant, hence the
+    //! result does not depend on the number of threads.
+    template<class M>
+    void level_bilu0_decomposition (M& A, const LevelSets& levels)
+    {
+        for (std::size_t level = 0; level < levels.size(); ++level)
+        {
+            const std::size_t begin = levels.start[level];
+            const std::size_t end = levels.start[level + 1];
+            int failed = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(max:failed) if(end - begin > 1)
+#endif
+            for (std::size_t k = begin; k < end; ++k)
+            {
+                try {
+                    bilu0_decompose_row(A, levels.rows[k]);
+                }
+                catch (const Dune::Exception&) {
+                    failed = 1;
+                }
+            }
+            if (failed)
+            {
+                DUNE_THROW(Dune::MatrixBlockError, "ILU failed to invert matrix block");
             }
         }
     }
 
+      //! Copy the entries of a block to a block of possibly different field type.
+      template<class Src, class Dst>
+      void copyBlock(const Src& src, Dst& dst)
+      {
+        for (std::size_t i = 0; i < dst.N(); ++i)
+        {
+          for (std::size_t j = 0; j < dst.M(); ++j)
+          {
+            dst[i][j] = src[i][j];
+          }
+        }
+      }
+
       //! compute ILU decomposition of A. A is overwritten by its decomposition
       template<class M, class CRS, class InvVector>
       void convertToCRS(const M& A, CRS& lower, CRS& upper, InvVector& inv )
@@ -574,7 +750,7 @@ namespace Opm
             const size_type jIndex = j.index();
             if( j.index() == iIndex )
             {
-              inv[ row ] = (*j);
+              copyBlock( (*j), inv[ row ] );
               break;
             }
             else if ( j.index() >= i.index() )
@@ -587,6 +763,49 @@ namespace Opm
         }
         assert(colcount == numUpper);
       }
+      //! Copy the values of the decomposition A to lower, upper and inv, which
+      //! must have been created by convertToCRS() for the same sparsity pattern.
+      template<class M, class CRS, class InvVector>
+      void updateCRSValues(const M& A, CRS& lower, CRS& upper, InvVector& inv)
+      {
+        if ( A.N() == 0 )
+        {
+          return;
+        }
+
+        typedef typename M :: size_type size_type;
+
+        size_type colcount = 0;
+        const auto endi = A.end();
+        for (auto i = A.begin(); i != endi; ++i)
+        {
+          const size_type iIndex = i.index();
+          for (auto j = (*i).begin(); j.index() < iIndex; ++j)
+          {
+            copyBlock( (*j), lower.values_[ colcount++ ] );
+          }
+        }
+        assert(colcount == lower.values_.size());
+
+        // upper and inv store entries in reverse order, see convertToCRS()
+        const auto rendi = A.beforeBegin();
+        size_type row = 0;
+        colcount = 0;
+        for (auto i = A.beforeEnd(); i != rendi; --i, ++row)
+        {
+          const size_type iIndex = i.index();
+          for (auto j = (*i).beforeEnd(); j.index() >= iIndex; --j)
+          {
+            if ( j.index() == iIndex )
+            {
+              copyBlock( (*j), inv[ row ] );
+              break;
+            }
+            copyBlock( (*j), upper.values_[ colcount++ ] );
+          }
+        }
+        assert(colcount == upper.values_.size());
+      }
     } // end namespace detail
 
 
@@ -624,11 +843,14 @@ public:
 
     typedef typename matrix_type::block_type  block_type;
     typedef typename matrix_type::size_type   size_type;
+    //! \brief The block type used to store the factors in single precision.
+    typedef Dune::FieldMatrix<float, block_type::rows, block_type::cols> float_block_type;
 
 protected:
-    struct CRS
+    template<class Block>
+    struct CRSStorage
     {
-      CRS() : nRows_( 0 ) {}
+      CRSStorage() : nRows_( 0 ) {}
 
       size_type rows() const { return nRows_; }
 
@@ -658,9 +880,11 @@ protected:
           }
       }
 
-      void push_back( const block_type& value, const size_type index )
+      template<class OtherBlock>
+      void push_back( const OtherBlock& value, const size_type index )
       {
-          values_.push_back( value );
+          values_.emplace_back();
+          detail::copyBlock( value, values_.back() );
           cols_.push_back( index );
       }
 
@@ -673,11 +897,14 @@ protected:
       }
 
       std::vector< size_type  > rows_;
-      std::vector< block_type > values_;
+      std::vector< Block      > values_;
       std::vector< size_type  > cols_;
       size_type nRows_;
     };
 
+    using CRS = CRSStorage<block_type>;
+    using FloatCRS = CRSStorage<float_block_type>;
+
 public:
     Dune::SolverCategory::Category category() const override
     {
@@ -697,19 +924,23 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering of the
+                         interior rows. Ignored if redblack is true.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
+                             bool reorder_sphere=true,
+                             bool reorder_rcm=false)
         : lower_(),
           upper_(),
           inv_(),
           comm_(nullptr), w_(w),
           relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
           A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(n),
-          milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+          milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+          reorderRcm_(reorder_rcm)
     {
         interiorSize_ = A.N();
         // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -728,19 +959,23 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering of the
+                         interior rows. Ignored if redblack is true.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const ParallelInfo& comm, const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
+                             bool reorder_sphere=true,
+                             bool reorder_rcm=false)
         : lower_(),
           upper_(),
           inv_(),
           comm_(&comm), w_(w),
           relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
           A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(n),
-          milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+          milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+          reorderRcm_(reorder_rcm)
     {
         interiorSize_ = A.N();
         // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -759,12 +994,15 @@ public:
                   The vertices on each layer aound it (same distance) are
                   ordered consecutivly. If false, we preserver the order of
                   the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering of the
+                         interior rows. Ignored if redblack is true.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const field_type w, MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
-        : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere )
+                             bool reorder_sphere=true,
+                             bool reorder_rcm=false)
+        : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere, reorder_rcm )
     {
     }
 
@@ -780,19 +1018,23 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering of the
+                         interior rows. Ignored if redblack is true.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const ParallelInfo& comm, const field_type w,
                              MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
+                             bool reorder_sphere=true,
+                             bool reorder_rcm=false)
         : lower_(),
           upper_(),
           inv_(),
           comm_(&comm), w_(w),
           relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
           A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(0),
-          milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+          milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+          reorderRcm_(reorder_rcm)
     {
         interiorSize_ = A.N();
         // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -813,13 +1055,16 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering of the
+                         interior rows. Ignored if redblack is true.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const ParallelInfo& comm,
                              const field_type w, MILU_VARIANT milu,
                              size_type interiorSize, bool redblack=false,
-                             bool reorder_sphere=true)
+                             bool reorder_sphere=true,
+                             bool reorder_rcm=false)
         : lower_(),
           upper_(),
           inv_(),
@@ -827,7 +1072,8 @@ public:
           relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
           interiorSize_(interiorSize),
           A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(0),
-          milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+          milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+          reorderRcm_(reorder_rcm)
     {
         // BlockMatrix is a Subclass of FieldMatrix that just adds
         // methods. Therefore this cast should be safe.
@@ -855,56 +1101,34 @@ public:
         Range& md = reorderD(d);
         Domain& mv = reorderV(v);
 
-        // iterator types
-        typedef typename Range ::block_type  dblock;
-        typedef typename Domain::block_type  vblock;
-
-        const size_type iEnd = lower_.rows();
-        const size_type lastRow = iEnd - 1;
-        size_type upperLoppStart = iEnd - interiorSize_;
-        size_type lowerLoopEnd = interiorSize_;
-        if( iEnd != upper_.rows() )
-        {
-            OPM_THROW(std::logic_error,"ILU: number of lower and upper rows must be the same");
-        }
-
-        // lower triangular solve
-        for( size_type i=0; i<lowerLoopEnd; ++ i )
+        if( floatFactors_ )
         {
-          dblock rhs( md[ i ] );
-          const size_type rowI     = lower_.rows_[ i ];
-          const size_type rowINext = lower_.rows_[ i+1 ];
-
-          for( size_type col = rowI; col < rowINext; ++ col )
-          {
-            lower_.values_[ col ].mmv( mv[ lower_.cols_[ col ] ], rhs );
-          }
-
-          mv[ i ] = rhs;  // Lii = I
+            triangularSolve( lowerFloat_, upperFloat_, invFloat_, mv, md );
         }
-
-        for( size_type i=upperLoppStart; i<iEnd; ++ i )
+        else
         {
-            vblock& vBlock = mv[ lastRow - i ];
-            vblock rhs ( vBlock );
-            const size_type rowI     = upper_.rows_[ i ];
-            const size_type rowINext = upper_.rows_[ i+1 ];
-
-            for( size_type col = rowI; col < rowINext; ++ col )
-            {
-                upper_.values_[ col ].mmv( mv[ upper_.cols_[ col ] ], rhs );
-            }
-
-            // apply inverse and store result
-            inv_[ i ].mv( rhs, vBlock);
+            triangularSolve( lower_, upper_, inv_, mv, md );
         }
 
-        copyOwnerToAll( mv );
-
         if( relaxation_ ) {
             mv *= w_;
         }
         reorderBack(mv, v);
+
+        // The communication uses the original ordering of the unknowns.
+        if( exchangeResult_ )
+        {
+            copyOwnerToAll( v );
+        }
+    }
+
+    /// \brief Select whether apply() copies the owner values of its result to all copies.
+    ///
+    /// This may be disabled if every result is passed to an operator that
+    /// does the exchange itself, e.g. overlapped with its computation.
+    void setExchangeResult(const bool exchangeResult)
+    {
+        exchangeResult_ = exchangeResult;
     }
 
     template <class V>
@@ -927,6 +1151,8 @@ public:
 
     virtual void update() override
     {
+        ScopedTimer decompositionTimer(TimingRegistry::Region::IluDecomposition);
+
         // (For older DUNE versions the communicator might be
         // invalid if redistribution in AMG happened on the coarset level.
         // Therefore we check for nonzero size
@@ -947,9 +1173,23 @@ public:
         std::string message;
         const int rank = ( comm_ ) ? comm_->communicator().rank() : 0;
 
-        std::unique_ptr< Matrix > ILU;
+        // The sparsity pattern of the matrix does not change between updates,
+        // hence the ordering, the pattern of the factors and their CRS layout
+        // are only computed once, and later updates only do the numeric part.
+        const bool newPattern = !ILU_ || A_->N() != patternRows_ || A_->nonzeroes() != patternNonzeroes_;
+        if ( newPattern )
+        {
+            ILU_.reset();
+            crsPatternValid_ = false;
+            patternRows_ = A_->N();
+            patternNonzeroes_ = A_->nonzeroes();
+            if ( redBlack_ || reorderRcm_ )
+            {
+                ordering_.clear();
+            }
+        }
 
-        if ( redBlack_ )
+        if ( redBlack_ && ordering_.empty() )
         {
             using Graph = Dune::Amg::MatrixGraph<const Matrix>;
             Graph graph(*A_);
@@ -968,6 +1208,13 @@ public:
                                                       graph);
             }
         }
+        else if ( reorderRcm_ && ordering_.empty() )
+        {
+            // Ghost rows stay last.
+            using Graph = Dune::Amg::MatrixGraph<const Matrix>;
+            Graph graph(*A_);
+            ordering_ = reorderVerticesReverseCuthillMcKee(graph, interiorSize_);
+        }
 
         std::vector<std::size_t> inverseOrdering(ordering_.size());
         std::size_t index = 0;
@@ -982,21 +1229,42 @@ public:
                 // create ILU-0 decomposition
                 if ( ordering_.empty() )
                 {
-                    ILU.reset( new Matrix( *A_ ) );
+                    if ( !ILU_ )
+                    {
+                        ILU_.reset( new Matrix( *A_ ) );
+                        updateLevelSets( *ILU_ );
+                    }
+                    else
+                    {
+                        // Copy values
+                        for(auto iter = A_->begin(), iend = A_->end(); iter != iend; ++iter)
+                        {
+                            auto col = iter->begin();
+                            for(auto& entry : (*ILU_)[iter.index()])
+                            {
+                                entry = *col++;
+                            }
+                        }
+                    }
                 }
                 else
                 {
-                    ILU.reset( new Matrix(A_->N(), A_->M(), A_->nonzeroes(), Matrix::row_wise));
-                    auto& newA = *ILU;
-                    // Create sparsity pattern
-                    for(auto iter=newA.createbegin(), iend = newA.createend(); iter != iend; ++iter)
+                    if ( !ILU_ )
                     {
-                        const auto& row = (*A_)[inverseOrdering[iter.index()]];
-                        for(auto col = row.begin(), cend = row.end(); col != cend; ++col)
+                        ILU_.reset( new Matrix(A_->N(), A_->M(), A_->nonzeroes(), Matrix::row_wise));
+                        auto& newA = *ILU_;
+                        // Create sparsity pattern
+                        for(auto iter=newA.createbegin(), iend = newA.createend(); iter != iend; ++iter)
                         {
-                            iter.insert(ordering_[col.index()]);
+                            const auto& row = (*A_)[inverseOrdering[iter.index()]];
+                            for(auto col = row.begin(), cend = row.end(); col != cend; ++col)
+                            {
+                                iter.insert(ordering_[col.index()]);
+                            }
                         }
+                        updateLevelSets( newA );
                     }
+                    auto& newA = *ILU_;
                     // Copy values
                     for(auto iter = A_->begin(), iend = A_->end(); iter != iend; ++iter)
                     {
@@ -1008,38 +1276,40 @@ public:
                     }
                 }
 
+                auto& ILU = *ILU_;
                 switch ( milu_ )
                 {
                 case MILU_VARIANT::MILU_1:
-                    detail::milu0_decomposition ( *ILU);
+                    detail::milu0_decomposition ( ILU);
                     break;
                 case MILU_VARIANT::MILU_2:
-                    detail::milu0_decomposition ( *ILU, detail::IdentityFunctor(),
+                    detail::milu0_decomposition ( ILU, detail::IdentityFunctor(),
                                                   detail::SignFunctor() );
                     break;
                 case MILU_VARIANT::MILU_3:
-                    detail::milu0_decomposition ( *ILU, detail::AbsFunctor(),
+                    detail::milu0_decomposition ( ILU, detail::AbsFunctor(),
                                                   detail::SignFunctor() );
                     break;
                 case MILU_VARIANT::MILU_4:
-                    detail::milu0_decomposition ( *ILU, detail::IdentityFunctor(),
+                    detail::milu0_decomposition ( ILU, detail::IdentityFunctor(),
                                                   detail::IsPositiveFunctor() );
                     break;
                 default:
-                    if (interiorSize_ == A_->N())
+                    if (useLevelScheduling_)
+                        detail::level_bilu0_decomposition(ILU, lowerLevels_);
+                    else if (interiorSize_ == A_->N())
 #if DUNE_VERSION_LT(DUNE_GRID, 2, 8)
-                        bilu0_decomposition( *ILU );
+                        bilu0_decomposition( ILU );
 #else
-                        Dune::ILU::blockILU0Decomposition( *ILU );
+                        Dune::ILU::blockILU0Decomposition( ILU );
 #endif
                     else
-                        detail::ghost_last_bilu0_decomposition(*ILU, interiorSize_);
+                        detail::ghost_last_bilu0_decomposition(ILU, interiorSize_);
                     break;
                 }
             }
             else {
                 // create ILU-n decomposition
-                ILU.reset( new Matrix( A_->N(), A_->M(), Matrix::row_wise) );
                 std::unique_ptr<detail::Reorderer> reorderer, inverseReorderer;
                 if ( ordering_.empty() )
                 {
@@ -1052,7 +1322,13 @@ public:
                     inverseReorderer.reset(new detail::RealReorderer(inverseOrdering));
                 }
 
-                milun_decomposition( *A_, iluIteration_, milu_, *ILU, *reorderer, *inverseReorderer );
+                if ( !ILU_ )
+                {
+                    ILU_.reset( new Matrix( A_->N(), A_->M(), Matrix::row_wise) );
+                    detail::milun_pattern( *A_, iluIteration_, *ILU_, *reorderer, *inverseReorderer );
+                    updateLevelSets( *ILU_ );
+                }
+                detail::milun_numeric( *A_, milu_, *ILU_, *reorderer );
             }
         }
         catch (const Dune::MatrixBlockError& error)
@@ -1073,10 +1349,185 @@ public:
         }
 
         // store ILU in simple CRS format
-        detail::convertToCRS( *ILU, lower_, upper_, inv_ );
+        storeFactors();
+    }
+
+    /// \brief Select whether the factors are stored in single precision.
+    ///
+    /// The triangular solves are memory bound, storing the factors in float
+    /// roughly halves the memory traffic of apply(). The decomposition itself
+    /// is still computed in the precision of the matrix.
+    void setFloatFactors(const bool floatFactors)
+    {
+        if ( floatFactors == floatFactors_ )
+        {
+            return;
+        }
+        floatFactors_ = floatFactors;
+        crsPatternValid_ = false;
+        // release the storage of the other precision
+        lower_ = CRS();
+        upper_ = CRS();
+        std::vector<block_type>().swap( inv_ );
+        lowerFloat_ = FloatCRS();
+        upperFloat_ = FloatCRS();
+        std::vector<float_block_type>().swap( invFloat_ );
+        if ( ILU_ )
+        {
+            storeFactors();
+        }
     }
 
 protected:
+    /// \brief Solve (LU) mv = md with the factors stored in lower, upper and inv.
+    ///
+    /// The factors may be stored in a lower precision than the vectors, the
+    /// blocks are then converted while they are applied.
+    template<class CRSType, class InvVector>
+    void triangularSolve(const CRSType& lower, const CRSType& upper, const InvVector& inv,
+                         Domain& mv, const Range& md) const
+    {
+        // iterator types
+        typedef typename Range ::block_type  dblock;
+        typedef typename Domain::block_type  vblock;
+
+        const size_type iEnd = lower.rows();
+        const size_type lastRow = iEnd - 1;
+        size_type upperLoppStart = iEnd - interiorSize_;
+        size_type lowerLoopEnd = interiorSize_;
+        if( iEnd != upper.rows() )
+        {
+            OPM_THROW(std::logic_error,"ILU: number of lower and upper rows must be the same");
+        }
+
+        auto lowerSolveRow = [&]( const size_type i )
+        {
+          dblock rhs( md[ i ] );
+          const size_type rowI     = lower.rows_[ i ];
+          const size_type rowINext = lower.rows_[ i+1 ];
+
+          for( size_type col = rowI; col < rowINext; ++ col )
+          {
+            lower.values_[ col ].mmv( mv[ lower.cols_[ col ] ], rhs );
+          }
+
+          mv[ i ] = rhs;  // Lii = I
+        };
+
+        auto upperSolveRow = [&]( const size_type i )
+        {
+            vblock& vBlock = mv[ lastRow - i ];
+            vblock rhs ( vBlock );
+            const size_type rowI     = upper.rows_[ i ];
+            const size_type rowINext = upper.rows_[ i+1 ];
+
+            for( size_type col = rowI; col < rowINext; ++ col )
+            {
+                upper.values_[ col ].mmv( mv[ upper.cols_[ col ] ], rhs );
+            }
+
+            // apply inverse and store result
+            inv[ i ].mv( rhs, vBlock);
+        };
+
+        if( useLevelScheduling_ )
+        {
+            // rows within one level are independent of each other
+            for( std::size_t level = 0; level < lowerLevels_.size(); ++level )
+            {
+                const std::size_t begin = lowerLevels_.start[ level ];
+                const std::size_t end   = lowerLevels_.start[ level+1 ];
+#ifdef _OPENMP
+#pragma omp parallel for if(end - begin > minRowsPerLevel)
+#endif
+                for( std::size_t k = begin; k < end; ++k )
+                {
+                    lowerSolveRow( lowerLevels_.rows[ k ] );
+                }
+            }
+
+            for( std::size_t level = 0; level < upperLevels_.size(); ++level )
+            {
+                const std::size_t begin = upperLevels_.start[ level ];
+                const std::size_t end   = upperLevels_.start[ level+1 ];
+#ifdef _OPENMP
+#pragma omp parallel for if(end - begin > minRowsPerLevel)
+#endif
+                for( std::size_t k = begin; k < end; ++k )
+                {
+                    // upper and inv are stored in reverse row order
+                    upperSolveRow( lastRow - upperLevels_.rows[ k ] );
+                }
+            }
+        }
+        else
+        {
+            // lower triangular solve
+            for( size_type i=0; i<lowerLoopEnd; ++ i )
+            {
+                lowerSolveRow( i );
+            }
+
+            for( size_type i=upperLoppStart; i<iEnd; ++ i )
+            {
+                upperSolveRow( i );
+            }
+        }
+    }
+
+    /// \brief Store the decomposition ILU_ in the CRS factors used by apply().
+    void storeFactors()
+    {
+        if ( floatFactors_ )
+        {
+            storeFactors( lowerFloat_, upperFloat_, invFloat_ );
+        }
+        else
+        {
+            storeFactors( lower_, upper_, inv_ );
+        }
+    }
+
+    template<class CRSType, class InvVector>
+    void storeFactors(CRSType& lower, CRSType& upper, InvVector& inv)
+    {
+        if ( crsPatternValid_ )
+        {
+            detail::updateCRSValues( *ILU_, lower, upper, inv );
+        }
+        else
+        {
+            detail::convertToCRS( *ILU_, lower, upper, inv );
+            crsPatternValid_ = true;
+        }
+    }
+
+    /// \brief Compute the level sets of the factorization pattern if multiple threads are used.
+    ///
+    /// Level scheduling is only used if the levels contain enough rows on average
+    /// to amortize the synchronization between them.
+    void updateLevelSets(const Matrix& ILU)
+    {
+        useLevelScheduling_ = false;
+        lowerLevels_.clear();
+        upperLevels_.clear();
+#ifdef _OPENMP
+        if ( omp_get_max_threads() > 1 && interiorSize_ > 0 )
+        {
+            detail::computeLevelSets(ILU, interiorSize_, lowerLevels_, upperLevels_);
+            const std::size_t noLevels = std::max(lowerLevels_.size(), upperLevels_.size());
+            useLevelScheduling_ = interiorSize_ >= minRowsPerLevel * noLevels;
+            if ( !useLevelScheduling_ )
+            {
+                lowerLevels_.clear();
+                upperLevels_.clear();
+            }
+        }
+#else
+        DUNE_UNUSED_PARAMETER(ILU);
+#endif
+    }
+
     /// \brief Reorder D if needed and return a reference to it.
     Range& reorderD(const Range& d)
     {
@@ -1135,6 +1586,14 @@ protected:
     CRS lower_;
     CRS upper_;
     std::vector< block_type > inv_;
+    //! \brief The ILU0 decomposition of the matrix stored in single precision.
+    FloatCRS lowerFloat_;
+    FloatCRS upperFloat_;
+    std::vector< float_block_type > invFloat_;
+    //! \brief Whether the single precision factors are used.
+    bool floatFactors_ = false;
+    //! \brief Whether apply() makes its result consistent.
+    bool exchangeResult_ = true;
     //! \brief the reordering of the unknowns
     std::vector< std::size_t > ordering_;
     //! \brief The reordered right hand side
@@ -1152,6 +1611,20 @@ protected:
     MILU_VARIANT milu_;
     bool redBlack_;
     bool reorderSphere_;
+    bool reorderRcm_;
+    //! \brief The level sets of the lower and upper factors used for threaded application.
+    detail::LevelSets lowerLevels_;
+    detail::LevelSets upperLevels_;
+    bool useLevelScheduling_ = false;
+    //! \brief Minimum average number of rows per level for level scheduling to pay off.
+    static constexpr std::size_t minRowsPerLevel = 64;
+    //! \brief The (reordered) matrix holding the decomposition, its sparsity pattern is kept between updates.
+    std::unique_ptr<Matrix> ILU_;
+    //! \brief Size of the matrix the pattern of ILU_ was created for.
+    size_type patternRows_ = 0;
+    size_type patternNonzeroes_ = 0;
+    //! \brief Whether lower_, upper_ and inv_ have the layout of ILU_.
+    bool crsPatternValid_ = false;
 };
 
 } // end namespace Opm
@@ -20,11 +20,20 @@
 #ifndef OPM_PARALLELRESTRICTEDADDITIVESCHWARZ_HEADER_INCLUDED
 #define OPM_PARALLELRESTRICTEDADDITIVESCHWARZ_HEADER_INCLUDED
 
+#include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
 #include <dune/istl/preconditioner.hh>
 #include <dune/istl/paamg/smoother.hh>
+#include <dune/istl/solver.hh>
+#if HAVE_SUITESPARSE_UMFPACK
+#include <dune/istl/umfpack.hh>
+#endif
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
+#include <memory>
+#include <utility>
+
 namespace Opm
 {
 
@@ -223,6 +232,113 @@ private:
     const communication_type& communication_;
 };
 
+/// \brief Restricted additive Schwarz preconditioner owning its subdomain solver.
+///
+/// Like ParallelRestrictedOverlappingSchwarz, the subdomain solver is applied
+/// to the whole local matrix including the rows of the overlap cells, and the
+/// owner values are copied to all other processes afterwards. The subdomain
+/// solver is shared with the preconditioner and refactorized by update(). The
+/// size of the subdomains is given by the number of overlap layers of the grid.
+///
+/// \tparam Domain The type of the Vector representing the domain.
+/// \tparam Range The type of the Vector representing the range.
+/// \tparam ParallelInfo The type of the parallel information object
+///         used, e.g. Dune::OwnerOverlapCommunication
+template<class Range, class Domain, class ParallelInfo>
+class OwningRestrictedOverlappingSchwarz
+    : public Dune::PreconditionerWithUpdate<Domain,Range>
+{
+public:
+    //! \brief The type of the subdomain solver.
+    using LocalSolver = Dune::PreconditionerWithUpdate<Domain,Range>;
+
+    OwningRestrictedOverlappingSchwarz(std::shared_ptr<LocalSolver> local,
+                                       const ParallelInfo& comm)
+        : local_(std::move(local)), communication_(comm)
+    {   }
+
+    void pre (Domain& x, Range& b) override
+    {
+        communication_.copyOwnerToAll(x,x);     // make dirichlet values consistent
+        local_->pre(x,b);
+    }
+
+    void apply (Domain& v, const Range& d) override
+    {
+        // hack us a mutable d to prevent copying.
+        Range& md = const_cast<Range&>(d);
+        communication_.copyOwnerToAll(md,md);
+        local_->apply(v,d);
+        communication_.copyOwnerToAll(v,v);
+        // Make sure that d is the same as at the beginning of apply.
+        communication_.project(md);
+    }
+
+    void post (Domain& x) override
+    {
+        local_->post(x);
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::overlapping;
+    }
+
+    void update() override
+    {
+        local_->update();
+    }
+
+private:
+    std::shared_ptr<LocalSolver> local_;
+    const ParallelInfo& communication_;
+};
+
+#if HAVE_SUITESPARSE_UMFPACK
+/// \brief Sparse direct solve with UMFPack used as a (sequential) preconditioner.
+///
+/// Meant as the subdomain solver of OwningRestrictedOverlappingSchwarz.
+/// The matrix is refactorized by update().
+template<class Matrix, class Vector>
+class UMFPackPreconditioner
+    : public Dune::PreconditionerWithUpdate<Vector,Vector>
+{
+public:
+    explicit UMFPackPreconditioner(const Matrix& A)
+        : A_(A), solver_(A, 0)
+    {   }
+
+    void pre (Vector&, Vector&) override
+    {   }
+
+    void apply (Vector& v, const Vector& d) override
+    {
+        // UMFPack overwrites the right hand side.
+        rhs_ = d;
+        Dune::InverseOperatorResult res;
+        solver_.apply(v, rhs_, res);
+    }
+
+    void post (Vector&) override
+    {   }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+    void update() override
+    {
+        solver_.setMatrix(A_);
+    }
+
+private:
+    const Matrix& A_;
+    Dune::UMFPack<Matrix> solver_;
+    Vector rhs_;
+};
+#endif
+
 
 } // end namespace OPM
 #endif
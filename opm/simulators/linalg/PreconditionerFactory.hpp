@@ -22,9 +22,12 @@
 #ifndef OPM_PRECONDITIONERFACTORY_HEADER
 #define OPM_PRECONDITIONERFACTORY_HEADER
 
+#include <opm/simulators/linalg/HyprePreconditioner.hpp>
+#include <opm/simulators/linalg/MsrsbPreconditioner.hpp>
 #include <opm/simulators/linalg/OwningBlockPreconditioner.hpp>
 #include <opm/simulators/linalg/OwningTwoLevelPreconditioner.hpp>
 #include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/ParallelRestrictedAdditiveSchwarz.hpp>
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
 #include <opm/simulators/linalg/PropertyTree.hpp>
 #include <opm/simulators/linalg/amgcpr.hh>
@@ -45,7 +48,10 @@ namespace Opm
 /// user need only interact with the factory through the static
 /// methods addStandardPreconditioners() and create(). In addition
 /// a user can call the addCreator() static method to add further
-/// preconditioners.
+/// preconditioners. This is also how preconditioners from external
+/// libraries are plugged into the pressure stage of CPR: the type of the
+/// coarsesolver.preconditioner section selects the creator registered for
+/// the scalar pressure operator.
 template <class Operator, class Comm>
 class PreconditionerFactory
 {
@@ -186,6 +192,7 @@ private:
         smootherArgs.setN(iluwitdh);
         const MILU_VARIANT milu = convertString2Milu(prm.get<std::string>("milutype", std::string("ilu")));
         smootherArgs.setMilu(milu);
+        smootherArgs.setFloatFactors(floatIluFactors(prm, "smoother_precision"));
         // smootherArgs.overlap=SmootherArgs::vertex;
         // smootherArgs.overlap=SmootherArgs::none;
         // smootherArgs.overlap=SmootherArgs::aggregate;
@@ -234,21 +241,106 @@ private:
         }
     }
 
+    /// Whether an ILU preconditioner stores its factors in single precision.
+    /// The parameter key selects "double" (default) or "float" precision.
+    static bool floatIluFactors(const PropertyTree& prm, const std::string& key = "precision")
+    {
+        const auto precision = prm.get<std::string>(key, "double");
+        if (precision != "double" && precision != "float") {
+            OPM_THROW(std::invalid_argument, "Properties: ILU precision " << precision
+                      << " not supported. Please use double or float.");
+        }
+        return precision == "float";
+    }
+
     static PrecPtr
     createParILU(const Operator& op, const PropertyTree& prm, const Comm& comm, const int ilulevel)
     {
         const double w = prm.get<double>("relaxation", 1.0);
         const bool redblack = prm.get<bool>("redblack", false);
         const bool reorder_spheres = prm.get<bool>("reorder_spheres", false);
+        const bool reorder_rcm = prm.get<bool>("reorder_rcm", false);
         // Already a parallel preconditioner. Need to pass comm, but no need to wrap it in a BlockPreconditioner.
+        std::shared_ptr<Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Comm>> ilu;
         if (ilulevel == 0) {
             const size_t num_interior = interiorIfGhostLast(comm);
-            return std::make_shared<Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Comm>>(
-                op.getmat(), comm, w, Opm::MILU_VARIANT::ILU, num_interior, redblack, reorder_spheres);
+            ilu = std::make_shared<Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Comm>>(
+                op.getmat(), comm, w, Opm::MILU_VARIANT::ILU, num_interior, redblack, reorder_spheres, reorder_rcm);
         } else {
-            return std::make_shared<Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Comm>>(
-                op.getmat(), comm, ilulevel, w, Opm::MILU_VARIANT::ILU, redblack, reorder_spheres);
+            ilu = std::make_shared<Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Comm>>(
+                op.getmat(), comm, ilulevel, w, Opm::MILU_VARIANT::ILU, redblack, reorder_spheres, reorder_rcm);
+        }
+        ilu->setFloatFactors(floatIluFactors(prm));
+        ilu->setExchangeResult(prm.get<bool>("exchange_result", true));
+        return ilu;
+    }
+
+    /// Create the subdomain solver of a restricted additive Schwarz
+    /// preconditioner, i.e. ILU(n) of the local matrix (local_solver "ilu",
+    /// using "ilulevel", "relaxation" and "precision") or a sparse direct
+    /// solver ("umfpack"). In the serial case this is the whole preconditioner.
+    static PrecPtr createRASLocalSolver(const Operator& op, const PropertyTree& prm)
+    {
+        const auto localSolver = prm.get<std::string>("local_solver", "ilu");
+        if (localSolver == "ilu") {
+            const int n = prm.get<int>("ilulevel", 0);
+            const double w = prm.get<double>("relaxation", 1.0);
+            auto ilu = std::make_shared<Opm::ParallelOverlappingILU0<Matrix, Vector, Vector>>(
+                op.getmat(), n, w, Opm::MILU_VARIANT::ILU);
+            ilu->setFloatFactors(floatIluFactors(prm));
+            return ilu;
+        }
+#if HAVE_SUITESPARSE_UMFPACK
+        if (localSolver == "umfpack") {
+            if constexpr (std::is_same_v<typename Vector::field_type, double>) {
+                return std::make_shared<Opm::UMFPackPreconditioner<Matrix, Vector>>(op.getmat());
+            } else {
+                OPM_THROW(std::invalid_argument, "Properties: Local solver umfpack is only supported in double precision.");
+            }
         }
+#endif
+        OPM_THROW(std::invalid_argument, "Properties: Local solver " << localSolver << " not known for RAS.");
+    }
+
+    /// Create a restricted additive Schwarz preconditioner. The subdomain of
+    /// a process is its local matrix including the rows of the overlap cells,
+    /// hence its size is set by the number of overlap layers of the grid.
+    static PrecPtr
+    createRAS(const Operator& op, const PropertyTree& prm, const Comm& comm)
+    {
+        return std::make_shared<Opm::OwningRestrictedOverlappingSchwarz<Vector, Vector, Comm>>(
+            createRASLocalSolver(op, prm), comm);
+    }
+
+    /// Create a CPR preconditioner. The "pressure_precision" parameter selects
+    /// whether the coarse pressure system and its AMG hierarchy are stored and
+    /// applied in "double" (default) or "float" precision.
+    /// The optional comm argument is only passed in the parallel case.
+    template <bool transpose, class... CommArg>
+    static PrecPtr createCpr(const Operator& op, const PropertyTree& prm,
+                             const std::function<Vector()>& weightsCalculator,
+                             std::size_t pressureIndex, const CommArg&... comm)
+    {
+        if (pressureIndex == std::numeric_limits<std::size_t>::max())
+        {
+            OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
+        }
+        const auto precision = prm.get<std::string>("pressure_precision", "double");
+        if (precision == "double") {
+            return std::make_shared<OwningTwoLevelPreconditioner<Operator, Vector, transpose, Comm>>(op, prm, weightsCalculator,
+                                                                                                     pressureIndex, comm...);
+        }
+        if (precision == "float") {
+            if constexpr (std::is_same_v<typename Vector::field_type, double>) {
+                return std::make_shared<OwningTwoLevelPreconditioner<Operator, Vector, transpose, Comm, float>>(op, prm, weightsCalculator,
+                                                                                                                pressureIndex, comm...);
+            } else {
+                OPM_THROW(std::invalid_argument, "Properties: Pressure precision float is only supported"
+                          " for CPR of double precision systems.");
+            }
+        }
+        OPM_THROW(std::invalid_argument, "Properties: Pressure precision " << precision
+                  << " not supported for CPR. Please use double or float.");
     }
 
     // Add a useful default set of preconditioners to the factory.
@@ -272,6 +364,9 @@ private:
         doAddCreator("ILUn", [](const O& op, const P& prm, const std::function<Vector()>&, std::size_t, const C& comm) {
             return createParILU(op, prm, comm, prm.get<int>("ilulevel", 0));
         });
+        doAddCreator("RAS", [](const O& op, const P& prm, const std::function<Vector()>&, std::size_t, const C& comm) {
+            return createRAS(op, prm, comm);
+        });
         doAddCreator("Jac", [](const O& op, const P& prm, const std::function<Vector()>&,
                                std::size_t, const C& comm) {
             const int n = prm.get<int>("repeats", 1);
@@ -305,28 +400,30 @@ private:
                     using Smoother = Opm::ParallelOverlappingILU0<M, V, V, C>;
                     auto crit = amgCriterion(prm);
                     auto sargs = amgSmootherArgs<Smoother>(prm);
-                    return std::make_shared<Dune::Amg::AMGCPR<O, V, Smoother, C>>(op, crit, sargs, comm);
+                    auto amg = std::make_shared<Dune::Amg::AMGCPR<O, V, Smoother, C>>(op, crit, sargs, comm);
+                    amg->setRedundantCoarseSolve(prm.get<bool>("redundant_coarse_solve", false));
+                    return amg;
                 } else {
                     OPM_THROW(std::invalid_argument, "Properties: No smoother with name " << smoother << ".");
                 }
             });
         }
 
+#if HAVE_HYPRE && HAVE_MPI
+        if constexpr (M::block_type::rows == 1) {
+            doAddCreator("hypre", [](const O& op, const P& prm, const std::function<Vector()>&, std::size_t, const C& comm) {
+                return std::make_shared<Opm::HyprePreconditioner<M, V, C>>(op.getmat(), prm, comm);
+            });
+        }
+#endif
+
         doAddCreator("cpr", [](const O& op, const P& prm, const std::function<Vector()> weightsCalculator, std::size_t pressureIndex, const C& comm) {
             assert(weightsCalculator);
-            if (pressureIndex == std::numeric_limits<std::size_t>::max())
-            {
-                OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
-            }
-            return std::make_shared<OwningTwoLevelPreconditioner<O, V, false, Comm>>(op, prm, weightsCalculator, pressureIndex, comm);
+            return createCpr<false>(op, prm, weightsCalculator, pressureIndex, comm);
         });
         doAddCreator("cprt", [](const O& op, const P& prm, const std::function<Vector()> weightsCalculator, std::size_t pressureIndex, const C& comm) {
             assert(weightsCalculator);
-            if (pressureIndex == std::numeric_limits<std::size_t>::max())
-            {
-                OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
-            }
-            return std::make_shared<OwningTwoLevelPreconditioner<O, V, true, Comm>>(op, prm, weightsCalculator, pressureIndex, comm);
+            return createCpr<true>(op, prm, weightsCalculator, pressureIndex, comm);
         });
     }
 
@@ -341,20 +438,30 @@ private:
         using P = PropertyTree;
         doAddCreator("ILU0", [](const O& op, const P& prm, const std::function<Vector()>&, std::size_t) {
             const double w = prm.get<double>("relaxation", 1.0);
-            return std::make_shared<Opm::ParallelOverlappingILU0<M, V, V>>(
+            auto ilu = std::make_shared<Opm::ParallelOverlappingILU0<M, V, V>>(
                 op.getmat(), 0, w, Opm::MILU_VARIANT::ILU);
+            ilu->setFloatFactors(floatIluFactors(prm));
+            return ilu;
         });
         doAddCreator("ParOverILU0", [](const O& op, const P& prm, const std::function<Vector()>&, std::size_t) {
             const double w = prm.get<double>("relaxation", 1.0);
             const int n = prm.get<int>("ilulevel", 0);
-            return std::make_shared<Opm::ParallelOverlappingILU0<M, V, V>>(
-                op.getmat(), n, w, Opm::MILU_VARIANT::ILU);
+            const bool reorder_rcm = prm.get<bool>("reorder_rcm", false);
+            auto ilu = std::make_shared<Opm::ParallelOverlappingILU0<M, V, V>>(
+                op.getmat(), n, w, Opm::MILU_VARIANT::ILU, false, true, reorder_rcm);
+            ilu->setFloatFactors(floatIluFactors(prm));
+            return ilu;
         });
         doAddCreator("ILUn", [](const O& op, const P& prm, const std::function<Vector()>&, std::size_t) {
             const int n = prm.get<int>("ilulevel", 0);
             const double w = prm.get<double>("relaxation", 1.0);
-            return std::make_shared<Opm::ParallelOverlappingILU0<M, V, V>>(
+            auto ilu = std::make_shared<Opm::ParallelOverlappingILU0<M, V, V>>(
                 op.getmat(), n, w, Opm::MILU_VARIANT::ILU);
+            ilu->setFloatFactors(floatIluFactors(prm));
+            return ilu;
+        });
+        doAddCreator("RAS", [](const O& op, const P& prm, const std::function<Vector()>&, std::size_t) {
+            return createRASLocalSolver(op, prm);
         });
         doAddCreator("Jac", [](const O& op, const P& prm, const std::function<Vector()>&, std::size_t) {
             const int n = prm.get<int>("repeats", 1);
@@ -449,19 +556,24 @@ private:
                 return wrapPreconditioner<Dune::Amg::FastAMG<O, V>>(op, crit, parms);
             });
         }
+#if HAVE_HYPRE && HAVE_MPI
+        if constexpr (M::block_type::rows == 1) {
+            doAddCreator("hypre", [](const O& op, const P& prm, const std::function<Vector()>&, std::size_t) {
+                return std::make_shared<Opm::HyprePreconditioner<M, V, Dune::Amg::SequentialInformation>>(
+                    op.getmat(), prm, Dune::Amg::SequentialInformation());
+            });
+        }
+#endif
+        if constexpr (M::block_type::rows == 1) {
+            doAddCreator("msrsb", [](const O& op, const P& prm, const std::function<Vector()>&, std::size_t) {
+                return std::make_shared<Opm::MsrsbPreconditioner<M, V>>(op.getmat(), prm);
+            });
+        }
         doAddCreator("cpr", [](const O& op, const P& prm, const std::function<Vector()>& weightsCalculator, std::size_t pressureIndex) {
-                                if (pressureIndex == std::numeric_limits<std::size_t>::max())
-                                {
-                                    OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
-                                }
-                                return std::make_shared<OwningTwoLevelPreconditioner<O, V, false>>(op, prm, weightsCalculator, pressureIndex);
+                                return createCpr<false>(op, prm, weightsCalculator, pressureIndex);
         });
         doAddCreator("cprt", [](const O& op, const P& prm, const std::function<Vector()>& weightsCalculator, std::size_t pressureIndex) {
-                                if (pressureIndex == std::numeric_limits<std::size_t>::max())
-                                {
-                                    OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
-                                }
-                                 return std::make_shared<OwningTwoLevelPreconditioner<O, V, true>>(op, prm, weightsCalculator, pressureIndex);
+                                return createCpr<true>(op, prm, weightsCalculator, pressureIndex);
         });
     }
 
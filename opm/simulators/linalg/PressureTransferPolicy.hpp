@@ -22,6 +22,7 @@
 #define OPM_PRESSURE_TRANSFER_POLICY_HEADER_INCLUDED
 
 
+#include <opm/simulators/linalg/extractPressureMatrix.hpp>
 #include <opm/simulators/linalg/twolevelmethodcpr.hh>
 
 
@@ -47,16 +48,7 @@ public:
     virtual void createCoarseLevelSystem(const FineOperator& fineOperator) override
     {
         using CoarseMatrix = typename CoarseOperator::matrix_type;
-        const auto& fineLevelMatrix = fineOperator.getmat();
-        coarseLevelMatrix_.reset(new CoarseMatrix(fineLevelMatrix.N(), fineLevelMatrix.M(), CoarseMatrix::row_wise));
-        auto createIter = coarseLevelMatrix_->createbegin();
-
-        for (const auto& row : fineLevelMatrix) {
-            for (auto col = row.begin(), cend = row.end(); col != cend; ++col) {
-                createIter.insert(col.index());
-            }
-            ++createIter;
-        }
+        coarseLevelMatrix_ = Amg::createPressureMatrixPattern<CoarseMatrix>(fineOperator.getmat());
 
         calculateCoarseEntries(fineOperator);
         coarseLevelCommunication_.reset(communication_, [](Communication*) {});
@@ -75,30 +67,8 @@ public:
 
     virtual void calculateCoarseEntries(const FineOperator& fineOperator) override
     {
-        const auto& fineMatrix = fineOperator.getmat();
-        *coarseLevelMatrix_ = 0;
-        auto rowCoarse = coarseLevelMatrix_->begin();
-        for (auto row = fineMatrix.begin(), rowEnd = fineMatrix.end(); row != rowEnd; ++row, ++rowCoarse) {
-            assert(row.index() == rowCoarse.index());
-            auto entryCoarse = rowCoarse->begin();
-            for (auto entry = row->begin(), entryEnd = row->end(); entry != entryEnd; ++entry, ++entryCoarse) {
-                assert(entry.index() == entryCoarse.index());
-                double matrix_el = 0;
-                if (transpose) {
-                    const auto& bw = weights_[entry.index()];
-                    for (size_t i = 0; i < bw.size(); ++i) {
-                        matrix_el += (*entry)[pressure_var_index_][i] * bw[i];
-                    }
-                } else {
-                    const auto& bw = weights_[row.index()];
-                    for (size_t i = 0; i < bw.size(); ++i) {
-                        matrix_el += (*entry)[i][pressure_var_index_] * bw[i];
-                    }
-                }
-                (*entryCoarse) = matrix_el;
-            }
-        }
-        assert(rowCoarse == coarseLevelMatrix_->end());
+        Amg::calculatePressureMatrixEntries<transpose>(fineOperator.getmat(), weights_,
+                                                       pressure_var_index_, *coarseLevelMatrix_);
     }
 
     virtual void moveToCoarseLevel(const typename ParentType::FineRangeType& fine) override
@@ -90,6 +90,11 @@ PropertyTree::get_child_optional(const std::string& key) const
   return PropertyTree(pt.get());
 }
 
+void PropertyTree::put_child(const std::string& key, const PropertyTree& tree)
+{
+  tree_->put_child(key, *tree.tree_);
+}
+
 PropertyTree& PropertyTree::operator=(const PropertyTree& tree)
 {
   tree_ = std::make_unique<boost::property_tree::ptree>(*tree.tree_);
@@ -54,6 +54,8 @@ public:
 
     std::optional<PropertyTree> get_child_optional(const std::string& key) const;
 
+    void put_child(const std::string& key, const PropertyTree& tree);
+
     PropertyTree& operator=(const PropertyTree& tree);
 
     void write_json(std::ostream& os, bool pretty) const;
@@ -0,0 +1,174 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_RECYCLINGSOLVER_HEADER_INCLUDED
+#define OPM_RECYCLINGSOLVER_HEADER_INCLUDED
+
+#include <dune/common/timer.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/scalarproducts.hh>
+#include <dune/istl/solver.hh>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// \brief Krylov solver wrapper that recycles the solutions of previous solves.
+///
+/// The corrections computed by the last few solves span a subspace that
+/// typically contains the slow, pressure dominated modes of the following
+/// systems, since the Jacobians of successive Newton iterations differ
+/// little. Before each solve, the residual is minimised over this subspace
+/// for the current operator (one operator application per recycled vector),
+/// and the wrapped solver only has to compute the remaining correction.
+/// The convergence criterion stays relative to the residual of the initial
+/// guess given by the caller.
+template <class X>
+class RecyclingSolver : public Dune::InverseOperator<X, X>
+{
+public:
+    RecyclingSolver(Dune::LinearOperator<X, X>& op,
+                    Dune::ScalarProduct<X>& sp,
+                    std::shared_ptr<Dune::InverseOperator<X, X>> solver,
+                    const double reduction,
+                    const std::size_t maxVectors)
+        : op_(op)
+        , sp_(sp)
+        , solver_(std::move(solver))
+        , reduction_(reduction)
+        , maxVectors_(maxVectors)
+    {
+    }
+
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+    {
+        apply(x, b, reduction_, res);
+    }
+
+    void apply(X& x, X& b, double reduction, Dune::InverseOperatorResult& res) override
+    {
+        Dune::Timer watch;
+        const X x0(x);
+        if (!vectors_.empty() && vectors_.front().size() != x.size()) {
+            vectors_.clear();
+        }
+        if (vectors_.empty()) {
+            solver_->apply(x, b, reduction, res);
+        } else {
+            X r(b);
+            op_.applyscaleadd(-1.0, x, r);
+            const double def0 = sp_.norm(r);
+            project(x, r);
+            const double def = sp_.norm(r);
+
+            if (def <= def0 * reduction) {
+                // The recycled subspace already contains a good enough solution.
+                res.clear();
+                res.converged = true;
+                res.reduction = def0 > 0.0 ? def / def0 : 0.0;
+                res.elapsed = watch.elapsed();
+                b = r;
+            } else {
+                solver_->apply(x, b, reduction * def0 / def, res);
+                res.reduction *= def / def0;
+                res.elapsed = watch.elapsed();
+            }
+        }
+
+        X correction(x);
+        correction -= x0;
+        vectors_.push_back(std::move(correction));
+        if (vectors_.size() > maxVectors_) {
+            vectors_.erase(vectors_.begin());
+        }
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return op_.category();
+    }
+
+    /// Take the recycled vectors, e.g. to hand them to a new solver of the same system.
+    std::vector<X> releaseVectors()
+    {
+        std::vector<X> vectors;
+        vectors.swap(vectors_);
+        return vectors;
+    }
+
+    /// Set the recycled vectors, the most recent last.
+    void setVectors(std::vector<X> vectors)
+    {
+        vectors_ = std::move(vectors);
+        if (vectors_.size() > maxVectors_) {
+            vectors_.erase(vectors_.begin(), vectors_.end() - maxVectors_);
+        }
+    }
+
+private:
+    /// Minimise the residual r of x over the recycled subspace. The images of
+    /// the recycled vectors under the operator are orthonormalised with modified
+    /// Gram-Schmidt, and the vectors are transformed alike.
+    void project(X& x, X& r)
+    {
+        std::vector<X> images;
+        std::vector<X> basis;
+        images.reserve(vectors_.size());
+        basis.reserve(vectors_.size());
+        for (const auto& v : vectors_) {
+            X u(v);
+            X c(v);
+            op_.apply(u, c);
+            const double norm0 = sp_.norm(c);
+            for (std::size_t j = 0; j < images.size(); ++j) {
+                const auto h = sp_.dot(images[j], c);
+                c.axpy(-h, images[j]);
+                u.axpy(-h, basis[j]);
+            }
+            const double norm = sp_.norm(c);
+            // Skip vectors that are (numerically) in the span of the previous ones.
+            if (!(norm > 1e-10 * norm0)) {
+                continue;
+            }
+            c /= norm;
+            u /= norm;
+
+            const auto alpha = sp_.dot(c, r);
+            x.axpy(alpha, u);
+            r.axpy(-alpha, c);
+            images.push_back(std::move(c));
+            basis.push_back(std::move(u));
+        }
+    }
+
+    Dune::LinearOperator<X, X>& op_;
+    Dune::ScalarProduct<X>& sp_;
+    std::shared_ptr<Dune::InverseOperator<X, X>> solver_;
+    double reduction_;
+    std::size_t maxVectors_;
+    std::vector<X> vectors_;
+};
+
+} // namespace Opm
+
+#endif // OPM_RECYCLINGSOLVER_HEADER_INCLUDED
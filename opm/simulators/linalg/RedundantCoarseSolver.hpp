@@ -0,0 +1,293 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_REDUNDANTCOARSESOLVER_HEADER_INCLUDED
+#define OPM_REDUNDANTCOARSESOLVER_HEADER_INCLUDED
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <dune/common/timer.hh>
+#include <dune/common/version.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/scalarproducts.hh>
+#include <dune/istl/solver.hh>
+#include <dune/istl/solvers.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// \brief Solver of a small distributed system on every process.
+///
+/// The rows owned by each process are gathered on all processes of the
+/// communicator once, when the solver is set up. Every solve then needs a
+/// single collective call to gather the right hand side. Each process
+/// solves the whole system, and takes the values of all its local indices
+/// from that solution, hence the result is consistent without further
+/// communication.
+///
+/// This is meant for the coarsest level of a parallel AMG, where the
+/// iterative solve with one global reduction per iteration is dominated
+/// by latency on many processes. The gathered system is solved with
+/// the given direct solver. If there is none, a sequential ILU0
+/// preconditioned BiCGSTAB with the given reduction is used.
+template <class Matrix, class X, class PI>
+class RedundantCoarseSolver : public Dune::InverseOperator<X, X>
+{
+public:
+    using block_type = typename Matrix::block_type;
+    using field_type = typename Matrix::field_type;
+
+    /// \param A           the local part of the distributed matrix
+    /// \param pinfo       the parallel information of A
+    /// \param directSolver creates a direct solver of the gathered matrix,
+    ///                    may return nullptr
+    /// \param reduction   reduction of the iterative fallback solver
+    template <class DirectSolverCreator>
+    RedundantCoarseSolver(const Matrix& A, const PI& pinfo,
+                          const DirectSolverCreator& directSolver,
+                          const double reduction)
+        : pinfo_(pinfo)
+        , reduction_(reduction)
+    {
+        gatherMatrix(A);
+        solver_.reset(directSolver(*matrix_));
+        if (!solver_) {
+            op_ = std::make_unique<Dune::MatrixAdapter<Matrix, X, X>>(*matrix_);
+            prec_ = std::make_unique<SeqILU>(*matrix_, 1.0);
+            solver_ = std::make_shared<Dune::BiCGSTABSolver<X>>(*op_, sp_, *prec_, reduction_, 1000, 0);
+        }
+    }
+
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+    {
+        apply(x, b, reduction_, res);
+    }
+
+    void apply(X& x, X& b, double reduction, Dune::InverseOperatorResult& res) override
+    {
+        Dune::Timer watch;
+        for (std::size_t i = 0; i < owned_.size(); ++i) {
+            copyBlock(b[owned_[i]], &localValues_[i * blockSize]);
+        }
+        pinfo_.communicator().allgatherv(localValues_.data(), localValues_.size(), globalValues_.data(),
+                                         valueCounts_.data(), valueDisplacements_.data());
+        for (std::size_t k = 0; k < globalB_.size(); ++k) {
+            for (int i = 0; i < blockSize; ++i) {
+                globalB_[k][i] = globalValues_[k * blockSize + i];
+            }
+        }
+
+        globalX_ = 0;
+        solver_->apply(globalX_, globalB_, reduction, res);
+
+        for (std::size_t i = 0; i < localPositions_.size(); ++i) {
+            if (localPositions_[i] != noPosition) {
+                x[i] = globalX_[localPositions_[i]];
+            }
+        }
+        res.elapsed = watch.elapsed();
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::overlapping;
+    }
+
+private:
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 7)
+    using SeqILU = Dune::SeqILU<Matrix, X, X>;
+#else
+    using SeqILU = Dune::SeqILU0<Matrix, X, X>;
+#endif
+
+    static constexpr int blockSize = X::block_type::dimension;
+    static constexpr std::size_t noPosition = std::numeric_limits<std::size_t>::max();
+
+    template <class Block>
+    static void copyBlock(const Block& block, field_type* values)
+    {
+        for (int i = 0; i < blockSize; ++i) {
+            values[i] = block[i];
+        }
+    }
+
+    /// Gather the owned rows of all processes. The gathered rows are
+    /// numbered in the order of the processes and of their local indices.
+    void gatherMatrix(const Matrix& A)
+    {
+        const auto& comm = pinfo_.communicator();
+
+        std::vector<int> localToGlobal(A.N(), -1);
+        for (const auto& index : pinfo_.indexSet()) {
+            const std::size_t local = index.local().local();
+            localToGlobal[local] = index.global();
+            if (index.local().attribute() == Dune::OwnerOverlapCopyAttributeSet::owner) {
+                owned_.push_back(local);
+            }
+        }
+        std::sort(owned_.begin(), owned_.end());
+
+        // the global indices, sizes, columns and values of the owned rows
+        std::vector<int> rowGlobal;
+        std::vector<int> rowSizes;
+        std::vector<int> cols;
+        std::vector<field_type> values;
+        constexpr int entriesPerBlock = block_type::rows * block_type::cols;
+        for (const auto row : owned_) {
+            rowGlobal.push_back(localToGlobal[row]);
+            rowSizes.push_back(A[row].size());
+            for (auto col = A[row].begin(), cend = A[row].end(); col != cend; ++col) {
+                if (localToGlobal[col.index()] < 0) {
+                    OPM_THROW(std::logic_error, "Redundant coarse solve: column " << col.index()
+                              << " is not in the index set");
+                }
+                cols.push_back(localToGlobal[col.index()]);
+                for (int i = 0; i < block_type::rows; ++i) {
+                    for (int j = 0; j < block_type::cols; ++j) {
+                        values.push_back((*col)[i][j]);
+                    }
+                }
+            }
+        }
+
+        const int numProcs = comm.size();
+        std::vector<int> rowCounts(numProcs);
+        std::vector<int> nnzCounts(numProcs);
+        const int numRows = rowGlobal.size();
+        const int nnz = cols.size();
+        comm.allgather(&numRows, 1, rowCounts.data());
+        comm.allgather(&nnz, 1, nnzCounts.data());
+
+        const auto displacements = [](const std::vector<int>& counts) {
+            std::vector<int> displ(counts.size() + 1, 0);
+            std::partial_sum(counts.begin(), counts.end(), displ.begin() + 1);
+            return displ;
+        };
+        auto rowDispl = displacements(rowCounts);
+        auto nnzDispl = displacements(nnzCounts);
+        const std::size_t totalRows = rowDispl.back();
+        const std::size_t totalNnz = nnzDispl.back();
+
+        std::vector<int> allRowGlobal(totalRows);
+        std::vector<int> allRowSizes(totalRows);
+        std::vector<int> allCols(totalNnz);
+        std::vector<field_type> allValues(totalNnz * entriesPerBlock);
+        comm.allgatherv(rowGlobal.data(), numRows, allRowGlobal.data(), rowCounts.data(), rowDispl.data());
+        comm.allgatherv(rowSizes.data(), numRows, allRowSizes.data(), rowCounts.data(), rowDispl.data());
+        comm.allgatherv(cols.data(), nnz, allCols.data(), nnzCounts.data(), nnzDispl.data());
+        std::vector<int> valueCounts(numProcs);
+        std::vector<int> valueDispl(numProcs + 1);
+        for (int p = 0; p < numProcs; ++p) {
+            valueCounts[p] = nnzCounts[p] * entriesPerBlock;
+            valueDispl[p] = nnzDispl[p] * entriesPerBlock;
+        }
+        comm.allgatherv(values.data(), nnz * entriesPerBlock, allValues.data(),
+                        valueCounts.data(), valueDispl.data());
+
+        // position of a global index in the gathered system
+        std::vector<std::pair<int, std::size_t>> positions(totalRows);
+        for (std::size_t k = 0; k < totalRows; ++k) {
+            positions[k] = {allRowGlobal[k], k};
+        }
+        std::sort(positions.begin(), positions.end());
+        const auto position = [&positions](const int global) {
+            auto it = std::lower_bound(positions.begin(), positions.end(), std::make_pair(global, std::size_t(0)));
+            if (it == positions.end() || it->first != global) {
+                return noPosition;
+            }
+            return it->second;
+        };
+
+        matrix_ = std::make_unique<Matrix>(totalRows, totalRows, totalNnz, Matrix::row_wise);
+        std::size_t entry = 0;
+        for (auto row = matrix_->createbegin(), rend = matrix_->createend(); row != rend; ++row) {
+            for (int j = 0; j < allRowSizes[row.index()]; ++j, ++entry) {
+                const auto col = position(allCols[entry]);
+                if (col == noPosition) {
+                    OPM_THROW(std::logic_error, "Redundant coarse solve: global index " << allCols[entry]
+                              << " is not owned by any process");
+                }
+                row.insert(col);
+            }
+        }
+        entry = 0;
+        for (std::size_t row = 0; row < totalRows; ++row) {
+            for (int j = 0; j < allRowSizes[row]; ++j, ++entry) {
+                auto& block = (*matrix_)[row][position(allCols[entry])];
+                const field_type* v = &allValues[entry * entriesPerBlock];
+                for (int i = 0; i < block_type::rows; ++i) {
+                    for (int l = 0; l < block_type::cols; ++l) {
+                        block[i][l] = *v++;
+                    }
+                }
+            }
+        }
+
+        localPositions_.resize(A.N(), noPosition);
+        for (std::size_t i = 0; i < localPositions_.size(); ++i) {
+            if (localToGlobal[i] >= 0) {
+                localPositions_[i] = position(localToGlobal[i]);
+            }
+        }
+
+        localValues_.resize(owned_.size() * blockSize);
+        globalValues_.resize(totalRows * blockSize);
+        valueCounts_.resize(numProcs);
+        valueDisplacements_.resize(numProcs);
+        for (int p = 0; p < numProcs; ++p) {
+            valueCounts_[p] = rowCounts[p] * blockSize;
+            valueDisplacements_[p] = rowDispl[p] * blockSize;
+        }
+        globalB_.resize(totalRows);
+        globalX_.resize(totalRows);
+    }
+
+    const PI& pinfo_;
+    double reduction_;
+    std::unique_ptr<Matrix> matrix_;
+    std::shared_ptr<Dune::InverseOperator<X, X>> solver_;
+    // the iterative fallback
+    std::unique_ptr<Dune::MatrixAdapter<Matrix, X, X>> op_;
+    std::unique_ptr<SeqILU> prec_;
+    Dune::SeqScalarProduct<X> sp_;
+
+    std::vector<std::size_t> owned_;
+    std::vector<std::size_t> localPositions_;
+    std::vector<field_type> localValues_;
+    std::vector<field_type> globalValues_;
+    std::vector<int> valueCounts_;
+    std::vector<int> valueDisplacements_;
+    X globalB_;
+    X globalX_;
+};
+
+} // namespace Opm
+
+#endif // OPM_REDUNDANTCOARSESOLVER_HEADER_INCLUDED
@@ -0,0 +1,73 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_TIMEDSCALARPRODUCT_HEADER_INCLUDED
+#define OPM_TIMEDSCALARPRODUCT_HEADER_INCLUDED
+
+#include <opm/simulators/utils/TimingRegistry.hpp>
+
+#include <dune/istl/scalarproducts.hh>
+#include <dune/istl/solvercategory.hh>
+
+#include <memory>
+#include <utility>
+
+namespace Opm
+{
+
+/// \brief Scalar product that adds the time of the wrapped one to the MPI wait region.
+///
+/// The global reductions of the dot products and norms are where the Krylov
+/// solvers wait for the slowest process, the local part is small in comparison.
+template <class X>
+class TimedScalarProduct : public Dune::ScalarProduct<X>
+{
+public:
+    using field_type = typename Dune::ScalarProduct<X>::field_type;
+    using real_type = typename Dune::ScalarProduct<X>::real_type;
+
+    explicit TimedScalarProduct(std::shared_ptr<Dune::ScalarProduct<X>> sp)
+        : sp_(std::move(sp))
+    {
+    }
+
+    field_type dot(const X& x, const X& y) const override
+    {
+        ScopedTimer waitTimer(TimingRegistry::Region::MpiWait);
+        return sp_->dot(x, y);
+    }
+
+    real_type norm(const X& x) const override
+    {
+        ScopedTimer waitTimer(TimingRegistry::Region::MpiWait);
+        return sp_->norm(x);
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return sp_->category();
+    }
+
+private:
+    std::shared_ptr<Dune::ScalarProduct<X>> sp_;
+};
+
+} // namespace Opm
+
+#endif // OPM_TIMEDSCALARPRODUCT_HEADER_INCLUDED
@@ -22,8 +22,15 @@
 #ifndef OPM_WELLOPERATORS_HEADER_INCLUDED
 #define OPM_WELLOPERATORS_HEADER_INCLUDED
 
+#include <opm/simulators/linalg/BlockSpMV.hpp>
+#include <opm/simulators/linalg/HaloExchange.hpp>
+
 #include <dune/istl/operators.hh>
 
+#include <cstddef>
+#include <memory>
+#include <vector>
+
 
 namespace Opm
 {
@@ -126,7 +133,7 @@ public:
 
   virtual void apply( const X& x, Y& y ) const override
   {
-    A_.mv( x, y );
+    detail::blockMv( A_, x, y );
 
     // add well model modification to y
     wellOper_.apply(x, y );
@@ -140,7 +147,7 @@ public:
   // y += \alpha * A * x
   virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const override
   {
-    A_.usmv(alpha,x,y);
+    detail::blockUsmv( alpha, A_, x, y );
 
     // add scaled well model modification to y
     wellOper_.applyscaleadd( alpha, x, y );
@@ -167,6 +174,12 @@ protected:
    This is similar to WellModelMatrixAdapter, with the difference that
    here we assume a parallel ordering of rows, where ghost rows are
    located after interior rows.
+
+   If a halo exchange is given, the input vector does not need to be
+   consistent on the ghost rows. The owner values are then sent to the
+   ghost rows of the other processes while the interior rows that do not
+   couple to ghost rows are multiplied, and only the remaining rows wait
+   for the exchange.
  */
 template<class M, class X, class Y, bool overlapping >
 class WellModelGhostLastMatrixAdapter : public Dune::AssembledLinearOperator<M,X,Y>
@@ -179,6 +192,7 @@ public:
 
 #if HAVE_MPI
     typedef Dune::OwnerOverlapCopyCommunication<int,int> communication_type;
+    typedef HaloExchange<X> halo_exchange_type;
 #else
     typedef Dune::CollectiveCommunication< int > communication_type;
 #endif
@@ -197,14 +211,43 @@ public:
         : A_( A ), wellOper_( wellOper ), interiorSize_(interiorSize)
     {}
 
+#if HAVE_MPI
+    //! constructor: overlap the halo exchange of the input vector with the interior rows
+    WellModelGhostLastMatrixAdapter (const M& A,
+                                     const Dune::LinearOperator<X, Y>& wellOper,
+                                     const size_t interiorSize,
+                                     std::shared_ptr<halo_exchange_type> haloExchange )
+        : A_( A ), wellOper_( wellOper ), interiorSize_(interiorSize),
+          haloExchange_(std::move(haloExchange))
+    {
+        // Split the interior rows by whether they couple to ghost rows.
+        for (auto row = A_.begin(); row.index() < interiorSize_; ++row) {
+            bool boundary = false;
+            for (auto col = row->begin(), cend = row->end(); col != cend; ++col) {
+                if (col.index() >= interiorSize_) {
+                    boundary = true;
+                    break;
+                }
+            }
+            (boundary ? boundaryRows_ : innerRows_).push_back(row.index());
+        }
+    }
+#endif
+
     virtual void apply( const X& x, Y& y ) const override
     {
-        for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
+#if HAVE_MPI
+        if (haloExchange_) {
+            haloExchange_->start(x);
+            detail::blockSpMVRows<false>( A_, x, y, 1.0, innerRows_ );
+            // Only the ghost rows of x are written, which makes x consistent.
+            // As for the preconditioners, x is not const in the solvers.
+            haloExchange_->finish(const_cast<X&>(x));
+            detail::blockSpMVRows<false>( A_, x, y, 1.0, boundaryRows_ );
+        } else
+#endif
         {
-            y[row.index()]=0;
-            auto endc = (*row).end();
-            for (auto col = (*row).begin(); col != endc; ++col)
-                (*col).umv(x[col.index()], y[row.index()]);
+            detail::blockMv( A_, x, y, interiorSize_ );
         }
 
         // add well model modification to y
@@ -216,11 +259,16 @@ public:
     // y += \alpha * A * x
     virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const override
     {
-        for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
+#if HAVE_MPI
+        if (haloExchange_) {
+            haloExchange_->start(x);
+            detail::blockSpMVRows<true>( A_, x, y, alpha, innerRows_ );
+            haloExchange_->finish(const_cast<X&>(x));
+            detail::blockSpMVRows<true>( A_, x, y, alpha, boundaryRows_ );
+        } else
+#endif
         {
-            auto endc = (*row).end();
-            for (auto col = (*row).begin(); col != endc; ++col)
-                (*col).usmv(alpha, x[col.index()], y[row.index()]);
+            detail::blockUsmv( alpha, A_, x, y, interiorSize_ );
         }
         // add scaled well model modification to y
         wellOper_.applyscaleadd( alpha, x, y );
@@ -241,6 +289,12 @@ protected:
     const matrix_type& A_ ;
     const Dune::LinearOperator<X, Y>& wellOper_;
     size_t interiorSize_;
+#if HAVE_MPI
+    std::shared_ptr<halo_exchange_type> haloExchange_;
+    //! \brief Interior rows without and with couplings to ghost rows.
+    std::vector<std::size_t> innerRows_;
+    std::vector<std::size_t> boundaryRows_;
+#endif
 };
 
 } // namespace Opm
@@ -7,6 +7,7 @@
 // dune-istl release 2.6.0. Modifications have been kept as minimal as possible.
 
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/simulators/linalg/RedundantCoarseSolver.hpp>
 
 #include <dune/common/exceptions.hh>
 #include <dune/istl/paamg/smoother.hh>
@@ -241,6 +242,21 @@ namespace Dune
        */
       virtual void update();
 
+      /**
+       * @brief Select whether every process solves the whole coarsest system.
+       *
+       * In parallel the coarsest system is gathered on all processes of the
+       * coarsest level, which replaces the parallel iterative coarse solve
+       * by one collective call per cycle, see Opm::RedundantCoarseSolver.
+       */
+      void setRedundantCoarseSolve(bool redundant)
+      {
+        if (redundant != redundantCoarseSolve_) {
+          redundantCoarseSolve_ = redundant;
+          setupCoarseSolver();
+        }
+      }
+
       /**
        * @brief Check whether the coarse solver used is a direct solver.
        * @return True if the coarse level solver is a direct solver.
@@ -385,6 +401,8 @@ namespace Dune
       SolverCategory::Category category_;
       /** @brief The verbosity level. */
       std::size_t verbosity_;
+      /** @brief Whether every process solves the whole coarsest system. */
+      bool redundantCoarseSolve_ = false;
     };
 
     template<class M, class X, class S, class PI, class A>
@@ -398,7 +416,8 @@ namespace Dune
       additive(amg.additive), coarsesolverconverged(amg.coarsesolverconverged),
       coarseSmoother_(amg.coarseSmoother_),
       category_(amg.category_),
-      verbosity_(amg.verbosity_)
+      verbosity_(amg.verbosity_),
+      redundantCoarseSolve_(amg.redundantCoarseSolve_)
     {
       if(amg.rhs_)
         rhs_.reset( new Hierarchy<Range,A>(*amg.rhs_) );
@@ -521,6 +540,33 @@ namespace Dune
          && ( ! matrices_->redistributeInformation().back().isSetup() ||
               matrices_->parallelInformation().coarsest().getRedistributed().communicator().size() ) )
       {
+        typedef DirectSolverSelector< typename M::matrix_type, X > SolverSelector;
+
+        if constexpr (!std::is_same<PI,SequentialInformation>::value) {
+          const bool redistributed = matrices_->redistributeInformation().back().isSetup();
+          const auto& coarseInfo = redistributed ? matrices_->parallelInformation().coarsest().getRedistributed()
+                                                 : *matrices_->parallelInformation().coarsest();
+          if (redundantCoarseSolve_ && coarseInfo.communicator().size() > 1) {
+            const auto& coarseMatrix = redistributed ? matrices_->matrices().coarsest().getRedistributed().getmat()
+                                                     : matrices_->matrices().coarsest()->getmat();
+            auto directSolver = [](const auto& mat) -> CoarseSolver* {
+              if constexpr (SolverSelector::isDirectSolver) {
+                return SolverSelector::create(mat, false, false);
+              } else {
+                return nullptr;
+              }
+            };
+            coarseSmoother_.reset();
+            scalarProduct_.reset();
+            solver_ = std::make_shared<Opm::RedundantCoarseSolver<typename M::matrix_type, X, PI>>(coarseMatrix, coarseInfo,
+                                                                                                 directSolver, 1E-2);
+            if(verbosity_>0 && coarseInfo.communicator().rank()==0)
+              std::cout<< "Solving the coarsest system redundantly on " << coarseInfo.communicator().size()
+                       << " processes" << std::endl;
+            return;
+          }
+        }
+
         // We have the carsest level. Create the coarse Solver
         SmootherArgs sargs(smootherArgs_);
         sargs.iterations = 1;
@@ -545,8 +591,6 @@ namespace Dune
         scalarProduct_ = createScalarProduct<X>(cargs.getComm(),category());
 
 
-        typedef DirectSolverSelector< typename M::matrix_type, X > SolverSelector;
-
         // Use superlu if we are purely sequential or with only one processor on the coarsest level.
         if( SolverSelector::isDirectSolver &&
             (std::is_same<ParallelInformation,SequentialInformation>::value // sequential mode
@@ -877,7 +921,9 @@ namespace Dune
           levelContext.redist->redistributeBackward(*levelContext.update, levelContext.update.getRedistributed());
           levelContext.pinfo->copyOwnerToAll(*levelContext.update, *levelContext.update);
         }else{
-          levelContext.pinfo->copyOwnerToAll(*levelContext.rhs, *levelContext.rhs);
+          // The redundant coarse solve only uses the owned values.
+          if (!redundantCoarseSolve_)
+            levelContext.pinfo->copyOwnerToAll(*levelContext.rhs, *levelContext.rhs);
           solver_->apply(*levelContext.update, *levelContext.rhs, res);
         }
 
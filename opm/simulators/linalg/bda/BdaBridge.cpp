@@ -26,6 +26,8 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/material/common/Unused.hpp>
 
+#include <algorithm>
+
 #include <opm/simulators/linalg/bda/BdaBridge.hpp>
 #include <opm/simulators/linalg/bda/BdaResult.hpp>
 
@@ -64,13 +66,14 @@ BdaBridge<BridgeMatrix, BridgeVector, block_size>::BdaBridge(std::string acceler
                                                              [[maybe_unused]] unsigned int platformID,
                                                              unsigned int deviceID,
                                                              [[maybe_unused]] std::string opencl_ilu_reorder,
-                                                             [[maybe_unused]] std::string linsolver)
+                                                             [[maybe_unused]] std::string linsolver,
+                                                             [[maybe_unused]] const std::string& opencl_program_cache)
 : verbosity(linear_solver_verbosity), accelerator_mode(accelerator_mode_)
 {
     if (accelerator_mode.compare("cusparse") == 0) {
 #if HAVE_CUDA
         use_gpu = true;
-        backend.reset(new Opm::Accelerator::cusparseSolverBackend<block_size>(linear_solver_verbosity, maxit, tolerance, deviceID));
+        backend.reset(new Opm::Accelerator::cusparseSolverBackend<block_size>(linear_solver_verbosity, maxit, tolerance, deviceID, linsolver));
 #else
         OPM_THROW(std::logic_error, "Error cusparseSolver was chosen, but CUDA was not found by CMake");
 #endif
@@ -89,7 +92,7 @@ BdaBridge<BridgeMatrix, BridgeVector, block_size>::BdaBridge(std::string acceler
         } else {
             OPM_THROW(std::logic_error, "Error invalid argument for --opencl-ilu-reorder, usage: '--opencl-ilu-reorder=[level_scheduling|graph_coloring]'");
         }
-        backend.reset(new Opm::Accelerator::openclSolverBackend<block_size>(linear_solver_verbosity, maxit, tolerance, platformID, deviceID, ilu_reorder, linsolver));
+        backend.reset(new Opm::Accelerator::openclSolverBackend<block_size>(linear_solver_verbosity, maxit, tolerance, platformID, deviceID, ilu_reorder, linsolver, opencl_program_cache));
 #else
         OPM_THROW(std::logic_error, "Error openclSolver was chosen, but OpenCL was not found by CMake");
 #endif
@@ -209,9 +212,9 @@ void BdaBridge<BridgeMatrix, BridgeVector, block_size>::solve_system([[maybe_unu
         const int nnzb = (h_rows.empty()) ? mat->nonzeroes() : h_rows.back();
         const int nnz = nnzb * dim * dim;
 
-        if (dim != 3) {
-            OpmLog::warning("BdaSolver only accepts blocksize = 3 at this time, will use Dune for the remainder of the program");
-            use_gpu = use_fpga = false;
+        if (use_fpga && dim != 3) {
+            OpmLog::warning("FpgaSolver only accepts blocksize = 3 at this time, will use Dune for the remainder of the program");
+            use_fpga = false;
             return;
         }
 
@@ -228,6 +231,17 @@ void BdaBridge<BridgeMatrix, BridgeVector, block_size>::solve_system([[maybe_unu
             out << "Checking zeros took: " << t_zeros.stop() << " s, found " << numZeros << " zeros";
             OpmLog::info(out.str());
         }
+#if HAVE_OPENCL
+        if (numZeros > 0 && accelerator_mode.compare("opencl") == 0) {
+            // values prefetched in prefetch_matrix() are outdated
+            static_cast<Opm::Accelerator::openclSolverBackend<block_size>*>(backend.get())->discard_matrix_upload();
+        }
+#endif
+#if HAVE_CUDA
+        if (numZeros > 0 && accelerator_mode.compare("cusparse") == 0) {
+            static_cast<Opm::Accelerator::cusparseSolverBackend<block_size>*>(backend.get())->discard_matrix_upload();
+        }
+#endif
 
 
         /////////////////////////
@@ -260,6 +274,26 @@ void BdaBridge<BridgeMatrix, BridgeVector, block_size>::solve_system([[maybe_unu
 }
 
 
+template <class BridgeMatrix, class BridgeVector, int block_size>
+void BdaBridge<BridgeMatrix, BridgeVector, block_size>::prefetch_matrix([[maybe_unused]] BridgeMatrix* mat) {
+#if HAVE_OPENCL
+    if (use_gpu && accelerator_mode.compare("opencl") == 0) {
+        // same modification as in solve_system(), such that the uploaded values stay valid
+        checkZeroDiagonal(*mat);
+        auto openclBackend = static_cast<Opm::Accelerator::openclSolverBackend<block_size>*>(backend.get());
+        openclBackend->upload_matrix_async(static_cast<double*>(&(((*mat)[0][0][0][0]))));
+    }
+#endif
+#if HAVE_CUDA
+    if (use_gpu && accelerator_mode.compare("cusparse") == 0) {
+        checkZeroDiagonal(*mat);
+        auto cudaBackend = static_cast<Opm::Accelerator::cusparseSolverBackend<block_size>*>(backend.get());
+        cudaBackend->upload_matrix_async(static_cast<double*>(&(((*mat)[0][0][0][0]))));
+    }
+#endif
+}
+
+
 template <class BridgeMatrix, class BridgeVector, int block_size>
 void BdaBridge<BridgeMatrix, BridgeVector, block_size>::get_result([[maybe_unused]] BridgeVector& x) {
     if (use_gpu || use_fpga) {
@@ -267,12 +301,100 @@ void BdaBridge<BridgeMatrix, BridgeVector, block_size>::get_result([[maybe_unuse
     }
 }
 
+template <class BridgeMatrix, class BridgeVector, int block_size>
+void BdaBridge<BridgeMatrix, BridgeVector, block_size>::setParallelInfo([[maybe_unused]] int Nb_owned,
+                                                                        [[maybe_unused]] std::function<void(BridgeVector&)> copyOwnerToAll,
+                                                                        [[maybe_unused]] std::function<double(double)> globalSum) {
+    if (accelerator_mode.compare("opencl") == 0 || accelerator_mode.compare("amgcl") == 0) {
+#if HAVE_OPENCL || HAVE_AMGCL
+        // the exchange works on a Dune vector, the solver only sees a raw array of doubles
+        auto exchange = [copyOwnerToAll, halo = BridgeVector()](double* vec, int N) mutable {
+            halo.resize(N / block_size);
+            std::copy(vec, vec + N, &(halo[0][0]));
+            copyOwnerToAll(halo);
+            std::copy(&(halo[0][0]), &(halo[0][0]) + N, vec);
+        };
+        backend->setParallelInfo(Nb_owned, std::move(exchange), std::move(globalSum));
+#else
+        OPM_THROW(std::logic_error, "Error " + accelerator_mode + "Solver was chosen, but it was not found by CMake");
+#endif
+    } else if (use_gpu || use_fpga) {
+        OPM_THROW(std::logic_error, "Error only the openclSolver and the amgclSolver support distributed systems");
+    }
+}
+
+#if HAVE_MPI
+template <class BridgeMatrix, class BridgeVector, int block_size>
+void BdaBridge<BridgeMatrix, BridgeVector, block_size>::setMpiCommunicator([[maybe_unused]] MPI_Comm comm) {
+#if HAVE_AMGCL
+    if (accelerator_mode.compare("amgcl") == 0) {
+        static_cast<Opm::Accelerator::amgclSolverBackend<block_size>*>(backend.get())->setCommunicator(comm);
+    }
+#endif
+}
+#endif
+
+template <class BridgeMatrix, class BridgeVector, int block_size>
+void BdaBridge<BridgeMatrix, BridgeVector, block_size>::setAutotuneCache([[maybe_unused]] const std::string& file) {
+#if HAVE_OPENCL
+    if (accelerator_mode.compare("opencl") == 0) {
+        static_cast<Opm::Accelerator::openclSolverBackend<block_size>*>(backend.get())->setAutotuneCache(file);
+    }
+#endif
+}
+
+template <class BridgeMatrix, class BridgeVector, int block_size>
+void BdaBridge<BridgeMatrix, BridgeVector, block_size>::setConvergenceCheckInterval([[maybe_unused]] int interval) {
+#if HAVE_OPENCL
+    if (accelerator_mode.compare("opencl") == 0) {
+        static_cast<Opm::Accelerator::openclSolverBackend<block_size>*>(backend.get())->setConvergenceCheckInterval(interval);
+    }
+#endif
+}
+
+template <class BridgeMatrix, class BridgeVector, int block_size>
+void BdaBridge<BridgeMatrix, BridgeVector, block_size>::setSellFormat([[maybe_unused]] bool sell) {
+#if HAVE_OPENCL
+    if (accelerator_mode.compare("opencl") == 0) {
+        static_cast<Opm::Accelerator::openclSolverBackend<block_size>*>(backend.get())->setSellFormat(sell);
+    }
+#endif
+}
+
+template <class BridgeMatrix, class BridgeVector, int block_size>
+void BdaBridge<BridgeMatrix, BridgeVector, block_size>::setIluFloatFactors([[maybe_unused]] bool float_factors) {
+#if HAVE_OPENCL
+    if (accelerator_mode.compare("opencl") == 0) {
+        static_cast<Opm::Accelerator::openclSolverBackend<block_size>*>(backend.get())->setIluFloatFactors(float_factors);
+    }
+#endif
+}
+
+template <class BridgeMatrix, class BridgeVector, int block_size>
+void BdaBridge<BridgeMatrix, BridgeVector, block_size>::setAmgclReuse([[maybe_unused]] int reuse_setup, [[maybe_unused]] int rebuild_interval) {
+#if HAVE_AMGCL
+    if (accelerator_mode.compare("amgcl") == 0) {
+        static_cast<Opm::Accelerator::amgclSolverBackend<block_size>*>(backend.get())->setReuseSetup(reuse_setup, rebuild_interval);
+    }
+#endif
+}
+
+template <class BridgeMatrix, class BridgeVector, int block_size>
+void BdaBridge<BridgeMatrix, BridgeVector, block_size>::forceAmgclRebuild() {
+#if HAVE_AMGCL
+    if (accelerator_mode.compare("amgcl") == 0) {
+        static_cast<Opm::Accelerator::amgclSolverBackend<block_size>*>(backend.get())->forceRebuild();
+    }
+#endif
+}
+
 template <class BridgeMatrix, class BridgeVector, int block_size>
 void BdaBridge<BridgeMatrix, BridgeVector, block_size>::initWellContributions([[maybe_unused]] WellContributions& wellContribs) {
     if(accelerator_mode.compare("opencl") == 0){
 #if HAVE_OPENCL
-        const auto openclBackend = static_cast<const Opm::Accelerator::openclSolverBackend<block_size>*>(backend.get());
-        static_cast<WellContributionsOCL&>(wellContribs).setOpenCLEnv(openclBackend->context.get(), openclBackend->queue.get());
+        const auto openclBackend = static_cast<Opm::Accelerator::openclSolverBackend<block_size>*>(backend.get());
+        static_cast<WellContributionsOCL&>(wellContribs).setOpenCLEnv(openclBackend->context.get(), openclBackend->queue.get(),
+                                                                      &openclBackend->bufferPool);
 #else
         OPM_THROW(std::logic_error, "Error openclSolver was chosen, but OpenCL was not found by CMake");
 #endif
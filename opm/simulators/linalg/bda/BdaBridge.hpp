@@ -25,6 +25,12 @@
 #include <opm/simulators/linalg/bda/BdaSolver.hpp>
 #include <opm/simulators/linalg/bda/ILUReorder.hpp>
 
+#include <functional>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
 namespace Opm
 {
 
@@ -55,8 +61,10 @@ public:
     /// \param[in] deviceID                   the device ID to be used by the cusparse- and openclSolvers, too high values could cause runtime errors
     /// \param[in] opencl_ilu_reorder         select either level_scheduling or graph_coloring, see ILUReorder.hpp for explanation
     /// \param[in] linsolver                  copy of cmdline argument --linsolver
+    /// \param[in] opencl_program_cache       directory of the compiled OpenCL kernels, is passed via command-line: '--opencl-program-cache=[<dirname>]'
     BdaBridge(std::string accelerator_mode, std::string fpga_bitstream, int linear_solver_verbosity, int maxit, double tolerance,
-        unsigned int platformID, unsigned int deviceID, std::string opencl_ilu_reorder, std::string linsolver);
+        unsigned int platformID, unsigned int deviceID, std::string opencl_ilu_reorder, std::string linsolver,
+        const std::string& opencl_program_cache = "");
 
 
     /// Solve linear system, A*x = b
@@ -67,6 +75,11 @@ public:
     /// \param[inout] result    summary of solver result
     void solve_system(BridgeMatrix *mat, BridgeVector &b, WellContributions& wellContribs, InverseOperatorResult &result);
 
+    /// Start copying the matrix values to the device before the system is solved
+    /// Only done by the openclSolver after its first solve, the values of mat must not change before solve_system()
+    /// \param[in] mat          matrix A, should be of type Dune::BCRSMatrix
+    void prefetch_matrix(BridgeMatrix *mat);
+
     /// Get the resulting x vector
     /// \param[inout] x    vector x, should be of type Dune::BlockVector
     void get_result(BridgeVector &x);
@@ -77,6 +90,44 @@ public:
         return use_gpu;
     }
 
+    /// Let the BdaSolver solve only the local part of a distributed system, each process drives its own device
+    /// Only supported by the openclSolver and the amgclSolver, the rows owned by this process must come first
+    /// and the other rows must be decoupled, as done in ISTLSolverEbos::makeOverlapRowsInvalid()
+    /// \param[in] Nb_owned          number of blocked rows owned by this process
+    /// \param[in] copyOwnerToAll    update the copied rows of a vector from their owners
+    /// \param[in] globalSum         sum a value over all processes
+    void setParallelInfo(int Nb_owned, std::function<void(BridgeVector&)> copyOwnerToAll, std::function<double(double)> globalSum);
+
+#if HAVE_MPI
+    /// Set the communicator of a distributed system, the amgclSolver solves it with amgcl::mpi
+    /// \param[in] comm              communicator of the processes sharing the system
+    void setMpiCommunicator(MPI_Comm comm);
+#endif
+
+    /// Set the file in which the openclSolver stores the preconditioner chosen with linsolver autotune
+    /// \param[in] file              name of the cache file, empty to disable
+    void setAutotuneCache(const std::string& file);
+
+    /// Set how often the openclSolver checks convergence halfway through an iteration
+    /// \param[in] interval          number of iterations between the checks, at least 1
+    void setConvergenceCheckInterval(int interval);
+
+    /// Let the openclSolver use a sliced ELLPACK copy of the matrix for its spmv
+    /// \param[in] sell              whether to use the sliced copy
+    void setSellFormat(bool sell);
+
+    /// Let the ilu0 preconditioner of the openclSolver apply single precision factors
+    /// \param[in] float_factors     whether to use single precision factors
+    void setIluFloatFactors(bool float_factors);
+
+    /// Set when the amgclSolver rebuilds its amgcl hierarchy, see amgclSolverBackend::setReuseSetup()
+    /// \param[in] reuse_setup       same options as --cpr-reuse-setup, except 4
+    /// \param[in] rebuild_interval  rebuild after this many linear solves with a reused hierarchy, 0 to disable
+    void setAmgclReuse(int reuse_setup, int rebuild_interval);
+
+    /// Let the amgclSolver rebuild its amgcl hierarchy for the next linear solve
+    void forceAmgclRebuild();
+
     /// Store sparsity pattern into vectors
     /// \param[in] mat       input matrix, probably BCRSMatrix
     /// \param[out] h_rows   rowpointers
@@ -23,6 +23,7 @@
 
 #include <opm/simulators/linalg/bda/BdaResult.hpp>
 
+#include <functional>
 #include <string>
 
 namespace Opm {
@@ -68,6 +69,11 @@ namespace Accelerator {
 
         bool initialized = false;
 
+        // only set when solving the local part of a distributed system, see setParallelInfo()
+        int N_owned = -1;                                  // number of scalar rows owned by this process
+        std::function<void(double*, int)> copyOwnerToAll;  // update the copied rows of a vector of N values from their owners
+        std::function<double(double)> globalSum;           // sum a value over all processes
+
     public:
         /// Construct a BdaSolver, can be cusparseSolver, openclSolver, fpgaSolver
         /// \param[in] fpga_bitstream             FPGA bitstream file name (only for fpgaSolver)
@@ -91,6 +97,22 @@ namespace Accelerator {
 
         virtual void get_result(double *x) = 0;
 
+        /// Solve the local part of a distributed system, the rows owned by this process must come first
+        /// The rows not owned must be decoupled (zero except for an identity diagonal block)
+        /// \param[in] Nb_owned          number of blocked rows owned by this process
+        /// \param[in] copyOwnerToAll_   update the copied rows of a vector with the given number of values from their owners
+        /// \param[in] globalSum_        sum a value over all processes
+        void setParallelInfo(int Nb_owned, std::function<void(double*, int)> copyOwnerToAll_, std::function<double(double)> globalSum_) {
+            N_owned = Nb_owned * block_size;
+            copyOwnerToAll = std::move(copyOwnerToAll_);
+            globalSum = std::move(globalSum_);
+        }
+
+        /// Return whether only the local part of a distributed system is solved
+        bool isParallel() const {
+            return N_owned >= 0;
+        }
+
     }; // end class BdaSolver
 
 } // namespace Accelerator
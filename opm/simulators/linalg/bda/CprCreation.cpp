@@ -0,0 +1,392 @@
+/*
+  Copyright 2021 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/ErrorMacros.hpp>
+
+#include <dune/common/shared_ptr.hh>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <utility>
+
+#include <opm/simulators/linalg/PreconditionerFactory.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+#include <opm/simulators/linalg/extractPressureMatrix.hpp>
+
+#include <opm/simulators/linalg/bda/BdaBridge.hpp>
+#include <opm/simulators/linalg/bda/BlockedMatrix.hpp>
+#include <opm/simulators/linalg/bda/CprCreation.hpp>
+
+
+namespace Opm
+{
+namespace Accelerator
+{
+
+template <unsigned int block_size>
+CprCreation<block_size>::CprCreation()
+{
+    if (block_size <= static_cast<unsigned int>(pressure_idx)) {
+        OPM_THROW(std::logic_error, "Error CPR requires a block_size larger than the pressure index");
+    }
+    diagIndices.resize(1);
+}
+
+// return the absolute value of the N elements for which the absolute value is highest
+double get_absmax(const double *data, const int N) {
+    return std::abs(*std::max_element(data, data + N, [](double a, double b){return std::fabs(a) < std::fabs(b);}));
+}
+
+
+// solve A^T * x = b
+void solve_transposed_3x3(const double *A, const double *b, double *x) {
+    const int B = 3;
+    // from dune-common/densematrix.hh, but transposed, so replace [r*B+c] with [r+c*B]
+    double t4  = A[0+0*B] * A[1+1*B];
+    double t6  = A[0+0*B] * A[1+2*B];
+    double t8  = A[0+1*B] * A[1+0*B];
+    double t10 = A[0+2*B] * A[1+0*B];
+    double t12 = A[0+1*B] * A[2+0*B];
+    double t14 = A[0+2*B] * A[2+0*B];
+
+    double d = (t4*A[2+2*B]-t6*A[2+1*B]-t8*A[2+2*B]+
+          t10*A[2+1*B]+t12*A[1+2*B]-t14*A[1+1*B]); //determinant
+
+    x[0] = (b[0]*A[1+1*B]*A[2+2*B] - b[0]*A[2+1*B]*A[1+2*B]
+          - b[1] *A[0+1*B]*A[2+2*B] + b[1]*A[2+1*B]*A[0+2*B]
+          + b[2] *A[0+1*B]*A[1+2*B] - b[2]*A[1+1*B]*A[0+2*B]) / d;
+
+    x[1] = (A[0+0*B]*b[1]*A[2+2*B] - A[0+0*B]*b[2]*A[1+2*B]
+          - A[1+0*B] *b[0]*A[2+2*B] + A[1+0*B]*b[2]*A[0+2*B]
+          + A[2+0*B] *b[0]*A[1+2*B] - A[2+0*B]*b[1]*A[0+2*B]) / d;
+
+    x[2] = (A[0+0*B]*A[1+1*B]*b[2] - A[0+0*B]*A[2+1*B]*b[1]
+          - A[1+0*B] *A[0+1*B]*b[2] + A[1+0*B]*A[2+1*B]*b[0]
+          + A[2+0*B] *A[0+1*B]*b[1] - A[2+0*B]*A[1+1*B]*b[0]) / d;
+}
+
+// solve A^T * x = b for a BxB block, with Gaussian elimination and partial pivoting
+template <unsigned int B>
+void solve_transposed(const double *A, const double *b, double *x) {
+    if constexpr (B == 3) {
+        solve_transposed_3x3(A, b, x);
+    } else {
+        std::array<double, B * B> At;  // row major copy of A^T
+        std::array<double, B> rhs;
+        for (unsigned int r = 0; r < B; ++r) {
+            for (unsigned int c = 0; c < B; ++c) {
+                At[r * B + c] = A[c * B + r];
+            }
+            rhs[r] = b[r];
+        }
+        for (unsigned int k = 0; k < B; ++k) {
+            unsigned int pivot = k;
+            for (unsigned int r = k + 1; r < B; ++r) {
+                if (std::fabs(At[r * B + k]) > std::fabs(At[pivot * B + k])) {
+                    pivot = r;
+                }
+            }
+            if (pivot != k) {
+                for (unsigned int c = 0; c < B; ++c) {
+                    std::swap(At[k * B + c], At[pivot * B + c]);
+                }
+                std::swap(rhs[k], rhs[pivot]);
+            }
+            for (unsigned int r = k + 1; r < B; ++r) {
+                const double factor = At[r * B + k] / At[k * B + k];
+                for (unsigned int c = k; c < B; ++c) {
+                    At[r * B + c] -= factor * At[k * B + c];
+                }
+                rhs[r] -= factor * rhs[k];
+            }
+        }
+        for (int r = B - 1; r >= 0; --r) {
+            double sum = rhs[r];
+            for (unsigned int c = r + 1; c < B; ++c) {
+                sum -= At[r * B + c] * x[c];
+            }
+            x[r] = sum / At[r * B + r];
+        }
+    }
+}
+
+
+template <unsigned int block_size>
+void CprCreation<block_size>::create_preconditioner_amg(BlockedMatrix *mat_) {
+    this->mat = mat_;
+    const int Nb = mat->Nb;
+    const int nnzb = mat->nnzbs;
+
+    coarse_vals.resize(nnzb);
+    weights.resize(Nb * block_size);
+
+    try{
+        std::array<double, block_size> rhs{};
+        rhs[pressure_idx] = 1;
+
+        // find diagonal index for each row
+        if (diagIndices[0].empty()) {
+            diagIndices[0].resize(Nb);
+            for (int row = 0; row < Nb; ++row) {
+                int start = mat->rowPointers[row];
+                int end = mat->rowPointers[row + 1];
+                auto candidate = std::find(mat->colIndices + start, mat->colIndices + end, row);
+                assert(candidate != mat->colIndices + end);
+                diagIndices[0][row] = candidate - mat->colIndices;
+            }
+        }
+
+        // calculate weights for each row
+        for (int row = 0; row < Nb; ++row) {
+            // solve to find weights
+            double *row_weights = weights.data() + block_size * row; // weights for this row
+            solve_transposed<block_size>(mat->nnzValues + block_size * block_size * diagIndices[0][row], rhs.data(), row_weights);
+
+            // normalize weights for this row
+            double abs_max = get_absmax(row_weights, block_size);
+            for(unsigned int i = 0; i < block_size; i++){
+                row_weights[i] /= abs_max;
+            }
+        }
+
+        // extract pressure
+        // transform blocks to scalars to create scalar linear system
+        Amg::calculatePressureMatrixEntries</*transpose=*/false>(Nb, block_size, mat->rowPointers, mat->colIndices,
+                                                                mat->nnzValues, weights.data(), pressure_idx,
+                                                                coarse_vals.data());
+
+#if HAVE_MPI
+        using Communication = Dune::OwnerOverlapCopyCommunication<int, int>;
+#else
+        using Communication = Dune::Amg::SequentialInformation;
+#endif
+        using OverlapFlags = Dune::NegateSet<Communication::OwnerSet>;
+        if (recalculate_aggregates) {
+            dune_coarse = std::make_unique<DuneMat>(Nb, Nb, nnzb, DuneMat::row_wise);
+
+            typedef DuneMat::CreateIterator Iter;
+
+            // setup sparsity pattern
+            for(Iter row = dune_coarse->createbegin(); row != dune_coarse->createend(); ++row){
+                int start = mat->rowPointers[row.index()];
+                int end = mat->rowPointers[row.index() + 1];
+                for (int idx = start; idx < end; ++idx) {
+                    int col = mat->colIndices[idx];
+                    row.insert(col);
+                }
+            }
+
+            // set values, dune_coarse has the same sparsity pattern as mat
+            Amg::copyPressureMatrixEntries(coarse_vals.data(), *dune_coarse);
+
+            dune_op = std::make_shared<MatrixOperator>(*dune_coarse);
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 7)
+            Dune::Amg::SequentialInformation seqinfo;
+            dune_amg = std::make_unique<DuneAmg>(dune_op, Dune::stackobject_to_shared_ptr(seqinfo));
+#else
+            dune_amg = std::make_unique<DuneAmg>(*dune_op);
+#endif
+
+            Opm::PropertyTree property_tree;
+            property_tree.put("alpha", 0.333333333333);
+
+            // The matrix has a symmetric sparsity pattern, but the values are not symmetric
+            // Yet a SymmetricDependency is used in AMGCPR
+            // An UnSymmetricCriterion is also available
+            // using Criterion = Dune::Amg::CoarsenCriterion<Dune::Amg::UnSymmetricCriterion<DuneMat, Dune::Amg::FirstDiagonal> >;
+            using CriterionBase = Dune::Amg::AggregationCriterion<Dune::Amg::SymmetricDependency<DuneMat, Dune::Amg::FirstDiagonal>>;
+            using Criterion = Dune::Amg::CoarsenCriterion<CriterionBase>;
+            const Criterion c = Opm::PreconditionerFactory<MatrixOperator, Dune::Amg::SequentialInformation>::amgCriterion(property_tree);
+            num_pre_smooth_steps = c.getNoPreSmoothSteps();
+            num_post_smooth_steps = c.getNoPostSmoothSteps();
+
+            dune_amg->build<OverlapFlags>(c);
+
+            analyzeHierarchy();
+            analyzeAggregateMaps();
+
+            recalculate_aggregates = false;
+        } else {
+            // update values of coarsest level in AMG
+            // this works because that level is actually a reference to the DuneMat held by dune_coarse
+            Amg::copyPressureMatrixEntries(coarse_vals.data(), *dune_coarse);
+
+            // update the rest of the AMG hierarchy
+            dune_amg->recalculateGalerkin(OverlapFlags());
+            analyzeHierarchy();
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << "Caught exception: " << ex.what() << std::endl;
+        throw ex;
+    }
+}
+
+
+template <unsigned int block_size>
+void CprCreation<block_size>::analyzeHierarchy() {
+    const DuneAmg::ParallelMatrixHierarchy& matrixHierarchy = dune_amg->matrices();
+
+    // store coarsest AMG level in umfpack format, also performs LU decomposition
+    const auto& coarsest = (*matrixHierarchy.coarsest()).getmat();
+    umfpack.setMatrix(coarsest);
+
+    // small coarsest levels are solved on the device, which avoids a
+    // round trip to the host in every preconditioner application
+    dense_coarse_solve = static_cast<int>(coarsest.N()) <= max_dense_coarse_size;
+    if (dense_coarse_solve) {
+        compute_coarse_inverse(coarsest);
+    }
+
+    num_levels = dune_amg->levels();
+    level_sizes.resize(num_levels);
+    diagIndices.resize(num_levels);
+
+    Amatrices.reserve(num_levels);
+    Rmatrices.reserve(num_levels - 1);  // coarsest level does not need one
+    invDiags.reserve(num_levels);
+
+    Amatrices.clear();
+    invDiags.clear();
+
+    // matrixIter.dereference() returns MatrixAdapter
+    // matrixIter.dereference().getmat() returns BCRSMat
+    DuneAmg::ParallelMatrixHierarchy::ConstIterator matrixIter = matrixHierarchy.finest();
+    for(int level = 0; level < num_levels; ++matrixIter, ++level) {
+        const auto& A = matrixIter.dereference().getmat();
+        level_sizes[level] = A.N();
+        diagIndices[level].reserve(A.N());
+
+        // extract matrix A
+        Amatrices.emplace_back(A.N(), A.nonzeroes());
+        // contiguous copy is not possible
+        // std::copy(&(A[0][0][0][0]), &(A[0][0][0][0]) + A.nonzeroes(), Amatrices.back().nnzValues.data());
+        // also update diagonal indices if needed, level 0 is already filled in create_preconditioner()
+        int nnz_idx = 0;
+        const bool fillDiagIndices = diagIndices[level].empty();
+        for (typename DuneMat::const_iterator r = A.begin(); r != A.end(); ++r) {
+            for (auto c = r->begin(); c != r->end(); ++c) {
+                Amatrices.back().nnzValues[nnz_idx] = A[r.index()][c.index()];
+                if (fillDiagIndices && r.index() == c.index()) {
+                    diagIndices[level].emplace_back(nnz_idx);
+                }
+                nnz_idx++;
+            }
+        }
+
+        Opm::BdaBridge<DuneMat, DuneVec, 1>::copySparsityPatternFromISTL(A, Amatrices.back().rowPointers, Amatrices.back().colIndices);
+
+        // compute inverse diagonal values for current level
+        invDiags.emplace_back(A.N());
+        for (unsigned int row = 0; row < A.N(); ++row) {
+            invDiags.back()[row] = 1 / Amatrices.back().nnzValues[diagIndices[level][row]];
+        }
+    }
+}
+
+
+template <unsigned int block_size>
+void CprCreation<block_size>::compute_coarse_inverse(const DuneMat& coarsest) {
+    const int Nc = coarsest.N();
+    if (!coarse_inverse || coarse_inverse->N != Nc) {
+        // dense pattern, row major
+        coarse_inverse = std::make_unique<Matrix>(Nc, Nc * Nc);
+        for (int row = 0; row < Nc; ++row) {
+            coarse_inverse->rowPointers[row] = row * Nc;
+            std::iota(coarse_inverse->colIndices.begin() + row * Nc,
+                      coarse_inverse->colIndices.begin() + (row + 1) * Nc, 0);
+        }
+        coarse_inverse->rowPointers[Nc] = Nc * Nc;
+    }
+
+    // column j of the inverse is the solution for the j-th unit vector,
+    // reusing the LU decomposition of umfpack
+    std::vector<double> unit(Nc, 0.0), column(Nc);
+    for (int col = 0; col < Nc; ++col) {
+        unit[col] = 1.0;
+        umfpack.apply(column.data(), unit.data());
+        unit[col] = 0.0;
+        for (int row = 0; row < Nc; ++row) {
+            coarse_inverse->nnzValues[row * Nc + col] = column[row];
+        }
+    }
+}
+
+
+template <unsigned int block_size>
+void CprCreation<block_size>::analyzeAggregateMaps() {
+
+    PcolIndices.resize(num_levels - 1);
+    Rmatrices.clear();
+
+    const DuneAmg::AggregatesMapList& aggregatesMaps = dune_amg->aggregatesMaps();
+
+    DuneAmg::AggregatesMapList::const_iterator mapIter = aggregatesMaps.begin();
+    for(int level = 0; level < num_levels - 1; ++mapIter, ++level) {
+        DuneAmg::AggregatesMap *map = *mapIter;
+
+        Rmatrices.emplace_back(level_sizes[level+1], level_sizes[level], level_sizes[level]);
+        std::fill(Rmatrices.back().nnzValues.begin(), Rmatrices.back().nnzValues.end(), 1.0);
+
+        // get indices for each row of P and R
+        std::vector<std::vector<unsigned> > indicesR(level_sizes[level+1]);
+        PcolIndices[level].resize(level_sizes[level]);
+
+        using AggregateIterator = DuneAmg::AggregatesMap::const_iterator;
+        for(AggregateIterator ai = map->begin(); ai != map->end(); ++ai){
+            if (*ai != DuneAmg::AggregatesMap::ISOLATED) {
+                const long int diff = ai - map->begin();
+                PcolIndices[level][diff] = *ai;
+                indicesR[*ai].emplace_back(diff);
+            }
+        }
+
+        int col_idx = 0;
+        // set sparsity pattern of R
+        Rmatrices.back().rowPointers[0] = 0;
+        for (unsigned int i = 0; i < indicesR.size(); ++i) {
+            Rmatrices.back().rowPointers[i + 1] = Rmatrices.back().rowPointers[i] + indicesR[i].size();
+            for (auto it = indicesR[i].begin(); it != indicesR[i].end(); ++it) {
+                Rmatrices.back().colIndices[col_idx++] = *it;
+            }
+        }
+    }
+}
+
+
+#define INSTANTIATE_BDA_FUNCTIONS(n)  \
+template class CprCreation<n>;
+
+INSTANTIATE_BDA_FUNCTIONS(1);
+INSTANTIATE_BDA_FUNCTIONS(2);
+INSTANTIATE_BDA_FUNCTIONS(3);
+INSTANTIATE_BDA_FUNCTIONS(4);
+INSTANTIATE_BDA_FUNCTIONS(5);
+INSTANTIATE_BDA_FUNCTIONS(6);
+
+#undef INSTANTIATE_BDA_FUNCTIONS
+
+} // namespace Accelerator
+} // namespace Opm
@@ -0,0 +1,101 @@
+/*
+  Copyright 2021 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CPRCREATION_HPP
+#define OPM_CPRCREATION_HPP
+
+#include <memory>
+#include <vector>
+
+#include <dune/common/version.hh>
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 7)
+#include <dune/istl/paamg/matrixhierarchy.hh>
+#else
+#include <dune/istl/paamg/hierarchy.hh>
+#endif
+#include <dune/istl/umfpack.hh>
+
+#include <opm/simulators/linalg/bda/Matrix.hpp>
+
+namespace Opm
+{
+namespace Accelerator
+{
+
+class BlockedMatrix;
+
+/// This class creates the host side of a Constrained Pressure Residual (CPR) preconditioner:
+/// the quasiimpes weights, the pressure matrix and the AMG hierarchy built by Dune.
+/// The backends upload the resulting scalar matrices and apply the AMG cycle on their device.
+template <unsigned int block_size>
+class CprCreation
+{
+protected:
+    int num_levels;
+    std::vector<double> weights, coarse_vals;
+    std::vector<Matrix> Amatrices, Rmatrices; // scalar matrices that represent the AMG hierarchy
+    std::vector<std::vector<int> > PcolIndices; // prolongation does not need a full matrix, only store colIndices
+    std::vector<std::vector<double> > invDiags; // inverse of diagonal of Amatrices
+    BlockedMatrix *mat = nullptr;    // input matrix, blocked
+
+    using DuneMat = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1> >;
+    using DuneVec = Dune::BlockVector<Dune::FieldVector<double, 1> >;
+    using MatrixOperator = Dune::MatrixAdapter<DuneMat, DuneVec, DuneVec>;
+    using DuneAmg = Dune::Amg::MatrixHierarchy<MatrixOperator, Dune::Amg::SequentialInformation>;
+    std::unique_ptr<DuneAmg> dune_amg;
+    std::unique_ptr<DuneMat> dune_coarse;       // extracted pressure matrix, finest level in AMG hierarchy
+    std::shared_ptr<MatrixOperator> dune_op;    // operator, input to Dune AMG
+    std::vector<int> level_sizes;               // size of each level in the AMG hierarchy
+    std::vector<std::vector<int> > diagIndices; // index of diagonal value for each level
+    Dune::UMFPack<DuneMat> umfpack;             // dune/istl/umfpack object used to solve the coarsest level of AMG
+    std::unique_ptr<Matrix> coarse_inverse;     // dense inverse of the coarsest level, stored as csr matrix
+    bool dense_coarse_solve = false;            // solve the coarsest level on the device with coarse_inverse
+    const int max_dense_coarse_size = 2048;     // largest coarsest level that is inverted
+    bool always_recalculate_aggregates = false; // OPM always reuses the aggregates by default
+    bool recalculate_aggregates = true;         // only rerecalculate if true
+    const int pressure_idx = 1;                 // hardcoded to mimic OPM
+    unsigned num_pre_smooth_steps;              // number of Jacobi smooth steps before restriction
+    unsigned num_post_smooth_steps;             // number of Jacobi smooth steps after prolongation
+
+    CprCreation();
+
+    // Analyze the AMG hierarchy build by Dune
+    void analyzeHierarchy();
+
+    // Compute the dense inverse of the coarsest level with umfpack
+    void compute_coarse_inverse(const DuneMat& coarsest);
+
+    // Analyze the aggregateMaps from the AMG hierarchy
+    // These can be reused, so only use when recalculate_aggregates is true
+    void analyzeAggregateMaps();
+
+    // Calculate the weights, extract the pressure matrix and (re)build the AMG hierarchy
+    // mat_ must stay valid until the next call, it is stored in mat
+    void create_preconditioner_amg(BlockedMatrix *mat_);
+};
+
+// solve A^T * x = b
+// A should represent a 3x3 matrix
+// x and b are vectors with 3 elements
+void solve_transposed_3x3(const double *A, const double *b, double *x);
+
+} // namespace Accelerator
+} // namespace Opm
+
+#endif
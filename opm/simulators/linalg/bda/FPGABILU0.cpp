@@ -19,6 +19,9 @@
 
 #include <config.h>
 
+#include <algorithm>
+#include <future>
+
 #include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/simulators/linalg/MatrixBlock.hpp>
@@ -254,6 +257,20 @@ bool FPGABILU0<block_size>::create_preconditioner(BlockedMatrix *mat)
         OpmLog::info(out.str());
     }
 
+    // the RDF of the reordered matrix only depends on rMat, so it is created on another thread
+    // while the decomposition and the RDF of L and U are done here
+    // the destructor of the future waits for the thread, also when returning early
+    double worker_time = 0.0;
+    const double start_overlap = second();
+    std::future<int> rMatRDF = std::async(std::launch::async, [&]() {
+        const double start_worker = second();
+        int res = rMat->toRDF(numColors, rowsPerColor.data(), /*isUMatrix:*/ false,
+                              colIndicesInColor, maxNNZsPerRow, nnzValsSizes.data(),
+                              nnzValues, colIndices.data(), NROffsets.data(), colorSizes.data(), &valSize);
+        worker_time = second() - start_worker;
+        return res;
+    });
+
     int i, j, ij, ik, jk;
     int iRowStart, iRowEnd, jRowEnd;
     double pivot[bs * bs];
@@ -357,12 +374,6 @@ bool FPGABILU0<block_size>::create_preconditioner(BlockedMatrix *mat)
         URowsPerColor[numColors - c - 1] = rowsPerColor[c];
     }
     int err;
-    err = rMat->toRDF(numColors, rowsPerColor.data(), /*isUMatrix:*/ false,
-                      colIndicesInColor, maxNNZsPerRow, nnzValsSizes.data(),
-                      nnzValues, colIndices.data(), NROffsets.data(), colorSizes.data(), &valSize);
-    if (err != 0) {
-        return false;
-    }
     err = LMat->toRDF(LNumColors, rowsPerColor.data(), /*isUMatrix:*/ false,
                       LColIndicesInColor, maxNNZsPerRow, LnnzValsSizes.data(),
                       LnnzValues, LColIndices.data(), LNROffsets.data(), LColorSizes.data(), &LValSize);
@@ -375,6 +386,18 @@ bool FPGABILU0<block_size>::create_preconditioner(BlockedMatrix *mat)
     if (err != 0) {
         return false;
     }
+    const double main_time = second() - start_overlap;
+    err = rMatRDF.get();
+    overlapTime = std::min(main_time, worker_time);
+
+    if (verbosity >= 3) {
+        std::ostringstream out;
+        out << "FPGABILU0 toRDF of reordered matrix: " << worker_time << " s, overlapped: " << overlapTime << " s";
+        OpmLog::info(out.str());
+    }
+    if (err != 0) {
+        return false;
+    }
     blockedDiagtoRDF(invDiagVals, rMat->Nb, numColors, URowsPerColor, blockDiag.data());
     // resultPointers are set in the init method
     resultSizes[0] = rowSize;
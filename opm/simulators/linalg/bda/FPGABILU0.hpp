@@ -74,6 +74,7 @@ private:
     int numResultSizes = 18;
     std::vector<int> resultSizes;
     int maxRowsPerColor, maxColsPerColor, maxNNZsPerRow, maxNumColors; // are set via the constructor
+    double overlapTime = 0.0; // time the RDF of rMat was created concurrently with the decomposition, in the last call
 
 public:
 
@@ -112,6 +113,12 @@ public:
         return resultSizes.data();
     }
 
+    // time in seconds that the host threads worked concurrently during the last create_preconditioner()
+    double getOverlapTime()
+    {
+        return overlapTime;
+    }
+
 };
 
 } // namespace Accelerator
@@ -70,6 +70,7 @@ private:
     // per call performance metrics
     typedef struct {
       double s_preconditioner_create = 0.0;
+      double s_preconditioner_overlap = 0.0;
       double s_analysis = 0.0;
       double s_reorder = 0.0;
       double s_mem_setup = 0.0;
@@ -89,6 +90,8 @@ private:
       double s_preconditioner_setup;
       double s_preconditioner_create;
       double s_preconditioner_create_min,s_preconditioner_create_max,s_preconditioner_create_avg;
+      double s_preconditioner_overlap;
+      double s_preconditioner_overlap_min,s_preconditioner_overlap_max,s_preconditioner_overlap_avg;
       double s_analysis;
       double s_analysis_min,s_analysis_max,s_analysis_avg;
       double s_reorder;
@@ -109,6 +109,21 @@ void MultisegmentWellContribution::apply(double *h_x, double *h_y)
     }
 }
 
+void MultisegmentWellContribution::computeDenseInverseD(std::vector<double>& Dinv)
+{
+    Dinv.resize(M * M);
+    std::vector<double> unit(M, 0.0);
+    std::vector<double> column(M);
+    for (unsigned int col = 0; col < M; ++col) {
+        unit[col] = 1.0;
+        umfpack_di_solve(UMFPACK_A, Dcols.data(), Drows.data(), Dvals.data(), column.data(), unit.data(), UMFPACK_Numeric, nullptr, nullptr);
+        unit[col] = 0.0;
+        for (unsigned int row = 0; row < M; ++row) {
+            Dinv[row * M + col] = column[row];
+        }
+    }
+}
+
 #if HAVE_CUDA
 void MultisegmentWellContribution::setCudaStream(cudaStream_t stream_)
 {
@@ -123,6 +123,24 @@ public:
     /// \param[in] toOrder    array with mappings
     /// \param[in] reorder    whether reordering is actually used or not
     void setReordering(int *toOrder, bool reorder);
+
+    /// Return the size of the blocks of x and y, and of the well equations
+    unsigned int getDim() const { return dim; }
+    unsigned int getDimWells() const { return dim_wells; }
+
+    /// Return the number of blockrows (segments) in C, D and B
+    unsigned int getNumBlockRows() const { return Mb; }
+
+    /// Return the nonzero values of C and B, and their shared sparsity pattern
+    const std::vector<double>& getCvals() const { return Cvals; }
+    const std::vector<double>& getBvals() const { return Bvals; }
+    const std::vector<unsigned int>& getBcols() const { return Bcols; }
+    const std::vector<unsigned int>& getBrows() const { return Brows; }
+
+    /// Compute D^-1 as a dense matrix with the existing factorization of D
+    /// Only sensible for small wells, the cost is M solves and M*M doubles
+    /// \param[out] Dinv      row major M x M matrix
+    void computeDenseInverseD(std::vector<double>& Dinv);
 };
 
 } //namespace Opm
@@ -22,6 +22,7 @@
 #include <opm/simulators/linalg/bda/BlockedMatrix.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
+#include <opm/simulators/utils/CacheFile.hpp>
 
 #include <algorithm>
 #include <array>
@@ -368,6 +369,15 @@ void csrPatternToCsc(int *CSRColIndices, int *CSRRowPointers, int *CSCRowIndices
 }
 
 
+std::size_t hashSparsityPattern(const int *CSRRowPointers, const int *CSRColIndices, int Nb)
+{
+    Fnv1aHash hash;
+    hash.addBytes(CSRRowPointers, sizeof(int) * (Nb + 1));
+    hash.addBytes(CSRColIndices, sizeof(int) * CSRRowPointers[Nb]);
+    return hash.value();
+}
+
+
 #define INSTANTIATE_BDA_FUNCTIONS(n)                                                                                                            \
 template int colorBlockedNodes<n>(int, const int *, const int *, const int *, const int *, std::vector<int>&, int, int);                        \
 template void reorderBlockedVectorByPattern<n>(int, double*, int*, double*);                                                                    \
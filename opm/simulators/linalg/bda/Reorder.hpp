@@ -20,6 +20,7 @@
 #ifndef REORDER_HPP
 #define REORDER_HPP
 
+#include <cstddef>
 #include <vector>
 
 #include <opm/simulators/linalg/bda/BlockedMatrix.hpp>
@@ -122,6 +123,14 @@ void findGraphColoring(const int *CSRColIndices, const int *CSRRowPointers, cons
 /// \param[in] Nb                number of blockrows in the matrix
 void csrPatternToCsc(int *CSRColIndices, int *CSRRowPointers, int *CSCRowIndices, int *CSCColPointers, int Nb);
 
+/// Compute a hash of a sparsity pattern stored in the CSR format, to cheaply recognize a pattern seen before
+/// Equal patterns give equal hashes, a matching hash does not guarantee an equal pattern
+/// \param[in] CSRRowPointers    row pointers of the pattern
+/// \param[in] CSRColIndices     column indices of the pattern
+/// \param[in] Nb                number of blockrows in the matrix
+/// \return                      FNV-1a hash of the pattern
+std::size_t hashSparsityPattern(const int *CSRRowPointers, const int *CSRColIndices, int Nb);
+
 } // namespace Accelerator
 } // namespace Opm
 
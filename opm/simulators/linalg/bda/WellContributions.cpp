@@ -68,10 +68,8 @@ WellContributions::create(const std::string& accelerator_mode, bool useWellConn)
     }
 }
 
-void WellContributions::addMatrix([[maybe_unused]] MatrixType type,
-                                  [[maybe_unused]] int* colIndices,
-                                  [[maybe_unused]] double* values,
-                                  [[maybe_unused]] unsigned int val_size)
+WellContributions::StandardWellStorage
+WellContributions::getStandardWellStorage(unsigned int val_size)
 {
 #if !HAVE_CUDA && !HAVE_OPENCL
     OPM_THROW(std::logic_error, "Error cannot add StandardWell matrix on GPU because neither CUDA nor OpenCL were found by cmake");
@@ -80,25 +78,41 @@ void WellContributions::addMatrix([[maybe_unused]] MatrixType type,
     if (!allocated) {
         OPM_THROW(std::logic_error, "Error cannot add wellcontribution before allocating memory in WellContributions");
     }
+    if (num_std_wells_so_far == num_std_wells || num_blocks_so_far + val_size > num_blocks) {
+        OPM_THROW(std::logic_error, "Error more StandardWell data added than was allocated in WellContributions");
+    }
+
+    StandardWellStorage storage;
+    storage.Cnnzs = h_Cnnzs.data() + num_blocks_so_far * dim * dim_wells;
+    storage.Ccols = h_Ccols.data() + num_blocks_so_far;
+    storage.Dnnzs = h_Dnnzs.data() + num_std_wells_so_far * dim_wells * dim_wells;
+    storage.Bnnzs = h_Bnnzs.data() + num_blocks_so_far * dim * dim_wells;
+    storage.Bcols = h_Bcols.data() + num_blocks_so_far;
 
-    this->APIaddMatrix(type, colIndices, values, val_size);
+    val_pointers[num_std_wells_so_far] = num_blocks_so_far;
+    num_blocks_so_far += val_size;
+    num_std_wells_so_far++;
 
-    if(MatrixType::B == type) {
-        num_blocks_so_far += val_size;
-        num_std_wells_so_far++;
+    return storage;
+}
+
+void WellContributions::upload()
+{
+    if (num_std_wells == 0) {
+        return;
     }
+    if (num_std_wells_so_far != num_std_wells) {
+        OPM_THROW(std::logic_error, "Error not all StandardWells were added to WellContributions before uploading");
+    }
+    val_pointers[num_std_wells] = num_blocks;
+
+    this->APIupload();
 }
 
 void WellContributions::setBlockSize(unsigned int dim_, unsigned int dim_wells_)
 {
     dim = dim_;
     dim_wells = dim_wells_;
-
-    if(dim != 3 || dim_wells != 4){
-        std::ostringstream oss;
-        oss << "WellContributions::setBlockSize error: dim and dim_wells must be equal to 3 and 4, repectivelly, otherwise the add well contributions kernel won't work.\n";
-        OPM_THROW(std::logic_error, oss.str());
-    }
 }
 
 void WellContributions::addNumBlocks(unsigned int numBlocks)
@@ -114,6 +128,11 @@ void WellContributions::alloc()
 {
     if (num_std_wells > 0) {
         val_pointers.resize(num_std_wells+1);
+        h_Cnnzs.resize(num_blocks * dim * dim_wells);
+        h_Bnnzs.resize(num_blocks * dim * dim_wells);
+        h_Dnnzs.resize(num_std_wells * dim_wells * dim_wells);
+        h_Ccols.resize(num_blocks);
+        h_Bcols.resize(num_blocks);
 
         this->APIalloc();
         allocated = true;
@@ -45,10 +45,11 @@ namespace Opm
 /// B*x and D*B*x are a vector with numStaticWellEq doubles
 /// C*D*B*x is a blocked matrix with a symmetric sparsity pattern, contains square blocks with size numEq. For every columnindex i, j in StandardWell::duneB_, there is a block on (i, j) in C*D*B*x.
 ///
-/// This class is used in 3 phases:
+/// This class is used in 4 phases:
 /// - get total size of all wellcontributions that must be stored here
 /// - allocate memory
-/// - copy data of wellcontributions
+/// - let every StandardWell write its data directly into the contiguous host arena
+/// - upload the whole arena to the device at once
 class WellContributions
 {
 public:
@@ -59,11 +60,14 @@ public:
 #else
     using UMFPackIndex = int;
 #endif
-    /// StandardWell has C, D and B matrices that need to be copied
-    enum class MatrixType {
-        C,
-        D,
-        B
+    /// Pointers to the part of the host arena that belongs to one StandardWell
+    /// C and B contain val_size blocks of dim_wells x dim, stored row-wise, D contains one block of dim_wells x dim_wells
+    struct StandardWellStorage {
+        double *Cnnzs;
+        int *Ccols;
+        double *Dnnzs;
+        double *Bnnzs;
+        int *Bcols;
     };
 
 protected:
@@ -79,6 +83,10 @@ protected:
     unsigned int num_std_wells_so_far = 0;   // keep track of where next data is written
     std::vector<unsigned int> val_pointers;    // val_pointers[wellID] == index of first block for this well in Ccols and Bcols
 
+    // host arena for the StandardWells, filled by the wells themselves and uploaded by upload()
+    std::vector<double> h_Cnnzs, h_Dnnzs, h_Bnnzs;
+    std::vector<int> h_Ccols, h_Bcols;
+
     std::vector<std::unique_ptr<MultisegmentWellContribution>> multisegments;
 
 public:
@@ -101,12 +109,15 @@ public:
     /// \param[in] dim_wells   number of rows
     void setBlockSize(unsigned int dim, unsigned int dim_wells);
 
-    /// Store a matrix in this object, in blocked csr format, can only be called after alloc() is called
-    /// \param[in] type        indicate if C, D or B is sent
-    /// \param[in] colIndices  columnindices of blocks in C or B, ignored for D
-    /// \param[in] values      array of nonzeroes
-    /// \param[in] val_size    number of blocks in C or B, ignored for D
-    void addMatrix(MatrixType type, int *colIndices, double *values, unsigned int val_size);
+    /// Reserve the part of the host arena for the next StandardWell, can only be called after alloc() is called
+    /// The StandardWell writes its C, D^-1 and B directly to the returned pointers
+    /// \param[in] val_size    number of blocks in C and B of this StandardWell
+    /// \return                pointers to the storage of this StandardWell
+    StandardWellStorage getStandardWellStorage(unsigned int val_size);
+
+    /// Copy the host arena of all StandardWells to the device in one go
+    /// Must be called after the data of all StandardWells is written
+    void upload();
 
     /// Add a MultisegmentWellContribution, actually creates an object on heap that is destroyed in the destructor
     /// Matrices C and B are passed in Blocked CSR, matrix D in CSC
@@ -131,8 +142,8 @@ protected:
     //! \brief API specific allocation.
     virtual void APIalloc() {}
 
-    /// Api specific upload of matrix.
-    virtual void APIaddMatrix(MatrixType, int*, double*, unsigned int) {}
+    /// API specific upload of the host arena.
+    virtual void APIupload() {}
 };
 } //namespace Opm
 
@@ -18,6 +18,7 @@
 */
 
 #include <config.h>
+#include <memory>
 #include <sstream>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
@@ -35,6 +36,17 @@
 #include <amgcl/backend/vexcl_static_matrix.hpp>
 #endif
 
+#if HAVE_MPI
+#include <amgcl/mpi/amg.hpp>
+#include <amgcl/mpi/coarsening/runtime.hpp>
+#include <amgcl/mpi/direct_solver/runtime.hpp>
+#include <amgcl/mpi/distributed_matrix.hpp>
+#include <amgcl/mpi/make_solver.hpp>
+#include <amgcl/mpi/partition/runtime.hpp>
+#include <amgcl/mpi/relaxation/runtime.hpp>
+#include <amgcl/mpi/solver/runtime.hpp>
+#endif
+
 namespace Opm
 {
 namespace Accelerator
@@ -141,10 +153,101 @@ void amgclSolverBackend<block_size>::initialize(int N_, int nnz_, int dim) {
     }
     OpmLog::info(out.str());
 
+    if (backend_type == Amgcl_backend_type::vexcl && (reuse_setup != 0 || rebuild_interval > 0)) {
+        OpmLog::warning("amgclSolverBackend: reusing the amgcl hierarchy is not supported with VexCL, it is rebuilt for every linear solve");
+    }
+
+    if (isParallel()) {
+#if HAVE_MPI
+        if (comm == MPI_COMM_NULL) {
+            OPM_THROW(std::logic_error, "Error amgclSolverBackend needs a communicator to solve a distributed system");
+        }
+        if (backend_type != Amgcl_backend_type::cpu) {
+            OPM_THROW(std::logic_error, "Error amgclSolverBackend only supports backend_type 'cpu' for a distributed system");
+        }
+        // amgcl::mpi always uses an AMG preconditioner, a relaxation chosen
+        // as preconditioner becomes the smoother of its levels
+        mpi_prm = prm;
+        mpi_prm.erase("precond");
+        if (prm.get("precond.class", "relaxation") == "amg") {
+            mpi_prm.put_child("precond", prm.get_child("precond"));
+            mpi_prm.get_child("precond").erase("class");
+        } else {
+            mpi_prm.put("precond.relax.type", prm.get("precond.type", "ilu0"));
+        }
+        std::ostringstream mpi_out;
+        mpi_out << "Solving the distributed system with amgcl::mpi, parameters:\n";
+        boost::property_tree::write_json(mpi_out, mpi_prm);
+        OpmLog::info(mpi_out.str());
+        if (reuse_setup != 0 || rebuild_interval > 0) {
+            OpmLog::warning("amgclSolverBackend: reusing the amgcl hierarchy is not supported with MPI, it is rebuilt for every linear solve");
+        }
+#else
+        OPM_THROW(std::logic_error, "Error amgclSolverBackend can only solve a distributed system with MPI");
+#endif
+    }
+
     initialized = true;
 } // end initialize()
 
 
+template <unsigned int block_size>
+void amgclSolverBackend<block_size>::setReuseSetup(int reuse_setup_, int rebuild_interval_) {
+    if (reuse_setup_ < 0 || reuse_setup_ > 3) {
+        OPM_THROW(std::logic_error, "Error amgclSolver only supports reuse setup options 0, 1, 2 and 3");
+    }
+    reuse_setup = reuse_setup_;
+    rebuild_interval = rebuild_interval_;
+}
+
+
+template <unsigned int block_size>
+void amgclSolverBackend<block_size>::forceRebuild() {
+    rebuild_requested = true;
+}
+
+
+#if HAVE_MPI
+template <unsigned int block_size>
+void amgclSolverBackend<block_size>::setCommunicator(MPI_Comm comm_) {
+    comm = comm_;
+}
+#endif
+
+
+template <unsigned int block_size>
+bool amgclSolverBackend<block_size>::should_rebuild(bool have_setup) const {
+    if (!have_setup || reuse_setup == 0) {
+        return true;
+    }
+    if (rebuild_interval > 0 && solves_since_setup >= rebuild_interval) {
+        return true;
+    }
+    if (reuse_setup == 1) {
+        // rebuild on the first Newton iteration of every timestep
+        return rebuild_requested;
+    }
+    if (reuse_setup == 2) {
+        // rebuild if the last solve used more than 10 iterations
+        return iters > 10;
+    }
+    return false;
+}
+
+
+template <unsigned int block_size>
+void amgclSolverBackend<block_size>::update_reuse_state(bool rebuilt) {
+    solves_since_setup = rebuilt ? 0 : solves_since_setup + 1;
+    rebuild_requested = false;
+
+    if (verbosity >= 3) {
+        std::ostringstream out;
+        out << "amgclSolverBackend " << (rebuilt ? "rebuilt" : "reused") << " the amgcl hierarchy";
+        OpmLog::info(out.str());
+    }
+}
+
+
 template <unsigned int block_size>
 void amgclSolverBackend<block_size>::convert_sparsity_pattern(int *rows, int *cols) {
     Timer t;
@@ -259,12 +362,90 @@ void solve_vexcl(
 }
 #endif
 
+#if HAVE_MPI
+template <unsigned int block_size>
+void amgclSolverBackend<block_size>::find_global_columns() {
+    Timer t;
+
+    // the owned rows come first on every process, and are numbered after those of the lower ranks
+    long long owned = N_owned;
+    long long offset = 0;
+    MPI_Exscan(&owned, &offset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    if (rank == 0) {
+        offset = 0; // MPI_Exscan leaves the result of the first process undefined
+    }
+
+    // the global numbers of the copied rows are sent by their owners, doubles hold them exactly
+    std::vector<double> global_rows(N, -1.0);
+    for (int row = 0; row < N_owned; ++row) {
+        global_rows[row] = static_cast<double>(offset + row);
+    }
+    copyOwnerToAll(global_rows.data(), N);
+
+    global_cols.resize(A_rows[N_owned]);
+    for (std::size_t ij = 0; ij < global_cols.size(); ++ij) {
+        const double global_col = global_rows[A_cols[ij]];
+        if (global_col < 0.0) {
+            OPM_THROW(std::logic_error, "Error amgclSolverBackend found a column without owner in the distributed system");
+        }
+        global_cols[ij] = static_cast<std::ptrdiff_t>(global_col);
+    }
+
+    if (verbosity >= 3) {
+        std::ostringstream out;
+        out << "amgclSolverBackend::find_global_columns(): " << t.stop() << " s";
+        OpmLog::info(out.str());
+    }
+}
+
+
+template <unsigned int block_size>
+void amgclSolverBackend<block_size>::solve_mpi(double *b) {
+    // amgcl::mpi gets unblocked values, its direct coarse solvers do not support blocks
+    typedef amgcl::backend::builtin<double> MPI_Backend;
+    typedef amgcl::mpi::make_solver<
+        amgcl::mpi::amg<MPI_Backend,
+                        amgcl::runtime::mpi::coarsening::wrapper<MPI_Backend>,
+                        amgcl::runtime::mpi::relaxation::wrapper<MPI_Backend>,
+                        amgcl::runtime::mpi::direct::solver<double>,
+                        amgcl::runtime::mpi::partition::wrapper<MPI_Backend> >,
+        amgcl::runtime::mpi::solver::wrapper<MPI_Backend> > MPI_Solver;
+
+    amgcl::mpi::communicator world(comm);
+
+    // the local rows of the distributed matrix are the owned rows, which come first
+    auto A = std::make_shared<amgcl::mpi::distributed_matrix<MPI_Backend> >(
+        world, std::tie(N_owned, A_rows, global_cols, A_vals));
+    MPI_Solver solver(world, A, mpi_prm);
+
+    std::call_once(print_info, [&](){
+        std::ostringstream out;
+        out << solver << std::endl;
+        OpmLog::info(out.str());
+    });
+
+    std::fill(x.begin(), x.end(), 0.0);
+    auto B = amgcl::make_iterator_range(b, b + N_owned);
+    auto X = amgcl::make_iterator_range(x.data(), x.data() + N_owned);
+    std::tie(iters, error) = solver(B, X);
+
+    // the copied rows are not part of the distributed system
+    copyOwnerToAll(x.data(), N);
+}
+#endif
+
 template <unsigned int block_size>
 void amgclSolverBackend<block_size>::solve_system(double *b, BdaResult &res) {
     Timer t;
 
     try {
-        if (backend_type == Amgcl_backend_type::cuda) { // use CUDA
+        if (isParallel()) { // use amgcl::mpi
+#if HAVE_MPI
+            solve_mpi(b);
+#endif
+        } else if (backend_type == Amgcl_backend_type::cuda) { // use CUDA
 #if HAVE_CUDA
             solve_cuda(b);
 #endif
@@ -273,14 +454,16 @@ void amgclSolverBackend<block_size>::solve_system(double *b, BdaResult &res) {
             auto Atmp = std::tie(N, A_rows, A_cols, A_vals);
             auto A = amgcl::adapter::block_matrix<dmat_type>(Atmp);
 
-            // create solver and construct preconditioner
-            // don't reuse this unless the preconditioner can be reused
-            CPU_Solver solve(A, prm);
+            // create solver and construct preconditioner, unless the old one is reused
+            const bool rebuild = should_rebuild(cpu_solver != nullptr);
+            if (rebuild) {
+                cpu_solver = std::make_unique<CPU_Solver>(A, prm);
+            }
 
             // print solver structure (once)
             std::call_once(print_info, [&](){
                 std::ostringstream out;
-                out << solve << std::endl;
+                out << *cpu_solver << std::endl;
                 OpmLog::info(out.str());
             });
 
@@ -294,7 +477,14 @@ void amgclSolverBackend<block_size>::solve_system(double *b, BdaResult &res) {
             auto X = amgcl::make_iterator_range(x_ptr, x_ptr + N / block_size);
 
             // actually solve
-            std::tie(iters, error) = solve(B, X);
+            if (rebuild) {
+                std::tie(iters, error) = (*cpu_solver)(B, X);
+            } else {
+                // the hierarchy is kept, the krylov solver uses the new values of the system matrix
+                typename CPU_Backend::matrix Anew(A);
+                std::tie(iters, error) = (*cpu_solver)(Anew, B, X);
+            }
+            update_reuse_state(rebuild);
         } else if (backend_type == Amgcl_backend_type::vexcl) {
 #if HAVE_VEXCL
             static std::vector<cl::CommandQueue> ctx; // using CommandQueue directly instead of vex::Context
@@ -364,6 +554,11 @@ SolverStatus amgclSolverBackend<block_size>::solve_system(int N_, int nnz_, int
     if (initialized == false) {
         initialize(N_, nnz_, dim);
         convert_sparsity_pattern(rows, cols);
+#if HAVE_MPI
+        if (isParallel()) {
+            find_global_columns();
+        }
+#endif
     }
     convert_data(vals, rows);
     solve_system(b, res);
@@ -371,8 +566,20 @@ SolverStatus amgclSolverBackend<block_size>::solve_system(int N_, int nnz_, int
 }
 
 
+#if HAVE_MPI
+#define INSTANTIATE_MPI_FUNCTIONS(n)                                                                \
+template void amgclSolverBackend<n>::setCommunicator(MPI_Comm);
+#else
+#define INSTANTIATE_MPI_FUNCTIONS(n)
+#endif
+
 #define INSTANTIATE_BDA_FUNCTIONS(n)                                                                \
 template amgclSolverBackend<n>::amgclSolverBackend(int, int, double, unsigned int, unsigned int);   \
+template void amgclSolverBackend<n>::setReuseSetup(int, int);                                      \
+template void amgclSolverBackend<n>::forceRebuild();                                               \
+template bool amgclSolverBackend<n>::should_rebuild(bool) const;                                   \
+template void amgclSolverBackend<n>::update_reuse_state(bool);                                     \
+INSTANTIATE_MPI_FUNCTIONS(n)                                                                        \
 
 INSTANTIATE_BDA_FUNCTIONS(1);
 INSTANTIATE_BDA_FUNCTIONS(2);
@@ -382,6 +589,7 @@ INSTANTIATE_BDA_FUNCTIONS(5);
 INSTANTIATE_BDA_FUNCTIONS(6);
 
 #undef INSTANTIATE_BDA_FUNCTIONS
+#undef INSTANTIATE_MPI_FUNCTIONS
 
 } // namespace Accelerator
 } // namespace Opm
@@ -20,6 +20,7 @@
 #ifndef OPM_AMGCLSOLVER_BACKEND_HEADER_INCLUDED
 #define OPM_AMGCLSOLVER_BACKEND_HEADER_INCLUDED
 
+#include <memory>
 #include <mutex>
 
 #include <opm/simulators/linalg/bda/BdaResult.hpp>
@@ -38,6 +39,10 @@
 #include <amgcl/preconditioner/runtime.hpp>
 #include <amgcl/value_type/static_matrix.hpp>
 
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
 namespace Opm
 {
 namespace Accelerator
@@ -60,6 +65,9 @@ class amgclSolverBackend : public BdaSolver<block_size>
     using Base::maxit;
     using Base::tolerance;
     using Base::initialized;
+    using Base::N_owned;
+    using Base::copyOwnerToAll;
+    using Base::isParallel;
 
     typedef amgcl::static_matrix<double, block_size, block_size> dmat_type; // matrix value type in double precision
     typedef amgcl::static_matrix<double, block_size, 1> dvec_type; // the corresponding vector value type
@@ -87,14 +95,45 @@ private:
     int iters = 0;
     double error = 0.0;
 
+    // the solver is kept between linear solves, such that the amgcl hierarchy can be reused
+    // when reusing, only the system matrix of the krylov solver is replaced
+    std::unique_ptr<CPU_Solver> cpu_solver;
+    int reuse_setup = 0;             // same options as cpr_reuse_setup, except 4
+    int rebuild_interval = 0;        // rebuild after this many solves with a reused hierarchy, 0 to disable
+    int solves_since_setup = 0;      // number of linear solves since the last (re)build
+    bool rebuild_requested = false;  // set by forceRebuild()
+
+    /// Decide whether the amgcl hierarchy must be (re)built for the current linear system
+    /// \param[in] have_setup     whether a hierarchy exists that could be reused
+    /// \return                   true iff the hierarchy must be (re)built
+    bool should_rebuild(bool have_setup) const;
+
+    /// Update the counters after a linear solve
+    /// \param[in] rebuilt        whether the hierarchy was (re)built for this solve
+    void update_reuse_state(bool rebuilt);
+
 #if HAVE_CUDA
     std::once_flag cuda_initialize;
+    std::shared_ptr<void> cuda_solver; // the type of the CUDA solver is only known in amgclSolverBackend.cu
     void solve_cuda(double *b);
 #endif
 
 #if HAVE_VEXCL
     std::once_flag vexcl_initialize;
 #endif
+
+#if HAVE_MPI
+    // a distributed system is solved by amgcl::mpi, with the owned rows of all processes numbered consecutively
+    MPI_Comm comm = MPI_COMM_NULL;
+    std::vector<std::ptrdiff_t> global_cols;  // global column indices of the owned rows
+    boost::property_tree::ptree mpi_prm;      // amgcl parameters translated to the amgcl::mpi solver
+
+    /// Find the global column indices of the owned rows, the copied rows get the numbers of their owners
+    void find_global_columns();
+
+    /// Solve the distributed system with amgcl::mpi, the copied rows of x are updated afterwards
+    void solve_mpi(double *b);
+#endif
     /// Initialize host memory and determine amgcl parameters
     /// \param[in] N              number of nonzeroes, divide by dim*dim to get number of blocks
     /// \param[in] nnz            number of nonzeroes, divide by dim*dim to get number of blocks
@@ -149,6 +188,22 @@ public:
     /// \param[inout] x          resulting x vector, caller must guarantee that x points to a valid array
     void get_result(double *x) override;
 
+    /// Set when the amgcl hierarchy is rebuilt, only used by the cpu and cuda backends
+    /// \param[in] reuse_setup         0: rebuild every linear solve, 1: rebuild when forceRebuild() was called,
+    ///                                2: rebuild if the last linear solve took more than 10 iterations, 3: never rebuild
+    /// \param[in] rebuild_interval    rebuild after this many linear solves with a reused hierarchy, 0 to disable
+    void setReuseSetup(int reuse_setup, int rebuild_interval);
+
+    /// Rebuild the amgcl hierarchy for the next linear solve, used for the first Newton iteration of a timestep
+    void forceRebuild();
+
+#if HAVE_MPI
+    /// Set the communicator of a distributed system, must be called together with setParallelInfo()
+    /// The owned rows are then solved with the MPI solvers of amgcl, with an AMG preconditioner
+    /// \param[in] comm               communicator of the processes sharing the system
+    void setCommunicator(MPI_Comm comm);
+#endif
+
 }; // end class amgclSolverBackend
 
 } // namespace Accelerator
@@ -18,6 +18,7 @@
 */
 
 #include <config.h>
+#include <memory>
 #include <sstream>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
@@ -56,9 +57,12 @@ void amgclSolverBackend<block_size>::solve_cuda(double *b) {
     // create matrix object
     auto A = std::tie(N, A_rows, A_cols, A_vals);
 
-    // create solver and construct preconditioner
-    // don't reuse this unless the preconditioner can be reused
-    CUDA_Solver solve(A, prm, CUDA_bprm);
+    // create solver and construct preconditioner, unless the old one is reused
+    const bool rebuild = should_rebuild(cuda_solver != nullptr);
+    if (rebuild) {
+        cuda_solver = std::make_shared<CUDA_Solver>(A, prm, CUDA_bprm);
+    }
+    auto& solve = *static_cast<CUDA_Solver*>(cuda_solver.get());
 
     // print solver structure (once)
     std::call_once(print_info, [&](){
@@ -71,7 +75,15 @@ void amgclSolverBackend<block_size>::solve_cuda(double *b) {
     thrust::device_vector<double> X(N, 0.0);
 
     // actually solve
-    std::tie(iters, error) = solve(B, X);
+    if (rebuild) {
+        std::tie(iters, error) = solve(B, X);
+    } else {
+        // the hierarchy is kept, the krylov solver uses the new values of the system matrix
+        auto Ahost = std::make_shared<amgcl::backend::crs<double> >(A);
+        auto Anew = CUDA_Backend::copy_matrix(Ahost, CUDA_bprm);
+        std::tie(iters, error) = solve(*Anew, B, X);
+    }
+    update_reuse_state(rebuild);
 
     thrust::copy(X.begin(), X.end(), x.begin());
 }
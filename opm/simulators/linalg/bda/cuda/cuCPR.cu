@@ -0,0 +1,378 @@
+/*
+  Copyright 2021 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <cuda_runtime.h>
+#include <sstream>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <dune/common/timer.hh>
+
+#include <opm/simulators/linalg/bda/BlockedMatrix.hpp>
+#include <opm/simulators/linalg/bda/cuda/cuCPR.hpp>
+#include <opm/simulators/linalg/bda/cuda/cuda_header.hpp>
+
+#include "cusparse_v2.h"
+
+namespace Opm
+{
+namespace Accelerator
+{
+
+using Opm::OpmLog;
+using Dune::Timer;
+
+namespace
+{
+
+const cusparseOperation_t operation  = CUSPARSE_OPERATION_NON_TRANSPOSE;
+const cusparseDirection_t order = CUSPARSE_DIRECTION_ROW;
+const unsigned int threads_per_block = 256;
+
+unsigned int num_blocks(const int N)
+{
+    return (N + threads_per_block - 1) / threads_per_block;
+}
+
+} // anonymous namespace
+
+// coarse_y = sum of the weighted equations of each blockrow of fine_y
+__global__ void full_to_pressure_restriction(
+    const double * __restrict__ fine_y,
+    const double * __restrict__ weights,
+    double * __restrict__ coarse_y,
+    const int Nb,
+    const int block_size)
+{
+    for (int row = blockIdx.x * blockDim.x + threadIdx.x; row < Nb; row += gridDim.x * blockDim.x) {
+        double sum = 0.0;
+        const int idx = block_size * row;
+        for (int i = 0; i < block_size; ++i) {
+            sum += fine_y[idx + i] * weights[idx + i];
+        }
+        coarse_y[row] = sum;
+    }
+}
+
+// add the pressure correction to the pressure unknown of each blockrow
+__global__ void add_coarse_pressure_correction(
+    const double * __restrict__ coarse_x,
+    double * __restrict__ fine_x,
+    const int pressure_idx,
+    const int Nb,
+    const int block_size)
+{
+    for (int row = blockIdx.x * blockDim.x + threadIdx.x; row < Nb; row += gridDim.x * blockDim.x) {
+        fine_x[row * block_size + pressure_idx] += coarse_x[row];
+    }
+}
+
+// out += P * in, P is stored as the aggregate of each fine row
+__global__ void prolongate_vector(
+    const double * __restrict__ in,
+    double * __restrict__ out,
+    const int * __restrict__ cols,
+    const int N)
+{
+    for (int row = blockIdx.x * blockDim.x + threadIdx.x; row < N; row += gridDim.x * blockDim.x) {
+        out[row] += in[cols[row]];
+    }
+}
+
+// out += alpha * in1 .* in2
+__global__ void vmul(
+    const double alpha,
+    const double * __restrict__ in1,
+    const double * __restrict__ in2,
+    double * __restrict__ out,
+    const int N)
+{
+    for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < N; idx += gridDim.x * blockDim.x) {
+        out[idx] += alpha * in1[idx] * in2[idx];
+    }
+}
+
+
+void CudaMatrix::allocate(const Matrix& mat) {
+    N = mat.N;
+    M = mat.M;
+    nnz = mat.nnzs;
+    cudaMalloc((void**)&nnzValues, sizeof(double) * nnz);
+    cudaMalloc((void**)&colIndices, sizeof(int) * nnz);
+    cudaMalloc((void**)&rowPointers, sizeof(int) * (N + 1));
+    cudaCheckLastError("Could not allocate enough memory on GPU for CPR");
+}
+
+void CudaMatrix::upload(const Matrix& mat, cudaStream_t stream) {
+    cudaMemcpyAsync(nnzValues, mat.nnzValues.data(), sizeof(double) * nnz, cudaMemcpyHostToDevice, stream);
+    cudaMemcpyAsync(colIndices, mat.colIndices.data(), sizeof(int) * nnz, cudaMemcpyHostToDevice, stream);
+    cudaMemcpyAsync(rowPointers, mat.rowPointers.data(), sizeof(int) * (N + 1), cudaMemcpyHostToDevice, stream);
+}
+
+void CudaMatrix::free() {
+    cudaFree(nnzValues);
+    cudaFree(colIndices);
+    cudaFree(rowPointers);
+    nnzValues = nullptr;
+    colIndices = nullptr;
+    rowPointers = nullptr;
+}
+
+
+template <unsigned int block_size>
+CprCuda<block_size>::CprCuda(int verbosity_) :
+    CprCreation<block_size>(), verbosity(verbosity_)
+{
+    cusparseCreateMatDescr(&descr);
+    cusparseSetMatType(descr, CUSPARSE_MATRIX_TYPE_GENERAL);
+    cusparseSetMatIndexBase(descr, CUSPARSE_INDEX_BASE_ZERO);
+}
+
+
+template <unsigned int block_size>
+CprCuda<block_size>::~CprCuda() {
+    finalize();
+    cusparseDestroyMatDescr(descr);
+}
+
+
+template <unsigned int block_size>
+void CprCuda<block_size>::setCuda(cusparseHandle_t handle, cudaStream_t stream_) {
+    cusparseHandle = handle;
+    stream = stream_;
+}
+
+
+template <unsigned int block_size>
+void CprCuda<block_size>::init_cuda_buffers() {
+    d_Amatrices.resize(num_levels);
+    for (int level = 0; level < num_levels; ++level) {
+        d_Amatrices[level].allocate(Amatrices[level]);
+    }
+    d_Rmatrices.resize(Rmatrices.size());
+    for (unsigned int i = 0; i < Rmatrices.size(); ++i) {
+        const Matrix& m = Rmatrices[i];
+        d_Rmatrices[i].allocate(m);
+        d_f.emplace_back();
+        d_u.emplace_back();
+        d_PcolIndices.emplace_back();
+        d_invDiags.emplace_back();
+        d_t.emplace_back();
+        cudaMalloc((void**)&d_f.back(), sizeof(double) * m.N);
+        cudaMalloc((void**)&d_u.back(), sizeof(double) * m.N);
+        cudaMalloc((void**)&d_PcolIndices.back(), sizeof(int) * m.M);
+        cudaMalloc((void**)&d_invDiags.back(), sizeof(double) * m.M);
+        cudaMalloc((void**)&d_t.back(), sizeof(double) * m.M);
+    }
+    cudaMalloc((void**)&d_weights, sizeof(double) * Nb * block_size);
+    cudaMalloc((void**)&d_rs, sizeof(double) * Nb * block_size);
+    cudaMalloc((void**)&d_coarse_y, sizeof(double) * Nb);
+    cudaMalloc((void**)&d_coarse_x, sizeof(double) * Nb);
+    cudaCheckLastError("Could not allocate enough memory on GPU for CPR");
+
+    buffers_allocated = true;
+}
+
+
+template <unsigned int block_size>
+void CprCuda<block_size>::cuda_upload() {
+    cudaMemcpyAsync(d_weights, weights.data(), sizeof(double) * Nb * block_size, cudaMemcpyHostToDevice, stream);
+    for (unsigned int i = 0; i < Rmatrices.size(); ++i) {
+        d_Amatrices[i].upload(Amatrices[i], stream);
+        d_Rmatrices[i].upload(Rmatrices[i], stream);
+
+        cudaMemcpyAsync(d_invDiags[i], invDiags[i].data(), sizeof(double) * Amatrices[i].N, cudaMemcpyHostToDevice, stream);
+        cudaMemcpyAsync(d_PcolIndices[i], PcolIndices[i].data(), sizeof(int) * Amatrices[i].N, cudaMemcpyHostToDevice, stream);
+    }
+    if (dense_coarse_solve) {
+        if (d_coarse_inverse.N != coarse_inverse->N) {
+            d_coarse_inverse.free();
+            d_coarse_inverse.allocate(*coarse_inverse);
+        }
+        d_coarse_inverse.upload(*coarse_inverse, stream);
+    }
+    // the host arrays are rebuilt by the next create_preconditioner()
+    cudaStreamSynchronize(stream);
+    cudaCheckLastError("Could not upload CPR hierarchy to GPU");
+}
+
+
+template <unsigned int block_size>
+void CprCuda<block_size>::finalize() {
+    if (!buffers_allocated) {
+        return;
+    }
+    for (auto& m : d_Amatrices) {
+        m.free();
+    }
+    for (auto& m : d_Rmatrices) {
+        m.free();
+    }
+    d_coarse_inverse.free();
+    for (unsigned int i = 0; i < d_f.size(); ++i) {
+        cudaFree(d_f[i]);
+        cudaFree(d_u[i]);
+        cudaFree(d_PcolIndices[i]);
+        cudaFree(d_invDiags[i]);
+        cudaFree(d_t[i]);
+    }
+    cudaFree(d_weights);
+    cudaFree(d_rs);
+    cudaFree(d_coarse_y);
+    cudaFree(d_coarse_x);
+    buffers_allocated = false;
+}
+
+
+template <unsigned int block_size>
+void CprCuda<block_size>::create_preconditioner(BlockedMatrix *mat_, double *d_vals, int *d_rows, int *d_cols) {
+    Timer t;
+    Nb = mat_->Nb;
+    nnzb = mat_->nnzbs;
+    d_matVals = d_vals;
+    d_matRows = d_rows;
+    d_matCols = d_cols;
+
+    this->create_preconditioner_amg(mat_);
+
+    if (!buffers_allocated) {
+        init_cuda_buffers();
+    }
+    cuda_upload();
+
+    if (verbosity >= 3) {
+        std::ostringstream out;
+        out << "CprCuda create_preconditioner(): " << t.stop() << " s";
+        OpmLog::info(out.str());
+    }
+}
+
+
+template <unsigned int block_size>
+void CprCuda<block_size>::residual(const CudaMatrix& A, const double *x, const double *b, double *r) {
+    const double one = 1.0;
+    const double mone = -1.0;
+    cudaMemcpyAsync(r, b, sizeof(double) * A.N, cudaMemcpyDeviceToDevice, stream);
+    cusparseDbsrmv(cusparseHandle, order, operation, A.N, A.M, A.nnz, &mone, descr,
+                   A.nnzValues, A.rowPointers, A.colIndices, 1, x, &one, r);
+}
+
+
+template <unsigned int block_size>
+void CprCuda<block_size>::amg_cycle_gpu(const int level, double *y, double *x) {
+    const double zero = 0.0;
+    const double one = 1.0;
+    const CudaMatrix& A = d_Amatrices[level];
+    const int Ncur = A.N;
+
+    if (level == num_levels - 1) {
+        if (dense_coarse_solve) {
+            // solve coarsest level on the device, x = A^{-1} y
+            const CudaMatrix& Ainv = d_coarse_inverse;
+            cusparseDbsrmv(cusparseHandle, order, operation, Ainv.N, Ainv.M, Ainv.nnz, &one, descr,
+                           Ainv.nnzValues, Ainv.rowPointers, Ainv.colIndices, 1, y, &zero, x);
+            return;
+        }
+
+        // solve coarsest level using umfpack
+        h_y.resize(Ncur);
+        h_x.assign(Ncur, 0.0);
+        cudaMemcpyAsync(h_y.data(), y, sizeof(double) * Ncur, cudaMemcpyDeviceToHost, stream);
+        cudaStreamSynchronize(stream);
+
+        umfpack.apply(h_x.data(), h_y.data());
+
+        cudaMemcpyAsync(x, h_x.data(), sizeof(double) * Ncur, cudaMemcpyHostToDevice, stream);
+        cudaStreamSynchronize(stream);
+        return;
+    }
+    const CudaMatrix& R = d_Rmatrices[level];
+
+    double *t = d_t[level];
+    double *f = d_f[level];
+    double *u = d_u[level]; // u was 0-initialized earlier
+
+    // presmooth
+    double jacobi_damping = 0.65; // default value in amgcl: 0.72
+    for (unsigned i = 0; i < num_pre_smooth_steps; ++i){
+        residual(A, x, y, t);
+        vmul<<<num_blocks(Ncur), threads_per_block, 0, stream>>>(jacobi_damping, d_invDiags[level], t, x, Ncur);
+    }
+
+    // move to coarser level
+    residual(A, x, y, t);
+    cusparseDbsrmv(cusparseHandle, order, operation, R.N, R.M, R.nnz, &one, descr,
+                   R.nnzValues, R.rowPointers, R.colIndices, 1, t, &zero, f);
+    amg_cycle_gpu(level + 1, f, u);
+    prolongate_vector<<<num_blocks(Ncur), threads_per_block, 0, stream>>>(u, x, d_PcolIndices[level], Ncur);
+
+    // postsmooth
+    for (unsigned i = 0; i < num_post_smooth_steps; ++i){
+        residual(A, x, y, t);
+        vmul<<<num_blocks(Ncur), threads_per_block, 0, stream>>>(jacobi_damping, d_invDiags[level], t, x, Ncur);
+    }
+}
+
+
+template <unsigned int block_size>
+void CprCuda<block_size>::apply_amg(const double *y, double *x) {
+    Timer t;
+    const double one = 1.0;
+    const double mone = -1.0;
+
+    // 0-initialize u and x vectors
+    cudaMemsetAsync(d_coarse_x, 0, sizeof(double) * Nb, stream);
+    for (unsigned int i = 0; i < d_u.size(); ++i) {
+        cudaMemsetAsync(d_u[i], 0, sizeof(double) * Rmatrices[i].N, stream);
+    }
+
+    // rs = y - A * x
+    cudaMemcpyAsync(d_rs, y, sizeof(double) * Nb * block_size, cudaMemcpyDeviceToDevice, stream);
+    cusparseDbsrmv(cusparseHandle, order, operation, Nb, Nb, nnzb, &mone, descr,
+                   d_matVals, d_matRows, d_matCols, block_size, x, &one, d_rs);
+    full_to_pressure_restriction<<<num_blocks(Nb), threads_per_block, 0, stream>>>(d_rs, d_weights, d_coarse_y, Nb, block_size);
+
+    amg_cycle_gpu(0, d_coarse_y, d_coarse_x);
+
+    add_coarse_pressure_correction<<<num_blocks(Nb), threads_per_block, 0, stream>>>(d_coarse_x, x, pressure_idx, Nb, block_size);
+
+    if (verbosity >= 4) {
+        cudaStreamSynchronize(stream);
+        std::ostringstream out;
+        out << "CprCuda apply_amg(): " << t.stop() << " s";
+        OpmLog::info(out.str());
+    }
+}
+
+
+#define INSTANTIATE_BDA_FUNCTIONS(n)  \
+template class CprCuda<n>;
+
+INSTANTIATE_BDA_FUNCTIONS(1);
+INSTANTIATE_BDA_FUNCTIONS(2);
+INSTANTIATE_BDA_FUNCTIONS(3);
+INSTANTIATE_BDA_FUNCTIONS(4);
+INSTANTIATE_BDA_FUNCTIONS(5);
+INSTANTIATE_BDA_FUNCTIONS(6);
+
+#undef INSTANTIATE_BDA_FUNCTIONS
+
+} // namespace Accelerator
+} // namespace Opm
@@ -0,0 +1,143 @@
+/*
+  Copyright 2021 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CUCPR_HPP
+#define OPM_CUCPR_HPP
+
+#include <vector>
+
+#include <cuda_runtime.h>
+#include "cusparse_v2.h"
+
+#include <opm/simulators/linalg/bda/CprCreation.hpp>
+
+namespace Opm
+{
+namespace Accelerator
+{
+
+class BlockedMatrix;
+
+/// This struct holds a scalar csr matrix on the GPU
+struct CudaMatrix
+{
+    int N = 0;              // number of rows
+    int M = 0;              // number of columns
+    int nnz = 0;            // number of nonzeroes
+    double *nnzValues = nullptr;
+    int *colIndices = nullptr;
+    int *rowPointers = nullptr;
+
+    /// Allocate device memory for a matrix with the sizes of mat
+    void allocate(const Matrix& mat);
+
+    /// Copy the values and pattern of mat to the device
+    void upload(const Matrix& mat, cudaStream_t stream);
+
+    /// Free device memory
+    void free();
+};
+
+/// This class applies a Constrained Pressure Residual (CPR) preconditioner with CUDA
+/// The ILU0 part is done by the cusparseSolverBackend, this class only applies
+/// the AMG for the pressure component. The AMG hierarchy is created by CprCreation.
+template <unsigned int block_size>
+class CprCuda : public CprCreation<block_size>
+{
+    typedef CprCreation<block_size> Base;
+
+    using Base::num_levels;
+    using Base::weights;
+    using Base::Amatrices;
+    using Base::Rmatrices;
+    using Base::PcolIndices;
+    using Base::invDiags;
+    using Base::umfpack;
+    using Base::coarse_inverse;
+    using Base::dense_coarse_solve;
+    using Base::pressure_idx;
+    using Base::num_pre_smooth_steps;
+    using Base::num_post_smooth_steps;
+
+private:
+    int verbosity;
+    int Nb = 0;                     // number of blockrows of the blocked matrix
+    int nnzb = 0;                   // number of blocks of the blocked matrix
+    cusparseHandle_t cusparseHandle;
+    cudaStream_t stream;
+    cusparseMatDescr_t descr;       // general matrix, used for all spmvs
+
+    // blocked matrix, owned by the cusparseSolverBackend
+    double *d_matVals = nullptr;
+    int *d_matRows = nullptr;
+    int *d_matCols = nullptr;
+
+    std::vector<CudaMatrix> d_Amatrices, d_Rmatrices; // scalar matrices that represent the AMG hierarchy
+    std::vector<int*> d_PcolIndices;
+    std::vector<double*> d_invDiags;
+    std::vector<double*> d_t, d_f, d_u; // intermediate vectors used during amg cycle
+    double *d_rs = nullptr;              // residual before extracting the pressure
+    double *d_weights = nullptr;         // the quasiimpes weights, used to extract pressure
+    double *d_coarse_y = nullptr, *d_coarse_x = nullptr; // stores the scalar vectors
+    CudaMatrix d_coarse_inverse;         // dense inverse of the coarsest level on the device
+    std::vector<double> h_y, h_x;        // host vectors for the coarsest level if it is solved by umfpack
+    bool buffers_allocated = false;
+
+    // Allocate matrices and vectors on the GPU, called once
+    void init_cuda_buffers();
+
+    // Copy matrices and vectors to the GPU
+    void cuda_upload();
+
+    // Free all GPU memory
+    void finalize();
+
+    // r = b - A * x for the scalar level A
+    void residual(const CudaMatrix& A, const double *x, const double *b, double *r);
+
+    void amg_cycle_gpu(const int level, double *y, double *x);
+
+public:
+
+    CprCuda(int verbosity);
+
+    ~CprCuda();
+
+    /// Use the handle and stream of the solver backend
+    /// \param[in] handle       cusparse handle
+    /// \param[in] stream       stream to perform the operations on
+    void setCuda(cusparseHandle_t handle, cudaStream_t stream);
+
+    /// Create the AMG hierarchy for mat and upload it to the GPU
+    /// \param[in] mat          blocked matrix on the host
+    /// \param[in] d_vals       nonzeroes of the same matrix on the GPU
+    /// \param[in] d_rows       rowpointers of the same matrix on the GPU
+    /// \param[in] d_cols       columnindices of the same matrix on the GPU
+    void create_preconditioner(BlockedMatrix *mat, double *d_vals, int *d_rows, int *d_cols);
+
+    /// Add the pressure correction for the residual of x, x += P * amg(R * (y - A * x))
+    /// \param[in] y            input vector, contains N values
+    /// \param[inout] x         output of the ILU0 part, contains N values
+    void apply_amg(const double *y, double *x);
+};
+
+} // namespace Accelerator
+} // namespace Opm
+
+#endif
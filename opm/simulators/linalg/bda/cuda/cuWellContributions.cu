@@ -152,6 +152,9 @@ WellContributionsCuda::~WellContributionsCuda()
 
 void WellContributionsCuda::APIalloc()
 {
+    if (dim != 3 || dim_wells != 4) {
+        OPM_THROW(std::logic_error, "WellContributionsCuda error: dim and dim_wells must be equal to 3 and 4, respectively, otherwise the add well contributions kernel won't work");
+    }
     cudaMalloc((void**)&d_Cnnzs, sizeof(double) * num_blocks * dim * dim_wells);
     cudaMalloc((void**)&d_Dnnzs, sizeof(double) * num_std_wells * dim_wells * dim_wells);
     cudaMalloc((void**)&d_Bnnzs, sizeof(double) * num_blocks * dim * dim_wells);
@@ -200,29 +203,15 @@ void WellContributionsCuda::apply(double *d_x, double *d_y)
 }
 
 
-void WellContributionsCuda::APIaddMatrix(MatrixType type, int *colIndices, double *values, unsigned int val_size)
+void WellContributionsCuda::APIupload()
 {
-    switch (type) {
-    case MatrixType::C:
-        cudaMemcpy(d_Cnnzs + num_blocks_so_far * dim * dim_wells, values, sizeof(double) * val_size * dim * dim_wells, cudaMemcpyHostToDevice);
-        cudaMemcpy(d_Ccols + num_blocks_so_far, colIndices, sizeof(int) * val_size, cudaMemcpyHostToDevice);
-        break;
-    case MatrixType::D:
-        cudaMemcpy(d_Dnnzs + num_std_wells_so_far * dim_wells * dim_wells, values, sizeof(double) * dim_wells * dim_wells, cudaMemcpyHostToDevice);
-        break;
-    case MatrixType::B:
-        cudaMemcpy(d_Bnnzs + num_blocks_so_far * dim * dim_wells, values, sizeof(double) * val_size * dim * dim_wells, cudaMemcpyHostToDevice);
-        cudaMemcpy(d_Bcols + num_blocks_so_far, colIndices, sizeof(int) * val_size, cudaMemcpyHostToDevice);
-        val_pointers[num_std_wells_so_far] = num_blocks_so_far;
-        if (num_std_wells_so_far == num_std_wells - 1) {
-            val_pointers[num_std_wells] = num_blocks;
-            cudaMemcpy(d_val_pointers, val_pointers.data(), sizeof(unsigned int) * (num_std_wells + 1), cudaMemcpyHostToDevice);
-        }
-        break;
-    default:
-        OPM_THROW(std::logic_error, "Error unsupported matrix ID for WellContributions::addMatrix()");
-    }
-    cudaCheckLastError("WellContributions::addMatrix() failed");
+    cudaMemcpy(d_Cnnzs, h_Cnnzs.data(), sizeof(double) * h_Cnnzs.size(), cudaMemcpyHostToDevice);
+    cudaMemcpy(d_Dnnzs, h_Dnnzs.data(), sizeof(double) * h_Dnnzs.size(), cudaMemcpyHostToDevice);
+    cudaMemcpy(d_Bnnzs, h_Bnnzs.data(), sizeof(double) * h_Bnnzs.size(), cudaMemcpyHostToDevice);
+    cudaMemcpy(d_Ccols, h_Ccols.data(), sizeof(int) * h_Ccols.size(), cudaMemcpyHostToDevice);
+    cudaMemcpy(d_Bcols, h_Bcols.data(), sizeof(int) * h_Bcols.size(), cudaMemcpyHostToDevice);
+    cudaMemcpy(d_val_pointers, val_pointers.data(), sizeof(unsigned int) * (num_std_wells + 1), cudaMemcpyHostToDevice);
+    cudaCheckLastError("WellContributions::upload() failed");
 }
 
 void WellContributionsCuda::setCudaStream(cudaStream_t stream_)
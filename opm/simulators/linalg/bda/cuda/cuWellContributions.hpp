@@ -50,12 +50,8 @@ protected:
     /// Allocate memory for the StandardWells
     void APIalloc() override;
 
-    /// Store a matrix in this object, in blocked csr format, can only be called after alloc() is called
-    /// \param[in] type        indicate if C, D or B is sent
-    /// \param[in] colIndices  columnindices of blocks in C or B, ignored for D
-    /// \param[in] values      array of nonzeroes
-    /// \param[in] val_size    number of blocks in C or B, ignored for D
-    void APIaddMatrix(MatrixType type, int *colIndices, double *values, unsigned int val_size) override;
+    /// Copy the host arena of all StandardWells to the device
+    void APIupload() override;
 
     cudaStream_t stream;
 
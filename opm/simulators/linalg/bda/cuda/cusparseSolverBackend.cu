@@ -23,9 +23,11 @@
 #include <sstream>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/ErrorMacros.hpp>
 #include <dune/common/timer.hh>
 
 #include <opm/simulators/linalg/bda/cuda/cusparseSolverBackend.hpp>
+#include <opm/simulators/linalg/bda/cuda/cuCPR.hpp>
 #include <opm/simulators/linalg/bda/cuda/cuWellContributions.hpp>
 #include <opm/simulators/linalg/bda/BdaResult.hpp>
 #include <opm/simulators/linalg/bda/cuda/cuda_header.hpp>
@@ -52,7 +54,21 @@ const cusparseDirection_t order = CUSPARSE_DIRECTION_ROW;
 
 
 template <unsigned int block_size>
-cusparseSolverBackend<block_size>::cusparseSolverBackend(int verbosity_, int maxit_, double tolerance_, unsigned int deviceID_) : BdaSolver<block_size>(verbosity_, maxit_, tolerance_, deviceID_) {}
+cusparseSolverBackend<block_size>::cusparseSolverBackend(int verbosity_, int maxit_, double tolerance_, unsigned int deviceID_, std::string linsolver) : BdaSolver<block_size>(verbosity_, maxit_, tolerance_, deviceID_) {
+    if (linsolver.compare("ilu0") == 0) {
+        use_cpr = false;
+    } else if (linsolver.compare("cpr_quasiimpes") == 0) {
+        use_cpr = true;
+    } else if (linsolver.compare("cpr_trueimpes") == 0) {
+        OPM_THROW(std::logic_error, "Error cusparseSolver does not support --linsolver=cpr_trueimpes");
+    } else {
+        OPM_THROW(std::logic_error, "Error unknown value for argument --linsolver, " + linsolver);
+    }
+
+    if (use_cpr) {
+        cpr = std::make_unique<CprCuda<block_size> >(verbosity);
+    }
+}
 
 template <unsigned int block_size>
 cusparseSolverBackend<block_size>::~cusparseSolverBackend() {
@@ -102,13 +118,8 @@ void cusparseSolverBackend<block_size>::gpu_pbicgstab(WellContributions& wellCon
             cublasDaxpy(cublasHandle, n, &one, d_r, 1, d_p, 1);
         }
 
-        // apply ilu0
-        cusparseDbsrsv2_solve(cusparseHandle, order, \
-                              operation, Nb, nnzb, &one, \
-                              descr_L, d_mVals, d_mRows, d_mCols, block_size, info_L, d_p, d_t, policy, d_buffer);
-        cusparseDbsrsv2_solve(cusparseHandle, order, \
-                              operation, Nb, nnzb, &one, \
-                              descr_U, d_mVals, d_mRows, d_mCols, block_size, info_U, d_t, d_pw, policy, d_buffer);
+        // pw = prec(p)
+        apply_preconditioner(d_p, d_pw);
 
         // spmv
         cusparseDbsrmv(cusparseHandle, order, \
@@ -133,13 +144,8 @@ void cusparseSolverBackend<block_size>::gpu_pbicgstab(WellContributions& wellCon
 
         it += 0.5;
 
-        // apply ilu0
-        cusparseDbsrsv2_solve(cusparseHandle, order, \
-                              operation, Nb, nnzb, &one, \
-                              descr_L, d_mVals, d_mRows, d_mCols, block_size, info_L, d_r, d_t, policy, d_buffer);
-        cusparseDbsrsv2_solve(cusparseHandle, order, \
-                              operation, Nb, nnzb, &one, \
-                              descr_U, d_mVals, d_mRows, d_mCols, block_size, info_U, d_t, d_s, policy, d_buffer);
+        // s = prec(r)
+        apply_preconditioner(d_r, d_s);
 
         // spmv
         cusparseDbsrmv(cusparseHandle, order, \
@@ -187,6 +193,26 @@ void cusparseSolverBackend<block_size>::gpu_pbicgstab(WellContributions& wellCon
 }
 
 
+// d_t is used as intermediate vector, it is free whenever the preconditioner is applied
+template <unsigned int block_size>
+void cusparseSolverBackend<block_size>::apply_preconditioner(const double *y, double *x) {
+    double one = 1.0;
+
+    // apply ilu0
+    cusparseDbsrsv2_solve(cusparseHandle, order, \
+                          operation, Nb, nnzb, &one, \
+                          descr_L, d_mVals, d_mRows, d_mCols, block_size, info_L, y, d_t, policy, d_buffer);
+    cusparseDbsrsv2_solve(cusparseHandle, order, \
+                          operation, Nb, nnzb, &one, \
+                          descr_U, d_mVals, d_mRows, d_mCols, block_size, info_U, d_t, x, policy, d_buffer);
+
+    // apply amg for the pressure component
+    if (use_cpr) {
+        cpr->apply_amg(y, x);
+    }
+}
+
+
 template <unsigned int block_size>
 void cusparseSolverBackend<block_size>::initialize(int N, int nnz, int dim) {
     this->N = N;
@@ -220,6 +246,10 @@ void cusparseSolverBackend<block_size>::initialize(int N, int nnz, int dim) {
     cusparseCreate(&cusparseHandle);
     cudaCheckLastError("Could not create cusparseHandle");
 
+    if (use_cpr) {
+        cpr->setCuda(cusparseHandle, stream);
+    }
+
     cudaMalloc((void**)&d_x, sizeof(double) * N);
     cudaMalloc((void**)&d_b, sizeof(double) * N);
     cudaMalloc((void**)&d_r, sizeof(double) * N);
@@ -277,6 +307,9 @@ void cusparseSolverBackend<block_size>::finalize() {
 #if COPY_ROW_BY_ROW
         cudaFreeHost(vals_contiguous);
 #endif
+        if (vals_page_locked) {
+            cudaHostUnregister(registered_vals);
+        }
         cudaStreamDestroy(stream);
     }
 } // end finalize()
@@ -295,6 +328,7 @@ void cusparseSolverBackend<block_size>::copy_system_to_gpu(double *vals, int *ro
     }
     cudaMemcpyAsync(d_bVals, vals_contiguous, nnz * sizeof(double), cudaMemcpyHostToDevice, stream);
 #else
+    register_matrix_values(vals);
     cudaMemcpyAsync(d_bVals, vals, nnz * sizeof(double), cudaMemcpyHostToDevice, stream);
 #endif
 
@@ -312,6 +346,25 @@ void cusparseSolverBackend<block_size>::copy_system_to_gpu(double *vals, int *ro
 } // end copy_system_to_gpu()
 
 
+template <unsigned int block_size>
+void cusparseSolverBackend<block_size>::register_matrix_values(double *vals) {
+    if (vals == registered_vals) {
+        return;
+    }
+    if (vals_page_locked) {
+        cudaHostUnregister(registered_vals);
+    }
+    // the matrix from BdaBridge keeps its values contiguous and at the same address
+    registered_vals = vals;
+    vals_page_locked = (cudaHostRegister(vals, nnz * sizeof(double), cudaHostRegisterDefault) == cudaSuccess);
+    if (!vals_page_locked) {
+        // not fatal, the copies just go through pageable memory
+        cudaGetLastError();
+        OpmLog::warning("cusparseSolver could not page-lock the matrix values");
+    }
+}
+
+
 // don't copy rowpointers and colindices, they stay the same
 template <unsigned int block_size>
 void cusparseSolverBackend<block_size>::update_system_on_gpu(double *vals, int *rows, double *b) {
@@ -326,7 +379,13 @@ void cusparseSolverBackend<block_size>::update_system_on_gpu(double *vals, int *
     }
     cudaMemcpyAsync(d_bVals, vals_contiguous, nnz * sizeof(double), cudaMemcpyHostToDevice, stream);
 #else
-    cudaMemcpyAsync(d_bVals, vals, nnz * sizeof(double), cudaMemcpyHostToDevice, stream);
+    if (matrix_upload_pending) {
+        // already enqueued on the same stream by upload_matrix_async()
+        matrix_upload_pending = false;
+    } else {
+        register_matrix_values(vals);
+        cudaMemcpyAsync(d_bVals, vals, nnz * sizeof(double), cudaMemcpyHostToDevice, stream);
+    }
 #endif
 
     cudaMemcpyAsync(d_b, b, N * sizeof(double), cudaMemcpyHostToDevice, stream);
@@ -341,6 +400,41 @@ void cusparseSolverBackend<block_size>::update_system_on_gpu(double *vals, int *
 } // end update_system_on_gpu()
 
 
+template <unsigned int block_size>
+bool cusparseSolverBackend<block_size>::upload_matrix_async([[maybe_unused]] double *vals) {
+#if COPY_ROW_BY_ROW
+    // the copy to the staging buffer would block anyway
+    return false;
+#else
+    if (!initialized) {
+        return false;
+    }
+    Timer t;
+
+    register_matrix_values(vals);
+    cudaMemcpyAsync(d_bVals, vals, nnz * sizeof(double), cudaMemcpyHostToDevice, stream);
+    matrix_upload_pending = true;
+
+    if (verbosity > 2) {
+        std::ostringstream out;
+        out << "cusparseSolver::upload_matrix_async(): " << t.stop() << " s";
+        OpmLog::info(out.str());
+    }
+    return true;
+#endif
+} // end upload_matrix_async()
+
+
+template <unsigned int block_size>
+void cusparseSolverBackend<block_size>::discard_matrix_upload() {
+    if (matrix_upload_pending) {
+        // the host values must not change while they are copied
+        cudaStreamSynchronize(stream);
+        matrix_upload_pending = false;
+    }
+}
+
+
 template <unsigned int block_size>
 void cusparseSolverBackend<block_size>::reset_prec_on_gpu() {
     cudaMemcpyAsync(d_mVals, d_bVals, nnz  * sizeof(double), cudaMemcpyDeviceToDevice, stream);
@@ -442,6 +536,11 @@ bool cusparseSolverBackend<block_size>::create_preconditioner() {
         return false;
     }
 
+    if (use_cpr) {
+        // the AMG is built from the unfactorized matrix
+        cpr->create_preconditioner(mat.get(), d_bVals, d_bRows, d_bCols);
+    }
+
     if (verbosity > 2) {
         cudaStreamSynchronize(stream);
         std::ostringstream out;
@@ -487,6 +586,9 @@ SolverStatus cusparseSolverBackend<block_size>::solve_system(int N, int nnz, int
     } else {
         update_system_on_gpu(vals, rows, b);
     }
+    if (use_cpr) {
+        mat = std::make_unique<BlockedMatrix>(Nb, nnzb, block_size, vals, cols, rows);
+    }
     if (analysis_done == false) {
         if (!analyse_matrix()) {
             return SolverStatus::BDA_SOLVER_ANALYSIS_FAILED;
@@ -503,7 +605,9 @@ SolverStatus cusparseSolverBackend<block_size>::solve_system(int N, int nnz, int
 
 
 #define INSTANTIATE_BDA_FUNCTIONS(n)                                                       \
-template cusparseSolverBackend<n>::cusparseSolverBackend(int, int, double, unsigned int);  \
+template cusparseSolverBackend<n>::cusparseSolverBackend(int, int, double, unsigned int, std::string);  \
+template bool cusparseSolverBackend<n>::upload_matrix_async(double*);                    \
+template void cusparseSolverBackend<n>::discard_matrix_upload();                          \
 
 INSTANTIATE_BDA_FUNCTIONS(1);
 INSTANTIATE_BDA_FUNCTIONS(2);
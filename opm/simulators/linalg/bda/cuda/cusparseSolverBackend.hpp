@@ -21,10 +21,14 @@
 #define OPM_CUSPARSESOLVER_BACKEND_HEADER_INCLUDED
 
 
+#include <memory>
+#include <string>
+
 #include "cublas_v2.h"
 #include "cusparse_v2.h"
 
 #include <opm/simulators/linalg/bda/BdaResult.hpp>
+#include <opm/simulators/linalg/bda/BlockedMatrix.hpp>
 #include <opm/simulators/linalg/bda/BdaSolver.hpp>
 #include <opm/simulators/linalg/bda/WellContributions.hpp>
 
@@ -33,7 +37,10 @@ namespace Opm
 namespace Accelerator
 {
 
-/// This class implements a cusparse-based ilu0-bicgstab solver on GPU
+template <unsigned int block_size>
+class CprCuda;
+
+/// This class implements a cusparse-based ilu0-bicgstab or cpr-bicgstab solver on GPU
 template <unsigned int block_size>
 class cusparseSolverBackend : public BdaSolver<block_size> {
 
@@ -65,9 +72,21 @@ private:
     double *d_pw, *d_s, *d_t, *d_v;
     void *d_buffer;
     double *vals_contiguous;                  // only used if COPY_ROW_BY_ROW is true in cusparseSolverBackend.cpp
+    double *registered_vals = nullptr;        // host array of matrix values passed to cudaHostRegister
+    bool vals_page_locked = false;            // whether registering registered_vals succeeded
+    bool matrix_upload_pending = false;       // d_bVals is being filled by upload_matrix_async()
 
     bool analysis_done = false;
 
+    bool use_cpr = false;                        // apply the AMG pressure correction after ilu0
+    std::unique_ptr<CprCuda<block_size> > cpr;   // creates and applies the AMG part of CPR
+    std::unique_ptr<BlockedMatrix> mat;          // host matrix, input to cpr, does not own the data
+
+    /// Apply the preconditioner, x = prec(y)
+    /// \param[in] y             input vector, contains N values
+    /// \param[out] x            output vector, contains N values
+    void apply_preconditioner(const double *y, double *x);
+
 
     /// Solve linear system using ilu0-bicgstab
     /// \param[in] wellContribs   contains all WellContributions, to apply them separately, instead of adding them to matrix A
@@ -96,6 +115,11 @@ private:
     /// \param[in] b           input vector, contains N values
     void update_system_on_gpu(double *vals, int *rows, double *b);
 
+    /// Page-lock the host array of matrix values, such that it is copied to the GPU
+    /// without going through a staging buffer. Only done again if the array moves.
+    /// \param[in] vals          array of nonzeroes, contains nnz values
+    void register_matrix_values(double *vals);
+
     /// Reset preconditioner on GPU, ilu0-decomposition is done inplace by cusparse
     void reset_prec_on_gpu();
 
@@ -103,7 +127,7 @@ private:
     /// \return true iff analysis was successful
     bool analyse_matrix();
 
-    /// Perform ilu0-decomposition
+    /// Perform ilu0-decomposition, and create the AMG hierarchy if CPR is used
     /// \return true iff decomposition was successful
     bool create_preconditioner();
 
@@ -120,7 +144,8 @@ public:
     /// \param[in] maxit                      maximum number of iterations for cusparseSolver
     /// \param[in] tolerance                  required relative tolerance for cusparseSolver
     /// \param[in] deviceID                   the device to be used
-    cusparseSolverBackend(int linear_solver_verbosity, int maxit, double tolerance, unsigned int deviceID);
+    /// \param[in] linsolver                  preconditioner, 'ilu0' or 'cpr_quasiimpes'
+    cusparseSolverBackend(int linear_solver_verbosity, int maxit, double tolerance, unsigned int deviceID, std::string linsolver);
 
     /// Destroy a cusparseSolver, and free memory
     ~cusparseSolverBackend();
@@ -142,6 +167,17 @@ public:
     /// \param[inout] x        resulting x vector, caller must guarantee that x points to a valid array
     void get_result(double *x) override;
 
+    /// Start a non-blocking upload of the matrix values
+    /// The next solve_system() uses them instead of copying the values again
+    /// Only possible after the first solve
+    /// \param[in] vals         matrix values, with the sparsity pattern of the previous solves
+    /// \return                 true iff the upload was started
+    bool upload_matrix_async(double *vals);
+
+    /// Forget a pending asynchronous upload, the values are copied again in the next solve_system()
+    /// Must be called if the matrix values have changed after upload_matrix_async()
+    void discard_matrix_upload();
+
 }; // end class cusparseSolverBackend
 
 } // namespace Accelerator
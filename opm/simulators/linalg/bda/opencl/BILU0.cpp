@@ -19,6 +19,7 @@
 
 #include <config.h>
 #include <algorithm>
+#include <cstddef>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/common/ErrorMacros.hpp>
@@ -39,6 +40,33 @@ namespace Accelerator
 using Opm::OpmLog;
 using Dune::Timer;
 
+namespace
+{
+
+// The reordering only depends on the sparsity pattern, which usually stays the same
+// when the solver is recreated after a failed solve or a change in the wells.
+// The last analysis is kept, such that a new BILU0 with the same pattern can skip it.
+struct ReorderCache
+{
+    bool valid = false;
+    ILUReorder strategy;
+    std::size_t hash = 0;
+    std::vector<int> rowPointers, colIndices;
+    int numColors = 0;
+    std::vector<int> toOrder, fromOrder, rowsPerColor;
+};
+
+bool patternMatches(const ReorderCache& cache, ILUReorder strategy, std::size_t hash, const BlockedMatrix *mat)
+{
+    return cache.valid && cache.strategy == strategy && cache.hash == hash
+        && static_cast<int>(cache.rowPointers.size()) == mat->Nb + 1
+        && static_cast<int>(cache.colIndices.size()) == mat->nnzbs
+        && std::equal(cache.rowPointers.begin(), cache.rowPointers.end(), mat->rowPointers)
+        && std::equal(cache.colIndices.begin(), cache.colIndices.end(), mat->colIndices);
+}
+
+} // anonymous namespace
+
 template <unsigned int block_size>
 BILU0<block_size>::BILU0(ILUReorder opencl_ilu_reorder_, int verbosity_) :
     Preconditioner<block_size>(verbosity_), opencl_ilu_reorder(opencl_ilu_reorder_)
@@ -49,6 +77,19 @@ BILU0<block_size>::BILU0(ILUReorder opencl_ilu_reorder_, int verbosity_) :
 }
 
 
+template <unsigned int block_size>
+void BILU0<block_size>::setFloatFactors(bool float_factors_)
+{
+#if CHOW_PATEL
+    if (float_factors_) {
+        OpmLog::warning("BILU0 does not support single precision factors with CHOW_PATEL, using double precision");
+    }
+#else
+    float_factors = float_factors_;
+#endif
+}
+
+
 template <unsigned int block_size>
 bool BILU0<block_size>::analyze_matrix(BlockedMatrix *mat)
 {
@@ -81,9 +122,23 @@ bool BILU0<block_size>::analyze_matrix(BlockedMatrix *mat)
         }
     }
 
+    static ReorderCache cache;
+    std::size_t hash = 0;
+    bool reuse = false;
+    if (opencl_ilu_reorder != ILUReorder::NONE) {
+        hash = hashSparsityPattern(mat->rowPointers, mat->colIndices, mat->Nb);
+        reuse = patternMatches(cache, opencl_ilu_reorder, hash, mat);
+    }
+
     Timer t_analysis;
     std::ostringstream out;
-    if (opencl_ilu_reorder == ILUReorder::LEVEL_SCHEDULING) {
+    if (reuse) {
+        out << "BILU0 reusing reordering of identical sparsity pattern\n";
+        numColors = cache.numColors;
+        toOrder = cache.toOrder;
+        fromOrder = cache.fromOrder;
+        rowsPerColor = cache.rowsPerColor;
+    } else if (opencl_ilu_reorder == ILUReorder::LEVEL_SCHEDULING) {
         out << "BILU0 reordering strategy: " << "level_scheduling\n";
         findLevelScheduling(mat->colIndices, mat->rowPointers, CSCRowIndices.data(), CSCColPointers.data(), mat->Nb, &numColors, toOrder.data(), fromOrder.data(), rowsPerColor);
     } else if (opencl_ilu_reorder == ILUReorder::GRAPH_COLORING) {
@@ -100,6 +155,17 @@ bool BILU0<block_size>::analyze_matrix(BlockedMatrix *mat)
     } else {
         OPM_THROW(std::logic_error, "Error ilu reordering strategy not set correctly\n");
     }
+    if (opencl_ilu_reorder != ILUReorder::NONE && !reuse) {
+        cache.valid = true;
+        cache.strategy = opencl_ilu_reorder;
+        cache.hash = hash;
+        cache.rowPointers.assign(mat->rowPointers, mat->rowPointers + mat->Nb + 1);
+        cache.colIndices.assign(mat->colIndices, mat->colIndices + mat->nnzbs);
+        cache.numColors = numColors;
+        cache.toOrder = toOrder;
+        cache.fromOrder = fromOrder;
+        cache.rowsPerColor = rowsPerColor;
+    }
     if (verbosity >= 1) {
         out << "BILU0 analysis took: " << t_analysis.stop() << " s, " << numColors << " colors\n";
     }
@@ -130,6 +196,10 @@ bool BILU0<block_size>::analyze_matrix(BlockedMatrix *mat)
     s.LUvals = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(double) * bs * bs * LUmat->nnzbs);
     s.LUcols = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(int) * LUmat->nnzbs);
     s.LUrows = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(int) * (LUmat->Nb + 1));
+    if (float_factors) {
+        s.LUvalsFloat = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(float) * bs * bs * LUmat->nnzbs);
+        s.invDiagValsFloat = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(float) * bs * bs * mat->Nb);
+    }
 #endif
 
     events.resize(2);
@@ -235,6 +305,11 @@ bool BILU0<block_size>::create_preconditioner(BlockedMatrix *mat)
         }
         OpenclKernels::ILU_decomp(firstRow, lastRow, s.LUvals, s.LUcols, s.LUrows, s.diagIndex, s.invDiagVals, Nb, block_size);
     }
+    if (float_factors) {
+        // the decomposition is done in double precision, only its application uses the copies
+        OpenclKernels::convert_to_float(s.LUvals, s.LUvalsFloat, LUmat->nnzbs * bs * bs);
+        OpenclKernels::convert_to_float(s.invDiagVals, s.invDiagValsFloat, Nb * bs * bs);
+    }
 
     if (verbosity >= 3) {
         out << "BILU0 decomposition: " << t_decomposition.stop() << " s";
@@ -259,7 +334,11 @@ void BILU0<block_size>::apply(const cl::Buffer& y, cl::Buffer& x)
 #if CHOW_PATEL
         OpenclKernels::ILU_apply1(s.Lvals, s.Lcols, s.Lrows, s.diagIndex, y, x, s.rowsPerColor, color, Nb, block_size);
 #else
-        OpenclKernels::ILU_apply1(s.LUvals, s.LUcols, s.LUrows, s.diagIndex, y, x, s.rowsPerColor, color, Nb, block_size);
+        if (float_factors) {
+            OpenclKernels::ILU_apply1(s.LUvalsFloat, s.LUcols, s.LUrows, s.diagIndex, y, x, s.rowsPerColor, color, Nb, block_size, true);
+        } else {
+            OpenclKernels::ILU_apply1(s.LUvals, s.LUcols, s.LUrows, s.diagIndex, y, x, s.rowsPerColor, color, Nb, block_size);
+        }
 #endif
     }
 
@@ -267,7 +346,11 @@ void BILU0<block_size>::apply(const cl::Buffer& y, cl::Buffer& x)
 #if CHOW_PATEL
         OpenclKernels::ILU_apply2(s.Uvals, s.Ucols, s.Urows, s.diagIndex, s.invDiagVals, x, s.rowsPerColor, color, Nb, block_size);
 #else
-        OpenclKernels::ILU_apply2(s.LUvals, s.LUcols, s.LUrows, s.diagIndex, s.invDiagVals, x, s.rowsPerColor, color, Nb, block_size);
+        if (float_factors) {
+            OpenclKernels::ILU_apply2(s.LUvalsFloat, s.LUcols, s.LUrows, s.diagIndex, s.invDiagValsFloat, x, s.rowsPerColor, color, Nb, block_size, true);
+        } else {
+            OpenclKernels::ILU_apply2(s.LUvals, s.LUcols, s.LUrows, s.diagIndex, s.invDiagVals, x, s.rowsPerColor, color, Nb, block_size);
+        }
 #endif
     }
 
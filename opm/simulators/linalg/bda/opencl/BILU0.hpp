@@ -67,6 +67,7 @@ private:
     std::once_flag pattern_uploaded;
 
     ILUReorder opencl_ilu_reorder;
+    bool float_factors = false;     // apply single precision copies of the factors
 
     typedef struct {
         cl::Buffer invDiagVals;
@@ -77,6 +78,7 @@ private:
         cl::Buffer Uvals, Ucols, Urows;
 #else
         cl::Buffer LUvals, LUcols, LUrows;
+        cl::Buffer LUvalsFloat, invDiagValsFloat;  // only used with float_factors
 #endif
     } GPU_storage;
 
@@ -99,6 +101,10 @@ public:
     // apply preconditioner, x = prec(y)
     void apply(const cl::Buffer& y, cl::Buffer& x) override;
 
+    // apply the factors in single precision, they are still computed in double precision
+    // must be set before analyze_matrix(), not supported with CHOW_PATEL
+    void setFloatFactors(bool float_factors);
+
     int* getToOrder() override
     {
         return toOrder.data();
@@ -23,12 +23,9 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <dune/common/timer.hh>
 
-#include <dune/common/shared_ptr.hh>
+#include <functional>
+#include <vector>
 
-#include <opm/simulators/linalg/PreconditionerFactory.hpp>
-#include <opm/simulators/linalg/PropertyTree.hpp>
-
-#include <opm/simulators/linalg/bda/BdaBridge.hpp>
 #include <opm/simulators/linalg/bda/BlockedMatrix.hpp>
 #include <opm/simulators/linalg/bda/opencl/CPR.hpp>
 #include <opm/simulators/linalg/bda/opencl/OpenclMatrix.hpp>
@@ -45,10 +42,9 @@ using Dune::Timer;
 
 template <unsigned int block_size>
 CPR<block_size>::CPR(int verbosity_, ILUReorder opencl_ilu_reorder_) :
-    Preconditioner<block_size>(verbosity_), opencl_ilu_reorder(opencl_ilu_reorder_)
+    Preconditioner<block_size>(verbosity_), CprCreation<block_size>(), opencl_ilu_reorder(opencl_ilu_reorder_)
 {
     bilu0 = std::make_unique<BILU0<block_size> >(opencl_ilu_reorder, verbosity_);
-    diagIndices.resize(1);
 }
 
 
@@ -92,7 +88,14 @@ bool CPR<block_size>::create_preconditioner(BlockedMatrix *mat_) {
     }
 
     Dune::Timer t_amg;
-    create_preconditioner_amg(mat); // already points to bilu0::rmat if needed
+    this->create_preconditioner_amg(mat); // already points to bilu0::rmat if needed
+
+    // initialize OpenclMatrices and Buffers if needed
+    auto init_func = std::bind(&CPR::init_opencl_buffers, this);
+    std::call_once(opencl_buffers_allocated, init_func);
+
+    // upload matrices and vectors to GPU
+    opencl_upload();
     if (verbosity >= 3) {
         std::ostringstream out;
         out << "CPR create_preconditioner_amg(): " << t_amg.stop() << " s";
@@ -101,40 +104,6 @@ bool CPR<block_size>::create_preconditioner(BlockedMatrix *mat_) {
     return result;
 }
 
-// return the absolute value of the N elements for which the absolute value is highest
-double get_absmax(const double *data, const int N) {
-    return std::abs(*std::max_element(data, data + N, [](double a, double b){return std::fabs(a) < std::fabs(b);}));
-}
-
-
-// solve A^T * x = b
-void solve_transposed_3x3(const double *A, const double *b, double *x) {
-    const int B = 3;
-    // from dune-common/densematrix.hh, but transposed, so replace [r*B+c] with [r+c*B]
-    double t4  = A[0+0*B] * A[1+1*B];
-    double t6  = A[0+0*B] * A[1+2*B];
-    double t8  = A[0+1*B] * A[1+0*B];
-    double t10 = A[0+2*B] * A[1+0*B];
-    double t12 = A[0+1*B] * A[2+0*B];
-    double t14 = A[0+2*B] * A[2+0*B];
-
-    double d = (t4*A[2+2*B]-t6*A[2+1*B]-t8*A[2+2*B]+
-          t10*A[2+1*B]+t12*A[1+2*B]-t14*A[1+1*B]); //determinant
-
-    x[0] = (b[0]*A[1+1*B]*A[2+2*B] - b[0]*A[2+1*B]*A[1+2*B]
-          - b[1] *A[0+1*B]*A[2+2*B] + b[1]*A[2+1*B]*A[0+2*B]
-          + b[2] *A[0+1*B]*A[1+2*B] - b[2]*A[1+1*B]*A[0+2*B]) / d;
-
-    x[1] = (A[0+0*B]*b[1]*A[2+2*B] - A[0+0*B]*b[2]*A[1+2*B]
-          - A[1+0*B] *b[0]*A[2+2*B] + A[1+0*B]*b[2]*A[0+2*B]
-          + A[2+0*B] *b[0]*A[1+2*B] - A[2+0*B]*b[1]*A[0+2*B]) / d;
-
-    x[2] = (A[0+0*B]*A[1+1*B]*b[2] - A[0+0*B]*A[2+1*B]*b[1]
-          - A[1+0*B] *A[0+1*B]*b[2] + A[1+0*B]*A[2+1*B]*b[0]
-          + A[2+0*B] *A[0+1*B]*b[1] - A[2+0*B]*A[1+1*B]*b[0]) / d;
-}
-
-
 template <unsigned int block_size>
 void CPR<block_size>::init_opencl_buffers() {
     d_Amatrices.reserve(num_levels);
@@ -182,243 +151,12 @@ void CPR<block_size>::opencl_upload() {
     for (unsigned int i = 0; i < Rmatrices.size(); ++i) {
         d_Rmatrices[i].upload(queue.get(), &Rmatrices[i]);
     }
-}
-
-
-template <unsigned int block_size>
-void CPR<block_size>::create_preconditioner_amg(BlockedMatrix *mat_) {
-    this->mat = mat_;
-
-    coarse_vals.resize(nnzb);
-    coarse_x.resize(Nb);
-    coarse_y.resize(Nb);
-    weights.resize(N);
-
-    try{
-        double rhs[] = {0, 0, 0};
-        rhs[pressure_idx] = 1;
-
-        // find diagonal index for each row
-        if (diagIndices[0].empty()) {
-            diagIndices[0].resize(Nb);
-            for (int row = 0; row < Nb; ++row) {
-                int start = mat->rowPointers[row];
-                int end = mat->rowPointers[row + 1];
-                auto candidate = std::find(mat->colIndices + start, mat->colIndices + end, row);
-                assert(candidate != mat->colIndices + end);
-                diagIndices[0][row] = candidate - mat->colIndices;
-            }
-        }
-
-        // calculate weights for each row
-        for (int row = 0; row < Nb; ++row) {
-            // solve to find weights
-            double *row_weights = weights.data() + block_size * row; // weights for this row
-            solve_transposed_3x3(mat->nnzValues + block_size * block_size * diagIndices[0][row], rhs, row_weights);
-
-            // normalize weights for this row
-            double abs_max = get_absmax(row_weights, block_size);
-            for(unsigned int i = 0; i < block_size; i++){
-                row_weights[i] /= abs_max;
-            }
-        }
-
-        // extract pressure
-        // transform blocks to scalars to create scalar linear system
-        for (int row = 0; row < Nb; ++row) {
-            int start = mat->rowPointers[row];
-            int end = mat->rowPointers[row + 1];
-            for (int idx = start; idx < end; ++idx) {
-                double *block = mat->nnzValues + idx * block_size * block_size;
-                double *row_weights = weights.data() + block_size * row;
-                double value = 0.0;
-                for (unsigned int i = 0; i < block_size; ++i) {
-                    value += block[block_size * i + pressure_idx] * row_weights[i];
-                }
-                coarse_vals[idx] = value;
-            }
-        }
-
-#if HAVE_MPI
-        using Communication = Dune::OwnerOverlapCopyCommunication<int, int>;
-#else
-        using Communication = Dune::Amg::SequentialInformation;
-#endif
-        using OverlapFlags = Dune::NegateSet<Communication::OwnerSet>;
-        if (recalculate_aggregates) {
-            dune_coarse = std::make_unique<DuneMat>(Nb, Nb, nnzb, DuneMat::row_wise);
-
-            typedef DuneMat::CreateIterator Iter;
-
-            // setup sparsity pattern
-            for(Iter row = dune_coarse->createbegin(); row != dune_coarse->createend(); ++row){
-                int start = mat->rowPointers[row.index()];
-                int end = mat->rowPointers[row.index() + 1];
-                for (int idx = start; idx < end; ++idx) {
-                    int col = mat->colIndices[idx];
-                    row.insert(col);
-                }
-            }
-
-            // set values
-            for (int row = 0; row < Nb; ++row) {
-                int start = mat->rowPointers[row];
-                int end = mat->rowPointers[row + 1];
-                for (int idx = start; idx < end; ++idx) {
-                    int col = mat->colIndices[idx];
-                    (*dune_coarse)[row][col] = coarse_vals[idx];
-                }
-            }
-
-            dune_op = std::make_shared<MatrixOperator>(*dune_coarse);
-#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 7)
-            Dune::Amg::SequentialInformation seqinfo;
-            dune_amg = std::make_unique<DuneAmg>(dune_op, Dune::stackobject_to_shared_ptr(seqinfo));
-#else
-            dune_amg = std::make_unique<DuneAmg>(*dune_op);
-#endif
-
-            Opm::PropertyTree property_tree;
-            property_tree.put("alpha", 0.333333333333);
-
-            // The matrix has a symmetric sparsity pattern, but the values are not symmetric
-            // Yet a SymmetricDependency is used in AMGCPR
-            // An UnSymmetricCriterion is also available
-            // using Criterion = Dune::Amg::CoarsenCriterion<Dune::Amg::UnSymmetricCriterion<DuneMat, Dune::Amg::FirstDiagonal> >;
-            using CriterionBase = Dune::Amg::AggregationCriterion<Dune::Amg::SymmetricDependency<DuneMat, Dune::Amg::FirstDiagonal>>;
-            using Criterion = Dune::Amg::CoarsenCriterion<CriterionBase>;
-            const Criterion c = Opm::PreconditionerFactory<MatrixOperator, Dune::Amg::SequentialInformation>::amgCriterion(property_tree);
-            num_pre_smooth_steps = c.getNoPreSmoothSteps();
-            num_post_smooth_steps = c.getNoPostSmoothSteps();
-
-            dune_amg->build<OverlapFlags>(c);
-
-            analyzeHierarchy();
-            analyzeAggregateMaps();
-
-            recalculate_aggregates = false;
-        } else {
-            // update values of coarsest level in AMG
-            // this works because that level is actually a reference to the DuneMat held by dune_coarse
-            for (int row = 0; row < Nb; ++row) {
-                int start = mat->rowPointers[row];
-                int end = mat->rowPointers[row + 1];
-                for (int idx = start; idx < end; ++idx) {
-                    int col = mat->colIndices[idx];
-                    (*dune_coarse)[row][col] = coarse_vals[idx];
-                }
-            }
-
-            // update the rest of the AMG hierarchy
-            dune_amg->recalculateGalerkin(OverlapFlags());
-            analyzeHierarchy();
-        }
-
-        // initialize OpenclMatrices and Buffers if needed
-        auto init_func = std::bind(&CPR::init_opencl_buffers, this);
-        std::call_once(opencl_buffers_allocated, init_func);
-
-        // upload matrices and vectors to GPU
-        opencl_upload();
-
-    } catch (const std::exception& ex) {
-        std::cerr << "Caught exception: " << ex.what() << std::endl;
-        throw ex;
-    }
-}
-
-
-template <unsigned int block_size>
-void CPR<block_size>::analyzeHierarchy() {
-    const DuneAmg::ParallelMatrixHierarchy& matrixHierarchy = dune_amg->matrices();
-
-    // store coarsest AMG level in umfpack format, also performs LU decomposition
-    umfpack.setMatrix((*matrixHierarchy.coarsest()).getmat());
-
-    num_levels = dune_amg->levels();
-    level_sizes.resize(num_levels);
-    diagIndices.resize(num_levels);
-
-    Amatrices.reserve(num_levels);
-    Rmatrices.reserve(num_levels - 1);  // coarsest level does not need one
-    invDiags.reserve(num_levels);
-
-    Amatrices.clear();
-    invDiags.clear();
-
-    // matrixIter.dereference() returns MatrixAdapter
-    // matrixIter.dereference().getmat() returns BCRSMat
-    DuneAmg::ParallelMatrixHierarchy::ConstIterator matrixIter = matrixHierarchy.finest();
-    for(int level = 0; level < num_levels; ++matrixIter, ++level) {
-        const auto& A = matrixIter.dereference().getmat();
-        level_sizes[level] = A.N();
-        diagIndices[level].reserve(A.N());
-
-        // extract matrix A
-        Amatrices.emplace_back(A.N(), A.nonzeroes());
-        // contiguous copy is not possible
-        // std::copy(&(A[0][0][0][0]), &(A[0][0][0][0]) + A.nonzeroes(), Amatrices.back().nnzValues.data());
-        // also update diagonal indices if needed, level 0 is already filled in create_preconditioner()
-        int nnz_idx = 0;
-        const bool fillDiagIndices = diagIndices[level].empty();
-        for (typename DuneMat::const_iterator r = A.begin(); r != A.end(); ++r) {
-            for (auto c = r->begin(); c != r->end(); ++c) {
-                Amatrices.back().nnzValues[nnz_idx] = A[r.index()][c.index()];
-                if (fillDiagIndices && r.index() == c.index()) {
-                    diagIndices[level].emplace_back(nnz_idx);
-                }
-                nnz_idx++;
-            }
-        }
-
-        Opm::BdaBridge<DuneMat, DuneVec, 1>::copySparsityPatternFromISTL(A, Amatrices.back().rowPointers, Amatrices.back().colIndices);
-
-        // compute inverse diagonal values for current level
-        invDiags.emplace_back(A.N());
-        for (unsigned int row = 0; row < A.N(); ++row) {
-            invDiags.back()[row] = 1 / Amatrices.back().nnzValues[diagIndices[level][row]];
-        }
-    }
-}
-
-
-template <unsigned int block_size>
-void CPR<block_size>::analyzeAggregateMaps() {
-
-    PcolIndices.resize(num_levels - 1);
-    Rmatrices.clear();
-
-    const DuneAmg::AggregatesMapList& aggregatesMaps = dune_amg->aggregatesMaps();
-
-    DuneAmg::AggregatesMapList::const_iterator mapIter = aggregatesMaps.begin();
-    for(int level = 0; level < num_levels - 1; ++mapIter, ++level) {
-        DuneAmg::AggregatesMap *map = *mapIter;
-
-        Rmatrices.emplace_back(level_sizes[level+1], level_sizes[level], level_sizes[level]);
-        std::fill(Rmatrices.back().nnzValues.begin(), Rmatrices.back().nnzValues.end(), 1.0);
-
-        // get indices for each row of P and R
-        std::vector<std::vector<unsigned> > indicesR(level_sizes[level+1]);
-        PcolIndices[level].resize(level_sizes[level]);
-
-        using AggregateIterator = DuneAmg::AggregatesMap::const_iterator;
-        for(AggregateIterator ai = map->begin(); ai != map->end(); ++ai){
-            if (*ai != DuneAmg::AggregatesMap::ISOLATED) {
-                const long int diff = ai - map->begin();
-                PcolIndices[level][diff] = *ai;
-                indicesR[*ai].emplace_back(diff);
-            }
-        }
-
-        int col_idx = 0;
-        // set sparsity pattern of R
-        Rmatrices.back().rowPointers[0] = 0;
-        for (unsigned int i = 0; i < indicesR.size(); ++i) {
-            Rmatrices.back().rowPointers[i + 1] = Rmatrices.back().rowPointers[i] + indicesR[i].size();
-            for (auto it = indicesR[i].begin(); it != indicesR[i].end(); ++it) {
-                Rmatrices.back().colIndices[col_idx++] = *it;
-            }
+    if (dense_coarse_solve) {
+        if (!d_coarse_inverse || d_coarse_inverse->Nb != coarse_inverse->N) {
+            d_coarse_inverse = std::make_unique<OpenclMatrix>(context.get(), coarse_inverse->N, coarse_inverse->N,
+                                                              coarse_inverse->nnzs, 1);
         }
+        d_coarse_inverse->upload(queue.get(), coarse_inverse.get());
     }
 }
 
@@ -430,6 +168,13 @@ void CPR<block_size>::amg_cycle_gpu(const int level, cl::Buffer &y, cl::Buffer &
     int Ncur = A->Nb;
 
     if (level == num_levels - 1) {
+        if (dense_coarse_solve) {
+            // solve coarsest level on the device, x = A^{-1} y
+            OpenclKernels::spmv(d_coarse_inverse->nnzValues, d_coarse_inverse->colIndices, d_coarse_inverse->rowPointers,
+                                y, x, Ncur, 1);
+            return;
+        }
+
         // solve coarsest level
         std::vector<double> h_y(Ncur), h_x(Ncur, 0);
 
@@ -499,11 +244,11 @@ void CPR<block_size>::apply_amg(const cl::Buffer& y, cl::Buffer& x) {
     }
 
     OpenclKernels::residual(d_mat->nnzValues, d_mat->colIndices, d_mat->rowPointers, x, y, *d_rs, Nb, block_size);
-    OpenclKernels::full_to_pressure_restriction(*d_rs, *d_weights, *d_coarse_y, Nb);
+    OpenclKernels::full_to_pressure_restriction(*d_rs, *d_weights, *d_coarse_y, Nb, block_size);
 
     amg_cycle_gpu(0, *d_coarse_y, *d_coarse_x);
 
-    OpenclKernels::add_coarse_pressure_correction(*d_coarse_x, x, pressure_idx, Nb);
+    OpenclKernels::add_coarse_pressure_correction(*d_coarse_x, x, pressure_idx, Nb, block_size);
 }
 
 template <unsigned int block_size>
@@ -22,16 +22,9 @@
 
 #include <mutex>
 
-#include <dune/common/version.hh>
-#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 7)
-#include <dune/istl/paamg/matrixhierarchy.hh>
-#else
-#include <dune/istl/paamg/hierarchy.hh>
-#endif
-#include <dune/istl/umfpack.hh>
-
 #include <opm/simulators/linalg/bda/opencl/opencl.hpp>
 #include <opm/simulators/linalg/bda/opencl/BILU0.hpp>
+#include <opm/simulators/linalg/bda/CprCreation.hpp>
 #include <opm/simulators/linalg/bda/Matrix.hpp>
 #include <opm/simulators/linalg/bda/opencl/OpenclMatrix.hpp>
 #include <opm/simulators/linalg/bda/ILUReorder.hpp>
@@ -47,10 +40,12 @@ namespace Accelerator
 class BlockedMatrix;
 
 /// This class implements a Constrained Pressure Residual (CPR) preconditioner
+/// The AMG hierarchy is created by CprCreation, this class applies it with OpenCL
 template <unsigned int block_size>
-class CPR : public Preconditioner<block_size>
+class CPR : public Preconditioner<block_size>, public CprCreation<block_size>
 {
     typedef Preconditioner<block_size> Base;
+    typedef CprCreation<block_size> CprBase;
 
     using Base::N;
     using Base::Nb;
@@ -62,14 +57,23 @@ class CPR : public Preconditioner<block_size>
     using Base::events;
     using Base::err;
 
+    using CprBase::num_levels;
+    using CprBase::weights;
+    using CprBase::Amatrices;
+    using CprBase::Rmatrices;
+    using CprBase::PcolIndices;
+    using CprBase::invDiags;
+    using CprBase::mat;
+    using CprBase::umfpack;
+    using CprBase::coarse_inverse;
+    using CprBase::dense_coarse_solve;
+    using CprBase::pressure_idx;
+    using CprBase::num_pre_smooth_steps;
+    using CprBase::num_post_smooth_steps;
+
 private:
-    int num_levels;
-    std::vector<double> weights, coarse_vals, coarse_x, coarse_y;
-    std::vector<Matrix> Amatrices, Rmatrices; // scalar matrices that represent the AMG hierarchy
     std::vector<OpenclMatrix> d_Amatrices, d_Rmatrices; // scalar matrices that represent the AMG hierarchy
-    std::vector<std::vector<int> > PcolIndices; // prolongation does not need a full matrix, only store colIndices
     std::vector<cl::Buffer> d_PcolIndices;
-    std::vector<std::vector<double> > invDiags; // inverse of diagonal of Amatrices
     std::vector<cl::Buffer> d_invDiags;
     std::vector<cl::Buffer> d_t, d_f, d_u; // intermediate vectors used during amg cycle
     std::unique_ptr<cl::Buffer> d_rs;      // use before extracting the pressure
@@ -79,34 +83,11 @@ private:
     std::once_flag opencl_buffers_allocated;  // only allocate OpenCL Buffers once
 
     std::unique_ptr<BILU0<block_size> > bilu0;                    // Blocked ILU0 preconditioner
-    BlockedMatrix *mat = nullptr;    // input matrix, blocked
-
-    using DuneMat = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1> >;
-    using DuneVec = Dune::BlockVector<Dune::FieldVector<double, 1> >;
-    using MatrixOperator = Dune::MatrixAdapter<DuneMat, DuneVec, DuneVec>;
-    using DuneAmg = Dune::Amg::MatrixHierarchy<MatrixOperator, Dune::Amg::SequentialInformation>;
-    std::unique_ptr<DuneAmg> dune_amg;
-    std::unique_ptr<DuneMat> dune_coarse;       // extracted pressure matrix, finest level in AMG hierarchy
-    std::shared_ptr<MatrixOperator> dune_op;    // operator, input to Dune AMG
-    std::vector<int> level_sizes;               // size of each level in the AMG hierarchy
-    std::vector<std::vector<int> > diagIndices; // index of diagonal value for each level
-    Dune::UMFPack<DuneMat> umfpack;             // dune/istl/umfpack object used to solve the coarsest level of AMG
-    bool always_recalculate_aggregates = false; // OPM always reuses the aggregates by default
-    bool recalculate_aggregates = true;         // only rerecalculate if true
-    const int pressure_idx = 1;                 // hardcoded to mimic OPM
-    unsigned num_pre_smooth_steps;              // number of Jacobi smooth steps before restriction
-    unsigned num_post_smooth_steps;             // number of Jacobi smooth steps after prolongation
+    std::unique_ptr<OpenclMatrix> d_coarse_inverse; // dense inverse of the coarsest level on the device
 
     std::unique_ptr<openclSolverBackend<1> > coarse_solver; // coarse solver is scalar
     ILUReorder opencl_ilu_reorder;                          // reordering strategy for ILU0 in coarse solver
 
-    // Analyze the AMG hierarchy build by Dune
-    void analyzeHierarchy();
-
-    // Analyze the aggregateMaps from the AMG hierarchy
-    // These can be reused, so only use when recalculate_aggregates is true
-    void analyzeAggregateMaps();
-
     // Initialize and allocate matrices and vectors
     void init_opencl_buffers();
 
@@ -118,8 +99,6 @@ private:
 
     void amg_cycle_gpu(const int level, cl::Buffer &y, cl::Buffer &x);
 
-    void create_preconditioner_amg(BlockedMatrix *mat);
-
 public:
 
     CPR(int verbosity, ILUReorder opencl_ilu_reorder);
@@ -151,11 +130,6 @@ public:
     }
 };
 
-// solve A^T * x = b
-// A should represent a 3x3 matrix
-// x and b are vectors with 3 elements
-void solve_transposed_3x3(const double *A, const double *b, double *x);
-
 } // namespace Accelerator
 } // namespace Opm
 
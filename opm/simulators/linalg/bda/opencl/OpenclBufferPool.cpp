@@ -0,0 +1,51 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/linalg/bda/opencl/OpenclBufferPool.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace Opm
+{
+namespace Accelerator
+{
+
+cl::Buffer& OpenclBufferPool::get(cl::Context& context, Slot slot, std::size_t bytes)
+{
+    const auto idx = static_cast<std::size_t>(slot);
+    if (bytes > sizes[idx] || sizes[idx] == 0) {
+        // some headroom, such that a few more perforations or segments fit
+        // an opencl buffer must not be empty
+        sizes[idx] = std::max(bytes + bytes / 8, sizeof(double));
+        buffers[idx] = cl::Buffer(context, CL_MEM_READ_WRITE, sizes[idx]);
+        ++num_allocations;
+    }
+    return buffers[idx];
+}
+
+std::size_t OpenclBufferPool::bytes() const
+{
+    return std::accumulate(sizes.begin(), sizes.end(), std::size_t{0});
+}
+
+} // namespace Accelerator
+} // namespace Opm
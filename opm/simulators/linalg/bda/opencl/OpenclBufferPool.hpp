@@ -0,0 +1,72 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_OPENCLBUFFERPOOL_HEADER_INCLUDED
+#define OPM_OPENCLBUFFERPOOL_HEADER_INCLUDED
+
+#include <array>
+#include <cstddef>
+
+#include <opm/simulators/linalg/bda/opencl/opencl.hpp>
+
+namespace Opm
+{
+namespace Accelerator
+{
+
+/// Device buffers of objects which are created again for every linear solve,
+/// like the WellContributions. The pool lives as long as the solver backend,
+/// and a buffer is only reallocated if a larger size is requested than ever
+/// before, so a change of the wells does not allocate device memory unless
+/// the wells grow beyond their largest size.
+class OpenclBufferPool {
+public:
+    enum class Slot {
+        StdWellCnnzs, StdWellDnnzs, StdWellBnnzs, StdWellCcols, StdWellBcols, StdWellValPointers,
+        MsWellCvals, MsWellBvals, MsWellCols, MsWellRowPointers, MsWellSegPointers,
+        MsWellDinv, MsWellDinvPointers, MsWellZ1, MsWellZ2,
+        NumSlots
+    };
+
+    /// Get the buffer of a slot with at least the requested size, the contents
+    /// are undefined. The reference stays valid as long as the pool.
+    /// \param[in] context    the opencl context of the buffers
+    /// \param[in] slot       the user of the buffer
+    /// \param[in] bytes      minimum size of the buffer
+    cl::Buffer& get(cl::Context& context, Slot slot, std::size_t bytes);
+
+    /// Total size of the buffers of the pool
+    std::size_t bytes() const;
+
+    /// Number of device allocations done by the pool
+    int allocations() const
+    { return num_allocations; }
+
+private:
+    static constexpr std::size_t num_slots = static_cast<std::size_t>(Slot::NumSlots);
+
+    std::array<cl::Buffer, num_slots> buffers;
+    std::array<std::size_t, num_slots> sizes{};
+    int num_allocations = 0;
+};
+
+} // namespace Accelerator
+} // namespace Opm
+
+#endif // OPM_OPENCLBUFFERPOOL_HEADER_INCLUDED
@@ -0,0 +1,136 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <opm/simulators/linalg/bda/opencl/OpenclSellMatrix.hpp>
+#include <opm/simulators/linalg/bda/opencl/openclKernels.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace Opm
+{
+namespace Accelerator
+{
+
+OpenclSellMatrix::Layout OpenclSellMatrix::buildLayout(const int *rowPointers, const int *colIndices, int Nb, int slice_height, int sigma)
+{
+    if (slice_height < 1 || sigma < 1) {
+        OPM_THROW(std::logic_error, "OpenclSellMatrix needs a positive slice height and sorting window");
+    }
+    const auto rowLength = [rowPointers](int row) { return rowPointers[row + 1] - rowPointers[row]; };
+
+    // sort the rows by decreasing length within every window of sigma rows,
+    // the sort is stable such that rows of equal length keep their order
+    std::vector<int> order(Nb);
+    std::iota(order.begin(), order.end(), 0);
+    for (int first = 0; first < Nb; first += sigma) {
+        const int last = std::min(first + sigma, Nb);
+        std::stable_sort(order.begin() + first, order.begin() + last,
+                         [&rowLength](int a, int b) { return rowLength(a) > rowLength(b); });
+    }
+
+    Layout layout;
+    layout.num_slices = (Nb + slice_height - 1) / slice_height;
+    layout.slicePointers.resize(layout.num_slices + 1);
+    layout.rowIndices.assign(layout.num_slices * slice_height, -1);
+    layout.slicePointers[0] = 0;
+    for (int slice = 0; slice < layout.num_slices; ++slice) {
+        int width = 0;
+        for (int r = 0; r < slice_height && slice * slice_height + r < Nb; ++r) {
+            const int row = order[slice * slice_height + r];
+            layout.rowIndices[slice * slice_height + r] = row;
+            width = std::max(width, rowLength(row));
+        }
+        layout.slicePointers[slice + 1] = layout.slicePointers[slice] + width * slice_height;
+    }
+
+    // block j of row r of a slice is stored at slicePointers[slice] + j * slice_height + r,
+    // the padding at the end of a row has column -1
+    layout.colIndices.assign(layout.slicePointers[layout.num_slices], -1);
+    layout.blockMap.assign(layout.slicePointers[layout.num_slices], -1);
+    for (int slice = 0; slice < layout.num_slices; ++slice) {
+        for (int r = 0; r < slice_height; ++r) {
+            const int row = layout.rowIndices[slice * slice_height + r];
+            if (row < 0) {
+                continue;
+            }
+            for (int j = 0; j < rowLength(row); ++j) {
+                const int block = layout.slicePointers[slice] + j * slice_height + r;
+                layout.colIndices[block] = colIndices[rowPointers[row] + j];
+                layout.blockMap[block] = rowPointers[row] + j;
+            }
+        }
+    }
+    return layout;
+}
+
+OpenclSellMatrix::OpenclSellMatrix(cl::Context *context, cl::CommandQueue *queue_, const int *rowPointers, const int *colIndices_,
+                                   int Nb_, unsigned int block_size_, int slice_height_, int sigma)
+    : Nb(Nb_),
+      nnzbs(rowPointers[Nb_]),
+      slice_height(slice_height_),
+      block_size(block_size_),
+      queue(queue_)
+{
+    const Layout layout = buildLayout(rowPointers, colIndices_, Nb, slice_height, sigma);
+    num_slices = layout.num_slices;
+    padded_nnzbs = layout.slicePointers.back();
+
+    // an opencl buffer must not be empty
+    const std::size_t num_blocks = std::max(padded_nnzbs, 1);
+    nnzValues = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(double) * block_size * block_size * num_blocks);
+    colIndices = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(int) * num_blocks);
+    blockMap = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(int) * num_blocks);
+    slicePointers = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(int) * (num_slices + 1));
+    rowIndices = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(int) * std::max(num_slices * slice_height, 1));
+
+    std::vector<cl::Event> events;
+    events.reserve(4);
+    cl_int err = CL_SUCCESS;
+    const auto write = [&](cl::Buffer& buffer, const std::vector<int>& data) {
+        if (!data.empty()) {
+            events.emplace_back();
+            err |= queue->enqueueWriteBuffer(buffer, CL_FALSE, 0, sizeof(int) * data.size(), data.data(), nullptr, &events.back());
+        }
+    };
+    write(slicePointers, layout.slicePointers);
+    write(colIndices, layout.colIndices);
+    write(blockMap, layout.blockMap);
+    write(rowIndices, layout.rowIndices);
+
+    cl::WaitForEvents(events);
+    events.clear();
+    if (err != CL_SUCCESS) {
+        // enqueueWriteBuffer is C and does not throw exceptions like C++ OpenCL
+        OPM_THROW(std::logic_error, "OpenclSellMatrix OpenCL enqueueWriteBuffer error");
+    }
+}
+
+void OpenclSellMatrix::gather(const cl::Buffer& bcsrVals)
+{
+    OpenclKernels::sell_gather(bcsrVals, blockMap, nnzValues, padded_nnzbs, slice_height, block_size);
+}
+
+} // namespace Accelerator
+} // namespace Opm
@@ -0,0 +1,93 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_OPENCLSELLMATRIX_HEADER_INCLUDED
+#define OPM_OPENCLSELLMATRIX_HEADER_INCLUDED
+
+#include <vector>
+
+#include <opm/simulators/linalg/bda/opencl/opencl.hpp>
+
+namespace Opm
+{
+namespace Accelerator
+{
+
+/// Blocked sliced ELLPACK (SELL-C-sigma) copy of a BCSR matrix on the GPU.
+/// The rows are sorted by their number of blocks within windows of sigma rows,
+/// and every slice_height consecutive sorted rows form a slice, which is padded
+/// to the length of its longest row. The blocks of a slice are stored column
+/// by column, and the entries of these blocks are interleaved over the rows of
+/// the slice, such that neighbouring work-items read neighbouring addresses
+/// and rows of very different lengths do not end up in the same slice.
+/// Only the sparsity pattern is built on the CPU, the values are gathered from
+/// the BCSR values on the GPU by gather() after every upload of the matrix.
+class OpenclSellMatrix {
+public:
+    /// Sparsity pattern of the sliced format, built on the CPU
+    struct Layout {
+        int num_slices = 0;
+        std::vector<int> slicePointers;   // first stored block of every slice, num_slices + 1 entries
+        std::vector<int> colIndices;      // block column of every stored block, -1 for padding
+        std::vector<int> blockMap;        // BCSR block of every stored block, -1 for padding
+        std::vector<int> rowIndices;      // BCSR row of every row of the slices, -1 for padding
+    };
+
+    /// Build the sliced layout of a BCSR sparsity pattern
+    /// \param[in] rowPointers    BCSR row pointers, Nb + 1 entries
+    /// \param[in] colIndices     BCSR column indices
+    /// \param[in] Nb             number of block rows
+    /// \param[in] slice_height   number of rows per slice
+    /// \param[in] sigma          number of rows within which the rows are sorted, 1 to keep the order
+    /// \return                   the layout
+    static Layout buildLayout(const int *rowPointers, const int *colIndices, int Nb, int slice_height, int sigma);
+
+    /// Build the layout of the BCSR pattern and upload it
+    OpenclSellMatrix(cl::Context *context, cl::CommandQueue *queue, const int *rowPointers, const int *colIndices,
+                     int Nb, unsigned int block_size, int slice_height = 32, int sigma = 256);
+
+    /// Fill the values from the BCSR values on the GPU, with the sparsity pattern given to the constructor
+    /// The gather is enqueued on the queue, later kernels on the same queue see the new values
+    /// \param[in] bcsrVals     BCSR values on the GPU
+    void gather(const cl::Buffer& bcsrVals);
+
+    /// Stored blocks, including the padding, per nonzero block of the BCSR matrix
+    double fillRatio() const
+    { return nnzbs > 0 ? static_cast<double>(padded_nnzbs) / nnzbs : 1.0; }
+
+    cl::Buffer nnzValues;
+    cl::Buffer colIndices;
+    cl::Buffer slicePointers;
+    cl::Buffer rowIndices;
+    cl::Buffer blockMap;
+    int Nb;
+    int nnzbs;
+    int padded_nnzbs;
+    int num_slices;
+    int slice_height;
+    unsigned int block_size;
+
+private:
+    cl::CommandQueue *queue;
+};
+
+} // namespace Accelerator
+} // namespace Opm
+
+#endif // OPM_OPENCLSELLMATRIX_HEADER_INCLUDED
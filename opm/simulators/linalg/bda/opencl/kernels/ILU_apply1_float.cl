@@ -0,0 +1,73 @@
+/// ILU apply part 1: forward substitution, with the factors in single precision.
+/// Solves L*x=y where L is a lower triangular sparse blocked matrix.
+/// Here, L is inside a normal, square matrix.
+/// In this case, diagIndex indicates where the rows of L end.
+/// The vectors stay in double precision, the products are computed in single precision.
+__kernel void ILU_apply1_float(
+    __global const float *LUvals,
+    __global const unsigned int *LUcols,
+    __global const unsigned int *LUrows,
+    __global const int *diagIndex,
+    __global const double *y,
+    __global double *x,
+    __global const unsigned int *nodesPerColorPrefix,
+    const unsigned int color,
+    const unsigned int block_size,
+    __local float *tmp)
+{
+    const unsigned int warpsize = 32;
+    const unsigned int bs = block_size;
+    const unsigned int idx_t = get_local_id(0);
+    // blocks with more than warpsize entries are handled in several passes over their columns
+    const unsigned int cols_per_pass = min(bs, warpsize/bs);
+    const unsigned int num_blocks_per_warp = max(1u, warpsize/bs/bs);
+    const unsigned int num_active_threads = num_blocks_per_warp*bs*cols_per_pass;
+    const unsigned int NUM_THREADS = get_global_size(0);
+    const unsigned int num_warps_in_grid = NUM_THREADS / warpsize;
+    unsigned int idx = get_global_id(0);
+    unsigned int target_block_row = idx / warpsize;
+    target_block_row += nodesPerColorPrefix[color];
+    const unsigned int lane = idx_t % warpsize;
+    const unsigned int c = (lane / bs) % cols_per_pass;
+    const unsigned int r = lane % bs;
+
+    while(target_block_row < nodesPerColorPrefix[color+1]){
+        const unsigned int first_block = LUrows[target_block_row];
+        const unsigned int last_block = diagIndex[target_block_row];
+        unsigned int block = first_block + lane / (bs*cols_per_pass);
+        float local_out = 0.0f;
+
+        if(lane < num_active_threads){
+            if(lane < bs){
+                local_out = (float)y[target_block_row*bs+lane];
+            }
+            for(; block < last_block; block += num_blocks_per_warp){
+                for(unsigned int cc = c; cc < bs; cc += cols_per_pass){
+                    const float x_elem = (float)x[LUcols[block]*bs + cc];
+                    const float A_elem = LUvals[block*bs*bs + cc + r*bs];
+                    local_out -= x_elem * A_elem;
+                }
+            }
+        }
+
+        // do reduction in shared mem
+        tmp[lane] = local_out;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(unsigned int offset = bs; offset < warpsize; offset <<= 1)
+        {
+            if (lane + offset < warpsize)
+            {
+                tmp[lane] += tmp[lane + offset];
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        if(lane < bs){
+            const unsigned int row = target_block_row*bs + lane;
+            x[row] = tmp[lane];
+        }
+
+        target_block_row += num_warps_in_grid;
+    }
+}
@@ -16,21 +16,23 @@ __kernel void ILU_apply2(
     const unsigned int warpsize = 32;
     const unsigned int bs = block_size;
     const unsigned int idx_t = get_local_id(0);
-    const unsigned int num_active_threads = (warpsize/bs/bs)*bs*bs;
-    const unsigned int num_blocks_per_warp = warpsize/bs/bs;
+    // blocks with more than warpsize entries are handled in several passes over their columns
+    const unsigned int cols_per_pass = min(bs, warpsize/bs);
+    const unsigned int num_blocks_per_warp = max(1u, warpsize/bs/bs);
+    const unsigned int num_active_threads = num_blocks_per_warp*bs*cols_per_pass;
     const unsigned int NUM_THREADS = get_global_size(0);
     const unsigned int num_warps_in_grid = NUM_THREADS / warpsize;
     unsigned int idx_g = get_global_id(0);
     unsigned int target_block_row = idx_g / warpsize;
     target_block_row += nodesPerColorPrefix[color];
     const unsigned int lane = idx_t % warpsize;
-    const unsigned int c = (lane / bs) % bs;
+    const unsigned int c = (lane / bs) % cols_per_pass;
     const unsigned int r = lane % bs;
 
     while(target_block_row < nodesPerColorPrefix[color+1]){
         const unsigned int first_block = LUrows[target_block_row];
         const unsigned int last_block = LUrows[target_block_row+1];
-        unsigned int block = first_block + lane / (bs*bs);
+        unsigned int block = first_block + lane / (bs*cols_per_pass);
         double local_out = 0.0;
 
         if(lane < num_active_threads){
@@ -39,9 +41,11 @@ __kernel void ILU_apply2(
                 local_out = x[row];
             }
             for(; block < last_block; block += num_blocks_per_warp){
-                const double x_elem = x[LUcols[block]*bs + c];
-                const double A_elem = LUvals[block*bs*bs + c + r*bs];
-                local_out -= x_elem * A_elem;
+                for(unsigned int cc = c; cc < bs; cc += cols_per_pass){
+                    const double x_elem = x[LUcols[block]*bs + cc];
+                    const double A_elem = LUvals[block*bs*bs + cc + r*bs];
+                    local_out -= x_elem * A_elem;
+                }
             }
         }
 
@@ -49,7 +53,7 @@ __kernel void ILU_apply2(
         tmp[lane] = local_out;
         barrier(CLK_LOCAL_MEM_FENCE);
 
-        for(unsigned int offset = 3; offset <= 24; offset <<= 1)
+        for(unsigned int offset = bs; offset < warpsize; offset <<= 1)
         {
             if (lane + offset < warpsize)
             {
@@ -1,13 +1,13 @@
 // a = a - (b * c)
-__kernel void block_mult_sub(__global double *a, __local double *b, __global double *c)
+// the hwarp loops over the block_size * block_size entries, blocks larger than 4x4 need more than one pass
+__kernel void block_mult_sub(__global double *a, __local double *b, __global double *c, const unsigned int block_size)
 {
-    const unsigned int block_size = 3;
     const unsigned int hwarp_size = 16;
     const unsigned int idx_t = get_local_id(0);                   // thread id in work group
     const unsigned int thread_id_in_hwarp = idx_t % hwarp_size;   // thread id in warp (16 threads)
-    if(thread_id_in_hwarp < block_size * block_size){
-        const unsigned int row = thread_id_in_hwarp / block_size;
-        const unsigned int col = thread_id_in_hwarp % block_size;
+    for (unsigned int entry = thread_id_in_hwarp; entry < block_size * block_size; entry += hwarp_size) {
+        const unsigned int row = entry / block_size;
+        const unsigned int col = entry % block_size;
         double temp = 0.0;
         for (unsigned int k = 0; k < block_size; k++) {
             temp += b[block_size * row + k] * c[block_size * k + col];
@@ -17,15 +17,14 @@ __kernel void block_mult_sub(__global double *a, __local double *b, __global dou
 }
 
 // c = a * b
-__kernel void block_mult(__global double *a, __global double *b, __local double *c)
+__kernel void block_mult(__global double *a, __global double *b, __local double *c, const unsigned int block_size)
 {
-    const unsigned int block_size = 3;
     const unsigned int hwarp_size = 16;
     const unsigned int idx_t = get_local_id(0);                   // thread id in work group
     const unsigned int thread_id_in_hwarp = idx_t % hwarp_size;   // thread id in warp (16 threads)
-    if(thread_id_in_hwarp < block_size * block_size){
-        const unsigned int row = thread_id_in_hwarp / block_size;
-        const unsigned int col = thread_id_in_hwarp % block_size;
+    for (unsigned int entry = thread_id_in_hwarp; entry < block_size * block_size; entry += hwarp_size) {
+        const unsigned int row = entry / block_size;
+        const unsigned int col = entry % block_size;
         double temp = 0.0;
         for (unsigned int k = 0; k < block_size; k++) {
             temp += a[block_size * row + k] * b[block_size * k + col];
@@ -64,6 +63,28 @@ __kernel void inverter(__global double *matrix, __global double *inverse)
     }
 }
 
+// invert a block of any size with in-place Gauss-Jordan elimination, without pivoting
+// executed by a single thread, the diagonal blocks are assumed to be nonsingular as in the 3x3 case
+void invert_in_place(__global double *inverse, const unsigned int bs)
+{
+    for (unsigned int k = 0; k < bs; k++) {
+        const double pivot = 1.0 / inverse[k * bs + k];
+        inverse[k * bs + k] = 1.0;
+        for (unsigned int j = 0; j < bs; j++) {
+            inverse[k * bs + j] *= pivot;
+        }
+        for (unsigned int i = 0; i < bs; i++) {
+            if (i != k) {
+                const double factor = inverse[i * bs + k];
+                inverse[i * bs + k] = 0.0;
+                for (unsigned int j = 0; j < bs; j++) {
+                    inverse[i * bs + j] -= factor * inverse[k * bs + j];
+                }
+            }
+        }
+    }
+}
+
 /// Exact ilu decomposition kernel
 /// The kernel takes a full BSR matrix and performs inplace ILU decomposition
 __kernel void ilu_decomp(const unsigned int firstRow,
@@ -74,9 +95,10 @@ __kernel void ilu_decomp(const unsigned int firstRow,
                          __global double *invDiagVals,
                          __global int *diagIndex,
                          const unsigned int Nb,
+                         const unsigned int block_size,
                          __local double *pivot)
 {
-    const unsigned int bs = 3;
+    const unsigned int bs = block_size;
     const unsigned int hwarp_size = 16;
     const unsigned int work_group_size = get_local_size(0);
     const unsigned int work_group_id = get_group_id(0);
@@ -100,11 +122,11 @@ __kernel void ilu_decomp(const unsigned int firstRow,
 
             if (j < i) {
                 // calculate the pivot of this row
-                block_mult(LUvals + ij * bs * bs, invDiagVals + j * bs * bs, pivot + lmem_offset);
+                block_mult(LUvals + ij * bs * bs, invDiagVals + j * bs * bs, pivot + lmem_offset, bs);
 
                 // copy pivot
-                if (thread_id_in_hwarp < bs * bs) {
-                    LUvals[ij * bs * bs + thread_id_in_hwarp] = pivot[lmem_offset + thread_id_in_hwarp];
+                for (unsigned int entry = thread_id_in_hwarp; entry < bs * bs; entry += hwarp_size) {
+                    LUvals[ij * bs * bs + entry] = pivot[lmem_offset + entry];
                 }
 
                 int jRowEnd = LUrows[j + 1];
@@ -113,7 +135,7 @@ __kernel void ilu_decomp(const unsigned int firstRow,
                 // subtract that row scaled by the pivot from this row.
                 while (ik < iRowEnd && jk < jRowEnd) {
                     if (LUcols[ik] == LUcols[jk]) {
-                        block_mult_sub(LUvals + ik * bs * bs, pivot + lmem_offset, LUvals + jk * bs * bs);
+                        block_mult_sub(LUvals + ik * bs * bs, pivot + lmem_offset, LUvals + jk * bs * bs, bs);
                         ik++;
                         jk++;
                     } else {
@@ -127,11 +149,23 @@ __kernel void ilu_decomp(const unsigned int firstRow,
         }
 
         // store the inverse in the diagonal
-        inverter(LUvals + diagIndex[i] * bs * bs, invDiagVals + i * bs * bs);
+        if (bs == 3) {
+            inverter(LUvals + diagIndex[i] * bs * bs, invDiagVals + i * bs * bs);
 
-        // copy inverse
-        if (thread_id_in_hwarp < bs * bs) {
-            LUvals[diagIndex[i] * bs * bs + thread_id_in_hwarp] = invDiagVals[i * bs * bs + thread_id_in_hwarp];
+            // copy inverse
+            if (thread_id_in_hwarp < bs * bs) {
+                LUvals[diagIndex[i] * bs * bs + thread_id_in_hwarp] = invDiagVals[i * bs * bs + thread_id_in_hwarp];
+            }
+        } else if (thread_id_in_hwarp == 0) {
+            __global double *diag = LUvals + diagIndex[i] * bs * bs;
+            __global double *inverse = invDiagVals + i * bs * bs;
+            for (unsigned int entry = 0; entry < bs * bs; entry++) {
+                inverse[entry] = diag[entry];
+            }
+            invert_in_place(inverse, bs);
+            for (unsigned int entry = 0; entry < bs * bs; entry++) {
+                diag[entry] = inverse[entry];
+            }
         }
     }
 }
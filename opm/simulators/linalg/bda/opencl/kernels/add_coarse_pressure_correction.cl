@@ -4,10 +4,10 @@ __kernel void add_coarse_pressure_correction(
     __global const double *coarse_x,
     __global double *fine_x,
     const unsigned int pressure_idx,
-    const unsigned int Nb)
+    const unsigned int Nb,
+    const unsigned int block_size)
 {
     const unsigned int NUM_THREADS = get_global_size(0);
-    const unsigned int block_size = 3;
     unsigned int target_block_row = get_global_id(0);
 
     while(target_block_row < Nb){
@@ -0,0 +1,56 @@
+/// Fused bicgstab update: x += alpha_x * dx, r += alpha_r * dr
+/// and returns partial sums of (r, r) and (rw, r) of the updated r, like dot_2
+/// out[2*i] holds (r, r) and out[2*i+1] holds (rw, r) of workgroup i
+/// only the first N_reduce entries are used for the sums, all N entries are updated
+__kernel void bicgstab_update(
+    __global double *x,
+    __global const double *dx,
+    const double alpha_x,
+    __global double *r,
+    __global const double *dr,
+    const double alpha_r,
+    __global const double *rw,
+    __global double *out,
+    const unsigned int N,
+    const unsigned int N_reduce,
+    __local double *tmp)
+{
+    unsigned int tid = get_local_id(0);
+    unsigned int bsize = get_local_size(0);
+    unsigned int i = get_global_id(0);
+    unsigned int NUM_THREADS = get_global_size(0);
+
+    double sum_rr = 0.0;
+    double sum_rwr = 0.0;
+    while(i < N){
+        x[i] += alpha_x * dx[i];
+        const double ri = r[i] + alpha_r * dr[i];
+        r[i] = ri;
+        if (i < N_reduce) {
+            sum_rr += ri * ri;
+            sum_rwr += rw[i] * ri;
+        }
+        i += NUM_THREADS;
+    }
+    tmp[tid] = sum_rr;
+    tmp[tid + bsize] = sum_rwr;
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    // do reduction in shared mem
+    for(unsigned int s = bsize / 2; s > 0; s >>= 1)
+    {
+        if (tid < s)
+        {
+            tmp[tid] += tmp[tid + s];
+            tmp[tid + bsize] += tmp[tid + bsize + s];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    // write result for this block to global mem
+    if (tid == 0) {
+        out[2 * get_group_id(0)] = tmp[0];
+        out[2 * get_group_id(0) + 1] = tmp[bsize];
+    }
+}
@@ -0,0 +1,14 @@
+/// out = (float)in, used to store factors in single precision after they are computed in double precision
+__kernel void convert_to_float(
+    __global const double *in,
+    __global float *out,
+    const unsigned int N)
+{
+    const unsigned int NUM_THREADS = get_global_size(0);
+    unsigned int idx = get_global_id(0);
+
+    while(idx < N){
+        out[idx] = (float)in[idx];
+        idx += NUM_THREADS;
+    }
+}
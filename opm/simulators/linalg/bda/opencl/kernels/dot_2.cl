@@ -0,0 +1,46 @@
+/// returns partial sums of two dot products that share in1, instead of the final dot products
+/// out[2*i] holds (in1, in2) and out[2*i+1] holds (in1, in3) of workgroup i, partial sums are added on CPU
+/// in1 is only read once, and in3 may be the same buffer as in1 or in2
+__kernel void dot_2(
+    __global const double *in1,
+    __global const double *in2,
+    __global const double *in3,
+    __global double *out,
+    const unsigned int N,
+    __local double *tmp)
+{
+    unsigned int tid = get_local_id(0);
+    unsigned int bsize = get_local_size(0);
+    unsigned int i = get_global_id(0);
+    unsigned int NUM_THREADS = get_global_size(0);
+
+    double sum2 = 0.0;
+    double sum3 = 0.0;
+    while(i < N){
+        const double a = in1[i];
+        sum2 += a * in2[i];
+        sum3 += a * in3[i];
+        i += NUM_THREADS;
+    }
+    tmp[tid] = sum2;
+    tmp[tid + bsize] = sum3;
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    // do reduction in shared mem
+    for(unsigned int s = bsize / 2; s > 0; s >>= 1)
+    {
+        if (tid < s)
+        {
+            tmp[tid] += tmp[tid + s];
+            tmp[tid + bsize] += tmp[tid + bsize + s];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    // write result for this block to global mem
+    if (tid == 0) {
+        out[2 * get_group_id(0)] = tmp[0];
+        out[2 * get_group_id(0) + 1] = tmp[bsize];
+    }
+}
@@ -4,10 +4,10 @@ __kernel void full_to_pressure_restriction(
     __global const double *fine_y,
     __global const double *weights,
     __global double *coarse_y,
-    const unsigned int Nb)
+    const unsigned int Nb,
+    const unsigned int block_size)
 {
     const unsigned int NUM_THREADS = get_global_size(0);
-    const unsigned int block_size = 3;
     unsigned int target_block_row = get_global_id(0);
 
     while(target_block_row < Nb){
@@ -0,0 +1,72 @@
+/// Applies multisegment wells, one workgroup per well
+/// y -= C^T * (D^-1 * (B * x)), with D^-1 stored as a dense row major matrix
+/// B and C share their sparsity pattern, the columnindices are already reordered if needed
+__kernel void mswell_apply(
+            __global const double *Cvals,
+            __global const double *Bvals,
+            __global const int *cols,
+            __global const unsigned int *rowPointers,
+            __global const unsigned int *segPointers,
+            __global const double *Dinv,
+            __global const unsigned int *DinvPointers,
+            __global const double *x,
+            __global double *y,
+            __global double *z1,
+            __global double *z2,
+            const unsigned int dim,
+            const unsigned int dim_wells)
+{
+    const unsigned int wgId = get_group_id(0);
+    const unsigned int wiId = get_local_id(0);
+    const unsigned int wgSize = get_local_size(0);
+    const unsigned int segBegin = segPointers[wgId];
+    const unsigned int numSegs = segPointers[wgId + 1] - segBegin;
+    const unsigned int M = numSegs * dim_wells;
+    const unsigned int valsPerBlock = dim * dim_wells;
+    __global double *wz1 = z1 + segBegin * dim_wells;
+    __global double *wz2 = z2 + segBegin * dim_wells;
+    __global const double *wDinv = Dinv + DinvPointers[wgId];
+
+    // z1 = B * x, one workitem per row
+    for (unsigned int i = wiId; i < M; i += wgSize) {
+        const unsigned int seg = segBegin + i / dim_wells;
+        const unsigned int r = i % dim_wells;
+        double temp = 0.0;
+        for (unsigned int b = rowPointers[seg]; b < rowPointers[seg + 1]; ++b) {
+            const int colIdx = cols[b];
+            for (unsigned int k = 0; k < dim; ++k) {
+                temp += Bvals[b * valsPerBlock + r * dim + k] * x[colIdx * dim + k];
+            }
+        }
+        wz1[i] = temp;
+    }
+
+    barrier(CLK_GLOBAL_MEM_FENCE);
+
+    // z2 = D^-1 * z1
+    for (unsigned int i = wiId; i < M; i += wgSize) {
+        double temp = 0.0;
+        for (unsigned int j = 0; j < M; ++j) {
+            temp += wDinv[i * M + j] * wz1[j];
+        }
+        wz2[i] = temp;
+    }
+
+    barrier(CLK_GLOBAL_MEM_FENCE);
+
+    // y -= C^T * z2
+    // several perforations can be in the same cell, so each workitem
+    // handles one component of y for all blocks of the well
+    if (wiId < dim) {
+        for (unsigned int seg = segBegin; seg < segBegin + numSegs; ++seg) {
+            __global const double *zseg = wz2 + (seg - segBegin) * dim_wells;
+            for (unsigned int b = rowPointers[seg]; b < rowPointers[seg + 1]; ++b) {
+                double temp = 0.0;
+                for (unsigned int k = 0; k < dim_wells; ++k) {
+                    temp += Cvals[b * valsPerBlock + wiId + k * dim] * zseg[k];
+                }
+                y[cols[b] * dim + wiId] -= temp;
+            }
+        }
+    }
+}
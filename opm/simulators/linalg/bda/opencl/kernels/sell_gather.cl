@@ -0,0 +1,24 @@
+/// copy the values of a BCSR matrix into the blocked sliced ELLPACK format of OpenclSellMatrix
+/// one work-item per stored value, padding blocks are set to zero
+/// the entries of every slice_height consecutive stored blocks are interleaved
+__kernel void sell_gather(
+    __global const double *bcsr_vals,
+    __global const int *blockMap,
+    __global double *vals,
+    const unsigned int num_blocks,
+    const unsigned int slice_height,
+    const unsigned int block_size)
+{
+    const unsigned int bs = block_size;
+    const unsigned int C = slice_height;
+    const unsigned int idx = get_global_id(0);
+
+    if (idx >= num_blocks * bs * bs) {
+        return;
+    }
+    const unsigned int group = idx / (C * bs * bs);
+    const unsigned int entry = (idx % (C * bs * bs)) / C;
+    const unsigned int r = idx % C;
+    const int src = blockMap[group * C + r];
+    vals[idx] = src < 0 ? 0.0 : bcsr_vals[src * bs * bs + entry];
+}
@@ -18,13 +18,15 @@ __kernel void spmv_blocked_add(
     const unsigned int idx_t = get_local_id(0);
     unsigned int idx = idx_b * bsize + idx_t;
     const unsigned int bs = block_size;
-    const unsigned int num_active_threads = (warpsize/bs/bs)*bs*bs;
-    const unsigned int num_blocks_per_warp = warpsize/bs/bs;
+    // blocks with more than warpsize entries are handled in several passes over their columns
+    const unsigned int cols_per_pass = min(bs, warpsize/bs);
+    const unsigned int num_blocks_per_warp = max(1u, warpsize/bs/bs);
+    const unsigned int num_active_threads = num_blocks_per_warp*bs*cols_per_pass;
     const unsigned int NUM_THREADS = get_global_size(0);
     const unsigned int num_warps_in_grid = NUM_THREADS / warpsize;
     unsigned int target_block_row = idx / warpsize;
     const unsigned int lane = idx_t % warpsize;
-    const unsigned int c = (lane / bs) % bs;
+    const unsigned int c = (lane / bs) % cols_per_pass;
     const unsigned int r = lane % bs;
 
     // for 3x3 blocks:
@@ -34,14 +36,16 @@ __kernel void spmv_blocked_add(
     while(target_block_row < Nb){
         unsigned int first_block = rows[target_block_row];
         unsigned int last_block = rows[target_block_row+1];
-        unsigned int block = first_block + lane / (bs*bs);
+        unsigned int block = first_block + lane / (bs*cols_per_pass);
         double local_out = 0.0;
 
         if(lane < num_active_threads){
             for(; block < last_block; block += num_blocks_per_warp){
-                double x_elem = x[cols[block]*bs + c];
-                double A_elem = vals[block*bs*bs + c + r*bs];
-                local_out += x_elem * A_elem;
+                for(unsigned int cc = c; cc < bs; cc += cols_per_pass){
+                    double x_elem = x[cols[block]*bs + cc];
+                    double A_elem = vals[block*bs*bs + cc + r*bs];
+                    local_out += x_elem * A_elem;
+                }
             }
         }
 
@@ -49,7 +53,7 @@ __kernel void spmv_blocked_add(
         tmp[lane] = local_out;
         barrier(CLK_LOCAL_MEM_FENCE);
 
-        for(unsigned int offset = 3; offset <= 24; offset <<= 1)
+        for(unsigned int offset = bs; offset < warpsize; offset <<= 1)
         {
             if (lane + offset < warpsize)
             {
@@ -0,0 +1,46 @@
+/// b = mat * x, for a matrix in the blocked sliced ELLPACK format of OpenclSellMatrix
+/// one work-item per scalar row, the rows of a slice are handled by neighbouring work-items
+/// such that the interleaved blocks of a slice are read coalesced
+__kernel void spmv_sell(
+    __global const double *vals,
+    __global const int *cols,
+    __global const int *slicePointers,
+    __global const int *rowIndices,
+    const unsigned int num_slices,
+    const unsigned int slice_height,
+    __global const double *x,
+    __global double *out,
+    const unsigned int block_size)
+{
+    const unsigned int bs = block_size;
+    const unsigned int C = slice_height;
+    const unsigned int idx = get_global_id(0);
+    const unsigned int slice = idx / (C * bs);
+    const unsigned int lane = idx % (C * bs);
+    const unsigned int r = lane % C;     // row of the slice
+    const unsigned int i = lane / C;     // row within the block
+
+    if (slice >= num_slices) {
+        return;
+    }
+    const int row = rowIndices[slice * C + r];
+    if (row < 0) {
+        return;
+    }
+
+    const unsigned int first = slicePointers[slice];
+    const unsigned int width = (slicePointers[slice + 1] - first) / C;
+    double sum = 0.0;
+    for (unsigned int j = 0; j < width; ++j) {
+        const unsigned int column_start = first + j * C;
+        const int col = cols[column_start + r];
+        if (col < 0) {
+            // only padding follows
+            break;
+        }
+        for (unsigned int c = 0; c < bs; ++c) {
+            sum += vals[column_start * bs * bs + (i * bs + c) * C + r] * x[col * bs + c];
+        }
+    }
+    out[row * bs + i] = sum;
+}
@@ -18,11 +18,18 @@
 */
 
 #include <config.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/common/ErrorMacros.hpp>
+#include <opm/simulators/utils/CacheFile.hpp>
 #include <dune/common/timer.hh>
 
 #include <opm/simulators/linalg/bda/opencl/openclKernels.hpp>
@@ -44,12 +51,14 @@ bool OpenclKernels::initialized = false;
 
 std::unique_ptr<cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int, cl::LocalSpaceArg> > OpenclKernels::dot_k;
 std::unique_ptr<cl::KernelFunctor<cl::Buffer&, cl::Buffer&, const unsigned int, cl::LocalSpaceArg> > OpenclKernels::norm_k;
+std::unique_ptr<dot_2_kernel_type> OpenclKernels::dot_2_k;
+std::unique_ptr<bicgstab_update_kernel_type> OpenclKernels::bicgstab_update_k;
 std::unique_ptr<cl::KernelFunctor<cl::Buffer&, const double, cl::Buffer&, const unsigned int> > OpenclKernels::axpy_k;
 std::unique_ptr<cl::KernelFunctor<cl::Buffer&, const double, const unsigned int> > OpenclKernels::scale_k;
 std::unique_ptr<cl::KernelFunctor<const double, cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int> > OpenclKernels::vmul_k;
 std::unique_ptr<cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, const double, const double, const unsigned int> > OpenclKernels::custom_k;
-std::unique_ptr<cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int> > OpenclKernels::full_to_pressure_restriction_k;
-std::unique_ptr<cl::KernelFunctor<cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int> > OpenclKernels::add_coarse_pressure_correction_k;
+std::unique_ptr<cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int> > OpenclKernels::full_to_pressure_restriction_k;
+std::unique_ptr<cl::KernelFunctor<cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int, const unsigned int> > OpenclKernels::add_coarse_pressure_correction_k;
 std::unique_ptr<cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, const cl::Buffer&, const unsigned int> > OpenclKernels::prolongate_vector_k;
 std::unique_ptr<spmv_blocked_kernel_type> OpenclKernels::spmv_blocked_k;
 std::unique_ptr<spmv_blocked_kernel_type> OpenclKernels::spmv_blocked_add_k;
@@ -57,10 +66,16 @@ std::unique_ptr<spmv_kernel_type> OpenclKernels::spmv_k;
 std::unique_ptr<spmv_kernel_type> OpenclKernels::spmv_noreset_k;
 std::unique_ptr<residual_blocked_kernel_type> OpenclKernels::residual_blocked_k;
 std::unique_ptr<residual_kernel_type> OpenclKernels::residual_k;
+std::unique_ptr<spmv_sell_kernel_type> OpenclKernels::spmv_sell_k;
+std::unique_ptr<sell_gather_kernel_type> OpenclKernels::sell_gather_k;
 std::unique_ptr<ilu_apply1_kernel_type> OpenclKernels::ILU_apply1_k;
 std::unique_ptr<ilu_apply2_kernel_type> OpenclKernels::ILU_apply2_k;
+std::unique_ptr<ilu_apply1_kernel_type> OpenclKernels::ILU_apply1_float_k;
+std::unique_ptr<ilu_apply2_kernel_type> OpenclKernels::ILU_apply2_float_k;
+std::unique_ptr<cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, const unsigned int> > OpenclKernels::convert_to_float_k;
 std::unique_ptr<stdwell_apply_kernel_type> OpenclKernels::stdwell_apply_k;
 std::unique_ptr<stdwell_apply_no_reorder_kernel_type> OpenclKernels::stdwell_apply_no_reorder_k;
+std::unique_ptr<mswell_apply_kernel_type> OpenclKernels::mswell_apply_k;
 std::unique_ptr<ilu_decomp_kernel_type> OpenclKernels::ilu_decomp_k;
 std::unique_ptr<isaiL_kernel_type> OpenclKernels::isaiL_k;
 std::unique_ptr<isaiU_kernel_type> OpenclKernels::isaiU_k;
@@ -71,7 +86,83 @@ unsigned int ceilDivision(const unsigned int A, const unsigned int B)
     return A / B + (A % B > 0);
 }
 
-void OpenclKernels::init(cl::Context *context, cl::CommandQueue *queue_, std::vector<cl::Device>& devices, int verbosity_)
+namespace {
+
+// Hash of the device, its driver and the kernel sources, any change of
+// these invalidates the cached program
+std::uint64_t programHash(const cl::Device& device, const cl::Program::Sources& sources)
+{
+    Fnv1aHash hash;
+    hash.add(device.getInfo<CL_DEVICE_NAME>());
+    hash.add(device.getInfo<CL_DEVICE_VENDOR>());
+    hash.add(device.getInfo<CL_DEVICE_VERSION>());
+    hash.add(device.getInfo<CL_DRIVER_VERSION>());
+    for (const auto& source : sources) {
+        hash.add(source);
+    }
+    return hash.value();
+}
+
+std::string programCacheFile(const std::string& cacheDir, const cl::Device& device, const cl::Program::Sources& sources)
+{
+    std::ostringstream file;
+    file << cacheDir << "/opm_opencl_kernels_" << std::hex << programHash(device, sources) << ".bin";
+    return file.str();
+}
+
+// Create the program from the binary in the cache, if there is a usable one,
+// otherwise compile the sources and store the binary in the cache.
+// The cache only speeds up the startup, failing to use it is not an error.
+cl::Program buildProgram(cl::Context& context, std::vector<cl::Device>& devices,
+                         const cl::Program::Sources& sources, const std::string& cacheDir, int verbosity)
+{
+    // the binaries are stored for a single device
+    const bool useCache = !cacheDir.empty() && devices.size() == 1;
+    std::string cacheFile;
+
+    if (useCache) {
+        cacheFile = programCacheFile(cacheDir, devices[0], sources);
+        std::ifstream is(cacheFile, std::ios::binary);
+        if (is) {
+            std::vector<unsigned char> binary((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+            try {
+                cl::Program program(context, devices, cl::Program::Binaries{binary});
+                program.build(devices);
+                if (verbosity >= 1) {
+                    OpmLog::info("openclSolver loaded the compiled kernels from " + cacheFile);
+                }
+                return program;
+            } catch (const cl::Error& error) {
+                OpmLog::warning("openclSolver could not use the compiled kernels in " + cacheFile
+                                + ", compiling them again: " + error.what());
+            }
+        }
+    }
+
+    cl::Program program(context, sources);
+    program.build(devices);
+
+    if (useCache) {
+        try {
+            const auto binaries = program.getInfo<CL_PROGRAM_BINARIES>();
+            std::filesystem::create_directories(cacheDir);
+            writeCacheFile(cacheFile, [&binaries](std::ostream& os) {
+                os.write(reinterpret_cast<const char*>(binaries[0].data()), binaries[0].size());
+            });
+            if (verbosity >= 1) {
+                OpmLog::info("openclSolver stored the compiled kernels in " + cacheFile);
+            }
+        } catch (const std::exception& error) {
+            OpmLog::warning(std::string("openclSolver could not store the compiled kernels: ") + error.what());
+        }
+    }
+    return program;
+}
+
+} // anonymous namespace
+
+void OpenclKernels::init(cl::Context *context, cl::CommandQueue *queue_, std::vector<cl::Device>& devices, int verbosity_,
+                         const std::string& program_cache)
 {
     if (initialized) {
         OpmLog::debug("Warning OpenclKernels is already initialized");
@@ -87,6 +178,8 @@ void OpenclKernels::init(cl::Context *context, cl::CommandQueue *queue_, std::ve
     sources.emplace_back(vmul_str);
     sources.emplace_back(dot_1_str);
     sources.emplace_back(norm_str);
+    sources.emplace_back(dot_2_str);
+    sources.emplace_back(bicgstab_update_str);
     sources.emplace_back(custom_str);
     sources.emplace_back(full_to_pressure_restriction_str);
     sources.emplace_back(add_coarse_pressure_correction_str);
@@ -97,6 +190,8 @@ void OpenclKernels::init(cl::Context *context, cl::CommandQueue *queue_, std::ve
     sources.emplace_back(spmv_noreset_str);
     sources.emplace_back(residual_blocked_str);
     sources.emplace_back(residual_str);
+    sources.emplace_back(spmv_sell_str);
+    sources.emplace_back(sell_gather_str);
 #if CHOW_PATEL
     sources.emplace_back(ILU_apply1_str);
     sources.emplace_back(ILU_apply2_str);
@@ -104,14 +199,17 @@ void OpenclKernels::init(cl::Context *context, cl::CommandQueue *queue_, std::ve
     sources.emplace_back(ILU_apply1_fm_str);
     sources.emplace_back(ILU_apply2_fm_str);
 #endif
+    sources.emplace_back(ILU_apply1_float_str);
+    sources.emplace_back(ILU_apply2_float_str);
+    sources.emplace_back(convert_to_float_str);
     sources.emplace_back(stdwell_apply_str);
     sources.emplace_back(stdwell_apply_no_reorder_str);
+    sources.emplace_back(mswell_apply_str);
     sources.emplace_back(ILU_decomp_str);
     sources.emplace_back(isaiL_str);
     sources.emplace_back(isaiU_str);
 
-    cl::Program program = cl::Program(*context, sources);
-    program.build(devices);
+    cl::Program program = buildProgram(*context, devices, sources, program_cache, verbosity);
 
     // queue.enqueueNDRangeKernel() is a blocking/synchronous call, at least for NVIDIA
     // cl::KernelFunctor<> myKernel(); myKernel(args, arg1, arg2); is also blocking
@@ -119,12 +217,14 @@ void OpenclKernels::init(cl::Context *context, cl::CommandQueue *queue_, std::ve
     // actually creating the kernels
     dot_k.reset(new cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int, cl::LocalSpaceArg>(cl::Kernel(program, "dot_1")));
     norm_k.reset(new cl::KernelFunctor<cl::Buffer&, cl::Buffer&, const unsigned int, cl::LocalSpaceArg>(cl::Kernel(program, "norm")));
+    dot_2_k.reset(new dot_2_kernel_type(cl::Kernel(program, "dot_2")));
+    bicgstab_update_k.reset(new bicgstab_update_kernel_type(cl::Kernel(program, "bicgstab_update")));
     axpy_k.reset(new cl::KernelFunctor<cl::Buffer&, const double, cl::Buffer&, const unsigned int>(cl::Kernel(program, "axpy")));
     scale_k.reset(new cl::KernelFunctor<cl::Buffer&, const double, const unsigned int>(cl::Kernel(program, "scale")));
     vmul_k.reset(new cl::KernelFunctor<const double, cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int>(cl::Kernel(program, "vmul")));
     custom_k.reset(new cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, const double, const double, const unsigned int>(cl::Kernel(program, "custom")));
-    full_to_pressure_restriction_k.reset(new cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int>(cl::Kernel(program, "full_to_pressure_restriction")));
-    add_coarse_pressure_correction_k.reset(new cl::KernelFunctor<cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int>(cl::Kernel(program, "add_coarse_pressure_correction")));
+    full_to_pressure_restriction_k.reset(new cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int>(cl::Kernel(program, "full_to_pressure_restriction")));
+    add_coarse_pressure_correction_k.reset(new cl::KernelFunctor<cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int, const unsigned int>(cl::Kernel(program, "add_coarse_pressure_correction")));
     prolongate_vector_k.reset(new cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, const cl::Buffer&, const unsigned int>(cl::Kernel(program, "prolongate_vector")));
     spmv_blocked_k.reset(new spmv_blocked_kernel_type(cl::Kernel(program, "spmv_blocked")));
     spmv_blocked_add_k.reset(new spmv_blocked_kernel_type(cl::Kernel(program, "spmv_blocked_add")));
@@ -132,10 +232,16 @@ void OpenclKernels::init(cl::Context *context, cl::CommandQueue *queue_, std::ve
     spmv_noreset_k.reset(new spmv_kernel_type(cl::Kernel(program, "spmv_noreset")));
     residual_blocked_k.reset(new residual_blocked_kernel_type(cl::Kernel(program, "residual_blocked")));
     residual_k.reset(new residual_kernel_type(cl::Kernel(program, "residual")));
+    spmv_sell_k.reset(new spmv_sell_kernel_type(cl::Kernel(program, "spmv_sell")));
+    sell_gather_k.reset(new sell_gather_kernel_type(cl::Kernel(program, "sell_gather")));
     ILU_apply1_k.reset(new ilu_apply1_kernel_type(cl::Kernel(program, "ILU_apply1")));
     ILU_apply2_k.reset(new ilu_apply2_kernel_type(cl::Kernel(program, "ILU_apply2")));
+    ILU_apply1_float_k.reset(new ilu_apply1_kernel_type(cl::Kernel(program, "ILU_apply1_float")));
+    ILU_apply2_float_k.reset(new ilu_apply2_kernel_type(cl::Kernel(program, "ILU_apply2_float")));
+    convert_to_float_k.reset(new cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, const unsigned int>(cl::Kernel(program, "convert_to_float")));
     stdwell_apply_k.reset(new stdwell_apply_kernel_type(cl::Kernel(program, "stdwell_apply")));
     stdwell_apply_no_reorder_k.reset(new stdwell_apply_no_reorder_kernel_type(cl::Kernel(program, "stdwell_apply_no_reorder")));
+    mswell_apply_k.reset(new mswell_apply_kernel_type(cl::Kernel(program, "mswell_apply")));
     ilu_decomp_k.reset(new ilu_decomp_kernel_type(cl::Kernel(program, "ilu_decomp")));
     isaiL_k.reset(new isaiL_kernel_type(cl::Kernel(program, "isaiL")));
     isaiU_k.reset(new isaiU_kernel_type(cl::Kernel(program, "isaiU")));
@@ -200,6 +306,69 @@ double OpenclKernels::norm(cl::Buffer& in, cl::Buffer& out, int N)
     return gpu_norm;
 }
 
+std::pair<double, double> OpenclKernels::dot_2(cl::Buffer& in1, cl::Buffer& in2, cl::Buffer& in3, cl::Buffer& out, int N)
+{
+    const unsigned int work_group_size = 256;
+    const unsigned int num_work_groups = ceilDivision(N, work_group_size);
+    const unsigned int total_work_items = num_work_groups * work_group_size;
+    const unsigned int lmem_per_work_group = 2 * sizeof(double) * work_group_size;
+    Timer t_dot_2;
+    tmp.resize(2 * num_work_groups);
+
+    cl::Event event = (*dot_2_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), in1, in2, in3, out, N, cl::Local(lmem_per_work_group));
+
+    queue->enqueueReadBuffer(out, CL_TRUE, 0, sizeof(double) * 2 * num_work_groups, tmp.data());
+
+    double sum2 = 0.0;
+    double sum3 = 0.0;
+    for (unsigned int i = 0; i < num_work_groups; ++i) {
+        sum2 += tmp[2 * i];
+        sum3 += tmp[2 * i + 1];
+    }
+
+    if (verbosity >= 4) {
+        event.wait();
+        std::ostringstream oss;
+        oss << std::scientific << "OpenclKernels dot_2() time: " << t_dot_2.stop() << " s";
+        OpmLog::info(oss.str());
+    }
+
+    return {sum2, sum3};
+}
+
+std::pair<double, double> OpenclKernels::bicgstab_update(cl::Buffer& x, cl::Buffer& dx, const double alpha_x,
+                                                         cl::Buffer& r, cl::Buffer& dr, const double alpha_r,
+                                                         cl::Buffer& rw, cl::Buffer& out, int N, int N_reduce)
+{
+    const unsigned int work_group_size = 256;
+    const unsigned int num_work_groups = ceilDivision(N, work_group_size);
+    const unsigned int total_work_items = num_work_groups * work_group_size;
+    const unsigned int lmem_per_work_group = 2 * sizeof(double) * work_group_size;
+    Timer t_update;
+    tmp.resize(2 * num_work_groups);
+
+    cl::Event event = (*bicgstab_update_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)),
+                                           x, dx, alpha_x, r, dr, alpha_r, rw, out, N, N_reduce, cl::Local(lmem_per_work_group));
+
+    queue->enqueueReadBuffer(out, CL_TRUE, 0, sizeof(double) * 2 * num_work_groups, tmp.data());
+
+    double sum_rr = 0.0;
+    double sum_rwr = 0.0;
+    for (unsigned int i = 0; i < num_work_groups; ++i) {
+        sum_rr += tmp[2 * i];
+        sum_rwr += tmp[2 * i + 1];
+    }
+
+    if (verbosity >= 4) {
+        event.wait();
+        std::ostringstream oss;
+        oss << std::scientific << "OpenclKernels bicgstab_update() time: " << t_update.stop() << " s";
+        OpmLog::info(oss.str());
+    }
+
+    return {sum_rr, sum_rwr};
+}
+
 void OpenclKernels::axpy(cl::Buffer& in, const double a, cl::Buffer& out, int N)
 {
     const unsigned int work_group_size = 32;
@@ -268,14 +437,14 @@ void OpenclKernels::custom(cl::Buffer& p, cl::Buffer& v, cl::Buffer& r, const do
     }
 }
 
-void OpenclKernels::full_to_pressure_restriction(const cl::Buffer& fine_y, cl::Buffer& weights, cl::Buffer& coarse_y, int Nb)
+void OpenclKernels::full_to_pressure_restriction(const cl::Buffer& fine_y, cl::Buffer& weights, cl::Buffer& coarse_y, int Nb, unsigned int block_size)
 {
     const unsigned int work_group_size = 32;
     const unsigned int num_work_groups = ceilDivision(Nb, work_group_size);
     const unsigned int total_work_items = num_work_groups * work_group_size;
     Timer t;
 
-    cl::Event event = (*full_to_pressure_restriction_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), fine_y, weights, coarse_y, Nb);
+    cl::Event event = (*full_to_pressure_restriction_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), fine_y, weights, coarse_y, Nb, block_size);
 
     if (verbosity >= 4) {
         event.wait();
@@ -285,14 +454,14 @@ void OpenclKernels::full_to_pressure_restriction(const cl::Buffer& fine_y, cl::B
     }
 }
 
-void OpenclKernels::add_coarse_pressure_correction(cl::Buffer& coarse_x, cl::Buffer& fine_x, int pressure_idx, int Nb)
+void OpenclKernels::add_coarse_pressure_correction(cl::Buffer& coarse_x, cl::Buffer& fine_x, int pressure_idx, int Nb, unsigned int block_size)
 {
     const unsigned int work_group_size = 32;
     const unsigned int num_work_groups = ceilDivision(Nb, work_group_size);
     const unsigned int total_work_items = num_work_groups * work_group_size;
     Timer t;
 
-    cl::Event event = (*add_coarse_pressure_correction_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), coarse_x, fine_x, pressure_idx, Nb);
+    cl::Event event = (*add_coarse_pressure_correction_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), coarse_x, fine_x, pressure_idx, Nb, block_size);
 
     if (verbosity >= 4) {
         event.wait();
@@ -373,15 +542,58 @@ void OpenclKernels::residual(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& row
     }
 }
 
-void OpenclKernels::ILU_apply1(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& rows, cl::Buffer& diagIndex, const cl::Buffer& y, cl::Buffer& x, cl::Buffer& rowsPerColor, int color, int Nb, unsigned int block_size)
+void OpenclKernels::spmv_sell(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& slicePointers, cl::Buffer& rowIndices,
+    const cl::Buffer& x, cl::Buffer& b, int num_slices, int slice_height, unsigned int block_size)
+{
+    // one work group per slice, one work-item per scalar row
+    const unsigned int work_group_size = slice_height * block_size;
+    const unsigned int total_work_items = num_slices * work_group_size;
+    Timer t_spmv;
+
+    if (total_work_items == 0) {
+        return;
+    }
+    cl::Event event = (*spmv_sell_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), vals, cols, slicePointers, rowIndices, num_slices, slice_height, x, b, block_size);
+
+    if (verbosity >= 4) {
+        event.wait();
+        std::ostringstream oss;
+        oss << std::scientific << "OpenclKernels spmv_sell() time: " << t_spmv.stop() << " s";
+        OpmLog::info(oss.str());
+    }
+}
+
+void OpenclKernels::sell_gather(const cl::Buffer& bcsr_vals, cl::Buffer& blockMap, cl::Buffer& vals,
+    int num_blocks, int slice_height, unsigned int block_size)
+{
+    const unsigned int work_group_size = 256;
+    const unsigned int num_work_groups = ceilDivision(num_blocks * block_size * block_size, work_group_size);
+    const unsigned int total_work_items = num_work_groups * work_group_size;
+    Timer t_gather;
+
+    if (total_work_items == 0) {
+        return;
+    }
+    cl::Event event = (*sell_gather_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), bcsr_vals, blockMap, vals, num_blocks, slice_height, block_size);
+
+    if (verbosity >= 4) {
+        event.wait();
+        std::ostringstream oss;
+        oss << std::scientific << "OpenclKernels sell_gather() time: " << t_gather.stop() << " s";
+        OpmLog::info(oss.str());
+    }
+}
+
+void OpenclKernels::ILU_apply1(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& rows, cl::Buffer& diagIndex, const cl::Buffer& y, cl::Buffer& x, cl::Buffer& rowsPerColor, int color, int Nb, unsigned int block_size, bool float_factors)
 {
     const unsigned int work_group_size = 32;
     const unsigned int num_work_groups = ceilDivision(Nb, work_group_size);
     const unsigned int total_work_items = num_work_groups * work_group_size;
-    const unsigned int lmem_per_work_group = sizeof(double) * work_group_size;
+    const unsigned int lmem_per_work_group = (float_factors ? sizeof(float) : sizeof(double)) * work_group_size;
     Timer t_ilu_apply1;
 
-    cl::Event event = (*ILU_apply1_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), vals, cols, rows, diagIndex, y, x, rowsPerColor, color, block_size, cl::Local(lmem_per_work_group));
+    auto& kernel = float_factors ? ILU_apply1_float_k : ILU_apply1_k;
+    cl::Event event = (*kernel)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), vals, cols, rows, diagIndex, y, x, rowsPerColor, color, block_size, cl::Local(lmem_per_work_group));
 
     if (verbosity >= 5) {
         event.wait();
@@ -391,15 +603,16 @@ void OpenclKernels::ILU_apply1(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& r
     }
 }
 
-void OpenclKernels::ILU_apply2(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& rows, cl::Buffer& diagIndex, cl::Buffer& invDiagVals, cl::Buffer& x, cl::Buffer& rowsPerColor, int color, int Nb, unsigned int block_size)
+void OpenclKernels::ILU_apply2(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& rows, cl::Buffer& diagIndex, cl::Buffer& invDiagVals, cl::Buffer& x, cl::Buffer& rowsPerColor, int color, int Nb, unsigned int block_size, bool float_factors)
 {
     const unsigned int work_group_size = 32;
     const unsigned int num_work_groups = ceilDivision(Nb, work_group_size);
     const unsigned int total_work_items = num_work_groups * work_group_size;
-    const unsigned int lmem_per_work_group = sizeof(double) * work_group_size;
+    const unsigned int lmem_per_work_group = (float_factors ? sizeof(float) : sizeof(double)) * work_group_size;
     Timer t_ilu_apply2;
 
-    cl::Event event = (*ILU_apply2_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), vals, cols, rows, diagIndex, invDiagVals, x, rowsPerColor, color, block_size, cl::Local(lmem_per_work_group));
+    auto& kernel = float_factors ? ILU_apply2_float_k : ILU_apply2_k;
+    cl::Event event = (*kernel)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), vals, cols, rows, diagIndex, invDiagVals, x, rowsPerColor, color, block_size, cl::Local(lmem_per_work_group));
 
     if (verbosity >= 5) {
         event.wait();
@@ -409,6 +622,23 @@ void OpenclKernels::ILU_apply2(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& r
     }
 }
 
+void OpenclKernels::convert_to_float(const cl::Buffer& in, cl::Buffer& out, int N)
+{
+    const unsigned int work_group_size = 256;
+    const unsigned int num_work_groups = ceilDivision(N, work_group_size);
+    const unsigned int total_work_items = num_work_groups * work_group_size;
+    Timer t;
+
+    cl::Event event = (*convert_to_float_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)), in, out, N);
+
+    if (verbosity >= 4) {
+        event.wait();
+        std::ostringstream oss;
+        oss << std::scientific << "OpenclKernels convert_to_float() time: " << t.stop() << " s";
+        OpmLog::info(oss.str());
+    }
+}
+
 void OpenclKernels::ILU_decomp(int firstRow, int lastRow, cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& rows, cl::Buffer& diagIndex, cl::Buffer& invDiagVals, int Nb, unsigned int block_size)
 {
     const unsigned int work_group_size2 = 128;
@@ -418,7 +648,7 @@ void OpenclKernels::ILU_decomp(int firstRow, int lastRow, cl::Buffer& vals, cl::
     const unsigned int lmem_per_work_group2 = num_hwarps_per_group * block_size * block_size * sizeof(double);           // each block needs a pivot
     Timer t_ilu_decomp;
 
-    cl::Event event = (*ilu_decomp_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items2), cl::NDRange(work_group_size2)), firstRow, lastRow, vals, cols, rows, invDiagVals, diagIndex, Nb, cl::Local(lmem_per_work_group2));
+    cl::Event event = (*ilu_decomp_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items2), cl::NDRange(work_group_size2)), firstRow, lastRow, vals, cols, rows, invDiagVals, diagIndex, Nb, block_size, cl::Local(lmem_per_work_group2));
 
     if (verbosity >= 4) {
         event.wait();
@@ -432,7 +662,8 @@ void OpenclKernels::apply_stdwells_reorder(cl::Buffer& d_Cnnzs_ocl, cl::Buffer &
     cl::Buffer &d_Ccols_ocl, cl::Buffer &d_Bcols_ocl, cl::Buffer &d_x, cl::Buffer &d_y,
     cl::Buffer &d_toOrder, int dim, int dim_wells, cl::Buffer &d_val_pointers_ocl, int num_std_wells)
 {
-    const unsigned int work_group_size = 32;
+    // every block of B needs dim*dim_wells workitems
+    const unsigned int work_group_size = std::max(32u, ceilDivision(dim * dim_wells, 32) * 32);
     const unsigned int total_work_items = num_std_wells * work_group_size;
     const unsigned int lmem1 = sizeof(double) * work_group_size;
     const unsigned int lmem2 = sizeof(double) * dim_wells;
@@ -454,7 +685,8 @@ void OpenclKernels::apply_stdwells_no_reorder(cl::Buffer& d_Cnnzs_ocl, cl::Buffe
     cl::Buffer &d_Ccols_ocl, cl::Buffer &d_Bcols_ocl, cl::Buffer &d_x, cl::Buffer &d_y,
     int dim, int dim_wells, cl::Buffer &d_val_pointers_ocl, int num_std_wells)
 {
-    const unsigned int work_group_size = 32;
+    // every block of B needs dim*dim_wells workitems
+    const unsigned int work_group_size = std::max(32u, ceilDivision(dim * dim_wells, 32) * 32);
     const unsigned int total_work_items = num_std_wells * work_group_size;
     const unsigned int lmem1 = sizeof(double) * work_group_size;
     const unsigned int lmem2 = sizeof(double) * dim_wells;
@@ -472,6 +704,26 @@ void OpenclKernels::apply_stdwells_no_reorder(cl::Buffer& d_Cnnzs_ocl, cl::Buffe
     }
 }
 
+void OpenclKernels::apply_mswells(cl::Buffer& d_Cvals, cl::Buffer& d_Bvals, cl::Buffer& d_cols, cl::Buffer& d_rowPointers,
+    cl::Buffer& d_segPointers, cl::Buffer& d_Dinv, cl::Buffer& d_DinvPointers, cl::Buffer& d_x, cl::Buffer& d_y,
+    cl::Buffer& d_z1, cl::Buffer& d_z2, int dim, int dim_wells, int num_ms_wells)
+{
+    const unsigned int work_group_size = 64;
+    const unsigned int total_work_items = num_ms_wells * work_group_size;
+    Timer t_apply_mswells;
+
+    cl::Event event = (*mswell_apply_k)(cl::EnqueueArgs(*queue, cl::NDRange(total_work_items), cl::NDRange(work_group_size)),
+                          d_Cvals, d_Bvals, d_cols, d_rowPointers, d_segPointers, d_Dinv, d_DinvPointers,
+                          d_x, d_y, d_z1, d_z2, dim, dim_wells);
+
+    if (verbosity >= 4) {
+        event.wait();
+        std::ostringstream oss;
+        oss << std::scientific << "OpenclKernels apply_mswells() time: " << t_apply_mswells.stop() << " s";
+        OpmLog::info(oss.str());
+    }
+}
+
 void OpenclKernels::isaiL(cl::Buffer& diagIndex, cl::Buffer& colPointers, cl::Buffer& mapping, cl::Buffer& nvc,
     cl::Buffer& luIdxs, cl::Buffer& xxIdxs, cl::Buffer& dxIdxs, cl::Buffer& LUvals, cl::Buffer& invLvals, unsigned int Nb)
 {
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <memory>
+#include <utility>
 
 #include <opm/simulators/linalg/bda/opencl/opencl.hpp>
 
@@ -38,6 +39,10 @@ using residual_blocked_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::Buffer&,
                                          cl::Buffer&, const cl::Buffer&, cl::Buffer&, const unsigned int, cl::LocalSpaceArg>;
 using residual_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int,
                                          cl::Buffer&, const cl::Buffer&, cl::Buffer&, cl::LocalSpaceArg>;
+using spmv_sell_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int,
+                                         const unsigned int, const cl::Buffer&, cl::Buffer&, const unsigned int>;
+using sell_gather_kernel_type = cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int,
+                                         const unsigned int, const unsigned int>;
 using ilu_apply1_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&, const cl::Buffer&,
                                                cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int, cl::LocalSpaceArg>;
 using ilu_apply2_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&,
@@ -50,8 +55,15 @@ using stdwell_apply_no_reorder_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::
                                                              cl::Buffer&, cl::Buffer&, cl::Buffer&,
                                                              const unsigned int, const unsigned int, cl::Buffer&,
                                                              cl::LocalSpaceArg, cl::LocalSpaceArg, cl::LocalSpaceArg>;
+using mswell_apply_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&,
+                                                 cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&,
+                                                 cl::Buffer&, cl::Buffer&, cl::Buffer&,
+                                                 const unsigned int, const unsigned int>;
 using ilu_decomp_kernel_type = cl::KernelFunctor<const unsigned int, const unsigned int, cl::Buffer&, cl::Buffer&,
-                                               cl::Buffer&, cl::Buffer&, cl::Buffer&, const int, cl::LocalSpaceArg>;
+                                               cl::Buffer&, cl::Buffer&, cl::Buffer&, const int, const unsigned int, cl::LocalSpaceArg>;
+using dot_2_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int, cl::LocalSpaceArg>;
+using bicgstab_update_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::Buffer&, const double, cl::Buffer&, cl::Buffer&, const double,
+                                                    cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int, cl::LocalSpaceArg>;
 using isaiL_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&,
                                   cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int>;
 using isaiU_kernel_type = cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&, cl::Buffer&,
@@ -67,12 +79,14 @@ private:
 
     static std::unique_ptr<cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int, cl::LocalSpaceArg> > dot_k;
     static std::unique_ptr<cl::KernelFunctor<cl::Buffer&, cl::Buffer&, const unsigned int, cl::LocalSpaceArg> > norm_k;
+    static std::unique_ptr<dot_2_kernel_type> dot_2_k;
+    static std::unique_ptr<bicgstab_update_kernel_type> bicgstab_update_k;
     static std::unique_ptr<cl::KernelFunctor<cl::Buffer&, const double, cl::Buffer&, const unsigned int> > axpy_k;
     static std::unique_ptr<cl::KernelFunctor<cl::Buffer&, const double, const unsigned int> > scale_k;
     static std::unique_ptr<cl::KernelFunctor<const double, cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int> > vmul_k;
     static std::unique_ptr<cl::KernelFunctor<cl::Buffer&, cl::Buffer&, cl::Buffer&, const double, const double, const unsigned int> > custom_k;
-    static std::unique_ptr<cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int> > full_to_pressure_restriction_k;
-    static std::unique_ptr<cl::KernelFunctor<cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int> > add_coarse_pressure_correction_k;
+    static std::unique_ptr<cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int> > full_to_pressure_restriction_k;
+    static std::unique_ptr<cl::KernelFunctor<cl::Buffer&, cl::Buffer&, const unsigned int, const unsigned int, const unsigned int> > add_coarse_pressure_correction_k;
     static std::unique_ptr<cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, const cl::Buffer&, const unsigned int> > prolongate_vector_k;
     static std::unique_ptr<spmv_blocked_kernel_type> spmv_blocked_k;
     static std::unique_ptr<spmv_blocked_kernel_type> spmv_blocked_add_k;
@@ -80,10 +94,16 @@ private:
     static std::unique_ptr<spmv_kernel_type> spmv_noreset_k;
     static std::unique_ptr<residual_blocked_kernel_type> residual_blocked_k;
     static std::unique_ptr<residual_kernel_type> residual_k;
+    static std::unique_ptr<spmv_sell_kernel_type> spmv_sell_k;
+    static std::unique_ptr<sell_gather_kernel_type> sell_gather_k;
     static std::unique_ptr<ilu_apply1_kernel_type> ILU_apply1_k;
     static std::unique_ptr<ilu_apply2_kernel_type> ILU_apply2_k;
+    static std::unique_ptr<ilu_apply1_kernel_type> ILU_apply1_float_k;
+    static std::unique_ptr<ilu_apply2_kernel_type> ILU_apply2_float_k;
+    static std::unique_ptr<cl::KernelFunctor<const cl::Buffer&, cl::Buffer&, const unsigned int> > convert_to_float_k;
     static std::unique_ptr<stdwell_apply_kernel_type> stdwell_apply_k;
     static std::unique_ptr<stdwell_apply_no_reorder_kernel_type> stdwell_apply_no_reorder_k;
+    static std::unique_ptr<mswell_apply_kernel_type> mswell_apply_k;
     static std::unique_ptr<ilu_decomp_kernel_type> ilu_decomp_k;
     static std::unique_ptr<isaiL_kernel_type> isaiL_k;
     static std::unique_ptr<isaiU_kernel_type> isaiU_k;
@@ -96,6 +116,8 @@ public:
     static const std::string vmul_str;
     static const std::string dot_1_str;
     static const std::string norm_str;
+    static const std::string dot_2_str;
+    static const std::string bicgstab_update_str;
     static const std::string custom_str;
     static const std::string full_to_pressure_restriction_str;
     static const std::string add_coarse_pressure_correction_str;
@@ -106,6 +128,8 @@ public:
     static const std::string spmv_noreset_str;
     static const std::string residual_blocked_str;
     static const std::string residual_str;
+    static const std::string spmv_sell_str;
+    static const std::string sell_gather_str;
 #if CHOW_PATEL
     static const std::string ILU_apply1_str;
     static const std::string ILU_apply2_str;
@@ -113,31 +137,59 @@ public:
     static const std::string ILU_apply1_fm_str;
     static const std::string ILU_apply2_fm_str;
 #endif
+    static const std::string ILU_apply1_float_str;
+    static const std::string ILU_apply2_float_str;
+    static const std::string convert_to_float_str;
     static const std::string stdwell_apply_str;
     static const std::string stdwell_apply_no_reorder_str;
+    static const std::string mswell_apply_str;
     static const std::string ILU_decomp_str;
     static const std::string isaiL_str;
     static const std::string isaiU_str;
 
-    static void init(cl::Context *context, cl::CommandQueue *queue, std::vector<cl::Device>& devices, int verbosity);
+    /// Build the kernels for the given device
+    /// \param[in] program_cache   directory in which the compiled program is stored for the device and driver,
+    ///                            and from which it is loaded by later runs, empty to always compile the sources
+    static void init(cl::Context *context, cl::CommandQueue *queue, std::vector<cl::Device>& devices, int verbosity,
+                     const std::string& program_cache = "");
 
     static double dot(cl::Buffer& in1, cl::Buffer& in2, cl::Buffer& out, int N);
     static double norm(cl::Buffer& in, cl::Buffer& out, int N);
+    // returns (in1, in2) and (in1, in3), in1 is read only once
+    static std::pair<double, double> dot_2(cl::Buffer& in1, cl::Buffer& in2, cl::Buffer& in3, cl::Buffer& out, int N);
+    // x += alpha_x * dx, r += alpha_r * dr, then returns (r, r) and (rw, r) over the first N_reduce entries
+    static std::pair<double, double> bicgstab_update(cl::Buffer& x, cl::Buffer& dx, const double alpha_x,
+                                                     cl::Buffer& r, cl::Buffer& dr, const double alpha_r,
+                                                     cl::Buffer& rw, cl::Buffer& out, int N, int N_reduce);
     static void axpy(cl::Buffer& in, const double a, cl::Buffer& out, int N);
     static void scale(cl::Buffer& in, const double a, int N);
     static void vmul(const double alpha, cl::Buffer& in1, cl::Buffer& in2, cl::Buffer& out, int N);
     static void custom(cl::Buffer& p, cl::Buffer& v, cl::Buffer& r, const double omega, const double beta, int N);
-    static void full_to_pressure_restriction(const cl::Buffer& fine_y, cl::Buffer& weights, cl::Buffer& coarse_y, int Nb);
-    static void add_coarse_pressure_correction(cl::Buffer& coarse_x, cl::Buffer& fine_x, int pressure_idx, int Nb);
+    static void full_to_pressure_restriction(const cl::Buffer& fine_y, cl::Buffer& weights, cl::Buffer& coarse_y, int Nb, unsigned int block_size);
+    static void add_coarse_pressure_correction(cl::Buffer& coarse_x, cl::Buffer& fine_x, int pressure_idx, int Nb, unsigned int block_size);
     static void prolongate_vector(const cl::Buffer& in, cl::Buffer& out, const cl::Buffer& cols, int N);
     static void spmv(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& rows, const cl::Buffer& x, cl::Buffer& b, int Nb, unsigned int block_size, bool reset = true, bool add = false);
     static void residual(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& rows, cl::Buffer& x, const cl::Buffer& rhs, cl::Buffer& out, int Nb, unsigned int block_size);
 
+    /// b = A * x for a matrix in the sliced format of OpenclSellMatrix
+    static void spmv_sell(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& slicePointers, cl::Buffer& rowIndices,
+        const cl::Buffer& x, cl::Buffer& b, int num_slices, int slice_height, unsigned int block_size);
+
+    /// Copy the values of a BCSR matrix to the sliced format of OpenclSellMatrix
+    static void sell_gather(const cl::Buffer& bcsr_vals, cl::Buffer& blockMap, cl::Buffer& vals,
+        int num_blocks, int slice_height, unsigned int block_size);
+
+    /// Apply the ILU factors, with float_factors the vals and invDiagVals buffers hold floats
     static void ILU_apply1(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& rows, cl::Buffer& diagIndex,
-        const cl::Buffer& y, cl::Buffer& x, cl::Buffer& rowsPerColor, int color, int Nb, unsigned int block_size);
+        const cl::Buffer& y, cl::Buffer& x, cl::Buffer& rowsPerColor, int color, int Nb, unsigned int block_size,
+        bool float_factors = false);
 
     static void ILU_apply2(cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& rows, cl::Buffer& diagIndex,
-        cl::Buffer& invDiagVals, cl::Buffer& x, cl::Buffer& rowsPerColor, int color, int Nb, unsigned int block_size);
+        cl::Buffer& invDiagVals, cl::Buffer& x, cl::Buffer& rowsPerColor, int color, int Nb, unsigned int block_size,
+        bool float_factors = false);
+
+    /// out = (float)in, out must hold N floats
+    static void convert_to_float(const cl::Buffer& in, cl::Buffer& out, int N);
 
     static void ILU_decomp(int firstRow, int lastRow, cl::Buffer& vals, cl::Buffer& cols, cl::Buffer& rows,
         cl::Buffer& diagIndex, cl::Buffer& invDiagVals, int Nb, unsigned int block_size);
@@ -150,6 +202,12 @@ public:
         cl::Buffer &d_Ccols_ocl, cl::Buffer &d_Bcols_ocl, cl::Buffer &d_x, cl::Buffer &d_y,
         int dim, int dim_wells, cl::Buffer &d_val_pointers_ocl, int num_std_wells);
 
+    /// Apply all multisegment wells, y -= C^T * (D^-1 * (B * x)), one workgroup per well
+    /// The concatenated data of the wells is created by WellContributionsOCL
+    static void apply_mswells(cl::Buffer& d_Cvals, cl::Buffer& d_Bvals, cl::Buffer& d_cols, cl::Buffer& d_rowPointers,
+        cl::Buffer& d_segPointers, cl::Buffer& d_Dinv, cl::Buffer& d_DinvPointers, cl::Buffer& d_x, cl::Buffer& d_y,
+        cl::Buffer& d_z1, cl::Buffer& d_z2, int dim, int dim_wells, int num_ms_wells);
+
     static void isaiL(cl::Buffer& diagIndex, cl::Buffer& colPointers, cl::Buffer& mapping, cl::Buffer& nvc,
             cl::Buffer& luIdxs, cl::Buffer& xxIdxs, cl::Buffer& dxIdxs, cl::Buffer& LUvals, cl::Buffer& invLvals, unsigned int Nb);
 
@@ -18,13 +18,19 @@
 */
 
 #include <config.h>
+#include <algorithm>
 #include <cmath>
+#include <fstream>
 #include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/common/ErrorMacros.hpp>
 #include <dune/common/timer.hh>
 
+#include <opm/simulators/linalg/bda/opencl/BILU0.hpp>
 #include <opm/simulators/linalg/bda/opencl/opencl.hpp>
 #include <opm/simulators/linalg/bda/opencl/openclKernels.hpp>
 #include <opm/simulators/linalg/bda/opencl/openclSolverBackend.hpp>
@@ -47,7 +53,7 @@ using Opm::OpmLog;
 using Dune::Timer;
 
 template <unsigned int block_size>
-openclSolverBackend<block_size>::openclSolverBackend(int verbosity_, int maxit_, double tolerance_, unsigned int platformID_, unsigned int deviceID_, ILUReorder opencl_ilu_reorder_, std::string linsolver) : BdaSolver<block_size>(verbosity_, maxit_, tolerance_, platformID_, deviceID_), opencl_ilu_reorder(opencl_ilu_reorder_) {
+openclSolverBackend<block_size>::openclSolverBackend(int verbosity_, int maxit_, double tolerance_, unsigned int platformID_, unsigned int deviceID_, ILUReorder opencl_ilu_reorder_, std::string linsolver, const std::string& program_cache) : BdaSolver<block_size>(verbosity_, maxit_, tolerance_, platformID_, deviceID_), opencl_ilu_reorder(opencl_ilu_reorder_) {
 
     bool use_cpr, use_isai;
 
@@ -58,15 +64,22 @@ openclSolverBackend<block_size>::openclSolverBackend(int verbosity_, int maxit_,
         use_cpr = true;
         use_isai = false;
     } else if (linsolver.compare("isai") == 0) {
+        if (block_size != 3) {
+            OPM_THROW(std::logic_error, "Error openclSolver only supports --linsolver=isai for block_size = 3");
+        }
         use_cpr = false;
         use_isai = true;
+    } else if (linsolver.compare("autotune") == 0) {
+        // BILU0 until the first solve_system() picks the preconditioner
+        use_cpr = false;
+        use_isai = false;
+        autotune = true;
     } else if (linsolver.compare("cpr_trueimpes") == 0) {
         OPM_THROW(std::logic_error, "Error openclSolver does not support --linsolver=cpr_trueimpes");
     } else {
         OPM_THROW(std::logic_error, "Error unknown value for argument --linsolver, " + linsolver);
     }
 
-    using PreconditionerType = typename Preconditioner<block_size>::PreconditionerType;
     if (use_cpr) {
         prec = Preconditioner<block_size>::create(PreconditionerType::CPR, verbosity, opencl_ilu_reorder);
     } else if (use_isai) {
@@ -204,7 +217,7 @@ openclSolverBackend<block_size>::openclSolverBackend(int verbosity_, int maxit_,
         context = std::make_shared<cl::Context>(devices[0]);
         queue.reset(new cl::CommandQueue(*context, devices[0], 0, &err));
 
-        OpenclKernels::init(context.get(), queue.get(), devices, verbosity);
+        OpenclKernels::init(context.get(), queue.get(), devices, verbosity, program_cache);
 
     } catch (const cl::Error& error) {
         std::ostringstream oss;
@@ -239,10 +252,80 @@ openclSolverBackend<block_size>::~openclSolverBackend() {
 
 
 
+template <unsigned int block_size>
+double openclSolverBackend<block_size>::global_dot(cl::Buffer& in1, cl::Buffer& in2) {
+    if (!isParallel()) {
+        return OpenclKernels::dot(in1, in2, d_tmp, N);
+    }
+    return globalSum(OpenclKernels::dot(in1, in2, d_tmp, N_owned));
+}
+
+template <unsigned int block_size>
+double openclSolverBackend<block_size>::global_norm(cl::Buffer& in) {
+    if (!isParallel()) {
+        return OpenclKernels::norm(in, d_tmp, N);
+    }
+    return std::sqrt(global_dot(in, in));
+}
+
+template <unsigned int block_size>
+std::pair<double, double> openclSolverBackend<block_size>::global_dot_2(cl::Buffer& in1, cl::Buffer& in2, cl::Buffer& in3) {
+    if (!isParallel()) {
+        return OpenclKernels::dot_2(in1, in2, in3, d_tmp, N);
+    }
+    const auto local = OpenclKernels::dot_2(in1, in2, in3, d_tmp, N_owned);
+    return {globalSum(local.first), globalSum(local.second)};
+}
+
+template <unsigned int block_size>
+std::pair<double, double> openclSolverBackend<block_size>::global_bicgstab_update(cl::Buffer& x, cl::Buffer& dx, const double alpha_x,
+                                                                                  cl::Buffer& r, cl::Buffer& dr, const double alpha_r, cl::Buffer& rw) {
+    // all rows are updated, only the owned rows are reduced
+    const int N_reduce = isParallel() ? N_owned : N;
+    auto sums = OpenclKernels::bicgstab_update(x, dx, alpha_x, r, dr, alpha_r, rw, d_tmp, N, N_reduce);
+    if (isParallel()) {
+        sums = {globalSum(sums.first), globalSum(sums.second)};
+    }
+    return {std::sqrt(sums.first), sums.second};
+}
+
+template <unsigned int block_size>
+void openclSolverBackend<block_size>::copy_owner_to_all(cl::Buffer& vec) {
+    if (!isParallel()) {
+        return;
+    }
+    h_halo.resize(N);
+    queue->enqueueReadBuffer(vec, CL_TRUE, 0, sizeof(double) * N, h_halo.data());
+    copyOwnerToAll(h_halo.data(), N);
+    if (N > N_owned) {
+        queue->enqueueWriteBuffer(vec, CL_TRUE, sizeof(double) * N_owned, sizeof(double) * (N - N_owned), h_halo.data() + N_owned);
+    }
+}
+
+template <unsigned int block_size>
+void openclSolverBackend<block_size>::project(cl::Buffer& vec) {
+    if (!isParallel() || N == N_owned) {
+        return;
+    }
+    cl::Event event;
+    queue->enqueueFillBuffer(vec, 0, sizeof(double) * N_owned, sizeof(double) * (N - N_owned), nullptr, &event);
+    event.wait();
+}
+
+template <unsigned int block_size>
+void openclSolverBackend<block_size>::spmv_A(cl::Buffer& x, cl::Buffer& b) {
+    if (sellMat) {
+        OpenclKernels::spmv_sell(sellMat->nnzValues, sellMat->colIndices, sellMat->slicePointers, sellMat->rowIndices,
+                                 x, b, sellMat->num_slices, sellMat->slice_height, block_size);
+    } else {
+        OpenclKernels::spmv(d_Avals, d_Acols, d_Arows, x, b, Nb, block_size);
+    }
+}
+
 template <unsigned int block_size>
 void openclSolverBackend<block_size>::gpu_pbicgstab(WellContributions& wellContribs, BdaResult& res) {
     float it;
-    double rho, rhop, beta, alpha, omega, tmp1, tmp2;
+    double rho, rhop, rho_next = 0.0, beta, alpha, omega, tmp1, tmp2;
     double norm, norm_0;
 
     Timer t_total, t_prec(false), t_spmv(false), t_well(false), t_rest(false);
@@ -270,7 +353,13 @@ void openclSolverBackend<block_size>::gpu_pbicgstab(WellContributions& wellContr
         OPM_THROW(std::logic_error, "openclSolverBackend OpenCL enqueue[Fill|Copy]Buffer error");
     }
 
-    norm = OpenclKernels::norm(d_r, d_tmp, N);
+    // for a distributed system the residual is only kept on the owned rows,
+    // the preconditioned vectors are made consistent before each spmv
+    project(d_r);
+    project(d_rw);
+    project(d_p);
+
+    norm = global_norm(d_r);
     norm_0 = norm;
 
     if (verbosity > 1) {
@@ -282,7 +371,8 @@ void openclSolverBackend<block_size>::gpu_pbicgstab(WellContributions& wellContr
     t_rest.start();
     for (it = 0.5; it < maxit; it += 0.5) {
         rhop = rho;
-        rho = OpenclKernels::dot(d_rw, d_r, d_tmp, N);
+        // rho for later iterations comes from the fused update at the end of the previous one
+        rho = it > 1 ? rho_next : global_dot(d_rw, d_r);
 
         if (it > 1) {
             beta = (rho / rhop) * (alpha / omega);
@@ -293,11 +383,13 @@ void openclSolverBackend<block_size>::gpu_pbicgstab(WellContributions& wellContr
         // pw = prec(p)
         t_prec.start();
         prec->apply(d_p, d_pw);
+        copy_owner_to_all(d_pw);
         t_prec.stop();
 
         // v = A * pw
         t_spmv.start();
-        OpenclKernels::spmv(d_Avals, d_Acols, d_Arows, d_pw, d_v, Nb, block_size);
+        spmv_A(d_pw, d_v);
+        project(d_v);
         t_spmv.stop();
 
         // apply wellContributions
@@ -308,14 +400,20 @@ void openclSolverBackend<block_size>::gpu_pbicgstab(WellContributions& wellContr
         t_well.stop();
 
         t_rest.start();
-        tmp1 = OpenclKernels::dot(d_rw, d_v, d_tmp, N);
+        tmp1 = global_dot(d_rw, d_v);
         alpha = rho / tmp1;
-        OpenclKernels::axpy(d_v, -alpha, d_r, N);      // r = r - alpha * v
-        OpenclKernels::axpy(d_pw, alpha, d_x, N);      // x = x + alpha * pw
-        norm = OpenclKernels::norm(d_r, d_tmp, N);
+        // x = x + alpha * pw, r = r - alpha * v
+        // the norm of r is only needed, and read back, if the convergence is checked here
+        const bool check_half = (static_cast<int>(it) % convergence_check_interval) == 0;
+        if (check_half) {
+            norm = global_bicgstab_update(d_x, d_pw, alpha, d_r, d_v, -alpha, d_rw).first;
+        } else {
+            OpenclKernels::axpy(d_pw, alpha, d_x, N);
+            OpenclKernels::axpy(d_v, -alpha, d_r, N);
+        }
         t_rest.stop();
 
-        if (norm < tolerance * norm_0) {
+        if (check_half && norm < tolerance * norm_0) {
             break;
         }
 
@@ -324,11 +422,13 @@ void openclSolverBackend<block_size>::gpu_pbicgstab(WellContributions& wellContr
         // s = prec(r)
         t_prec.start();
         prec->apply(d_r, d_s);
+        copy_owner_to_all(d_s);
         t_prec.stop();
 
         // t = A * s
         t_spmv.start();
-        OpenclKernels::spmv(d_Avals, d_Acols, d_Arows, d_s, d_t, Nb, block_size);
+        spmv_A(d_s, d_t);
+        project(d_t);
         t_spmv.stop();
 
         // apply wellContributions
@@ -339,12 +439,10 @@ void openclSolverBackend<block_size>::gpu_pbicgstab(WellContributions& wellContr
         t_well.stop();
 
         t_rest.start();
-        tmp1 = OpenclKernels::dot(d_t, d_r, d_tmp, N);
-        tmp2 = OpenclKernels::dot(d_t, d_t, d_tmp, N);
+        std::tie(tmp1, tmp2) = global_dot_2(d_t, d_r, d_t);
         omega = tmp1 / tmp2;
-        OpenclKernels::axpy(d_s, omega, d_x, N);     // x = x + omega * s
-        OpenclKernels::axpy(d_t, -omega, d_r, N);    // r = r - omega * t
-        norm = OpenclKernels::norm(d_r, d_tmp, N);
+        // x = x + omega * s, r = r - omega * t
+        std::tie(norm, rho_next) = global_bicgstab_update(d_x, d_s, omega, d_r, d_t, -omega, d_rw);
         t_rest.stop();
 
         if (norm < tolerance * norm_0) {
@@ -415,7 +513,8 @@ void openclSolverBackend<block_size>::initialize(int N_, int nnz_, int dim, doub
         d_s = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(double) * N);
         d_t = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(double) * N);
         d_v = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(double) * N);
-        d_tmp = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(double) * N);
+        // the paired reductions write two partial sums per work group
+        d_tmp = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(double) * std::max(N, 2));
 
         d_Avals = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(double) * nnz);
         d_Acols = cl::Buffer(*context, CL_MEM_READ_WRITE, sizeof(int) * nnzb);
@@ -447,8 +546,22 @@ void openclSolverBackend<block_size>::finalize() {
     if (opencl_ilu_reorder != ILUReorder::NONE) {
         delete[] rb;
     }
+    discard_matrix_upload();
 } // end finalize()
 
+template <unsigned int block_size>
+void openclSolverBackend<block_size>::enqueue_matrix_upload(double *vals, cl::Event *event) {
+    if (vals != h_vals_ptr) {
+        h_vals = cl::Buffer(*context, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, sizeof(double) * nnz, vals);
+        h_vals_ptr = vals;
+    }
+    // the values were changed on the host since the last upload, mapping the buffer
+    // with invalidation followed by unmapping makes the runtime use the new contents
+    void *mapped = queue->enqueueMapBuffer(h_vals, CL_TRUE, CL_MAP_WRITE_INVALIDATE_REGION, 0, sizeof(double) * nnz);
+    queue->enqueueUnmapMemObject(h_vals, mapped);
+    queue->enqueueCopyBuffer(h_vals, d_Avals, 0, 0, sizeof(double) * nnz, nullptr, event);
+}
+
 template <unsigned int block_size>
 void openclSolverBackend<block_size>::copy_system_to_gpu() {
     Timer t;
@@ -463,7 +576,8 @@ void openclSolverBackend<block_size>::copy_system_to_gpu() {
     }
     err = queue->enqueueWriteBuffer(d_Avals, CL_TRUE, 0, sizeof(double) * nnz, vals_contiguous.data(), nullptr, &events[0]);
 #else
-    err = queue->enqueueWriteBuffer(d_Avals, CL_TRUE, 0, sizeof(double) * nnz, rmat->nnzValues, nullptr, &events[0]);
+    enqueue_matrix_upload(rmat->nnzValues, &events[0]);
+    err = CL_SUCCESS;
 #endif
 
     err |= queue->enqueueWriteBuffer(d_Acols, CL_TRUE, 0, sizeof(int) * nnzb, rmat->colIndices, nullptr, &events[1]);
@@ -480,6 +594,9 @@ void openclSolverBackend<block_size>::copy_system_to_gpu() {
         // enqueueWriteBuffer is C and does not throw exceptions like C++ OpenCL
         OPM_THROW(std::logic_error, "openclSolverBackend OpenCL enqueueWriteBuffer error");
     }
+    if (sellMat) {
+        sellMat->gather(d_Avals);
+    }
 
     if (verbosity > 2) {
         std::ostringstream out;
@@ -494,17 +611,25 @@ void openclSolverBackend<block_size>::update_system_on_gpu() {
     Timer t;
     events.resize(3);
 
+    if (matrix_upload_pending) {
+        // values are already on their way, only wait for them
+        events[0] = upload_event;
+        err = CL_SUCCESS;
+        matrix_upload_pending = false;
+    } else {
 #if COPY_ROW_BY_ROW
-    int sum = 0;
-    for (int i = 0; i < Nb; ++i) {
-        int size_row = rmat->rowPointers[i + 1] - rmat->rowPointers[i];
-        memcpy(vals_contiguous.data() + sum, reinterpret_cast<double*>(rmat->nnzValues) + sum, size_row * sizeof(double) * block_size * block_size);
-        sum += size_row * block_size * block_size;
-    }
-    err = queue->enqueueWriteBuffer(d_Avals, CL_TRUE, 0, sizeof(double) * nnz, vals_contiguous.data(), nullptr, &events[0]);
+        int sum = 0;
+        for (int i = 0; i < Nb; ++i) {
+            int size_row = rmat->rowPointers[i + 1] - rmat->rowPointers[i];
+            memcpy(vals_contiguous.data() + sum, reinterpret_cast<double*>(rmat->nnzValues) + sum, size_row * sizeof(double) * block_size * block_size);
+            sum += size_row * block_size * block_size;
+        }
+        err = queue->enqueueWriteBuffer(d_Avals, CL_TRUE, 0, sizeof(double) * nnz, vals_contiguous.data(), nullptr, &events[0]);
 #else
-    err = queue->enqueueWriteBuffer(d_Avals, CL_TRUE, 0, sizeof(double) * nnz, rmat->nnzValues, nullptr, &events[0]);
+        enqueue_matrix_upload(rmat->nnzValues, &events[0]);
+        err = CL_SUCCESS;
 #endif
+    }
 
     err |= queue->enqueueWriteBuffer(d_b, CL_TRUE, 0, sizeof(double) * N, rb, nullptr, &events[1]);
     err |= queue->enqueueFillBuffer(d_x, 0, 0, sizeof(double) * N, nullptr, &events[2]);
@@ -514,6 +639,9 @@ void openclSolverBackend<block_size>::update_system_on_gpu() {
         // enqueueWriteBuffer is C and does not throw exceptions like C++ OpenCL
         OPM_THROW(std::logic_error, "openclSolverBackend OpenCL enqueueWriteBuffer error");
     }
+    if (sellMat) {
+        sellMat->gather(d_Avals);
+    }
 
     if (verbosity > 2) {
         std::ostringstream out;
@@ -527,6 +655,9 @@ template <unsigned int block_size>
 bool openclSolverBackend<block_size>::analyze_matrix() {
     Timer t;
 
+    if (auto *bilu0 = dynamic_cast<BILU0<block_size>*>(prec.get())) {
+        bilu0->setFloatFactors(ilu_float_factors);
+    }
     // bool success = bilu0->init(mat.get());
     bool success = prec->analyze_matrix(mat.get());
 
@@ -541,6 +672,16 @@ bool openclSolverBackend<block_size>::analyze_matrix() {
         rmat = prec->getRMat();
     }
 
+    if (use_sell) {
+        // the values are gathered into the sliced copy after every upload
+        sellMat = std::make_unique<OpenclSellMatrix>(context.get(), queue.get(), rmat->rowPointers, rmat->colIndices, Nb, block_size);
+        if (verbosity > 1) {
+            std::ostringstream out;
+            out << "openclSolver uses a sliced ELLPACK matrix, " << sellMat->num_slices << " slices, fill ratio "
+                << sellMat->fillRatio();
+            OpmLog::info(out.str());
+        }
+    }
 
     if (verbosity > 2) {
         std::ostringstream out;
@@ -575,6 +716,43 @@ void openclSolverBackend<block_size>::update_system(double *vals, double *b, Wel
 } // end update_system()
 
 
+template <unsigned int block_size>
+bool openclSolverBackend<block_size>::upload_matrix_async(double *vals) {
+    if (!initialized || opencl_ilu_reorder != ILUReorder::NONE) {
+        return false;
+    }
+    Timer t;
+
+    try {
+        discard_matrix_upload();
+        enqueue_matrix_upload(vals, &upload_event);
+        queue->flush();
+    } catch (const cl::Error& error) {
+        std::ostringstream oss;
+        oss << "openclSolverBackend::upload_matrix_async error: " << error.what() << "(" << error.err() << ")\n";
+        oss << getErrorString(error.err());
+        OPM_THROW(std::logic_error, oss.str());
+    }
+    matrix_upload_pending = true;
+
+    if (verbosity > 2) {
+        std::ostringstream out;
+        out << "openclSolver::upload_matrix_async(): " << t.stop() << " s";
+        OpmLog::info(out.str());
+    }
+    return true;
+} // end upload_matrix_async()
+
+
+template <unsigned int block_size>
+void openclSolverBackend<block_size>::discard_matrix_upload() {
+    if (matrix_upload_pending) {
+        upload_event.wait();
+        matrix_upload_pending = false;
+    }
+}
+
+
 template <unsigned int block_size>
 bool openclSolverBackend<block_size>::create_preconditioner() {
     Timer t;
@@ -617,6 +795,104 @@ void openclSolverBackend<block_size>::solve_system(WellContributions &wellContri
 } // end solve_system()
 
 
+template <unsigned int block_size>
+void openclSolverBackend<block_size>::set_preconditioner(PreconditionerType type) {
+    prec = Preconditioner<block_size>::create(type, verbosity, opencl_ilu_reorder);
+    prec->setOpencl(context, queue);
+    analysis_done = false;
+}
+
+
+template <unsigned int block_size>
+SolverStatus openclSolverBackend<block_size>::autotune_preconditioner(double *vals, double *b, WellContributions& wellContribs, BdaResult& res) {
+    // the names are the matching --linsolver arguments
+    std::vector<std::pair<PreconditionerType, std::string>> candidates = {{PreconditionerType::BILU0, "ilu0"}};
+    if (block_size > 1) {
+        candidates.emplace_back(PreconditionerType::CPR, "cpr_quasiimpes");
+    }
+    if (block_size == 3) {
+        candidates.emplace_back(PreconditionerType::BISAI, "isai");
+    }
+
+    auto solve_with = [&](PreconditionerType type, BdaResult& result) {
+        set_preconditioner(type);
+        if (!analyze_matrix()) {
+            return SolverStatus::BDA_SOLVER_ANALYSIS_FAILED;
+        }
+        update_system(vals, b, wellContribs);
+        if (!create_preconditioner()) {
+            return SolverStatus::BDA_SOLVER_CREATE_PRECONDITIONER_FAILED;
+        }
+        copy_system_to_gpu();
+        solve_system(wellContribs, result);
+        return SolverStatus::BDA_SOLVER_SUCCESS;
+    };
+
+    std::ostringstream key;
+    key << block_size << " " << Nb << " " << nnzb << " " << hashSparsityPattern(mat->rowPointers, mat->colIndices, Nb);
+    if (!autotune_cache.empty()) {
+        std::ifstream file(autotune_cache);
+        std::string line;
+        const std::string prefix = key.str() + " ";
+        while (std::getline(file, line)) {
+            if (line.compare(0, prefix.size(), prefix) != 0) {
+                continue;
+            }
+            for (const auto& [type, name] : candidates) {
+                if (line.substr(prefix.size()) == name) {
+                    OpmLog::info("openclSolver autotune: using " + name + " from " + autotune_cache);
+                    return solve_with(type, res);
+                }
+            }
+        }
+    }
+
+    std::ostringstream out;
+    out << "openclSolver autotune:\n";
+    int best = -1;
+    double best_time = 0.0;
+    SolverStatus status = SolverStatus::BDA_SOLVER_SUCCESS;
+    for (unsigned int i = 0; i < candidates.size(); ++i) {
+        Timer t;
+        BdaResult result;
+        result.converged = false;
+        try {
+            status = solve_with(candidates[i].first, result);
+        } catch (const std::logic_error& error) {
+            // e.g. a preconditioner that cannot be created for this matrix
+            out << "  " << candidates[i].second << " failed: " << error.what() << "\n";
+            continue;
+        }
+        const double time = t.stop();
+        out << "  " << candidates[i].second << ": " << time << " s, " << result.iterations << " iterations"
+            << (result.converged ? "" : ", not converged") << "\n";
+        if (status == SolverStatus::BDA_SOLVER_SUCCESS && result.converged && (best < 0 || time < best_time)) {
+            best = i;
+            best_time = time;
+        }
+        res = result;
+    }
+
+    if (best < 0) {
+        // nothing converged, fall back to the default
+        best = 0;
+    }
+    out << "  using " << candidates[best].second;
+    OpmLog::info(out.str());
+
+    if (!autotune_cache.empty()) {
+        std::ofstream file(autotune_cache, std::ios::app);
+        file << key.str() << " " << candidates[best].second << "\n";
+    }
+
+    // the solution of the last attempt is still on the GPU, only redo the solve if that is not the chosen one
+    if (best != static_cast<int>(candidates.size()) - 1 || status != SolverStatus::BDA_SOLVER_SUCCESS) {
+        return solve_with(candidates[best].first, res);
+    }
+    return status;
+}
+
+
 // copy result to host memory
 // caller must be sure that x is a valid array
 template <unsigned int block_size>
@@ -640,8 +916,21 @@ void openclSolverBackend<block_size>::get_result(double *x) {
 
 template <unsigned int block_size>
 SolverStatus openclSolverBackend<block_size>::solve_system(int N_, int nnz_, int dim, double *vals, int *rows, int *cols, double *b, WellContributions& wellContribs, BdaResult &res) {
+    if (isParallel() && opencl_ilu_reorder != ILUReorder::NONE) {
+        // the owned rows must stay in front to exchange halos and compute global dot products
+        OPM_THROW(std::logic_error, "Error openclSolver only supports --opencl-ilu-reorder=none for a distributed system");
+    }
+    if (isParallel() && autotune) {
+        // the timings and the cache file are local to each process, which could
+        // then choose different preconditioners and solve a different number of times
+        OPM_THROW(std::logic_error, "Error openclSolver does not support --linsolver=autotune for a distributed system");
+    }
     if (initialized == false) {
         initialize(N_, nnz_,  dim, vals, rows, cols);
+        if (autotune) {
+            autotune = false;
+            return autotune_preconditioner(vals, b, wellContribs, res);
+        }
         if (analysis_done == false) {
             if (!analyze_matrix()) {
                 return SolverStatus::BDA_SOLVER_ANALYSIS_FAILED;
@@ -666,9 +955,11 @@ SolverStatus openclSolverBackend<block_size>::solve_system(int N_, int nnz_, int
 
 #define INSTANTIATE_BDA_FUNCTIONS(n)                                        \
 template openclSolverBackend<n>::openclSolverBackend(                       \
-    int, int, double, unsigned int, unsigned int, ILUReorder, std::string); \
+    int, int, double, unsigned int, unsigned int, ILUReorder, std::string, const std::string&); \
 template openclSolverBackend<n>::openclSolverBackend(int, int, double, ILUReorder); \
-template void openclSolverBackend<n>::setOpencl(std::shared_ptr<cl::Context>&, std::shared_ptr<cl::CommandQueue>&);
+template void openclSolverBackend<n>::setOpencl(std::shared_ptr<cl::Context>&, std::shared_ptr<cl::CommandQueue>&); \
+template bool openclSolverBackend<n>::upload_matrix_async(double*);                 \
+template void openclSolverBackend<n>::discard_matrix_upload();
 
 INSTANTIATE_BDA_FUNCTIONS(1);
 INSTANTIATE_BDA_FUNCTIONS(2);
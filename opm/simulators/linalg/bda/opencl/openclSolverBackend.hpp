@@ -20,7 +20,12 @@
 #ifndef OPM_OPENCLSOLVER_BACKEND_HEADER_INCLUDED
 #define OPM_OPENCLSOLVER_BACKEND_HEADER_INCLUDED
 
+#include <algorithm>
+#include <utility>
+
 #include <opm/simulators/linalg/bda/opencl/opencl.hpp>
+#include <opm/simulators/linalg/bda/opencl/OpenclBufferPool.hpp>
+#include <opm/simulators/linalg/bda/opencl/OpenclSellMatrix.hpp>
 #include <opm/simulators/linalg/bda/BdaResult.hpp>
 #include <opm/simulators/linalg/bda/BdaSolver.hpp>
 #include <opm/simulators/linalg/bda/ILUReorder.hpp>
@@ -49,6 +54,10 @@ class openclSolverBackend : public BdaSolver<block_size>
     using Base::maxit;
     using Base::tolerance;
     using Base::initialized;
+    using Base::N_owned;
+    using Base::copyOwnerToAll;
+    using Base::globalSum;
+    using Base::isParallel;
 
 private:
     double *rb = nullptr;                 // reordered b vector, if the matrix is reordered, rb is newly allocated, otherwise it just points to b
@@ -73,6 +82,19 @@ private:
     ILUReorder opencl_ilu_reorder;                                // reordering strategy
     std::vector<cl::Event> events;
     cl_int err;
+    std::vector<double> h_halo;                                   // host copy of a vector for the halo exchange of a distributed system
+    cl::Buffer h_vals;                                            // wraps the host array of matrix values (CL_MEM_USE_HOST_PTR)
+    double *h_vals_ptr = nullptr;                                 // host array wrapped by h_vals
+    cl::Event upload_event;                                       // completes when the asynchronous upload is done
+    bool matrix_upload_pending = false;
+    bool autotune = false;                                        // choose the preconditioner in the first solve, see --linsolver=autotune
+    std::string autotune_cache;                                   // file with the choices of earlier runs, empty to disable
+    int convergence_check_interval = 1;                           // iterations between the convergence checks halfway an iteration
+    bool use_sell = false;                                        // use a sliced ELLPACK copy of the matrix for the spmv
+    std::unique_ptr<OpenclSellMatrix> sellMat;                    // sliced copy of rmat, only if use_sell is set
+    bool ilu_float_factors = false;                               // BILU0 applies single precision factors
+
+    using PreconditionerType = typename Preconditioner<block_size>::PreconditionerType;
 
     /// Divide A by B, and round up: return (int)ceil(A/B)
     /// \param[in] A    dividend
@@ -124,6 +146,59 @@ private:
     /// \param[out] b       output vector
     void spmv_blocked_w(cl::Buffer vals, cl::Buffer cols, cl::Buffer rows, cl::Buffer x, cl::Buffer b);
 
+    /// Calculate the dot product of in1 and in2, for a distributed system only the owned rows
+    /// are used and the result is summed over all processes
+    /// \param[in] in1           input vector 1
+    /// \param[in] in2           input vector 2
+    /// \return                  global dot product
+    double global_dot(cl::Buffer& in1, cl::Buffer& in2);
+
+    /// Calculate the norm of in, for a distributed system over the owned rows of all processes
+    /// \param[in] in            input vector
+    /// \return                  global norm
+    double global_norm(cl::Buffer& in);
+
+    /// Calculate (in1, in2) and (in1, in3) in a single pass over in1, globally as global_dot()
+    /// \param[in] in1          input vector 1
+    /// \param[in] in2          input vector 2
+    /// \param[in] in3          input vector 3
+    /// \return                 pair of global dot products
+    std::pair<double, double> global_dot_2(cl::Buffer& in1, cl::Buffer& in2, cl::Buffer& in3);
+
+    /// Fused bicgstab update: x += alpha_x * dx and r += alpha_r * dr, followed by
+    /// the global reductions (r, r) and (rw, r) of the updated r
+    /// \param[inout] x         solution vector
+    /// \param[in] dx           update of x
+    /// \param[in] alpha_x      scaling of dx
+    /// \param[inout] r         residual vector
+    /// \param[in] dr           update of r
+    /// \param[in] alpha_r      scaling of dr
+    /// \param[in] rw           shadow residual
+    /// \return                 norm of the updated r and (rw, r)
+    std::pair<double, double> global_bicgstab_update(cl::Buffer& x, cl::Buffer& dx, const double alpha_x,
+                                                     cl::Buffer& r, cl::Buffer& dr, const double alpha_r, cl::Buffer& rw);
+
+    /// Update the copied rows of vec from their owners, does nothing for a serial system
+    /// The exchange is staged through host memory
+    /// \param[inout] vec        vector on GPU
+    void copy_owner_to_all(cl::Buffer& vec);
+
+    /// Set the copied rows of vec to zero, does nothing for a serial system
+    /// \param[inout] vec        vector on GPU
+    void project(cl::Buffer& vec);
+
+    /// Perform b = A * x with the BSR matrix or its sliced copy
+    /// \param[in] x             input vector on GPU
+    /// \param[out] b            output vector on GPU
+    void spmv_A(cl::Buffer& x, cl::Buffer& b);
+
+    /// Enqueue the copy of the matrix values from host memory to d_Avals
+    /// The host array is wrapped in an OpenCL buffer once, so the driver can transfer
+    /// directly from it instead of first copying to an internal staging buffer
+    /// \param[in] vals          matrix values, must stay at the same address between solves to avoid rewrapping
+    /// \param[out] event        completes when the values are on the device
+    void enqueue_matrix_upload(double *vals, cl::Event *event);
+
     /// Solve linear system using ilu0-bicgstab
     /// \param[in] wellContribs   WellContributions, to apply them separately, instead of adding them to matrix A
     /// \param[inout] res         summary of solver result
@@ -166,9 +241,25 @@ private:
     /// \param[inout] res         summary of solver result
     void solve_system(WellContributions &wellContribs, BdaResult &res);
 
+    /// Replace the preconditioner, the matrix must be analyzed again afterwards
+    /// \param[in] type           new preconditioner
+    void set_preconditioner(PreconditionerType type);
+
+    /// Solve the first linear system with each preconditioner that supports this block_size,
+    /// and keep the fastest one that converges. If autotune_cache is set, a choice made for the
+    /// same sparsity pattern in an earlier run is used instead, and a new choice is appended to it
+    /// Only for sequential runs, the choice is made from the timings of this process
+    /// \param[in] vals           array of nonzeroes, each block is stored row-wise and contiguous, contains nnz values
+    /// \param[in] b              input vector, contains N values
+    /// \param[in] wellContribs   WellContributions, to apply them separately, instead of adding them to matrix A
+    /// \param[inout] res         summary of solver result of the chosen preconditioner
+    /// \return                   status code
+    SolverStatus autotune_preconditioner(double *vals, double *b, WellContributions& wellContribs, BdaResult& res);
+
 public:
     std::shared_ptr<cl::Context> context;
     std::shared_ptr<cl::CommandQueue> queue;
+    OpenclBufferPool bufferPool;                                  // device buffers of the WellContributions
 
     /// Construct a openclSolver
     /// \param[in] linear_solver_verbosity    verbosity of openclSolver
@@ -178,9 +269,10 @@ public:
     /// \param[in] deviceID                   the device to be used
     /// \param[in] opencl_ilu_reorder         select either level_scheduling or graph_coloring, see Reorder.hpp for explanation
     /// \param[in] linsolver                  indicating the preconditioner, equal to the --linsolver cmdline argument
-    ///                                       only ilu0, cpr_quasiimpes and isai are supported
+    ///                                       only ilu0, cpr_quasiimpes, isai and autotune are supported
+    /// \param[in] program_cache              directory of the compiled OpenCL kernels, empty to always compile them
     openclSolverBackend(int linear_solver_verbosity, int maxit, double tolerance, unsigned int platformID, unsigned int deviceID,
-        ILUReorder opencl_ilu_reorder, std::string linsolver);
+        ILUReorder opencl_ilu_reorder, std::string linsolver, const std::string& program_cache = "");
 
     /// For the CPR coarse solver
     openclSolverBackend(int linear_solver_verbosity, int maxit, double tolerance, ILUReorder opencl_ilu_reorder);
@@ -213,6 +305,50 @@ public:
     /// \param[inout] x          resulting x vector, caller must guarantee that x points to a valid array
     void get_result(double *x) override;
 
+    /// Set the file to store the preconditioner chosen by --linsolver=autotune in
+    /// A later run with the same sparsity pattern reads the choice back instead of trying all of them
+    /// \param[in] file         name of the cache file, empty to disable
+    void setAutotuneCache(const std::string& file)
+    {
+        autotune_cache = file;
+    }
+
+    /// Set how often the convergence is checked halfway through an iteration
+    /// That check reads the residual norm back from the device, the check at the end
+    /// of an iteration is for free since rho is read back at the same time
+    /// \param[in] interval     number of iterations between the checks, at least 1
+    void setConvergenceCheckInterval(int interval)
+    {
+        convergence_check_interval = std::max(interval, 1);
+    }
+
+    /// Use a sliced ELLPACK (SELL-C-sigma) copy of the matrix for the spmv of the iterations
+    /// The copy is built in analyze_matrix(), and filled on the GPU after every upload of the values
+    /// \param[in] sell         whether to use the sliced copy
+    void setSellFormat(bool sell)
+    {
+        use_sell = sell;
+    }
+
+    /// Let the BILU0 preconditioner apply single precision copies of its factors
+    /// The factorization and the iterations stay in double precision
+    /// \param[in] float_factors    whether to use single precision factors
+    void setIluFloatFactors(bool float_factors)
+    {
+        ilu_float_factors = float_factors;
+    }
+
+    /// Start a non-blocking upload of the matrix values
+    /// The next solve_system() waits for it instead of copying the values again
+    /// Only possible after the first solve and without reordering
+    /// \param[in] vals         matrix values, with the sparsity pattern of the previous solves
+    /// \return                 true iff the upload was started
+    bool upload_matrix_async(double *vals);
+
+    /// Forget a pending asynchronous upload, the values are copied again in the next solve_system()
+    /// Must be called if the matrix values have changed after upload_matrix_async()
+    void discard_matrix_upload();
+
     /// Set OpenCL objects
     /// This class either creates them based on platformID and deviceID or receives them through this function
     /// \param[in] context   the opencl context to be used
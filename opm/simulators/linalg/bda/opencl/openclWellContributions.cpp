@@ -31,10 +31,13 @@ namespace Opm
 {
 
 using Accelerator::OpenclKernels;
+using Slot = Accelerator::OpenclBufferPool::Slot;
 
-void WellContributionsOCL::setOpenCLEnv(cl::Context* context_, cl::CommandQueue* queue_) {
+void WellContributionsOCL::setOpenCLEnv(cl::Context* context_, cl::CommandQueue* queue_,
+                                        Accelerator::OpenclBufferPool* pool_) {
     this->context = context_;
     this->queue = queue_;
+    this->pool = pool_;
  }
 
 void WellContributionsOCL::setKernel(Accelerator::stdwell_apply_kernel_type* kernel_,
@@ -59,7 +62,87 @@ void WellContributionsOCL::apply_stdwells(cl::Buffer d_x, cl::Buffer d_y, cl::Bu
     }
 }
 
+void WellContributionsOCL::prepare_mswells()
+{
+    std::vector<MultisegmentWellContribution*> device_mswells;
+    host_mswells.clear();
+    for (auto& well : multisegments) {
+        const unsigned int M = well->getNumBlockRows() * well->getDimWells();
+        const bool same_sizes = device_mswells.empty()
+            || (well->getDim() == ms_dim && well->getDimWells() == ms_dim_wells);
+        if (M <= max_device_mswell_size && same_sizes) {
+            ms_dim = well->getDim();
+            ms_dim_wells = well->getDimWells();
+            device_mswells.push_back(well.get());
+        } else {
+            host_mswells.push_back(well.get());
+        }
+    }
+    num_device_ms_wells = device_mswells.size();
+    mswells_prepared = true;
+    if (num_device_ms_wells == 0) {
+        return;
+    }
+
+    // concatenate the wells, the rowpointers and columnindices refer to the concatenated blocks
+    std::vector<double> Cvals, Bvals, Dinv, wellDinv;
+    std::vector<int> cols;
+    std::vector<unsigned int> rowPointers(1, 0), segPointers(1, 0), DinvPointers(1, 0);
+    for (auto well : device_mswells) {
+        const unsigned int blockOffset = rowPointers.back();
+        Cvals.insert(Cvals.end(), well->getCvals().begin(), well->getCvals().end());
+        Bvals.insert(Bvals.end(), well->getBvals().begin(), well->getBvals().end());
+        for (const auto col : well->getBcols()) {
+            cols.push_back(reorder ? h_toOrder[col] : col);
+        }
+        const auto& Brows = well->getBrows();
+        for (unsigned int seg = 1; seg < Brows.size(); ++seg) {
+            rowPointers.push_back(blockOffset + Brows[seg]);
+        }
+        segPointers.push_back(segPointers.back() + well->getNumBlockRows());
+        well->computeDenseInverseD(wellDinv);
+        Dinv.insert(Dinv.end(), wellDinv.begin(), wellDinv.end());
+        DinvPointers.push_back(Dinv.size());
+    }
+
+    const unsigned int numSegs = segPointers.back();
+    d_ms_Cvals = &pool->get(*context, Slot::MsWellCvals, sizeof(double) * Cvals.size());
+    d_ms_Bvals = &pool->get(*context, Slot::MsWellBvals, sizeof(double) * Bvals.size());
+    d_ms_cols = &pool->get(*context, Slot::MsWellCols, sizeof(int) * cols.size());
+    d_ms_rowPointers = &pool->get(*context, Slot::MsWellRowPointers, sizeof(unsigned int) * rowPointers.size());
+    d_ms_segPointers = &pool->get(*context, Slot::MsWellSegPointers, sizeof(unsigned int) * segPointers.size());
+    d_ms_Dinv = &pool->get(*context, Slot::MsWellDinv, sizeof(double) * Dinv.size());
+    d_ms_DinvPointers = &pool->get(*context, Slot::MsWellDinvPointers, sizeof(unsigned int) * DinvPointers.size());
+    d_ms_z1 = &pool->get(*context, Slot::MsWellZ1, sizeof(double) * numSegs * ms_dim_wells);
+    d_ms_z2 = &pool->get(*context, Slot::MsWellZ2, sizeof(double) * numSegs * ms_dim_wells);
+
+    events.resize(7);
+    queue->enqueueWriteBuffer(*d_ms_Cvals, CL_FALSE, 0, sizeof(double) * Cvals.size(), Cvals.data(), nullptr, &events[0]);
+    queue->enqueueWriteBuffer(*d_ms_Bvals, CL_FALSE, 0, sizeof(double) * Bvals.size(), Bvals.data(), nullptr, &events[1]);
+    queue->enqueueWriteBuffer(*d_ms_cols, CL_FALSE, 0, sizeof(int) * cols.size(), cols.data(), nullptr, &events[2]);
+    queue->enqueueWriteBuffer(*d_ms_rowPointers, CL_FALSE, 0, sizeof(unsigned int) * rowPointers.size(), rowPointers.data(), nullptr, &events[3]);
+    queue->enqueueWriteBuffer(*d_ms_segPointers, CL_FALSE, 0, sizeof(unsigned int) * segPointers.size(), segPointers.data(), nullptr, &events[4]);
+    queue->enqueueWriteBuffer(*d_ms_Dinv, CL_FALSE, 0, sizeof(double) * Dinv.size(), Dinv.data(), nullptr, &events[5]);
+    queue->enqueueWriteBuffer(*d_ms_DinvPointers, CL_FALSE, 0, sizeof(unsigned int) * DinvPointers.size(), DinvPointers.data(), nullptr, &events[6]);
+    // the host vectors go out of scope
+    cl::WaitForEvents(events);
+    events.clear();
+}
+
 void WellContributionsOCL::apply_mswells(cl::Buffer d_x, cl::Buffer d_y){
+    if (!mswells_prepared) {
+        prepare_mswells();
+    }
+
+    if (num_device_ms_wells > 0) {
+        OpenclKernels::apply_mswells(*d_ms_Cvals, *d_ms_Bvals, *d_ms_cols, *d_ms_rowPointers, *d_ms_segPointers,
+            *d_ms_Dinv, *d_ms_DinvPointers, d_x, d_y, *d_ms_z1, *d_ms_z2, ms_dim, ms_dim_wells, num_device_ms_wells);
+    }
+
+    if (host_mswells.empty()) {
+        return;
+    }
+
     if (h_x.empty()) {
         h_x.resize(N);
         h_y.resize(N);
@@ -71,8 +154,8 @@ void WellContributionsOCL::apply_mswells(cl::Buffer d_x, cl::Buffer d_y){
     cl::WaitForEvents(events);
     events.clear();
 
-    // actually apply MultisegmentWells
-    for (auto& well : multisegments) {
+    // actually apply the MultisegmentWells that are too large for the device
+    for (auto well : host_mswells) {
         well->setReordering(h_toOrder, reorder);
         well->apply(h_x.data(), h_y.data());
     }
@@ -94,61 +177,27 @@ void WellContributionsOCL::apply(cl::Buffer d_x, cl::Buffer d_y, cl::Buffer d_to
     }
 }
 
-void WellContributionsOCL::APIaddMatrix(MatrixType type,
-                                        int* colIndices,
-                                        double* values,
-                                        unsigned int val_size)
+void WellContributionsOCL::APIupload()
 {
-    if (!allocated) {
-        OPM_THROW(std::logic_error, "Error cannot add wellcontribution before allocating memory in WellContributions");
-    }
-
-    switch (type) {
-    case MatrixType::C:
-        events.resize(2);
-        queue->enqueueWriteBuffer(*d_Cnnzs_ocl, CL_FALSE, sizeof(double) * num_blocks_so_far * dim * dim_wells, sizeof(double) * val_size * dim * dim_wells, values, nullptr, &events[0]);
-        queue->enqueueWriteBuffer(*d_Ccols_ocl, CL_FALSE, sizeof(int) * num_blocks_so_far, sizeof(int) * val_size, colIndices, nullptr, &events[1]);
-        cl::WaitForEvents(events);
-        events.clear();
-        break;
-
-    case MatrixType::D:
-        events.resize(1);
-        queue->enqueueWriteBuffer(*d_Dnnzs_ocl, CL_FALSE, sizeof(double) * num_std_wells_so_far * dim_wells * dim_wells, sizeof(double) * dim_wells * dim_wells, values, nullptr, &events[0]);
-        events[0].wait();
-        events.clear();
-        break;
-
-    case MatrixType::B:
-        events.resize(2);
-        queue->enqueueWriteBuffer(*d_Bnnzs_ocl, CL_FALSE, sizeof(double) * num_blocks_so_far * dim * dim_wells, sizeof(double) * val_size * dim * dim_wells, values, nullptr, &events[0]);
-        queue->enqueueWriteBuffer(*d_Bcols_ocl, CL_FALSE, sizeof(int) * num_blocks_so_far, sizeof(int) * val_size, colIndices, nullptr, &events[1]);
-        cl::WaitForEvents(events);
-        events.clear();
-
-        val_pointers[num_std_wells_so_far] = num_blocks_so_far;
-        if (num_std_wells_so_far == num_std_wells - 1) {
-            val_pointers[num_std_wells] = num_blocks;
-            events.resize(1);
-            queue->enqueueWriteBuffer(*d_val_pointers_ocl, CL_FALSE, 0, sizeof(unsigned int) * (num_std_wells + 1), val_pointers.data(), nullptr, &events[0]);
-            events[0].wait();
-            events.clear();
-        }
-        break;
-
-    default:
-        OPM_THROW(std::logic_error, "Error unsupported matrix ID for WellContributionsOCL::addMatrix()");
-    }
+    events.resize(6);
+    queue->enqueueWriteBuffer(*d_Cnnzs_ocl, CL_FALSE, 0, sizeof(double) * h_Cnnzs.size(), h_Cnnzs.data(), nullptr, &events[0]);
+    queue->enqueueWriteBuffer(*d_Dnnzs_ocl, CL_FALSE, 0, sizeof(double) * h_Dnnzs.size(), h_Dnnzs.data(), nullptr, &events[1]);
+    queue->enqueueWriteBuffer(*d_Bnnzs_ocl, CL_FALSE, 0, sizeof(double) * h_Bnnzs.size(), h_Bnnzs.data(), nullptr, &events[2]);
+    queue->enqueueWriteBuffer(*d_Ccols_ocl, CL_FALSE, 0, sizeof(int) * h_Ccols.size(), h_Ccols.data(), nullptr, &events[3]);
+    queue->enqueueWriteBuffer(*d_Bcols_ocl, CL_FALSE, 0, sizeof(int) * h_Bcols.size(), h_Bcols.data(), nullptr, &events[4]);
+    queue->enqueueWriteBuffer(*d_val_pointers_ocl, CL_FALSE, 0, sizeof(unsigned int) * (num_std_wells + 1), val_pointers.data(), nullptr, &events[5]);
+    cl::WaitForEvents(events);
+    events.clear();
 }
 
 void WellContributionsOCL::APIalloc()
 {
-    d_Cnnzs_ocl = std::make_unique<cl::Buffer>(*context, CL_MEM_READ_WRITE, sizeof(double) * num_blocks * dim * dim_wells);
-    d_Dnnzs_ocl = std::make_unique<cl::Buffer>(*context, CL_MEM_READ_WRITE, sizeof(double) * num_std_wells * dim_wells * dim_wells);
-    d_Bnnzs_ocl = std::make_unique<cl::Buffer>(*context, CL_MEM_READ_WRITE, sizeof(double) * num_blocks * dim * dim_wells);
-    d_Ccols_ocl = std::make_unique<cl::Buffer>(*context, CL_MEM_READ_WRITE, sizeof(int) * num_blocks);
-    d_Bcols_ocl = std::make_unique<cl::Buffer>(*context, CL_MEM_READ_WRITE, sizeof(int) * num_blocks);
-    d_val_pointers_ocl = std::make_unique<cl::Buffer>(*context, CL_MEM_READ_WRITE, sizeof(unsigned int) * (num_std_wells + 1));
+    d_Cnnzs_ocl = &pool->get(*context, Slot::StdWellCnnzs, sizeof(double) * num_blocks * dim * dim_wells);
+    d_Dnnzs_ocl = &pool->get(*context, Slot::StdWellDnnzs, sizeof(double) * num_std_wells * dim_wells * dim_wells);
+    d_Bnnzs_ocl = &pool->get(*context, Slot::StdWellBnnzs, sizeof(double) * num_blocks * dim * dim_wells);
+    d_Ccols_ocl = &pool->get(*context, Slot::StdWellCcols, sizeof(int) * num_blocks);
+    d_Bcols_ocl = &pool->get(*context, Slot::StdWellBcols, sizeof(int) * num_blocks);
+    d_val_pointers_ocl = &pool->get(*context, Slot::StdWellValPointers, sizeof(unsigned int) * (num_std_wells + 1));
 }
 
 } //namespace Opm
@@ -23,6 +23,7 @@
 #include <opm/simulators/linalg/bda/WellContributions.hpp>
 
 #include <opm/simulators/linalg/bda/opencl/opencl.hpp>
+#include <opm/simulators/linalg/bda/opencl/OpenclBufferPool.hpp>
 #include <opm/simulators/linalg/bda/opencl/openclKernels.hpp>
 
 #include <memory>
@@ -37,7 +38,9 @@ class WellContributionsOCL : public WellContributions
 public:
     void setKernel(Opm::Accelerator::stdwell_apply_kernel_type *kernel_,
                    Opm::Accelerator::stdwell_apply_no_reorder_kernel_type *kernel_no_reorder_);
-    void setOpenCLEnv(cl::Context *context_, cl::CommandQueue *queue_);
+    /// The device buffers are taken from the pool, which outlives this object
+    void setOpenCLEnv(cl::Context *context_, cl::CommandQueue *queue_,
+                      Opm::Accelerator::OpenclBufferPool *pool_);
 
     /// Since the rows of the matrix are reordered, the columnindices of the matrixdata is incorrect
     /// Those indices need to be mapped via toOrder
@@ -52,22 +55,39 @@ protected:
     /// Allocate memory for the StandardWells
     void APIalloc() override;
 
-    void APIaddMatrix(MatrixType type, int *colIndices, double *values, unsigned int val_size) override;
+    /// Copy the host arena of all StandardWells to the device
+    void APIupload() override;
 
     cl::Context* context;
     cl::CommandQueue* queue;
+    Opm::Accelerator::OpenclBufferPool* pool;
     Opm::Accelerator::stdwell_apply_kernel_type* kernel;
     Opm::Accelerator::stdwell_apply_no_reorder_kernel_type* kernel_no_reorder;
     std::vector<cl::Event> events;
 
-    std::unique_ptr<cl::Buffer> d_Cnnzs_ocl, d_Dnnzs_ocl, d_Bnnzs_ocl;
-    std::unique_ptr<cl::Buffer> d_Ccols_ocl, d_Bcols_ocl;
-    std::unique_ptr<cl::Buffer> d_val_pointers_ocl;
+    // owned by the pool
+    cl::Buffer *d_Cnnzs_ocl = nullptr, *d_Dnnzs_ocl = nullptr, *d_Bnnzs_ocl = nullptr;
+    cl::Buffer *d_Ccols_ocl = nullptr, *d_Bcols_ocl = nullptr;
+    cl::Buffer *d_val_pointers_ocl = nullptr;
 
     bool reorder = false;
     int *h_toOrder = nullptr;
     std::vector<double> h_x;
     std::vector<double> h_y;
+
+    /// Multisegment wells with at most this many rows in D are applied on the device, using a dense D^-1
+    static constexpr unsigned int max_device_mswell_size = 512;
+
+    /// Copy the multisegment wells that are small enough to the device, the others stay on the host
+    void prepare_mswells();
+
+    bool mswells_prepared = false;
+    unsigned int num_device_ms_wells = 0;
+    unsigned int ms_dim = 0, ms_dim_wells = 0;
+    std::vector<MultisegmentWellContribution*> host_mswells;
+    cl::Buffer *d_ms_Cvals = nullptr, *d_ms_Bvals = nullptr, *d_ms_cols = nullptr, *d_ms_rowPointers = nullptr;
+    cl::Buffer *d_ms_segPointers = nullptr, *d_ms_Dinv = nullptr, *d_ms_DinvPointers = nullptr;
+    cl::Buffer *d_ms_z1 = nullptr, *d_ms_z2 = nullptr;
 };
 
 } //namespace Opm
@@ -0,0 +1,143 @@
+/*
+  Copyright 2021 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_EXTRACT_PRESSURE_MATRIX_HEADER_INCLUDED
+#define OPM_EXTRACT_PRESSURE_MATRIX_HEADER_INCLUDED
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+namespace Opm
+{
+
+namespace Amg
+{
+    /// \brief Pressure matrix entry of a block given the weights of its row or column.
+    ///
+    /// Without transpose the conservation equations of a row are combined
+    /// using the row weights. With transpose the pressure equation is taken as
+    /// is and the unknowns are combined using the column weights.
+    template <bool transpose, class Block, class Weights>
+    double pressureMatrixEntry(const Block& block, const Weights& rowWeights, const Weights& colWeights,
+                               const int pressureVarIndex, const int blockSize)
+    {
+        double value = 0.0;
+        for (int i = 0; i < blockSize; ++i) {
+            if constexpr (transpose) {
+                value += block[pressureVarIndex][i] * colWeights[i];
+            } else {
+                value += block[i][pressureVarIndex] * rowWeights[i];
+            }
+        }
+        return value;
+    }
+
+    /// \brief Create a scalar matrix with the sparsity pattern of the blocked fine matrix.
+    template <class CoarseMatrix, class FineMatrix>
+    std::unique_ptr<CoarseMatrix> createPressureMatrixPattern(const FineMatrix& fineMatrix)
+    {
+        auto coarseMatrix = std::make_unique<CoarseMatrix>(fineMatrix.N(), fineMatrix.M(),
+                                                           fineMatrix.nonzeroes(), CoarseMatrix::row_wise);
+        auto createIter = coarseMatrix->createbegin();
+        for (const auto& row : fineMatrix) {
+            for (auto col = row.begin(), cend = row.end(); col != cend; ++col) {
+                createIter.insert(col.index());
+            }
+            ++createIter;
+        }
+        return coarseMatrix;
+    }
+
+    /// \brief Compute the entries of the pressure matrix from a BCRSMatrix.
+    ///
+    /// The coarse matrix must have the sparsity pattern of the fine one, as
+    /// created by createPressureMatrixPattern(). Rows are processed in parallel.
+    template <bool transpose, class FineMatrix, class Vector, class CoarseMatrix>
+    void calculatePressureMatrixEntries(const FineMatrix& fineMatrix, const Vector& weights,
+                                        const int pressureVarIndex, CoarseMatrix& coarseMatrix)
+    {
+        assert(fineMatrix.N() == coarseMatrix.N());
+        constexpr int blockSize = FineMatrix::block_type::rows;
+        const std::size_t numRows = fineMatrix.N();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (std::size_t row = 0; row < numRows; ++row) {
+            const auto& fineRow = fineMatrix[row];
+            auto& coarseRow = coarseMatrix[row];
+            auto entryCoarse = coarseRow.begin();
+            for (auto entry = fineRow.begin(), entryEnd = fineRow.end(); entry != entryEnd; ++entry, ++entryCoarse) {
+                assert(entry.index() == entryCoarse.index());
+                *entryCoarse = pressureMatrixEntry<transpose>(*entry, weights[row], weights[entry.index()],
+                                                              pressureVarIndex, blockSize);
+            }
+        }
+    }
+
+    /// \brief Compute the entries of the pressure matrix from a blocked CSR matrix.
+    ///
+    /// Blocks and weights are stored contiguously with blockSize x blockSize
+    /// (row major) and blockSize values, respectively. The values of the
+    /// pressure matrix are written in the order of the nonzero blocks, i.e.,
+    /// the pressure matrix shares rowPointers and colIndices with the fine matrix.
+    template <bool transpose>
+    void calculatePressureMatrixEntries(const int Nb, const int blockSize,
+                                        const int* rowPointers, const int* colIndices,
+                                        const double* blockValues, const double* weights,
+                                        const int pressureVarIndex, double* coarseValues)
+    {
+        // Thin row major view of one block.
+        struct BlockView
+        {
+            const double* data;
+            int size;
+            const double* operator[](int i) const { return data + i * size; }
+        };
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int row = 0; row < Nb; ++row) {
+            const double* rowWeights = weights + blockSize * row;
+            for (int idx = rowPointers[row]; idx < rowPointers[row + 1]; ++idx) {
+                const BlockView block{blockValues + idx * blockSize * blockSize, blockSize};
+                const double* colWeights = weights + blockSize * colIndices[idx];
+                coarseValues[idx] = pressureMatrixEntry<transpose>(block, rowWeights, colWeights,
+                                                                   pressureVarIndex, blockSize);
+            }
+        }
+    }
+
+    /// \brief Copy values stored in the nonzero order of a CSR matrix into a BCRSMatrix with the same pattern.
+    template <class CoarseMatrix>
+    void copyPressureMatrixEntries(const double* coarseValues, CoarseMatrix& coarseMatrix)
+    {
+        std::size_t idx = 0;
+        for (auto& row : coarseMatrix) {
+            for (auto& entry : row) {
+                entry = coarseValues[idx++];
+            }
+        }
+    }
+
+} // namespace Amg
+
+} // namespace Opm
+
+#endif // OPM_EXTRACT_PRESSURE_MATRIX_HEADER_INCLUDED
@@ -22,10 +22,18 @@
 
 #include <dune/common/fvector.hh>
 
+#include <opm/models/parallel/threadedentityiterator.hh>
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <exception>
+#include <type_traits>
 
 namespace Opm
 {
@@ -51,30 +59,35 @@ namespace Amg
     {
         using VectorBlockType = typename Vector::block_type;
         using MatrixBlockType = typename Matrix::block_type;
+        constexpr int numEq = MatrixBlockType::rows;
         const Matrix& A = matrix;
         VectorBlockType rhs(0.0);
         rhs[pressureVarIndex] = 1.0;
-        const auto endi = A.end();
-        for (auto i = A.begin(); i != endi; ++i) {
-            const auto endj = (*i).end();
+        const std::size_t numRows = A.N();
+        // Rows are independent. The diagonal block is found by binary
+        // search and copied (transposed if needed) into a local block, for
+        // which the solve of the fixed size block is fully unrolled.
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (std::size_t row = 0; row < numRows; ++row) {
+            const auto diag = A[row].find(row);
             MatrixBlockType diag_block(0.0);
-            for (auto j = (*i).begin(); j != endj; ++j) {
-                if (i.index() == j.index()) {
-                    diag_block = (*j);
-                    break;
+            if (diag != A[row].end()) {
+                if (transpose) {
+                    diag_block = *diag;
+                } else {
+                    for (int ii = 0; ii < numEq; ++ii)
+                        for (int jj = 0; jj < numEq; ++jj)
+                            diag_block[jj][ii] = (*diag)[ii][jj];
                 }
             }
             VectorBlockType bweights;
-            if (transpose) {
-                diag_block.solve(bweights, rhs);
-            } else {
-                auto diag_block_transpose = Details::transposeDenseMatrix(diag_block);
-                diag_block_transpose.solve(bweights, rhs);
-            }
+            diag_block.solve(bweights, rhs);
             double abs_max = *std::max_element(
                 bweights.begin(), bweights.end(), [](double a, double b) { return std::fabs(a) < std::fabs(b); });
             bweights /= std::fabs(abs_max);
-            weights[i.index()] = bweights;
+            weights[row] = bweights;
         }
         // return weights;
     }
@@ -87,48 +100,77 @@ namespace Amg
         return weights;
     }
 
-    template<class Vector, class GridView, class ElementContext, class Model>
-    void getTrueImpesWeights(int pressureVarIndex, Vector& weights, const GridView& gridView,
-                             ElementContext& elemCtx, const Model& model, std::size_t threadId)
+    /// Compute true IMPES weights from the storage terms of the local residual.
+    ///
+    /// The elements are distributed over the threads with one element context
+    /// per thread. Cached intensive quantities of the last linearization are
+    /// used by the element contexts if the model keeps them, hence only the
+    /// storage term itself is evaluated here.
+    template<class ElementContext, class Vector, class Simulator>
+    void getTrueImpesWeights(int pressureVarIndex, Vector& weights, const Simulator& simulator)
     {
         using VectorBlockType = typename Vector::block_type;
+        const auto& model = simulator.model();
+        const auto& gridView = simulator.gridView();
+        using GridView = std::decay_t<decltype(gridView)>;
         using Matrix = typename std::decay_t<decltype(model.linearizer().jacobian())>;
         using MatrixBlockType = typename Matrix::MatrixBlock;
         constexpr int numEq = VectorBlockType::size();
-        using Evaluation = typename std::decay_t<decltype(model.localLinearizer(threadId).localResidual().residual(0))>
+        using Evaluation = typename std::decay_t<decltype(model.localLinearizer(0).localResidual().residual(0))>
             ::block_type;
         VectorBlockType rhs(0.0);
         rhs[pressureVarIndex] = 1.0;
-        int index = 0;
-        auto elemIt = gridView.template begin</*codim=*/0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/0>();
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView);
+        std::exception_ptr exceptionPtr = nullptr;
         OPM_BEGIN_PARALLEL_TRY_CATCH();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            elemCtx.updatePrimaryStencil(*elemIt);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            Dune::FieldVector<Evaluation, numEq> storage;
-            model.localLinearizer(threadId).localResidual().computeStorage(storage,elemCtx,/*spaceIdx=*/0, /*timeIdx=*/0);
-            auto extrusionFactor = elemCtx.intensiveQuantities(0, /*timeIdx=*/0).extrusionFactor();
-            auto scvVolume = elemCtx.stencil(/*timeIdx=*/0).subControlVolume(0).volume() * extrusionFactor;
-            auto storage_scale = scvVolume / elemCtx.simulator().timeStepSize();
-            MatrixBlockType block;
-            double pressure_scale = 50e5;
-            for (int ii = 0; ii < numEq; ++ii) {
-                for (int jj = 0; jj < numEq; ++jj) {
-                    block[ii][jj] = storage[ii].derivative(jj)/storage_scale;
-                    if (jj == pressureVarIndex) {
-                        block[ii][jj] *= pressure_scale;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ElementContext elemCtx(simulator);
+#ifdef _OPENMP
+            const unsigned threadId = omp_get_thread_num();
+#else
+            const unsigned threadId = 0;
+#endif
+            auto elemIt = threadedElemIt.beginParallel();
+            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                try {
+                    elemCtx.updatePrimaryStencil(*elemIt);
+                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                    Dune::FieldVector<Evaluation, numEq> storage;
+                    model.localLinearizer(threadId).localResidual().computeStorage(storage,elemCtx,/*spaceIdx=*/0, /*timeIdx=*/0);
+                    auto extrusionFactor = elemCtx.intensiveQuantities(0, /*timeIdx=*/0).extrusionFactor();
+                    auto scvVolume = elemCtx.stencil(/*timeIdx=*/0).subControlVolume(0).volume() * extrusionFactor;
+                    auto storage_scale = scvVolume / elemCtx.simulator().timeStepSize();
+                    MatrixBlockType block_transpose;
+                    double pressure_scale = 50e5;
+                    for (int ii = 0; ii < numEq; ++ii) {
+                        for (int jj = 0; jj < numEq; ++jj) {
+                            block_transpose[jj][ii] = storage[ii].derivative(jj)/storage_scale;
+                            if (jj == pressureVarIndex) {
+                                block_transpose[jj][ii] *= pressure_scale;
+                            }
+                        }
                     }
+                    VectorBlockType bweights;
+                    block_transpose.solve(bweights, rhs);
+                    bweights /= 1000.0; // given normal densities this scales weights to about 1.
+                    weights[elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0)] = bweights;
+                }
+                catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                    exceptionPtr = std::current_exception();
+                    threadedElemIt.setFinished();
                 }
             }
-            VectorBlockType bweights;
-            MatrixBlockType block_transpose = Details::transposeDenseMatrix(block);
-            block_transpose.solve(bweights, rhs);
-            bweights /= 1000.0; // given normal densities this scales weights to about 1.
-            weights[index] = bweights;
-            ++index;
         }
-        OPM_END_PARALLEL_TRY_CATCH("getTrueImpesWeights() failed: ", elemCtx.simulator().vanguard().grid().comm());
+        if (exceptionPtr) {
+            std::rethrow_exception(exceptionPtr);
+        }
+        OPM_END_PARALLEL_TRY_CATCH("getTrueImpesWeights() failed: ", simulator.vanguard().grid().comm());
     }
 } // namespace Amg
 
@@ -58,8 +58,15 @@ setupPropertyTree(FlowLinearSolverParameters p, // Note: copying the parameters
 #endif
     }
 
+    const auto withFallbacks = [&p](PropertyTree prm) {
+        if (p.linear_solver_fallback_) {
+            addFallbackSolvers(prm, p);
+        }
+        return prm;
+    };
+
     // Use CPR configuration.
-    if ((conf == "cpr") || (conf == "cpr_trueimpes") || (conf == "cpr_quasiimpes")) {
+    if ((conf == "cpr") || (conf == "cpr_trueimpes") || (conf == "cpr_quasiimpes") || (conf == "cpr_msrsb")) {
         if (conf == "cpr") {
             // Treat "cpr" as short cut for the true IMPES variant.
             conf = "cpr_trueimpes";
@@ -72,27 +79,37 @@ setupPropertyTree(FlowLinearSolverParameters p, // Note: copying the parameters
             // Use our own default unless it was explicitly overridden by user.
             p.cpr_max_ell_iter_ = 1;
         }
-        return setupCPR(conf, p);
+        return withFallbacks(setupCPR(conf, p));
     }
 
     if (conf == "amg") {
-        return setupAMG(conf, p);
+        return withFallbacks(setupAMG(conf, p));
     }
 
     // Use ILU0 configuration.
     if (conf == "ilu0") {
-        return setupILU(conf, p);
+        return withFallbacks(setupILU(conf, p));
+    }
+
+    // The openclSolver chooses its own preconditioner, ILU0 is used on the CPU.
+    if (conf == "autotune") {
+        return withFallbacks(setupILU("ilu0", p));
     }
 
     // Same configuration as ILU0.
     if (conf == "isai") {
-        return setupISAI(conf, p);
+        return withFallbacks(setupISAI(conf, p));
+    }
+
+    // Restricted additive Schwarz with ILU(n) subdomain solves.
+    if (conf == "ras") {
+        return withFallbacks(setupRAS(conf, p));
     }
 
     // No valid configuration option found.
     OPM_THROW(std::invalid_argument,
               conf << " is not a valid setting for --linear-solver-configuration."
-              << " Please use ilu0, cpr, cpr_trueimpes, cpr_quasiimpes or isai");
+              << " Please use ilu0, cpr, cpr_trueimpes, cpr_quasiimpes, cpr_msrsb, isai, ras or autotune");
 }
 
 PropertyTree
@@ -104,6 +121,7 @@ setupCPR(const std::string& conf, const FlowLinearSolverParameters& p)
     prm.put("tol", p.linear_solver_reduction_);
     prm.put("verbosity", p.linear_solver_verbosity_);
     prm.put("solver", "bicgstab"s);
+    prm.put("recycle", p.linear_solver_recycle_);
     prm.put("preconditioner.type", "cpr"s);
     if (conf == "cpr_quasiimpes") {
         prm.put("preconditioner.weight_type", "quasiimpes"s);
@@ -112,11 +130,22 @@ setupCPR(const std::string& conf, const FlowLinearSolverParameters& p)
     }
     prm.put("preconditioner.finesmoother.type", "ParOverILU0"s);
     prm.put("preconditioner.finesmoother.relaxation", 1.0);
+    prm.put("preconditioner.finesmoother.reorder_rcm", p.ilu_reorder_rcm_);
     prm.put("preconditioner.verbosity", 0);
     prm.put("preconditioner.coarsesolver.maxiter", 1);
     prm.put("preconditioner.coarsesolver.tol", 1e-1);
     prm.put("preconditioner.coarsesolver.solver", "loopsolver"s);
     prm.put("preconditioner.coarsesolver.verbosity", 0);
+    if (conf == "cpr_msrsb") {
+        // Multiscale pressure solve for screening runs, sequential only.
+        prm.put("preconditioner.coarsesolver.preconditioner.type", "msrsb"s);
+        prm.put("preconditioner.coarsesolver.preconditioner.coarse_size", 64);
+        prm.put("preconditioner.coarsesolver.preconditioner.basis_iterations", 50);
+        prm.put("preconditioner.coarsesolver.preconditioner.basis_tolerance", 1e-3);
+        prm.put("preconditioner.coarsesolver.preconditioner.pre_smooth", 1);
+        prm.put("preconditioner.coarsesolver.preconditioner.post_smooth", 1);
+        return prm;
+    }
     prm.put("preconditioner.coarsesolver.preconditioner.type", "amg"s);
     prm.put("preconditioner.coarsesolver.preconditioner.alpha", 0.333333333333);
     prm.put("preconditioner.coarsesolver.preconditioner.relaxation", 1.0);
@@ -138,6 +167,7 @@ setupCPR(const std::string& conf, const FlowLinearSolverParameters& p)
     prm.put("preconditioner.coarsesolver.preconditioner.maxconnectivity", 15);
     prm.put("preconditioner.coarsesolver.preconditioner.maxaggsize", 6);
     prm.put("preconditioner.coarsesolver.preconditioner.minaggsize", 4);
+    prm.put("preconditioner.coarsesolver.preconditioner.redundant_coarse_solve", p.cpr_redundant_coarse_solve_);
     return prm;
 }
 
@@ -151,6 +181,7 @@ setupAMG([[maybe_unused]] const std::string& conf, const FlowLinearSolverParamet
     prm.put("maxiter", p.linear_solver_maxiter_);
     prm.put("verbosity", p.linear_solver_verbosity_);
     prm.put("solver", "bicgstab"s);
+    prm.put("recycle", p.linear_solver_recycle_);
     prm.put("preconditioner.type", "amg"s);
     prm.put("preconditioner.alpha", 0.333333333333);
     prm.put("preconditioner.relaxation", 1.0);
@@ -185,9 +216,11 @@ setupILU([[maybe_unused]] const std::string& conf, const FlowLinearSolverParamet
     prm.put("maxiter", p.linear_solver_maxiter_);
     prm.put("verbosity", p.linear_solver_verbosity_);
     prm.put("solver", "bicgstab"s);
+    prm.put("recycle", p.linear_solver_recycle_);
     prm.put("preconditioner.type", "ParOverILU0"s);
     prm.put("preconditioner.relaxation", p.ilu_relaxation_);
     prm.put("preconditioner.ilulevel", p.ilu_fillin_level_);
+    prm.put("preconditioner.reorder_rcm", p.ilu_reorder_rcm_);
     return prm;
 }
 
@@ -201,6 +234,7 @@ setupISAI([[maybe_unused]] const std::string& conf, const FlowLinearSolverParame
     prm.put("maxiter", p.linear_solver_maxiter_);
     prm.put("verbosity", p.linear_solver_verbosity_);
     prm.put("solver", "bicgstab"s);
+    prm.put("recycle", p.linear_solver_recycle_);
     prm.put("preconditioner.type", "ParOverILU0"s);
     prm.put("preconditioner.relaxation", p.ilu_relaxation_);
     prm.put("preconditioner.ilulevel", p.ilu_fillin_level_);
@@ -208,4 +242,55 @@ setupISAI([[maybe_unused]] const std::string& conf, const FlowLinearSolverParame
 }
 
 
+PropertyTree
+setupRAS([[maybe_unused]] const std::string& conf, const FlowLinearSolverParameters& p)
+{
+    using namespace std::string_literals;
+    PropertyTree prm;
+    prm.put("tol", p.linear_solver_reduction_);
+    prm.put("maxiter", p.linear_solver_maxiter_);
+    prm.put("verbosity", p.linear_solver_verbosity_);
+    prm.put("solver", "bicgstab"s);
+    prm.put("recycle", p.linear_solver_recycle_);
+    prm.put("preconditioner.type", "RAS"s);
+    prm.put("preconditioner.local_solver", "ilu"s);
+    prm.put("preconditioner.relaxation", p.ilu_relaxation_);
+    prm.put("preconditioner.ilulevel", p.ilu_fillin_level_);
+    return prm;
+}
+
+
+/// Add the configurations ISTLSolverEbos tries in turn when a linear solve
+/// with prm fails, as the children "fallback.1", "fallback.2", ... of prm:
+/// prm with one more level of ILU fill-in and four times the iterations,
+/// the same with GMRES and a larger restart, and if available a direct
+/// solver, which is only used for small sequential systems.
+void addFallbackSolvers(PropertyTree& prm, const FlowLinearSolverParameters& p)
+{
+    using namespace std::string_literals;
+    PropertyTree stronger(prm);
+    stronger.put("maxiter", 4 * prm.get<int>("maxiter"));
+    stronger.put("recycle", 0);
+    const auto precType = prm.get<std::string>("preconditioner.type");
+    if (precType == "cpr") {
+        stronger.put("preconditioner.finesmoother.ilulevel", 1);
+    } else if (precType == "ParOverILU0" || precType == "RAS") {
+        stronger.put("preconditioner.ilulevel", p.ilu_fillin_level_ + 1);
+    }
+    prm.put_child("fallback.1", stronger);
+
+    PropertyTree gmres(stronger);
+    gmres.put("solver", "gmres"s);
+    gmres.put("restart", 2 * p.linear_solver_restart_);
+    prm.put_child("fallback.2", gmres);
+
+#if HAVE_SUITESPARSE_UMFPACK
+    PropertyTree direct;
+    direct.put("solver", "umfpack"s);
+    direct.put("verbosity", p.linear_solver_verbosity_);
+    direct.put("max_rows", 50000);
+    prm.put_child("fallback.3", direct);
+#endif
+}
+
 } // namespace Opm
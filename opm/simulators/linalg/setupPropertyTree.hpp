@@ -36,6 +36,9 @@ PropertyTree setupCPR(const std::string& conf, const FlowLinearSolverParameters&
 PropertyTree setupAMG(const std::string& conf, const FlowLinearSolverParameters& p);
 PropertyTree setupILU(const std::string& conf, const FlowLinearSolverParameters& p);
 PropertyTree setupISAI(const std::string& conf, const FlowLinearSolverParameters& p);
+PropertyTree setupRAS(const std::string& conf, const FlowLinearSolverParameters& p);
+
+void addFallbackSolvers(PropertyTree& prm, const FlowLinearSolverParameters& p);
 
 } // namespace Opm
 
@@ -419,7 +419,7 @@ public:
                                                  CoarseOperatorType>& policy,
                     CoarseLevelSolverPolicy& coarsePolicy,
                     std::size_t preSteps=1, std::size_t postSteps=1)
-    : operator_(&op), smoother_(smoother),
+    : operator_(&op), residualOperator_(&op), smoother_(smoother),
       preSteps_(preSteps), postSteps_(postSteps)
   {
     policy_ = policy.clone();
@@ -428,7 +428,8 @@ public:
   }
 
   TwoLevelMethodCpr(const TwoLevelMethodCpr& other)
-  : operator_(other.operator_), coarseSolver_(new CoarseLevelSolver(*other.coarseSolver_)),
+  : operator_(other.operator_), residualOperator_(other.residualOperator_),
+    coarseSolver_(new CoarseLevelSolver(*other.coarseSolver_)),
     smoother_(other.smoother_), policy_(other.policy_->clone()),
     preSteps_(other.preSteps_), postSteps_(other.postSteps_)
   {}
@@ -440,6 +441,17 @@ public:
     delete coarseSolver_;
   }
 
+  /**
+   * @brief Set the operator used to update the residual after smoothing.
+   *
+   * It has to approximate the fine level operator, e.g. by a copy of its
+   * matrix in lower precision. The fine level operator is used if op is null.
+   */
+  void setResidualOperator(const LinearOperator<FineDomainType,FineRangeType>* op)
+  {
+    residualOperator_ = op ? op : operator_;
+  }
+
   void updatePreconditioner(FineOperatorType& /* op */,
                             std::shared_ptr<SmootherType> smoother,
                             CoarseLevelSolverPolicy& coarsePolicy)
@@ -484,7 +496,7 @@ public:
     context.update=&v;
     context.smoother=smoother_;
     context.rhs=&rhs;
-    context.matrix=operator_;
+    context.matrix=residualOperator_;
     // Presmoothing
     presmooth(context, preSteps_);
     //Coarse grid correction
@@ -535,9 +547,11 @@ private:
      *
      * Needed to update the residual.
      */
-    const FineOperatorType* matrix;
+    const LinearOperator<FineDomainType,FineRangeType>* matrix;
   };
   const FineOperatorType* operator_;
+  /** @brief The operator used to update the residual after smoothing. */
+  const LinearOperator<FineDomainType,FineRangeType>* residualOperator_;
   /** @brief The coarse level solver. */
   CoarseLevelSolver* coarseSolver_;
   /** @brief The fine level smoother. */
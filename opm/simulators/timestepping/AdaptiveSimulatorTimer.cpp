@@ -18,6 +18,7 @@
 */
 
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -63,6 +64,10 @@ AdaptiveSimulatorTimer& AdaptiveSimulatorTimer::operator++ ()
         ++current_step_;
         current_time_ += dt_;
         assert(dt_ > 0);
+        // do not leave a remainder of the report step due to rounding
+        if( total_time_ - current_time_ < 1e-10 * dt_ ) {
+            current_time_ = std::max( current_time_, total_time_ );
+        }
         // store used time step sizes
         steps_.push_back( dt_ );
         return *this;
@@ -76,26 +81,15 @@ AdaptiveSimulatorTimer& AdaptiveSimulatorTimer::operator++ ()
         dt_ = std::min( dt_estimate, max_time_step_ );
         assert(dt_ > 0);
         if( remaining > 0 ) {
-
-            // set new time step (depending on remaining time)
-            if( 1.05 * dt_ > remaining ) {
-                dt_ = remaining;
-                // check max time step again and use half remaining if too large
-                if( dt_ > max_time_step_ ) {
-                    dt_ = 0.5 * remaining;
-                }
-                assert(dt_ > 0);
-                return;
-            }
-
-            // check for half interval step to avoid very small step at the end
-            // remaining *= 0.5;
-
-            if( 1.5 * dt_ > remaining ) {
-                dt_ = 0.5 * remaining;
-                assert(dt_ > 0);
-                return;
-            }
+            // Spread the remaining time evenly over the number of steps it
+            // takes with the estimated step size, which may be exceeded by 5%
+            // but not beyond the max time step. This avoids a short last step
+            // to hit the end of the report step, which costs as many Newton
+            // iterations as a full one.
+            const double longest = std::min( 1.05 * dt_, max_time_step_ );
+            const double numSteps = std::ceil( remaining / longest );
+            dt_ = remaining / numSteps;
+            assert(dt_ > 0);
         }
     }
 
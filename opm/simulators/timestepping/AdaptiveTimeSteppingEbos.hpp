@@ -3,8 +3,11 @@
 #ifndef OPM_ADAPTIVE_TIME_STEPPING_EBOS_HPP
 #define OPM_ADAPTIVE_TIME_STEPPING_EBOS_HPP
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
 #include <opm/grid/utility/StopWatch.hpp>
@@ -341,7 +344,7 @@ namespace Opm {
             EWOMS_REGISTER_PARAM(TypeTag, double, TimeStepAfterEventInDays,
                                  "Time step size of the first time step after an event occurs during the simulation in days");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, TimeStepControl,
-                                 "The algorithm used to determine time-step sizes. valid options are: 'pid' (default), 'pid+iteration', 'pid+newtoniteration', 'iterationcount', 'newtoniterationcount' and 'hardcoded'");
+                                 "The algorithm used to determine time-step sizes. valid options are: 'pid' (default), 'pid+iteration', 'pid+newtoniteration', 'iterationcount', 'newtoniterationcount', 'convergencerate' and 'hardcoded'");
             EWOMS_REGISTER_PARAM(TypeTag, double, TimeStepControlTolerance,
                                  "The tolerance used by the time step size control algorithm");
             EWOMS_REGISTER_PARAM(TypeTag, int, TimeStepControlTargetIterations,
@@ -460,6 +463,9 @@ namespace Opm {
                 ebosSimulator.problem().setSubStepReport(substepReport);
 
                 report += substepReport;
+                if (substepCallback_) {
+                    substepCallback_(substepReport);
+                }
 
                 bool continue_on_uncoverged_solution = ignoreConvergenceFailure_ && !substepReport.converged && dt <= minTimeStep_;
 
@@ -484,6 +490,8 @@ namespace Opm {
                     // compute new time step estimate
                     const int iterations = useNewtonIteration_ ? substepReport.total_newton_iterations
                         : substepReport.total_linear_iterations;
+                    // largest residual norm of each nonlinear iteration
+                    timeStepControl_->setNonlinearResiduals(solver.model().residualNormsHistory().maxNorms());
                     double dtEstimate = timeStepControl_->computeTimeStepSize(dt, iterations, relativeChange,
                                                                                substepTimer.simulationTimeElapsed());
 
@@ -548,6 +556,8 @@ namespace Opm {
                         OPM_THROW_NOLOG(NumericalIssue, msg);
                     }
 
+                    timeStepControl_->timeStepFailed(dt);
+
                     // The new, chopped timestep.
                     const double newTimeStep = restartFactor_ * dt;
 
@@ -572,6 +582,10 @@ namespace Opm {
                             msg = causeOfFailure + "\nTimestep chopped to "
                                 + std::to_string(unit::convert::to(substepTimer.currentStepLength(), unit::day)) + " days\n";
                             OpmLog::problem(msg);
+                            const auto [cnvCells, cnvPvFraction] = solver.model().cnvViolations();
+                            OpmLog::debug("CNV was violated in " + std::to_string(cnvCells)
+                                          + " cells holding " + std::to_string(100.0 * cnvPvFraction)
+                                          + "% of the pore volume at the last iteration of the failed step");
                         }
                         ++restarts;
                     };
@@ -642,6 +656,11 @@ namespace Opm {
         void setSuggestedNextStep(const double x)
         { suggestedNextTimestep_ = x; }
 
+        /// Function called with the report of every substep, also of the
+        /// failed ones, after it is added to the report of the report step.
+        void setSubstepCallback(std::function<void(const SimulatorReportSingle&)> callback)
+        { substepCallback_ = std::move(callback); }
+
         void updateTUNING(double max_next_tstep, const Tuning& tuning)
         {
             restartFactor_ = tuning.TSFCNV;
@@ -693,6 +712,13 @@ namespace Opm {
                 timeStepControl_ = TimeStepControlType(new SimpleIterationCountTimeStepControl(iterations, decayrate, growthrate));
                 useNewtonIteration_ = true;
             }
+            else if (control == "convergencerate") {
+                const int iterations =  EWOMS_GET_PARAM(TypeTag, int, TimeStepControlTargetNewtonIterations); // 8
+                const double decayrate = EWOMS_GET_PARAM(TypeTag, double, TimeStepControlDecayRate); // 0.75
+                const double growthrate = EWOMS_GET_PARAM(TypeTag, double, TimeStepControlGrowthRate); // 1.25
+                timeStepControl_ = TimeStepControlType(new ConvergenceRateTimeStepControl(iterations, decayrate, growthrate));
+                useNewtonIteration_ = true;
+            }
             else if (control == "hardcoded") {
                 const std::string filename = EWOMS_GET_PARAM(TypeTag, std::string, TimeStepControlFileName); // "timesteps"
                 timeStepControl_ = TimeStepControlType(new HardcodedTimeStepControl(filename));
@@ -774,6 +800,7 @@ namespace Opm {
         double timestepAfterEvent_;         //!< suggested size of timestep after an event
         bool useNewtonIteration_;           //!< use newton iteration count for adaptive time step control
         double minTimeStepBeforeShuttingProblematicWells_; //! < shut problematic wells when time step size in days are less than this
+        std::function<void(const SimulatorReportSingle&)> substepCallback_; //!< called after every substep
     };
 }
 
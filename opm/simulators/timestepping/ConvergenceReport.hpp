@@ -79,6 +79,27 @@ namespace Opm
             int phase_;
             std::string well_name_;
         };
+        /// A cell with one of the largest CNV errors of an equation.
+        class WorstCell
+        {
+        public:
+            WorstCell(int phase, int cell, int rank, double value)
+                : phase_(phase), cell_(cell), rank_(rank), value_(value)
+            {
+            }
+            int phase() const { return phase_; }
+            /// Cartesian index of the cell.
+            int cell() const { return cell_; }
+            /// Process owning the cell.
+            int rank() const { return rank_; }
+            /// The CNV error of the equation in the cell.
+            double value() const { return value_; }
+        private:
+            int phase_;
+            int cell_;
+            int rank_;
+            double value_;
+        };
 
         // ----------- Mutating member functions -----------
 
@@ -87,6 +108,9 @@ namespace Opm
             , res_failures_{}
             , well_failures_{}
             , groupConverged_(true)
+            , switched_cells_(0)
+            , frozen_cells_(0)
+            , worst_cells_{}
         {
         }
 
@@ -96,6 +120,9 @@ namespace Opm
             res_failures_.clear();
             well_failures_.clear();
             groupConverged_ = true;
+            switched_cells_ = 0;
+            frozen_cells_ = 0;
+            worst_cells_.clear();
         }
 
         void setReservoirFailed(const ReservoirFailure& rf)
@@ -115,11 +142,29 @@ namespace Opm
             groupConverged_ = groupConverged;
         }
 
+        /// Set the number of cells whose primary variables changed meaning in
+        /// the last update, and of those kept from changing it again.
+        void setPrimaryVariableSwitches(const long int switched, const long int frozen)
+        {
+            switched_cells_ = switched;
+            frozen_cells_ = frozen;
+        }
+
+        /// Set the cells with the largest CNV errors, ordered by equation
+        /// and by decreasing error.
+        void setWorstCells(const std::vector<WorstCell>& worst)
+        {
+            worst_cells_ = worst;
+        }
+
         ConvergenceReport& operator+=(const ConvergenceReport& other)
         {
             status_ = static_cast<Status>(status_ | other.status_);
             res_failures_.insert(res_failures_.end(), other.res_failures_.begin(), other.res_failures_.end());
             well_failures_.insert(well_failures_.end(), other.well_failures_.begin(), other.well_failures_.end());
+            switched_cells_ += other.switched_cells_;
+            frozen_cells_ += other.frozen_cells_;
+            worst_cells_.insert(worst_cells_.end(), other.worst_cells_.begin(), other.worst_cells_.end());
             assert(reservoirFailed() != res_failures_.empty());
             assert(wellFailed() != well_failures_.empty());
             return *this;
@@ -152,6 +197,21 @@ namespace Opm
             return well_failures_;
         }
 
+        long int numSwitchedCells() const
+        {
+            return switched_cells_;
+        }
+
+        long int numFrozenCells() const
+        {
+            return frozen_cells_;
+        }
+
+        const std::vector<WorstCell>& worstCells() const
+        {
+            return worst_cells_;
+        }
+
         Severity severityOfWorstFailure() const
         {
             // A function to get the worst of two severities.
@@ -175,6 +235,9 @@ namespace Opm
         std::vector<ReservoirFailure> res_failures_;
         std::vector<WellFailure> well_failures_;
         bool groupConverged_;
+        long int switched_cells_;
+        long int frozen_cells_;
+        std::vector<WorstCell> worst_cells_;
     };
 
 } // namespace Opm
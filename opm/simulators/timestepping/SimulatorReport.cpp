@@ -195,6 +195,45 @@ namespace Opm
         os << std::endl;
     }
 
+    const std::array<const char*, 8> SimulatorReportSingle::timingNames {
+        "solver_time", "assemble_time", "assemble_time_well", "linear_solve_setup_time",
+        "linear_solve_time", "update_time", "pre_post_time", "output_write_time"
+    };
+
+    SimulatorReportSingle::Timings SimulatorReportSingle::timings() const
+    {
+        return {solver_time, assemble_time, assemble_time_well, linear_solve_setup_time,
+                linear_solve_time, update_time, pre_post_time, output_write_time};
+    }
+
+    void SimulatorReportSingle::reportJson(std::ostream& os,
+                                           const Timings& min,
+                                           const Timings& max,
+                                           const Timings& mean,
+                                           const std::vector<ConvergenceReport::WorstCell>& worstCells) const
+    {
+        os << fmt::format("{{\"time\": {:.10g}, \"timestep_length\": {:.10g}, \"converged\": {}",
+                          global_time, timestep_length, converged ? "true" : "false");
+        os << fmt::format(", \"well_iterations\": {}, \"linearizations\": {}"
+                          ", \"newton_iterations\": {}, \"linear_iterations\": {}",
+                          total_well_iterations, total_linearizations,
+                          total_newton_iterations, total_linear_iterations);
+        for (std::size_t i = 0; i < timingNames.size(); ++i) {
+            os << fmt::format(", \"{}\": {{\"min\": {:.6g}, \"max\": {:.6g}, \"mean\": {:.6g}}}",
+                              timingNames[i], min[i], max[i], mean[i]);
+        }
+        if (!worstCells.empty()) {
+            os << ", \"worst_cells\": [";
+            for (std::size_t i = 0; i < worstCells.size(); ++i) {
+                const auto& wc = worstCells[i];
+                os << fmt::format("{}{{\"eq\": {}, \"cell\": {}, \"rank\": {}, \"cnv\": {:.6g}}}",
+                                  i > 0 ? ", " : "", wc.phase(), wc.cell(), wc.rank(), wc.value());
+            }
+            os << "]";
+        }
+        os << "}\n";
+    }
+
     void SimulatorReport::operator+=(const SimulatorReportSingle& sr)
     {
         if (sr.converged) {
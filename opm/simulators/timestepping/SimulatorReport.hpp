@@ -19,6 +19,9 @@
 
 #ifndef OPM_SIMULATORREPORT_HEADER_INCLUDED
 #define OPM_SIMULATORREPORT_HEADER_INCLUDED
+#include <opm/simulators/timestepping/ConvergenceReport.hpp>
+
+#include <array>
 #include <cassert>
 #include <iosfwd>
 #include <vector>
@@ -63,6 +66,16 @@ namespace Opm
         void reportStep(std::ostringstream& os) const;
         /// Print a report suitable for the end of a fully implicit case, leaving out the pressure/transport time.
         void reportFullyImplicit(std::ostream& os, const SimulatorReportSingle* failedReport = nullptr) const;
+
+        /// The times of the step that may differ between processes, in the order of timingNames.
+        using Timings = std::array<double, 8>;
+        static const std::array<const char*, 8> timingNames;
+        Timings timings() const;
+        /// Print the step as a JSON object on a single line, with the minimum,
+        /// maximum and mean of its timings over the processes, and the cells
+        /// with the largest CNV errors in its last nonlinear iteration.
+        void reportJson(std::ostream& os, const Timings& min, const Timings& max, const Timings& mean,
+                        const std::vector<ConvergenceReport::WorstCell>& worstCells = {}) const;
     };
 
     struct SimulatorReport
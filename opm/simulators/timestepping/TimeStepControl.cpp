@@ -78,6 +78,80 @@ namespace Opm
         return dtEstimate;
     }
 
+    ////////////////////////////////////////////////////////
+    //
+    //  ConvergenceRateTimeStepControl Implementation
+    //
+    ////////////////////////////////////////////////////////
+
+    ConvergenceRateTimeStepControl::
+    ConvergenceRateTimeStepControl( const int target_iterations,
+                                    const double decayrate,
+                                    const double growthrate,
+                                    const bool verbose)
+        : target_iterations_( target_iterations )
+        , decayrate_( decayrate )
+        , growthrate_( growthrate )
+        , verbose_( verbose )
+    {
+        if( decayrate_  > 1.0 ) {
+            OPM_THROW(std::runtime_error,"ConvergenceRateTimeStepControl: decay should be <= 1 " << decayrate_ );
+        }
+        if( growthrate_ < 1.0 ) {
+            OPM_THROW(std::runtime_error,"ConvergenceRateTimeStepControl: growth should be >= 1 " << growthrate_ );
+        }
+    }
+
+    void ConvergenceRateTimeStepControl::
+    setNonlinearResiduals( const std::vector<double>& residuals )
+    {
+        residuals_ = residuals;
+    }
+
+    void ConvergenceRateTimeStepControl::
+    timeStepFailed( const double dt )
+    {
+        failed_dt_ = (failed_dt_ > 0.0) ? std::min(failed_dt_, dt) : dt;
+    }
+
+    double ConvergenceRateTimeStepControl::
+    computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& /* relativeChange */, const double /*simulationTimeElapsed */) const
+    {
+        double factor = 1.0;
+        const int num_iterations = static_cast<int>(residuals_.size()) - 1;
+        const bool have_rate = num_iterations > 0 && residuals_.front() > 0.0 && residuals_.back() > 0.0
+            && std::isfinite(residuals_.front()) && std::isfinite(residuals_.back());
+        if (have_rate) {
+            // average contraction factor of the iterations of the last step
+            const double rho = std::pow(residuals_.back() / residuals_.front(), 1.0 / num_iterations);
+            if (rho < 1.0) {
+                factor = std::pow(rho, num_iterations - target_iterations_);
+            } else {
+                // the residual did not decrease, no rate to base the estimate on
+                factor = decayrate_;
+            }
+        } else if (iterations > target_iterations_) {
+            factor = decayrate_;
+        } else if (iterations < target_iterations_ - 1) {
+            factor = growthrate_;
+        }
+        factor = std::clamp(factor, decayrate_, growthrate_);
+        double dtEstimate = dt * factor;
+
+        // stay below the size of the last failed step until it is outgrown
+        if (failed_dt_ > 0.0) {
+            dtEstimate = std::min(dtEstimate, failed_dt_);
+            failed_dt_ *= growthrate_;
+            if (failed_dt_ > growthrate_ * dtEstimate) {
+                failed_dt_ = 0.0;
+            }
+        }
+
+        if( verbose_ )
+            std::cout << "Computed step size (convergence rate): " << unit::convert::to( dtEstimate, unit::day ) << " (days)" << std::endl;
+        return dtEstimate;
+    }
+
     ////////////////////////////////////////////////////////
     //
     //  HardcodedTimeStepControl Implementation
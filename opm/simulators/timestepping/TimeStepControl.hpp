@@ -121,6 +121,49 @@ namespace Opm
         const double  minTimeStepBasedOnIterations_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    ///
+    ///  Adaptive time step control based on the convergence rate of the nonlinear solver.
+    ///
+    ///  The residual of the first nonlinear iteration is assumed to be proportional to the
+    ///  time step size, and each iteration to reduce it by the average contraction factor
+    ///  rho of the last time step. A step that took n iterations then allows the size
+    ///  dt * rho^(n - target_iterations) for the next one. After a time step had to be
+    ///  chopped, the estimates are kept below the failed size, which is relaxed by the
+    ///  growth rate for every successful step.
+    //
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class ConvergenceRateTimeStepControl : public TimeStepControlInterface
+    {
+    public:
+        /// \brief constructor
+        /// \param target_iterations  number of desired nonlinear iterations per time step
+        //  \param decayrate          largest decrease of the time step in one step (should be <= 1)
+        //  \param growthrate         largest increase of the time step in one step (should be >= 1)
+        /// \param verbose            if true get some output (default = false)
+        ConvergenceRateTimeStepControl( const int target_iterations,
+                                        const double decayrate,
+                                        const double growthrate,
+                                        const bool verbose = false);
+
+        /// \brief \copydoc TimeStepControlInterface::computeTimeStepSize
+        double computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& /* relativeChange */, const double /*simulationTimeElapsed */ ) const override;
+
+        /// \brief \copydoc TimeStepControlInterface::setNonlinearResiduals
+        void setNonlinearResiduals( const std::vector<double>& residuals ) override;
+
+        /// \brief \copydoc TimeStepControlInterface::timeStepFailed
+        void timeStepFailed( const double dt ) override;
+
+    protected:
+        const int     target_iterations_;
+        const double  decayrate_;
+        const double  growthrate_;
+        const bool    verbose_;
+        std::vector<double> residuals_;
+        mutable double failed_dt_ = 0.0;
+    };
+
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
     ///
     ///  HardcodedTimeStepControl
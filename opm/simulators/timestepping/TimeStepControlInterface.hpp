@@ -19,6 +19,8 @@
 #ifndef OPM_TIMESTEPCONTROLINTERFACE_HEADER_INCLUDED
 #define OPM_TIMESTEPCONTROLINTERFACE_HEADER_INCLUDED
 
+#include <vector>
+
 
 namespace Opm
 {
@@ -58,6 +60,15 @@ namespace Opm
         /// \return suggested time step size for the next step
         virtual double computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& relativeChange , const double simulationTimeElapsed) const = 0;
 
+        /// provide the residual norms of the nonlinear iterations of the time step
+        /// that is passed to the next call of computeTimeStepSize, ignored by default
+        /// \param residuals  largest residual norm of each iteration, starting with the initial residual
+        virtual void setNonlinearResiduals( const std::vector<double>& /* residuals */ ) {}
+
+        /// notify the control that a time step failed and was chopped, ignored by default
+        /// \param dt  time step size that failed
+        virtual void timeStepFailed( const double /* dt */ ) {}
+
         /// virtual destructor (empty)
         virtual ~TimeStepControlInterface () {}
     };
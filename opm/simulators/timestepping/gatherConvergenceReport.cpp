@@ -24,6 +24,12 @@
 
 #if HAVE_MPI
 
+#include <opm/simulators/utils/TimingRegistry.hpp>
+
+#include <cassert>
+#include <numeric>
+#include <vector>
+
 #include <mpi.h>
 
 namespace
@@ -159,6 +165,29 @@ namespace
         return cr;
     }
 
+    // Gather the packed buffers of all processes, displ is set to the
+    // offsets of the processes in the returned buffer.
+    std::vector<char> allGatherPacked(std::vector<char>& buffer, std::vector<int>& displ,
+                                      MPI_Comm mpi_communicator)
+    {
+        // Get message sizes and create offset/displacement array for gathering.
+        int message_size = buffer.size();
+        int num_processes = -1;
+        MPI_Comm_size(mpi_communicator, &num_processes);
+        std::vector<int> message_sizes(num_processes);
+        MPI_Allgather(&message_size, 1, MPI_INT, message_sizes.data(), 1, MPI_INT, mpi_communicator);
+        displ.assign(num_processes + 1, 0);
+        std::partial_sum(message_sizes.begin(), message_sizes.end(), displ.begin() + 1);
+
+        // Gather.
+        std::vector<char> recv_buffer(displ.back());
+        MPI_Allgatherv(buffer.data(), buffer.size(), MPI_PACKED,
+                       const_cast<char*>(recv_buffer.data()), message_sizes.data(),
+                       displ.data(), MPI_PACKED,
+                       mpi_communicator);
+        return recv_buffer;
+    }
+
 } // anonymous namespace
 
 
@@ -169,6 +198,8 @@ namespace Opm
     /// (per-process) reports.
     ConvergenceReport gatherConvergenceReport(const ConvergenceReport& local_report, Parallel::Communication mpi_communicator)
     {
+        ScopedTimer gatherTimer(TimingRegistry::Region::ConvergenceGather);
+
         // Pack local report.
         int message_size = messageSize(local_report, mpi_communicator);
         std::vector<char> buffer(message_size);
@@ -176,26 +207,60 @@ namespace Opm
         packConvergenceReport(local_report, buffer, offset,mpi_communicator);
         assert(offset == message_size);
 
-        // Get message sizes and create offset/displacement array for gathering.
-        int num_processes = -1;
-        MPI_Comm_size(mpi_communicator, &num_processes);
-        std::vector<int> message_sizes(num_processes);
-        MPI_Allgather(&message_size, 1, MPI_INT, message_sizes.data(), 1, MPI_INT, mpi_communicator);
-        std::vector<int> displ(num_processes + 1, 0);
-        std::partial_sum(message_sizes.begin(), message_sizes.end(), displ.begin() + 1);
-
         // Gather.
-        std::vector<char> recv_buffer(displ.back());
-        MPI_Allgatherv(buffer.data(), buffer.size(), MPI_PACKED,
-                       const_cast<char*>(recv_buffer.data()), message_sizes.data(),
-                       displ.data(), MPI_PACKED,
-                       mpi_communicator);
+        std::vector<int> displ;
+        const std::vector<char> recv_buffer = allGatherPacked(buffer, displ, mpi_communicator);
 
         // Unpack.
         ConvergenceReport global_report = unpackConvergenceReports(recv_buffer, displ, mpi_communicator);
         return global_report;
     }
 
+    std::pair<ConvergenceReport, DeferredLogger>
+    gatherConvergenceReport(const ConvergenceReport& local_report,
+                            const DeferredLogger& local_deferredlogger,
+                            Parallel::Communication mpi_communicator)
+    {
+        ScopedTimer gatherTimer(TimingRegistry::Region::ConvergenceGather);
+
+        // Pack local report, followed by the size and bytes of the local messages.
+        std::vector<char> messages;
+        local_deferredlogger.packMessages(messages);
+        int messages_size = messages.size();
+        int int_pack_size = 0;
+        MPI_Pack_size(1, MPI_INT, mpi_communicator, &int_pack_size);
+        int messages_pack_size = 0;
+        MPI_Pack_size(messages_size, MPI_BYTE, mpi_communicator, &messages_pack_size);
+
+        int message_size = messageSize(local_report, mpi_communicator) + int_pack_size + messages_pack_size;
+        std::vector<char> buffer(message_size);
+        int offset = 0;
+        packConvergenceReport(local_report, buffer, offset,mpi_communicator);
+        MPI_Pack(&messages_size, 1, MPI_INT, buffer.data(), buffer.size(), &offset, mpi_communicator);
+        MPI_Pack(messages.data(), messages_size, MPI_BYTE, buffer.data(), buffer.size(), &offset, mpi_communicator);
+        assert(offset == message_size);
+
+        // Gather.
+        std::vector<int> displ;
+        const std::vector<char> recv_buffer = allGatherPacked(buffer, displ, mpi_communicator);
+
+        // Unpack.
+        ConvergenceReport global_report;
+        DeferredLogger global_deferredlogger;
+        auto* data = const_cast<char*>(recv_buffer.data());
+        const int num_processes = displ.size() - 1;
+        for (int process = 0; process < num_processes; ++process) {
+            offset = displ[process];
+            global_report += unpackSingleConvergenceReport(recv_buffer, offset, mpi_communicator);
+            MPI_Unpack(data, recv_buffer.size(), &offset, &messages_size, 1, MPI_INT, mpi_communicator);
+            messages.resize(messages_size);
+            MPI_Unpack(data, recv_buffer.size(), &offset, messages.data(), messages_size, MPI_BYTE, mpi_communicator);
+            global_deferredlogger.unpackMessages(messages.data(), messages.data() + messages_size);
+            assert(offset == displ[process + 1]);
+        }
+        return {global_report, global_deferredlogger};
+    }
+
 } // namespace Opm
 
 #else // HAVE_MPI
@@ -207,6 +272,14 @@ namespace Opm
     {
         return local_report;
     }
+
+    std::pair<ConvergenceReport, DeferredLogger>
+    gatherConvergenceReport(const ConvergenceReport& local_report,
+                            const DeferredLogger& local_deferredlogger,
+                            Parallel::Communication mpi_communicator [[maybe_unused]])
+    {
+        return {local_report, local_deferredlogger};
+    }
 } // namespace Opm
 
 #endif // HAVE_MPI
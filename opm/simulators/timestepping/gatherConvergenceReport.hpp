@@ -23,8 +23,11 @@
 
 #include <opm/simulators/timestepping/ConvergenceReport.hpp>
 
+#include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
+#include <utility>
+
 namespace Opm
 {
 
@@ -32,6 +35,13 @@ namespace Opm
     /// (per-process) reports.
     ConvergenceReport gatherConvergenceReport(const ConvergenceReport& local_report, Parallel::Communication communicator);
 
+    /// Create a global convergence report and a global log combining local
+    /// (per-process) reports and logs, with one variable-size gather for both.
+    std::pair<ConvergenceReport, DeferredLogger>
+    gatherConvergenceReport(const ConvergenceReport& local_report,
+                            const DeferredLogger& local_deferredlogger,
+                            Parallel::Communication communicator);
+
 } // namespace Opm
 
 
@@ -0,0 +1,91 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/CacheFile.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+
+namespace Opm
+{
+
+void writeCacheValue(std::ostream& os, const std::uint64_t value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+std::uint64_t readCacheValue(std::istream& is)
+{
+    std::uint64_t value = 0;
+    is.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+void writeCacheString(std::ostream& os, const std::string& value)
+{
+    writeCacheValue(os, value.size());
+    os.write(value.data(), value.size());
+}
+
+std::string readCacheString(std::istream& is)
+{
+    std::string value(readCacheValue(is), '\0');
+    is.read(value.data(), value.size());
+    return value;
+}
+
+void writeCacheMagic(std::ostream& os, const CacheMagic& magic)
+{
+    os.write(magic.data(), magic.size());
+}
+
+bool readCacheMagic(std::istream& is, const CacheMagic& magic)
+{
+    CacheMagic fileMagic{};
+    is.read(fileMagic.data(), fileMagic.size());
+    return is && fileMagic == magic;
+}
+
+void writeCacheFile(const std::string& cacheFile,
+                    const std::function<void(std::ostream&)>& writeContents)
+{
+    const auto tmpFile = cacheFile + ".tmp" + std::to_string(std::random_device{}());
+    try {
+        {
+            std::ofstream os(tmpFile, std::ios::binary | std::ios::trunc);
+            writeContents(os);
+            os.close();
+            if (!os) {
+                throw std::runtime_error("Writing the cache file " + tmpFile + " failed");
+            }
+        }
+        std::filesystem::rename(tmpFile, cacheFile);
+    }
+    catch (...) {
+        std::error_code ec;
+        std::filesystem::remove(tmpFile, ec);
+        throw;
+    }
+}
+
+} // namespace Opm
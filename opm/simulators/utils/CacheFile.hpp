@@ -0,0 +1,102 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CACHEFILE_HEADER_INCLUDED
+#define OPM_CACHEFILE_HEADER_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace Opm
+{
+
+/// 64 bit FNV-1a hash, continued over several values. It is used for the
+/// keys of the files and tables which cache results of earlier runs.
+class Fnv1aHash
+{
+public:
+    void addBytes(const void* data, const std::size_t size)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash_ ^= bytes[i];
+            hash_ *= 1099511628211ULL;
+        }
+    }
+
+    template<class T>
+    void add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Only the bytes of trivially copyable values are hashed");
+        addBytes(&value, sizeof(T));
+    }
+
+    /// The size is hashed as well, such that moving characters between
+    /// consecutive strings changes the hash.
+    void add(const std::string& value)
+    {
+        add(value.size());
+        addBytes(value.data(), value.size());
+    }
+
+    std::uint64_t value() const
+    { return hash_; }
+
+private:
+    std::uint64_t hash_ = 14695981039346656037ULL;
+};
+
+/// The magic string at the start of a cache file, which is bumped whenever
+/// the layout of the file changes.
+using CacheMagic = std::array<char, 8>;
+
+/// Binary values and strings of the cache files, in the byte order of the
+/// machine.
+void writeCacheValue(std::ostream& os, std::uint64_t value);
+std::uint64_t readCacheValue(std::istream& is);
+void writeCacheString(std::ostream& os, const std::string& value);
+std::string readCacheString(std::istream& is);
+
+/// The magic string of a cache file.
+void writeCacheMagic(std::ostream& os, const CacheMagic& magic);
+/// \return  false if the stream does not start with magic
+bool readCacheMagic(std::istream& is, const CacheMagic& magic);
+
+/// Write a cache file.
+///
+/// The contents are written to a temporary file first, which is then
+/// renamed, so that concurrent runs never read a partially written cache.
+/// The temporary file is removed if the writing fails.
+///
+/// \param[in] cacheFile      name of the cache file
+/// \param[in] writeContents  writes the contents of the file to the stream
+/// \throw std::runtime_error if the file cannot be written
+void writeCacheFile(const std::string& cacheFile,
+                    const std::function<void(std::ostream&)>& writeContents);
+
+} // namespace Opm
+
+#endif // OPM_CACHEFILE_HEADER_INCLUDED
@@ -0,0 +1,82 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CHECKPOINTSTREAM_HEADER_INCLUDED
+#define OPM_CHECKPOINTSTREAM_HEADER_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace Opm
+{
+
+/// Values of the text sections written to the checkpoints of the eWoms
+/// restart mechanism. The bit patterns of the doubles are written, such that
+/// a simulation continues from a checkpoint with exactly the same state.
+
+inline void writeCheckpointValue(std::ostream& os, const double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    os << ' ' << bits;
+}
+
+inline double readCheckpointValue(std::istream& is)
+{
+    std::uint64_t bits = 0;
+    is >> bits;
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template <class Range>
+void writeCheckpointValues(std::ostream& os, const Range& values)
+{
+    os << ' ' << values.size();
+    for (const double value : values) {
+        writeCheckpointValue(os, value);
+    }
+}
+
+/// Read values written by writeCheckpointValues() into a range of the same
+/// size.
+///
+/// \return false if the checkpoint holds a different number of values, in
+///         which case the range is left unchanged.
+template <class Range>
+bool readCheckpointValues(std::istream& is, Range& values)
+{
+    std::size_t size = 0;
+    is >> size;
+    if (size != values.size()) {
+        return false;
+    }
+    for (auto& value : values) {
+        value = readCheckpointValue(is);
+    }
+    return true;
+}
+
+} // namespace Opm
+
+#endif // OPM_CHECKPOINTSTREAM_HEADER_INCLUDED
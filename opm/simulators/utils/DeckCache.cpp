@@ -0,0 +1,195 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/DeckCache.hpp>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/input/eclipse/Deck/Deck.hpp>
+#include <opm/input/eclipse/Parser/ParseContext.hpp>
+#include <opm/simulators/utils/CacheFile.hpp>
+
+#include <ebos/eclmpiserializer.hh>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace {
+
+// Bumped whenever the layout of the cache file changes.
+constexpr Opm::CacheMagic cacheMagic {'O', 'P', 'M', 'D', 'E', 'C', 'K', '2'};
+
+// The actions of the parse context, which decide which input errors the
+// parsing of the cached deck ignored.
+std::string parseContextId(const Opm::ParseContext& parseContext)
+{
+    std::string id;
+    for (const auto& [key, action] : parseContext) {
+        id += key + '=' + std::to_string(static_cast<int>(action)) + ';';
+    }
+    return id;
+}
+
+struct InputFile
+{
+    std::string name;
+    std::uint64_t size = 0;
+    std::uint64_t hash = 0;
+};
+
+// Hash of the contents of a file.
+std::uint64_t fileHash(const std::string& filename)
+{
+    std::ifstream is(filename, std::ios::binary);
+    Opm::Fnv1aHash hash;
+    std::vector<char> chunk(1 << 20);
+    while (is) {
+        is.read(chunk.data(), chunk.size());
+        hash.addBytes(chunk.data(), is.gcount());
+    }
+    return hash.value();
+}
+
+// The layout of the serialized deck, which depends on the serializer and on
+// the deck classes of opm-common of this build, as the hash of their
+// reference object. A cache written by a build with another layout is not
+// read.
+std::uint64_t layoutHash(Opm::Parallel::Communication comm)
+{
+    auto deck = Opm::Deck::serializeObject();
+    Opm::EclMpiSerializer ser(comm);
+    const auto buffer = ser.serialized(deck);
+    Opm::Fnv1aHash hash;
+    hash.addBytes(buffer.data(), buffer.size());
+    return hash.value();
+}
+
+InputFile inputFile(const std::string& filename)
+{
+    return {filename, std::filesystem::file_size(filename), fileHash(filename)};
+}
+
+std::shared_ptr<Opm::Deck> readDeckCache(Opm::Parallel::Communication comm,
+                                         std::istream& is,
+                                         const std::string& deckFilename,
+                                         const Opm::ParseContext& parseContext)
+{
+    if (!Opm::readCacheMagic(is, cacheMagic) ||
+        Opm::readCacheValue(is) != layoutHash(comm) ||
+        Opm::readCacheString(is) != parseContextId(parseContext) ||
+        Opm::readCacheString(is) != deckFilename)
+    {
+        return nullptr;
+    }
+
+    const auto numFiles = Opm::readCacheValue(is);
+    for (std::uint64_t i = 0; i < numFiles && is; ++i) {
+        InputFile cached;
+        cached.name = Opm::readCacheString(is);
+        cached.size = Opm::readCacheValue(is);
+        cached.hash = Opm::readCacheValue(is);
+        std::error_code ec;
+        if (!is || std::filesystem::file_size(cached.name, ec) != cached.size || ec ||
+            fileHash(cached.name) != cached.hash)
+        {
+            return nullptr;
+        }
+    }
+
+    std::vector<char> buffer(Opm::readCacheValue(is));
+    is.read(buffer.data(), buffer.size());
+    if (!is) {
+        return nullptr;
+    }
+
+    auto deck = std::make_shared<Opm::Deck>();
+    Opm::EclMpiSerializer ser(comm);
+    ser.fromSerialized(*deck, std::move(buffer));
+    return deck;
+}
+
+} // anonymous namespace
+
+namespace Opm
+{
+
+std::shared_ptr<Deck> loadDeckCache(Parallel::Communication comm,
+                                    const std::string& cacheFile,
+                                    const std::string& deckFilename,
+                                    const ParseContext& parseContext)
+{
+    std::ifstream is(cacheFile, std::ios::binary);
+    if (!is) {
+        return nullptr;
+    }
+
+    // A damaged cache must not stop the run, the deck is parsed instead.
+    try {
+        return readDeckCache(comm, is, deckFilename, parseContext);
+    }
+    catch (const std::exception& e) {
+        OpmLog::warning(fmt::format("Reading the deck cache file '{}' failed: {}",
+                                    cacheFile, e.what()));
+        return nullptr;
+    }
+}
+
+void writeDeckCache(Parallel::Communication comm,
+                    const std::string& cacheFile,
+                    const std::string& deckFilename,
+                    const ParseContext& parseContext,
+                    const Deck& deck)
+{
+    std::set<std::string> filenames { deckFilename };
+    for (std::size_t i = 0; i < deck.size(); ++i) {
+        const auto& filename = deck[i].location().filename;
+        if (!filename.empty() && std::filesystem::is_regular_file(filename)) {
+            filenames.insert(filename);
+        }
+    }
+
+    EclMpiSerializer ser(comm);
+    const auto buffer = ser.serialized(const_cast<Deck&>(deck));
+
+    writeCacheFile(cacheFile, [&](std::ostream& os) {
+        writeCacheMagic(os, cacheMagic);
+        writeCacheValue(os, layoutHash(comm));
+        writeCacheString(os, parseContextId(parseContext));
+        writeCacheString(os, deckFilename);
+        writeCacheValue(os, filenames.size());
+        for (const auto& filename : filenames) {
+            const auto file = inputFile(filename);
+            writeCacheString(os, file.name);
+            writeCacheValue(os, file.size);
+            writeCacheValue(os, file.hash);
+        }
+        writeCacheValue(os, buffer.size());
+        os.write(buffer.data(), buffer.size());
+    });
+}
+
+} // namespace Opm
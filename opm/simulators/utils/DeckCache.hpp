@@ -0,0 +1,71 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_DECKCACHE_HEADER_INCLUDED
+#define OPM_DECKCACHE_HEADER_INCLUDED
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <memory>
+#include <string>
+
+namespace Opm
+{
+
+class Deck;
+class ParseContext;
+
+/// Binary cache of a parsed deck.
+///
+/// The cache file holds the serialized deck together with the size and a
+/// hash of every file the deck was read from, i.e., the data file and all
+/// files included from it. A cache is only used if all of these files are
+/// unchanged, so repeated runs of the same case skip the parsing of the
+/// text files while edited cases are parsed again. The cache is also tied
+/// to the build which wrote it and to the actions of the parse context.
+
+/// Read a deck from a cache file.
+/// \param[in] comm          communicator, only used for the serialization
+/// \param[in] cacheFile     name of the cache file
+/// \param[in] deckFilename  name of the data file of the deck
+/// \param[in] parseContext  parse context the deck would be parsed with
+/// \return                  the cached deck, or nullptr if there is no
+///                          usable cache for deckFilename and parseContext,
+///                          any of its input files changed, or the cache
+///                          could not be read
+std::shared_ptr<Deck> loadDeckCache(Parallel::Communication comm,
+                                    const std::string& cacheFile,
+                                    const std::string& deckFilename,
+                                    const ParseContext& parseContext);
+
+/// Write a deck to a cache file.
+/// \param[in] comm          communicator, only used for the serialization
+/// \param[in] cacheFile     name of the cache file
+/// \param[in] deckFilename  name of the data file of the deck
+/// \param[in] parseContext  parse context the deck was parsed with
+/// \param[in] deck          the deck parsed from deckFilename
+void writeDeckCache(Parallel::Communication comm,
+                    const std::string& cacheFile,
+                    const std::string& deckFilename,
+                    const ParseContext& parseContext,
+                    const Deck& deck);
+
+} // namespace Opm
+
+#endif // OPM_DECKCACHE_HEADER_INCLUDED
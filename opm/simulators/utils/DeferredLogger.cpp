@@ -21,65 +21,109 @@
 #include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+
+    // Every message is stored as its flag, the lengths of tag and text and
+    // the characters of both.
+    constexpr std::size_t header_size = sizeof(std::int64_t) + 2 * sizeof(std::uint32_t);
+
+    template <class T>
+    void write(char*& pos, const T& value)
+    {
+        std::memcpy(pos, &value, sizeof(T));
+        pos += sizeof(T);
+    }
+
+    template <class T>
+    T read(const char*& pos)
+    {
+        T value;
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+} // anonymous namespace
+
 namespace Opm
 {
 
+    std::int64_t DeferredLogger::discarded_types_ = 0;
+
+    void DeferredLogger::setDiscardedMessageTypes(const std::int64_t message_types)
+    {
+        discarded_types_ = message_types;
+    }
+
+    void DeferredLogger::store_(const std::int64_t flag, const std::string& tag, const std::string& message)
+    {
+        if (isStored(flag)) {
+            messages_.push_back({flag, tag, message});
+        }
+    }
+
     void DeferredLogger::info(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Info, tag, message});
+        store_(Log::MessageType::Info, tag, message);
     }
     void DeferredLogger::warning(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Warning, tag, message});
+        store_(Log::MessageType::Warning, tag, message);
     }
     void DeferredLogger::error(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Error, tag, message});
+        store_(Log::MessageType::Error, tag, message);
     }
     void DeferredLogger::problem(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Problem, tag, message});
+        store_(Log::MessageType::Problem, tag, message);
     }
     void DeferredLogger::bug(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Bug, tag, message});
+        store_(Log::MessageType::Bug, tag, message);
     }
     void DeferredLogger::debug(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Debug, tag, message});
+        store_(Log::MessageType::Debug, tag, message);
     }
     void DeferredLogger::note(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Note, tag, message});
+        store_(Log::MessageType::Note, tag, message);
     }
 
     void DeferredLogger::info(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Info, "", message});
+        store_(Log::MessageType::Info, "", message);
     }
     void DeferredLogger::warning(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Warning, "", message});
+        store_(Log::MessageType::Warning, "", message);
     }
     void DeferredLogger::error(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Error, "", message});
+        store_(Log::MessageType::Error, "", message);
     }
     void DeferredLogger::problem(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Problem, "", message});
+        store_(Log::MessageType::Problem, "", message);
     }
     void DeferredLogger::bug(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Bug, "", message});
+        store_(Log::MessageType::Bug, "", message);
     }
     void DeferredLogger::debug(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Debug, "", message});
+        store_(Log::MessageType::Debug, "", message);
     }
     void DeferredLogger::note(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Note, "", message});
+        store_(Log::MessageType::Note, "", message);
     }
 
     void DeferredLogger::logMessages()
@@ -95,4 +139,46 @@ namespace Opm
         messages_.clear();
     }
 
+    void DeferredLogger::packMessages(std::vector<char>& buffer) const
+    {
+        std::size_t size = 0;
+        for (const auto& m : messages_) {
+            size += header_size + m.tag.size() + m.text.size();
+        }
+
+        const std::size_t offset = buffer.size();
+        buffer.resize(offset + size);
+        char* pos = buffer.data() + offset;
+        for (const auto& m : messages_) {
+            write(pos, m.flag);
+            write(pos, static_cast<std::uint32_t>(m.tag.size()));
+            write(pos, static_cast<std::uint32_t>(m.text.size()));
+            pos = std::copy(m.tag.begin(), m.tag.end(), pos);
+            pos = std::copy(m.text.begin(), m.text.end(), pos);
+        }
+        assert(pos == buffer.data() + buffer.size());
+    }
+
+    void DeferredLogger::unpackMessages(const char* begin, const char* end)
+    {
+        const char* pos = begin;
+        while (pos < end) {
+            const auto flag = read<std::int64_t>(pos);
+            const auto tagsize = read<std::uint32_t>(pos);
+            const auto textsize = read<std::uint32_t>(pos);
+            std::string tag(pos, tagsize);
+            pos += tagsize;
+            std::string text(pos, textsize);
+            pos += textsize;
+            messages_.push_back({flag, std::move(tag), std::move(text)});
+        }
+        assert(pos == end);
+    }
+
+    void DeferredLogger::appendMessages(const DeferredLogger& other)
+    {
+        messages_.reserve(messages_.size() + other.messages_.size());
+        messages_.insert(messages_.end(), other.messages_.begin(), other.messages_.end());
+    }
+
 } // namespace Opm
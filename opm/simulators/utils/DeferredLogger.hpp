@@ -21,11 +21,15 @@
 #ifndef OPM_DEFERREDLOGGER_HEADER_INCLUDED
 #define OPM_DEFERREDLOGGER_HEADER_INCLUDED
 
+#include <opm/common/OpmLog/LogUtil.hpp>
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include <fmt/format.h>
+
 namespace Opm
 {
     /** This class implements a deferred logger:
@@ -80,6 +84,28 @@ enum ExcEnum {
         void debug(const std::string& message);
         void note(const std::string& message);
 
+        /// Add a debug message formatted with fmt::format(format, args...).
+        /// The formatting is skipped if debug messages are discarded.
+        template <typename... Args>
+        void debugFormat(fmt::string_view format, const Args&... args)
+        {
+            if (isStored(Log::MessageType::Debug)) {
+                debug(fmt::vformat(format, fmt::make_format_args(args...)));
+            }
+        }
+
+        /// Discard messages of the given types, a bitmask of Log::MessageType
+        /// values, when they are added to any deferred logger. Meant for the
+        /// types that no OpmLog backend of this run would show.
+        static void setDiscardedMessageTypes(std::int64_t message_types);
+
+        /// Whether messages of the given type are kept when they are added.
+        /// Lets callers skip building a message that would be discarded.
+        static bool isStored(std::int64_t message_type)
+        {
+            return (message_type & discarded_types_) == 0;
+        }
+
         /// Log all messages to the OpmLog backends,
         /// and clear the message container.
         void logMessages();
@@ -87,10 +113,23 @@ enum ExcEnum {
         /// Clear the message container without logging them.
         void clearMessages();
 
+        /// Append the messages of other to the message container,
+        /// keeping their order.
+        void appendMessages(const DeferredLogger& other);
+
+        /// Append the messages to buffer in a compact byte format, which
+        /// is the same on all processes of a run.
+        void packMessages(std::vector<char>& buffer) const;
+
+        /// Append the messages packed by packMessages() in [begin, end)
+        /// to the message container.
+        void unpackMessages(const char* begin, const char* end);
+
     private:
+        void store_(std::int64_t flag, const std::string& tag, const std::string& message);
+
         std::vector<Message> messages_;
-        friend DeferredLogger gatherDeferredLogger(const DeferredLogger& local_deferredlogger,
-                                                   Parallel::Communication mpi_communicator);
+        static std::int64_t discarded_types_;
     };
 
 } // namespace Opm
@@ -0,0 +1,221 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/GeometricPartition.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+using Iterator = std::vector<std::size_t>::iterator;
+
+void bisect(Iterator begin, Iterator end,
+            const std::vector<std::array<double, 3>>& coords,
+            const std::vector<double>& weights,
+            const int firstPart, const int numParts,
+            std::vector<int>& parts)
+{
+    if (numParts == 1 || end - begin <= 1) {
+        for (auto it = begin; it != end; ++it) {
+            parts[*it] = firstPart;
+        }
+        return;
+    }
+
+    // cut normal to the direction of the largest extent
+    std::array<double, 3> lower;
+    std::array<double, 3> upper;
+    lower.fill(std::numeric_limits<double>::max());
+    upper.fill(std::numeric_limits<double>::lowest());
+    double total = 0.0;
+    for (auto it = begin; it != end; ++it) {
+        for (int d = 0; d < 3; ++d) {
+            lower[d] = std::min(lower[d], coords[*it][d]);
+            upper[d] = std::max(upper[d], coords[*it][d]);
+        }
+        total += weights[*it];
+    }
+    int dim = 0;
+    for (int d = 1; d < 3; ++d) {
+        if (upper[d] - lower[d] > upper[dim] - lower[dim]) {
+            dim = d;
+        }
+    }
+    // ties are ordered by index, such that the partition is deterministic
+    std::sort(begin, end, [&coords, dim](const std::size_t a, const std::size_t b) {
+        return coords[a][dim] < coords[b][dim] || (coords[a][dim] == coords[b][dim] && a < b);
+    });
+
+    const int leftParts = numParts / 2;
+    const double target = total * leftParts / numParts;
+    auto mid = begin;
+    double weight = 0.0;
+    while (mid != end && weight + 0.5 * weights[*mid] <= target) {
+        weight += weights[*mid];
+        ++mid;
+    }
+    // both sides get at least one point
+    mid = std::clamp(mid, begin + 1, end - 1);
+
+    bisect(begin, mid, coords, weights, firstPart, leftParts, parts);
+    bisect(mid, end, coords, weights, firstPart + leftParts, numParts - leftParts, parts);
+}
+
+// Move all cells of every well to the part holding most of them.
+void keepWellsTogether(std::vector<int>& parts,
+                       const std::vector<std::vector<int>>& wellCells,
+                       const int numParts)
+{
+    std::vector<int> count(numParts);
+    for (const auto& cells : wellCells) {
+        if (cells.empty()) {
+            continue;
+        }
+        std::fill(count.begin(), count.end(), 0);
+        for (const int cell : cells) {
+            ++count[parts[cell]];
+        }
+        const int part = std::max_element(count.begin(), count.end()) - count.begin();
+        for (const int cell : cells) {
+            parts[cell] = part;
+        }
+    }
+}
+
+int findRoot(std::vector<int>& parent, int i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+} // anonymous namespace
+
+namespace Opm
+{
+
+std::vector<int> coordinateBisection(const std::vector<std::array<double, 3>>& coords,
+                                     const std::vector<double>& weights,
+                                     const int numParts)
+{
+    if (numParts < 1) {
+        throw std::invalid_argument("The number of parts of a partition must be positive");
+    }
+    if (weights.size() != coords.size()) {
+        throw std::invalid_argument("Coordinate bisection needs a weight for every point");
+    }
+    std::vector<std::size_t> order(coords.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<int> parts(coords.size(), 0);
+    bisect(order.begin(), order.end(), coords, weights, 0, numParts, parts);
+    return parts;
+}
+
+bool isGeometricPartitionMethod(const std::string& method)
+{
+    return method == "rcb" || method == "columns" || method == "wells";
+}
+
+std::vector<int> geometricPartition(const std::string& method,
+                                    const std::vector<std::array<double, 3>>& centroids,
+                                    const std::vector<int>& columns,
+                                    const std::vector<std::vector<int>>& wellCells,
+                                    const int numParts)
+{
+    if (!isGeometricPartitionMethod(method)) {
+        throw std::invalid_argument("Unknown geometric partition method " + method);
+    }
+    const std::size_t numCells = centroids.size();
+
+    if (method == "rcb") {
+        auto parts = coordinateBisection(centroids, std::vector<double>(numCells, 1.0), numParts);
+        keepWellsTogether(parts, wellCells, numParts);
+        return parts;
+    }
+
+    if (columns.size() != numCells) {
+        throw std::invalid_argument("The column partition needs the column of every cell");
+    }
+
+    // the region of every cell, a column or the columns connected by wells
+    std::unordered_map<int, int> columnRegion;
+    std::vector<int> cellRegion(numCells);
+    for (std::size_t cell = 0; cell < numCells; ++cell) {
+        const int next = columnRegion.size();
+        cellRegion[cell] = columnRegion.emplace(columns[cell], next).first->second;
+    }
+    int numRegions = columnRegion.size();
+    if (method == "wells") {
+        std::vector<int> parent(numRegions);
+        std::iota(parent.begin(), parent.end(), 0);
+        for (const auto& cells : wellCells) {
+            for (std::size_t i = 1; i < cells.size(); ++i) {
+                const int a = findRoot(parent, cellRegion[cells[0]]);
+                const int b = findRoot(parent, cellRegion[cells[i]]);
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+        std::vector<int> number(numRegions, -1);
+        int numRoots = 0;
+        for (int region = 0; region < numRegions; ++region) {
+            const int root = findRoot(parent, region);
+            if (number[root] < 0) {
+                number[root] = numRoots++;
+            }
+        }
+        for (auto& region : cellRegion) {
+            region = number[findRoot(parent, region)];
+        }
+        numRegions = numRoots;
+    }
+
+    // the regions are bisected at their areal centre, weighted by their cells
+    std::vector<std::array<double, 3>> regionCoords(numRegions, {0.0, 0.0, 0.0});
+    std::vector<double> regionWeights(numRegions, 0.0);
+    for (std::size_t cell = 0; cell < numCells; ++cell) {
+        auto& coords = regionCoords[cellRegion[cell]];
+        coords[0] += centroids[cell][0];
+        coords[1] += centroids[cell][1];
+        regionWeights[cellRegion[cell]] += 1.0;
+    }
+    for (int region = 0; region < numRegions; ++region) {
+        regionCoords[region][0] /= regionWeights[region];
+        regionCoords[region][1] /= regionWeights[region];
+    }
+    const auto regionParts = coordinateBisection(regionCoords, regionWeights, numParts);
+
+    std::vector<int> parts(numCells);
+    for (std::size_t cell = 0; cell < numCells; ++cell) {
+        parts[cell] = regionParts[cellRegion[cell]];
+    }
+    if (method == "columns") {
+        keepWellsTogether(parts, wellCells, numParts);
+    }
+    return parts;
+}
+
+} // namespace Opm
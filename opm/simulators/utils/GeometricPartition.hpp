@@ -0,0 +1,79 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GEOMETRICPARTITION_HEADER_INCLUDED
+#define OPM_GEOMETRICPARTITION_HEADER_INCLUDED
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+/// Geometric partitioners of the grid.
+///
+/// These are cheaper than the graph partitioner and produce compact,
+/// box shaped subdomains. They only see the cell centroids, the areal
+/// column of every cell and the cells of the wells.
+
+/// Recursive coordinate bisection of weighted points.
+///
+/// The points are split at the weighted median of the coordinate with the
+/// largest extent, into two sets whose weights are proportional to the
+/// number of parts assigned to each side, until every set is one part.
+///
+/// \param[in] coords     the coordinates of every point
+/// \param[in] weights    the weight of every point
+/// \param[in] numParts   number of parts
+/// \return               the part of every point
+std::vector<int> coordinateBisection(const std::vector<std::array<double, 3>>& coords,
+                                     const std::vector<double>& weights,
+                                     int numParts);
+
+/// Whether the name is a method of geometricPartition().
+bool isGeometricPartitionMethod(const std::string& method);
+
+/// Partition the cells of a grid with a geometric method.
+///
+/// The methods are
+///   - "rcb":     recursive coordinate bisection of the cell centroids.
+///   - "columns": recursive coordinate bisection of the areal columns, such
+///                that all cells of a column are in the same part. Suits
+///                gravity dominated flow and vertical wells.
+///   - "wells":   like "columns", but the columns connected by a well form
+///                one region which is not split. Suits deviated wells.
+/// The first two methods move all cells of a well to the part holding most
+/// of them afterwards.
+///
+/// \param[in] method     one of the methods above
+/// \param[in] centroids  the centroid of every cell
+/// \param[in] columns    the areal column of every cell, e.g. i + nx*j
+/// \param[in] wellCells  the cells of every well which must not be split
+/// \param[in] numParts   number of parts
+/// \return               the part of every cell
+std::vector<int> geometricPartition(const std::string& method,
+                                    const std::vector<std::array<double, 3>>& centroids,
+                                    const std::vector<int>& columns,
+                                    const std::vector<std::vector<int>>& wellCells,
+                                    int numParts);
+
+} // namespace Opm
+
+#endif // OPM_GEOMETRICPARTITION_HEADER_INCLUDED
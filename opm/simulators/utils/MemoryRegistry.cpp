@@ -0,0 +1,117 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/MemoryRegistry.hpp>
+
+#include <fmt/format.h>
+
+#include <fstream>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace Opm
+{
+
+std::array<MemoryRegistry::Entry, MemoryRegistry::numOwners> MemoryRegistry::entries_{};
+
+const char* MemoryRegistry::name(const Owner owner)
+{
+    switch (owner) {
+    case Owner::Input:              return "Deck and schedule";
+    case Owner::Transmissibilities: return "Transmissibilities";
+    case Owner::Jacobian:           return "Jacobian";
+    case Owner::Preconditioner:     return "Preconditioner";
+    case Owner::WellState:          return "Well states";
+    case Owner::OutputGather:       return "Output gather";
+    case Owner::OutputBuffers:      return "Output buffers";
+    case Owner::NumOwners:          break;
+    }
+    return "Unknown";
+}
+
+std::size_t MemoryRegistry::residentBytes()
+{
+    // the second entry is the number of resident pages
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0;
+    std::size_t resident = 0;
+    if (!(statm >> size >> resident)) {
+        return 0;
+    }
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::size_t MemoryRegistry::peakResidentBytes()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    // kilobytes on Linux
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+}
+
+std::string MemoryRegistry::report(const Parallel::Communication& comm)
+{
+    // The last entry is the resident memory of the process.
+    constexpr std::size_t numRows = numOwners + 1;
+    std::vector<double> current(numRows), peak(numRows);
+    for (std::size_t i = 0; i < numOwners; ++i) {
+        current[i] = entries_[i].current;
+        peak[i] = entries_[i].peak;
+    }
+    current[numOwners] = residentBytes();
+    peak[numOwners] = peakResidentBytes();
+
+    std::vector<double> minCurrent = current, maxCurrent = current, meanCurrent = current;
+    comm.min(minCurrent.data(), numRows);
+    comm.max(maxCurrent.data(), numRows);
+    comm.sum(meanCurrent.data(), numRows);
+    // the peaks of all processes, by process
+    std::vector<double> allPeaks(numRows * comm.size());
+    comm.allgather(peak.data(), numRows, allPeaks.data());
+
+    constexpr double megabyte = 1024.0 * 1024.0;
+    std::string table = fmt::format("{:<22} {:>12} {:>12} {:>12} {:>12} {:>10}\n",
+                                    "Memory (MB)", "Min", "Mean", "Max", "Max peak", "On rank");
+    for (std::size_t i = 0; i < numRows; ++i) {
+        double maxPeak = 0.0;
+        int maxRank = 0;
+        for (int rank = 0; rank < comm.size(); ++rank) {
+            if (allPeaks[rank * numRows + i] > maxPeak) {
+                maxPeak = allPeaks[rank * numRows + i];
+                maxRank = rank;
+            }
+        }
+        if (maxPeak == 0.0) {
+            continue;
+        }
+        table += fmt::format("{:<22} {:>12.1f} {:>12.1f} {:>12.1f} {:>12.1f} {:>10}\n",
+                             i < numOwners ? name(static_cast<Owner>(i)) : "Resident",
+                             minCurrent[i] / megabyte,
+                             meanCurrent[i] / comm.size() / megabyte,
+                             maxCurrent[i] / megabyte,
+                             maxPeak / megabyte, maxRank);
+    }
+    return table;
+}
+
+} // namespace Opm
@@ -0,0 +1,162 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MEMORYREGISTRY_HEADER_INCLUDED
+#define OPM_MEMORYREGISTRY_HEADER_INCLUDED
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+/// Current and peak memory of the main data structures of a run.
+///
+/// Like the TimingRegistry the owners are a fixed enumeration. The owners
+/// report their sizes when they allocate, so the accounting costs nothing
+/// in between. The sizes are estimates from the sizes of the containers,
+/// except for the input and the preconditioner, whose sizes are the growth
+/// of the resident memory of the process while they are created. The
+/// registry is not thread safe.
+class MemoryRegistry
+{
+public:
+    enum class Owner {
+        Input,              // deck, EclipseState and Schedule
+        Transmissibilities,
+        Jacobian,           // the reservoir matrix seen by the linear solver
+        Preconditioner,
+        WellState,          // the active, last valid and NUPCOL copies
+        OutputGather,       // the global buffers on the I/O rank
+        OutputBuffers,      // the cell data buffers of the output module
+        NumOwners
+    };
+
+    struct Entry
+    {
+        std::size_t current = 0;
+        std::size_t peak = 0;
+    };
+
+    /// Change the current size of an owner by a number of bytes.
+    static void add(const Owner owner, const long long bytes)
+    {
+        auto& entry = entries_[static_cast<std::size_t>(owner)];
+        entry.current = bytes < 0 && static_cast<std::size_t>(-bytes) > entry.current
+            ? 0 : entry.current + bytes;
+        entry.peak = std::max(entry.peak, entry.current);
+    }
+
+    /// The sizes of this process
+    static const Entry& entry(const Owner owner)
+    {
+        return entries_[static_cast<std::size_t>(owner)];
+    }
+
+    static const char* name(Owner owner);
+
+    /// Resident memory of this process, 0 if unknown.
+    static std::size_t residentBytes();
+
+    /// Peak resident memory of this process, 0 if unknown.
+    static std::size_t peakResidentBytes();
+
+    /// Table of the current and peak size of every owner and of the resident
+    /// memory, with the minimum, mean and maximum over all processes and the
+    /// rank with the largest peak. Collective, the table is the same on all
+    /// processes.
+    static std::string report(const Parallel::Communication& comm);
+
+private:
+    static constexpr std::size_t numOwners = static_cast<std::size_t>(Owner::NumOwners);
+    static std::array<Entry, numOwners> entries_;
+};
+
+/// The share of an object in the size of an owner of the MemoryRegistry,
+/// which is removed with the object. Copies add their share again.
+class MemoryAccount
+{
+public:
+    explicit MemoryAccount(const MemoryRegistry::Owner owner)
+        : owner_(owner)
+    {
+    }
+
+    MemoryAccount(const MemoryAccount& other)
+        : owner_(other.owner_)
+    {
+        set(other.bytes_);
+    }
+
+    MemoryAccount& operator=(const MemoryAccount& other)
+    {
+        if (this != &other) {
+            set(0);
+            owner_ = other.owner_;
+            set(other.bytes_);
+        }
+        return *this;
+    }
+
+    ~MemoryAccount()
+    {
+        set(0);
+    }
+
+    /// Set the size of the object.
+    void set(const std::size_t bytes)
+    {
+        MemoryRegistry::add(owner_, static_cast<long long>(bytes) - static_cast<long long>(bytes_));
+        bytes_ = bytes;
+    }
+
+    std::size_t bytes() const
+    {
+        return bytes_;
+    }
+
+private:
+    MemoryRegistry::Owner owner_;
+    std::size_t bytes_ = 0;
+};
+
+/// Bytes allocated by a vector.
+template <class T>
+std::size_t memoryBytes(const std::vector<T>& v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+/// Estimate of the bytes allocated by a BCRS matrix: the blocks, their
+/// column indices and the rows.
+template <class Matrix>
+std::size_t matrixMemoryBytes(const Matrix& A)
+{
+    return A.nonzeroes() * (sizeof(typename Matrix::block_type) + sizeof(typename Matrix::size_type))
+        + A.N() * sizeof(typename Matrix::row_type);
+}
+
+} // namespace Opm
+
+#endif // OPM_MEMORYREGISTRY_HEADER_INCLUDED
@@ -0,0 +1,139 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/MetricsExporter.hpp>
+
+#include <opm/simulators/timestepping/SimulatorReport.hpp>
+#include <opm/simulators/utils/MemoryRegistry.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+MetricsExporter::MetricsExporter(const Parallel::Communication& comm,
+                                 const std::string& filename,
+                                 const double endTime)
+    : comm_(comm)
+    , filename_(filename)
+    , end_time_(endTime)
+    , start_(std::chrono::steady_clock::now())
+    , last_update_(start_)
+{
+}
+
+void MetricsExporter::update(const SimulatorReportSingle& substep, const int reportStep)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const double wallTime = std::chrono::duration<double>(now - start_).count();
+    const double substepWallTime = std::chrono::duration<double>(now - last_update_).count();
+    last_update_ = now;
+
+    ++substeps_;
+    if (substep.converged) {
+        simulated_time_ = std::max(simulated_time_, substep.global_time + substep.timestep_length);
+    }
+    else {
+        ++failed_substeps_;
+    }
+    newton_iterations_ += substep.total_newton_iterations;
+    linear_iterations_ += substep.total_linear_iterations;
+    well_iterations_ += substep.total_well_iterations;
+
+    // The times of the regions, then the time in the collective regions,
+    // the resident and the peak resident memory.
+    constexpr std::size_t numRegions = static_cast<std::size_t>(TimingRegistry::Region::NumRegions);
+    std::vector<double> max(numRegions + 3), mean(numRegions + 3);
+    double wait = 0.0;
+    for (std::size_t i = 0; i < numRegions; ++i) {
+        const auto region = static_cast<TimingRegistry::Region>(i);
+        max[i] = TimingRegistry::entry(region).time;
+        if (TimingRegistry::isCollective(region)) {
+            wait += max[i];
+        }
+    }
+    max[numRegions] = wait;
+    max[numRegions + 1] = MemoryRegistry::residentBytes();
+    max[numRegions + 2] = MemoryRegistry::peakResidentBytes();
+    mean = max;
+    comm_.max(max.data(), max.size());
+    comm_.sum(mean.data(), mean.size());
+    for (auto& m : mean) {
+        m /= comm_.size();
+    }
+    auto maxMean = [&max, &mean](const std::size_t i) {
+        return fmt::format("{{\"max\": {:.6g}, \"mean\": {:.6g}, \"imbalance\": {:.4g}}}",
+                           max[i], mean[i], mean[i] > 0.0 ? max[i] / mean[i] : 1.0);
+    };
+
+    const auto timestamp = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    std::string json = fmt::format("{{\"timestamp\": {:.3f}, \"wall_time\": {:.3f}, \"report_step\": {}"
+                                   ", \"simulated_time\": {:.10g}, \"end_time\": {:.10g}, \"progress\": {:.6f}",
+                                   timestamp, wallTime, reportStep, simulated_time_, end_time_,
+                                   end_time_ > 0.0 ? simulated_time_ / end_time_ : 0.0);
+    json += fmt::format(", \"substeps\": {}, \"failed_substeps\": {}, \"substeps_per_hour\": {:.4g}",
+                        substeps_, failed_substeps_, wallTime > 0.0 ? 3600.0 * substeps_ / wallTime : 0.0);
+    json += fmt::format(", \"newton_iterations\": {}, \"linear_iterations\": {}, \"well_iterations\": {}",
+                        newton_iterations_, linear_iterations_, well_iterations_);
+    json += fmt::format(", \"last_substep\": {{\"length\": {:.10g}, \"converged\": {}, \"wall_time\": {:.3f}"
+                        ", \"newton_iterations\": {}, \"linear_iterations\": {}}}",
+                        substep.timestep_length, substep.converged ? "true" : "false", substepWallTime,
+                        substep.total_newton_iterations, substep.total_linear_iterations);
+    json += ", \"timings\": {";
+    bool first = true;
+    for (std::size_t i = 0; i < numRegions; ++i) {
+        const auto region = static_cast<TimingRegistry::Region>(i);
+        if (TimingRegistry::isStartup(region) || max[i] == 0.0) {
+            continue;
+        }
+        json += fmt::format("{}\"{}\": {}", first ? "" : ", ", TimingRegistry::name(region), maxMean(i));
+        first = false;
+    }
+    json += fmt::format("}}, \"collective_time\": {}", maxMean(numRegions));
+    json += fmt::format(", \"resident_bytes\": {}, \"peak_resident_bytes\": {}}}\n",
+                        maxMean(numRegions + 1), maxMean(numRegions + 2));
+    snapshot_ = std::move(json);
+
+    if (comm_.rank() == 0) {
+        write();
+    }
+}
+
+void MetricsExporter::write() const
+{
+    const std::string tmp = filename_ + ".tmp";
+    std::ofstream os(tmp);
+    os << snapshot_;
+    os.close();
+    // keep the previous snapshot if the file system is full
+    if (!os) {
+        return;
+    }
+    std::rename(tmp.c_str(), filename_.c_str());
+}
+
+} // namespace Opm
@@ -0,0 +1,93 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_METRICSEXPORTER_HEADER_INCLUDED
+#define OPM_METRICSEXPORTER_HEADER_INCLUDED
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <chrono>
+#include <string>
+
+namespace Opm
+{
+
+struct SimulatorReportSingle;
+
+/// Snapshot of the progress of a running simulation in a JSON file, for
+/// job schedulers which watch for stalled or degraded runs.
+///
+/// The file is replaced after every substep by the first process, through
+/// a temporary file and a rename, so a reader never sees a partial file.
+/// It holds the wall clock time of the update, the simulated time, the
+/// number of substeps and failed substeps, the substep rate, the iteration
+/// counts, the maximum, mean and imbalance over the processes of the times
+/// of the regions of the TimingRegistry, and the resident memory.
+class MetricsExporter
+{
+public:
+    /// \param comm      communicator of the simulation
+    /// \param filename  file replaced by every update
+    /// \param endTime   simulated time at the end of the run in seconds
+    MetricsExporter(const Parallel::Communication& comm,
+                    const std::string& filename,
+                    double endTime);
+
+    /// Count a substep and replace the file. Collective.
+    /// \param substep     report of the substep, also if it failed
+    /// \param reportStep  index of the report step of the substep
+    void update(const SimulatorReportSingle& substep, int reportStep);
+
+    /// The contents of the last update, also on the other processes
+    const std::string& snapshot() const
+    {
+        return snapshot_;
+    }
+
+    int substeps() const
+    {
+        return substeps_;
+    }
+
+    int failedSubsteps() const
+    {
+        return failed_substeps_;
+    }
+
+private:
+    void write() const;
+
+    Parallel::Communication comm_;
+    std::string filename_;
+    double end_time_;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_update_;
+
+    double simulated_time_ = 0.0;
+    int substeps_ = 0;
+    int failed_substeps_ = 0;
+    unsigned long newton_iterations_ = 0;
+    unsigned long linear_iterations_ = 0;
+    unsigned long well_iterations_ = 0;
+    std::string snapshot_;
+};
+
+} // namespace Opm
+
+#endif // OPM_METRICSEXPORTER_HEADER_INCLUDED
@@ -0,0 +1,61 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/NumaFirstTouch.hpp>
+
+#include <cstdint>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Opm
+{
+
+bool releasePages(void* data, const std::size_t bytes, const bool hugePages)
+{
+#ifdef MADV_DONTNEED
+    const auto pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto begin = reinterpret_cast<std::uintptr_t>(data);
+    // only the pages which hold nothing but entries of the array
+    const std::uintptr_t first = (begin + pageSize - 1) / pageSize * pageSize;
+    const std::uintptr_t last = (begin + bytes) / pageSize * pageSize;
+    if (last <= first) {
+        return false;
+    }
+    void* pages = reinterpret_cast<void*>(first);
+    const std::size_t length = last - first;
+#ifdef MADV_HUGEPAGE
+    if (hugePages) {
+        // only a hint, the huge pages may not be available
+        madvise(pages, length, MADV_HUGEPAGE);
+    }
+#else
+    static_cast<void>(hugePages);
+#endif
+    return madvise(pages, length, MADV_DONTNEED) == 0;
+#else
+    static_cast<void>(data);
+    static_cast<void>(bytes);
+    static_cast<void>(hugePages);
+    return false;
+#endif
+}
+
+} // namespace Opm
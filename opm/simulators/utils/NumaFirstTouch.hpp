@@ -0,0 +1,156 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_NUMAFIRSTTOUCH_HEADER_INCLUDED
+#define OPM_NUMAFIRSTTOUCH_HEADER_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace Opm
+{
+
+/// Placement of large arrays on the NUMA domains of the threads using them.
+///
+/// The operating system places a memory page on the NUMA domain of the
+/// thread which touches it first. Arrays which are allocated and filled by
+/// the master thread therefore end up on one domain, although the threads
+/// of the other domains process most of their entries. The functions below
+/// give the whole pages of an array back to the operating system and then
+/// write the entries again from the threads owning them under a static
+/// OpenMP schedule, which is the schedule of the loops over the cells and
+/// the matrix rows. The contents are kept, at the cost of a temporary copy.
+/// They must only be used on arrays allocated on the heap of this process,
+/// and outside of threaded regions.
+
+/// Give the whole memory pages within an array back to the operating system,
+/// such that they are placed again by the next touch. Their contents are
+/// lost. Optionally advise the kernel to back the range with transparent
+/// huge pages.
+///
+/// \return whether any page was released.
+bool releasePages(void* data, std::size_t bytes, bool hugePages);
+
+/// Move the entries of an array to pages first touched by the threads
+/// processing them under a static schedule.
+template <class T>
+void firstTouch(T* data, const std::size_t size, const bool hugePages = false)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Entries must be trivially copyable");
+#ifdef _OPENMP
+    const int numThreads = omp_get_max_threads();
+#else
+    const int numThreads = 1;
+#endif
+    if (size == 0 || (numThreads < 2 && !hugePages)) {
+        return;
+    }
+    const std::vector<T> copy(data, data + size);
+    if (!releasePages(data, size * sizeof(T), hugePages)) {
+        return;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = copy[i];
+    }
+}
+
+template <class T>
+void firstTouch(std::vector<T>& v, const bool hugePages = false)
+{
+    firstTouch(v.data(), v.size(), hugePages);
+}
+
+/// Move the entries of a block vector, e.g. a residual, to the threads
+/// processing its blocks.
+template <class Vector>
+void firstTouchVector(Vector& x, const bool hugePages = false)
+{
+    using Field = typename Vector::field_type;
+    using Block = typename Vector::block_type;
+    static_assert(sizeof(Block) == Block::dimension * sizeof(Field),
+                  "Blocks must be stored contiguously");
+    if (x.size() > 0) {
+        firstTouch(&x[0][0], x.size() * Block::dimension, hugePages);
+    }
+}
+
+/// Move the blocks of a BCRS matrix to the threads processing its rows.
+///
+/// \return false if the blocks are not one array in row order, which is
+///         the case for matrices built in implicit mode and not compressed,
+///         and nothing was done.
+template <class Matrix>
+bool firstTouchMatrix(Matrix& A, const bool hugePages = false)
+{
+    using Field = typename Matrix::field_type;
+    using Block = typename Matrix::block_type;
+    constexpr std::size_t blockSize = Block::rows * Block::cols;
+    static_assert(sizeof(Block) == blockSize * sizeof(Field),
+                  "Blocks must be stored contiguously");
+
+    const std::size_t numRows = A.N();
+    std::vector<std::size_t> rowStart(numRows + 1, 0);
+    Field* values = nullptr;
+    std::size_t numBlocks = 0;
+    for (std::size_t i = 0; i < numRows; ++i) {
+        rowStart[i] = numBlocks;
+        if (A[i].size() == 0) {
+            continue;
+        }
+        Field* rowValues = &(*A[i].begin())[0][0];
+        if (values == nullptr) {
+            values = rowValues;
+        }
+        if (rowValues != values + numBlocks * blockSize) {
+            return false;
+        }
+        numBlocks += A[i].size();
+    }
+    rowStart[numRows] = numBlocks;
+    if (numBlocks == 0) {
+        return false;
+    }
+
+    const std::vector<Field> copy(values, values + numBlocks * blockSize);
+    if (!releasePages(values, copy.size() * sizeof(Field), hugePages)) {
+        return false;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (std::size_t i = 0; i < numRows; ++i) {
+        std::copy(copy.begin() + rowStart[i] * blockSize,
+                  copy.begin() + rowStart[i + 1] * blockSize,
+                  values + rowStart[i] * blockSize);
+    }
+    return true;
+}
+
+} // namespace Opm
+
+#endif // OPM_NUMAFIRSTTOUCH_HEADER_INCLUDED
@@ -20,6 +20,7 @@
 
 #include <opm/simulators/utils/ParallelFileMerger.hpp>
 #include <iostream>
+#include <system_error>
 
 namespace Opm
 {
@@ -109,5 +110,21 @@ void ParallelFileMerger::appendFile(std::ofstream& of, const fs::path& file, con
     fs::remove(file);
 }
 
+void removeRankLogFiles(const fs::path& output_dir,
+                        const std::string& deckname,
+                        int rank,
+                        bool keep_nonempty)
+{
+    for (const auto* extension : {".PRT", ".DBG"}) {
+        auto file = output_dir;
+        file /= deckname + "." + std::to_string(rank) + extension;
+        std::error_code ec;
+        const auto size = fs::file_size(file, ec);
+        if (!ec && (size == 0 || !keep_nonempty)) {
+            fs::remove(file, ec);
+        }
+    }
+}
+
 } // end namespace detail
 } // end namespace Opm
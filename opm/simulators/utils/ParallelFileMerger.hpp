@@ -73,6 +73,21 @@ private:
     /// \brief Whether to show any logging fallout
     bool show_fallout_;
 };
+
+/// \brief Remove the log files of one process that need not be merged.
+///
+/// Lets every process clean up after itself, in parallel, such that
+/// ParallelFileMerger on the root process only has the files with
+/// content left to merge.
+/// \param output_dir The output directory of the log files.
+/// \param deckname The name of the deck.
+/// \param rank The rank of the process whose files to remove.
+/// \param keep_nonempty Whether to keep files that have content.
+void removeRankLogFiles(const fs::path& output_dir,
+                        const std::string& deckname,
+                        int rank,
+                        bool keep_nonempty);
+
 } // end namespace detail
 } // end namespace Opm
 #endif // end header guard
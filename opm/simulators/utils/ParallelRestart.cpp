@@ -22,11 +22,13 @@
 #endif
 
 #include "ParallelRestart.hpp"
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
 #include <ctime>
 #include <memory>
+#include <numeric>
 #include <dune/common/parallel/mpitraits.hh>
 #include <opm/output/data/Aquifer.hpp>
 #include <opm/output/data/Cells.hpp>
@@ -1101,15 +1103,37 @@ INSTANTIATE_PACK(std::set<std::string>)
 RestartValue loadParallelRestart(const EclipseIO* eclIO, Action::State& actionState, SummaryState& summaryState,
                                  const std::vector<Opm::RestartKey>& solutionKeys,
                                  const std::vector<Opm::RestartKey>& extraKeys,
+                                 [[maybe_unused]] const std::vector<int>& globalIndices,
                                  Parallel::Communication comm)
 {
 #if HAVE_MPI
+    if (comm.size() == 1) {
+        return eclIO->loadRestart(actionState, summaryState, solutionKeys, extraKeys);
+    }
+
+    // The global indices of the cells of all processes, on the I/O rank.
+    const int numLocal = globalIndices.size();
+    std::vector<int> sizes(comm.rank() == 0 ? comm.size() : 0);
+    comm.gather(&numLocal, sizes.data(), 1, 0);
+    std::vector<int> offsets(sizes.size() + 1, 0);
+    std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+    std::vector<int> allIndices(offsets.back());
+    comm.gatherv(globalIndices.data(), numLocal, allIndices.data(), sizes.data(), offsets.data(), 0);
+
     RestartValue restartValues{};
+    data::Solution globalSolution;
 
     if (eclIO)
     {
         assert(comm.rank() == 0);
         restartValues = eclIO->loadRestart(actionState, summaryState, solutionKeys, extraKeys);
+        // Only the names, units and targets of the solution arrays are
+        // broadcast, their values are scattered below.
+        globalSolution = std::move(restartValues.solution);
+        restartValues.solution = data::Solution{};
+        for (const auto& [name, cellData] : globalSolution) {
+            restartValues.solution.emplace(name, data::CellData{cellData.dim, {}, cellData.target});
+        }
         int packedSize = Mpi::packSize(restartValues, comm);
         std::vector<char> buffer(packedSize);
         int position=0;
@@ -1134,6 +1158,21 @@ RestartValue loadParallelRestart(const EclipseIO* eclIO, Action::State& actionSt
         comm.broadcast(buffer.data(), bufferSize, 0);
         summaryState.deserialize(buffer);
     }
+
+    // The solution arrays are in the same order on all processes.
+    std::vector<double> sendBuffer(allIndices.size());
+    for (auto& [name, cellData] : restartValues.solution) {
+        if (comm.rank() == 0) {
+            const auto& values = globalSolution.data(name);
+            std::transform(allIndices.begin(), allIndices.end(), sendBuffer.begin(),
+                           [&values](const int globalIdx) { return values[globalIdx]; });
+            // release the global array as soon as it is sent
+            globalSolution.erase(name);
+        }
+        cellData.data.resize(numLocal);
+        comm.scatterv(sendBuffer.data(), sizes.data(), offsets.data(),
+                      cellData.data.data(), numLocal, 0);
+    }
     return restartValues;
 #else
     (void) comm;
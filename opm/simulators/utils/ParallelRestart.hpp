@@ -416,9 +416,17 @@ void broadcast(Parallel::Communication, int, Args&&...)
 
 } // end namespace Mpi
 
+/// Load the restart values on the I/O rank and distribute them.
+///
+/// The solution arrays are scattered, every process only receives the
+/// values of its cells, in the order of its local cells. The well, group,
+/// aquifer and extra values are broadcast.
+/// \param eclIO          the restart reader, only given on the I/O rank 0
+/// \param globalIndices  the global index of every local cell
 RestartValue loadParallelRestart(const EclipseIO* eclIO, Action::State& actionState, SummaryState& summaryState,
                                  const std::vector<RestartKey>& solutionKeys,
                                  const std::vector<RestartKey>& extraKeys,
+                                 const std::vector<int>& globalIndices,
                                  Parallel::Communication comm);
 
 } // end namespace Opm
@@ -50,8 +50,9 @@ void eclStateBroadcast(Parallel::Communication comm, EclipseState& eclState, Sch
                        WellTestState&  wtestState)
 {
     Opm::EclMpiSerializer ser(comm);
-    ser.broadcast(eclState);
-    ser.broadcast(schedule);
+    // The serialized state and schedule are large, send them once per node.
+    ser.broadcastNodeShared(eclState);
+    ser.broadcastNodeShared(schedule);
     ser.broadcast(summaryConfig);
     ser.broadcast(udqState);
     ser.broadcast(actionState);
@@ -65,8 +66,22 @@ void eclBroadcast(Parallel::Communication comm, T& data)
     ser.broadcast(data);
 }
 
+template <class T>
+void eclBroadcastUpdate(Parallel::Communication comm, T& data,
+                        const std::function<void()>& update)
+{
+    Opm::EclMpiSerializer ser(comm);
+    std::vector<char> previous;
+    if (comm.size() > 1)
+        previous = ser.serialized(data);
+    update();
+    ser.broadcastChanges(data, std::move(previous));
+}
+
 
 template void eclBroadcast<TransMult>(Parallel::Communication, TransMult&);
 template void eclBroadcast<Schedule>(Parallel::Communication, Schedule&);
+template void eclBroadcastUpdate<TransMult>(Parallel::Communication, TransMult&,
+                                            const std::function<void()>&);
 
 }
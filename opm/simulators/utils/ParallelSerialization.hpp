@@ -21,6 +21,8 @@
 
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
+#include <functional>
+
 namespace Opm {
 
 class EclipseState;
@@ -55,6 +57,22 @@ void eclBroadcast(Parallel::Communication, T& )
 {}
 #endif
 
+/*! \brief Applies an update to an object and broadcasts the result from the
+ *!        root node in parallel runs.
+ *! \details Only the parts of the serialized object which were changed by
+ *!          the update on the root node are sent to the other processes.
+ *!          The object must be the same on all processes before the update.
+ *! \param data Object to update and broadcast
+ *! \param update Function applying the update to data, called on all processes
+*/
+template <class T>
+void eclBroadcastUpdate(Parallel::Communication, T&,
+                        const std::function<void()>& update)
+#if HAVE_MPI
+;
+#else
+{ update(); }
+#endif
 
 } // end namespace Opm
 
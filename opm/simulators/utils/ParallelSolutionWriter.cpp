@@ -0,0 +1,229 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/ParallelSolutionWriter.hpp>
+
+#include <opm/output/data/Solution.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+void append(std::vector<char>& buffer, const void* data, const std::size_t size)
+{
+    const auto* bytes = static_cast<const char*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+// The names of the arrays are stored in 8 characters, as in the ECL files.
+// A longer name would be truncated, possibly to the name of another array.
+void checkNames(const Opm::data::Solution& cellData)
+{
+    std::set<std::string> padded;
+    for (const auto& entry : cellData) {
+        const auto& name = entry.first;
+        if (name.size() > 8) {
+            throw std::invalid_argument("The name of array " + name + " of the parallel "
+                                        "solution file is longer than 8 characters");
+        }
+        if (!padded.insert(name + std::string(8 - name.size(), ' ')).second) {
+            throw std::invalid_argument("The name of array " + name + " of the parallel "
+                                        "solution file is not unique in 8 characters");
+        }
+    }
+}
+
+std::vector<char> header(const Opm::data::Solution& cellData,
+                         const std::size_t numGlobalCells)
+{
+    std::vector<char> buffer;
+    append(buffer, "OPMPSOL1", 8);
+    const std::int64_t numCells = numGlobalCells;
+    const std::int64_t numArrays = cellData.size();
+    append(buffer, &numCells, sizeof(numCells));
+    append(buffer, &numArrays, sizeof(numArrays));
+    for (const auto& [name, data] : cellData) {
+        char padded[8];
+        std::fill(padded, padded + 8, ' ');
+        std::copy(name.begin(), name.end(), padded);
+        append(buffer, padded, 8);
+        const std::int64_t measure = static_cast<std::int64_t>(data.dim);
+        append(buffer, &measure, sizeof(measure));
+    }
+    return buffer;
+}
+
+// An MPI-IO call may fail on some of the processes only. Its status is
+// therefore reduced over all of them, so that they throw together instead
+// of the others waiting in the next collective call.
+void check(const Opm::Parallel::Communication& comm, const int status,
+           const std::string& what, const std::string& filename)
+{
+    if (comm.max(status != MPI_SUCCESS ? 1 : 0) > 0) {
+        throw std::runtime_error(what + " of parallel solution file " + filename + " failed");
+    }
+}
+
+// Closes the file on all processes when they throw together.
+struct FileCloser
+{
+    MPI_File* file;
+    ~FileCloser()
+    {
+        if (file != nullptr) {
+            MPI_File_close(file);
+        }
+    }
+};
+
+struct TypeFreer
+{
+    MPI_Datatype* type;
+    ~TypeFreer() { MPI_Type_free(type); }
+};
+
+void read(std::ifstream& is, void* data, const std::size_t size,
+          const std::string& filename)
+{
+    if (!is.read(static_cast<char*>(data), size)) {
+        throw std::runtime_error("Reading parallel solution file " + filename + " failed");
+    }
+}
+
+} // anonymous namespace
+
+namespace Opm
+{
+
+void writeParallelSolution(Parallel::Communication comm,
+                           const std::string& filename,
+                           const data::Solution& cellData,
+                           const std::vector<int>& localIndex,
+                           const std::vector<int>& globalIndex,
+                           const std::size_t numGlobalCells)
+{
+    assert(localIndex.size() == globalIndex.size());
+
+    // The arrays are the same on all processes, which therefore all reject
+    // them before any collective call.
+    checkNames(cellData);
+
+    MPI_Comm mpiComm = comm;
+    MPI_File file;
+    check(comm, MPI_File_open(mpiComm, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                              MPI_INFO_NULL, &file), "Opening", filename);
+    FileCloser closer{&file};
+
+    const auto head = header(cellData, numGlobalCells);
+    const MPI_Offset arraySize = numGlobalCells * sizeof(double);
+    check(comm, MPI_File_set_size(file, head.size() + cellData.size() * arraySize),
+          "Resizing", filename);
+    int status = MPI_SUCCESS;
+    if (comm.rank() == 0) {
+        status = MPI_File_write_at(file, 0, head.data(), head.size(), MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+    check(comm, status, "Writing the header", filename);
+
+    // Each process writes its cells at their global positions, in
+    // increasing order as MPI-IO requires of the file view.
+    const int numCells = localIndex.size();
+    std::vector<int> order(numCells);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&globalIndex](const int a, const int b) { return globalIndex[a] < globalIndex[b]; });
+    std::vector<int> displacements(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        displacements[i] = globalIndex[order[i]];
+    }
+
+    MPI_Datatype fileType;
+    MPI_Type_create_indexed_block(numCells, 1, displacements.data(), MPI_DOUBLE, &fileType);
+    MPI_Type_commit(&fileType);
+    TypeFreer freer{&fileType};
+
+    std::vector<double> values(numCells);
+    MPI_Offset offset = head.size();
+    for (const auto& entry : cellData) {
+        const auto& data = entry.second.data;
+        for (int i = 0; i < numCells; ++i) {
+            values[i] = data[localIndex[order[i]]];
+        }
+        check(comm, MPI_File_set_view(file, offset, MPI_DOUBLE, fileType, "native", MPI_INFO_NULL),
+              "Setting the view", filename);
+        check(comm, MPI_File_write_all(file, values.data(), numCells, MPI_DOUBLE, MPI_STATUS_IGNORE),
+              "Writing " + entry.first, filename);
+        offset += arraySize;
+    }
+
+    closer.file = nullptr;
+    check(comm, MPI_File_close(&file), "Closing", filename);
+}
+
+data::Solution readParallelSolution(const std::string& filename)
+{
+    std::ifstream is(filename, std::ios::binary);
+    if (!is) {
+        throw std::runtime_error("Opening parallel solution file " + filename + " failed");
+    }
+
+    char magic[8];
+    read(is, magic, 8, filename);
+    if (std::memcmp(magic, "OPMPSOL1", 8) != 0) {
+        throw std::runtime_error(filename + " is not a parallel solution file");
+    }
+    std::int64_t numCells = 0;
+    std::int64_t numArrays = 0;
+    read(is, &numCells, sizeof(numCells), filename);
+    read(is, &numArrays, sizeof(numArrays), filename);
+    if (numCells < 0 || numArrays < 0) {
+        throw std::runtime_error(filename + " is not a parallel solution file");
+    }
+
+    std::vector<std::pair<std::string, std::int64_t>> arrays(numArrays);
+    for (auto& [name, measure] : arrays) {
+        char padded[8];
+        read(is, padded, 8, filename);
+        name.assign(padded, 8);
+        name.erase(name.find_last_not_of(' ') + 1);
+        read(is, &measure, sizeof(measure), filename);
+    }
+
+    data::Solution cellData;
+    for (const auto& [name, measure] : arrays) {
+        std::vector<double> values(numCells);
+        read(is, values.data(), numCells * sizeof(double), filename);
+        cellData.insert(name, static_cast<UnitSystem::measure>(measure),
+                        std::move(values), data::TargetType::RESTART_SOLUTION);
+    }
+    return cellData;
+}
+
+} // namespace Opm
@@ -0,0 +1,75 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARALLELSOLUTIONWRITER_HEADER_INCLUDED
+#define OPM_PARALLELSOLUTIONWRITER_HEADER_INCLUDED
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+namespace data { class Solution; }
+
+/// Write the cell data of all processes into one file with collective
+/// MPI-IO, without gathering it on a single process.
+///
+/// The file starts with the magic string "OPMPSOL1", followed by the number
+/// of global cells and the number of arrays as 64 bit integers, and for each
+/// array its name, padded with blanks to 8 characters, and its unit measure
+/// as a 64 bit integer. The arrays follow in the same order, each with one
+/// double per global cell in SI units, ordered by the global (active) cell
+/// index like the arrays of an ECL restart file.
+///
+/// Array names longer than 8 characters are rejected with an
+/// std::invalid_argument. If an MPI-IO call fails on any process, all
+/// processes throw an std::runtime_error.
+///
+/// \param[in] comm            the processes writing the file, all must call this
+/// \param[in] filename        name of the file, it is overwritten
+/// \param[in] cellData        the cell data of this process, the same arrays
+///                            on all processes
+/// \param[in] localIndex      index in the cell data arrays of the cells
+///                            written by this process
+/// \param[in] globalIndex     global cell index of each of these cells, every
+///                            global cell must be written by one process
+/// \param[in] numGlobalCells  the number of cells of the global grid
+void writeParallelSolution(Parallel::Communication comm,
+                           const std::string& filename,
+                           const data::Solution& cellData,
+                           const std::vector<int>& localIndex,
+                           const std::vector<int>& globalIndex,
+                           std::size_t numGlobalCells);
+
+/// Read a file written by writeParallelSolution() on a single process.
+///
+/// The arrays are returned with all global cells, ordered by the global cell
+/// index, as restart solution arrays. An std::runtime_error is thrown if the
+/// file cannot be read or is not a parallel solution file.
+///
+/// \param[in] filename  name of the file
+data::Solution readParallelSolution(const std::string& filename);
+
+} // namespace Opm
+
+#endif // OPM_PARALLELSOLUTIONWRITER_HEADER_INCLUDED
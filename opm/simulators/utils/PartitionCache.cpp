@@ -0,0 +1,116 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/PartitionCache.hpp>
+
+#include <opm/input/eclipse/Schedule/Well/Well.hpp>
+#include <opm/input/eclipse/Schedule/Well/WellConnections.hpp>
+#include <opm/simulators/utils/CacheFile.hpp>
+
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+// Bumped whenever the layout of the cache file changes.
+constexpr Opm::CacheMagic cacheMagic {'O', 'P', 'M', 'P', 'A', 'R', 'T', '1'};
+
+} // anonymous namespace
+
+namespace Opm
+{
+
+PartitionCacheKey partitionCacheKey(int numProcesses,
+                                    const std::vector<int>& globalCell,
+                                    const std::vector<Well>& wells,
+                                    int edgeWeightsMethod,
+                                    double imbalanceTol,
+                                    bool distributedWells)
+{
+    Fnv1aHash hash;
+    for (const int cell : globalCell) {
+        hash.add(cell);
+    }
+    hash.add(wells.size());
+    for (const auto& well : wells) {
+        hash.add(well.name());
+        hash.add(well.getConnections().size());
+        for (const auto& connection : well.getConnections()) {
+            hash.add(connection.global_index());
+        }
+    }
+    hash.add(edgeWeightsMethod);
+    hash.add(imbalanceTol);
+    hash.add(distributedWells);
+
+    return {static_cast<std::uint64_t>(numProcesses), globalCell.size(), hash.value()};
+}
+
+std::optional<std::vector<int>> loadPartitionCache(const std::string& cacheFile,
+                                                   const PartitionCacheKey& key)
+{
+    std::ifstream is(cacheFile, std::ios::binary);
+    if (!is) {
+        return std::nullopt;
+    }
+
+    if (!readCacheMagic(is, cacheMagic)) {
+        return std::nullopt;
+    }
+
+    PartitionCacheKey cached;
+    cached.numProcesses = readCacheValue(is);
+    cached.numCells = readCacheValue(is);
+    cached.hash = readCacheValue(is);
+    if (!is || !(cached == key)) {
+        return std::nullopt;
+    }
+
+    std::vector<int> parts(key.numCells);
+    is.read(reinterpret_cast<char*>(parts.data()), parts.size() * sizeof(int));
+    if (!is) {
+        return std::nullopt;
+    }
+    for (const int part : parts) {
+        if (part < 0 || static_cast<std::uint64_t>(part) >= key.numProcesses) {
+            return std::nullopt;
+        }
+    }
+    return parts;
+}
+
+void writePartitionCache(const std::string& cacheFile,
+                         const PartitionCacheKey& key,
+                         const std::vector<int>& parts)
+{
+    if (parts.size() != key.numCells) {
+        throw std::logic_error("The partition does not match the number of cells of its key");
+    }
+
+    writeCacheFile(cacheFile, [&key, &parts](std::ostream& os) {
+        writeCacheMagic(os, cacheMagic);
+        writeCacheValue(os, key.numProcesses);
+        writeCacheValue(os, key.numCells);
+        writeCacheValue(os, key.hash);
+        os.write(reinterpret_cast<const char*>(parts.data()), parts.size() * sizeof(int));
+    });
+}
+
+} // namespace Opm
@@ -0,0 +1,90 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARTITIONCACHE_HEADER_INCLUDED
+#define OPM_PARTITIONCACHE_HEADER_INCLUDED
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+class Well;
+
+/// Cache of a computed partition of the grid.
+///
+/// The cache file holds the process of every active cell together with a
+/// key of the setup the partition was computed for. A cache is only used
+/// if the key matches, so repeated runs of the same grid on the same
+/// number of processes skip the graph partitioner and get the same
+/// distribution of cells and wells.
+
+/// The setup a partition was computed for.
+struct PartitionCacheKey
+{
+    std::uint64_t numProcesses = 0;
+    std::uint64_t numCells = 0;
+    /// Hash of the active cells, the well connections and the parameters
+    /// of the partitioner.
+    std::uint64_t hash = 0;
+
+    bool operator==(const PartitionCacheKey& other) const
+    {
+        return numProcesses == other.numProcesses &&
+               numCells == other.numCells &&
+               hash == other.hash;
+    }
+};
+
+/// Compute the key of a partitioning setup.
+/// \param[in] numProcesses       number of processes of the partition
+/// \param[in] globalCell         Cartesian index of every active cell
+/// \param[in] wells              the wells the partitioner keeps together
+/// \param[in] edgeWeightsMethod  edge weights of the partitioner
+/// \param[in] imbalanceTol       tolerated imbalance of the partitioner
+/// \param[in] distributedWells   whether wells may be distributed
+PartitionCacheKey partitionCacheKey(int numProcesses,
+                                    const std::vector<int>& globalCell,
+                                    const std::vector<Well>& wells,
+                                    int edgeWeightsMethod,
+                                    double imbalanceTol,
+                                    bool distributedWells);
+
+/// Read a partition from a cache file.
+/// \param[in] cacheFile  name of the cache file
+/// \param[in] key        key of the current setup
+/// \return               the process of every active cell, or nothing if
+///                       there is no cache for key
+std::optional<std::vector<int>> loadPartitionCache(const std::string& cacheFile,
+                                                   const PartitionCacheKey& key);
+
+/// Write a partition to a cache file.
+/// \param[in] cacheFile  name of the cache file
+/// \param[in] key        key of the setup the partition was computed for
+/// \param[in] parts      the process of every active cell
+void writePartitionCache(const std::string& cacheFile,
+                         const PartitionCacheKey& key,
+                         const std::vector<int>& parts);
+
+} // namespace Opm
+
+#endif // OPM_PARTITIONCACHE_HEADER_INCLUDED
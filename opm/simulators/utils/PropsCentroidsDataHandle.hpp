@@ -35,6 +35,8 @@
 #include <dune/common/parallel/mpihelper.hh>
 #include <unordered_map>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 namespace Opm
 {
@@ -93,9 +95,20 @@ public:
             // Unpack Calculator as we need it here, too.
             m_distributed_fieldProps.deserialize_tran( std::vector<char>(buffer.begin() + calcStart, buffer.end()) );
 
-            // copy data to persistent map based on local id
+            // Remember where the data of each element is found. The values
+            // are read from the global properties when they are sent, rather
+            // than holding a second copy of all of them on the root process.
             m_no_data = m_intKeys.size() + m_doubleKeys.size() +
                 Grid::dimensionworld;
+            m_eclGridOnRoot = eclGridOnRoot;
+            for (const auto& intKey : m_intKeys)
+                m_rootIntData.push_back(&globalProps.get_int_field_data(intKey));
+            for (const auto& doubleKey : m_doubleKeys)
+                // We need to allow unsupported keywords to get the data
+                // for TranCalculator, too.
+                m_rootDoubleData.push_back(&globalProps.get_double_field_data(doubleKey,
+                                                                              /* allow_unsupported = */ true));
+
             const auto& idSet = m_grid.localIdSet();
             const auto& gridView = m_grid.levelGridView(0);
             using ElementMapper =
@@ -104,32 +117,9 @@ public:
 
             for( const auto &element : elements( gridView, Dune::Partitions::interiorBorder ) )
             {
-                const auto& id = idSet.id(element);
                 auto index = elemMapper.index(element);
-                auto& data = elementData_[id];
-                data.reserve(m_no_data);
-
-                for (const auto& intKey : m_intKeys)
-                {
-                    const auto& fieldData = globalProps.get_int_field_data(intKey);
-                    data.emplace_back(fieldData.data[index],
-                                      static_cast<unsigned char>(fieldData.value_status[index]));
-                }
-
-                for (const auto& doubleKey : m_doubleKeys)
-                {
-                    // We need to allow unsupported keywords to get the data
-                    // for TranCalculator, too.
-                    const auto& fieldData = globalProps.get_double_field_data(doubleKey,
-                                                                              /* allow_unsupported = */ true);
-                    data.emplace_back(fieldData.data[index],
-                                      static_cast<unsigned char>(fieldData.value_status[index]));
-                }
-
-                auto cartIndex = cartMapper.cartesianIndex(index);
-                const auto& center = eclGridOnRoot->getCellCenter(cartIndex);
-                for (int dim = 0; dim < Grid::dimensionworld; ++dim)
-                    data.emplace_back(center[dim], '1'); // write garbage for value_status
+                m_rootIndices.emplace(idSet.id(element),
+                                      std::make_pair(index, cartMapper.cartesianIndex(index)));
             }
         }
         else
@@ -176,19 +166,31 @@ public:
             std::size_t counter{};
             const auto& id = idSet.id(element);
             auto index = elemMapper.index(element);
+            std::vector<DataType> rootData;
+            const std::vector<DataType>* values = nullptr;
             auto data = elementData_.find(id);
-            assert(data != elementData_.end());
+            if (data != elementData_.end()) {
+                values = &data->second;
+            } else {
+                // element kept by the root process and not scattered to it
+                auto root = m_rootIndices.find(id);
+                assert(root != m_rootIndices.end());
+                rootData.reserve(m_no_data);
+                forEachRootValue(root->second,
+                                 [&rootData](const DataType& value) { rootData.push_back(value); });
+                values = &rootData;
+            }
 
             for(const auto& intKey : m_intKeys)
             {
-                const auto& pair = data->second[counter++];
+                const auto& pair = (*values)[counter++];
                 m_distributed_fieldProps.m_intProps[intKey].data[index] = static_cast<int>(pair.first);
                 m_distributed_fieldProps.m_intProps[intKey].value_status[index] = static_cast<value::status>(pair.second);
             }
 
             for(const auto& doubleKey : m_doubleKeys)
             {
-                const auto& pair = data->second[counter++];
+                const auto& pair = (*values)[counter++];
                 m_distributed_fieldProps.m_doubleProps[doubleKey].data[index] = pair.first;
                 m_distributed_fieldProps.m_doubleProps[doubleKey].value_status[index] = static_cast<value::status>(pair.second);
             }
@@ -196,7 +198,7 @@ public:
             auto centroidIter = m_centroids.begin() + Grid::dimensionworld * index;
             auto centroidIterEnd = centroidIter + Grid::dimensionworld;
             for ( ; centroidIter != centroidIterEnd; ++centroidIter )
-                *centroidIter = data->second[counter++].first; // value_status discarded
+                *centroidIter = (*values)[counter++].first; // value_status discarded
         }
     }
 
@@ -223,7 +225,15 @@ public:
     template<class BufferType, class EntityType>
     void gather(BufferType& buffer, const EntityType& e) const
     {
-        auto iter = elementData_.find(m_grid.localIdSet().id(e));
+        const auto& id = m_grid.localIdSet().id(e);
+        auto root = m_rootIndices.find(id);
+        if (root != m_rootIndices.end()) {
+            forEachRootValue(root->second,
+                             [&buffer](const DataType& value) { buffer.write(value); });
+            return;
+        }
+
+        auto iter = elementData_.find(id);
         assert(iter != elementData_.end());
         for(const auto& data : iter->second)
         {
@@ -245,6 +255,27 @@ public:
 
 private:
     using LocalIdSet = typename Grid::LocalIdSet;
+
+    //! \brief Calls func for the values of an element in the global
+    //!        properties, given its index in the global grid and its
+    //!        cartesian index.
+    template<class Func>
+    void forEachRootValue(const std::pair<std::size_t, std::size_t>& indices, Func&& func) const
+    {
+        const auto [index, cartIndex] = indices;
+        for (const auto* fieldData : m_rootIntData)
+            func(DataType(fieldData->data[index],
+                          static_cast<unsigned char>(fieldData->value_status[index])));
+
+        for (const auto* fieldData : m_rootDoubleData)
+            func(DataType(fieldData->data[index],
+                          static_cast<unsigned char>(fieldData->value_status[index])));
+
+        const auto& center = m_eclGridOnRoot->getCellCenter(cartIndex);
+        for (int dim = 0; dim < Grid::dimensionworld; ++dim)
+            func(DataType(center[dim], '1')); // write garbage for value_status
+    }
+
     const Grid& m_grid;
     //! \brief The distributed field properties for receiving
     ParallelFieldPropsManager& m_distributed_fieldProps;
@@ -258,6 +289,15 @@ private:
     std::unordered_map<typename LocalIdSet::IdType, std::vector<std::pair<double,unsigned char> > > elementData_;
     /// \brief The cell centroids of the distributed grid.
     std::vector<double>& m_centroids;
+    /// \brief Global grid and cartesian index of the elements on the root
+    ///        process, mapped from the local id.
+    std::unordered_map<typename LocalIdSet::IdType, std::pair<std::size_t, std::size_t>> m_rootIndices;
+    /// \brief The integer fields of the global properties, on the root process.
+    std::vector<const Fieldprops::FieldData<int>*> m_rootIntData;
+    /// \brief The double fields of the global properties, on the root process.
+    std::vector<const Fieldprops::FieldData<double>*> m_rootDoubleData;
+    /// \brief The eclipse grid on the root process.
+    const EclipseGrid* m_eclGridOnRoot = nullptr;
     /// \brief The amount of data to send for each element
     std::size_t m_no_data;
 };
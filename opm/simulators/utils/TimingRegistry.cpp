@@ -0,0 +1,184 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/TimingRegistry.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace Opm
+{
+
+std::array<TimingRegistry::Entry, TimingRegistry::numRegions> TimingRegistry::entries_{};
+
+const char* TimingRegistry::name(const Region region)
+{
+    switch (region) {
+    case Region::Assembly:          return "Assembly";
+    case Region::WellAssembly:      return "Well assembly";
+    case Region::WellSolve:         return "Well solve";
+    case Region::LinearSolverSetup: return "Linear solver setup";
+    case Region::LinearSolve:       return "Linear solve";
+    case Region::IluDecomposition:  return "ILU decomposition";
+    case Region::CprSetup:          return "CPR setup";
+    case Region::CprApply:          return "CPR apply";
+    case Region::MpiWait:           return "MPI wait";
+    case Region::ConvergenceReduction: return "Convergence reduction";
+    case Region::ConvergenceGather: return "Convergence gather";
+    case Region::WellCommunication: return "Well communication";
+    case Region::OutputGather:      return "Output gather";
+    case Region::OutputWrite:       return "Output write";
+    case Region::ReadDeck:          return "Read deck";
+    case Region::GridCreation:      return "Grid creation";
+    case Region::LoadBalance:       return "Load balance";
+    case Region::Transmissibilities: return "Transmissibilities";
+    case Region::InitialCondition:  return "Initial condition";
+    case Region::WellSetup:         return "Well setup";
+    case Region::WriteInit:         return "Write INIT";
+    case Region::NumRegions:        break;
+    }
+    return "Unknown";
+}
+
+bool TimingRegistry::isCollective(const Region region)
+{
+    switch (region) {
+    case Region::MpiWait:
+    case Region::ConvergenceReduction:
+    case Region::ConvergenceGather:
+    case Region::WellCommunication:
+    case Region::OutputGather:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool TimingRegistry::isStartup(const Region region)
+{
+    return region >= Region::ReadDeck && region < Region::NumRegions;
+}
+
+void TimingRegistry::reset()
+{
+    entries_.fill(Entry{});
+}
+
+std::string TimingRegistry::report(const Parallel::Communication& comm, const double totalTime)
+{
+    // The last entry is the time of this process in the collective regions.
+    std::vector<double> min(numRegions + 1), max(numRegions + 1), mean(numRegions + 1), count(numRegions);
+    double wait = 0.0;
+    for (std::size_t i = 0; i < numRegions; ++i) {
+        min[i] = max[i] = mean[i] = entries_[i].time;
+        count[i] = entries_[i].count;
+        if (isCollective(static_cast<Region>(i))) {
+            wait += entries_[i].time;
+        }
+    }
+    min[numRegions] = max[numRegions] = mean[numRegions] = wait;
+    comm.min(min.data(), numRegions + 1);
+    comm.max(max.data(), numRegions + 1);
+    comm.sum(mean.data(), numRegions + 1);
+    comm.max(count.data(), numRegions);
+    for (auto& m : mean) {
+        m /= comm.size();
+    }
+
+    auto imbalance = [&mean, &max](const std::size_t i) {
+        return mean[i] > 0.0 ? max[i] / mean[i] : 1.0;
+    };
+
+    std::string table = fmt::format("{:<22} {:>10} {:>12} {:>12} {:>12} {:>10}\n",
+                                    "Region", "Count", "Min (s)", "Mean (s)", "Max (s)", "Imbalance");
+    for (std::size_t i = 0; i < numRegions; ++i) {
+        if (count[i] == 0) {
+            continue;
+        }
+        table += fmt::format("{:<22} {:>10} {:>12.3f} {:>12.3f} {:>12.3f} {:>10.2f}\n",
+                             name(static_cast<Region>(i)),
+                             static_cast<unsigned long>(count[i]),
+                             min[i], mean[i], max[i], imbalance(i));
+    }
+    if (comm.size() > 1 && totalTime > 0.0) {
+        table += fmt::format("Time in collectives: {:.3f} s min, {:.3f} s mean, {:.3f} s max, "
+                             "{:.1f}% of the run on average\n",
+                             min[numRegions], mean[numRegions], max[numRegions],
+                             100.0 * mean[numRegions] / totalTime);
+    }
+    return table;
+}
+
+std::string TimingRegistry::startupReport(const Parallel::Communication& comm,
+                                          const std::string& jsonFile)
+{
+    constexpr std::size_t first = static_cast<std::size_t>(Region::ReadDeck);
+    constexpr std::size_t numStartup = numRegions - first;
+    std::array<double, numStartup> local;
+    for (std::size_t i = 0; i < numStartup; ++i) {
+        local[i] = entries_[first + i].time;
+    }
+    // the times of all processes, by process
+    std::vector<double> all(numStartup * comm.size());
+    comm.allgather(local.data(), numStartup, all.data());
+
+    std::string table = fmt::format("{:<22} {:>12} {:>12} {:>12} {:>12}\n",
+                                    "Startup phase", "Min (s)", "Mean (s)", "Max (s)", "Max on rank");
+    std::string json = "{";
+    double total = 0.0;
+    for (std::size_t i = 0; i < numStartup; ++i) {
+        double min = all[i];
+        double max = all[i];
+        double mean = 0.0;
+        int maxRank = 0;
+        std::string times;
+        for (int rank = 0; rank < comm.size(); ++rank) {
+            const double t = all[rank * numStartup + i];
+            min = std::min(min, t);
+            if (t > max) {
+                max = t;
+                maxRank = rank;
+            }
+            mean += t;
+            times += fmt::format("{}{:.6g}", rank > 0 ? ", " : "", t);
+        }
+        mean /= comm.size();
+        total += max;
+        const char* phase = name(static_cast<Region>(first + i));
+        table += fmt::format("{:<22} {:>12.3f} {:>12.3f} {:>12.3f} {:>12}\n",
+                             phase, min, mean, max, maxRank);
+        json += fmt::format("{}\"{}\": {{\"min\": {:.6g}, \"mean\": {:.6g}, \"max\": {:.6g}"
+                            ", \"max_rank\": {}, \"ranks\": [{}]}}",
+                            i > 0 ? ", " : "", phase, min, mean, max, maxRank, times);
+    }
+    table += fmt::format("Sum of the slowest processes: {:.3f} s\n", total);
+    json += "}\n";
+
+    if (!jsonFile.empty() && comm.rank() == 0) {
+        std::ofstream os(jsonFile);
+        os << json;
+    }
+    return table;
+}
+
+} // namespace Opm
@@ -0,0 +1,143 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_TIMINGREGISTRY_HEADER_INCLUDED
+#define OPM_TIMINGREGISTRY_HEADER_INCLUDED
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace Opm
+{
+
+/// Accumulated wall clock times and counts of the main parts of a run.
+///
+/// The regions are a fixed enumeration, so recording a measurement is an
+/// update of an array entry without any lookup, and the timers can stay
+/// enabled in production runs. The registry is not thread safe, the timers
+/// must not be used within threaded regions.
+class TimingRegistry
+{
+public:
+    enum class Region {
+        Assembly,           // reservoir and well linearization
+        WellAssembly,       // well linearization, part of Assembly
+        WellSolve,          // iterations of the well equations
+        LinearSolverSetup,
+        LinearSolve,
+        IluDecomposition,
+        CprSetup,
+        CprApply,
+        MpiWait,            // dot products and norms of the Krylov solvers
+        ConvergenceReduction, // reductions of the residuals and pore volumes
+        ConvergenceGather,  // gathering the convergence reports of the processes
+        WellCommunication,  // collectives of the wells spanning several processes
+        OutputGather,       // gathering the output data on the I/O rank
+        OutputWrite,
+        // startup phases
+        ReadDeck,           // parsing the deck, creating the state and schedule
+        GridCreation,
+        LoadBalance,        // partitioning and distributing the grid and fields
+        Transmissibilities, // also the global ones, part of LoadBalance
+        InitialCondition,   // equilibration or reading the restart file
+        WellSetup,
+        WriteInit,          // EGRID, INIT and the other static files
+        NumRegions
+    };
+
+    struct Entry
+    {
+        double time = 0.0;
+        unsigned long count = 0;
+    };
+
+    static void add(const Region region, const double seconds)
+    {
+        auto& entry = entries_[static_cast<std::size_t>(region)];
+        entry.time += seconds;
+        ++entry.count;
+    }
+
+    /// The measurements of this process
+    static const Entry& entry(const Region region)
+    {
+        return entries_[static_cast<std::size_t>(region)];
+    }
+
+    static const char* name(Region region);
+
+    static void reset();
+
+    /// Whether the time of a region is spent in collective communication
+    static bool isCollective(Region region);
+
+    /// Whether the region is a phase of the startup of a run
+    static bool isStartup(Region region);
+
+    /// Table of the count and the minimum, mean and maximum time of every
+    /// region over all processes, with the ratio of the maximum to the mean
+    /// as the imbalance. The time of the collective regions is mostly spent
+    /// waiting for the slowest process, and its share of totalTime is
+    /// summarised below the table. Collective, the table is the same on all
+    /// processes.
+    static std::string report(const Parallel::Communication& comm, double totalTime);
+
+    /// Table of the minimum, mean and maximum time of the startup phases
+    /// over all processes, with the rank of the slowest process. If jsonFile
+    /// is not empty, the time of every process is also written to it as a
+    /// JSON object by the first process. Collective.
+    static std::string startupReport(const Parallel::Communication& comm,
+                                     const std::string& jsonFile = "");
+
+private:
+    static constexpr std::size_t numRegions = static_cast<std::size_t>(Region::NumRegions);
+    static std::array<Entry, numRegions> entries_;
+};
+
+/// Adds the wall clock time of its lifetime to a region of the TimingRegistry.
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(const TimingRegistry::Region region)
+        : region_(region)
+        , start_(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedTimer()
+    {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+        TimingRegistry::add(region_, elapsed.count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    TimingRegistry::Region region_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace Opm
+
+#endif // OPM_TIMINGREGISTRY_HEADER_INCLUDED
@@ -56,6 +56,10 @@
 
 #include <opm/simulators/flow/KeywordValidation.hpp>
 #include <opm/simulators/flow/ValidationFunctions.hpp>
+#if HAVE_MPI
+#include <opm/simulators/utils/DeckCache.hpp>
+#endif
+#include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/simulators/utils/ParallelEclipseState.hpp>
 #include <opm/simulators/utils/ParallelSerialization.hpp>
 #include <opm/simulators/utils/PartiallySupportedFlowKeywords.hpp>
@@ -197,14 +201,52 @@ namespace {
     }
 
     std::shared_ptr<Opm::Deck>
-    readDeckFile(const std::string&       deckFilename,
+    parseDeckFile([[maybe_unused]] Opm::Parallel::Communication comm,
+                  const std::string&                            deckFilename,
+                  [[maybe_unused]] const std::string&           deckCacheFile,
+                  const Opm::Parser&                            parser,
+                  const Opm::ParseContext&                      parseContext,
+                  Opm::ErrorGuard&                              errorGuard)
+    {
+#if HAVE_MPI
+        if (! deckCacheFile.empty()) {
+            auto deck = Opm::loadDeckCache(comm, deckCacheFile, deckFilename, parseContext);
+            if (deck != nullptr) {
+                Opm::OpmLog::info(fmt::format("Deck read from cache file '{}'", deckCacheFile));
+                return deck;
+            }
+        }
+#endif
+
+        auto deck = std::make_shared<Opm::Deck>
+            (parser.parseFile(deckFilename, parseContext, errorGuard));
+
+#if HAVE_MPI
+        if (! deckCacheFile.empty() && ! errorGuard) {
+            try {
+                Opm::writeDeckCache(comm, deckCacheFile, deckFilename, parseContext, *deck);
+            }
+            catch (const std::exception& e) {
+                Opm::OpmLog::warning(fmt::format("Writing the deck cache file '{}' failed: {}",
+                                                 deckCacheFile, e.what()));
+            }
+        }
+#endif
+
+        return deck;
+    }
+
+    std::shared_ptr<Opm::Deck>
+    readDeckFile(Opm::Parallel::Communication comm,
+                 const std::string&       deckFilename,
+                 const std::string&       deckCacheFile,
                  const bool               checkDeck,
                  const Opm::Parser&       parser,
                  const Opm::ParseContext& parseContext,
                  Opm::ErrorGuard&         errorGuard)
     {
-        auto deck = std::make_shared<Opm::Deck>
-            (parser.parseFile(deckFilename, parseContext, errorGuard));
+        auto deck = parseDeckFile(comm, deckFilename, deckCacheFile,
+                                  parser, parseContext, errorGuard);
 
         auto keyword_validator = Opm::KeywordValidation::KeywordValidator {
             Opm::FlowKeywordValidation::unsupportedKeywords(),
@@ -236,6 +278,7 @@ namespace {
 
     void readOnIORank(Opm::Parallel::Communication         comm,
                       const std::string&                   deckFilename,
+                      const std::string&                   deckCacheFile,
                       const Opm::ParseContext*             parseContext,
                       std::shared_ptr<Opm::Deck>&          deck,
                       std::shared_ptr<Opm::EclipseState>&  eclipseState,
@@ -260,7 +303,7 @@ namespace {
 
         auto parser = Opm::Parser{};
         if (deck == nullptr) {
-            deck = readDeckFile(deckFilename, checkDeck, parser,
+            deck = readDeckFile(comm, deckFilename, deckCacheFile, checkDeck, parser,
                                 *parseContext, errorGuard);
         }
 
@@ -403,6 +446,10 @@ Opm::setupLogging(const int          mpi_rank_,
             std::cerr << "Value " << cmdline_output
                       << " is not a recognized output mode. Using \"all\" instead.\n";
         }
+        // The deferred messages are logged on rank 0, which only has a debug
+        // log backend if the log files are written.
+        DeferredLogger::setDiscardedMessageTypes(output < FileOutputMode::OUTPUT_LOG_ONLY
+                                                 ? Log::MessageType::Debug : 0);
         if (!allRanksDbgLog && mpi_rank_ != 0)
         {
             output = FileOutputMode::OUTPUT_NONE;
@@ -447,7 +494,8 @@ void Opm::readDeck(Opm::Parallel::Communication    comm,
                    std::unique_ptr<ParseContext>   parseContext,
                    const bool                      initFromRestart,
                    const bool                      checkDeck,
-                   const std::optional<int>&       outputInterval)
+                   const std::optional<int>&       outputInterval,
+                   const std::string&              deckCacheFile)
 {
     if (errorGuard == nullptr) {
         errorGuard = std::make_unique<ErrorGuard>();
@@ -458,7 +506,7 @@ void Opm::readDeck(Opm::Parallel::Communication    comm,
 
     if (comm.rank() == 0) { // Always true when !HAVE_MPI
         try {
-            readOnIORank(comm, deckFilename, parseContext.get(), deck,
+            readOnIORank(comm, deckFilename, deckCacheFile, parseContext.get(), deck,
                          eclipseState, schedule, udqState, actionState, wtestState,
                          summaryConfig, std::move(python), initFromRestart,
                          checkDeck, outputInterval, *errorGuard);
@@ -70,7 +70,9 @@ setupLogging(int                mpi_rank_,
 /// \brief Reads the deck and creates all necessary objects if needed
 ///
 /// If pointers already contains objects then they are used otherwise they
-/// are created and can be used outside later.
+/// are created and can be used outside later. If deckCacheFile is given,
+/// the deck is read from that cache, see loadDeckCache(), when it is valid,
+/// and otherwise the cache is written after parsing.
 void readDeck(Parallel::Communication         comm,
               const std::string&              deckFilename,
               std::shared_ptr<Deck>&          deck,
@@ -85,7 +87,8 @@ void readDeck(Parallel::Communication         comm,
               std::unique_ptr<ParseContext>   parseContext,
               bool                            initFromRestart,
               bool                            checkDeck,
-              const std::optional<int>&       outputInterval);
+              const std::optional<int>&       outputInterval,
+              const std::string&              deckCacheFile = "");
 } // end namespace Opm
 
 #endif // OPM_READDECK_HEADER_INCLUDED
@@ -28,6 +28,7 @@
 #include <opm/common/OpmLog/OpmLog.hpp>
 
 #include <cassert>
+#include <exception>
 #include <map>
 #include <memory>
 #include <optional>
@@ -63,6 +64,7 @@
 #include <opm/simulators/wells/RegionAverageCalculator.hpp>
 #include <opm/simulators/wells/WellInterface.hpp>
 #include <opm/simulators/wells/StandardWell.hpp>
+#include <opm/simulators/wells/StandardWellBatch.hpp>
 #include <opm/simulators/wells/MultisegmentWell.hpp>
 #include <opm/simulators/wells/WellGroupHelpers.hpp>
 #include <opm/simulators/wells/WellProdIndexCalculator.hpp>
@@ -168,10 +170,17 @@ namespace Opm {
             // </ eWoms auxiliary module stuff>
             /////////////
 
+            /*!
+             * \brief This method restores the state of the wells from the
+             *        harddisk, after beginEpisode() set up the wells of the
+             *        report step.
+             */
             template <class Restarter>
-            void deserialize(Restarter& /* res */)
+            void deserialize(Restarter& res)
             {
-                // TODO (?)
+                res.deserializeSectionBegin("BlackoilWellModel");
+                this->readWellState(res.deserializeStream());
+                res.deserializeSectionEnd();
             }
 
             /*!
@@ -179,9 +188,11 @@ namespace Opm {
              *        to the harddisk.
              */
             template <class Restarter>
-            void serialize(Restarter& /* res*/)
+            void serialize(Restarter& res)
             {
-                // TODO (?)
+                res.serializeSectionBegin("BlackoilWellModel");
+                this->writeWellState(res.serializeStream());
+                res.serializeSectionEnd();
             }
 
             void beginEpisode()
@@ -308,6 +319,10 @@ namespace Opm {
             // a vector of all the wells.
             std::vector<WellInterfacePtr > well_container_{};
 
+            // report step the objects in well_container_ were created for, -1 once
+            // beginReportStep() recreated the data they refer to
+            int well_container_step_{-1};
+
             std::vector<bool> is_cell_perforated_{};
 
             void initializeWellState(const int           timeStepIdx,
@@ -345,6 +360,44 @@ namespace Opm {
             // used to better efficiency of calcuation
             mutable BVector scaleAddRes_{};
 
+            // the StandardWells in apply(x, Ax) are applied together, rebuilt in linearize()
+            StandardWellBatch<Scalar, numEq> well_batch_{};
+            // indices in well_container_ of the wells that are not in well_batch_
+            std::vector<int> unbatched_wells_{};
+            bool well_batch_valid_{false};
+            // the MultisegmentWells among unbatched_wells_, with threaded_well_assembly_ their
+            // systems D^-1 B x are solved over the OpenMP threads in apply(x, Ax)
+            std::vector<const MultisegmentWell<TypeTag>*> msw_batch_{};
+            mutable std::vector<typename MultisegmentWell<TypeTag>::BVectorWell> msw_solutions_{};
+            mutable std::vector<char> msw_contributes_{};
+
+            // collect the StandardWells in well_batch_, called once the well equations are final
+            void prepareWellBatch();
+
+            // Ax = Ax - C D^-1 B x for the wells in msw_batch_
+            void applyMultisegmentWells(const BVector& x, BVector& Ax) const;
+
+            // the connections of the wells are checked against the sparsity pattern of the
+            // Jacobian at the first linearization after the well container is created
+            bool check_well_pattern_{false};
+
+            // throw if the contributions of a well would be added outside the sparsity pattern
+            void checkWellsInPattern(const typename SparseMatrixAdapter::IstlMatrix& matrix) const;
+
+            // one logger per well for the threaded well assembly, kept between the calls
+            std::vector<DeferredLogger> well_loggers_{};
+            // scratch copies of the well state, one per thread, and the resulting states
+            // of the wells for the threaded well assembly, kept between the calls
+            std::vector<WellState> thread_well_states_{};
+            MemoryAccount thread_well_states_memory_{MemoryRegistry::Owner::WellState};
+            std::vector<std::optional<SingleWellState>> well_results_{};
+
+            // call f(well, well_state, deferred_logger) for every well in well_container_,
+            // with threaded_well_assembly_ the wells are distributed over the OpenMP threads
+            // and well_state is a copy of the well state for the thread
+            template <class Func>
+            void forEachWell(DeferredLogger& deferred_logger, Func&& f);
+
             std::vector<Scalar> B_avg_{};
 
             const Grid& grid() const
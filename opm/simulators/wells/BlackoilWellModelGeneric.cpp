@@ -29,12 +29,18 @@
 #include <opm/output/data/Wells.hpp>
 #include <opm/output/eclipse/RestartValue.hpp>
 
+#include <opm/input/eclipse/Deck/UDAValue.hpp>
 #include <opm/input/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/input/eclipse/Schedule/Group/GuideRateConfig.hpp>
 #include <opm/input/eclipse/Schedule/Group/GuideRate.hpp>
+#include <opm/input/eclipse/Schedule/GasLiftOpt.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
+#include <opm/input/eclipse/Schedule/Well/Well.hpp>
+#include <opm/input/eclipse/Schedule/Well/WellInjectionProperties.hpp>
+#include <opm/input/eclipse/Schedule/Well/WellProductionProperties.hpp>
 #include <opm/input/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
 
+#include <opm/simulators/utils/CheckpointStream.hpp>
 #include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/simulators/wells/GasLiftStage2.hpp>
 #include <opm/simulators/wells/VFPProperties.hpp>
@@ -44,7 +50,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
 #include <stack>
 #include <stdexcept>
 #include <string_view>
@@ -317,6 +327,60 @@ namespace {
     {
         return this->sched_.get().getWell({well.data(), well.size()}, this->reportStepIdx_);
     }
+
+    // Make the control the active control of the well, with the given
+    // target in SI units.
+    void setWellControlTarget(Opm::Well&         well,
+                              const std::string& control,
+                              const double       target)
+    {
+        const auto uda = Opm::UDAValue(target);
+        if (well.isProducer()) {
+            auto prop = std::make_shared<Opm::Well::WellProductionProperties>(well.getProductionProperties());
+            if (! prop->predictionMode) {
+                throw std::invalid_argument {
+                    fmt::format("Well {} is a history matching producer", well.name())
+                };
+            }
+            if      (control == "ORAT") { prop->OilRate    = uda; }
+            else if (control == "WRAT") { prop->WaterRate  = uda; }
+            else if (control == "GRAT") { prop->GasRate    = uda; }
+            else if (control == "LRAT") { prop->LiquidRate = uda; }
+            else if (control == "RESV") { prop->ResVRate   = uda; }
+            else if (control == "BHP")  { prop->BHPTarget  = uda; }
+            else if (control == "THP")  { prop->THPTarget  = uda; }
+            else {
+                throw std::invalid_argument {
+                    fmt::format("Control {} cannot be set for producer {}", control, well.name())
+                };
+            }
+            const auto cmode = Opm::Well::ProducerCModeFromString(control);
+            prop->addProductionControl(cmode);
+            prop->controlMode = cmode;
+            well.updateProduction(prop);
+        }
+        else {
+            auto prop = std::make_shared<Opm::Well::WellInjectionProperties>(well.getInjectionProperties());
+            if (! prop->predictionMode) {
+                throw std::invalid_argument {
+                    fmt::format("Well {} is a history matching injector", well.name())
+                };
+            }
+            if      (control == "RATE") { prop->surfaceInjectionRate   = uda; }
+            else if (control == "RESV") { prop->reservoirInjectionRate = uda; }
+            else if (control == "BHP")  { prop->BHPTarget              = uda; }
+            else if (control == "THP")  { prop->THPTarget              = uda; }
+            else {
+                throw std::invalid_argument {
+                    fmt::format("Control {} cannot be set for injector {}", control, well.name())
+                };
+            }
+            const auto cmode = Opm::Well::InjectorCModeFromString(control);
+            prop->addInjectionControl(cmode);
+            prop->controlMode = cmode;
+            well.updateInjection(prop);
+        }
+    }
 } // Anonymous
 
 namespace Opm {
@@ -354,6 +418,193 @@ BlackoilWellModelGeneric(Schedule& schedule,
   };
 }
 
+void
+BlackoilWellModelGeneric::
+resetState()
+{
+    this->active_wgstate_ = WGState(this->phase_usage_);
+    this->last_valid_wgstate_ = WGState(this->phase_usage_);
+    this->nupcol_wgstate_ = WGState(this->phase_usage_);
+    this->last_valid_is_checkpoint_ = false;
+    this->last_run_wellpi_.reset();
+    this->closed_this_step_.clear();
+    this->node_pressures_.clear();
+    this->network_leaf_history_.clear();
+    this->network_history_step_ = -1;
+    this->last_glift_opt_time_ = -1.0;
+    this->clearGasLiftGradients();
+    this->well_targets_.clear();
+}
+
+BlackoilWellModelGeneric::Checkpoint
+BlackoilWellModelGeneric::
+checkpoint() const
+{
+    return {this->active_wgstate_,
+            this->last_valid_wgstate_,
+            this->nupcol_wgstate_,
+            this->last_run_wellpi_,
+            this->closed_this_step_,
+            this->node_pressures_,
+            this->network_leaf_history_,
+            this->network_history_step_,
+            this->last_glift_opt_time_};
+}
+
+void
+BlackoilWellModelGeneric::
+restoreCheckpoint(const Checkpoint& checkpoint)
+{
+    this->active_wgstate_ = checkpoint.active_wgstate;
+    this->last_valid_wgstate_ = checkpoint.last_valid_wgstate;
+    this->nupcol_wgstate_ = checkpoint.nupcol_wgstate;
+    this->last_valid_is_checkpoint_ = false;
+    this->last_run_wellpi_ = checkpoint.last_run_wellpi;
+    this->closed_this_step_ = checkpoint.closed_this_step;
+    this->node_pressures_ = checkpoint.node_pressures;
+    this->network_leaf_history_ = checkpoint.network_leaf_history;
+    this->network_history_step_ = checkpoint.network_history_step;
+    this->last_glift_opt_time_ = checkpoint.last_glift_opt_time;
+    this->clearGasLiftGradients();
+}
+
+namespace {
+
+template <class Range>
+void readValues(std::istream& is, Range& values, const std::string& well)
+{
+    if (!readCheckpointValues(is, values)) {
+        throw std::runtime_error("The checkpoint of well " + well +
+                                 " does not match its connections or segments");
+    }
+}
+
+}
+
+void
+BlackoilWellModelGeneric::
+writeWellState(std::ostream& os) const
+{
+    const auto& well_state = this->wellState();
+    os << well_state.size();
+    for (std::size_t w = 0; w < well_state.size(); ++w) {
+        const auto& ws = well_state.well(w);
+        os << '\n' << ws.name
+           << ' ' << static_cast<int>(ws.status)
+           << ' ' << static_cast<int>(ws.injection_cmode)
+           << ' ' << static_cast<int>(ws.production_cmode);
+        for (const double value : {ws.bhp, ws.thp, ws.temperature,
+                                   ws.dissolved_gas_rate, ws.vaporized_oil_rate,
+                                   ws.perf_data.pressure_first_connection}) {
+            writeCheckpointValue(os, value);
+        }
+        writeCheckpointValues(os, ws.surface_rates);
+        writeCheckpointValues(os, ws.reservoir_rates);
+        writeCheckpointValues(os, ws.well_potentials);
+        writeCheckpointValues(os, ws.productivity_index);
+
+        const auto& perf_data = ws.perf_data;
+        for (const auto* values : {&perf_data.pressure, &perf_data.rates, &perf_data.phase_rates,
+                                   &perf_data.solvent_rates, &perf_data.polymer_rates,
+                                   &perf_data.brine_rates, &perf_data.prod_index,
+                                   &perf_data.micp_rates, &perf_data.water_throughput,
+                                   &perf_data.skin_pressure, &perf_data.water_velocity}) {
+            writeCheckpointValues(os, *values);
+        }
+
+        const auto& segments = ws.segments;
+        for (const auto* values : {&segments.rates, &segments.pressure,
+                                   &segments.pressure_drop_friction,
+                                   &segments.pressure_drop_hydrostatic,
+                                   &segments.pressure_drop_accel}) {
+            writeCheckpointValues(os, *values);
+        }
+    }
+
+    os << '\n' << this->node_pressures_.size();
+    for (const auto& [node, pressure] : this->node_pressures_) {
+        os << ' ' << node;
+        writeCheckpointValue(os, pressure);
+    }
+}
+
+void
+BlackoilWellModelGeneric::
+readWellState(std::istream& is)
+{
+    auto& well_state = this->wellState();
+    std::size_t num_wells = 0;
+    is >> num_wells;
+    if (num_wells != well_state.size()) {
+        throw std::runtime_error("The checkpoint does not match the wells of the report step");
+    }
+    for (std::size_t w = 0; w < num_wells; ++w) {
+        std::string name;
+        int status = 0, injection_cmode = 0, production_cmode = 0;
+        is >> name >> status >> injection_cmode >> production_cmode;
+        if (!well_state.has(name)) {
+            throw std::runtime_error("Well " + name + " of the checkpoint is not active on this process");
+        }
+
+        auto& ws = well_state.well(name);
+        ws.status = static_cast<Well::Status>(status);
+        ws.injection_cmode = static_cast<Well::InjectorCMode>(injection_cmode);
+        ws.production_cmode = static_cast<Well::ProducerCMode>(production_cmode);
+        for (double* value : {&ws.bhp, &ws.thp, &ws.temperature,
+                              &ws.dissolved_gas_rate, &ws.vaporized_oil_rate,
+                              &ws.perf_data.pressure_first_connection}) {
+            *value = readCheckpointValue(is);
+        }
+        readValues(is, ws.surface_rates, name);
+        readValues(is, ws.reservoir_rates, name);
+        readValues(is, ws.well_potentials, name);
+        readValues(is, ws.productivity_index, name);
+
+        auto& perf_data = ws.perf_data;
+        for (auto* values : {&perf_data.pressure, &perf_data.rates, &perf_data.phase_rates,
+                             &perf_data.solvent_rates, &perf_data.polymer_rates,
+                             &perf_data.brine_rates, &perf_data.prod_index,
+                             &perf_data.micp_rates, &perf_data.water_throughput,
+                             &perf_data.skin_pressure, &perf_data.water_velocity}) {
+            readValues(is, *values, name);
+        }
+
+        auto& segments = ws.segments;
+        for (auto* values : {&segments.rates, &segments.pressure,
+                             &segments.pressure_drop_friction,
+                             &segments.pressure_drop_hydrostatic,
+                             &segments.pressure_drop_accel}) {
+            readValues(is, *values, name);
+        }
+    }
+
+    std::size_t num_nodes = 0;
+    is >> num_nodes;
+    this->node_pressures_.clear();
+    for (std::size_t n = 0; n < num_nodes; ++n) {
+        std::string node;
+        is >> node;
+        this->node_pressures_[node] = readCheckpointValue(is);
+    }
+
+    if (!is) {
+        throw std::runtime_error("The well state of the checkpoint could not be read");
+    }
+
+    // a time step which is chopped restarts from the checkpointed state
+    this->commitWGState();
+}
+
+void
+BlackoilWellModelGeneric::
+clearGasLiftGradients()
+{
+    // the reuse tolerance is a parameter
+    const double tolerance = this->glift_grad_cache_.tolerance;
+    this->glift_grad_cache_ = GasLiftStage2::GradientCache{};
+    this->glift_grad_cache_.tolerance = tolerance;
+}
+
 int
 BlackoilWellModelGeneric::
 numLocalWells() const
@@ -1450,6 +1701,9 @@ updateEclWells(const int timeStepIdx,
                const std::unordered_set<std::string>& wells,
                const SummaryState& st)
 {
+    // the groups of the Schedule may have been replaced
+    this->group_tree_ = GroupTree{};
+
     for (const auto& wname : wells) {
         auto well_iter = std::find_if(this->wells_ecl_.begin(), this->wells_ecl_.end(),
             [&wname] (const auto& well) -> bool
@@ -1482,6 +1736,107 @@ updateEclWells(const int timeStepIdx,
     }
 }
 
+void
+BlackoilWellModelGeneric::
+setWellTargets(const int reportStepIdx,
+               const std::vector<std::string>& wells,
+               const std::string& control,
+               const std::vector<double>& targets,
+               const SummaryState& st)
+{
+    if (wells.size() != targets.size()) {
+        throw std::invalid_argument {
+            fmt::format("{} targets given for {} wells", targets.size(), wells.size())
+        };
+    }
+
+    // check all the wells before any target is changed
+    std::vector<std::pair<std::size_t, Well>> local_wells;
+    for (std::size_t i = 0; i < wells.size(); ++i) {
+        if (! this->schedule().hasWell(wells[i], reportStepIdx)) {
+            throw std::invalid_argument {
+                fmt::format("Unknown well {} at report step {}", wells[i], reportStepIdx)
+            };
+        }
+
+        auto well_iter = std::find_if(this->wells_ecl_.begin(), this->wells_ecl_.end(),
+            [&wname = wells[i]](const Well& well)
+        {
+            return well.name() == wname;
+        });
+
+        auto well = (well_iter != this->wells_ecl_.end())
+            ? *well_iter
+            : this->schedule().getWell(wells[i], reportStepIdx);
+        setWellControlTarget(well, control, targets[i]);
+
+        if (well_iter != this->wells_ecl_.end()) {
+            local_wells.emplace_back(std::distance(this->wells_ecl_.begin(), well_iter),
+                                     std::move(well));
+        }
+    }
+
+    for (std::size_t i = 0; i < wells.size(); ++i) {
+        auto& well_targets = this->well_targets_[wells[i]];
+        auto target = std::find_if(well_targets.begin(), well_targets.end(),
+                                   [&control](const auto& t) { return t.first == control; });
+        if (target != well_targets.end()) {
+            well_targets.erase(target);
+        }
+        well_targets.emplace_back(control, targets[i]);
+    }
+
+    if (local_wells.empty()) {
+        return;
+    }
+
+    // the next report step starts from the committed well state, which
+    // keeps the control modes of the wells
+    for (auto& [well_index, well] : local_wells) {
+        this->wells_ecl_[well_index] = std::move(well);
+        const auto& ecl_well = this->wells_ecl_[well_index];
+        if (! this->wellState().has(ecl_well.name())) {
+            continue;
+        }
+
+        auto& ws = this->wellState().well(ecl_well.name());
+        ws.update_targets(ecl_well, st);
+        if (ecl_well.isProducer()) {
+            ws.production_cmode = ecl_well.productionControls(st).cmode;
+        }
+        else {
+            ws.injection_cmode = ecl_well.injectionControls(st).cmode;
+        }
+    }
+    this->commitWGState();
+}
+
+void
+BlackoilWellModelGeneric::
+applyWellTargets(const int timeStepIdx)
+{
+    const auto& events = this->schedule()[timeStepIdx].wellgroup_events();
+    for (auto it = this->well_targets_.begin(); it != this->well_targets_.end();) {
+        if (events.hasEvent(it->first, ScheduleEvents::PRODUCTION_UPDATE +
+                                       ScheduleEvents::INJECTION_UPDATE)) {
+            it = this->well_targets_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    for (auto& well : this->wells_ecl_) {
+        auto well_targets = this->well_targets_.find(well.name());
+        if (well_targets == this->well_targets_.end()) {
+            continue;
+        }
+        for (const auto& [control, target] : well_targets->second) {
+            setWellControlTarget(well, control, target);
+        }
+    }
+}
+
 double
 BlackoilWellModelGeneric::
 wellPI(const int well_index) const
@@ -2002,6 +2357,7 @@ updateAndCommunicateGroupData(const int reportStepIdx,
                               const int iterationIdx)
 {
     const Group& fieldGroup = schedule().getGroup("FIELD", reportStepIdx);
+    const GroupTree& groupTree = this->groupTree(reportStepIdx);
     const int nupcol = schedule()[reportStepIdx].nupcol();
 
     // This builds some necessary lookup structures, so it must be called
@@ -2017,17 +2373,17 @@ updateAndCommunicateGroupData(const int reportStepIdx,
     // the group target reduction rates needs to be update since wells may have switched to/from GRUP control
     // The group target reduction does not honor NUPCOL.
     std::vector<double> groupTargetReduction(numPhases(), 0.0);
-    WellGroupHelpers::updateGroupTargetReduction(fieldGroup, schedule(), reportStepIdx, /*isInjector*/ false, phase_usage_, guideRate_, well_state, this->groupState(), groupTargetReduction);
+    WellGroupHelpers::updateGroupTargetReduction(groupTree, schedule(), reportStepIdx, /*isInjector*/ false, phase_usage_, guideRate_, well_state, this->groupState(), groupTargetReduction);
     std::vector<double> groupTargetReductionInj(numPhases(), 0.0);
-    WellGroupHelpers::updateGroupTargetReduction(fieldGroup, schedule(), reportStepIdx, /*isInjector*/ true, phase_usage_, guideRate_, well_state, this->groupState(), groupTargetReductionInj);
+    WellGroupHelpers::updateGroupTargetReduction(groupTree, schedule(), reportStepIdx, /*isInjector*/ true, phase_usage_, guideRate_, well_state, this->groupState(), groupTargetReductionInj);
 
-    WellGroupHelpers::updateREINForGroups(fieldGroup, schedule(), reportStepIdx, phase_usage_, summaryState_, well_state_nupcol, this->groupState());
-    WellGroupHelpers::updateVREPForGroups(fieldGroup, schedule(), reportStepIdx, well_state_nupcol, this->groupState());
+    WellGroupHelpers::updateREINForGroups(groupTree, schedule(), reportStepIdx, phase_usage_, summaryState_, well_state_nupcol, this->groupState());
+    WellGroupHelpers::updateVREPForGroups(groupTree, schedule(), reportStepIdx, well_state_nupcol, this->groupState());
 
-    WellGroupHelpers::updateReservoirRatesInjectionGroups(fieldGroup, schedule(), reportStepIdx, well_state_nupcol, this->groupState());
-    WellGroupHelpers::updateSurfaceRatesInjectionGroups(fieldGroup, schedule(), reportStepIdx, well_state_nupcol, this->groupState());
+    WellGroupHelpers::updateReservoirRatesInjectionGroups(groupTree, schedule(), reportStepIdx, well_state_nupcol, this->groupState());
+    WellGroupHelpers::updateSurfaceRatesInjectionGroups(groupTree, schedule(), reportStepIdx, well_state_nupcol, this->groupState());
 
-    WellGroupHelpers::updateGroupProductionRates(fieldGroup, schedule(), reportStepIdx, well_state_nupcol, this->groupState());
+    WellGroupHelpers::updateGroupProductionRates(groupTree, schedule(), reportStepIdx, well_state_nupcol, this->groupState());
 
     // We use the rates from the previous time-step to reduce oscillations
     WellGroupHelpers::updateWellRates(fieldGroup, schedule(), reportStepIdx, this->prevWellState(), well_state);
@@ -2041,8 +2397,19 @@ updateAndCommunicateGroupData(const int reportStepIdx,
         }
     }
 
-    well_state.communicateGroupRates(comm_);
-    this->groupState().communicate_rates(comm_);
+    // The well and group rates are communicated with a single sum() call.
+    auto& group_state = this->groupState();
+    const std::size_t well_size = well_state.groupRatesSize();
+    std::vector<double> data(well_size + group_state.data_size());
+    [[maybe_unused]] std::size_t pos = well_state.collectGroupRates(data.data());
+    pos += group_state.collect(data.data() + well_size);
+    assert(pos == data.size());
+
+    comm_.sum(data.data(), data.size());
+
+    pos = well_state.distributeGroupRates(data.data());
+    pos += group_state.distribute(data.data() + well_size);
+    assert(pos == data.size());
 }
 
 bool
@@ -2120,12 +2487,28 @@ updateNetworkPressures(const int reportStepIdx)
     if (!network.active()) {
         return;
     }
-    node_pressures_ = WellGroupHelpers::computeNetworkPressures(network,
-                                                                this->wellState(),
-                                                                this->groupState(),
-                                                                *(vfp_properties_->getProd()),
-                                                                schedule(),
-                                                                reportStepIdx);
+    if (network_coupled_solve_) {
+        // The network may change between report steps.
+        if (network_history_step_ != reportStepIdx) {
+            network_leaf_history_.clear();
+            network_history_step_ = reportStepIdx;
+        }
+        node_pressures_ = WellGroupHelpers::computeNetworkPressuresCoupled(network,
+                                                                           this->wellState(),
+                                                                           this->groupState(),
+                                                                           *(vfp_properties_->getProd()),
+                                                                           schedule(),
+                                                                           reportStepIdx,
+                                                                           node_pressures_,
+                                                                           network_leaf_history_);
+    } else {
+        node_pressures_ = WellGroupHelpers::computeNetworkPressures(network,
+                                                                    this->wellState(),
+                                                                    this->groupState(),
+                                                                    *(vfp_properties_->getProd()),
+                                                                    schedule(),
+                                                                    reportStepIdx);
+    }
 
     // Set the thp limits of wells
     for (auto& well : well_container_generic_) {
@@ -2234,6 +2617,8 @@ gasLiftOptimizationStage2(DeferredLogger& deferred_logger,
                          prod_wells,
                          glift_wells,
                          glift_well_state_map,
+                         this->glift_grad_cache_,
+                         this->glift_threaded_,
                          this->glift_debug
     };
     glift.runOptimize();
@@ -2247,6 +2632,9 @@ updateWellPotentials(const int reportStepIdx,
                      DeferredLogger& deferred_logger)
 {
     auto well_state_copy = this->wellState();
+    this->potential_well_state_ = well_state_copy;
+    this->potential_well_state_.clearChangedWells();
+    this->potential_well_state_active_ = true;
 
     const bool write_restart_file = schedule().write_rst_file(reportStepIdx);
     auto exc_type = ExceptionType::NONE;
@@ -2286,7 +2674,9 @@ updateWellPotentials(const int reportStepIdx,
         const auto& events = schedule()[reportStepIdx].wellgroup_events();
         const bool event = events.hasEvent(well->name(), ScheduleEvents::ACTIONX_WELL_EVENT) ||
                            (report_step_starts_ && events.hasEvent(well->name(), effective_events_mask));
-        const bool needPotentialsForGuideRates = well->underPredictionMode() && (!onlyAfterEvent || event);
+        const bool needPotentialsAfterTimeStep = !onlyAfterEvent &&
+            (!lazy_well_potentials_ || this->potentialsNeededForControl(*well, reportStepIdx, summaryConfig));
+        const bool needPotentialsForGuideRates = well->underPredictionMode() && (needPotentialsAfterTimeStep || event);
         const bool needPotentialsForOutput = !onlyAfterEvent && (needed_for_summary || write_restart_file);
         const bool compute_potential = needPotentialsForOutput || needPotentialsForGuideRates;
         if (compute_potential)
@@ -2295,12 +2685,75 @@ updateWellPotentials(const int reportStepIdx,
         }
         ++widx;
     }
+    this->potential_well_state_active_ = false;
     logAndCheckForExceptionsAndThrow(deferred_logger, exc_type,
                                      "computeWellPotentials() failed: " + exc_msg,
                                      terminal_output_, comm_);
 
 }
 
+WellState*
+BlackoilWellModelGeneric::
+potentialWellState() const
+{
+    if (!this->potential_well_state_active_)
+        return nullptr;
+
+    // the active wellstate only changes in the potentials of the wells
+    // done so far, which are not used by the calculations of other wells
+    this->potential_well_state_.restoreChangedWellsOnly(this->wellState());
+    this->potential_well_state_.clearChangedWells();
+    return &this->potential_well_state_;
+}
+
+bool
+BlackoilWellModelGeneric::
+potentialsNeededForControl(const WellInterfaceGeneric& well,
+                           const int reportStepIdx,
+                           const SummaryConfig& summaryConfig) const
+{
+    const auto& well_ecl = well.wellEcl();
+
+    // The guide rates are reported for all wells and groups.
+    for (const auto* keyword : {"WOPGR", "WGPGR", "WWPGR", "WVPGR", "WGIGR", "WWIGR",
+                                "GOPGR", "GGPGR", "GWPGR", "GVPGR", "GGIGR", "GWIGR"}) {
+        if (summaryConfig.hasKeyword(keyword)) {
+            return true;
+        }
+    }
+
+    // Economic limits checked against the potentials.
+    const auto& econ_limits = well_ecl.getEconLimits();
+    if (well.isProducer() && econ_limits.onAnyRateLimit() &&
+        econ_limits.quantityLimit() == WellEconProductionLimits::QuantityLimit::POTN) {
+        return true;
+    }
+
+    // Gas lift optimization uses the potentials of its wells.
+    if (well.isProducer() && schedule().glo(reportStepIdx).has_well(well.name())) {
+        return true;
+    }
+
+    // The potentials give the guide rates of group controlled wells, and
+    // of the groups above them.
+    if (well_ecl.isAvailableForGroupControl()) {
+        std::string group_name = well_ecl.groupName();
+        while (true) {
+            const auto& group = schedule().getGroup(group_name, reportStepIdx);
+            if ((well.isProducer() && group.isProductionGroup()) ||
+                (well.isInjector() && group.isInjectionGroup())) {
+                return true;
+            }
+            if (group_name == "FIELD") {
+                break;
+            }
+            group_name = group.parent();
+        }
+    }
+
+    return false;
+}
+
 void
 BlackoilWellModelGeneric::
 runWellPIScaling(const int timeStepIdx,
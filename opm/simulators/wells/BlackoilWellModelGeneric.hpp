@@ -29,17 +29,23 @@
 #include <opm/input/eclipse/Schedule/Group/GuideRate.hpp>
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
+#include <opm/simulators/utils/MemoryRegistry.hpp>
 
+#include <opm/simulators/wells/GasLiftStage2.hpp>
+#include <opm/simulators/wells/GroupTree.hpp>
 #include <opm/simulators/wells/PerforationData.hpp>
+#include <opm/simulators/wells/WellGroupHelpers.hpp>
 #include <opm/simulators/wells/WellProdIndexCalculator.hpp>
 #include <opm/simulators/wells/WGState.hpp>
 
 #include <functional>
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace Opm {
@@ -117,6 +123,15 @@ public:
         return this->active_wgstate_.well_state;
     }
 
+    /*
+      Scratch copy of the active wellstate for the potential calculations
+      of single wells, which must not change the active wellstate. Only
+      the wells changed since the previous call are copied again, instead
+      of the whole wellstate for every well. Available during
+      updateWellPotentials(), returns nullptr otherwise. Not thread-safe.
+    */
+    WellState* potentialWellState() const;
+
     GroupState& groupState() { return this->active_wgstate_.group_state; }
 
     WellTestState& wellTestState() { return this->active_wgstate_.well_test_state; }
@@ -131,6 +146,23 @@ public:
                         const std::unordered_set<std::string>& wells,
                         const SummaryState& st);
 
+    /*
+      Set the target of one control for a group of wells, e.g. from the
+      Python bindings between two report steps, without changing the
+      Schedule. The control is the name of a production control (ORAT,
+      WRAT, GRAT, LRAT, RESV, BHP, THP) or of an injection control (RATE,
+      RESV, BHP, THP) according to the type of each well, it becomes the
+      active control, and the targets are in SI units. The targets are
+      kept until the Schedule changes the controls of a well again. Wells
+      which are not on this process are only checked against the Schedule
+      at the report step.
+    */
+    void setWellTargets(const int reportStepIdx,
+                        const std::vector<std::string>& wells,
+                        const std::string& control,
+                        const std::vector<double>& targets,
+                        const SummaryState& st);
+
 
     void loadRestartData(const data::Wells& rst_wells,
                          const data::GroupAndNetworkValues& grpNwrkValues,
@@ -154,8 +186,48 @@ public:
     void commitWGState()
     {
         this->last_valid_wgstate_ = this->active_wgstate_;
+        this->active_wgstate_.well_state.clearChangedWells();
+        this->last_valid_is_checkpoint_ = true;
+        this->updateWellStateMemory();
     }
 
+    /*
+      Will discard the well, group and well test states and the history of
+      a run, such that the schedule can be simulated again from its start.
+      The guide rates are kept.
+    */
+    void resetState();
+
+    /*
+      Write the state of the local wells to a checkpoint file, each process
+      writes its own. The floating point values are written as their bit
+      patterns, such that a run continued from the checkpoint gives identical
+      results. readWellState() expects the wells of the same report step.
+    */
+    void writeWellState(std::ostream& os) const;
+    void readWellState(std::istream& is);
+
+    /*
+      The dynamic state of the well model at the end of a report step.
+      It is kept in memory by checkpoint(), and restoreCheckpoint() continues
+      the run from there, possibly several times.
+    */
+    struct Checkpoint
+    {
+        WGState active_wgstate;
+        WGState last_valid_wgstate;
+        WGState nupcol_wgstate;
+        std::optional<int> last_run_wellpi;
+        std::unordered_set<std::string> closed_this_step;
+        std::map<std::string, double> node_pressures;
+        std::map<std::string, WellGroupHelpers::NetworkLeafInflow> network_leaf_history;
+        int network_history_step;
+        double last_glift_opt_time;
+    };
+
+    Checkpoint checkpoint() const;
+    void restoreCheckpoint(const Checkpoint& checkpoint);
+
     data::GroupAndNetworkValues groupAndNetworkData(const int reportStepIdx) const;
 
     /// Return true if any well has a THP constraint.
@@ -214,6 +286,17 @@ protected:
         return this->nupcol_wgstate_.well_state;
     }
 
+    /*
+      The group hierarchy of the report step, built on first use in every
+      report step and discarded when the Schedule is updated.
+    */
+    const GroupTree& groupTree(const int reportStepIdx)
+    {
+        if (this->group_tree_.empty() || this->group_tree_.reportStep() != reportStepIdx)
+            this->group_tree_ = GroupTree(this->schedule_, reportStepIdx);
+        return this->group_tree_;
+    }
+
     /*
       Will store a copy of the input argument well_state in the
       last_valid_well_state_ member, that state can then be recovered
@@ -222,6 +305,8 @@ protected:
     void commitWGState(WGState wgstate)
     {
         this->last_valid_wgstate_ = std::move(wgstate);
+        this->last_valid_is_checkpoint_ = false;
+        this->updateWellStateMemory();
     }
 
     /*
@@ -231,7 +316,16 @@ protected:
     */
     void resetWGState()
     {
-        this->active_wgstate_ = this->last_valid_wgstate_;
+        if (this->last_valid_is_checkpoint_) {
+            // only the wells that were modified since the commit differ
+            this->active_wgstate_.well_state.restoreChangedWells(this->last_valid_wgstate_.well_state);
+            this->active_wgstate_.group_state = this->last_valid_wgstate_.group_state;
+            this->active_wgstate_.well_test_state = this->last_valid_wgstate_.well_test_state;
+        } else {
+            this->active_wgstate_ = this->last_valid_wgstate_;
+        }
+        this->active_wgstate_.well_state.clearChangedWells();
+        this->last_valid_is_checkpoint_ = true;
     }
 
     /*
@@ -242,6 +336,17 @@ protected:
     void updateNupcolWGState()
     {
         this->nupcol_wgstate_ = this->active_wgstate_;
+        this->updateWellStateMemory();
+    }
+
+    // account the memory of the copies of the well state held by this class,
+    // the copies may have different wells and segments
+    void updateWellStateMemory()
+    {
+        this->well_state_memory_.set(this->active_wgstate_.well_state.memoryBytes()
+                                     + this->last_valid_wgstate_.well_state.memoryBytes()
+                                     + this->nupcol_wgstate_.well_state.memoryBytes()
+                                     + this->potential_well_state_.memoryBytes());
     }
 
     /// \brief Create the parallel well information
@@ -250,6 +355,9 @@ protected:
 
     void initializeWellProdIndCalculators();
     void initializeWellPerfData();
+    // apply the targets of setWellTargets() to wells_ecl_, unless the
+    // Schedule changes the controls of the well at this report step
+    void applyWellTargets(const int timeStepIdx);
 
     bool wasDynamicallyShutThisTimeStep(const int well_index) const;
 
@@ -398,6 +506,12 @@ protected:
 
     bool guideRateUpdateIsNeeded(const int reportStepIdx) const;
 
+    // Whether the potentials of a well in prediction mode may influence
+    // its controls, the guide rates or the guide rate output.
+    bool potentialsNeededForControl(const WellInterfaceGeneric& well,
+                                    const int reportStepIdx,
+                                    const SummaryConfig& summaryConfig) const;
+
     // create the well container
     virtual void createWellContainer(const int time_step) = 0;
     virtual void initWellContainer() = 0;
@@ -445,8 +559,18 @@ protected:
     mutable std::unordered_set<std::string> closed_this_step_;
 
     GuideRate guideRate_;
+    GroupTree group_tree_;
     std::unique_ptr<VFPProperties> vfp_properties_{};
     std::map<std::string, double> node_pressures_; // Storing network pressures for output.
+    // targets set by setWellTargets(), in the order they were set
+    std::map<std::string, std::vector<std::pair<std::string, double>>> well_targets_;
+    // solve the network node pressures simultaneously instead of by a single sweep
+    bool network_coupled_solve_ = false;
+    // inflows of the network leaf nodes at earlier pressures, for the coupled solve
+    std::map<std::string, WellGroupHelpers::NetworkLeafInflow> network_leaf_history_;
+    int network_history_step_ = -1;
+    // skip the end of time step potentials of wells that do not need them
+    bool lazy_well_potentials_ = false;
 
     /*
       The various wellState members should be accessed and modified
@@ -457,13 +581,26 @@ protected:
     WGState active_wgstate_;
     WGState last_valid_wgstate_;
     WGState nupcol_wgstate_;
+    // whether last_valid_wgstate_ is a copy of active_wgstate_ made by
+    // commitWGState(), such that resetWGState() only copies the changed wells
+    bool last_valid_is_checkpoint_{false};
+    MemoryAccount well_state_memory_{MemoryRegistry::Owner::WellState};
+    // see potentialWellState()
+    mutable WellState potential_well_state_;
+    bool potential_well_state_active_{false};
 
     bool glift_debug = false;
 
     double last_glift_opt_time_ = -1.0;
+    // gradients of the gas lift wells, reused by later optimizations
+    GasLiftStage2::GradientCache glift_grad_cache_;
+    // evaluate the gas lift gradients of the wells on the OpenMP threads
+    bool glift_threaded_ = false;
 
 private:
     WellInterfaceGeneric* getGenWell(const std::string& well_name);
+    // discard the gas lift gradients, they belong to an earlier state
+    void clearGasLiftGradients();
 };
 
 
@@ -21,15 +21,24 @@
 */
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
 #include <opm/core/props/phaseUsageFromDeck.hpp>
 
+#include <opm/common/Exceptions.hpp>
 #include <opm/input/eclipse/Units/UnitSystem.hpp>
 
 #include <opm/simulators/wells/VFPProperties.hpp>
+#include <opm/simulators/wells/WellHelpers.hpp>
 
 #include <algorithm>
+#include <exception>
+#include <optional>
 #include <utility>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <fmt/format.h>
 
 namespace Opm {
@@ -63,6 +72,13 @@ namespace Opm {
 
         this->alternative_well_rate_init_ =
             EWOMS_GET_PARAM(TypeTag, bool, AlternativeWellRateInit);
+        this->glift_grad_cache_.tolerance =
+            EWOMS_GET_PARAM(TypeTag, Scalar, GasLiftGradientTolerance);
+        this->glift_threaded_ = param_.threaded_well_assembly_;
+        this->network_coupled_solve_ =
+            EWOMS_GET_PARAM(TypeTag, bool, NetworkCoupledSolve);
+        this->lazy_well_potentials_ =
+            EWOMS_GET_PARAM(TypeTag, bool, LazyWellPotentials);
     }
 
     template<typename TypeTag>
@@ -111,16 +127,26 @@ namespace Opm {
             return;
         }
 
+        // The pattern is created once and holds the couplings of all wells
+        // the schedule defines until its end, whether they are open or not.
+        // Wells which open, close or are shut for testing only change values,
+        // such that the matrix, the preconditioners and the analysis done by
+        // the accelerated solvers never need to be rebuilt for well events.
+
         // Create cartesian to compressed mapping
         const auto& schedule_wells = schedule().getWellsatEnd();
 
         // initialize the additional cell connections introduced by wells.
+        // All connections the wells ever have are included, such that the
+        // pattern does not change when connections open or close.
+        std::vector<std::vector<int>> wellCells;
+        wellCells.reserve(schedule_wells.size());
         for (const auto& well : schedule_wells)
         {
-            std::vector<int> wellCells;
+            auto& cells = wellCells.emplace_back();
             // All possible connections of the well
             const auto& connectionSet = well.getConnections();
-            wellCells.reserve(connectionSet.size());
+            cells.reserve(connectionSet.size());
 
             for ( size_t c=0; c < connectionSet.size(); c++ )
             {
@@ -128,15 +154,11 @@ namespace Opm {
                 int compressed_idx = compressedIndexForInterior(connection.global_index());
 
                 if ( compressed_idx >= 0 ) { // Ignore connections in inactive/remote cells.
-                    wellCells.push_back(compressed_idx);
+                    cells.push_back(compressed_idx);
                 }
             }
-
-            for (int cellIdx : wellCells) {
-                neighbors[cellIdx].insert(wellCells.begin(),
-                                          wellCells.end());
-            }
         }
+        wellhelpers::addWellNeighbors(std::move(wellCells), neighbors);
     }
 
     template<typename TypeTag>
@@ -154,12 +176,21 @@ namespace Opm {
                     // r = r - duneC_^T * invDuneD_ * resWell_
                     well->apply(res);
                 }
+                prepareWellBatch();
             }
             OPM_END_PARALLEL_TRY_CATCH("BlackoilWellModel::linearize failed: ",
                                        ebosSimulator_.gridView().comm());
             return;
         }
 
+        if (check_well_pattern_) {
+            OPM_BEGIN_PARALLEL_TRY_CATCH();
+            checkWellsInPattern(jacobian.istlMatrix());
+            OPM_END_PARALLEL_TRY_CATCH("BlackoilWellModel::linearize failed: ",
+                                       ebosSimulator_.gridView().comm());
+            check_well_pattern_ = false;
+        }
+
         for (const auto& well: well_container_) {
             well->addWellContributions(jacobian);
 
@@ -170,6 +201,27 @@ namespace Opm {
     }
 
 
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    checkWellsInPattern(const typename SparseMatrixAdapter::IstlMatrix& matrix) const
+    {
+        // Only wells created after the pattern, i.e., by actions, can be missing.
+        for (const auto& well : well_container_) {
+            const auto& cells = well->cells();
+            for (const int row : cells) {
+                for (const int col : cells) {
+                    if (matrix[row].find(col) == matrix[row].end()) {
+                        OPM_THROW(std::logic_error, "The connections of well " << well->name()
+                                  << " are not in the sparsity pattern of the Jacobian, which is built"
+                                  " from the wells at the end of the schedule. Wells or connections"
+                                  " added by actions need --matrix-add-well-contributions=false");
+                    }
+                }
+            }
+        }
+    }
+
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
@@ -179,10 +231,15 @@ namespace Opm {
 
         report_step_starts_ = true;
 
+        // the wells refer to the parallel well info, the perforation data and the
+        // rate converter, which are all created again below
+        well_container_step_ = -1;
+
         const Grid& grid = ebosSimulator_.vanguard().grid();
         const auto& summaryState = ebosSimulator_.vanguard().summaryState();
         // Make wells_ecl_ contain only this partition's wells.
         wells_ecl_ = getLocalWells(timeStepIdx);
+        this->applyWellTargets(timeStepIdx);
         this->local_parallel_well_info_ = createLocalParallelWellInfo(wells_ecl_);
 
         // at least initializeWellState might be throw
@@ -261,6 +318,7 @@ namespace Opm {
 
             // create the well container
             createWellContainer(reportStepIdx);
+            check_well_pattern_ = param_.matrix_add_well_contributions_;
 
             // do the initialization for all the wells
             // TODO: to see whether we can postpone of the intialization of the well containers to
@@ -384,6 +442,7 @@ namespace Opm {
         if (!wtest_config.empty()) { // there is a WTEST request
             const std::vector<std::string> wellsForTesting = wellTestState()
                 .test_wells(wtest_config, simulationTime);
+            std::vector<WellInterfacePtr> wells;
             for (const std::string& well_name : wellsForTesting) {
 
                 const Well& wellEcl = schedule().getWell(well_name, timeStepIdx);
@@ -401,8 +460,72 @@ namespace Opm {
                 well->setWellEfficiencyFactor(well_efficiency_factor);
                 well->setVFPProperties(vfp_properties_.get());
                 well->setGuideRate(&guideRate_);
+                wells.push_back(std::move(well));
+            }
 
-                well->wellTesting(ebosSimulator_, simulationTime, this->wellState(), this->groupState(), wellTestState(), deferred_logger);
+            // Without threads the wells are tested one after another, and a reopened
+            // well is committed before the next test, so the next tests see it. With
+            // threads all wells are tested against the well state from before the
+            // tests, and the reopened wells are committed afterwards in the order of
+            // the tests.
+            const int nw = wells.size();
+            std::vector<std::optional<SingleWellState>> tested_states(nw);
+            std::vector<WellTestState> closed_completions(nw);
+            auto testWell = [&](const int w, DeferredLogger& well_logger)
+            {
+                tested_states[w] = wells[w]->testWell(ebosSimulator_, simulationTime, this->wellState(),
+                                                      this->groupState(), closed_completions[w], well_logger);
+            };
+            auto commitWell = [&](const int w)
+            {
+                if (tested_states[w]) {
+                    wells[w]->commitWellTest(std::move(*tested_states[w]), closed_completions[w],
+                                             this->wellState(), wellTestState(), deferred_logger);
+                    tested_states[w].reset();
+                }
+            };
+#ifdef _OPENMP
+            if (param_.threaded_well_assembly_ && nw > 1 && omp_get_max_threads() > 1) {
+                // A tested well only changes its own well object and a copy of the well
+                // state. A distributed well communicates while it is solved, so those
+                // wells are tested in the same order on all processes after the others.
+                well_loggers_.resize(nw);
+                std::vector<std::exception_ptr> exceptions(nw);
+#pragma omp parallel for schedule(dynamic)
+                for (int w = 0; w < nw; ++w) {
+                    if (wells[w]->parallelWellInfo().communication().size() > 1) {
+                        continue;
+                    }
+                    try {
+                        testWell(w, well_loggers_[w]);
+                    } catch (...) {
+                        exceptions[w] = std::current_exception();
+                    }
+                }
+                for (int w = 0; w < nw; ++w) {
+                    deferred_logger.appendMessages(well_loggers_[w]);
+                    well_loggers_[w].clearMessages();
+                }
+                for (const auto& exception : exceptions) {
+                    if (exception) {
+                        std::rethrow_exception(exception);
+                    }
+                }
+                for (int w = 0; w < nw; ++w) {
+                    if (wells[w]->parallelWellInfo().communication().size() > 1) {
+                        testWell(w, deferred_logger);
+                    }
+                }
+                for (int w = 0; w < nw; ++w) {
+                    commitWell(w);
+                }
+            } else
+#endif
+            {
+                for (int w = 0; w < nw; ++w) {
+                    testWell(w, deferred_logger);
+                    commitWell(w);
+                }
             }
         }
     }
@@ -573,6 +696,17 @@ namespace Opm {
 
         const int nw = numLocalWells();
 
+        // Within a report step the objects of the wells are kept, as long as
+        // neither the well nor its perforations changed.
+        std::vector<WellInterfacePtr> previous_wells(nw);
+        if (well_container_step_ == time_step) {
+            for (auto& well : well_container_) {
+                const int w = well->indexOfWell();
+                if (w < nw) {
+                    previous_wells[w] = std::move(well);
+                }
+            }
+        }
         well_container_.clear();
 
         if (nw > 0) {
@@ -689,7 +823,13 @@ namespace Opm {
                     wellIsStopped = true;
                 }
 
-                well_container_.emplace_back(this->createWellPointer(w, time_step));
+                auto& previous = previous_wells[w];
+                if (previous && previous->canBeReused(well_ecl, time_step, this->well_perf_data_[w])) {
+                    previous->resetForNewTimeStep();
+                    well_container_.emplace_back(std::move(previous));
+                } else {
+                    well_container_.emplace_back(this->createWellPointer(w, time_step));
+                }
 
                 if (wellIsStopped)
                     well_container_.back()->stopWell();
@@ -707,6 +847,8 @@ namespace Opm {
         well_container_generic_.clear();
         for (auto& w : well_container_)
           well_container_generic_.push_back(w.get());
+
+        well_container_step_ = time_step;
     }
 
 
@@ -797,6 +939,7 @@ namespace Opm {
     assemble(const int iterationIdx,
              const double dt)
     {
+        ScopedTimer assemblyTimer(TimingRegistry::Region::WellAssembly);
 
         DeferredLogger local_deferredLogger;
         if (this->glift_debug) {
@@ -807,6 +950,7 @@ namespace Opm {
         last_report_ = SimulatorReportSingle();
         Dune::Timer perfTimer;
         perfTimer.start();
+        well_batch_valid_ = false;
 
         if ( ! wellsActive() ) {
             return;
@@ -1072,8 +1216,85 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     assembleWellEq(const double dt, DeferredLogger& deferred_logger)
     {
+        forEachWell(deferred_logger, [this, dt](auto& well, WellState& well_state, DeferredLogger& well_logger)
+        {
+            well.assembleWellEq(ebosSimulator_, dt, well_state, this->groupState(), well_logger);
+        });
+    }
+
+    template<typename TypeTag>
+    template<class Func>
+    void
+    BlackoilWellModel<TypeTag>::
+    forEachWell(DeferredLogger& deferred_logger, Func&& f)
+    {
+#ifdef _OPENMP
+        const int nw = well_container_.size();
+        if (param_.threaded_well_assembly_ && nw > 1 && omp_get_max_threads() > 1) {
+            // The well state is not changed while the wells are distributed over the
+            // threads, so every well sees the same state of the other wells, whatever
+            // the scheduling. Each thread works on its own copy of the well state. The
+            // state of a well is taken from that copy afterwards and the copy is
+            // restored, and the states of the wells are stored in the order of the
+            // wells after the loop. A distributed well communicates while it is solved,
+            // so those wells are done in the same order on all processes after the
+            // others. The messages and exceptions are collected in the order of the wells.
+            auto& well_state = this->wellState();
+            well_loggers_.resize(nw);
+            well_results_.resize(nw);
+            thread_well_states_.resize(omp_get_max_threads(), well_state);
+            std::vector<std::exception_ptr> exceptions(nw);
+#pragma omp parallel
+            {
+                auto& scratch = thread_well_states_[omp_get_thread_num()];
+                scratch = well_state;
+                scratch.clearChangedWells();
+#pragma omp for schedule(dynamic)
+                for (int w = 0; w < nw; ++w) {
+                    auto& well = *well_container_[w];
+                    if (well.parallelWellInfo().communication().size() > 1) {
+                        continue;
+                    }
+                    try {
+                        f(well, scratch, well_loggers_[w]);
+                        well_results_[w] = scratch.well(well.indexOfWell());
+                    } catch (...) {
+                        exceptions[w] = std::current_exception();
+                    }
+                    scratch.restoreChangedWellsOnly(well_state);
+                    scratch.clearChangedWells();
+                }
+            }
+            std::size_t thread_states_bytes = 0;
+            for (const auto& thread_state : thread_well_states_) {
+                thread_states_bytes += thread_state.memoryBytes();
+            }
+            thread_well_states_memory_.set(thread_states_bytes);
+            for (int w = 0; w < nw; ++w) {
+                if (well_results_[w]) {
+                    well_state.well(well_container_[w]->indexOfWell()) = std::move(*well_results_[w]);
+                    well_results_[w].reset();
+                }
+            }
+            for (int w = 0; w < nw; ++w) {
+                deferred_logger.appendMessages(well_loggers_[w]);
+                well_loggers_[w].clearMessages();
+            }
+            for (const auto& exception : exceptions) {
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+            }
+            for (auto& well : well_container_) {
+                if (well->parallelWellInfo().communication().size() > 1) {
+                    f(*well, well_state, deferred_logger);
+                }
+            }
+            return;
+        }
+#endif
         for (auto& well : well_container_) {
-            well->assembleWellEq(ebosSimulator_, dt, this->wellState(), this->groupState(), deferred_logger);
+            f(*well, this->wellState(), deferred_logger);
         }
     }
 
@@ -1103,11 +1324,104 @@ namespace Opm {
             return;
         }
 
+        if (well_batch_valid_) {
+            well_batch_.apply(x, Ax);
+            if (!msw_batch_.empty()) {
+                applyMultisegmentWells(x, Ax);
+                return;
+            }
+            for (const int idx : unbatched_wells_) {
+                well_container_[idx]->apply(x, Ax);
+            }
+            return;
+        }
+
         for (auto& well : well_container_) {
             well->apply(x, Ax);
         }
     }
 
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    applyMultisegmentWells(const BVector& x, BVector& Ax) const
+    {
+        // The small systems of the wells are independent, each well has its own
+        // factorization of D. Only the update of Ax is done in the order of the
+        // wells, since wells may share cells. OpmLog is not thread safe, a
+        // singular D is therefore logged by the master thread after the sweep.
+        const int nw = msw_batch_.size();
+        msw_solutions_.resize(nw);
+        msw_contributes_.resize(nw);
+        std::vector<std::exception_ptr> exceptions(nw);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int w = 0; w < nw; ++w) {
+            try {
+                msw_contributes_[w] = msw_batch_[w]->applyInvDB(x, msw_solutions_[w],
+                                                                /*logIssue=*/false);
+            } catch (...) {
+                exceptions[w] = std::current_exception();
+            }
+        }
+        for (const auto& exception : exceptions) {
+            if (exception) {
+                try {
+                    std::rethrow_exception(exception);
+                } catch (const NumericalIssue& e) {
+                    OpmLog::debug(e.what());
+                    throw;
+                }
+            }
+        }
+        for (int w = 0; w < nw; ++w) {
+            if (msw_contributes_[w]) {
+                msw_batch_[w]->applyCTranspose(msw_solutions_[w], Ax);
+            }
+        }
+    }
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    prepareWellBatch()
+    {
+        well_batch_.clear();
+        unbatched_wells_.clear();
+        msw_batch_.clear();
+        for (std::size_t i = 0; i < well_container_.size(); ++i) {
+            const auto* stdwell = dynamic_cast<const StandardWell<TypeTag>*>(well_container_[i].get());
+            if (!stdwell || !stdwell->addToBatch(well_batch_)) {
+                unbatched_wells_.push_back(i);
+            }
+        }
+        well_batch_.finalize();
+        well_batch_valid_ = true;
+
+#ifdef _OPENMP
+        if (!param_.threaded_well_assembly_ || omp_get_max_threads() < 2) {
+            return;
+        }
+        // msw_batch_ replaces unbatched_wells_ in apply(x, Ax), so it has to hold all of them
+        for (const int idx : unbatched_wells_) {
+            const auto* mswell = dynamic_cast<const MultisegmentWell<TypeTag>*>(well_container_[idx].get());
+            if (!mswell) {
+                msw_batch_.clear();
+                return;
+            }
+            msw_batch_.push_back(mswell);
+        }
+        if (msw_batch_.size() < 2) {
+            msw_batch_.clear();
+        }
+#endif
+    }
+
 #if HAVE_CUDA || HAVE_OPENCL
     template<typename TypeTag>
     void
@@ -1145,6 +1459,9 @@ namespace Opm {
                 }
             }
         }
+
+        // copy the data of all StandardWells to the device at once
+        wellContribs.upload();
     }
 #endif
 
@@ -1229,14 +1546,13 @@ namespace Opm {
             }
         }
         
+        // The report and the messages are gathered together.
         const Opm::Parallel::Communication comm = grid().comm();
-        DeferredLogger global_deferredLogger = gatherDeferredLogger(local_deferredLogger, comm);
+        auto [report, global_deferredLogger] = gatherConvergenceReport(local_report, local_deferredLogger, comm);
         if (terminal_output_) {
             global_deferredLogger.logMessages();
         }
 
-        ConvergenceReport report = gatherConvergenceReport(local_report, comm);
-
         // Log debug messages for NaN or too large residuals.
         if (terminal_output_) {
             for (const auto& f : report.wellFailures()) {
@@ -1359,9 +1675,17 @@ namespace Opm {
                          DeferredLogger& deferred_logger)
     {
         updateAndCommunicateGroupData(reportStepIdx, iterationIdx);
-        // if a well or group change control it affects all wells that are under the same group
+        // if a well or group change control it affects all wells that are under the same group.
+        // Wells under individual control keep their targets, and the wells that switched
+        // control have already been set to their new targets.
         for (const auto& well : well_container_) {
-            well->updateWellStateWithTarget(ebosSimulator_, this->groupState(), this->wellState(), deferred_logger);
+            const auto& ws = this->wellState().well(well->indexOfWell());
+            const bool under_group_control = well->isInjector()
+                ? ws.injection_cmode == Well::InjectorCMode::GRUP
+                : ws.production_cmode == Well::ProducerCMode::GRUP;
+            if (under_group_control) {
+                well->updateWellStateWithTarget(ebosSimulator_, this->groupState(), this->wellState(), deferred_logger);
+            }
         }
         updateAndCommunicateGroupData(reportStepIdx, iterationIdx);
     }
@@ -1424,6 +1748,43 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     calculateProductivityIndexValues(DeferredLogger& deferred_logger)
     {
+#ifdef _OPENMP
+        const int nw = well_container_.size();
+        if (param_.threaded_well_assembly_ && nw > 1 && omp_get_max_threads() > 1) {
+            // Every well only writes its own PI values. A distributed well sums its
+            // values over the processes, so those wells are done in the same order
+            // on all processes after the others.
+            well_loggers_.resize(nw);
+            std::vector<std::exception_ptr> exceptions(nw);
+#pragma omp parallel for schedule(dynamic)
+            for (int w = 0; w < nw; ++w) {
+                const auto* well = well_container_[w].get();
+                if (well->parallelWellInfo().communication().size() > 1) {
+                    continue;
+                }
+                try {
+                    this->calculateProductivityIndexValues(well, well_loggers_[w]);
+                } catch (...) {
+                    exceptions[w] = std::current_exception();
+                }
+            }
+            for (int w = 0; w < nw; ++w) {
+                deferred_logger.appendMessages(well_loggers_[w]);
+                well_loggers_[w].clearMessages();
+            }
+            for (const auto& exception : exceptions) {
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+            }
+            for (const auto& wellPtr : this->well_container_) {
+                if (wellPtr->parallelWellInfo().communication().size() > 1) {
+                    this->calculateProductivityIndexValues(wellPtr.get(), deferred_logger);
+                }
+            }
+            return;
+        }
+#endif
         for (const auto& wellPtr : this->well_container_) {
             this->calculateProductivityIndexValues(wellPtr.get(), deferred_logger);
         }
@@ -1485,24 +1846,26 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     prepareTimeStep(DeferredLogger& deferred_logger)
     {
-        for (const auto& well : well_container_) {
-            auto& events = this->wellState().well(well->indexOfWell()).events;
+        ScopedTimer solveTimer(TimingRegistry::Region::WellSolve);
+        forEachWell(deferred_logger, [this](auto& well, WellState& well_state, DeferredLogger& well_logger)
+        {
+            auto& events = well_state.well(well.indexOfWell()).events;
             if (events.hasEvent(WellState::event_mask)) {
-                well->updateWellStateWithTarget(ebosSimulator_, this->groupState(), this->wellState(), deferred_logger);
+                well.updateWellStateWithTarget(ebosSimulator_, this->groupState(), well_state, well_logger);
                 // There is no new well control change input within a report step,
                 // so next time step, the well does not consider to have effective events anymore.
                 events.clearEvent(WellState::event_mask);
             }
             // solve the well equation initially to improve the initial solution of the well model
-            if (param_.solve_welleq_initially_ && well->isOperableAndSolvable()) {
+            if (param_.solve_welleq_initially_ && well.isOperableAndSolvable()) {
                 try {
-                    well->solveWellEquation(ebosSimulator_, this->wellState(), this->groupState(), deferred_logger);
+                    well.solveWellEquation(ebosSimulator_, well_state, this->groupState(), well_logger);
                 } catch (const std::exception& e) {
-                    const std::string msg = "Compute initial well solution for " + well->name() + " initially failed. Continue with the privious rates";
-                    deferred_logger.warning("WELL_INITIAL_SOLVE_FAILED", msg);
+                    const std::string msg = "Compute initial well solution for " + well.name() + " initially failed. Continue with the privious rates";
+                    well_logger.warning("WELL_INITIAL_SOLVE_FAILED", msg);
                 }
             }
-        }
+        });
         updatePrimaryVariables(deferred_logger);
     }
 
@@ -29,12 +29,25 @@ GasLiftCommon(
     bool glift_debug
 ) :
     well_state_{well_state},
-    deferred_logger_{deferred_logger},
+    deferred_logger_{&deferred_logger},
     debug{glift_debug}
 {
 
 }
 
+/****************************************
+ * Public methods in alphabetical order
+ ****************************************/
+
+DeferredLogger&
+GasLiftCommon::
+redirectLogger(DeferredLogger& logger)
+{
+    DeferredLogger& previous = *this->deferred_logger_;
+    this->deferred_logger_ = &logger;
+    return previous;
+}
+
 /****************************************
  * Protected methods in alphabetical order
  ****************************************/
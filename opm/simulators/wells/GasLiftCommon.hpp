@@ -33,6 +33,10 @@ class GasLiftCommon
 public:
     virtual ~GasLiftCommon() = default;
 
+    /// Send the messages of this object to logger instead, e.g. to a logger
+    /// of the thread evaluating it. Returns the logger used before.
+    DeferredLogger& redirectLogger(DeferredLogger& logger);
+
 protected:
     GasLiftCommon(
         WellState &well_state,
@@ -43,7 +47,7 @@ protected:
     virtual void displayDebugMessage_(const std::string& msg) const = 0;
 
     WellState &well_state_;
-    DeferredLogger &deferred_logger_;
+    DeferredLogger *deferred_logger_;
     bool debug;
 };
 
@@ -423,7 +423,7 @@ displayDebugMessage_(const std::string &msg) const
     if (this->debug) {
         const std::string message = fmt::format(
              "  GLIFT (DEBUG) : Init group info : {}", msg);
-        this->deferred_logger_.info(message);
+        this->deferred_logger_->info(message);
     }
 }
 
@@ -435,7 +435,7 @@ displayDebugMessage_(const std::string &msg, const std::string &well_name)
         const std::string message = fmt::format(
              "  GLIFT (DEBUG) : Init group info : Well {} : {}",
              well_name, msg);
-        this->deferred_logger_.info(message);
+        this->deferred_logger_->info(message);
     }
 }
 
@@ -56,6 +56,8 @@ namespace Opm
 
     private:
         std::optional<double> computeBhpAtThpLimit_(double alq) const override;
+        std::vector<std::optional<double>> computeBhpAtThpLimits_(
+            const std::vector<double>& alqs) const override;
         BasicRates computeWellRates_(
             double bhp, bool bhp_is_limited, bool debug_output=true) const override;
         void setAlqMaxRate_(const GasLiftOpt::Well& well);
@@ -270,9 +270,11 @@ checkInitialALQmodified_(double alq, double initial_alq) const
         return false;
     }
     else {
-        const std::string msg = fmt::format("initial ALQ changed from {} "
-            "to {} before iteration starts..", initial_alq, alq);
-        displayDebugMessage_(msg);
+        if (this->debug) {
+            const std::string msg = fmt::format("initial ALQ changed from {} "
+                "to {} before iteration starts..", initial_alq, alq);
+            displayDebugMessage_(msg);
+        }
         return true;
     }
 }
@@ -300,7 +302,7 @@ computeInitialWellRates_() const
 {
     std::optional<BasicRates> rates;
     if (auto bhp = computeBhpAtThpLimit_(this->orig_alq_); bhp) {
-        {
+        if (this->debug) {
             const std::string msg = fmt::format(
                 "computed initial bhp {} given thp limit and given alq {}",
                 *bhp, this->orig_alq_);
@@ -308,7 +310,7 @@ computeInitialWellRates_() const
         }
         auto [new_bhp, bhp_is_limited] = getBhpWithLimit_(*bhp);
         rates = computeWellRates_(new_bhp, bhp_is_limited);
-        if (rates) {
+        if (rates && this->debug) {
             const std::string msg = fmt::format(
                 "computed initial well potentials given bhp, "
                 "oil: {}, gas: {}, water: {}",
@@ -346,6 +348,23 @@ computeWellRatesWithALQ_(double alq) const
     return rates;
 }
 
+// Evaluates the rates of all candidate ALQ values in one call, such that the
+//   well can share the inflow samples of the bhp(thp) solve between them.
+std::vector<std::optional<GasLiftSingleWellGeneric::BasicRates>>
+GasLiftSingleWellGeneric::
+computeWellRatesWithALQs_(const std::vector<double>& alqs, bool debug_output) const
+{
+    std::vector<std::optional<BasicRates>> rates(alqs.size());
+    const auto bhps = computeBhpAtThpLimits_(alqs);
+    for (std::size_t i = 0; i < alqs.size(); ++i) {
+        if (bhps[i]) {
+            auto [bhp, bhp_is_limited] = getBhpWithLimit_(*bhps[i]);
+            rates[i] = computeWellRates_(bhp, bhp_is_limited, debug_output);
+        }
+    }
+    return rates;
+}
+
 void
 GasLiftSingleWellGeneric::
 debugCheckNegativeGradient_(double grad, double alq, double new_alq,
@@ -382,35 +401,35 @@ void
 GasLiftSingleWellGeneric::
 debugShowBhpAlqTable_()
 {
-    double alq = 0.0;
     const std::string fmt_fmt1 {"{:^12s} {:^12s} {:^12s} {:^12s}"};
     const std::string fmt_fmt2 {"{:>12.5g} {:>12.5g} {:>12.5g} {:>12.5g}"};
     const std::string header = fmt::format(fmt_fmt1, "ALQ", "BHP", "oil", "gas");
     displayDebugMessage_(header);
     auto max_it = 50;
-    auto it = 1;
-    while (alq <= (this->max_alq_+this->increment_)) {
-        auto bhp_at_thp_limit = computeBhpAtThpLimit_(alq);
-        if (!bhp_at_thp_limit) {
+    std::vector<double> alqs;
+    for (double alq = 0.0; alq <= (this->max_alq_+this->increment_); alq += this->increment_) {
+        if (static_cast<int>(alqs.size()) > max_it) {
+            const std::string msg = fmt::format(
+                "ALQ table : max iterations {} reached. Stopping iteration.", max_it);
+            displayDebugMessage_(msg);
+            break;
+        }
+        alqs.push_back(alq);
+    }
+    const auto bhps = computeBhpAtThpLimits_(alqs);
+    for (std::size_t i = 0; i < alqs.size(); ++i) {
+        if (!bhps[i]) {
             const std::string msg = fmt::format("Failed to get converged potentials "
-                "for ALQ = {}. Skipping.", alq );
+                "for ALQ = {}. Skipping.", alqs[i]);
             displayDebugMessage_(msg);
         }
         else {
-            auto [bhp, bhp_is_limited] = getBhpWithLimit_(*bhp_at_thp_limit);
+            auto [bhp, bhp_is_limited] = getBhpWithLimit_(*bhps[i]);
             auto rates = computeWellRates_(bhp, bhp_is_limited, /*debug_out=*/false);
             const std::string msg = fmt::format(
-                fmt_fmt2, alq, bhp, rates.oil, rates.gas);
-            displayDebugMessage_(msg);
-        }
-        alq += this->increment_;
-        if (it > max_it) {
-            const std::string msg = fmt::format(
-                "ALQ table : max iterations {} reached. Stopping iteration.", max_it);
+                fmt_fmt2, alqs[i], bhp, rates.oil, rates.gas);
             displayDebugMessage_(msg);
-            break;
         }
-        it++;
     }
 }
 
@@ -497,7 +516,7 @@ displayDebugMessage_(const std::string& msg) const
     if (this->debug) {
         const std::string message = fmt::format(
             "  GLIFT (DEBUG) : Well {} : {}", this->well_name_, msg);
-        this->deferred_logger_.info(message);
+        this->deferred_logger_->info(message);
     }
 }
 
@@ -507,7 +526,7 @@ displayWarning_(const std::string& msg)
 {
     const std::string message = fmt::format(
         "GAS LIFT OPTIMIZATION, WELL {} : {}", this->well_name_, msg);
-    this->deferred_logger_.warning("WARNING", message);
+    this->deferred_logger_->warning("WARNING", message);
 }
 
 std::pair<double, bool>
@@ -639,10 +658,12 @@ getRateWithLimit_(Rate rate_type, const BasicRates &rates) const
     if (hasProductionControl_(rate_type)) {
         auto target = getProductionTarget_(rate_type);
         if (new_rate > target) {
-            const std::string msg = fmt::format("limiting {} rate to target: "
-                                                "computed rate: {}, target: {}",
-                  GasLiftGroupInfo::rateToString(rate_type), new_rate, target);
-            displayDebugMessage_(msg);
+            if (this->debug) {
+                const std::string msg = fmt::format("limiting {} rate to target: "
+                                                    "computed rate: {}, target: {}",
+                      GasLiftGroupInfo::rateToString(rate_type), new_rate, target);
+                displayDebugMessage_(msg);
+            }
             new_rate = target;
             target_type = rate_type;
         }
@@ -675,12 +696,14 @@ getRateWithLimit_(Rate rate_type, const BasicRates &rates) const
             //  limited = true.
             new_rate = fraction * liq_target;
             target_type = Rate::liquid;
-            const std::string msg = fmt::format(
-                "limiting {} rate to {} due to LRAT target: "
-                "computed LRAT: {}, target LRAT: {}",
-                GasLiftGroupInfo::rateToString(rate_type), new_rate,
-                liq_rate, liq_target);
-            displayDebugMessage_(msg);
+            if (this->debug) {
+                const std::string msg = fmt::format(
+                    "limiting {} rate to {} due to LRAT target: "
+                    "computed LRAT: {}, target LRAT: {}",
+                    GasLiftGroupInfo::rateToString(rate_type), new_rate,
+                    liq_rate, liq_target);
+                displayDebugMessage_(msg);
+            }
         }
     }
     // TODO: Also check RESV target?
@@ -955,7 +978,7 @@ logSuccess_(double alq, const int iteration_idx)
          this->well_name_,
          ((alq > this->orig_alq_) ? "increased" : "decreased"),
          this->orig_alq_, alq);
-    this->deferred_logger_.info(message);
+    this->deferred_logger_->info(message);
 }
 
 std::pair<GasLiftSingleWellGeneric::LimitedRates, double>
@@ -1494,10 +1517,11 @@ addOrSubtractAlqIncrement(double alq)
 {
     auto [alq_opt, limited]
         = this->parent.addOrSubtractAlqIncrement_(alq, this->increase);
-    if (!alq_opt) {
+    if (!alq_opt && this->parent.debug) {
         const std::string msg = fmt::format(
             "iteration {}, alq = {} : not able to {} ALQ increment",
             this->it, alq, (this->increase ? "add" : "subtract"));
+        this->parent.displayDebugMessage_(msg);
     }
     return {alq_opt, limited};
 }
@@ -249,10 +249,14 @@ protected:
     bool checkInitialALQmodified_(double alq, double initial_alq) const;
     bool checkThpControl_() const;
     virtual std::optional<double> computeBhpAtThpLimit_(double alq) const = 0;
+    virtual std::vector<std::optional<double>> computeBhpAtThpLimits_(
+                            const std::vector<double>& alqs) const = 0;
     std::optional<BasicRates> computeInitialWellRates_() const;
     std::optional<LimitedRates> computeLimitedWellRatesWithALQ_(double alq) const;
     virtual BasicRates computeWellRates_(double bhp, bool bhp_is_limited,                                                             bool debug_output = true) const = 0;
     std::optional<BasicRates> computeWellRatesWithALQ_(double alq) const;
+    std::vector<std::optional<BasicRates>> computeWellRatesWithALQs_(
+                            const std::vector<double>& alqs, bool debug_output = true) const;
     void debugCheckNegativeGradient_(double grad, double alq, double new_alq,
                                      double oil_rate, double new_oil_rate,
                                      double gas_rate, double new_gas_rate,
@@ -101,7 +101,7 @@ computeWellRates_( double bhp, bool bhp_is_limited, bool debug_output ) const
 {
     std::vector<double> potentials(NUM_PHASES, 0.0);
     this->well_.computeWellRatesWithBhp(
-        this->ebos_simulator_, bhp, potentials, this->deferred_logger_);
+        this->ebos_simulator_, bhp, potentials, *this->deferred_logger_);
     if (debug_output) {
         const std::string msg = fmt::format("computed well potentials given bhp {}, "
             "oil: {}, gas: {}, water: {}", bhp,
@@ -125,28 +125,39 @@ std::optional<double>
 GasLiftSingleWell<TypeTag>::
 computeBhpAtThpLimit_(double alq) const
 {
-    auto bhp_at_thp_limit = this->well_.computeBhpAtThpLimitProdWithAlq(
+    return computeBhpAtThpLimits_({alq}).front();
+}
+
+template<typename TypeTag>
+std::vector<std::optional<double>>
+GasLiftSingleWell<TypeTag>::
+computeBhpAtThpLimits_(const std::vector<double>& alqs) const
+{
+    auto bhps_at_thp_limit = this->well_.computeBhpAtThpLimitProdWithAlqs(
         this->ebos_simulator_,
         this->summary_state_,
-        this->deferred_logger_,
-        alq);
-    if (bhp_at_thp_limit) {
-        if (*bhp_at_thp_limit < this->controls_.bhp_limit) {
+        *this->deferred_logger_,
+        alqs);
+    for (std::size_t i = 0; i < alqs.size(); ++i) {
+        auto& bhp_at_thp_limit = bhps_at_thp_limit[i];
+        const double alq = alqs[i];
+        if (bhp_at_thp_limit) {
+            if (*bhp_at_thp_limit < this->controls_.bhp_limit) {
+                const std::string msg = fmt::format(
+                    "Computed bhp ({}) from thp limit is below bhp limit ({}), (ALQ = {})."
+                    " Using bhp limit instead",
+                    *bhp_at_thp_limit, this->controls_.bhp_limit, alq);
+                displayDebugMessage_(msg);
+                bhp_at_thp_limit = this->controls_.bhp_limit;
+            }
+        }
+        else {
             const std::string msg = fmt::format(
-                "Computed bhp ({}) from thp limit is below bhp limit ({}), (ALQ = {})."
-                " Using bhp limit instead",
-                *bhp_at_thp_limit, this->controls_.bhp_limit, alq);
+                "Failed in getting converged bhp potential from thp limit (ALQ = {})", alq);
             displayDebugMessage_(msg);
-            bhp_at_thp_limit = this->controls_.bhp_limit;
         }
-        //bhp_at_thp_limit = std::max(*bhp_at_thp_limit, this->controls_.bhp_limit);
-    }
-    else {
-        const std::string msg = fmt::format(
-            "Failed in getting converged bhp potential from thp limit (ALQ = {})", alq);
-        displayDebugMessage_(msg);
     }
-    return bhp_at_thp_limit;
+    return bhps_at_thp_limit;
 }
 
 template<typename TypeTag>
@@ -29,10 +29,16 @@
 #include <opm/simulators/wells/WellInterfaceGeneric.hpp>
 #include <opm/simulators/wells/WellState.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <exception>
 #include <optional>
 #include <string>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <fmt/format.h>
 
 namespace Opm {
@@ -47,20 +53,30 @@ GasLiftStage2::GasLiftStage2(
     GLiftProdWells &prod_wells,
     GLiftOptWells &glift_wells,
     GLiftWellStateMap &state_map,
+    GradientCache &grad_cache,
+    bool threaded,
     bool glift_debug
 ) :
     GasLiftCommon(well_state, deferred_logger, glift_debug)
     , prod_wells_{prod_wells}
     , stage1_wells_{glift_wells}
     , well_state_map_{state_map}
+    , grad_cache_{grad_cache}
     , report_step_idx_{report_step_idx}
     , summary_state_{summary_state}
     , schedule_{schedule}
     , glo_{schedule_.glo(report_step_idx_)}
     , comm_{comm}
+    , threaded_{threaded}
 {
 //    this->time_step_idx_
 //        = this->ebos_simulator_.model().newtonMethod().currentTimeStep();
+    if (this->grad_cache_.report_step != report_step_idx) {
+        // the gas lift controls may have changed
+        this->grad_cache_.inc_grads.clear();
+        this->grad_cache_.dec_grads.clear();
+        this->grad_cache_.report_step = report_step_idx;
+    }
 }
 
 /********************************************
@@ -129,52 +145,58 @@ addOrRemoveALQincrement_(GradMap &grad_map, const std::string& well_name, bool a
         this->well_state_[well_name].well_potentials = well_pot;
 }
 
+void
+GasLiftStage2::
+cacheGrad_(const std::string& well_name, bool increase, const std::optional<GradInfo>& grad)
+{
+    if (this->grad_cache_.tolerance <= 0.0)
+        return;
+    const GasLiftWellState &state = *(this->well_state_map_.at(well_name).get());
+    auto [oil_rate, gas_rate] = state.getRates();
+    auto& cached_grads = increase ? this->grad_cache_.inc_grads : this->grad_cache_.dec_grads;
+    cached_grads.insert_or_assign(well_name,
+        GradientCache::Entry{oil_rate, gas_rate, state.alq(), grad});
+}
+
 std::optional<GasLiftStage2::GradInfo>
 GasLiftStage2::
 calcIncOrDecGrad_(
     const std::string well_name, const GasLiftSingleWell &gs_well, bool increase)
 {
-
-    // only applies to wells in the well_state_map (i.e. wells on this rank)
-    if(this->well_state_map_.count(well_name) == 0)
-        return std::nullopt;
-    if (this->debug) {
-        const std::string msg = fmt::format("well {} : calculating {} gradient..",
-            well_name, (increase ? "incremental" : "decremental"));
-        displayDebugMessage_(msg);
+    auto [grad, computed] = evalIncOrDecGrad_(well_name, gs_well, increase);
+    if (computed) {
+        cacheGrad_(well_name, increase, grad);
     }
-    GasLiftWellState &state = *(this->well_state_map_.at(well_name).get());
-    if (checkRateAlreadyLimited_(state, increase)) {
-        /*
+    if (grad && this->debug) {
         const std::string msg = fmt::format(
-            "well {} : not able to obtain {} gradient",
-            well_name,
-            (increase ? "incremental" : "decremental")
+          "well {} : adding {} gradient = {}",
+          well_name,
+          (increase ? "incremental" : "decremental"),
+          grad->grad
         );
         displayDebugMessage_(msg);
-        */
-        return std::nullopt;
-    }
-    else {
-        auto [oil_rate, gas_rate] = state.getRates();
-        auto alq = state.alq();
-        auto grad = gs_well.calcIncOrDecGradient(oil_rate, gas_rate, alq, increase);
-        if (grad) {
-            const std::string msg = fmt::format(
-              "well {} : adding {} gradient = {}",
-              well_name,
-              (increase ? "incremental" : "decremental"),
-              grad->grad
-            );
-            displayDebugMessage_(msg);
-        }
-        return grad;
     }
+    return grad;
 }
 
 bool
 GasLiftStage2::
-checkRateAlreadyLimited_(GasLiftWellState &state, bool increase)
+checkCachedGradValid_(const GradientCache::Entry& entry,
+                      double oil_rate, double gas_rate, double alq) const
+{
+    const double tol = this->grad_cache_.tolerance;
+    auto rateUnchanged = [tol](double old_rate, double new_rate) {
+        return std::abs(new_rate - old_rate)
+            <= tol * std::max(std::abs(old_rate), std::abs(new_rate));
+    };
+    return tol > 0.0 && entry.alq == alq
+        && rateUnchanged(entry.oil_rate, oil_rate)
+        && rateUnchanged(entry.gas_rate, gas_rate);
+}
+
+bool
+GasLiftStage2::
+checkRateAlreadyLimited_(const GasLiftWellState &state, bool increase) const
 {
     auto current_increase = state.increase();
     bool do_check = false;
@@ -193,12 +215,14 @@ checkRateAlreadyLimited_(GasLiftWellState &state, bool increase)
     }
     if (do_check) {
         if (state.gasIsLimited() || state.oilIsLimited() || state.alqIsLimited()) {
-            const std::string msg = fmt::format(
-                "{} gradient : skipping since {} was limited in previous step",
-                (increase ? "incremental" : "decremental"),
-                (state.oilIsLimited() ? "oil" :
-                    (state.gasIsLimited() ? "gas" : "alq")));
-            displayDebugMessage_(msg);
+            if (this->debug) {
+                const std::string msg = fmt::format(
+                    "{} gradient : skipping since {} was limited in previous step",
+                    (increase ? "incremental" : "decremental"),
+                    (state.oilIsLimited() ? "oil" :
+                        (state.gasIsLimited() ? "gas" : "alq")));
+                displayDebugMessage_(msg);
+            }
             return true;
         }
     }
@@ -235,7 +259,7 @@ displayWarning_(const std::string &msg, const std::string &group_name)
 {
     const std::string message = fmt::format(
         "GAS LIFT OPTIMIZATION (STAGE2), GROUP: {} : {}", group_name, msg);
-    this->deferred_logger_.warning("WARNING", message);
+    this->deferred_logger_->warning("WARNING", message);
 }
 
 void
@@ -244,7 +268,7 @@ displayWarning_(const std::string &msg)
 {
     const std::string message = fmt::format(
         "GAS LIFT OPTIMIZATION (STAGE2) : {}", msg);
-    this->deferred_logger_.warning("WARNING", message);
+    this->deferred_logger_->warning("WARNING", message);
 }
 
 void
@@ -254,7 +278,7 @@ displayDebugMessage_(const std::string &msg) const
     if (this->debug) {
         const std::string message = fmt::format(
             "  GLIFT2 (DEBUG) : {}", msg);
-        this->deferred_logger_.info(message);
+        this->deferred_logger_->info(message);
     }
 }
 
@@ -280,6 +304,45 @@ displayDebugMessage_(const std::string &msg, const std::string &group_name)
     }
 }
 
+// Returns the gradient, and whether it was computed instead of taken from
+//   the cache. The cache is not modified, such that the gradients of
+//   different wells can be evaluated concurrently.
+std::pair<std::optional<GasLiftStage2::GradInfo>, bool>
+GasLiftStage2::
+evalIncOrDecGrad_(
+    const std::string& well_name, const GasLiftSingleWell &gs_well, bool increase) const
+{
+    // only applies to wells in the well_state_map (i.e. wells on this rank)
+    if(this->well_state_map_.count(well_name) == 0)
+        return {std::nullopt, false};
+    if (this->debug) {
+        const std::string msg = fmt::format("well {} : calculating {} gradient..",
+            well_name, (increase ? "incremental" : "decremental"));
+        displayDebugMessage_(msg);
+    }
+    const GasLiftWellState &state = *(this->well_state_map_.at(well_name).get());
+    if (checkRateAlreadyLimited_(state, increase)) {
+        /*
+        const std::string msg = fmt::format(
+            "well {} : not able to obtain {} gradient",
+            well_name,
+            (increase ? "incremental" : "decremental")
+        );
+        displayDebugMessage_(msg);
+        */
+        return {std::nullopt, false};
+    }
+    auto [oil_rate, gas_rate] = state.getRates();
+    auto alq = state.alq();
+    const auto& cached_grads = increase ? this->grad_cache_.inc_grads : this->grad_cache_.dec_grads;
+    auto cached = cached_grads.find(well_name);
+    if (cached != cached_grads.end()
+            && checkCachedGradValid_(cached->second, oil_rate, gas_rate, alq)) {
+        return {cached->second.grad, false};
+    }
+    return {gs_well.calcIncOrDecGradient(oil_rate, gas_rate, alq, increase), true};
+}
+
 std::tuple<double, double, double>
 GasLiftStage2::
 getCurrentGroupRates_(const Group &group)
@@ -465,6 +528,53 @@ getGroupGliftWellsRecursive_(const Group &group,
     }
 }
 
+// Synchronize the gradients of the given wells after they were recalculated
+//   on the ranks owning them. Compared to mpiSyncGlobalGradVector_() only the
+//   entries of these wells are exchanged: for every well the owning rank
+//   contributes whether it has an incremental and a decremental gradient and
+//   their values, all other ranks contribute zeros, such that a single sum
+//   distributes them.
+void
+GasLiftStage2::
+mpiSyncChangedGrads_(const std::vector<std::string> &well_names,
+    std::vector<GradPair> &inc_grads, std::vector<GradPair> &dec_grads)
+{
+    if (this->comm_.size() == 1)
+        return;
+
+    auto findGrad = [](std::vector<GradPair> &grads, const std::string &name) {
+        return std::find_if(grads.begin(), grads.end(),
+            [&name](const GradPair &grad) { return grad.first == name; });
+    };
+    std::vector<double> data(4 * well_names.size(), 0.0);
+    for (std::size_t i = 0; i < well_names.size(); ++i) {
+        const auto &name = well_names[i];
+        if (this->well_state_map_.count(name) == 0 || !this->well_state_.wellIsOwned(name))
+            continue;
+        if (auto itr = findGrad(inc_grads, name); itr != inc_grads.end()) {
+            data[4*i] = 1.0;
+            data[4*i + 1] = itr->second;
+        }
+        if (auto itr = findGrad(dec_grads, name); itr != dec_grads.end()) {
+            data[4*i + 2] = 1.0;
+            data[4*i + 3] = itr->second;
+        }
+    }
+    this->comm_.sum(data.data(), data.size());
+
+    for (std::size_t i = 0; i < well_names.size(); ++i) {
+        const auto &name = well_names[i];
+        for (auto [grads, offset] : {std::make_pair(&inc_grads, 0), std::make_pair(&dec_grads, 2)}) {
+            if (data[4*i + offset] > 0.0) {
+                updateGradVector_(name, *grads, data[4*i + offset + 1]);
+            }
+            else if (auto itr = findGrad(*grads, name); itr != grads->end()) {
+                grads->erase(itr);
+            }
+        }
+    }
+}
+
 void
 GasLiftStage2::
 mpiSyncGlobalGradVector_(std::vector<GradPair> &grads_global) const
@@ -687,7 +797,7 @@ redistributeALQ_(std::vector<GasLiftSingleWell *> &wells,  const Group &group,
     }
     bool stop_iteration = false;
     while (!stop_iteration && (state.it++ <= this->max_iterations_)) {
-        state.debugShowIterationInfo();
+        if (this->debug) state.debugShowIterationInfo();
         auto [min_dec_grad, max_inc_grad]
             = state.getEcoGradients(inc_grads, dec_grads);
         if (min_dec_grad) {
@@ -770,9 +880,9 @@ removeSurplusALQ_(const Group &group,
             recalculateGradientAndUpdateData_(
                         dec_grad_itr, /*increase=*/false, dec_grads, inc_grads);
 
-            // The dec_grads and inc_grads needs to be syncronized across ranks
-            mpiSyncGlobalGradVector_(dec_grads);
-            mpiSyncGlobalGradVector_(inc_grads);
+            // The dec_grads and inc_grads needs to be syncronized across ranks,
+            //   only the gradients of this well changed
+            mpiSyncChangedGrads_({well_name}, inc_grads, dec_grads);
             // NOTE: recalculateGradientAndUpdateData_() will remove the current gradient
             //   from dec_grads if it cannot calculate a new decremental gradient.
             //   This will invalidate dec_grad_itr and well_name
@@ -829,8 +939,11 @@ void
 GasLiftStage2::
 sortGradients_(std::vector<GradPair> &grads)
 {
-    auto cmp = [](GradPair a, GradPair b) {
-         return a.second <  b.second;
+    // Ties are broken by the well names, such that the order does not depend
+    //   on the order of the entries, which may differ between the ranks
+    auto cmp = [](const GradPair& a, const GradPair& b) {
+         return a.second < b.second
+             || (a.second == b.second && a.first < b.first);
     };
     std::sort(grads.begin(), grads.end(), cmp);
 }
@@ -872,6 +985,14 @@ GasLiftStage2::OptimizeState::
 calculateEcoGradients(std::vector<GasLiftSingleWell *> &wells,
            std::vector<GradPair> &inc_grads, std::vector<GradPair> &dec_grads)
 {
+#ifdef _OPENMP
+    // The debug output is written while evaluating, so it is only threaded without it
+    if (this->parent.threaded_ && !this->parent.debug
+            && wells.size() > 1 && omp_get_max_threads() > 1) {
+        calculateEcoGradientsThreaded(wells, inc_grads, dec_grads);
+        return;
+    }
+#endif
     for (auto well_ptr : wells) {
         const auto &gs_well = *well_ptr;  // gs = GasLiftSingleWell
         const auto &name = gs_well.name();
@@ -889,6 +1010,66 @@ calculateEcoGradients(std::vector<GasLiftSingleWell *> &wells,
 }
 
 
+// As calculateEcoGradients(), with the wells evaluated concurrently. The
+//   gradients of different wells are independent; the messages of every well
+//   are collected in a logger of its own, and the gradients are stored in
+//   the cache and in the gradient vectors afterwards in the order of the wells.
+void
+GasLiftStage2::OptimizeState::
+calculateEcoGradientsThreaded(std::vector<GasLiftSingleWell *> &wells,
+           std::vector<GradPair> &inc_grads, std::vector<GradPair> &dec_grads)
+{
+    using EvalResult = std::pair<std::optional<GradInfo>, bool>;
+    const int num_wells = wells.size();
+    std::vector<EvalResult> inc_results(num_wells);
+    std::vector<EvalResult> dec_results(num_wells);
+    std::vector<DeferredLogger> loggers(num_wells);
+    std::vector<DeferredLogger*> well_loggers(num_wells);
+    std::vector<std::exception_ptr> exceptions(num_wells);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int w = 0; w < num_wells; ++w) {
+        auto &gs_well = *wells[w];
+        well_loggers[w] = &gs_well.redirectLogger(loggers[w]);
+        try {
+            inc_results[w] = this->parent.evalIncOrDecGrad_(gs_well.name(), gs_well, /*increase=*/true);
+            dec_results[w] = this->parent.evalIncOrDecGrad_(gs_well.name(), gs_well, /*increase=*/false);
+        } catch (...) {
+            exceptions[w] = std::current_exception();
+        }
+        gs_well.redirectLogger(*well_loggers[w]);
+    }
+    for (int w = 0; w < num_wells; ++w) {
+        well_loggers[w]->appendMessages(loggers[w]);
+    }
+    for (int w = 0; w < num_wells; ++w) {
+        if (exceptions[w]) {
+            std::rethrow_exception(exceptions[w]);
+        }
+    }
+
+    for (int w = 0; w < num_wells; ++w) {
+        const auto &name = wells[w]->name();
+        auto& [inc_grad, inc_computed] = inc_results[w];
+        if (inc_computed) {
+            this->parent.cacheGrad_(name, /*increase=*/true, inc_grad);
+        }
+        if (inc_grad) {
+            inc_grads.emplace_back(std::make_pair(name, inc_grad->grad));
+            this->parent.saveIncGrad_(name, *inc_grad);
+        }
+        auto& [dec_grad, dec_computed] = dec_results[w];
+        if (dec_computed) {
+            this->parent.cacheGrad_(name, /*increase=*/false, dec_grad);
+        }
+        if (dec_grad) {
+            dec_grads.emplace_back(std::make_pair(name, dec_grad->grad));
+            this->parent.saveDecGrad_(name, *dec_grad);
+        }
+    }
+}
+
 bool
 GasLiftStage2::OptimizeState::
 checkAtLeastTwoWells(std::vector<GasLiftSingleWell *> &wells)
@@ -966,14 +1147,19 @@ recalculateGradients(
          std::vector<GradPair> &inc_grads, std::vector<GradPair> &dec_grads,
          GradPairItr &min_dec_grad_itr, GradPairItr &max_inc_grad_itr)
 {
+    // NOTE: The names are copied since recalculateGradientAndUpdateData_()
+    //   may invalidate the iterators
+    std::vector<std::string> changed_wells {max_inc_grad_itr->first};
+    if (min_dec_grad_itr->first != max_inc_grad_itr->first)
+        changed_wells.push_back(min_dec_grad_itr->first);
     this->parent.recalculateGradientAndUpdateData_(
         max_inc_grad_itr, /*increase=*/true, inc_grads, dec_grads);
     this->parent.recalculateGradientAndUpdateData_(
         min_dec_grad_itr, /*increase=*/false, dec_grads, inc_grads);
 
-    // The dec_grads and inc_grads needs to be syncronized across ranks
-    this->parent.mpiSyncGlobalGradVector_(dec_grads);
-    this->parent.mpiSyncGlobalGradVector_(inc_grads);
+    // The dec_grads and inc_grads needs to be syncronized across ranks,
+    //   only the gradients of the two wells changed
+    this->parent.mpiSyncChangedGrads_(changed_wells, inc_grads, dec_grads);
 }
 
 // Take one ALQ increment from well1, and give it to well2
@@ -981,12 +1167,14 @@ void
 GasLiftStage2::OptimizeState::
     redistributeALQ( GradPairItr &min_dec_grad, GradPairItr &max_inc_grad)
 {
-    const std::string msg = fmt::format(
-        "redistributing ALQ from well {} (dec gradient: {}) "
-        "to well {} (inc gradient {})",
-        min_dec_grad->first, min_dec_grad->second,
-        max_inc_grad->first, max_inc_grad->second);
-    displayDebugMessage_(msg);
+    if (this->parent.debug) {
+        const std::string msg = fmt::format(
+            "redistributing ALQ from well {} (dec gradient: {}) "
+            "to well {} (inc gradient {})",
+            min_dec_grad->first, min_dec_grad->second,
+            max_inc_grad->first, max_inc_grad->second);
+        displayDebugMessage_(msg);
+    }
     this->parent.addOrRemoveALQincrement_(
         this->parent.dec_grads_, /*well_name=*/min_dec_grad->first, /*add=*/false);
     this->parent.addOrRemoveALQincrement_(
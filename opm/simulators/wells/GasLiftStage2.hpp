@@ -59,6 +59,24 @@ class GasLiftStage2 : public GasLiftCommon {
     static const int Oil = BlackoilPhases::Liquid;
     static const int Gas = BlackoilPhases::Vapour;
 public:
+    // Gradients of the wells from earlier optimizations, kept by the well
+    // model between the calls to runOptimize(). A gradient is reused while
+    // the ALQ of the well is unchanged and its oil and gas rates changed by
+    // less than the relative tolerance. The cache is cleared when the
+    // report step changes.
+    struct GradientCache {
+        struct Entry {
+            double oil_rate;
+            double gas_rate;
+            double alq;
+            std::optional<GradInfo> grad;
+        };
+        double tolerance = 0.0; // 0 disables the reuse
+        int report_step = -1;
+        std::map<std::string, Entry> inc_grads;
+        std::map<std::string, Entry> dec_grads;
+    };
+
     GasLiftStage2(
         const int report_step_idx,
         const Parallel::Communication& comm,
@@ -69,15 +87,21 @@ public:
         GLiftProdWells& prod_wells,
         GLiftOptWells& glift_wells,
         GLiftWellStateMap& state_map,
+        GradientCache& grad_cache,
+        bool threaded,
         bool glift_debug
     );
     void runOptimize();
 protected:
     void addOrRemoveALQincrement_(
         GradMap& grad_map, const std::string& well_name, bool add);
+    void cacheGrad_(const std::string& well_name, bool increase,
+        const std::optional<GradInfo>& grad);
     std::optional<GradInfo> calcIncOrDecGrad_(
         const std::string name, const GasLiftSingleWell& gs_well, bool increase);
-    bool checkRateAlreadyLimited_(GasLiftWellState& state, bool increase);
+    bool checkCachedGradValid_(const GradientCache::Entry& entry,
+        double oil_rate, double gas_rate, double alq) const;
+    bool checkRateAlreadyLimited_(const GasLiftWellState& state, bool increase) const;
     GradInfo deleteDecGradItem_(const std::string& name);
     GradInfo deleteIncGradItem_(const std::string& name);
     GradInfo deleteGrad_(const std::string& name, bool increase);
@@ -86,6 +110,8 @@ protected:
     void displayDebugMessage_(const std::string& msg, const std::string& group_name);
     void displayWarning_(const std::string& msg, const std::string& group_name);
     void displayWarning_(const std::string& msg);
+    std::pair<std::optional<GradInfo>, bool> evalIncOrDecGrad_(
+        const std::string& well_name, const GasLiftSingleWell& gs_well, bool increase) const;
     std::tuple<double, double, double> getCurrentGroupRates_(
         const Group& group);
     std::array<double,3> getCurrentGroupRatesRecursive_(
@@ -116,6 +142,8 @@ protected:
         const std::string& name, GradInfo& grad, bool increase);
     void updateGradVector_(
         const std::string& name, std::vector<GradPair>& grads, double grad);
+    void mpiSyncChangedGrads_(const std::vector<std::string>& well_names,
+        std::vector<GradPair>& inc_grads, std::vector<GradPair>& dec_grads);
     void mpiSyncGlobalGradVector_(std::vector<GradPair>& grads_global) const;
     void mpiSyncLocalToGlobalGradVector_(
         const std::vector<GradPair>& grads_local,
@@ -125,12 +153,14 @@ protected:
     GLiftProdWells& prod_wells_;
     GLiftOptWells& stage1_wells_;
     GLiftWellStateMap& well_state_map_;
+    GradientCache& grad_cache_;
 
     int report_step_idx_;
     const SummaryState& summary_state_;
     const Schedule& schedule_;
     const GasLiftOpt& glo_;
     const Parallel::Communication& comm_;
+    bool threaded_; // evaluate the gradients of the wells concurrently
     GradMap inc_grads_;
     GradMap dec_grads_;
     int max_iterations_ = 1000;
@@ -152,6 +182,8 @@ protected:
         using GradMap = typename GasLiftStage2::GradMap;
         void calculateEcoGradients(std::vector<GasLiftSingleWell *>& wells,
             std::vector<GradPair>& inc_grads, std::vector<GradPair>& dec_grads);
+        void calculateEcoGradientsThreaded(std::vector<GasLiftSingleWell *>& wells,
+            std::vector<GradPair>& inc_grads, std::vector<GradPair>& dec_grads);
         bool checkAtLeastTwoWells(std::vector<GasLiftSingleWell *>& wells);
         void debugShowIterationInfo();
         std::pair<std::optional<GradPairItr>,std::optional<GradPairItr>>
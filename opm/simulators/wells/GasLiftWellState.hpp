@@ -46,7 +46,7 @@ namespace Opm
         bool alqIsLimited() const { return alq_is_limited_; }
         bool gasIsLimited() const { return gas_is_limited_; }
         double gasRate() const { return gas_rate_; }
-        std::pair<double, double> getRates() { return {oil_rate_, gas_rate_}; }
+        std::pair<double, double> getRates() const { return {oil_rate_, gas_rate_}; }
         std::optional<bool> increase() const { return increase_; }
         bool oilIsLimited() const { return oil_is_limited_; }
         double oilRate() const { return oil_rate_; }
@@ -20,6 +20,7 @@
 #ifndef OPM_GLOBAL_WELL_INFO_HEADER_INCLUDED
 #define OPM_GLOBAL_WELL_INFO_HEADER_INCLUDED
 
+#include <algorithm>
 #include <cstddef>
 #include <map>
 #include <string>
@@ -59,9 +60,14 @@ public:
     */
     template <typename Comm>
     void communicate(const Comm& comm) {
+        // Both vectors are summed with a single call.
         auto size = this->m_in_injecting_group.size();
-        comm.sum( this->m_in_injecting_group.data(), size);
-        comm.sum( this->m_in_producing_group.data(), size);
+        std::vector<int> in_group(2 * size);
+        std::copy(this->m_in_injecting_group.begin(), this->m_in_injecting_group.end(), in_group.begin());
+        std::copy(this->m_in_producing_group.begin(), this->m_in_producing_group.end(), in_group.begin() + size);
+        comm.sum( in_group.data(), in_group.size());
+        std::copy(in_group.begin(), in_group.begin() + size, this->m_in_injecting_group.begin());
+        std::copy(in_group.begin() + size, in_group.end(), this->m_in_producing_group.begin());
     }
 
 
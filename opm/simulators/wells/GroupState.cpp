@@ -17,6 +17,8 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <initializer_list>
 #include <iterator>
 
 #include <opm/json/JsonObject.hpp>
@@ -243,6 +245,56 @@ Group::InjectionCMode GroupState::injection_control(const std::string& gname, Ph
 
 //-------------------------------------------------------------------------
 
+// Note that injection_group_vrep_rates is handled separately from the
+// other rates, since it contains single doubles, not vectors.
+
+std::size_t GroupState::data_size() const {
+    std::size_t sz = this->inj_vrep_rate.size();
+    for (const auto* group_rates : {&this->m_production_rates, &this->prod_red_rates, &this->inj_red_rates,
+                                    &this->inj_resv_rates, &this->inj_rein_rates, &this->inj_surface_rates}) {
+        for (const auto& [_, rates] : *group_rates) {
+            (void)_;
+            sz += rates.size();
+        }
+    }
+    return sz;
+}
+
+std::size_t GroupState::collect(double * data) const {
+    std::size_t pos = 0;
+    for (const auto* group_rates : {&this->m_production_rates, &this->prod_red_rates, &this->inj_red_rates,
+                                    &this->inj_resv_rates, &this->inj_rein_rates, &this->inj_surface_rates}) {
+        for (const auto& [_, rates] : *group_rates) {
+            (void)_;
+            pos = std::copy(rates.begin(), rates.end(), data + pos) - data;
+        }
+    }
+    for (const auto& [_, rate] : this->inj_vrep_rate) {
+        (void)_;
+        data[pos++] = rate;
+    }
+    return pos;
+}
+
+std::size_t GroupState::distribute(const double * data) {
+    std::size_t pos = 0;
+    for (auto* group_rates : {&this->m_production_rates, &this->prod_red_rates, &this->inj_red_rates,
+                              &this->inj_resv_rates, &this->inj_rein_rates, &this->inj_surface_rates}) {
+        for (auto& [_, rates] : *group_rates) {
+            (void)_;
+            std::copy(data + pos, data + pos + rates.size(), rates.begin());
+            pos += rates.size();
+        }
+    }
+    for (auto& [_, rate] : this->inj_vrep_rate) {
+        (void)_;
+        rate = data[pos++];
+    }
+    return pos;
+}
+
+//-------------------------------------------------------------------------
+
 GPMaint::State& GroupState::gpmaint(const std::string& gname) {
     if (!this->gpmaint_state.has(gname))
         this->gpmaint_state.add(gname, GPMaint::State{});
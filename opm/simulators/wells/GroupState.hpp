@@ -21,6 +21,7 @@
 #define OPM_GROUPSTATE_HEADER_INCLUDED
 
 #include <map>
+#include <stdexcept>
 #include <vector>
 
 #include <opm/core/props/BlackoilPhases.hpp>
@@ -79,8 +80,11 @@ public:
     void injection_control(const std::string& gname, Phase phase, Group::InjectionCMode cmode);
     Group::InjectionCMode injection_control(const std::string& gname, Phase phase) const;
 
+    /// Number of values in the rates exchanged between the processes.
     std::size_t data_size() const;
+    /// Copy the exchanged rates to data, returns the number of values.
     std::size_t collect(double * data) const;
+    /// Set the exchanged rates from data, returns the number of values.
     std::size_t distribute(const double * data);
 
     GPMaint::State& gpmaint(const std::string& gname);
@@ -89,73 +93,15 @@ public:
     template<class Comm>
     void communicate_rates(const Comm& comm)
     {
-        // Note that injection_group_vrep_rates is handled separate from
-        // the forAllGroupData() function, since it contains single doubles,
-        // not vectors.
-
-        // Create a function that calls some function
-        // for all the individual data items to simplify
-        // the further code.
-        auto iterateContainer = [](auto& container, auto& func) {
-            for (auto& x : container) {
-                func(x.second);
-            }
-        };
-
-
-        auto forAllGroupData = [&](auto& func) {
-            iterateContainer(m_production_rates, func);
-            iterateContainer(prod_red_rates, func);
-            iterateContainer(inj_red_rates, func);
-            iterateContainer(inj_resv_rates, func);
-            iterateContainer(inj_rein_rates, func);
-            iterateContainer(inj_surface_rates, func);
-        };
-
-        // Compute the size of the data.
-        std::size_t sz = 0;
-        auto computeSize = [&sz](const auto& v) {
-            sz += v.size();
-        };
-        forAllGroupData(computeSize);
-        sz += this->inj_vrep_rate.size();
-
-        // Make a vector and collect all data into it.
-        std::vector<double> data(sz);
-        std::size_t pos = 0;
-
-
-
-        // That the collect function mutates the vector v is an artifact for
-        // testing.
-        auto collect = [&data, &pos](auto& v) {
-            for (auto& x : v) {
-                data[pos++] = x;
-                x = -1;
-            }
-        };
-        forAllGroupData(collect);
-        for (const auto& x : this->inj_vrep_rate) {
-            data[pos++] = x.second;
-        }
-        if (pos != sz)
+        // Collect all data into a vector and communicate it
+        // with a single sum() call.
+        std::vector<double> data(this->data_size());
+        if (this->collect(data.data()) != data.size())
             throw std::logic_error("Internal size mismatch when collecting groupData");
 
-        // Communicate it with a single sum() call.
         comm.sum(data.data(), data.size());
 
-        // Distribute the summed vector to the data items.
-        pos = 0;
-        auto distribute = [&data, &pos](auto& v) {
-            for (auto& x : v) {
-                x = data[pos++];
-            }
-        };
-        forAllGroupData(distribute);
-        for (auto& x : this->inj_vrep_rate) {
-            x.second = data[pos++];
-        }
-        if (pos != sz)
+        if (this->distribute(data.data()) != data.size())
             throw std::logic_error("Internal size mismatch when distributing groupData");
     }
 
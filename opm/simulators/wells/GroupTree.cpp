@@ -0,0 +1,70 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/wells/GroupTree.hpp>
+
+#include <opm/input/eclipse/Schedule/Group/Group.hpp>
+#include <opm/input/eclipse/Schedule/Schedule.hpp>
+
+#include <utility>
+
+namespace Opm {
+
+GroupTree::GroupTree(const Schedule& schedule, int report_step)
+    : report_step_(report_step)
+{
+    this->add(schedule, schedule.getGroup("FIELD", report_step));
+}
+
+void GroupTree::add(const Schedule& schedule, const Group& group)
+{
+    // the subgroups are added first, so a group comes after its subgroups
+    std::vector<std::size_t> children;
+    for (const std::string& child_name : group.groups()) {
+        this->add(schedule, schedule.getGroup(child_name, this->report_step_));
+        children.push_back(this->groups_.size() - 1);
+    }
+
+    const std::size_t index = this->groups_.size();
+    for (const auto child : children)
+        this->parents_[child] = index;
+
+    // the parent index is set when the parent is added
+    this->groups_.push_back(&group);
+    this->parents_.push_back(-1);
+    this->children_.push_back(std::move(children));
+    this->index_map_.emplace(group.name(), index);
+}
+
+const std::string& GroupTree::name(std::size_t index) const
+{
+    return this->groups_[index]->name();
+}
+
+std::optional<std::size_t> GroupTree::index(const std::string& name) const
+{
+    auto iter = this->index_map_.find(name);
+    if (iter == this->index_map_.end())
+        return std::nullopt;
+
+    return iter->second;
+}
+
+}
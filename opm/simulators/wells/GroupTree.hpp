@@ -0,0 +1,98 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GROUP_TREE_HEADER_INCLUDED
+#define OPM_GROUP_TREE_HEADER_INCLUDED
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Opm {
+
+class Group;
+class Schedule;
+
+/*
+  The GroupTree class is the group hierarchy of one report step, flattened
+  into arrays. Every group below FIELD gets an index, and the groups are
+  stored in the order of a depth first traversal where every group comes
+  after all its subgroups. The functions in WellGroupHelpers which accumulate
+  quantities from the wells up to FIELD can then do one sweep over the groups
+  instead of recursing through the Schedule by name.
+
+  The tree holds references to the groups of the Schedule, so it must be
+  rebuilt when the Schedule is updated, e.g. by ACTIONX.
+*/
+
+class GroupTree {
+public:
+    GroupTree() = default;
+    GroupTree(const Schedule& schedule, int report_step);
+
+    bool empty() const {
+        return this->groups_.empty();
+    }
+
+    std::size_t size() const {
+        return this->groups_.size();
+    }
+
+    int reportStep() const {
+        return this->report_step_;
+    }
+
+    /// The top group FIELD, which is the last group of the tree
+    std::size_t root() const {
+        return this->groups_.size() - 1;
+    }
+
+    const Group& group(std::size_t index) const {
+        return *this->groups_[index];
+    }
+
+    const std::string& name(std::size_t index) const;
+
+    /// The index of the parent group, or -1 for FIELD
+    int parent(std::size_t index) const {
+        return this->parents_[index];
+    }
+
+    /// The subgroups of a group, in the order of Group::groups()
+    const std::vector<std::size_t>& children(std::size_t index) const {
+        return this->children_[index];
+    }
+
+    std::optional<std::size_t> index(const std::string& name) const;
+
+private:
+    void add(const Schedule& schedule, const Group& group);
+
+    int report_step_{-1};
+    std::vector<const Group*> groups_;
+    std::vector<int> parents_;
+    std::vector<std::vector<std::size_t>> children_;
+    std::unordered_map<std::string, std::size_t> index_map_;
+};
+
+}
+
+#endif
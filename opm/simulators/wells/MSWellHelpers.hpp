@@ -44,9 +44,12 @@ namespace mswellhelpers
 {
 
     /// Applies umfpack and checks for singularity
+    /// The singularity is not logged if logIssue is false, as OpmLog must not be
+    /// used by several threads.
     template <typename MatrixType, typename VectorType>
     VectorType
-    applyUMFPack(const MatrixType& D, std::shared_ptr<Dune::UMFPack<MatrixType> >& linsolver, VectorType x)
+    applyUMFPack(const MatrixType& D, std::shared_ptr<Dune::UMFPack<MatrixType> >& linsolver, VectorType x,
+                 const bool logIssue = true)
     {
 #if HAVE_UMFPACK
         if (!linsolver)
@@ -70,13 +73,16 @@ namespace mswellhelpers
             for (size_t i_elem = 0; i_elem < y[i_block].size(); ++i_elem) {
                 if (std::isinf(y[i_block][i_elem]) || std::isnan(y[i_block][i_elem]) ) {
                     const std::string msg{"nan or inf value found after UMFPack solve due to singular matrix"};
-                    OpmLog::debug(msg);
+                    if (logIssue) {
+                        OpmLog::debug(msg);
+                    }
                     OPM_THROW_NOLOG(NumericalIssue, msg);
                 }
             }
         }
         return y;
 #else
+        static_cast<void>(logIssue);
         // this is not thread safe
         OPM_THROW(std::runtime_error, "Cannot use applyUMFPack() without UMFPACK. "
                   "Reconfigure opm-simulators with SuiteSparse/UMFPACK support and recompile.");
@@ -0,0 +1,210 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MSWELLTREELU_HEADER_INCLUDED
+#define OPM_MSWELLTREELU_HEADER_INCLUDED
+
+#include <dune/common/fmatrix.hh>
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm
+{
+
+/// Block LU decomposition of a matrix whose sparsity pattern is a tree.
+///
+/// The "diagonal" matrix of a multisegment well only couples a segment to its
+/// outlet and its inlets. When the segments are eliminated from the leaves
+/// towards the top segment there is no fill-in, so the decomposition is a
+/// Thomas algorithm generalised to branches. It only needs one inverted pivot
+/// block and two coupling blocks per segment.
+///
+/// The storage is allocated by analyze(), which only depends on the segment
+/// topology. factorize() and solve() do not allocate, and one factorization can
+/// be used for any number of solves until the values of the matrix change.
+template <class MatrixType, class VectorType>
+class MSWellTreeLU
+{
+public:
+    using Block = typename MatrixType::block_type;
+    using VectorBlock = typename VectorType::block_type;
+
+    /// Set up the elimination order for the given topology
+    /// \param[in] parent   the parent (outlet) of every node, -1 for the top node
+    /// \param[in] D        the matrix, only its sparsity pattern is used
+    /// \return             false if the pattern of D does not match the tree,
+    ///                     in that case the matrix cannot be decomposed by this class
+    bool analyze(const std::vector<int>& parent, const MatrixType& D)
+    {
+        const std::size_t n = parent.size();
+        parent_ = parent;
+        factorized_ = false;
+        singular_ = false;
+        tree_ = (D.N() == n && D.M() == n);
+
+        // every entry must be on the diagonal or couple a node and its parent
+        for (std::size_t i = 0; tree_ && i < n; ++i) {
+            for (auto col = D[i].begin(); col != D[i].end(); ++col) {
+                const int j = col.index();
+                if (j != static_cast<int>(i) && parent_[i] != j && parent_[j] != static_cast<int>(i)) {
+                    tree_ = false;
+                    break;
+                }
+            }
+        }
+        if (!tree_) {
+            return false;
+        }
+
+        // eliminate a node after all its children, starting from the leaves
+        std::vector<int> numChildren(n, 0);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (parent_[i] >= 0) {
+                ++numChildren[parent_[i]];
+            }
+        }
+        order_.clear();
+        order_.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (numChildren[i] == 0) {
+                order_.push_back(static_cast<int>(i));
+            }
+        }
+        for (std::size_t k = 0; k < order_.size(); ++k) {
+            const int p = parent_[order_[k]];
+            if (p >= 0 && --numChildren[p] == 0) {
+                order_.push_back(p);
+            }
+        }
+        // a cycle in the topology leaves nodes that are never eliminated
+        tree_ = (order_.size() == n);
+
+        invPivots_.resize(n);
+        lower_.resize(n);
+        upper_.resize(n);
+        return tree_;
+    }
+
+    /// Compute the decomposition of D, D must have the pattern passed to analyze()
+    /// \return   false if a pivot block is singular
+    bool factorize(const MatrixType& D)
+    {
+        factorized_ = false;
+        singular_ = false;
+        if (!tree_) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < parent_.size(); ++i) {
+            invPivots_[i] = entry(D, i, i);
+        }
+        try {
+            for (const int i : order_) {
+                // all children of i are eliminated, so the pivot of i is final
+                invPivots_[i].invert();
+                const int p = parent_[i];
+                if (p >= 0) {
+                    // L_i = D_pi * P_i^-1, U_i = D_ip, P_p -= L_i * U_i
+                    upper_[i] = entry(D, i, p);
+                    lower_[i] = entry(D, p, i);
+                    lower_[i].rightmultiply(invPivots_[i]);
+                    Block update = lower_[i];
+                    update.rightmultiply(upper_[i]);
+                    invPivots_[p] -= update;
+                }
+            }
+        } catch (const Dune::FMatrixError&) {
+            singular_ = true;
+            return false;
+        }
+        factorized_ = true;
+        return true;
+    }
+
+    /// x = D^-1 x with the decomposition computed by factorize()
+    void solve(VectorType& x) const
+    {
+        // forward substitution, from the leaves towards the top node
+        for (const int i : order_) {
+            const int p = parent_[i];
+            if (p >= 0) {
+                lower_[i].mmv(x[i], x[p]);
+            }
+        }
+        // backward substitution, from the top node towards the leaves
+        for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+            const int i = *it;
+            const int p = parent_[i];
+            VectorBlock rhs = x[i];
+            if (p >= 0) {
+                upper_[i].mmv(x[p], rhs);
+            }
+            invPivots_[i].mv(rhs, x[i]);
+        }
+    }
+
+    /// Mark the decomposition as outdated, e.g. after the values of the matrix changed
+    void invalidate()
+    {
+        factorized_ = false;
+        singular_ = false;
+    }
+
+    /// Return whether analyze() accepted the pattern of the matrix
+    bool valid() const
+    {
+        return tree_;
+    }
+
+    /// Return whether the decomposition for the current values is available
+    bool factorized() const
+    {
+        return factorized_;
+    }
+
+    /// Return whether the last call to factorize() found a singular pivot block
+    bool singular() const
+    {
+        return singular_;
+    }
+
+private:
+    static Block entry(const MatrixType& D, const int row, const int col)
+    {
+        const auto it = D[row].find(col);
+        if (it == D[row].end()) {
+            return Block(0.0);
+        }
+        return *it;
+    }
+
+    std::vector<int> parent_;
+    std::vector<int> order_;       // elimination order, every node comes after its children
+    std::vector<Block> invPivots_; // inverse of the pivot block of every node
+    std::vector<Block> lower_;     // D_pi * P_i^-1 for every node i with parent p
+    std::vector<Block> upper_;     // D_ip for every node i with parent p
+    bool tree_ = false;
+    bool factorized_ = false;
+    bool singular_ = false;
+};
+
+} // namespace Opm
+
+#endif // OPM_MSWELLTREELU_HEADER_INCLUDED
@@ -108,6 +108,12 @@ namespace Opm
 
         /// Ax = Ax - C D^-1 B x
         virtual void apply(const BVector& x, BVector& Ax) const override;
+        /// invDBx = D^-1 B x, the part of apply(x, Ax) which only touches this well.
+        /// Returns false if the well does not contribute to apply(x, Ax).
+        /// With logIssue false a singular D is not logged, for calls from threads.
+        bool applyInvDB(const BVector& x, BVectorWell& invDBx, const bool logIssue = true) const;
+        /// Ax = Ax - C^T invDBx, the part of apply(x, Ax) which writes to the reservoir cells
+        void applyCTranspose(const BVectorWell& invDBx, BVector& Ax) const;
         /// r = r - C D^-1 Rw
         virtual void apply(BVector& r) const override;
 
@@ -172,6 +178,12 @@ namespace Opm
 
         mutable int debug_cost_counter_ = 0;
 
+        // Work vectors of the perforation rates, which keep their storage
+        // between the Newton iterations. A well is only assembled by one
+        // thread at a time.
+        mutable std::vector<EvalWell> b_perfcells_scratch_;
+        mutable std::vector<EvalWell> cmix_s_scratch_;
+
         // updating the well_state based on well solution dwells
         void updateWellState(const BVectorWell& dwells,
                              WellState& well_state,
@@ -35,6 +35,8 @@
 #include <opm/simulators/wells/WellState.hpp>
 
 #include <cassert>
+#include <cmath>
+#include <string>
 
 namespace Opm
 {
@@ -86,10 +88,8 @@ initMatrixAndVectors(const int num_cells) const
         // the number of the row corrspnds to the segment now
         const int seg = row.index();
         // adding the item related to outlet relation
-        const Segment& segment = this->segmentSet()[seg];
-        const int outlet_segment_number = segment.outletSegment();
-        if (outlet_segment_number > 0) { // if there is a outlet_segment
-            const int outlet_segment_index = this->segmentNumberToIndex(outlet_segment_number);
+        const int outlet_segment_index = this->segment_outlets_[seg];
+        if (outlet_segment_index >= 0) { // if there is a outlet_segment
             row.insert(outlet_segment_index);
         }
 
@@ -120,12 +120,71 @@ initMatrixAndVectors(const int num_cells) const
         }
     }
 
+    // the segments form a tree, which allows to factorize duneD_ without fill-in
+    duneDTreeLU_.analyze(this->segment_outlets_, duneD_);
+
     resWell_.resize(this->numberOfSegments());
 
     primary_variables_.resize(this->numberOfSegments());
     primary_variables_evaluation_.resize(this->numberOfSegments());
 }
 
+template<typename FluidSystem, typename Indices, typename Scalar>
+void
+MultisegmentWellEval<FluidSystem,Indices,Scalar>::
+applyInvD(BVectorWell& x, const bool logIssue) const
+{
+    if (duneDTreeLU_.valid() && !duneDTreeLU_.factorized() && !duneDTreeLU_.singular()) {
+        duneDTreeLU_.factorize(duneD_);
+    }
+    if (!duneDTreeLU_.factorized()) {
+        // singular pivot block, UMFPack pivots over the whole matrix
+        x = mswellhelpers::applyUMFPack(duneD_, duneDSolver_, x, logIssue);
+        return;
+    }
+
+    duneDTreeLU_.solve(x);
+
+    // same check as in applyUMFPack, a nearly singular duneD_ gives inf or nan
+    for (std::size_t i_block = 0; i_block < x.size(); ++i_block) {
+        for (std::size_t i_elem = 0; i_elem < x[i_block].size(); ++i_elem) {
+            if (std::isinf(x[i_block][i_elem]) || std::isnan(x[i_block][i_elem])) {
+                const std::string msg{"nan or inf value found after block tree LU solve due to singular matrix"};
+                if (logIssue) {
+                    OpmLog::debug(msg);
+                }
+                OPM_THROW_NOLOG(NumericalIssue, msg);
+            }
+        }
+    }
+}
+
+template<typename FluidSystem, typename Indices, typename Scalar>
+Dune::Matrix<typename MultisegmentWellEval<FluidSystem,Indices,Scalar>::DiagMatrixBlockWellType>
+MultisegmentWellEval<FluidSystem,Indices,Scalar>::
+invertD() const
+{
+    const int sz = duneD_.M();
+    Dune::Matrix<DiagMatrixBlockWellType> inv(sz, sz);
+
+    // create the inverse by solving for the basis vectors
+    for (int ii = 0; ii < sz; ++ii) {
+        for (int jj = 0; jj < numWellEq; ++jj) {
+            BVectorWell col(sz);
+            col = 0.0;
+            col[ii][jj] = 1.0;
+            applyInvD(col);
+            for (int cc = 0; cc < sz; ++cc) {
+                for (int dd = 0; dd < numWellEq; ++dd) {
+                    inv[cc][ii][dd][jj] = col[cc][dd];
+                }
+            }
+        }
+    }
+
+    return inv;
+}
+
 template<typename FluidSystem, typename Indices, typename Scalar>
 void
 MultisegmentWellEval<FluidSystem,Indices,Scalar>::
@@ -516,7 +575,8 @@ recoverSolutionWell(const BVector& x, BVectorWell& xw) const
     // resWell = resWell - B * x
     duneB_.mmv(x, resWell);
     // xw = D^-1 * resWell
-    xw = mswellhelpers::applyUMFPack(duneD_, duneDSolver_, resWell);
+    xw = resWell;
+    applyInvD(xw);
 }
 
 template<typename FluidSystem, typename Indices, typename Scalar>
@@ -868,12 +928,11 @@ getFrictionPressureLoss(const int seg) const
         density.clearDerivatives();
         visc.clearDerivatives();
     }
-    const int outlet_segment_index = this->segmentNumberToIndex(this->segmentSet()[seg].outletSegment());
-    const double length = this->segmentSet()[seg].totalLength() - this->segmentSet()[outlet_segment_index].totalLength();
+    const double length = this->segment_lengths_[seg];
     assert(length > 0.);
-    const double roughness = this->segmentSet()[seg].roughness();
-    const double area = this->segmentSet()[seg].crossArea();
-    const double diameter = this->segmentSet()[seg].internalDiameter();
+    const double roughness = this->segment_roughnesses_[seg];
+    const double area = this->segment_cross_areas_[seg];
+    const double diameter = this->segment_diameters_[seg];
 
     const double sign = mass_rate < 0. ? 1.0 : - 1.0;
 
@@ -1363,7 +1422,7 @@ MultisegmentWellEval<FluidSystem,Indices,Scalar>::
 handleAccelerationPressureLoss(const int seg,
                                WellState& well_state) const
 {
-    const double area = this->segmentSet()[seg].crossArea();
+    const double area = this->segment_cross_areas_[seg];
     const EvalWell mass_rate = segment_mass_rates_[seg];
     const int seg_upwind = upwinding_segments_[seg];
     EvalWell density = segment_densities_[seg_upwind];
@@ -1378,7 +1437,7 @@ handleAccelerationPressureLoss(const int seg,
     // handling the velocity head of intlet segments
     for (const int inlet : this->segment_inlets_[seg]) {
         const int seg_upwind_inlet = upwinding_segments_[inlet];
-        const double inlet_area = this->segmentSet()[inlet].crossArea();
+        const double inlet_area = this->segment_cross_areas_[inlet];
         EvalWell inlet_density = this->segment_densities_[seg_upwind_inlet];
         // WARNING
         // We disregard the derivatives from the upwind density to make sure derivatives
@@ -1448,7 +1507,7 @@ assembleDefaultPressureEq(const int seg,
     }
 
     // contribution from the outlet segment
-    const int outlet_segment_index = this->segmentNumberToIndex(this->segmentSet()[seg].outletSegment());
+    const int outlet_segment_index = this->segment_outlets_[seg];
     const EvalWell outlet_pressure = getSegmentPressure(outlet_segment_index);
 
     resWell_[seg][SPres] -= outlet_pressure.value();
@@ -1577,7 +1636,7 @@ assembleICDPressureEq(const int seg,
     }
 
     // contribution from the outlet segment
-    const int outlet_segment_index = this->segmentNumberToIndex(this->segmentSet()[seg].outletSegment());
+    const int outlet_segment_index = this->segment_outlets_[seg];
     const EvalWell outlet_pressure = getSegmentPressure(outlet_segment_index);
 
     resWell_[seg][SPres] -= outlet_pressure.value();
@@ -1772,7 +1831,7 @@ updateUpwindingSegments()
         if (primary_variables_evaluation_[seg][GTotal] <= 0.) {
             upwinding_segments_[seg] = seg;
         } else {
-            const int outlet_segment_index = this->segmentNumberToIndex(this->segmentSet()[seg].outletSegment());
+            const int outlet_segment_index = this->segment_outlets_[seg];
             upwinding_segments_[seg] = outlet_segment_index;
         }
     }
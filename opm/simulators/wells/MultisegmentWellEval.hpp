@@ -23,6 +23,7 @@
 #define OPM_MULTISEGMENTWELL_EVAL_HEADER_INCLUDED
 
 #include <opm/simulators/wells/MultisegmentWellGeneric.hpp>
+#include <opm/simulators/wells/MSWellTreeLU.hpp>
 
 #include <opm/material/densead/Evaluation.hpp>
 
@@ -32,6 +33,7 @@
 #include <dune/common/fvector.hh>
 #include <dune/istl/bcrsmatrix.hh>
 #include <dune/istl/bvector.hh>
+#include <dune/istl/matrix.hh>
 #include <dune/istl/umfpack.hh>
 
 #include <array>
@@ -118,6 +120,13 @@ protected:
     void initMatrixAndVectors(const int num_cells) const;
     void initPrimaryVariablesEvaluation() const;
 
+    // x = duneD_^-1 * x, with the block tree LU of duneD_ or with UMFPack if it cannot be used.
+    // A singular duneD_ is only logged if logIssue is true, OpmLog is not thread safe.
+    void applyInvD(BVectorWell& x, const bool logIssue = true) const;
+
+    // the full block inverse of duneD_
+    Dune::Matrix<DiagMatrixBlockWellType> invertD() const;
+
     void assembleControlEq(const WellState& well_state,
                            const GroupState& group_state,
                            const Schedule& schedule,
@@ -263,6 +272,12 @@ protected:
     /// This is a shared_ptr as MultisegmentWell is copied in computeWellPotentials...
     mutable std::shared_ptr<Dune::UMFPack<DiagMatWell> > duneDSolver_;
 
+    /// \brief block tree LU of duneD_, following the inlet/outlet topology of the segments
+    ///
+    /// The decomposition is computed at the first solve after the assembly and
+    /// reused for all solves with the same duneD_.
+    mutable MSWellTreeLU<DiagMatWell, BVectorWell> duneDTreeLU_;
+
     // residuals of the well equations
     mutable BVectorWell resWell_;
 
@@ -21,8 +21,6 @@
 #include <config.h>
 #include <opm/simulators/wells/MultisegmentWellGeneric.hpp>
 
-#include <opm/common/utility/numeric/RootFinders.hpp>
-
 #include <opm/input/eclipse/Schedule/VFPInjTable.hpp>
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
@@ -46,6 +44,11 @@ MultisegmentWellGeneric(WellInterfaceGeneric& baseif)
     , segment_perforations_(numberOfSegments())
     , segment_inlets_(numberOfSegments())
     , segment_depth_diffs_(numberOfSegments(), 0.0)
+    , segment_outlets_(numberOfSegments(), -1)
+    , segment_lengths_(numberOfSegments(), 0.0)
+    , segment_cross_areas_(numberOfSegments(), 0.0)
+    , segment_diameters_(numberOfSegments(), 0.0)
+    , segment_roughnesses_(numberOfSegments(), 0.0)
     , perforation_segment_depth_diffs_(baseif_.numPerfs(), 0.0)
 {
     // since we decide to use the WellSegments from the well parser. we can reuse a lot from it.
@@ -72,7 +75,7 @@ MultisegmentWellGeneric(WellInterfaceGeneric& baseif)
         }
     }
 
-    // initialize the segment_inlets_
+    // initialize the segment_outlets_ and the segment_inlets_
     for (int seg = 0; seg < numberOfSegments(); ++seg) {
         const Segment& segment = segmentSet()[seg];
         const int segment_number = segment.segmentNumber();
@@ -80,6 +83,7 @@ MultisegmentWellGeneric(WellInterfaceGeneric& baseif)
         if (outlet_segment_number > 0) {
             const int segment_index = segmentNumberToIndex(segment_number);
             const int outlet_segment_index = segmentNumberToIndex(outlet_segment_number);
+            segment_outlets_[segment_index] = outlet_segment_index;
             segment_inlets_[outlet_segment_index].push_back(segment_index);
         }
     }
@@ -88,10 +92,17 @@ MultisegmentWellGeneric(WellInterfaceGeneric& baseif)
     // for the top segment, we will make its zero unless we find other purpose to use this value
     for (int seg = 1; seg < numberOfSegments(); ++seg) {
         const double segment_depth = segmentSet()[seg].depth();
-        const int outlet_segment_number = segmentSet()[seg].outletSegment();
-        const Segment& outlet_segment = segmentSet()[segmentNumberToIndex(outlet_segment_number)];
+        const Segment& outlet_segment = segmentSet()[segment_outlets_[seg]];
         const double outlet_depth = outlet_segment.depth();
         segment_depth_diffs_[seg] = segment_depth - outlet_depth;
+        segment_lengths_[seg] = segmentSet()[seg].totalLength() - outlet_segment.totalLength();
+    }
+
+    for (int seg = 0; seg < numberOfSegments(); ++seg) {
+        const Segment& segment = segmentSet()[seg];
+        segment_cross_areas_[seg] = segment.crossArea();
+        segment_diameters_[seg] = segment.internalDiameter();
+        segment_roughnesses_[seg] = segment.roughness();
     }
 }
 
@@ -325,6 +336,13 @@ computeBhpAtThpLimitInj(const std::function<std::vector<double>(const double)>&
     }
 
     // Find bhp values for inflow relation corresponding to flo samples.
+    // All samples are solved in the same bracket, so the inflow at its
+    // end points is only evaluated once.
+    // TODO: replace hardcoded low/high limits.
+    const double sample_low = 10.0 * unit::barsa;
+    const double sample_high = 800.0 * unit::barsa;
+    const double flo_low = flo(frates(sample_low));
+    const double flo_high = flo(frates(sample_high));
     std::vector<double> bhp_samples;
     for (double flo_sample : flo_samples) {
         if (flo_sample > flo_bhp_limit) {
@@ -339,20 +357,17 @@ computeBhpAtThpLimitInj(const std::function<std::vector<double>(const double)>&
         auto eq = [&flo, &frates, flo_sample](double bhp) {
             return flo(frates(bhp)) - flo_sample;
         };
-        // TODO: replace hardcoded low/high limits.
-        const double low = 10.0 * unit::barsa;
-        const double high = 800.0 * unit::barsa;
         const int max_iteration = 100;
         const double flo_tolerance = 0.05 * std::fabs(flo_samples.back());
-        int iteration = 0;
-        try {
-            const double solved_bhp = RegulaFalsiBisection<WarnAndContinueOnError>::
-                    solve(eq, low, high, max_iteration, flo_tolerance, iteration);
-            bhp_samples.push_back(solved_bhp);
+        const auto solved_bhp = wellhelpers::bracketedNewton(eq, sample_low, sample_high,
+                                                             flo_low - flo_sample, flo_high - flo_sample,
+                                                             std::nullopt, flo_tolerance, max_iteration);
+        if (solved_bhp.has_value()) {
+            bhp_samples.push_back(*solved_bhp);
         }
-        catch (...) {
+        else {
             // Use previous value (or max value if at start) if we failed.
-            bhp_samples.push_back(bhp_samples.empty() ? low : bhp_samples.back());
+            bhp_samples.push_back(bhp_samples.empty() ? sample_low : bhp_samples.back());
             deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE_EXTRACT_SAMPLES",
                                     "Robust bhp(thp) solve failed extracting bhp values at flo samples for well " + baseif_.name());
         }
@@ -408,7 +423,6 @@ computeBhpAtThpLimitInj(const std::function<std::vector<double>(const double)>&
     const double high = bhp_samples[sign_change_index];
     const int max_iteration = 100;
     const double bhp_tolerance = 0.01 * unit::barsa;
-    int iteration = 0;
     if (low == high) {
         // We are in the high flow regime where the bhp_samples
         // are all equal to the bhp_limit.
@@ -417,20 +431,24 @@ computeBhpAtThpLimitInj(const std::function<std::vector<double>(const double)>&
                                 "Robust bhp(thp) solve failed for well " + baseif_.name());
         return std::nullopt;
     }
-    try {
-        const double solved_bhp = RegulaFalsiBisection<WarnAndContinueOnError>::
-                solve(eq, low, high, max_iteration, bhp_tolerance, iteration);
-#ifdef EXTRA_THP_DEBUGGING
-        OpmLog::debug("*****    " + name() + "    solved_bhp = " + std::to_string(solved_bhp)
-                      + "    flo_bhp_limit = " + std::to_string(flo_bhp_limit));
-#endif // EXTRA_THP_DEBUGGING
-        return solved_bhp;
-    }
-    catch (...) {
+    // The residuals at the samples bracketing the solution are known, and the
+    // solution of the previous solve is the initial guess.
+    const double eq_low = fbhp_samples[sign_change_index + 1] - low;
+    const double eq_high = fbhp_samples[sign_change_index] - high;
+    const auto solved_bhp = wellhelpers::bracketedNewton(eq, low, high, eq_low, eq_high,
+                                                         baseif_.bhpAtThpLimitGuess(),
+                                                         bhp_tolerance, max_iteration);
+    if (!solved_bhp.has_value()) {
         deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE",
                                 "Robust bhp(thp) solve failed for well " + baseif_.name());
         return std::nullopt;
     }
+#ifdef EXTRA_THP_DEBUGGING
+    OpmLog::debug("*****    " + name() + "    solved_bhp = " + std::to_string(*solved_bhp)
+                  + "    flo_bhp_limit = " + std::to_string(flo_bhp_limit));
+#endif // EXTRA_THP_DEBUGGING
+    baseif_.bhpAtThpLimitGuess() = solved_bhp;
+    return solved_bhp;
 }
 
 template<typename Scalar>
@@ -474,7 +492,7 @@ computeBhpAtThpLimitProdWithAlq(
                                   const std::vector<double>& rates) {
         assert(rates.size() == 3);
         return baseif_.vfpProperties()->getProd()
-        ->bhp(controls.vfp_table_number, rates[Water], rates[Oil], rates[Gas], thp_limit, alq_value) - dp;
+        ->bhp(controls.vfp_table_number, rates[Water], rates[Oil], rates[Gas], thp_limit, alq_value, baseif_.vfpProdCache()) - dp;
     };
 
     // Make the flo() function.
@@ -524,19 +542,19 @@ computeBhpAtThpLimitProdWithAlq(
     }
 
     // Solve for the proper solution in the given interval.
+    // The solution of the previous solve is the initial guess.
     const int max_iteration = 100;
     const double bhp_tolerance = 0.01 * unit::barsa;
-    int iteration = 0;
-    try {
-        const double solved_bhp = RegulaFalsiBisection<ThrowOnError>::
-            solve(eq, low, high, max_iteration, bhp_tolerance, iteration);
-        return solved_bhp;
-    }
-    catch (...) {
+    const auto solved_bhp = wellhelpers::bracketedNewton(eq, low, high, eq(low), eq(high),
+                                                         baseif_.bhpAtThpLimitGuess(),
+                                                         bhp_tolerance, max_iteration);
+    if (!solved_bhp.has_value()) {
         deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE",
                                 "Robust bhp(thp) solve failed for well " + baseif_.name());
         return std::nullopt;
     }
+    baseif_.bhpAtThpLimitGuess() = solved_bhp;
+    return solved_bhp;
 }
 
 template<typename Scalar>
@@ -554,11 +572,9 @@ bhpMax(const std::function<double(const double)>& fflo,
     double high = maxPerfPress + 1.0 * unit::barsa;
     double f_low = fflo(low);
     double f_high = fflo(high);
-    deferred_logger.debug("computeBhpAtThpLimitProd(): well = " + baseif_.name() +
-                           "  low = " + std::to_string(low) +
-                           "  high = " + std::to_string(high) +
-                           "  f(low) = " + std::to_string(f_low) +
-                           "  f(high) = " + std::to_string(f_high));
+    deferred_logger.debugFormat("computeBhpAtThpLimitProd(): well = {}"
+                                "  low = {:f}  high = {:f}  f(low) = {:f}  f(high) = {:f}",
+                                baseif_.name(), low, high, f_low, f_high);
     int adjustments = 0;
     const int max_adjustments = 10;
     const double adjust_amount = 5.0 * unit::barsa;
@@ -607,12 +623,9 @@ bhpMax(const std::function<double(const double)>& fflo,
             return std::nullopt;
         }
     }
-    deferred_logger.debug("computeBhpAtThpLimitProd(): well = " + baseif_.name() +
-                          "  low = " + std::to_string(low) +
-                          "  high = " + std::to_string(high) +
-                          "  f(low) = " + std::to_string(f_low) +
-                          "  f(high) = " + std::to_string(f_high) +
-                          "  bhp_max = " + std::to_string(bhp_max));
+    deferred_logger.debugFormat("computeBhpAtThpLimitProd(): well = {}"
+                                "  low = {:f}  high = {:f}  f(low) = {:f}  f(high) = {:f}  bhp_max = {:f}",
+                                baseif_.name(), low, high, f_low, f_high, bhp_max);
     return bhp_max;
 }
 
@@ -633,11 +646,9 @@ bisectBracket(const std::function<double(const double)>& eq,
     double eq_high = eq(high);
     double eq_low = eq(low);
     const double eq_bhplimit = eq_low;
-    deferred_logger.debug("computeBhpAtThpLimitProd(): well = " + baseif_.name() +
-                          "  low = " + std::to_string(low) +
-                          "  high = " + std::to_string(high) +
-                          "  eq(low) = " + std::to_string(eq_low) +
-                          "  eq(high) = " + std::to_string(eq_high));
+    deferred_logger.debugFormat("computeBhpAtThpLimitProd(): well = {}"
+                                "  low = {:f}  high = {:f}  eq(low) = {:f}  eq(high) = {:f}",
+                                baseif_.name(), low, high, eq_low, eq_high);
     if (eq_low * eq_high > 0.0) {
         // Failed to bracket the zero.
         // If this is due to having two solutions, bisect until bracketed.
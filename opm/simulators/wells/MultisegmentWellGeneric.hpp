@@ -122,6 +122,17 @@ protected:
 
     std::vector<double> segment_depth_diffs_;
 
+    // the index of the outlet segment of each segment, -1 for the top segment
+    std::vector<int> segment_outlets_;
+
+    // the geometry of the segments used by the pressure drops, the length is
+    // the length between the segment and its outlet segment. The segments
+    // of the parser are looked up by their number, which is a linear search.
+    std::vector<double> segment_lengths_;
+    std::vector<double> segment_cross_areas_;
+    std::vector<double> segment_diameters_;
+    std::vector<double> segment_roughnesses_;
+
     // depth difference between the segment and the perforation
     // or in another way, the depth difference between the perforation and
     // the segment the perforation belongs to
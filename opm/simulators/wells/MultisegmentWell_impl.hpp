@@ -24,6 +24,7 @@
 #include <opm/input/eclipse/Schedule/MSW/Valve.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <optional>
 #include <string>
 #include <algorithm>
 
@@ -183,22 +184,48 @@ namespace Opm
     MultisegmentWell<TypeTag>::
     apply(const BVector& x, BVector& Ax) const
     {
-        if (!this->isOperableAndSolvable() && !this->wellIsStopped()) return;
+        BVectorWell invDBx;
+        if (applyInvDB(x, invDBx)) {
+            applyCTranspose(invDBx, Ax);
+        }
+    }
+
+
+
+
+
+    template <typename TypeTag>
+    bool
+    MultisegmentWell<TypeTag>::
+    applyInvDB(const BVector& x, BVectorWell& invDBx, const bool logIssue) const
+    {
+        if (!this->isOperableAndSolvable() && !this->wellIsStopped()) return false;
 
         if ( this->param_.matrix_add_well_contributions_ )
         {
             // Contributions are already in the matrix itself
-            return;
+            return false;
         }
-        BVectorWell Bx(this->duneB_.N());
 
-        this->duneB_.mv(x, Bx);
+        invDBx.resize(this->duneB_.N());
+        this->duneB_.mv(x, invDBx);
+
+        // invDBx = duneD^-1 * Bx_, computed in place
+        this->applyInvD(invDBx, logIssue);
+        return true;
+    }
+
+
+
 
-        // invDBx = duneD^-1 * Bx_
-        const BVectorWell invDBx = mswellhelpers::applyUMFPack(this->duneD_, this->duneDSolver_, Bx);
 
+    template <typename TypeTag>
+    void
+    MultisegmentWell<TypeTag>::
+    applyCTranspose(const BVectorWell& invDBx, BVector& Ax) const
+    {
         // Ax = Ax - duneC_^T * invDBx
-        this->duneC_.mmtv(invDBx,Ax);
+        this->duneC_.mmtv(invDBx, Ax);
     }
 
 
@@ -213,7 +240,8 @@ namespace Opm
         if (!this->isOperableAndSolvable() && !this->wellIsStopped()) return;
 
         // invDrw_ = duneD^-1 * resWell_
-        const BVectorWell invDrw = mswellhelpers::applyUMFPack(this->duneD_, this->duneDSolver_, this->resWell_);
+        BVectorWell invDrw = this->resWell_;
+        this->applyInvD(invDrw);
         // r = r - duneC_^T * invDrw
         this->duneC_.mmtv(invDrw, r);
     }
@@ -395,9 +423,17 @@ namespace Opm
         MultisegmentWell<TypeTag> well_copy(*this);
         well_copy.debug_cost_counter_ = 0;
 
-        // store a copy of the well state, we don't want to update the real well state
-        WellState well_state_copy = ebosSimulator.problem().wellModel().wellState();
-        const auto& group_state = ebosSimulator.problem().wellModel().groupState();
+        // use a scratch copy of the well state, we don't want to update the real well state.
+        // The scratch state of the well model only copies the wells changed by the previous
+        // well, the whole well state is only copied outside the potential calculations.
+        const auto& well_model = ebosSimulator.problem().wellModel();
+        std::optional<WellState> well_state_storage;
+        WellState* well_state_scratch = well_model.potentialWellState();
+        if (!well_state_scratch) {
+            well_state_scratch = &well_state_storage.emplace(well_model.wellState());
+        }
+        WellState& well_state_copy = *well_state_scratch;
+        const auto& group_state = well_model.groupState();
         auto& ws = well_state_copy.well(this->index_of_well_);
 
         // Get the current controls.
@@ -507,7 +543,8 @@ namespace Opm
 
         // We assemble the well equations, then we check the convergence,
         // which is why we do not put the assembleWellEq here.
-        const BVectorWell dx_well = mswellhelpers::applyUMFPack(this->duneD_, this->duneDSolver_, this->resWell_);
+        BVectorWell dx_well = this->resWell_;
+        this->applyInvD(dx_well);
 
         updateWellState(dx_well, well_state, deferred_logger);
     }
@@ -708,7 +745,7 @@ namespace Opm
     MultisegmentWell<TypeTag>::
     addWellContributions(SparseMatrixAdapter& jacobian) const
     {
-        const auto invDuneD = mswellhelpers::invertWithUMFPack<DiagMatWell, BVectorWell>(this->duneD_, this->duneDSolver_);
+        const auto invDuneD = this->invertD();
 
         // We need to change matrix A as follows
         // A -= C^T D^-1 B
@@ -896,7 +933,8 @@ namespace Opm
         const EvalWell rv = this->extendEval(fs.Rv());
 
         // not using number_of_phases_ because of solvent
-        std::vector<EvalWell> b_perfcells(this->num_components_, 0.0);
+        auto& b_perfcells = this->b_perfcells_scratch_;
+        b_perfcells.assign(this->num_components_, 0.0);
 
         for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
             if (!FluidSystem::phaseIsActive(phaseIdx)) {
@@ -907,7 +945,8 @@ namespace Opm
             b_perfcells[compIdx] = this->extendEval(fs.invB(phaseIdx));
         }
 
-        std::vector<EvalWell> cmix_s(this->numComponents(), 0.0);
+        auto& cmix_s = this->cmix_s_scratch_;
+        cmix_s.resize(this->numComponents());
         for (int comp_idx = 0; comp_idx < this->numComponents(); ++comp_idx) {
             cmix_s[comp_idx] = this->surfaceVolumeFraction(seg, comp_idx);
         }
@@ -1361,8 +1400,6 @@ namespace Opm
         if (!this->isOperableAndSolvable() && !this->wellIsStopped()) return true;
 
         const int max_iter_number = this->param_.max_inner_iter_ms_wells_;
-        const WellState well_state0 = well_state;
-        const std::vector<Scalar> residuals0 = this->getWellResiduals(Base::B_avg_, deferred_logger);
         std::vector<std::vector<Scalar> > residual_history;
         std::vector<double> measure_history;
         int it = 0;
@@ -1376,8 +1413,6 @@ namespace Opm
 
             assembleWellEqWithoutIteration(ebosSimulator, dt, inj_controls, prod_controls, well_state, group_state, deferred_logger);
 
-            const BVectorWell dx_well = mswellhelpers::applyUMFPack(this->duneD_, this->duneDSolver_, this->resWell_);
-
             if (it > this->param_.strict_inner_iter_wells_)
                 relax_convergence = true;
 
@@ -1387,6 +1422,10 @@ namespace Opm
                 break;
             }
 
+            // only factorize the segment system if an update is needed
+            BVectorWell dx_well = this->resWell_;
+            this->applyInvD(dx_well);
+
             residual_history.push_back(this->getWellResiduals(Base::B_avg_, deferred_logger));
             measure_history.push_back(this->getResidualMeasureValue(well_state,
                                                                     residual_history[it],
@@ -1439,28 +1478,30 @@ namespace Opm
         }
 
         // TODO: we should decide whether to keep the updated well_state, or recover to use the old well_state
-        if (converged) {
-            std::ostringstream sstr;
-            sstr << "     Well " << this->name() << " converged in " << it << " inner iterations.";
-            if (relax_convergence)
-                sstr << "      (A relaxed tolerance was used after "<< this->param_.strict_inner_iter_wells_ << " iterations)";
-            deferred_logger.debug(sstr.str());
-        } else {
-            std::ostringstream sstr;
-            sstr << "     Well " << this->name() << " did not converge in " << it << " inner iterations.";
+        if (DeferredLogger::isStored(Log::MessageType::Debug)) {
+            if (converged) {
+                std::ostringstream sstr;
+                sstr << "     Well " << this->name() << " converged in " << it << " inner iterations.";
+                if (relax_convergence)
+                    sstr << "      (A relaxed tolerance was used after "<< this->param_.strict_inner_iter_wells_ << " iterations)";
+                deferred_logger.debug(sstr.str());
+            } else {
+                std::ostringstream sstr;
+                sstr << "     Well " << this->name() << " did not converge in " << it << " inner iterations.";
 #define EXTRA_DEBUG_MSW 0
 #if EXTRA_DEBUG_MSW
-            sstr << "***** Outputting the residual history for well " << this->name() << " during inner iterations:";
-            for (int i = 0; i < it; ++i) {
-                const auto& residual = residual_history[i];
-                sstr << " residual at " << i << "th iteration ";
-                for (const auto& res : residual) {
-                    sstr << " " << res;
+                sstr << "***** Outputting the residual history for well " << this->name() << " during inner iterations:";
+                for (int i = 0; i < it; ++i) {
+                    const auto& residual = residual_history[i];
+                    sstr << " residual at " << i << "th iteration ";
+                    for (const auto& res : residual) {
+                        sstr << " " << res;
+                    }
+                    sstr << " " << measure_history[i] << " \n";
                 }
-                sstr << " " << measure_history[i] << " \n";
-            }
 #endif
-            deferred_logger.debug(sstr.str());
+                deferred_logger.debug(sstr.str());
+            }
         }
 
         return converged;
@@ -1498,6 +1539,7 @@ namespace Opm
         this->resWell_ = 0.0;
 
         this->duneDSolver_.reset();
+        this->duneDTreeLU_.invalidate();
 
         auto& ws = well_state.well(this->index_of_well_);
         ws.dissolved_gas_rate = 0;
@@ -1512,7 +1554,14 @@ namespace Opm
 
         const int nseg = this->numberOfSegments();
 
+        // The sparsity of the matrices is built once in initMatrixAndVectors(), only the values
+        // are assembled here. The blocks are looked up once per segment and perforation, and
+        // the perforation work vectors are allocated once per assembly.
+        std::vector<EvalWell> mob(this->num_components_, 0.0);
+        std::vector<EvalWell> cq_s(this->num_components_, 0.0);
+
         for (int seg = 0; seg < nseg; ++seg) {
+            auto& D_seg = this->duneD_[seg][seg];
             // calculating the accumulation term
             // TODO: without considering the efficiencty factor for now
             {
@@ -1529,7 +1578,7 @@ namespace Opm
 
                     this->resWell_[seg][comp_idx] += accumulation_term.value();
                     for (int pv_idx = 0; pv_idx < numWellEq; ++pv_idx) {
-                        this->duneD_[seg][seg][comp_idx][pv_idx] += accumulation_term.derivative(pv_idx + Indices::numEq);
+                        D_seg[comp_idx][pv_idx] += accumulation_term.derivative(pv_idx + Indices::numEq);
                     }
                 }
             }
@@ -1542,7 +1591,7 @@ namespace Opm
                     // segment_rate contains the derivatives with respect to GTotal in seg,
                     // and WFrac and GFrac in seg_upwind
                     this->resWell_[seg][comp_idx] -= segment_rate.value();
-                    this->duneD_[seg][seg][comp_idx][GTotal] -= segment_rate.derivative(GTotal + Indices::numEq);
+                    D_seg[comp_idx][GTotal] -= segment_rate.derivative(GTotal + Indices::numEq);
                     if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
                         this->duneD_[seg][seg_upwind][comp_idx][WFrac] -= segment_rate.derivative(WFrac + Indices::numEq);
                     }
@@ -1583,11 +1632,11 @@ namespace Opm
             for (const int perf : this->segment_perforations_[seg]) {
                 const int cell_idx = this->well_cells_[perf];
                 const auto& int_quants = *(ebosSimulator.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/ 0));
-                std::vector<EvalWell> mob(this->num_components_, 0.0);
+                std::fill(mob.begin(), mob.end(), 0.0);
                 getMobilityEval(ebosSimulator, perf, mob);
                 const double trans_mult = ebosSimulator.problem().template rockCompTransMultiplier<double>(int_quants, cell_idx);
                 const double Tw = this->well_index_[perf] * trans_mult;
-                std::vector<EvalWell> cq_s(this->num_components_, 0.0);
+                std::fill(cq_s.begin(), cq_s.end(), 0.0);
                 EvalWell perf_press;
                 double perf_dis_gas_rate = 0.;
                 double perf_vap_oil_rate = 0.;
@@ -1605,6 +1654,8 @@ namespace Opm
                 }
                 perf_press_state[perf] = perf_press.value();
 
+                auto& B_perf = this->duneB_[seg][cell_idx];
+                auto& C_perf = this->duneC_[seg][cell_idx];
                 for (int comp_idx = 0; comp_idx < this->num_components_; ++comp_idx) {
                     // the cq_s entering mass balance equations need to consider the efficiency factors.
                     const EvalWell cq_s_effective = cq_s[comp_idx] * this->well_efficiency_factor_;
@@ -1618,15 +1669,15 @@ namespace Opm
                     for (int pv_idx = 0; pv_idx < numWellEq; ++pv_idx) {
 
                         // also need to consider the efficiency factor when manipulating the jacobians.
-                        this->duneC_[seg][cell_idx][pv_idx][comp_idx] -= cq_s_effective.derivative(pv_idx + Indices::numEq); // intput in transformed matrix
+                        C_perf[pv_idx][comp_idx] -= cq_s_effective.derivative(pv_idx + Indices::numEq); // intput in transformed matrix
 
                         // the index name for the D should be eq_idx / pv_idx
-                        this->duneD_[seg][seg][comp_idx][pv_idx] += cq_s_effective.derivative(pv_idx + Indices::numEq);
+                        D_seg[comp_idx][pv_idx] += cq_s_effective.derivative(pv_idx + Indices::numEq);
                     }
 
                     for (int pv_idx = 0; pv_idx < Indices::numEq; ++pv_idx) {
                         // also need to consider the efficiency factor when manipulating the jacobians.
-                        this->duneB_[seg][cell_idx][comp_idx][pv_idx] += cq_s_effective.derivative(pv_idx);
+                        B_perf[comp_idx][pv_idx] += cq_s_effective.derivative(pv_idx);
                     }
                 }
             }
@@ -0,0 +1,165 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/wells/NetworkPressureSolver.hpp>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fmatrix.hh>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace Opm
+{
+
+NetworkPressureSolver::
+NetworkPressureSolver(std::vector<Node> nodes, BranchPressure branch_pressure)
+    : nodes_(std::move(nodes))
+    , branch_pressure_(std::move(branch_pressure))
+{
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        assert(nodes_[i].parent < static_cast<int>(i));
+        assert(nodes_[i].parent >= 0 || nodes_[i].fixed_pressure.has_value());
+    }
+}
+
+NetworkPressureSolver::Rates
+NetworkPressureSolver::
+inflow(const int node, const double pressure) const
+{
+    const auto& n = nodes_[node];
+    Rates rates;
+    for (std::size_t p = 0; p < rates.size(); ++p) {
+        // a producing leaf cannot turn into an injecting one
+        rates[p] = std::max(n.inflow[p] + n.inflow_derivative[p] * (pressure - n.reference_pressure), 0.0);
+    }
+    return rates;
+}
+
+void
+NetworkPressureSolver::
+residual(const std::vector<double>& pressures, std::vector<double>& res) const
+{
+    const int num_nodes = nodes_.size();
+    assert(static_cast<int>(pressures.size()) == num_nodes);
+
+    // Accumulate the leaf inflows towards the roots.
+    std::vector<Rates> rates(num_nodes);
+    for (int i = 0; i < num_nodes; ++i) {
+        rates[i] = inflow(i, pressures[i]);
+    }
+    for (int i = num_nodes - 1; i >= 0; --i) {
+        const int parent = nodes_[i].parent;
+        if (parent >= 0) {
+            for (std::size_t p = 0; p < rates[i].size(); ++p) {
+                rates[parent][p] += rates[i][p];
+            }
+        }
+    }
+
+    res.resize(num_nodes);
+    for (int i = 0; i < num_nodes; ++i) {
+        const auto& n = nodes_[i];
+        if (n.fixed_pressure) {
+            res[i] = pressures[i] - *n.fixed_pressure;
+        } else {
+            res[i] = pressures[i] - branch_pressure_(i, rates[i], pressures[n.parent]);
+        }
+    }
+}
+
+bool
+NetworkPressureSolver::
+solve(std::vector<double>& pressures, const double tolerance, const int max_iterations)
+{
+    const int num_nodes = nodes_.size();
+    iterations_ = 0;
+
+    std::vector<double> x = pressures;
+    std::vector<double> res, res_perturbed, x_trial, res_trial;
+    residual(x, res);
+    double norm = maxNorm(res);
+
+    Dune::DynamicMatrix<double> jacobian(num_nodes, num_nodes);
+    Dune::DynamicVector<double> rhs(num_nodes), dx(num_nodes);
+    while (norm >= tolerance) {
+        if (iterations_ == max_iterations) {
+            return false;
+        }
+        ++iterations_;
+
+        // Finite difference Jacobian, the networks are small enough for a dense matrix.
+        for (int j = 0; j < num_nodes; ++j) {
+            const double h = 1.0e-6 * std::max(std::abs(x[j]), 1.0e5);
+            const double xj = x[j];
+            x[j] += h;
+            residual(x, res_perturbed);
+            x[j] = xj;
+            for (int i = 0; i < num_nodes; ++i) {
+                jacobian[i][j] = (res_perturbed[i] - res[i]) / h;
+            }
+        }
+        for (int i = 0; i < num_nodes; ++i) {
+            rhs[i] = res[i];
+        }
+        try {
+            jacobian.solve(dx, rhs);
+        } catch (const Dune::FMatrixError&) {
+            return false;
+        }
+
+        // Halve the step until the residual decreases.
+        bool decreased = false;
+        double step = 1.0;
+        for (int cut = 0; cut < 5 && !decreased; ++cut, step *= 0.5) {
+            x_trial = x;
+            for (int i = 0; i < num_nodes; ++i) {
+                x_trial[i] -= step * dx[i];
+            }
+            residual(x_trial, res_trial);
+            decreased = maxNorm(res_trial) < norm;
+        }
+        if (!decreased) {
+            return false;
+        }
+        std::swap(x, x_trial);
+        std::swap(res, res_trial);
+        norm = maxNorm(res);
+    }
+
+    pressures = std::move(x);
+    return true;
+}
+
+double
+NetworkPressureSolver::
+maxNorm(const std::vector<double>& v)
+{
+    double norm = 0.0;
+    for (const double val : v) {
+        norm = std::max(norm, std::abs(val));
+    }
+    return norm;
+}
+
+} // namespace Opm
@@ -0,0 +1,95 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_NETWORKPRESSURESOLVER_HEADER_INCLUDED
+#define OPM_NETWORKPRESSURESOLVER_HEADER_INCLUDED
+
+#include <array>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace Opm
+{
+
+/// Solves for the pressures of all nodes of a production network at once.
+///
+/// The flow into every leaf node is modelled as a linear function of the
+/// pressure of the node, given by the rates at a reference pressure and their
+/// derivatives with respect to the node pressure. The rates of a node are the
+/// sum of the inflows of the leaves below it, and the pressure of a node that
+/// does not have a fixed pressure is given by the pressure drop of the branch
+/// to its uptree node. With zero derivatives the system is triangular, and a
+/// sweep from the roots towards the leaves solves it. Otherwise the residuals
+/// of all nodes are coupled through the rates, and they are solved together by
+/// Newton's method with a finite difference Jacobian.
+class NetworkPressureSolver
+{
+public:
+    /// Surface rates, indexed by BlackoilPhases::Aqua, Liquid and Vapour
+    using Rates = std::array<double, 3>;
+
+    /// Pressure at the downtree end of the branch above node, given the
+    /// (positive) rates through the branch and the pressure of the uptree node
+    using BranchPressure = std::function<double(int node, const Rates& rates, double uptree_pressure)>;
+
+    struct Node
+    {
+        int parent = -1;                      // index of the uptree node, -1 for a root
+        std::optional<double> fixed_pressure; // terminal pressure of the node, if any
+        Rates inflow {};                      // inflow of a leaf at reference_pressure
+        Rates inflow_derivative {};           // derivative of the inflow with respect to the node pressure
+        double reference_pressure = 0.0;
+    };
+
+    /// \param[in] nodes             the nodes of the network, every node after its parent
+    /// \param[in] branch_pressure   pressure drop relation of the branches
+    NetworkPressureSolver(std::vector<Node> nodes, BranchPressure branch_pressure);
+
+    /// Solve for the node pressures
+    /// \param[in,out] pressures     initial guess, and the solution if successful
+    /// \param[in] tolerance         maximum absolute residual of a converged solution
+    /// \param[in] max_iterations    maximum number of Newton iterations
+    /// \return                      whether the iterations converged, pressures is
+    ///                              left unchanged if they did not
+    bool solve(std::vector<double>& pressures, const double tolerance, const int max_iterations);
+
+    /// Residuals of the node equations for the given pressures
+    void residual(const std::vector<double>& pressures, std::vector<double>& res) const;
+
+    /// Inflow of a node at the given pressure, zero unless the node is a leaf
+    Rates inflow(const int node, const double pressure) const;
+
+    /// Number of Newton iterations of the last call to solve()
+    int iterations() const
+    {
+        return iterations_;
+    }
+
+private:
+    static double maxNorm(const std::vector<double>& v);
+
+    std::vector<Node> nodes_;
+    BranchPressure branch_pressure_;
+    int iterations_ = 0;
+};
+
+} // namespace Opm
+
+#endif // OPM_NETWORKPRESSURESOLVER_HEADER_INCLUDED
@@ -22,6 +22,10 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/input/eclipse/Schedule/Well/Well.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
 namespace Dune
 {
 #if HAVE_MPI
@@ -105,6 +109,7 @@ std::vector<double> GlobalPerfContainerFactory::createGlobal(const std::vector<d
 
     if (comm_.size() > 1)
     {
+        ScopedTimer commTimer(TimingRegistry::Region::WellCommunication);
         std::vector<Value> global_recv(perf_ecl_index_.size() * num_components);
         if (num_components == 1)
         {
@@ -195,6 +200,10 @@ void CommunicateAboveBelow::clear()
     current_indices_ = {};
     interface_.free();
     communicator_.free();
+    owner_sizes_.clear();
+    owner_displ_.assign(1, 0);
+    sorted_from_gathered_.clear();
+    local_to_sorted_.clear();
 #endif
     num_local_perfs_ = 0;
 }
@@ -225,6 +234,46 @@ int CommunicateAboveBelow::endReset()
         using ToSet = Dune::AllSet<Attribute>;
         interface_.build(remote_indices_, FromSet(), ToSet());
         communicator_.build<double*>(interface_);
+
+        // The owned perforations do not change until the next reset. Gather
+        // their ECL indices once, such that partialSumPerfValues() only
+        // needs to gather the values.
+        using GlobalIndex = IndexSet::IndexPair::GlobalIndex;
+        std::vector<GlobalIndex> my_indices;
+        my_indices.reserve(current_indices_.size());
+        for (const auto& pair: current_indices_)
+        {
+            if (pair.local().attribute() == owner)
+            {
+                my_indices.push_back(pair.global());
+            }
+        }
+        int mySize = my_indices.size();
+        owner_sizes_.resize(comm_.size());
+        owner_displ_.assign(comm_.size() + 1, 0);
+        comm_.allgather(&mySize, 1, owner_sizes_.data());
+        std::partial_sum(owner_sizes_.begin(), owner_sizes_.end(), owner_displ_.begin()+1);
+        std::vector<GlobalIndex> global_indices(owner_displ_.back());
+        comm_.allgatherv(my_indices.data(), my_indices.size(), global_indices.data(),
+                         owner_sizes_.data(), owner_displ_.data());
+
+        sorted_from_gathered_.resize(global_indices.size());
+        std::iota(sorted_from_gathered_.begin(), sorted_from_gathered_.end(), 0);
+        std::sort(sorted_from_gathered_.begin(), sorted_from_gathered_.end(),
+                  [&global_indices](const std::size_t i, const std::size_t j)
+                  { return global_indices[i] < global_indices[j]; });
+        std::vector<GlobalIndex> sorted_indices(global_indices.size());
+        std::transform(sorted_from_gathered_.begin(), sorted_from_gathered_.end(), sorted_indices.begin(),
+                       [&global_indices](const std::size_t i) { return global_indices[i]; });
+
+        local_to_sorted_.resize(num_local_perfs_);
+        for (const auto& pair: current_indices_)
+        {
+            auto sorted = std::lower_bound(sorted_indices.begin(), sorted_indices.end(), pair.global());
+            assert(sorted != sorted_indices.end());
+            assert(*sorted == pair.global());
+            local_to_sorted_[pair.local().local()] = sorted - sorted_indices.begin();
+        }
     }
 #endif
     return num_local_perfs_;
@@ -258,6 +307,7 @@ std::vector<double> CommunicateAboveBelow::communicateAbove(double first_above,
         // passing const double*& and double* as parameter is
         // incompatible with function decl template<Data> forward(const Data&, Data&))
         // That would need the first argument to be double* const&
+        ScopedTimer commTimer(TimingRegistry::Region::WellCommunication);
         communicator_.forward<CopyGatherScatter>(const_cast<double*>(current), aboveData);
     }
     else
@@ -285,6 +335,7 @@ std::vector<double> CommunicateAboveBelow::communicateBelow(double last_below,
         // passing const double*& and double* as parameter is
         // incompatible with function decl template<Data> backward(Data&, const Data&)
         // That would need the first argument to be double* const&
+        ScopedTimer commTimer(TimingRegistry::Region::WellCommunication);
         communicator_.backward<CopyGatherScatter>(belowData, const_cast<double*>(current));
     }
     else
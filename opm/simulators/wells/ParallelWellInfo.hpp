@@ -25,6 +25,7 @@
 #include <dune/istl/owneroverlapcopy.hh>
 
 #include <opm/simulators/utils/ParallelCommunication.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
 
@@ -126,44 +127,33 @@ public:
             // is the index of the perforation in ECL Schedule definition.
             // This is assumed to give the topological order that is used
             // when doing the partial sum.
-            // allgather the index of the perforation in ECL schedule and the value.
+            // The owned perforations and their order are set up by
+            // endReset(), hence only the values need to be gathered here.
             using Value = typename std::iterator_traits<RAIterator>::value_type;
-            std::vector<int> sizes(comm_.size());
-            std::vector<int> displ(comm_.size() + 1, 0);
-            using GlobalIndex = typename IndexSet::IndexPair::GlobalIndex;
-            using Pair = std::pair<GlobalIndex,Value>;
-            std::vector<Pair> my_pairs;
-            my_pairs.reserve(current_indices_.size());
+            std::vector<Value> my_values;
+            my_values.reserve(current_indices_.size());
             for (const auto& pair: current_indices_)
             {
                 if (pair.local().attribute() == owner)
                 {
-                    my_pairs.emplace_back(pair.global(), begin[pair.local()]);
+                    my_values.push_back(begin[pair.local()]);
                 }
             }
-            int mySize = my_pairs.size();
-            comm_.allgather(&mySize, 1, sizes.data());
-            std::partial_sum(sizes.begin(), sizes.end(), displ.begin()+1);
-            std::vector<Pair> global_pairs(displ.back());
-            comm_.allgatherv(my_pairs.data(), my_pairs.size(), global_pairs.data(), sizes.data(), displ.data());
+            std::vector<Value> gathered_values(owner_displ_.back());
+            ScopedTimer commTimer(TimingRegistry::Region::WellCommunication);
+            // Dune's allgatherv expects non-const sizes and offsets.
+            comm_.allgatherv(my_values.data(), my_values.size(), gathered_values.data(),
+                             const_cast<int*>(owner_sizes_.data()),
+                             const_cast<int*>(owner_displ_.data()));
             // sort the complete range to get the correct ordering
-            std::sort(global_pairs.begin(), global_pairs.end(),
-                      [](const Pair& p1, const Pair& p2){ return p1.first < p2.first; } );
-            std::vector<Value> sums(global_pairs.size());
-            std::transform(global_pairs.begin(), global_pairs.end(), sums.begin(),
-                           [](const Pair& p) { return p.second; });
+            std::vector<Value> sums(gathered_values.size());
+            std::transform(sorted_from_gathered_.begin(), sorted_from_gathered_.end(), sums.begin(),
+                           [&gathered_values](const std::size_t i) { return gathered_values[i]; });
             std::partial_sum(sums.begin(), sums.end(),sums.begin());
-            // assign the values (both ranges are sorted by the ecl index)
-            auto global_pair = global_pairs.begin();
+            // assign the values
             for (const auto& pair: current_indices_)
             {
-                global_pair = std::lower_bound(global_pair, global_pairs.end(),
-                                               pair.global(),
-                                               [](const Pair& val1, const GlobalIndex& val2)
-                                               { return val1.first < val2; });
-                assert(global_pair != global_pairs.end());
-                assert(global_pair->first == pair.global());
-                begin[pair.local()] = sums[global_pair - global_pairs.begin()];
+                begin[pair.local()] = sums[local_to_sorted_[pair.local().local()]];
             }
 #else
             OPM_THROW(std::logic_error, "In a sequential run the size of the communicator should be 1!");
@@ -185,6 +175,14 @@ private:
     RI remote_indices_;
     Dune::Interface interface_;
     Dune::BufferedCommunicator communicator_;
+    /// \brief Number of owned perforations of each process
+    std::vector<int> owner_sizes_;
+    /// \brief Offsets of the owned perforations of each process in the gathered values
+    std::vector<int> owner_displ_{0};
+    /// \brief Position in the gathered values of each perforation in ECL order
+    std::vector<std::size_t> sorted_from_gathered_;
+    /// \brief Position in ECL order of each local perforation
+    std::vector<std::size_t> local_to_sorted_;
 #endif
     std::size_t num_local_perfs_{};
 };
@@ -374,6 +372,10 @@ public:
         using V = typename std::iterator_traits<It>::value_type;
         /// \todo cater for overlap later. Currently only owner
         auto local = std::accumulate(begin, end, V());
+        if (communication().size() < 2) {
+            return local;
+        }
+        ScopedTimer commTimer(TimingRegistry::Region::WellCommunication);
         return communication().sum(local);
     }
 
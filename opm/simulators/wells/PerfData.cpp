@@ -20,31 +20,112 @@
 
 #include <opm/simulators/wells/PerfData.hpp>
 
+#include <algorithm>
+#include <utility>
+
 namespace Opm
 {
 
 
 PerfData::PerfData(std::size_t num_perf, double pressure_first_connection_, bool injector_, std::size_t num_phases)
     : injector(injector_)
+    , num_perf_(num_perf)
+    , num_phases_(num_phases)
     , pressure_first_connection(pressure_first_connection_)
-    , pressure(num_perf)
-    , rates(num_perf)
-    , phase_rates(num_perf * num_phases)
-    , solvent_rates(num_perf)
-    , polymer_rates(num_perf)
-    , brine_rates(num_perf)
-    , prod_index(num_perf * num_phases)
-    , micp_rates(num_perf)
     , cell_index(num_perf)
-    , connection_transmissibility_factor(num_perf)
     , satnum_id(num_perf)
     , ecl_index(num_perf)
 {
-    if (injector) {
-        this->water_throughput.resize(num_perf);
-        this->skin_pressure.resize(num_perf);
-        this->water_velocity.resize(num_perf);
-    }
+    // 7 values and 2 values per phase for every perforation, and 3 more for injectors
+    const std::size_t values_per_perf = 7 + 2 * num_phases + (injector ? 3 : 0);
+    this->values_.resize(num_perf * values_per_perf);
+    this->bind();
+}
+
+PerfData::PerfData(const PerfData& other)
+    : injector(other.injector)
+    , num_perf_(other.num_perf_)
+    , num_phases_(other.num_phases_)
+    , values_(other.values_)
+    , pressure_first_connection(other.pressure_first_connection)
+    , cell_index(other.cell_index)
+    , satnum_id(other.satnum_id)
+    , ecl_index(other.ecl_index)
+{
+    this->bind();
+}
+
+PerfData::PerfData(PerfData&& other) noexcept
+    : injector(other.injector)
+    , num_perf_(other.num_perf_)
+    , num_phases_(other.num_phases_)
+    , values_(std::move(other.values_))
+    , pressure_first_connection(other.pressure_first_connection)
+    , cell_index(std::move(other.cell_index))
+    , satnum_id(std::move(other.satnum_id))
+    , ecl_index(std::move(other.ecl_index))
+{
+    this->bind();
+    other.num_perf_ = 0;
+    other.bind();
+}
+
+PerfData& PerfData::operator=(const PerfData& other) {
+    if (this == &other)
+        return *this;
+
+    this->injector = other.injector;
+    this->num_perf_ = other.num_perf_;
+    this->num_phases_ = other.num_phases_;
+    // reuses the buffer if it is large enough
+    this->values_ = other.values_;
+    this->pressure_first_connection = other.pressure_first_connection;
+    this->cell_index = other.cell_index;
+    this->satnum_id = other.satnum_id;
+    this->ecl_index = other.ecl_index;
+    this->bind();
+    return *this;
+}
+
+PerfData& PerfData::operator=(PerfData&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    this->injector = other.injector;
+    this->num_perf_ = other.num_perf_;
+    this->num_phases_ = other.num_phases_;
+    this->values_ = std::move(other.values_);
+    this->pressure_first_connection = other.pressure_first_connection;
+    this->cell_index = std::move(other.cell_index);
+    this->satnum_id = std::move(other.satnum_id);
+    this->ecl_index = std::move(other.ecl_index);
+    this->bind();
+    other.num_perf_ = 0;
+    other.bind();
+    return *this;
+}
+
+void PerfData::bind() {
+    double* next = this->values_.data();
+    auto assign = [&next](Values& view, std::size_t size) {
+        view.data_ = next;
+        view.size_ = size;
+        next += size;
+    };
+    const std::size_t nperf = this->num_perf_;
+    const std::size_t ninj = this->injector ? nperf : 0;
+    assign(this->pressure, nperf);
+    assign(this->rates, nperf);
+    assign(this->phase_rates, nperf * this->num_phases_);
+    assign(this->solvent_rates, nperf);
+    assign(this->polymer_rates, nperf);
+    assign(this->brine_rates, nperf);
+    assign(this->prod_index, nperf * this->num_phases_);
+    assign(this->micp_rates, nperf);
+    assign(this->connection_transmissibility_factor, nperf);
+    assign(this->water_throughput, ninj);
+    assign(this->skin_pressure, ninj);
+    assign(this->water_velocity, ninj);
 }
 
 std::size_t PerfData::size() const {
@@ -55,6 +136,13 @@ bool PerfData::empty() const {
     return this->pressure.empty();
 }
 
+std::size_t PerfData::memoryBytes() const {
+    return this->values_.capacity() * sizeof(double)
+        + this->cell_index.capacity() * sizeof(std::size_t)
+        + this->satnum_id.capacity() * sizeof(int)
+        + this->ecl_index.capacity() * sizeof(std::size_t);
+}
+
 bool PerfData::try_assign(const PerfData& other) {
     if (this->size() != other.size())
         return false;
@@ -62,18 +150,21 @@ bool PerfData::try_assign(const PerfData& other) {
     if (this->injector != other.injector)
         return false;
 
+    auto copy = [](const Values& from, Values& to) {
+        std::copy(from.begin(), from.end(), to.begin());
+    };
     this->pressure_first_connection = other.pressure_first_connection;
-    this->pressure = other.pressure;
-    this->rates = other.rates;
-    this->phase_rates = other.phase_rates;
-    this->solvent_rates = other.solvent_rates;
-    this->polymer_rates = other.polymer_rates;
-    this->brine_rates = other.brine_rates;
-    this->water_throughput = other.water_throughput;
-    this->skin_pressure = other.skin_pressure;
-    this->water_velocity = other.water_velocity;
-    this->prod_index = other.prod_index;
-    this->micp_rates = other.micp_rates;
+    copy(other.pressure, this->pressure);
+    copy(other.rates, this->rates);
+    copy(other.phase_rates, this->phase_rates);
+    copy(other.solvent_rates, this->solvent_rates);
+    copy(other.polymer_rates, this->polymer_rates);
+    copy(other.brine_rates, this->brine_rates);
+    copy(other.water_throughput, this->water_throughput);
+    copy(other.skin_pressure, this->skin_pressure);
+    copy(other.water_velocity, this->water_velocity);
+    copy(other.prod_index, this->prod_index);
+    copy(other.micp_rates, this->micp_rates);
     return true;
 }
 
@@ -21,44 +21,90 @@
 #ifndef OPM_PERFDATA_HEADER_INCLUDED
 #define OPM_PERFDATA_HEADER_INCLUDED
 
+#include <cstddef>
 #include <vector>
 
 namespace Opm
 {
 
+/// The state of the perforations of one well.
+///
+/// All floating point quantities are stored in one contiguous buffer, and the
+/// public members are views into that buffer. Copying a PerfData is therefore
+/// one allocation for all of them, or none when the target already has the
+/// same size, instead of one allocation per quantity.
 class PerfData
 {
+public:
+    /// View of one quantity in the buffer of a PerfData
+    class Values
+    {
+    public:
+        Values() = default;
+        Values(const Values&) = delete;
+        Values& operator=(const Values&) = delete;
+
+        double& operator[](std::size_t i) { return data_[i]; }
+        const double& operator[](std::size_t i) const { return data_[i]; }
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        double* data() { return data_; }
+        const double* data() const { return data_; }
+        double* begin() { return data_; }
+        double* end() { return data_ + size_; }
+        const double* begin() const { return data_; }
+        const double* end() const { return data_ + size_; }
+
+    private:
+        friend class PerfData;
+        double* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
 private:
     bool injector;
+    std::size_t num_perf_;
+    std::size_t num_phases_;
+    std::vector<double> values_;
+
+    // point the views into values_
+    void bind();
 
 public:
     PerfData(std::size_t num_perf, double pressure_first_connection_, bool injector_, std::size_t num_phases);
+    PerfData(const PerfData& other);
+    PerfData(PerfData&& other) noexcept;
+    PerfData& operator=(const PerfData& other);
+    PerfData& operator=(PerfData&& other) noexcept;
+
     std::size_t size() const;
     bool empty() const;
     bool try_assign(const PerfData& other);
+    /// Bytes allocated by the connection data.
+    std::size_t memoryBytes() const;
 
 
     double pressure_first_connection;
-    std::vector<double> pressure;
-    std::vector<double> rates;
-    std::vector<double> phase_rates;
-    std::vector<double> solvent_rates;
-    std::vector<double> polymer_rates;
-    std::vector<double> brine_rates;
-    std::vector<double> prod_index;
-    std::vector<double> micp_rates;
+    Values pressure;
+    Values rates;
+    Values phase_rates;
+    Values solvent_rates;
+    Values polymer_rates;
+    Values brine_rates;
+    Values prod_index;
+    Values micp_rates;
 
     std::vector<std::size_t> cell_index;
-    std::vector<double> connection_transmissibility_factor;
+    Values connection_transmissibility_factor;
     std::vector<int> satnum_id;
     std::vector<std::size_t> ecl_index;
 
 
     // The water_throughput, skin_pressure and water_velocity variables are only
     // used for injectors to check the injectivity.
-    std::vector<double> water_throughput;
-    std::vector<double> skin_pressure;
-    std::vector<double> water_velocity;
+    Values water_throughput;
+    Values skin_pressure;
+    Values water_velocity;
 };
 
 } // namespace Opm
@@ -108,36 +108,27 @@ namespace Opm {
 
                 }
 
-                // quantities for pore volume average
-                std::unordered_map<RegionId, Attributes> attributes_pv;
-
-                // quantities for hydrocarbon volume average
-                std::unordered_map<RegionId, Attributes> attributes_hpv;
-
-                for (const auto& reg : rmap_.activeRegions()) {
-                    attributes_pv.insert({reg, Attributes()});
-                    attributes_hpv.insert({reg, Attributes()});
+                // quantities for pore volume and hydrocarbon volume
+                // averages, accumulated separately by each thread
+                const int numThreads = RegionAttributeHelpers::maxThreads();
+                std::vector<std::unordered_map<RegionId, Attributes>> attributes_pv(numThreads);
+                std::vector<std::unordered_map<RegionId, Attributes>> attributes_hpv(numThreads);
+
+                for (int threadId = 0; threadId < numThreads; ++threadId) {
+                    for (const auto& reg : rmap_.activeRegions()) {
+                        attributes_pv[threadId].insert({reg, Attributes()});
+                        attributes_hpv[threadId].insert({reg, Attributes()});
+                    }
                 }
 
-                ElementContext elemCtx( simulator );
                 const auto& gridView = simulator.gridView();
                 const auto& comm = gridView.comm();
+                const auto& pu = phaseUsage_;
                 OPM_BEGIN_PARALLEL_TRY_CATCH();
 
-                const auto& elemEndIt = gridView.template end</*codim=*/0>();
-                for (auto elemIt = gridView.template begin</*codim=*/0>();
-                     elemIt != elemEndIt;
-                     ++elemIt)
+                RegionAttributeHelpers::forEachInteriorCell<ElementContext>(simulator,
+                    [&](const unsigned cellIdx, const auto& intQuants, const int threadId)
                 {
-
-                    const auto& elem = *elemIt;
-                    if (elem.partitionType() != Dune::InteriorEntity)
-                        continue;
-
-                    elemCtx.updatePrimaryStencil(elem);
-                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                    const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                    const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
                     const auto& fs = intQuants.fluidState();
                     // use pore volume weighted averages.
                     const double pv_cell =
@@ -146,7 +137,6 @@ namespace Opm {
 
                     // only count oil and gas filled parts of the domain
                     double hydrocarbon = 1.0;
-                    const auto& pu = phaseUsage_;
                     if (RegionAttributeHelpers::PhaseUsed::water(pu)) {
                         hydrocarbon -= fs.saturation(FluidSystem::waterPhaseIdx).value();
                     }
@@ -157,7 +147,7 @@ namespace Opm {
                     // sum p, rs, rv, and T.
                     const double hydrocarbonPV = pv_cell*hydrocarbon;
                     if (hydrocarbonPV > 0.) {
-                        auto& attr = attributes_hpv[reg];
+                        auto& attr = attributes_hpv[threadId][reg];
                         attr.pv += hydrocarbonPV;
                         if (RegionAttributeHelpers::PhaseUsed::oil(pu) && RegionAttributeHelpers::PhaseUsed::gas(pu)) {
                             attr.rs += fs.Rs().value() * hydrocarbonPV;
@@ -175,7 +165,7 @@ namespace Opm {
                     }
 
                     if (pv_cell > 0.) {
-                        auto& attr = attributes_pv[reg];
+                        auto& attr = attributes_pv[threadId][reg];
                         attr.pv += pv_cell;
                         if (RegionAttributeHelpers::PhaseUsed::oil(pu) && RegionAttributeHelpers::PhaseUsed::gas(pu)) {
                             attr.rs += fs.Rs().value() * pv_cell;
@@ -194,46 +184,53 @@ namespace Opm {
                         }
                         attr.saltConcentration += fs.saltConcentration().value() * pv_cell;
                     }
-                }
+                });
 
                 OPM_END_PARALLEL_TRY_CATCH("SurfaceToReservoirVoidage::defineState() failed: ", simulator.vanguard().grid().comm());
 
-                for (const auto& reg : rmap_.activeRegions()) {
+                // Combine the thread contributions in thread order and sum
+                // all regions over the processes in a single reduction.
+                constexpr int numValues = 6;
+                const auto pack = [](const Attributes& attr, double* values)
+                {
+                    values[0] += attr.pv;
+                    values[1] += attr.pressure;
+                    values[2] += attr.temperature;
+                    values[3] += attr.rs;
+                    values[4] += attr.rv;
+                    values[5] += attr.saltConcentration;
+                };
+                const auto& activeRegions = rmap_.activeRegions();
+                std::vector<double> sums(2 * numValues * activeRegions.size(), 0.0);
+                {
+                    std::size_t offset = 0;
+                    for (const auto& reg : activeRegions) {
+                        for (int threadId = 0; threadId < numThreads; ++threadId) {
+                            pack(attributes_hpv[threadId][reg], &sums[offset]);
+                            pack(attributes_pv[threadId][reg], &sums[offset + numValues]);
+                        }
+                        offset += 2 * numValues;
+                    }
+                }
+                comm.sum(sums.data(), sums.size());
+
+                std::size_t offset = 0;
+                for (const auto& reg : activeRegions) {
                       auto& ra = attr_.attributes(reg);
-                      const double hpv_sum = comm.sum(attributes_hpv[reg].pv);
+                      const double* hpv_sums = &sums[offset];
+                      const double* pv_sums = &sums[offset + numValues];
+                      offset += 2 * numValues;
                       // TODO: should we have some epsilon here instead of zero?
-                      if (hpv_sum > 0.) {
-                          const auto& attri_hpv = attributes_hpv[reg];
-                          const double p_hpv_sum = comm.sum(attri_hpv.pressure);
-                          const double T_hpv_sum = comm.sum(attri_hpv.temperature);
-                          const double rs_hpv_sum = comm.sum(attri_hpv.rs);
-                          const double rv_hpv_sum = comm.sum(attri_hpv.rv);
-                          const double sc_hpv_sum = comm.sum(attri_hpv.saltConcentration);
-
-                          ra.pressure = p_hpv_sum / hpv_sum;
-                          ra.temperature = T_hpv_sum / hpv_sum;
-                          ra.rs = rs_hpv_sum / hpv_sum;
-                          ra.rv = rv_hpv_sum / hpv_sum;
-                          ra.pv = hpv_sum;
-                          ra.saltConcentration = sc_hpv_sum / hpv_sum;
-                      } else {
-                          // using the pore volume to do the averaging
-                          const auto& attri_pv = attributes_pv[reg];
-                          const double pv_sum = comm.sum(attri_pv.pv);
-                          assert(pv_sum > 0.);
-                          const double p_pv_sum = comm.sum(attri_pv.pressure);
-                          const double T_pv_sum = comm.sum(attri_pv.temperature);
-                          const double rs_pv_sum = comm.sum(attri_pv.rs);
-                          const double rv_pv_sum = comm.sum(attri_pv.rv);
-                          const double sc_pv_sum = comm.sum(attri_pv.saltConcentration);
-
-                          ra.pressure = p_pv_sum / pv_sum;
-                          ra.temperature = T_pv_sum / pv_sum;
-                          ra.rs = rs_pv_sum / pv_sum;
-                          ra.rv = rv_pv_sum / pv_sum;
-                          ra.pv = pv_sum;
-                          ra.saltConcentration = sc_pv_sum / pv_sum;
-                      }
+                      // Otherwise use the pore volume to do the averaging.
+                      const double* values = hpv_sums[0] > 0. ? hpv_sums : pv_sums;
+                      assert(values[0] > 0.);
+
+                      ra.pv = values[0];
+                      ra.pressure = values[1] / values[0];
+                      ra.temperature = values[2] / values[0];
+                      ra.rs = values[3] / values[0];
+                      ra.rv = values[4] / values[0];
+                      ra.saltConcentration = values[5] / values[0];
                 }
             }
 
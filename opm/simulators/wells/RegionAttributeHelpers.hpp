@@ -28,8 +28,16 @@
 #include <opm/simulators/linalg/ParallelIstlInformation.hpp>
 
 #include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
 #include <cmath>
+#include <exception>
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
@@ -404,6 +412,95 @@ namespace Opm {
                 }
             } // namespace PhasePos
 
+            /**
+             * Number of threads that may call the function passed to
+             * forEachInteriorCell(), i.e., the size of per-thread
+             * accumulation buffers.
+             */
+            inline int
+            maxThreads()
+            {
+#ifdef _OPENMP
+                return omp_get_max_threads();
+#else
+                return 1;
+#endif
+            }
+
+            /**
+             * Visit the intensive quantities of all interior cells.
+             *
+             * If the model caches the intensive quantities, the cached
+             * values are used and the cells are distributed over the
+             * OpenMP threads.  Otherwise the quantities are evaluated
+             * through an element context by the calling thread.
+             *
+             * \param[in] simulator Simulator object.
+             *
+             * \param[in] func Called as \code func(cellIdx, intQuants,
+             * threadId) \endcode with \c threadId less than
+             * maxThreads().  Calls with the same \c threadId never
+             * run concurrently.
+             */
+            template <class ElementContext, class Simulator, class Func>
+            void
+            forEachInteriorCell(const Simulator& simulator, Func&& func)
+            {
+                const auto& model = simulator.model();
+                const auto& gridView = simulator.gridView();
+                const auto& elemMapper = model.elementMapper();
+
+                std::vector<unsigned> interiorCells;
+                interiorCells.reserve(gridView.size(/*codim=*/0));
+                for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+                    interiorCells.push_back(elemMapper.index(elem));
+                }
+
+                const bool haveCachedIntQuants = interiorCells.empty() ||
+                    model.cachedIntensiveQuantities(interiorCells.front(), /*timeIdx=*/0) != nullptr;
+
+                if (!haveCachedIntQuants) {
+                    ElementContext elemCtx(simulator);
+                    for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+                        elemCtx.updatePrimaryStencil(elem);
+                        elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                        func(elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0),
+                             elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0),
+                             /*threadId=*/0);
+                    }
+                    return;
+                }
+
+                // Exceptions must not escape the parallel region, the first
+                // one is rethrown on the calling thread.
+                std::exception_ptr exc;
+                const int numInteriorCells = interiorCells.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+                for (int i = 0; i < numInteriorCells; ++i) {
+#ifdef _OPENMP
+                    const int threadId = omp_get_thread_num();
+#else
+                    const int threadId = 0;
+#endif
+                    try {
+                        const unsigned cellIdx = interiorCells[i];
+                        func(cellIdx, *model.cachedIntensiveQuantities(cellIdx, /*timeIdx=*/0), threadId);
+                    } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                        if (!exc) {
+                            exc = std::current_exception();
+                        }
+                    }
+                }
+                if (exc) {
+                    std::rethrow_exception(exc);
+                }
+            }
+
     } // namespace RegionAttributesHelpers
 } // namespace Opm
 
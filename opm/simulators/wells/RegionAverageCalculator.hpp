@@ -105,34 +105,25 @@ namespace Opm {
 
                 }
 
-                // quantities for pore volume average
-                std::unordered_map<RegionId, Attributes> attributes_pv;
-
-                // quantities for hydrocarbon volume average
-                std::unordered_map<RegionId, Attributes> attributes_hpv;
-
-                for (int reg = 1; reg <= numRegions ; ++ reg) {
-                    attributes_pv.insert({reg, Attributes()});
-                    attributes_hpv.insert({reg, Attributes()});
+                // quantities for pore volume and hydrocarbon volume
+                // averages, accumulated separately by each thread
+                const int numThreads = RegionAttributeHelpers::maxThreads();
+                std::vector<std::unordered_map<RegionId, Attributes>> attributes_pv(numThreads);
+                std::vector<std::unordered_map<RegionId, Attributes>> attributes_hpv(numThreads);
+
+                for (int threadId = 0; threadId < numThreads; ++threadId) {
+                    for (int reg = 1; reg <= numRegions ; ++ reg) {
+                        attributes_pv[threadId].insert({reg, Attributes()});
+                        attributes_hpv[threadId].insert({reg, Attributes()});
+                    }
                 }
 
-                ElementContext elemCtx( simulator );
-                const auto& elemEndIt = gridView.template end</*codim=*/0>();
+                const auto& pu = phaseUsage_;
                 OPM_BEGIN_PARALLEL_TRY_CATCH();
 
-                for (auto elemIt = gridView.template begin</*codim=*/0>();
-                     elemIt != elemEndIt;
-                     ++elemIt)
+                RegionAttributeHelpers::forEachInteriorCell<ElementContext>(simulator,
+                    [&](const unsigned cellIdx, const auto& intQuants, const int threadId)
                 {
-
-                    const auto& elem = *elemIt;
-                    if (elem.partitionType() != Dune::InteriorEntity)
-                        continue;
-
-                    elemCtx.updatePrimaryStencil(elem);
-                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                    const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                    const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
                     const auto& fs = intQuants.fluidState();
                     // use pore volume weighted averages.
                     const double pv_cell =
@@ -141,7 +132,6 @@ namespace Opm {
 
                     // only count oil and gas filled parts of the domain
                     double hydrocarbon = 1.0;
-                    const auto& pu = phaseUsage_;
                     if (RegionAttributeHelpers::PhaseUsed::water(pu)) {
                         hydrocarbon -= fs.saturation(FluidSystem::waterPhaseIdx).value();
                     }
@@ -152,7 +142,7 @@ namespace Opm {
                     // sum p, rs, rv, and T.
                     const double hydrocarbonPV = pv_cell*hydrocarbon;
                     if (hydrocarbonPV > 0.) {
-                        auto& attr = attributes_hpv[reg];
+                        auto& attr = attributes_hpv[threadId][reg];
                         attr.pv += hydrocarbonPV;
                         if (RegionAttributeHelpers::PhaseUsed::oil(pu)) {
                             attr.pressure += fs.pressure(FluidSystem::oilPhaseIdx).value() * hydrocarbonPV;
@@ -163,7 +153,7 @@ namespace Opm {
                     }
 
                     if (pv_cell > 0.) {
-                        auto& attr = attributes_pv[reg];
+                        auto& attr = attributes_pv[threadId][reg];
                         attr.pv += pv_cell;
                         if (RegionAttributeHelpers::PhaseUsed::oil(pu)) {
                             attr.pressure += fs.pressure(FluidSystem::oilPhaseIdx).value() * pv_cell;
@@ -174,25 +164,40 @@ namespace Opm {
                             attr.pressure += fs.pressure(FluidSystem::waterPhaseIdx).value() * pv_cell;
                         }
                     }
-                }
+                });
                 OPM_END_PARALLEL_TRY_CATCH("AverageRegionalPressure::defineState(): ", simulator.vanguard().grid().comm());
 
+                // Combine the thread contributions in thread order and sum
+                // all regions over the processes in a single reduction.
+                // Per region: hydrocarbon volume, its pressure sum, pore
+                // volume and its pressure sum.
+                std::vector<double> sums(4 * numRegions, 0.0);
+                for (int reg = 1; reg <= numRegions ; ++ reg) {
+                    double* values = &sums[4 * (reg - 1)];
+                    for (int threadId = 0; threadId < numThreads; ++threadId) {
+                        const auto& attri_hpv = attributes_hpv[threadId][reg];
+                        const auto& attri_pv = attributes_pv[threadId][reg];
+                        values[0] += attri_hpv.pv;
+                        values[1] += attri_hpv.pressure;
+                        values[2] += attri_pv.pv;
+                        values[3] += attri_pv.pressure;
+                    }
+                }
+                comm.sum(sums.data(), sums.size());
+
                 for (int reg = 1; reg <= numRegions ; ++ reg) {
                       auto& ra = attr_.attributes(reg);
-                      const double hpv_sum = comm.sum(attributes_hpv[reg].pv);
+                      const double* values = &sums[4 * (reg - 1)];
+                      const double hpv_sum = values[0];
                       // TODO: should we have some epsilon here instead of zero?
                       if (hpv_sum > 0.) {
-                          const auto& attri_hpv = attributes_hpv[reg];
-                          const double p_hpv_sum = comm.sum(attri_hpv.pressure);
-                          ra.pressure = p_hpv_sum / hpv_sum;
+                          ra.pressure = values[1] / hpv_sum;
                       } else {
                           // using the pore volume to do the averaging
-                          const auto& attri_pv = attributes_pv[reg];
-                          const double pv_sum = comm.sum(attri_pv.pv);
+                          const double pv_sum = values[2];
                           // pore volums can be zero if a fipnum region is empty
                           if (pv_sum > 0) {
-                            const double p_pv_sum = comm.sum(attri_pv.pressure);
-                            ra.pressure = p_pv_sum / pv_sum;
+                            ra.pressure = values[3] / pv_sum;
                           }
                       }
                 }
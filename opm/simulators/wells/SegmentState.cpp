@@ -59,6 +59,14 @@ std::size_t SegmentState::size() const {
     return this->pressure.size();
 }
 
+std::size_t SegmentState::memoryBytes() const {
+    return (this->rates.capacity() + this->pressure.capacity()
+            + this->pressure_drop_friction.capacity()
+            + this->pressure_drop_hydrostatic.capacity()
+            + this->pressure_drop_accel.capacity()) * sizeof(double)
+        + this->m_segment_number.capacity() * sizeof(int);
+}
+
 
 void SegmentState::scale_pressure(const double bhp) {
     if (this->empty())
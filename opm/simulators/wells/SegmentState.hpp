@@ -39,6 +39,8 @@ public:
     void scale_pressure(double bhp);
     const std::vector<int>& segment_number() const;
     std::size_t size() const;
+    /// Bytes allocated by the segment data.
+    std::size_t memoryBytes() const;
 
     std::vector<double> rates;
     std::vector<double> pressure;
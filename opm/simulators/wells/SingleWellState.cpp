@@ -74,7 +74,7 @@ void SingleWellState::shut() {
     std::fill(this->productivity_index.begin(), this->productivity_index.end(), 0);
 
     auto& connpi = this->perf_data.prod_index;
-    connpi.assign(connpi.size(), 0);
+    std::fill(connpi.begin(), connpi.end(), 0);
 }
 
 void SingleWellState::stop() {
@@ -132,7 +132,7 @@ void SingleWellState::reset_connection_factors(const std::vector<PerforationData
 }
 
 
-double SingleWellState::sum_connection_rates(const std::vector<double>& connection_rates) const {
+double SingleWellState::sum_connection_rates(const PerfData::Values& connection_rates) const {
     return this->parallel_info.get().sumPerfValues(connection_rates.begin(), connection_rates.end());
 }
 
@@ -153,6 +153,10 @@ namespace Opm
         /// r = r - C D^-1 Rw
         virtual void apply(BVector& r) const override;
 
+        /// Add this well to the batched apply of the StandardWells, instead of apply(x, Ax)
+        /// \return false iff the well is distributed and must use apply(x, Ax)
+        bool addToBatch(StandardWellBatch<Scalar, Indices::numEq>& batch) const;
+
         /// using the solution x to recover the solution xw for wells and applying
         /// xw to update Well State
         virtual void recoverWellSolutionAndUpdateWellState(const BVector& x,
@@ -215,6 +219,12 @@ namespace Opm
             DeferredLogger& deferred_logger,
             double alq_value) const override;
 
+        virtual std::vector<std::optional<double>> computeBhpAtThpLimitProdWithAlqs(
+            const Simulator& ebos_simulator,
+            const SummaryState& summary_state,
+            DeferredLogger& deferred_logger,
+            const std::vector<double>& alq_values) const override;
+
         virtual void computeWellRatesWithBhp(
             const Simulator& ebosSimulator,
             const double& bhp,
@@ -228,20 +238,38 @@ namespace Opm
         virtual std::vector<double> computeCurrentWellRates(const Simulator& ebosSimulator,
                                                             DeferredLogger& deferred_logger) const override;
 
+        // the mobilities are either EvalWell or Scalar, only their values are used
+        template <class Value>
         void computeConnLevelProdInd(const FluidState& fs,
                                      const std::function<double(const double)>& connPICalc,
-                                     const std::vector<EvalWell>& mobility,
+                                     const std::vector<Value>& mobility,
                                      double* connPI) const;
 
+        template <class Value>
         void computeConnLevelInjInd(const typename StandardWell<TypeTag>::FluidState& fs,
                                     const Phase preferred_phase,
                                     const std::function<double(const double)>& connIICalc,
-                                    const std::vector<EvalWell>& mobility,
+                                    const std::vector<Value>& mobility,
                                     double* connII,
                                     DeferredLogger& deferred_logger) const;
 
 
     protected:
+        // Work vectors of the assembly of the well equations, which keep their
+        // storage between the Newton iterations so that the assembly does not
+        // allocate once the sizes are known. A well is only assembled by one
+        // thread at a time.
+        struct AssemblyScratch
+        {
+            std::vector<EvalWell> mob;
+            std::vector<EvalWell> b_perfcells;
+            std::vector<EvalWell> cq_s;
+            std::vector<RateVector> connectionRates;
+            BVectorWell resWell;
+            BVectorWell dx_well;
+        };
+        mutable AssemblyScratch scratch_;
+
         // xw = inv(D)*(rw - C*x)
         void recoverSolutionWell(const BVector& x, BVectorWell& xw) const;
 
@@ -275,6 +303,7 @@ namespace Opm
                                  const double Tw,
                                  const int perf,
                                  const bool allow_cf,
+                                 const std::vector<EvalWell>& cmix_s,
                                  std::vector<EvalWell>& cq_s,
                                  double& perf_dis_gas_rate,
                                  double& perf_vap_oil_rate,
@@ -286,6 +315,7 @@ namespace Opm
                                    const double Tw,
                                    const int perf,
                                    const bool allow_cf,
+                                   const std::vector<Scalar>& cmix_s,
                                    std::vector<Scalar>& cq_s,
                                    DeferredLogger& deferred_logger) const;
 
@@ -363,6 +393,8 @@ namespace Opm
 
         void calculateSinglePerf(const Simulator& ebosSimulator,
                                  const int perf,
+                                 const bool allow_cf,
+                                 const std::vector<EvalWell>& cmix_s,
                                  WellState& well_state,
                                  std::vector<RateVector>& connectionRates,
                                  std::vector<EvalWell>& cq_s,
@@ -0,0 +1,258 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_STANDARDWELLBATCH_HEADER_INCLUDED
+#define OPM_STANDARDWELLBATCH_HEADER_INCLUDED
+
+#include <dune/common/fvector.hh>
+#include <dune/istl/bvector.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// Applies y -= C^T D^-1 B x for many StandardWells at once.
+///
+/// The wells are grouped by their number of perforations and their number of
+/// well equations. Every group stores the blocks of its wells contiguously,
+/// such that applying the wells is a loop over a few groups with sizes that are
+/// fixed within the group, instead of a virtual call and three small BCRS
+/// products per well. Within a group the wells are distributed over the
+/// OpenMP threads.
+///
+/// Usage: clear(), addWell() for every well followed by filling the returned
+/// storage, finalize(), and then apply() as often as needed.
+template <class Scalar, int numEq>
+class StandardWellBatch
+{
+public:
+    using BVector = Dune::BlockVector<Dune::FieldVector<Scalar, numEq>>;
+
+    /// Pointers to the storage of one well, only valid until the next call to addWell()
+    /// B and C contain numPerfs blocks of numWellEq x numEq, stored row-wise
+    /// invD contains one block of numWellEq x numWellEq, stored row-wise
+    struct WellStorage {
+        int* cells;
+        Scalar* B;
+        Scalar* C;
+        Scalar* invD;
+    };
+
+    /// Remove all wells, the memory of the groups is kept for the next Newton iteration
+    void clear()
+    {
+        for (auto& group : groups_) {
+            group.numWells = 0;
+            group.cells.clear();
+            group.B.clear();
+            group.C.clear();
+            group.invD.clear();
+        }
+        numWells_ = 0;
+        finalized_ = false;
+    }
+
+    /// Reserve the storage for a well
+    /// \param[in] numPerfs    number of perforated cells of the well
+    /// \param[in] numWellEq   number of well equations
+    /// \return                pointers to the storage of this well
+    WellStorage addWell(const int numPerfs, const int numWellEq)
+    {
+        const auto key = std::make_pair(numPerfs, numWellEq);
+        auto it = groupIndex_.find(key);
+        if (it == groupIndex_.end()) {
+            it = groupIndex_.emplace(key, groups_.size()).first;
+            groups_.emplace_back();
+            groups_.back().numPerfs = numPerfs;
+            groups_.back().numWellEq = numWellEq;
+        }
+        Group& group = groups_[it->second];
+        const std::size_t blockSize = numWellEq * numEq;
+
+        group.cells.resize(group.cells.size() + numPerfs);
+        group.B.resize(group.B.size() + numPerfs * blockSize);
+        group.C.resize(group.C.size() + numPerfs * blockSize);
+        group.invD.resize(group.invD.size() + numWellEq * numWellEq);
+        ++group.numWells;
+        ++numWells_;
+        finalized_ = false;
+
+        WellStorage storage;
+        storage.cells = group.cells.data() + group.cells.size() - numPerfs;
+        storage.B = group.B.data() + group.B.size() - numPerfs * blockSize;
+        storage.C = group.C.data() + group.C.size() - numPerfs * blockSize;
+        storage.invD = group.invD.data() + group.invD.size() - numWellEq * numWellEq;
+        return storage;
+    }
+
+    /// Must be called after all wells are added and filled, before apply()
+    void finalize()
+    {
+        // the wells can update y concurrently if no cell is perforated by more than one batched well
+        int maxCell = -1;
+        for (const auto& group : groups_) {
+            for (const int cell : group.cells) {
+                maxCell = std::max(maxCell, cell);
+            }
+            group.z.resize(2 * group.numWells * group.numWellEq);
+        }
+        std::vector<char> perforated(maxCell + 1, 0);
+        cellsDisjoint_ = true;
+        for (const auto& group : groups_) {
+            for (const int cell : group.cells) {
+                if (perforated[cell]) {
+                    cellsDisjoint_ = false;
+                }
+                perforated[cell] = 1;
+            }
+        }
+        finalized_ = true;
+    }
+
+    /// Return the number of wells in the batch
+    int numWells() const
+    {
+        return numWells_;
+    }
+
+    /// Return whether finalize() was called after the last change
+    bool finalized() const
+    {
+        return finalized_;
+    }
+
+    /// y -= C^T D^-1 B x for all wells in the batch
+    void apply(const BVector& x, BVector& y) const
+    {
+        for (const auto& group : groups_) {
+            if (group.numWells > 0) {
+                applyGroup(group, x, y);
+            }
+        }
+    }
+
+private:
+    struct Group {
+        int numPerfs = 0;
+        int numWellEq = 0;
+        int numWells = 0;
+        std::vector<int> cells;
+        std::vector<Scalar> B, C, invD;
+        mutable std::vector<Scalar> z; // B x and D^-1 B x of every well
+    };
+
+    // minimum number of wells in a group before the group is split over threads
+    static constexpr int minWellsPerThread = 32;
+
+    // z = D^-1 B x for well w
+    static void computeZ(const Group& group, const int w, const BVector& x)
+    {
+        const int numPerfs = group.numPerfs;
+        const int numWellEq = group.numWellEq;
+        const std::size_t blockSize = numWellEq * numEq;
+        const int* cells = group.cells.data() + w * numPerfs;
+        const Scalar* B = group.B.data() + w * numPerfs * blockSize;
+        const Scalar* invD = group.invD.data() + w * numWellEq * numWellEq;
+        Scalar* Bx = group.z.data() + 2 * w * numWellEq;
+        Scalar* z = Bx + numWellEq;
+
+        std::fill(Bx, Bx + numWellEq, 0.0);
+        for (int perf = 0; perf < numPerfs; ++perf) {
+            const auto& xc = x[cells[perf]];
+            const Scalar* block = B + perf * blockSize;
+            for (int i = 0; i < numWellEq; ++i) {
+                Scalar sum = 0.0;
+                for (int j = 0; j < numEq; ++j) {
+                    sum += block[i * numEq + j] * xc[j];
+                }
+                Bx[i] += sum;
+            }
+        }
+        for (int i = 0; i < numWellEq; ++i) {
+            Scalar sum = 0.0;
+            for (int k = 0; k < numWellEq; ++k) {
+                sum += invD[i * numWellEq + k] * Bx[k];
+            }
+            z[i] = sum;
+        }
+    }
+
+    // y -= C^T z for well w
+    static void scatter(const Group& group, const int w, BVector& y)
+    {
+        const int numPerfs = group.numPerfs;
+        const int numWellEq = group.numWellEq;
+        const std::size_t blockSize = numWellEq * numEq;
+        const int* cells = group.cells.data() + w * numPerfs;
+        const Scalar* C = group.C.data() + w * numPerfs * blockSize;
+        const Scalar* z = group.z.data() + 2 * w * numWellEq + numWellEq;
+
+        for (int perf = 0; perf < numPerfs; ++perf) {
+            auto& yc = y[cells[perf]];
+            const Scalar* block = C + perf * blockSize;
+            for (int j = 0; j < numEq; ++j) {
+                Scalar sum = 0.0;
+                for (int i = 0; i < numWellEq; ++i) {
+                    sum += block[i * numEq + j] * z[i];
+                }
+                yc[j] -= sum;
+            }
+        }
+    }
+
+    void applyGroup(const Group& group, const BVector& x, BVector& y) const
+    {
+        const int numWells = group.numWells;
+        if (cellsDisjoint_) {
+#ifdef _OPENMP
+#pragma omp parallel for if(numWells > 2 * minWellsPerThread)
+#endif
+            for (int w = 0; w < numWells; ++w) {
+                computeZ(group, w, x);
+                scatter(group, w, y);
+            }
+        } else {
+            // some wells share a cell, only the products with B and D^-1 are done concurrently
+#ifdef _OPENMP
+#pragma omp parallel for if(numWells > 2 * minWellsPerThread)
+#endif
+            for (int w = 0; w < numWells; ++w) {
+                computeZ(group, w, x);
+            }
+            for (int w = 0; w < numWells; ++w) {
+                scatter(group, w, y);
+            }
+        }
+    }
+
+    std::vector<Group> groups_;
+    std::map<std::pair<int, int>, std::size_t> groupIndex_; // (numPerfs, numWellEq) -> index in groups_
+    int numWells_ = 0;
+    bool cellsDisjoint_ = true;
+    bool finalized_ = false;
+};
+
+} // namespace Opm
+
+#endif // OPM_STANDARDWELLBATCH_HEADER_INCLUDED
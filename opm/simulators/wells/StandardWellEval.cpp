@@ -244,6 +244,39 @@ wellSurfaceVolumeFraction(const int compIdx) const
     return wellVolumeFractionScaled(compIdx) / sum_volume_fraction_scaled;
  }
 
+template<class FluidSystem, class Indices, class Scalar>
+std::vector<typename StandardWellEval<FluidSystem,Indices,Scalar>::EvalWell>
+StandardWellEval<FluidSystem,Indices,Scalar>::
+wellSurfaceVolumeFractionsEval() const
+{
+    std::vector<EvalWell> fractions(baseif_.numComponents(), EvalWell{numWellEq_ + Indices::numEq, 0.});
+    EvalWell sum_volume_fraction_scaled(numWellEq_ + Indices::numEq, 0.);
+    for (int idx = 0; idx < baseif_.numComponents(); ++idx) {
+        fractions[idx] = wellVolumeFractionScaled(idx);
+        sum_volume_fraction_scaled += fractions[idx];
+    }
+
+    assert(sum_volume_fraction_scaled.value() != 0.);
+
+    for (auto& fraction : fractions) {
+        fraction /= sum_volume_fraction_scaled;
+    }
+    return fractions;
+}
+
+template<class FluidSystem, class Indices, class Scalar>
+std::vector<Scalar>
+StandardWellEval<FluidSystem,Indices,Scalar>::
+wellSurfaceVolumeFractionsScalar() const
+{
+    const auto fractions = wellSurfaceVolumeFractionsEval();
+    std::vector<Scalar> values(fractions.size());
+    for (std::size_t idx = 0; idx < fractions.size(); ++idx) {
+        values[idx] = fractions[idx].value();
+    }
+    return values;
+}
+
 template<class FluidSystem, class Indices, class Scalar>
 void
 StandardWellEval<FluidSystem,Indices,Scalar>::
@@ -997,6 +1030,8 @@ init(std::vector<double>& perf_depth,
         }
     }
 
+    assert(has_dynamic_well_eq || numWellEq_ == numStaticWellEq);
+
     // with the updated numWellEq_, we can initialize the primary variables and matrices now
     primary_variables_.resize(numWellEq_, 0.0);
     primary_variables_evaluation_.resize(numWellEq_, EvalWell{numWellEq_ + Indices::numEq, 0.0});
@@ -1064,51 +1099,73 @@ void
 StandardWellEval<FluidSystem,Indices,Scalar>::
 addWellContribution(WellContributions& wellContribs) const
 {
-    std::vector<int> colIndices;
-    std::vector<double> nnzValues;
-    colIndices.reserve(this->duneB_.nonzeroes());
-    nnzValues.reserve(this->duneB_.nonzeroes()*numStaticWellEq * Indices::numEq);
+    // C and B share the sparsity pattern, the blocks are written directly into the arena of wellContribs
+    assert(this->duneC_.nonzeroes() == this->duneB_.nonzeroes());
+    auto storage = wellContribs.getStandardWellStorage(this->duneB_.nonzeroes());
 
     // duneC
     for ( auto colC = this->duneC_[0].begin(), endC = this->duneC_[0].end(); colC != endC; ++colC )
     {
-        colIndices.emplace_back(colC.index());
+        *storage.Ccols++ = colC.index();
         for (int i = 0; i < numStaticWellEq; ++i) {
             for (int j = 0; j < Indices::numEq; ++j) {
-                nnzValues.emplace_back((*colC)[i][j]);
+                *storage.Cnnzs++ = (*colC)[i][j];
             }
         }
     }
-    wellContribs.addMatrix(WellContributions::MatrixType::C, colIndices.data(), nnzValues.data(), this->duneC_.nonzeroes());
 
     // invDuneD
-    colIndices.clear();
-    nnzValues.clear();
-    colIndices.emplace_back(0);
     for (int i = 0; i < numStaticWellEq; ++i)
     {
         for (int j = 0; j < numStaticWellEq; ++j) {
-            nnzValues.emplace_back(this->invDuneD_[0][0][i][j]);
+            *storage.Dnnzs++ = this->invDuneD_[0][0][i][j];
         }
     }
-    wellContribs.addMatrix(WellContributions::MatrixType::D, colIndices.data(), nnzValues.data(), 1);
 
     // duneB
-    colIndices.clear();
-    nnzValues.clear();
     for ( auto colB = this->duneB_[0].begin(), endB = this->duneB_[0].end(); colB != endB; ++colB )
     {
-        colIndices.emplace_back(colB.index());
+        *storage.Bcols++ = colB.index();
         for (int i = 0; i < numStaticWellEq; ++i) {
             for (int j = 0; j < Indices::numEq; ++j) {
-                nnzValues.emplace_back((*colB)[i][j]);
+                *storage.Bnnzs++ = (*colB)[i][j];
             }
         }
     }
-    wellContribs.addMatrix(WellContributions::MatrixType::B, colIndices.data(), nnzValues.data(), this->duneB_.nonzeroes());
 }
 #endif
 
+template<class FluidSystem, class Indices, class Scalar>
+void
+StandardWellEval<FluidSystem,Indices,Scalar>::
+addToBatch(StandardWellBatch<Scalar, Indices::numEq>& batch) const
+{
+    // C and B share the sparsity pattern, the cells are taken from B
+    assert(this->duneC_[0].size() == this->duneB_[0].size());
+    auto storage = batch.addWell(this->duneB_[0].size(), numWellEq_);
+
+    for (auto colB = this->duneB_[0].begin(), endB = this->duneB_[0].end(); colB != endB; ++colB) {
+        *storage.cells++ = colB.index();
+        for (int i = 0; i < numWellEq_; ++i) {
+            for (int j = 0; j < Indices::numEq; ++j) {
+                *storage.B++ = (*colB)[i][j];
+            }
+        }
+    }
+    for (auto colC = this->duneC_[0].begin(), endC = this->duneC_[0].end(); colC != endC; ++colC) {
+        for (int i = 0; i < numWellEq_; ++i) {
+            for (int j = 0; j < Indices::numEq; ++j) {
+                *storage.C++ = (*colC)[i][j];
+            }
+        }
+    }
+    for (int i = 0; i < numWellEq_; ++i) {
+        for (int j = 0; j < numWellEq_; ++j) {
+            *storage.invD++ = this->invDuneD_[0][0][i][j];
+        }
+    }
+}
+
 #define INSTANCE(A,...) \
 template class StandardWellEval<BlackOilFluidSystem<double,A>,__VA_ARGS__,double>;
 
@@ -23,11 +23,14 @@
 #ifndef OPM_STANDARDWELL_EVAL_HEADER_INCLUDED
 #define OPM_STANDARDWELL_EVAL_HEADER_INCLUDED
 
+#include <opm/simulators/wells/StandardWellBatch.hpp>
 #include <opm/simulators/wells/StandardWellGeneric.hpp>
 
 #include <opm/material/densead/DynamicEvaluation.hpp>
+#include <opm/material/densead/Evaluation.hpp>
 
 #include <optional>
+#include <type_traits>
 #include <vector>
 
 namespace Opm
@@ -91,8 +94,17 @@ protected:
     static constexpr int GFrac = has_gfrac_variable ? has_wfrac_variable + 1 : -1000;
     static constexpr int SFrac = !Indices::enableSolvent ? -1000 : 3;
 
+    // Only the polymer molecular weight adds well equations, two per
+    // perforation of an injector. Without it the number of well equations
+    // is known at compile time and the fixed size evaluations are used,
+    // which avoids the run time sized derivative loops in the
+    // perforation rates.
+    static constexpr bool has_dynamic_well_eq = Indices::polymerMoleWeightIdx >= 0;
+
 public:
-    using EvalWell = DenseAd::DynamicEvaluation<Scalar, numStaticWellEq + Indices::numEq + 1>;
+    using EvalWell = std::conditional_t<has_dynamic_well_eq,
+                                        DenseAd::DynamicEvaluation<Scalar, numStaticWellEq + Indices::numEq + 1>,
+                                        DenseAd::Evaluation<Scalar, numStaticWellEq + Indices::numEq>>;
     using Eval = DenseAd::Evaluation<Scalar, Indices::numEq>;
     using BVectorWell = typename StandardWellGeneric<Scalar>::BVectorWell;
 
@@ -101,6 +113,9 @@ public:
         void addWellContribution(WellContributions& wellContribs) const;
 #endif
 
+    /// add the C, D^-1 and B matrices of this Well to the batched apply
+    void addToBatch(StandardWellBatch<Scalar, Indices::numEq>& batch) const;
+
 protected:
     StandardWellEval(const WellInterfaceIndices<FluidSystem,Indices,Scalar>& baseif);
 
@@ -121,6 +136,9 @@ protected:
     EvalWell extendEval(const Eval& in) const;
     EvalWell getQs(const int compIdx) const;
     EvalWell wellSurfaceVolumeFraction(const int compIdx) const;
+    // the surface volume fractions of all components at once, the same for all perforations
+    std::vector<EvalWell> wellSurfaceVolumeFractionsEval() const;
+    std::vector<Scalar> wellSurfaceVolumeFractionsScalar() const;
     EvalWell wellVolumeFraction(const unsigned compIdx) const;
     EvalWell wellVolumeFractionScaled(const int phase) const;
 
@@ -181,7 +199,8 @@ protected:
                    DeferredLogger& deferred_logger) const;
 
     // total number of the well equations and primary variables
-    // there might be extra equations be used, numWellEq will be updated during the initialization
+    // there might be extra equations be used, numWellEq will be updated during the initialization,
+    // which is only possible if has_dynamic_well_eq
     int numWellEq_ = numStaticWellEq;
 
     // the values for the primary varibles
@@ -22,8 +22,6 @@
 #include <config.h>
 #include <opm/simulators/wells/StandardWellGeneric.hpp>
 
-#include <opm/common/utility/numeric/RootFinders.hpp>
-
 #include <opm/core/props/BlackoilPhases.hpp>
 
 #include <opm/input/eclipse/Schedule/GasLiftOpt.hpp>
@@ -177,10 +175,13 @@ computeConnectionPressureDelta()
 
     const int nperf = baseif_.numPerfs();
     perf_pressure_diffs_.resize(nperf, 0.0);
-    auto z_above = baseif_.parallelWellInfo().communicateAboveValues(baseif_.refDepth(), baseif_.perfDepth());
+    if (!perf_depth_above_communicated_) {
+        perf_depth_above_ = baseif_.parallelWellInfo().communicateAboveValues(baseif_.refDepth(), baseif_.perfDepth());
+        perf_depth_above_communicated_ = true;
+    }
 
     for (int perf = 0; perf < nperf; ++perf) {
-        const double dz = baseif_.perfDepth()[perf] - z_above[perf];
+        const double dz = baseif_.perfDepth()[perf] - perf_depth_above_[perf];
         perf_pressure_diffs_[perf] = dz * perf_densities_[perf] * baseif_.gravity();
     }
 
@@ -200,6 +201,17 @@ computeBhpAtThpLimitProdWithAlq(const std::function<std::vector<double>(const do
                                 const SummaryState& summary_state,
                                 DeferredLogger& deferred_logger,
                                 double alq_value) const
+{
+    return computeBhpAtThpLimitProdWithAlqs(frates, summary_state, deferred_logger, {alq_value}).front();
+}
+
+template<class Scalar>
+std::vector<std::optional<double>>
+StandardWellGeneric<Scalar>::
+computeBhpAtThpLimitProdWithAlqs(const std::function<std::vector<double>(const double)>& frates,
+                                 const SummaryState& summary_state,
+                                 DeferredLogger& deferred_logger,
+                                 const std::vector<double>& alq_values) const
 {
     // Given a VFP function returning bhp as a function of phase
     // rates and thp:
@@ -239,21 +251,29 @@ computeBhpAtThpLimitProdWithAlq(const std::function<std::vector<double>(const do
     // the 0, 1 or 2 solution cases, and obtain the right interval
     // in which to solve for the solution we want (with highest
     // flow in case of 2 solutions).
+    //
+    // The inverse inflow samples do not depend on the ALQ, so when
+    // several ALQ values are given they are computed once and only
+    // the fbhp samples and the final solve are repeated per value.
 
     static constexpr int Water = BlackoilPhases::Aqua;
     static constexpr int Oil = BlackoilPhases::Liquid;
     static constexpr int Gas = BlackoilPhases::Vapour;
 
+    if (alq_values.empty()) {
+        return {};
+    }
+
     // Make the fbhp() function.
     const auto& controls = baseif_.wellEcl().productionControls(summary_state);
     const auto& table = baseif_.vfpProperties()->getProd()->getTable(controls.vfp_table_number);
     const double vfp_ref_depth = table.getDatumDepth();
     const double thp_limit = baseif_.getTHPConstraint(summary_state);
     const double dp = wellhelpers::computeHydrostaticCorrection(baseif_.refDepth(), vfp_ref_depth, getRho(), baseif_.gravity());
-    auto fbhp = [this, &controls, thp_limit, dp, alq_value](const std::vector<double>& rates) {
+    auto fbhp = [this, &controls, thp_limit, dp](const std::vector<double>& rates, const double alq_value) {
         assert(rates.size() == 3);
         return baseif_.vfpProperties()->getProd()
-        ->bhp(controls.vfp_table_number, rates[Water], rates[Oil], rates[Gas], thp_limit, alq_value) - dp;
+        ->bhp(controls.vfp_table_number, rates[Water], rates[Oil], rates[Gas], thp_limit, alq_value, baseif_.vfpProdCache()) - dp;
     };
 
     // Make the flo() function.
@@ -279,6 +299,13 @@ computeBhpAtThpLimitProdWithAlq(const std::function<std::vector<double>(const do
     }
 
     // Find bhp values for inflow relation corresponding to flo samples.
+    // All samples are solved in the same bracket, so the inflow at its
+    // end points is only evaluated once.
+    // TODO: replace hardcoded low/high limits.
+    const double sample_low = 10.0 * unit::barsa;
+    const double sample_high = 600.0 * unit::barsa;
+    const double flo_low = flo(frates(sample_low));
+    const double flo_high = flo(frates(sample_high));
     std::vector<double> bhp_samples;
     for (double flo_sample : flo_samples) {
         if (flo_sample < -flo_bhp_limit) {
@@ -293,30 +320,55 @@ computeBhpAtThpLimitProdWithAlq(const std::function<std::vector<double>(const do
         auto eq = [&flo, &frates, flo_sample](double bhp) {
             return flo(frates(bhp)) - flo_sample;
         };
-        // TODO: replace hardcoded low/high limits.
-        const double low = 10.0 * unit::barsa;
-        const double high = 600.0 * unit::barsa;
         const int max_iteration = 50;
         const double flo_tolerance = 1e-6 * std::fabs(flo_samples.back());
-        int iteration = 0;
-        try {
-            const double solved_bhp = RegulaFalsiBisection<>::
-                solve(eq, low, high, max_iteration, flo_tolerance, iteration);
-            bhp_samples.push_back(solved_bhp);
+        const auto solved_bhp = wellhelpers::bracketedNewton(eq, sample_low, sample_high,
+                                                             flo_low - flo_sample, flo_high - flo_sample,
+                                                             std::nullopt, flo_tolerance, max_iteration);
+        if (solved_bhp.has_value()) {
+            bhp_samples.push_back(*solved_bhp);
         }
-        catch (...) {
+        else {
             // Use previous value (or max value if at start) if we failed.
-            bhp_samples.push_back(bhp_samples.empty() ? high : bhp_samples.back());
+            bhp_samples.push_back(bhp_samples.empty() ? sample_high : bhp_samples.back());
             deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE_EXTRACT_SAMPLES",
                                     "Robust bhp(thp) solve failed extracting bhp values at flo samples for well " + baseif_.name());
         }
     }
 
-    // Find bhp values for VFP relation corresponding to flo samples.
+    // The inflow rates at the samples are shared by all ALQ values.
     const int num_samples = bhp_samples.size(); // Note that this can be smaller than flo_samples.size()
+    std::vector<std::vector<double>> rate_samples(num_samples);
+    for (int ii = 0; ii < num_samples; ++ii) {
+        rate_samples[ii] = frates(bhp_samples[ii]);
+    }
+
+    std::vector<std::optional<double>> solutions;
+    solutions.reserve(alq_values.size());
+    for (const double alq_value : alq_values) {
+        solutions.push_back(solveBhpAtThpLimitProd_(frates, fbhp, flo_samples, bhp_samples, rate_samples,
+                                                    controls.bhp_limit, alq_value, deferred_logger));
+    }
+    return solutions;
+}
+
+template<class Scalar>
+std::optional<double>
+StandardWellGeneric<Scalar>::
+solveBhpAtThpLimitProd_(const std::function<std::vector<double>(const double)>& frates,
+                        const std::function<double(const std::vector<double>&, const double)>& fbhp,
+                        [[maybe_unused]] const std::vector<double>& flo_samples,
+                        const std::vector<double>& bhp_samples,
+                        const std::vector<std::vector<double>>& rate_samples,
+                        [[maybe_unused]] const double bhp_limit,
+                        const double alq_value,
+                        DeferredLogger& deferred_logger) const
+{
+    // Find bhp values for VFP relation corresponding to flo samples.
+    const int num_samples = bhp_samples.size();
     std::vector<double> fbhp_samples(num_samples);
     for (int ii = 0; ii < num_samples; ++ii) {
-        fbhp_samples[ii] = fbhp(frates(bhp_samples[ii]));
+        fbhp_samples[ii] = fbhp(rate_samples[ii], alq_value);
     }
 // #define EXTRA_THP_DEBUGGING
 #ifdef EXTRA_THP_DEBUGGING
@@ -354,37 +406,40 @@ computeBhpAtThpLimitProdWithAlq(const std::function<std::vector<double>(const do
     }
 
     // Solve for the proper solution in the given interval.
-    auto eq = [&fbhp, &frates](double bhp) {
-        return fbhp(frates(bhp)) - bhp;
+    auto eq = [&fbhp, &frates, alq_value](double bhp) {
+        return fbhp(frates(bhp), alq_value) - bhp;
     };
     // TODO: replace hardcoded low/high limits.
     const double low = bhp_samples[sign_change_index + 1];
     const double high = bhp_samples[sign_change_index];
     const int max_iteration = 50;
     const double bhp_tolerance = 0.01 * unit::barsa;
-    int iteration = 0;
     if (low == high) {
         // We are in the high flow regime where the bhp_samples
         // are all equal to the bhp_limit.
-        assert(low == controls.bhp_limit);
+        assert(low == bhp_limit);
         deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE",
                                 "Robust bhp(thp) solve failed for well " + baseif_.name());
         return std::nullopt;
     }
-    try {
-        const double solved_bhp = RegulaFalsiBisection<>::
-            solve(eq, low, high, max_iteration, bhp_tolerance, iteration);
-#ifdef EXTRA_THP_DEBUGGING
-        OpmLog::debug("*****    " + name() + "    solved_bhp = " + std::to_string(solved_bhp)
-                      + "    flo_bhp_limit = " + std::to_string(flo_bhp_limit));
-#endif // EXTRA_THP_DEBUGGING
-        return solved_bhp;
-    }
-    catch (...) {
+    // The residuals at the samples bracketing the solution are known, and the
+    // solution of the previous solve is the initial guess.
+    const double eq_low = fbhp_samples[sign_change_index + 1] - low;
+    const double eq_high = fbhp_samples[sign_change_index] - high;
+    const auto solved_bhp = wellhelpers::bracketedNewton(eq, low, high, eq_low, eq_high,
+                                                         baseif_.bhpAtThpLimitGuess(),
+                                                         bhp_tolerance, max_iteration);
+    if (!solved_bhp.has_value()) {
         deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE",
                                 "Robust bhp(thp) solve failed for well " + baseif_.name());
         return std::nullopt;
     }
+#ifdef EXTRA_THP_DEBUGGING
+    OpmLog::debug("*****    " + baseif_.name() + "    solved_bhp = " + std::to_string(*solved_bhp)
+                  + "    alq = " + std::to_string(alq_value));
+#endif // EXTRA_THP_DEBUGGING
+    baseif_.bhpAtThpLimitGuess() = solved_bhp;
+    return solved_bhp;
 }
 
 template<class Scalar>
@@ -467,6 +522,13 @@ computeBhpAtThpLimitInj(const std::function<std::vector<double>(const double)>&
     }
 
     // Find bhp values for inflow relation corresponding to flo samples.
+    // All samples are solved in the same bracket, so the inflow at its
+    // end points is only evaluated once.
+    // TODO: replace hardcoded low/high limits.
+    const double sample_low = 10.0 * unit::barsa;
+    const double sample_high = 800.0 * unit::barsa;
+    const double flo_low = flo(frates(sample_low));
+    const double flo_high = flo(frates(sample_high));
     std::vector<double> bhp_samples;
     for (double flo_sample : flo_samples) {
         if (flo_sample > flo_bhp_limit) {
@@ -481,20 +543,17 @@ computeBhpAtThpLimitInj(const std::function<std::vector<double>(const double)>&
         auto eq = [&flo, &frates, flo_sample](double bhp) {
             return flo(frates(bhp)) - flo_sample;
         };
-        // TODO: replace hardcoded low/high limits.
-        const double low = 10.0 * unit::barsa;
-        const double high = 800.0 * unit::barsa;
         const int max_iteration = 50;
         const double flo_tolerance = 1e-6 * std::fabs(flo_samples.back());
-        int iteration = 0;
-        try {
-            const double solved_bhp = RegulaFalsiBisection<>::
-                    solve(eq, low, high, max_iteration, flo_tolerance, iteration);
-            bhp_samples.push_back(solved_bhp);
+        const auto solved_bhp = wellhelpers::bracketedNewton(eq, sample_low, sample_high,
+                                                             flo_low - flo_sample, flo_high - flo_sample,
+                                                             std::nullopt, flo_tolerance, max_iteration);
+        if (solved_bhp.has_value()) {
+            bhp_samples.push_back(*solved_bhp);
         }
-        catch (...) {
+        else {
             // Use previous value (or max value if at start) if we failed.
-            bhp_samples.push_back(bhp_samples.empty() ? low : bhp_samples.back());
+            bhp_samples.push_back(bhp_samples.empty() ? sample_low : bhp_samples.back());
             deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE_EXTRACT_SAMPLES",
                                     "Robust bhp(thp) solve failed extracting bhp values at flo samples for well " + baseif_.name());
         }
@@ -550,7 +609,6 @@ computeBhpAtThpLimitInj(const std::function<std::vector<double>(const double)>&
     const double high = bhp_samples[sign_change_index];
     const int max_iteration = 50;
     const double bhp_tolerance = 0.01 * unit::barsa;
-    int iteration = 0;
     if (low == high) {
         // We are in the high flow regime where the bhp_samples
         // are all equal to the bhp_limit.
@@ -559,20 +617,24 @@ computeBhpAtThpLimitInj(const std::function<std::vector<double>(const double)>&
                                 "Robust bhp(thp) solve failed for well " + baseif_.name());
         return std::nullopt;
     }
-    try {
-        const double solved_bhp = RegulaFalsiBisection<>::
-                solve(eq, low, high, max_iteration, bhp_tolerance, iteration);
-#ifdef EXTRA_THP_DEBUGGING
-        OpmLog::debug("*****    " + name() + "    solved_bhp = " + std::to_string(solved_bhp)
-                      + "    flo_bhp_limit = " + std::to_string(flo_bhp_limit));
-#endif // EXTRA_THP_DEBUGGING
-        return solved_bhp;
-    }
-    catch (...) {
+    // The residuals at the samples bracketing the solution are known, and the
+    // solution of the previous solve is the initial guess.
+    const double eq_low = fbhp_samples[sign_change_index + 1] - low;
+    const double eq_high = fbhp_samples[sign_change_index] - high;
+    const auto solved_bhp = wellhelpers::bracketedNewton(eq, low, high, eq_low, eq_high,
+                                                         baseif_.bhpAtThpLimitGuess(),
+                                                         bhp_tolerance, max_iteration);
+    if (!solved_bhp.has_value()) {
         deferred_logger.warning("FAILED_ROBUST_BHP_THP_SOLVE",
                                 "Robust bhp(thp) solve failed for well " + baseif_.name());
         return std::nullopt;
     }
+#ifdef EXTRA_THP_DEBUGGING
+    OpmLog::debug("*****    " + name() + "    solved_bhp = " + std::to_string(*solved_bhp)
+                  + "    flo_bhp_limit = " + std::to_string(flo_bhp_limit));
+#endif // EXTRA_THP_DEBUGGING
+    baseif_.bhpAtThpLimitGuess() = solved_bhp;
+    return solved_bhp;
 }
 
 template<class Scalar>
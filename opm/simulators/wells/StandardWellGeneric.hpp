@@ -106,6 +106,13 @@ protected:
                                                           const SummaryState& summary_state,
                                                           DeferredLogger& deferred_logger,
                                                           double alq_value) const;
+    // The same as computeBhpAtThpLimitProdWithAlq() for several ALQ values,
+    // the inflow samples are shared by all values
+    std::vector<std::optional<double>>
+    computeBhpAtThpLimitProdWithAlqs(const std::function<std::vector<double>(const double)>& frates,
+                                     const SummaryState& summary_state,
+                                     DeferredLogger& deferred_logger,
+                                     const std::vector<double>& alq_values) const;
 
     // Base interface reference
     const WellInterfaceGeneric& baseif_;
@@ -117,6 +124,10 @@ protected:
     std::vector<double> perf_densities_;
     // pressure drop between different perforations
     std::vector<double> perf_pressure_diffs_;
+    // depth of the perforation above each perforation, the reference depth
+    // for the first one. Communicated once, as the depths do not change.
+    std::vector<double> perf_depth_above_;
+    bool perf_depth_above_communicated_ = false;
 
     // two off-diagonal matrices
     OffDiagMatWell duneB_;
@@ -134,6 +145,16 @@ protected:
     double getRho() const { return perf_densities_[0]; }
 
 private:
+    // Solve for the bhp at the thp limit for one ALQ value from the inflow samples
+    std::optional<double> solveBhpAtThpLimitProd_(const std::function<std::vector<double>(const double)>& frates,
+                                                  const std::function<double(const std::vector<double>&, const double)>& fbhp,
+                                                  const std::vector<double>& flo_samples,
+                                                  const std::vector<double>& bhp_samples,
+                                                  const std::vector<std::vector<double>>& rate_samples,
+                                                  const double bhp_limit,
+                                                  const double alq_value,
+                                                  DeferredLogger& deferred_logger) const;
+
     int Bhp_; // index of Bhp
 };
 
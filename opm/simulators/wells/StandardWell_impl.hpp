@@ -27,7 +27,6 @@
 
 #include <algorithm>
 #include <functional>
-#include <numeric>
 
 namespace Opm
 {
@@ -91,6 +90,7 @@ namespace Opm
                         const double Tw,
                         const int perf,
                         const bool allow_cf,
+                        const std::vector<EvalWell>& cmix_s,
                         std::vector<EvalWell>& cq_s,
                         double& perf_dis_gas_rate,
                         double& perf_vap_oil_rate,
@@ -100,7 +100,8 @@ namespace Opm
         const EvalWell pressure = this->extendEval(this->getPerfCellPressure(fs));
         const EvalWell rs = this->extendEval(fs.Rs());
         const EvalWell rv = this->extendEval(fs.Rv());
-        std::vector<EvalWell> b_perfcells_dense(this->num_components_, EvalWell{this->numWellEq_ + Indices::numEq, 0.0});
+        auto& b_perfcells_dense = this->scratch_.b_perfcells;
+        b_perfcells_dense.assign(this->num_components_, EvalWell{this->numWellEq_ + Indices::numEq, 0.0});
         for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
             if (!FluidSystem::phaseIsActive(phaseIdx)) {
                 continue;
@@ -128,12 +129,6 @@ namespace Opm
             }
         }
 
-        // surface volume fraction of fluids within wellbore
-        std::vector<EvalWell> cmix_s(this->numComponents(), EvalWell{this->numWellEq_ + Indices::numEq});
-        for (int componentIdx = 0; componentIdx < this->numComponents(); ++componentIdx) {
-            cmix_s[componentIdx] = this->wellSurfaceVolumeFraction(componentIdx);
-        }
-
         computePerfRate(mob,
                         pressure,
                         bhp,
@@ -160,6 +155,7 @@ namespace Opm
                           const double Tw,
                           const int perf,
                           const bool allow_cf,
+                          const std::vector<Scalar>& cmix_s,
                           std::vector<Scalar>& cq_s,
                           DeferredLogger& deferred_logger) const
     {
@@ -198,12 +194,6 @@ namespace Opm
         Scalar perf_dis_gas_rate = 0.0;
         Scalar perf_vap_oil_rate = 0.0;
 
-        // surface volume fraction of fluids within wellbore
-        std::vector<Scalar> cmix_s(this->numComponents(), 0.0);
-        for (int componentIdx = 0; componentIdx < this->numComponents(); ++componentIdx) {
-            cmix_s[componentIdx] = getValue(this->wellSurfaceVolumeFraction(componentIdx));
-        }
-
         computePerfRate(mob,
                         pressure,
                         bhp,
@@ -412,15 +402,21 @@ namespace Opm
 
         const int np = this->number_of_phases_;
 
-        std::vector<RateVector> connectionRates = this->connectionRates_; // Copy to get right size.
+        auto& connectionRates = this->scratch_.connectionRates;
+        connectionRates = this->connectionRates_; // Copy to get right size.
         auto& perf_data = ws.perf_data;
         auto& perf_rates = perf_data.phase_rates;
+        // The cross flow check and the wellbore mixture are the same for all perforations.
+        const bool allow_cf = this->getAllowCrossFlow() || openCrossFlowAvoidSingularity(ebosSimulator);
+        const std::vector<EvalWell> cmix_s = this->wellSurfaceVolumeFractionsEval();
         for (int perf = 0; perf < this->number_of_perforations_; ++perf) {
             // Calculate perforation quantities.
-            std::vector<EvalWell> cq_s(this->num_components_, {this->numWellEq_ + Indices::numEq, 0.0});
+            auto& cq_s = this->scratch_.cq_s;
+            cq_s.assign(this->num_components_, {this->numWellEq_ + Indices::numEq, 0.0});
             EvalWell water_flux_s{this->numWellEq_ + Indices::numEq, 0.0};
             EvalWell cq_s_zfrac_effective{this->numWellEq_ + Indices::numEq, 0.0};
-            calculateSinglePerf(ebosSimulator, perf, well_state, connectionRates, cq_s, water_flux_s, cq_s_zfrac_effective, deferred_logger);
+            calculateSinglePerf(ebosSimulator, perf, allow_cf, cmix_s, well_state, connectionRates,
+                                cq_s, water_flux_s, cq_s_zfrac_effective, deferred_logger);
 
             // Equation assembly for this perforation.
             if constexpr (has_polymer && Base::has_polymermw) {
@@ -485,7 +481,7 @@ namespace Opm
             EvalWell resWell_loc(this->numWellEq_ + Indices::numEq, 0.0);
             if (FluidSystem::numActivePhases() > 1) {
                 assert(dt > 0);
-                resWell_loc += (this->wellSurfaceVolumeFraction(componentIdx) - this->F0_[componentIdx]) * volume / dt;
+                resWell_loc += (cmix_s[componentIdx] - this->F0_[componentIdx]) * volume / dt;
             }
             resWell_loc -= this->getQs(componentIdx) * this->well_efficiency_factor_;
             for (int pvIdx = 0; pvIdx < this->numWellEq_; ++pvIdx) {
@@ -515,6 +511,8 @@ namespace Opm
     StandardWell<TypeTag>::
     calculateSinglePerf(const Simulator& ebosSimulator,
                         const int perf,
+                        const bool allow_cf,
+                        const std::vector<EvalWell>& cmix_s,
                         WellState& well_state,
                         std::vector<RateVector>& connectionRates,
                         std::vector<EvalWell>& cq_s,
@@ -522,18 +520,18 @@ namespace Opm
                         EvalWell& cq_s_zfrac_effective,
                         DeferredLogger& deferred_logger) const
     {
-        const bool allow_cf = this->getAllowCrossFlow() || openCrossFlowAvoidSingularity(ebosSimulator);
         const EvalWell& bhp = this->getBhp();
         const int cell_idx = this->well_cells_[perf];
         const auto& intQuants = *(ebosSimulator.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/ 0));
-        std::vector<EvalWell> mob(this->num_components_, {this->numWellEq_ + Indices::numEq, 0.});
+        auto& mob = this->scratch_.mob;
+        mob.assign(this->num_components_, {this->numWellEq_ + Indices::numEq, 0.});
         getMobilityEval(ebosSimulator, perf, mob, deferred_logger);
 
         double perf_dis_gas_rate = 0.;
         double perf_vap_oil_rate = 0.;
         double trans_mult = ebosSimulator.problem().template rockCompTransMultiplier<double>(intQuants,  cell_idx);
         const double Tw = this->well_index_[perf] * trans_mult;
-        computePerfRateEval(intQuants, mob, bhp, Tw, perf, allow_cf,
+        computePerfRateEval(intQuants, mob, bhp, Tw, perf, allow_cf, cmix_s,
                             cq_s, perf_dis_gas_rate, perf_vap_oil_rate, deferred_logger);
 
         auto& ws = well_state.well(this->index_of_well_);
@@ -1395,6 +1393,17 @@ namespace Opm
         const auto preferred_phase = this->well_ecl_.getPreferredPhase();
         auto subsetPerfID = 0;
 
+        // Only the values of the mobilities are needed. Without polymer they are
+        // computed without derivatives, the water mobility of the polymer model
+        // is only available through the evaluation.
+        std::vector<EvalWell> mob_eval;
+        std::vector<Scalar> mob_scalar;
+        if constexpr (has_polymer) {
+            mob_eval.assign(this->num_components_, {this->numWellEq_ + Indices::numEq, 0.0});
+        } else {
+            mob_scalar.assign(this->num_components_, 0.0);
+        }
+
         for (const auto& perf : *this->perf_data_) {
             auto allPerfID = perf.ecl_index;
 
@@ -1403,18 +1412,25 @@ namespace Opm
                 return wellPICalc.connectionProdIndStandard(allPerfID, mobility);
             };
 
-            std::vector<EvalWell> mob(this->num_components_, {this->numWellEq_ + Indices::numEq, 0.0});
-            getMobilityEval(ebosSimulator, static_cast<int>(subsetPerfID), mob, deferred_logger);
-
             const auto& fs = fluidState(subsetPerfID);
             setToZero(connPI);
 
-            if (this->isInjector()) {
-                this->computeConnLevelInjInd(fs, preferred_phase, connPICalc,
-                                             mob, connPI, deferred_logger);
-            }
-            else {  // Production or zero flow rate
-                this->computeConnLevelProdInd(fs, connPICalc, mob, connPI);
+            auto computeConnPI = [&](const auto& mob)
+            {
+                if (this->isInjector()) {
+                    this->computeConnLevelInjInd(fs, preferred_phase, connPICalc,
+                                                 mob, connPI, deferred_logger);
+                }
+                else {  // Production or zero flow rate
+                    this->computeConnLevelProdInd(fs, connPICalc, mob, connPI);
+                }
+            };
+            if constexpr (has_polymer) {
+                getMobilityEval(ebosSimulator, static_cast<int>(subsetPerfID), mob_eval, deferred_logger);
+                computeConnPI(mob_eval);
+            } else {
+                getMobilityScalar(ebosSimulator, static_cast<int>(subsetPerfID), mob_scalar, deferred_logger);
+                computeConnPI(mob_scalar);
             }
 
             addVector(connPI, wellPI);
@@ -1537,7 +1553,8 @@ namespace Opm
 
         // We assemble the well equations, then we check the convergence,
         // which is why we do not put the assembleWellEq here.
-        BVectorWell dx_well(1);
+        auto& dx_well = this->scratch_.dx_well;
+        dx_well.resize(1);
         dx_well[0].resize(this->numWellEq_);
         this->invDuneD_.mv(this->resWell_, dx_well);
 
@@ -1594,6 +1611,25 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    bool
+    StandardWell<TypeTag>::
+    addToBatch(StandardWellBatch<Scalar, Indices::numEq>& batch) const
+    {
+        // same conditions as apply(x, Ax), these wells do not contribute
+        if (!this->isOperableAndSolvable() && !this->wellIsStopped()) return true;
+        if (this->param_.matrix_add_well_contributions_) return true;
+
+        // the product with B of distributed wells needs communication
+        if (this->parallel_well_info_.communication().size() > 1) return false;
+
+        StdWellEval::addToBatch(batch);
+        return true;
+    }
+
+
+
+
     template<typename TypeTag>
     void
     StandardWell<TypeTag>::
@@ -1616,7 +1652,8 @@ namespace Opm
     {
         if (!this->isOperableAndSolvable() && !this->wellIsStopped()) return;
 
-        BVectorWell resWell = this->resWell_;
+        auto& resWell = this->scratch_.resWell;
+        resWell = this->resWell_;
         // resWell = resWell - B * x
         this->parallelB_.mmv(x, resWell);
         // xw = D^-1 * resWell
@@ -1636,7 +1673,8 @@ namespace Opm
     {
         if (!this->isOperableAndSolvable() && !this->wellIsStopped()) return;
 
-        BVectorWell xw(1);
+        auto& xw = this->scratch_.dx_well;
+        xw.resize(1);
         xw[0].resize(this->numWellEq_);
 
         recoverSolutionWell(x, xw);
@@ -1659,6 +1697,7 @@ namespace Opm
         well_flux.resize(np, 0.0);
 
         const bool allow_cf = this->getAllowCrossFlow();
+        const std::vector<Scalar> cmix_s = this->wellSurfaceVolumeFractionsScalar();
 
         for (int perf = 0; perf < this->number_of_perforations_; ++perf) {
             const int cell_idx = this->well_cells_[perf];
@@ -1670,7 +1709,7 @@ namespace Opm
             const double Tw = this->well_index_[perf] * trans_mult;
 
             std::vector<Scalar> cq_s(this->num_components_, 0.);
-            computePerfRateScalar(intQuants, mob, bhp, Tw, perf, allow_cf,
+            computePerfRateScalar(intQuants, mob, bhp, Tw, perf, allow_cf, cmix_s,
                             cq_s, deferred_logger);
 
             for(int p = 0; p < np; ++p) {
@@ -1692,10 +1731,17 @@ namespace Opm
     {
 
         // iterate to get a more accurate well density
-        // create a copy of the well_state to use. If the operability checking is sucessful, we use this one
-        // to replace the original one
-        WellState well_state_copy = ebosSimulator.problem().wellModel().wellState();
-        const auto& group_state  = ebosSimulator.problem().wellModel().groupState();
+        // use a scratch copy of the well_state, we don't want to update the real well state.
+        // The scratch state of the well model only copies the wells changed by the previous
+        // well, the whole well state is only copied outside the potential calculations.
+        const auto& well_model = ebosSimulator.problem().wellModel();
+        std::optional<WellState> well_state_storage;
+        WellState* well_state_scratch = well_model.potentialWellState();
+        if (!well_state_scratch) {
+            well_state_scratch = &well_state_storage.emplace(well_model.wellState());
+        }
+        WellState& well_state_copy = *well_state_scratch;
+        const auto& group_state  = well_model.groupState();
         auto& ws = well_state_copy.well(this->index_of_well_);
 
         //  Set current control to bhp, and bhp value in state, modify bhp limit in control object.
@@ -1976,7 +2022,8 @@ namespace Opm
             double perf_vap_oil_rate = 0.;
             double trans_mult = ebos_simulator.problem().template rockCompTransMultiplier<double>(int_quant, cell_idx);
             const double Tw = this->well_index_[perf] * trans_mult;
-            computePerfRateEval(int_quant, mob, bhp, Tw, perf, allow_cf,
+            const std::vector<EvalWell> cmix_s = this->wellSurfaceVolumeFractionsEval();
+            computePerfRateEval(int_quant, mob, bhp, Tw, perf, allow_cf, cmix_s,
                                 cq_s, perf_dis_gas_rate, perf_vap_oil_rate, deferred_logger);
             // TODO: make area a member
             const double area = 2 * M_PI * this->perf_rep_radius_[perf] * this->perf_length_[perf];
@@ -2330,6 +2377,30 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    std::vector<std::optional<double>>
+    StandardWell<TypeTag>::
+    computeBhpAtThpLimitProdWithAlqs(const Simulator& ebos_simulator,
+                                     const SummaryState& summary_state,
+                                     DeferredLogger& deferred_logger,
+                                     const std::vector<double>& alq_values) const
+    {
+        // Make the frates() function, see computeBhpAtThpLimitProdWithAlq().
+        auto frates = [this, &ebos_simulator, &deferred_logger](const double bhp) {
+            std::vector<double> rates(3);
+            computeWellRatesWithBhp(ebos_simulator, bhp, rates, deferred_logger);
+            this->adaptRatesForVFP(rates);
+            return rates;
+        };
+
+        return this->StandardWellGeneric<Scalar>::computeBhpAtThpLimitProdWithAlqs(frates,
+                                                                                   summary_state,
+                                                                                   deferred_logger,
+                                                                                   alq_values);
+    }
+
+
+
     template<typename TypeTag>
     std::optional<double>
     StandardWell<TypeTag>::
@@ -2407,6 +2478,7 @@ namespace Opm
         std::vector<double> well_q_s(this->num_components_, 0.);
         const EvalWell& bhp = this->getBhp();
         const bool allow_cf = this->getAllowCrossFlow() || openCrossFlowAvoidSingularity(ebosSimulator);
+        const std::vector<Scalar> cmix_s = this->wellSurfaceVolumeFractionsScalar();
         for (int perf = 0; perf < this->number_of_perforations_; ++perf) {
             const int cell_idx = this->well_cells_[perf];
             const auto& intQuants = *(ebosSimulator.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/ 0));
@@ -2415,7 +2487,7 @@ namespace Opm
             std::vector<Scalar> cq_s(this->num_components_, 0.);
             double trans_mult = ebosSimulator.problem().template rockCompTransMultiplier<double>(intQuants,  cell_idx);
             const double Tw = this->well_index_[perf] * trans_mult;
-            computePerfRateScalar(intQuants, mob, bhp.value(), Tw, perf, allow_cf,
+            computePerfRateScalar(intQuants, mob, bhp.value(), Tw, perf, allow_cf, cmix_s,
                             cq_s, deferred_logger);
             for (int comp = 0; comp < this->num_components_; ++comp) {
                 well_q_s[comp] += cq_s[comp];
@@ -2434,11 +2506,12 @@ namespace Opm
 
 
     template <typename TypeTag>
+    template <class Value>
     void
     StandardWell<TypeTag>::
     computeConnLevelProdInd(const typename StandardWell<TypeTag>::FluidState& fs,
                             const std::function<double(const double)>& connPICalc,
-                            const std::vector<EvalWell>& mobility,
+                            const std::vector<Value>& mobility,
                             double* connPI) const
     {
         const auto& pu = this->phaseUsage();
@@ -2447,7 +2520,7 @@ namespace Opm
             // Note: E100's notion of PI value phase mobility includes
             // the reciprocal FVF.
             const auto connMob =
-                mobility[ this->flowPhaseToEbosCompIdx(p) ].value()
+                getValue(mobility[ this->flowPhaseToEbosCompIdx(p) ])
                     * fs.invB(this->flowPhaseToEbosPhaseIdx(p)).value();
 
             connPI[p] = connPICalc(connMob);
@@ -2472,12 +2545,13 @@ namespace Opm
 
 
     template <typename TypeTag>
+    template <class Value>
     void
     StandardWell<TypeTag>::
     computeConnLevelInjInd(const typename StandardWell<TypeTag>::FluidState& fs,
                            const Phase preferred_phase,
                            const std::function<double(const double)>& connIICalc,
-                           const std::vector<EvalWell>& mobility,
+                           const std::vector<Value>& mobility,
                            double* connII,
                            DeferredLogger& deferred_logger) const
     {
@@ -2503,8 +2577,10 @@ namespace Opm
                              deferred_logger);
         }
 
-        const auto zero   = EvalWell { this->numWellEq_ + Indices::numEq, 0.0 };
-        const auto mt     = std::accumulate(mobility.begin(), mobility.end(), zero);
-        connII[phase_pos] = connIICalc(mt.value() * fs.invB(this->flowPhaseToEbosPhaseIdx(phase_pos)).value());
+        double mt = 0.0;
+        for (const auto& mob : mobility) {
+            mt += getValue(mob);
+        }
+        connII[phase_pos] = connIICalc(mt * fs.invB(this->flowPhaseToEbosPhaseIdx(phase_pos)).value());
     }
 } // namespace Opm
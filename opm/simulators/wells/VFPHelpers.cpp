@@ -27,10 +27,16 @@
 #include <opm/input/eclipse/Schedule/VFPInjTable.hpp>
 #include <opm/input/eclipse/Schedule/VFPProdTable.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <stdexcept>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define OPM_VFPHELPERS_AVX2 1
+#endif
+
 namespace {
 
 /**
@@ -65,6 +71,131 @@ double findX(const double  x0,
     return x;
 }
 
+/**
+ * Whether findInterpData() selects the interval starting at index lower
+ * for the (chopped) value
+ */
+bool intervalContains(const double value, const std::vector<double>& values, const int lower)
+{
+    const int nvalues = values.size();
+    if (nvalues < 2 || lower < 0 || lower > nvalues-2) {
+        return false;
+    }
+    if (value < values.front()) {
+        return lower == 0;
+    }
+    if (value >= values.back()) {
+        return lower == nvalues-2;
+    }
+    // the search picks the first element greater than or equal to value
+    return values[lower+1] >= value && (lower == 0 || values[lower] < value);
+}
+
+/**
+ * Calculates the interpolation factor for the interval in data
+ */
+void setInterpFactor(const double value, const std::vector<double>& values, Opm::detail::InterpData& data)
+{
+    const double start = values[data.ind_[0]];
+    const double end   = values[data.ind_[1]];
+
+    //Find interpolation ratio
+    if (end > start) {
+        //FIXME: Possible source for floating point error here if value and floor are large,
+        //but very close to each other
+        data.inv_dist_ = 1.0 / (end-start);
+        data.factor_ = (value-start) * data.inv_dist_;
+    }
+    else {
+        data.inv_dist_ = 0.0;
+        data.factor_ = 0.0;
+    }
+
+    // Disallow extrapolation with higher factor than 3.0.
+    // The factor 3.0 has been chosen because it works well
+    // with certain testcases, and may not be optimal.
+    if (data.factor_ > 3.0) {
+        data.factor_ = 3.0;
+    }
+}
+
+// a[i] = t1*a[i] + t2*b[i] for i < n
+inline void lerpArrays(double* a, const double* b, const double t1, const double t2, const int n)
+{
+    int i = 0;
+#if OPM_VFPHELPERS_AVX2
+    const __m256d t1v = _mm256_set1_pd(t1);
+    const __m256d t2v = _mm256_set1_pd(t2);
+    for (; i + 4 <= n; i += 4) {
+        const __m256d av = _mm256_loadu_pd(a + i);
+        const __m256d bv = _mm256_loadu_pd(b + i);
+        _mm256_storeu_pd(a + i, _mm256_add_pd(_mm256_mul_pd(t1v, av), _mm256_mul_pd(t2v, bv)));
+    }
+#endif
+    for (; i < n; ++i) {
+        a[i] = t1*a[i] + t2*b[i];
+    }
+}
+
+// d[i] = (b[i] - a[i]) * scale for i < n
+inline void diffArrays(double* d, const double* a, const double* b, const double scale, const int n)
+{
+    int i = 0;
+#if OPM_VFPHELPERS_AVX2
+    const __m256d sv = _mm256_set1_pd(scale);
+    for (; i + 4 <= n; i += 4) {
+        const __m256d av = _mm256_loadu_pd(a + i);
+        const __m256d bv = _mm256_loadu_pd(b + i);
+        _mm256_storeu_pd(d + i, _mm256_mul_pd(_mm256_sub_pd(bv, av), sv));
+    }
+#endif
+    for (; i < n; ++i) {
+        d[i] = (b[i] - a[i]) * scale;
+    }
+}
+
+/**
+ * Multilinear interpolation in a cell with dim axes, which also gives the
+ * derivatives along every axis.
+ *
+ * The corner values are stored with axis 0 as the slowest index. Every step
+ * removes the slowest remaining axis by interpolating between the two halves
+ * of the remaining values, such that all loops run over contiguous arrays.
+ * The difference between the halves is the derivative along the removed
+ * axis, and the derivatives of the axes removed earlier are interpolated in
+ * the same way as the values.
+ */
+template <int dim>
+void multilinear(const double* corners,
+                 const double* factor,
+                 const double* inv_dist,
+                 double& value,
+                 double* deriv)
+{
+    constexpr int n = 1 << dim;
+    double values[n];
+    double derivs[dim][n/2];
+    std::copy(corners, corners + n, values);
+
+    int size = n;
+    for (int axis = 0; axis < dim; ++axis) {
+        const int half = size / 2;
+        const double t2 = factor[axis];
+        const double t1 = 1.0 - t2;
+        for (int k = 0; k < axis; ++k) {
+            lerpArrays(derivs[k], derivs[k] + half, t1, t2, half);
+        }
+        diffArrays(derivs[axis], values, values + half, inv_dist[axis], half);
+        lerpArrays(values, values + half, t1, t2, half);
+        size = half;
+    }
+
+    value = values[0];
+    for (int k = 0; k < dim; ++k) {
+        deriv[k] = derivs[k][0];
+    }
+}
+
 /**
  * Returns zero if input value is negative
  */
@@ -118,29 +249,23 @@ InterpData findInterpData(const double value_in, const std::vector<double>& valu
             }
         }
 
-        const double start = values[retval.ind_[0]];
-        const double end   = values[retval.ind_[1]];
-
-        //Find interpolation ratio
-        if (end > start) {
-            //FIXME: Possible source for floating point error here if value and floor are large,
-            //but very close to each other
-            retval.inv_dist_ = 1.0 / (end-start);
-            retval.factor_ = (value-start) * retval.inv_dist_;
-        }
-        else {
-            retval.inv_dist_ = 0.0;
-            retval.factor_ = 0.0;
-        }
+        setInterpFactor(value, values, retval);
     }
 
-    // Disallow extrapolation with higher factor than 3.0.
-    // The factor 3.0 has been chosen because it works well
-    // with certain testcases, and may not be optimal.
-    if (retval.factor_ > 3.0) {
-        retval.factor_ = 3.0;
+    return retval;
+}
+
+InterpData findInterpData(const double value_in, const std::vector<double>& values, const int hint)
+{
+    const double value = value_in < 0.? 0. : value_in;
+    if (!intervalContains(value, values, hint)) {
+        return findInterpData(value_in, values);
     }
 
+    InterpData retval;
+    retval.ind_[0] = hint;
+    retval.ind_[1] = hint+1;
+    setInterpFactor(value, values, retval);
     return retval;
 }
 
@@ -178,27 +303,21 @@ VFPEvaluation operator*(double lhs, const VFPEvaluation& rhs)
     return retval;
 }
 
-VFPEvaluation interpolate(const VFPProdTable& table,
-                          const InterpData& flo_i,
-                          const InterpData& thp_i,
-                          const InterpData& wfr_i,
-                          const InterpData& gfr_i,
-                          const InterpData& alq_i)
+void gatherCorners(const VFPProdTable& table,
+                   const InterpData& flo_i,
+                   const InterpData& thp_i,
+                   const InterpData& wfr_i,
+                   const InterpData& gfr_i,
+                   const InterpData& alq_i,
+                   VFPProdCorners& corners)
 {
-    //Values and derivatives in a 5D hypercube
-    VFPEvaluation nn[2][2][2][2][2];
-
-
-    //Pick out nearest neighbors (nn) to our evaluation point
-    //This is not really required, but performance-wise it may pay off, since the 32-elements
-    //we copy to (nn) will fit better in cache than the full original table for the
-    //interpolation below.
     //The following ladder of for loops will presumably be unrolled by a reasonable compiler.
-    for (int t=0; t<=1; ++t) {
-        for (int w=0; w<=1; ++w) {
+    int c = 0;
+    for (int f=0; f<=1; ++f) {
+        for (int a=0; a<=1; ++a) {
             for (int g=0; g<=1; ++g) {
-                for (int a=0; a<=1; ++a) {
-                    for (int f=0; f<=1; ++f) {
+                for (int w=0; w<=1; ++w) {
+                    for (int t=0; t<=1; ++t) {
                         //Shorthands for indexing
                         const int ti = thp_i.ind_[t];
                         const int wi = wfr_i.ind_[w];
@@ -207,137 +326,77 @@ VFPEvaluation interpolate(const VFPProdTable& table,
                         const int fi = flo_i.ind_[f];
 
                         //Copy element
-                        nn[t][w][g][a][f].value = table(ti,wi,gi,ai,fi);
+                        corners[c++] = table(ti,wi,gi,ai,fi);
                     }
                 }
             }
         }
     }
+}
 
-    //Calculate derivatives
-    //Note that the derivative of the two end points of a line aligned with the
-    //"axis of the derivative" are equal
-    for (int i=0; i<=1; ++i) {
-        for (int j=0; j<=1; ++j) {
-            for (int k=0; k<=1; ++k) {
-                for (int l=0; l<=1; ++l) {
-                    nn[0][i][j][k][l].dthp = (nn[1][i][j][k][l].value - nn[0][i][j][k][l].value) * thp_i.inv_dist_;
-                    nn[i][0][j][k][l].dwfr = (nn[i][1][j][k][l].value - nn[i][0][j][k][l].value) * wfr_i.inv_dist_;
-                    nn[i][j][0][k][l].dgfr = (nn[i][j][1][k][l].value - nn[i][j][0][k][l].value) * gfr_i.inv_dist_;
-                    nn[i][j][k][0][l].dalq = (nn[i][j][k][1][l].value - nn[i][j][k][0][l].value) * alq_i.inv_dist_;
-                    nn[i][j][k][l][0].dflo = (nn[i][j][k][l][1].value - nn[i][j][k][l][0].value) * flo_i.inv_dist_;
-
-                    nn[1][i][j][k][l].dthp = nn[0][i][j][k][l].dthp;
-                    nn[i][1][j][k][l].dwfr = nn[i][0][j][k][l].dwfr;
-                    nn[i][j][1][k][l].dgfr = nn[i][j][0][k][l].dgfr;
-                    nn[i][j][k][1][l].dalq = nn[i][j][k][0][l].dalq;
-                    nn[i][j][k][l][1].dflo = nn[i][j][k][l][0].dflo;
-                }
-            }
-        }
-    }
-
-    double t1, t2; //interpolation variables, so that t1 = (1-t) and t2 = t.
-
-    // Remove dimensions one by one
-    // Example: going from 3D to 2D to 1D, we start by interpolating along
-    // the z axis first, leaving a 2D problem. Then interpolating along the y
-    // axis, leaving a 1D, problem, etc.
-    t2 = flo_i.factor_;
-    t1 = (1.0-t2);
-    for (int t=0; t<=1; ++t) {
-        for (int w=0; w<=1; ++w) {
-            for (int g=0; g<=1; ++g) {
-                for (int a=0; a<=1; ++a) {
-                    nn[t][w][g][a][0] = t1*nn[t][w][g][a][0] + t2*nn[t][w][g][a][1];
-                }
-            }
-        }
-    }
-
-    t2 = alq_i.factor_;
-    t1 = (1.0-t2);
-    for (int t=0; t<=1; ++t) {
-        for (int w=0; w<=1; ++w) {
-            for (int g=0; g<=1; ++g) {
-                nn[t][w][g][0][0] = t1*nn[t][w][g][0][0] + t2*nn[t][w][g][1][0];
-            }
-        }
-    }
-
-    t2 = gfr_i.factor_;
-    t1 = (1.0-t2);
-    for (int t=0; t<=1; ++t) {
-        for (int w=0; w<=1; ++w) {
-            nn[t][w][0][0][0] = t1*nn[t][w][0][0][0] + t2*nn[t][w][1][0][0];
-        }
-    }
-
-    t2 = wfr_i.factor_;
-    t1 = (1.0-t2);
-    for (int t=0; t<=1; ++t) {
-        nn[t][0][0][0][0] = t1*nn[t][0][0][0][0] + t2*nn[t][1][0][0][0];
-    }
+VFPEvaluation interpolate(const VFPProdTable& table,
+                          const InterpData& flo_i,
+                          const InterpData& thp_i,
+                          const InterpData& wfr_i,
+                          const InterpData& gfr_i,
+                          const InterpData& alq_i)
+{
+    //Pick out nearest neighbors to our evaluation point
+    //This is not really required, but performance-wise it may pay off, since the 32-elements
+    //we copy will fit better in cache than the full original table for the
+    //interpolation below.
+    VFPProdCorners corners;
+    gatherCorners(table, flo_i, thp_i, wfr_i, gfr_i, alq_i, corners);
+    return interpolate(corners, flo_i, thp_i, wfr_i, gfr_i, alq_i);
+}
 
-    t2 = thp_i.factor_;
-    t1 = (1.0-t2);
-    nn[0][0][0][0][0] = t1*nn[0][0][0][0][0] + t2*nn[1][0][0][0][0];
+VFPEvaluation interpolate(const VFPProdCorners& corners,
+                          const InterpData& flo_i,
+                          const InterpData& thp_i,
+                          const InterpData& wfr_i,
+                          const InterpData& gfr_i,
+                          const InterpData& alq_i)
+{
+    // The axes in the order of the corners, the first axis is removed first
+    const double factor[5] = {flo_i.factor_, alq_i.factor_, gfr_i.factor_, wfr_i.factor_, thp_i.factor_};
+    const double inv_dist[5] = {flo_i.inv_dist_, alq_i.inv_dist_, gfr_i.inv_dist_, wfr_i.inv_dist_, thp_i.inv_dist_};
+    double deriv[5];
 
-    return nn[0][0][0][0][0];
+    VFPEvaluation retval;
+    multilinear<5>(corners.data(), factor, inv_dist, retval.value, deriv);
+    retval.dflo = deriv[0];
+    retval.dalq = deriv[1];
+    retval.dgfr = deriv[2];
+    retval.dwfr = deriv[3];
+    retval.dthp = deriv[4];
+    return retval;
 }
 
 VFPEvaluation interpolate(const VFPInjTable& table,
                           const InterpData& flo_i,
                           const InterpData& thp_i)
 {
-    //Values and derivatives in a 2D plane
-    VFPEvaluation nn[2][2];
-
-
-    //Pick out nearest neighbors (nn) to our evaluation point
-    //The following ladder of for loops will presumably be unrolled by a reasonable compiler.
-    for (int t=0; t<=1; ++t) {
-        for (int f=0; f<=1; ++f) {
-            //Shorthands for indexing
-            const int ti = thp_i.ind_[t];
-            const int fi = flo_i.ind_[f];
-
-            //Copy element
-            nn[t][f].value = table(ti,fi);
+    //Pick out nearest neighbors to our evaluation point, stored as [flo][thp]
+    double corners[4];
+    for (int f=0; f<=1; ++f) {
+        for (int t=0; t<=1; ++t) {
+            corners[2*f + t] = table(thp_i.ind_[t], flo_i.ind_[f]);
         }
     }
 
-    //Calculate derivatives
-    //Note that the derivative of the two end points of a line aligned with the
-    //"axis of the derivative" are equal
-    for (int i=0; i<=1; ++i) {
-        nn[0][i].dthp = (nn[1][i].value - nn[0][i].value) * thp_i.inv_dist_;
-        nn[i][0].dwfr = -1e100;
-        nn[i][0].dgfr = -1e100;
-        nn[i][0].dalq = -1e100;
-        nn[i][0].dflo = (nn[i][1].value - nn[i][0].value) * flo_i.inv_dist_;
-
-        nn[1][i].dthp = nn[0][i].dthp;
-        nn[i][1].dwfr = nn[i][0].dwfr;
-        nn[i][1].dgfr = nn[i][0].dgfr;
-        nn[i][1].dalq = nn[i][0].dalq;
-        nn[i][1].dflo = nn[i][0].dflo;
-    }
-
-    double t1, t2; //interpolation variables, so that t1 = (1-t) and t2 = t.
-
-    // Go from 2D to 1D
-    t2 = flo_i.factor_;
-    t1 = (1.0-t2);
-    nn[0][0] = t1*nn[0][0] + t2*nn[0][1];
-    nn[1][0] = t1*nn[1][0] + t2*nn[1][1];
+    const double factor[2] = {flo_i.factor_, thp_i.factor_};
+    const double inv_dist[2] = {flo_i.inv_dist_, thp_i.inv_dist_};
+    double deriv[2];
 
-    // Go from line to point on line
-    t2 = thp_i.factor_;
-    t1 = (1.0-t2);
-    nn[0][0] = t1*nn[0][0] + t2*nn[1][0];
-
-    return nn[0][0];
+    VFPEvaluation retval;
+    multilinear<2>(corners, factor, inv_dist, retval.value, deriv);
+    retval.dflo = deriv[0];
+    retval.dthp = deriv[1];
+    // injection tables do not depend on these
+    retval.dwfr = -1e100;
+    retval.dgfr = -1e100;
+    retval.dalq = -1e100;
+    return retval;
 }
 
 VFPEvaluation bhp(const VFPProdTable& table,
@@ -96,6 +96,15 @@ struct InterpData {
  */
 InterpData findInterpData(const double value_in, const std::vector<double>& values);
 
+/**
+ * As findInterpData() above, but the interval starting at index hint is
+ * checked before the values are searched. The result is the same as without
+ * the hint.
+ *  @param hint First index of the interval to check, typically the interval
+ *              of the previous evaluation. A negative value means no hint.
+ */
+InterpData findInterpData(const double value_in, const std::vector<double>& values, const int hint);
+
 /**
  * An "ADB-like" structure with a single value and a set of derivatives
  */
@@ -123,6 +132,34 @@ VFPEvaluation interpolate(const VFPProdTable& table,
                           const InterpData& gfr_i,
                           const InterpData& alq_i);
 
+/**
+ * The values of a production table at the 32 corners of an interpolation
+ * cell, stored in the order [flo][alq][gfr][wfr][thp]. The interpolation
+ * removes the axes in that order.
+ */
+using VFPProdCorners = std::array<double, 32>;
+
+/**
+ * Copies the values at the corners of the cell given by the inputs from the table.
+ */
+void gatherCorners(const VFPProdTable& table,
+                   const InterpData& flo_i,
+                   const InterpData& thp_i,
+                   const InterpData& wfr_i,
+                   const InterpData& gfr_i,
+                   const InterpData& alq_i,
+                   VFPProdCorners& corners);
+
+/**
+ * As interpolate() above, with the corner values of the cell given by gatherCorners().
+ */
+VFPEvaluation interpolate(const VFPProdCorners& corners,
+                          const InterpData& flo_i,
+                          const InterpData& thp_i,
+                          const InterpData& wfr_i,
+                          const InterpData& gfr_i,
+                          const InterpData& alq_i);
+
 /**
  * This basically models interpolate(VFPProdTable::array_type, ...)
  * which performs 5D interpolation, but here for the 2D case only
@@ -27,7 +27,43 @@
 
 #include <opm/simulators/wells/VFPHelpers.hpp>
 
+#include <array>
+#include <cstddef>
+
+
+namespace {
+
+// interpolate in the cell of the point, the cell is taken from cache if the
+// point is in the cell of the previous evaluation
+Opm::detail::VFPEvaluation
+interpolateCached(const Opm::VFPProdTable& table,
+                  const double flo,
+                  const double thp,
+                  const double wfr,
+                  const double gfr,
+                  const double alq,
+                  Opm::VFPProdProperties::EvaluationCache& cache)
+{
+    const bool same_table = (cache.table == &table);
+    auto hint = [&cache, same_table](const int axis) { return same_table ? cache.lower[axis] : -1; };
+
+    const auto flo_i = Opm::detail::findInterpData(flo, table.getFloAxis(), hint(0));
+    const auto thp_i = Opm::detail::findInterpData(thp, table.getTHPAxis(), hint(1));
+    const auto wfr_i = Opm::detail::findInterpData(wfr, table.getWFRAxis(), hint(2));
+    const auto gfr_i = Opm::detail::findInterpData(gfr, table.getGFRAxis(), hint(3));
+    const auto alq_i = Opm::detail::findInterpData(alq, table.getALQAxis(), hint(4));
+
+    const std::array<int, 5> lower{flo_i.ind_[0], thp_i.ind_[0], wfr_i.ind_[0], gfr_i.ind_[0], alq_i.ind_[0]};
+    if (!same_table || lower != cache.lower) {
+        Opm::detail::gatherCorners(table, flo_i, thp_i, wfr_i, gfr_i, alq_i, cache.corners);
+        cache.table = &table;
+        cache.lower = lower;
+    }
 
+    return Opm::detail::interpolate(cache.corners, flo_i, thp_i, wfr_i, gfr_i, alq_i);
+}
+
+}
 
 namespace Opm {
 
@@ -94,6 +130,44 @@ double VFPProdProperties::bhp(int table_id,
     return retval.value;
 }
 
+double VFPProdProperties::bhp(int table_id,
+                              const double& aqua,
+                              const double& liquid,
+                              const double& vapour,
+                              const double& thp_arg,
+                              const double& alq,
+                              EvaluationCache& cache) const {
+    const VFPProdTable& table = detail::getTable(m_tables, table_id);
+
+    //Find interpolation variables
+    const double flo = detail::getFlo(table, aqua, liquid, vapour);
+    const double wfr = detail::getWFR(table, aqua, liquid, vapour);
+    const double gfr = detail::getGFR(table, aqua, liquid, vapour);
+
+    //Recall that flo is negative in Opm, so switch sign.
+    return interpolateCached(table, -flo, thp_arg, wfr, gfr, alq, cache).value;
+}
+
+std::vector<double>
+VFPProdProperties::bhp(const std::vector<int>& table_ids,
+                       const std::vector<double>& aqua,
+                       const std::vector<double>& liquid,
+                       const std::vector<double>& vapour,
+                       const std::vector<double>& thp_arg,
+                       const std::vector<double>& alq,
+                       std::vector<EvaluationCache>& caches) const
+{
+    const std::size_t num_wells = table_ids.size();
+    if (caches.size() < num_wells)
+        caches.resize(num_wells);
+
+    std::vector<double> bhps(num_wells, 0.);
+    for (std::size_t w = 0; w < num_wells; ++w) {
+        bhps[w] = this->bhp(table_ids[w], aqua[w], liquid[w], vapour[w], thp_arg[w], alq[w], caches[w]);
+    }
+    return bhps;
+}
+
 
 const VFPProdTable& VFPProdProperties::getTable(const int table_id) const {
     return detail::getTable(m_tables, table_id);
@@ -146,6 +220,19 @@ EvalWell VFPProdProperties::bhp(const int table_id,
                                 const EvalWell& vapour,
                                 const double& thp,
                                 const double& alq) const
+{
+    EvaluationCache cache;
+    return this->bhp(table_id, aqua, liquid, vapour, thp, alq, cache);
+}
+
+template <class EvalWell>
+EvalWell VFPProdProperties::bhp(const int table_id,
+                                const EvalWell& aqua,
+                                const EvalWell& liquid,
+                                const EvalWell& vapour,
+                                const double& thp,
+                                const double& alq,
+                                EvaluationCache& cache) const
 {
     //Get the table
     const VFPProdTable& table = detail::getTable(m_tables, table_id);
@@ -156,15 +243,9 @@ EvalWell VFPProdProperties::bhp(const int table_id,
     EvalWell wfr = detail::getWFR(table, aqua, liquid, vapour);
     EvalWell gfr = detail::getGFR(table, aqua, liquid, vapour);
 
-    //First, find the values to interpolate between
     //Value of FLO is negative in OPM for producers, but positive in VFP table
-    auto flo_i = detail::findInterpData(-flo.value(), table.getFloAxis());
-    auto thp_i = detail::findInterpData( thp, table.getTHPAxis()); // assume constant
-    auto wfr_i = detail::findInterpData( wfr.value(), table.getWFRAxis());
-    auto gfr_i = detail::findInterpData( gfr.value(), table.getGFRAxis());
-    auto alq_i = detail::findInterpData( alq, table.getALQAxis()); //assume constant
-
-    detail::VFPEvaluation bhp_val = detail::interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
+    //The thp and alq are assumed constant
+    detail::VFPEvaluation bhp_val = interpolateCached(table, -flo.value(), thp, wfr.value(), gfr.value(), alq, cache);
 
     bhp = (bhp_val.dwfr * wfr) + (bhp_val.dgfr * gfr) - (bhp_val.dflo * flo);
     bhp.setValue(bhp_val.value);
@@ -174,7 +255,10 @@ EvalWell VFPProdProperties::bhp(const int table_id,
 #define INSTANCE(...) \
     template __VA_ARGS__ VFPProdProperties::bhp<__VA_ARGS__>(const int, \
                                                              const __VA_ARGS__&, const __VA_ARGS__&, const __VA_ARGS__&, \
-                                                             const double&, const double&) const;
+                                                             const double&, const double&) const; \
+    template __VA_ARGS__ VFPProdProperties::bhp<__VA_ARGS__>(const int, \
+                                                             const __VA_ARGS__&, const __VA_ARGS__&, const __VA_ARGS__&, \
+                                                             const double&, const double&, EvaluationCache&) const;
 
 INSTANCE(DenseAd::Evaluation<double, -1, 4u>)
 INSTANCE(DenseAd::Evaluation<double, -1, 5u>)
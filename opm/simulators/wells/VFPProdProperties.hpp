@@ -20,6 +20,7 @@
 #ifndef OPM_AUTODIFF_VFPPRODPROPERTIES_HPP_
 #define OPM_AUTODIFF_VFPPRODPROPERTIES_HPP_
 
+#include <array>
 #include <functional>
 #include <map>
 #include <vector>
@@ -37,6 +38,20 @@ class VFPProdTable;
 class VFPProdProperties {
 public:
     VFPProdProperties() = default;
+
+    /**
+     * The interpolation cell of a table used by the last evaluation of one
+     * well. When the same cache is passed to the next evaluation for the
+     * well, and its point lies in the same cell, the search along the axes
+     * reduces to checking the cached intervals and the corner values of the
+     * cell are reused. The cache must not be shared between threads.
+     */
+    struct EvaluationCache {
+        const VFPProdTable* table = nullptr;
+        std::array<int, 5> lower{-1, -1, -1, -1, -1}; // first index along the flo, thp, wfr, gfr and alq axes
+        std::array<double, 32> corners{};
+    };
+
     /**
      * Takes *no* ownership of data.
      */
@@ -67,6 +82,18 @@ public:
                  const double& thp,
                  const double& alq) const;
 
+    /**
+     * As bhp() above, reusing the interpolation cell in cache if possible
+     */
+    template <class EvalWell>
+    EvalWell bhp(const int table_id,
+                 const EvalWell& aqua,
+                 const EvalWell& liquid,
+                 const EvalWell& vapour,
+                 const double& thp,
+                 const double& alq,
+                 EvaluationCache& cache) const;
+
     /**
      * Linear interpolation of bhp as a function of the input parameters
      * @param table_id Table number to use
@@ -86,6 +113,30 @@ public:
             const double& thp,
             const double& alq) const;
 
+    /**
+     * As bhp() above, reusing the interpolation cell in cache if possible
+     */
+    double bhp(int table_id,
+            const double& aqua,
+            const double& liquid,
+            const double& vapour,
+            const double& thp,
+            const double& alq,
+            EvaluationCache& cache) const;
+
+    /**
+     * Linear interpolation of bhp for several wells at once. Entry i of the
+     * result is bhp(table_ids[i], aqua[i], ..., caches[i]), where caches
+     * holds one cache per well that is kept between the calls.
+     */
+    std::vector<double> bhp(const std::vector<int>& table_ids,
+                            const std::vector<double>& aqua,
+                            const std::vector<double>& liquid,
+                            const std::vector<double>& vapour,
+                            const std::vector<double>& thp,
+                            const std::vector<double>& alq,
+                            std::vector<EvaluationCache>& caches) const;
+
     /**
      * Linear interpolation of thp as a function of the input parameters
      * @param table_id Table number to use
@@ -27,6 +27,8 @@
 
 #include <opm/input/eclipse/EclipseState/EclipseState.hpp>
 
+#include <opm/simulators/wells/WellHelpers.hpp>
+
 namespace Opm
 {
 template<class TypeTag>
@@ -102,12 +104,7 @@ public:
 
     void addNeighbors(std::vector<NeighborSet>& neighbors) const
     {
-        for(const auto& well_perforations : wells_)
-        {
-            for(const auto& perforation : well_perforations)
-                neighbors[perforation].insert(well_perforations.begin(),
-                                              well_perforations.end());
-        }
+        wellhelpers::addWellNeighbors(wells_, neighbors);
     }
 
     void applyInitial()
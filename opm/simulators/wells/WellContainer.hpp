@@ -21,6 +21,7 @@
 #define OPM_WELL_CONTAINER_HEADER_INCLUDED
 
 #include <initializer_list>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -66,6 +67,7 @@ public:
             throw std::logic_error("An object with name: " + name + " already exists in container");
 
         this->index_map.emplace(name, this->m_data.size());
+        this->m_names.push_back(name);
         this->m_data.push_back(std::forward<T>(value));
         return this->m_data.back();
     }
@@ -75,6 +77,7 @@ public:
             throw std::logic_error("An object with name: " + name + " already exists in container");
 
         this->index_map.emplace(name, this->m_data.size());
+        this->m_names.push_back(name);
         this->m_data.push_back(value);
         return this->m_data.back();
     }
@@ -126,6 +129,7 @@ public:
 
     void clear() {
         this->m_data.clear();
+        this->m_names.clear();
         this->index_map.clear();
     }
 
@@ -150,11 +154,9 @@ public:
     }
 
     const std::string& well_name(std::size_t well_index) const {
-        for (const auto& [wname, windex] : this->index_map) {
-            if (windex == well_index)
-                return wname;
-        }
-        throw std::logic_error("No such well");
+        if (well_index >= this->m_names.size())
+            throw std::logic_error("No such well");
+        return this->m_names[well_index];
     }
 
     std::vector<std::string> wells() const {
@@ -179,6 +181,7 @@ private:
 
 
     std::vector<T> m_data;
+    std::vector<std::string> m_names;
     std::unordered_map<std::string, std::size_t> index_map;
 };
 
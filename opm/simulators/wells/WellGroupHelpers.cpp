@@ -23,8 +23,11 @@
 
 #include <opm/input/eclipse/Schedule/Group/GConSump.hpp>
 #include <opm/input/eclipse/Schedule/Group/GConSale.hpp>
+#include <opm/input/eclipse/Units/Units.hpp>
 #include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
+#include <opm/simulators/wells/GroupTree.hpp>
+#include <opm/simulators/wells/NetworkPressureSolver.hpp>
 #include <opm/simulators/wells/TargetCalculator.hpp>
 #include <opm/simulators/wells/VFPProdProperties.hpp>
 #include <opm/simulators/wells/WellState.hpp>
@@ -32,6 +35,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <set>
 #include <stack>
 
@@ -72,12 +76,9 @@ namespace {
             rate += gefac * sumWellPhaseRates(res_rates, groupTmp, schedule, wellState, reportStepIdx, phasePos, injector);
         }
 
-        for (const std::string& wellName : group.wells()) {
-            const auto& well_index = wellState.index(wellName);
-            if (!well_index.has_value())
-                continue;
-
-            if (! wellState.wellIsOwned(well_index.value(), wellName) ) // Only sum once
+        for (const std::size_t well_index : wellState.groupWellIndices(group)) {
+            const std::string& wellName = wellState.name(well_index);
+            if (! wellState.wellIsOwned(well_index, wellName) ) // Only sum once
             {
                 continue;
             }
@@ -91,7 +92,7 @@ namespace {
                 continue;
 
             double factor = wellEcl.getEfficiencyFactor();
-            const auto& ws = wellState.well(well_index.value());
+            const auto& ws = wellState.well(well_index);
             if (res_rates) {
                 const auto& well_rates = ws.reservoir_rates;
                 if (injector)
@@ -108,6 +109,138 @@ namespace {
         }
         return rate;
     }
+
+    // The rates of sumWellPhaseRates() for every group of the tree and every
+    // phase, computed in one sweep from the bottom of the tree. The rate of
+    // phase p of the group with index g is rates[np*g + p].
+    std::vector<double> sumWellPhaseRatesInTree(bool res_rates,
+                                                const Opm::GroupTree& tree,
+                                                const Opm::Schedule& schedule,
+                                                const Opm::WellState& wellState,
+                                                const int reportStepIdx,
+                                                const bool injector)
+    {
+        const int np = wellState.numPhases();
+        std::vector<double> rates(np * tree.size(), 0.0);
+        for (std::size_t g = 0; g < tree.size(); ++g) {
+            double* rate = rates.data() + np * g;
+            for (const std::size_t child : tree.children(g)) {
+                const auto& gefac = tree.group(child).getGroupEfficiencyFactor();
+                for (int phase = 0; phase < np; ++phase)
+                    rate[phase] += gefac * rates[np * child + phase];
+            }
+
+            for (const std::size_t well_index : wellState.groupWellIndices(tree.group(g))) {
+                const std::string& wellName = wellState.name(well_index);
+                if (! wellState.wellIsOwned(well_index, wellName) ) // Only sum once
+                {
+                    continue;
+                }
+
+                const auto& wellEcl = schedule.getWell(wellName, reportStepIdx);
+                // only count producers or injectors
+                if ((wellEcl.isProducer() && injector) || (wellEcl.isInjector() && !injector))
+                    continue;
+
+                if (wellEcl.getStatus() == Opm::Well::Status::SHUT)
+                    continue;
+
+                double factor = wellEcl.getEfficiencyFactor();
+                const auto& ws = wellState.well(well_index);
+                const auto& well_rates = res_rates ? ws.reservoir_rates : ws.surface_rates;
+                for (int phase = 0; phase < np; ++phase) {
+                    if (injector)
+                        rate[phase] += factor * well_rates[phase];
+                    else
+                        rate[phase] -= factor * well_rates[phase];
+                }
+            }
+        }
+        return rates;
+    }
+
+    // Nodes of the network ordered so that a child is always after its
+    // parent, and the leaf nodes which correspond to groups.
+    std::vector<std::string> networkNodesRootToChild(const Opm::Network::ExtNetwork& network,
+                                                     std::set<std::string>& leaf_nodes)
+    {
+        std::stack<std::string> children;
+        std::vector<std::string> root_to_child_nodes;
+        children.push(network.root().name());
+        while (!children.empty()) {
+            const auto node = children.top();
+            children.pop();
+            root_to_child_nodes.push_back(node);
+            auto branches = network.downtree_branches(node);
+            if (branches.empty()) {
+                leaf_nodes.insert(node);
+            }
+            for (const auto& branch : branches) {
+                children.push(branch.downtree_node());
+            }
+        }
+        assert(children.empty());
+        return root_to_child_nodes;
+    }
+
+    // The flow rates of the leaf nodes, taken from the corresponding groups.
+    std::map<std::string, std::vector<double>>
+    networkLeafInflows(const Opm::Network::ExtNetwork& network,
+                       const std::set<std::string>& leaf_nodes,
+                       const Opm::WellState& well_state,
+                       const Opm::GroupState& group_state,
+                       const Opm::Schedule& schedule,
+                       const int report_time_step)
+    {
+        std::map<std::string, std::vector<double>> node_inflows;
+        for (const auto& node : leaf_nodes) {
+            node_inflows[node] = group_state.production_rates(node);
+            // Add the ALQ amounts to the gas rates if requested.
+            if (network.node(node).add_gas_lift_gas()) {
+                const auto& group = schedule.getGroup(node, report_time_step);
+                for (const std::string& wellname : group.wells()) {
+                    const Opm::Well& well = schedule.getWell(wellname, report_time_step);
+                    // Here we use the efficiency unconditionally, but if WEFAC item 3
+                    // for the well is false (it defaults to true) then we should NOT use
+                    // the efficiency factor. Fixing this requires not only changing the
+                    // code here, but also:
+                    //    - Adding a member to the well for this flag, and setting it in Schedule::handleWEFAC().
+                    //    - Making the wells' maximum flows (i.e. not time-averaged by using a efficiency factor)
+                    //      available and using those (for wells with WEFAC(3) true only) when accumulating group
+                    //      rates, but ONLY for network calculations.
+                    const double efficiency = well.getEfficiencyFactor();
+                    node_inflows[node][Opm::BlackoilPhases::Vapour] += well_state.getALQ(wellname) * efficiency;
+                }
+            }
+        }
+        return node_inflows;
+    }
+
+    // Pressure at the downtree node of a branch, given the positive rates
+    // through the branch and the uptree pressure.
+    double networkBranchPressure(const Opm::Network::Branch& branch,
+                                 std::vector<double> rates,
+                                 const double up_press,
+                                 const Opm::VFPProdProperties& vfp_prod_props)
+    {
+        const auto vfp_table = branch.vfp_table();
+        if (!vfp_table) {
+            // Table number specified as 9999 in the deck, no pressure loss.
+            return up_press;
+        }
+        // The rates are here positive, but the VFP code expects the
+        // convention that production rates are negative, so we must
+        // flip signs.
+        for (auto& r : rates) { r *= -1.0; }
+        assert(rates.size() == 3);
+        const double alq = 0.0; // TODO: Do not ignore ALQ
+        return vfp_prod_props.bhp(*vfp_table,
+                                  rates[Opm::BlackoilPhases::Aqua],
+                                  rates[Opm::BlackoilPhases::Liquid],
+                                  rates[Opm::BlackoilPhases::Vapour],
+                                  up_press,
+                                  alq);
+    }
 } // namespace Anonymous
 
 namespace Opm
@@ -222,12 +355,9 @@ namespace WellGroupHelpers
             rate += gefac * sumSolventRates(groupTmp, schedule, wellState, reportStepIdx, injector);
         }
 
-        for (const std::string& wellName : group.wells()) {
-            const auto& well_index = wellState.index(wellName);
-            if (!well_index.has_value())
-                continue;
-
-            if (! wellState.wellIsOwned(well_index.value(), wellName) ) // Only sum once
+        for (const std::size_t well_index : wellState.groupWellIndices(group)) {
+            const std::string& wellName = wellState.name(well_index);
+            if (! wellState.wellIsOwned(well_index, wellName) ) // Only sum once
             {
                 continue;
             }
@@ -240,7 +370,7 @@ namespace WellGroupHelpers
             if (wellEcl.getStatus() == Well::Status::SHUT)
                 continue;
 
-            const auto& ws = wellState.well(well_index.value());
+            const auto& ws = wellState.well(well_index);
             double factor = wellEcl.getEfficiencyFactor();
             if (injector)
                 rate += factor * ws.sum_solvent_rates();
@@ -310,7 +440,7 @@ namespace WellGroupHelpers
         }
     }
 
-    void updateGroupTargetReduction(const Group& group,
+    void updateGroupTargetReduction(const GroupTree& tree,
                                     const Schedule& schedule,
                                     const int reportStepIdx,
                                     const bool isInjector,
@@ -321,116 +451,117 @@ namespace WellGroupHelpers
                                     std::vector<double>& groupTargetReduction)
     {
         const int np = wellState.numPhases();
-        for (const std::string& subGroupName : group.groups()) {
-            std::vector<double> subGroupTargetReduction(np, 0.0);
-            const Group& subGroup = schedule.getGroup(subGroupName, reportStepIdx);
-            updateGroupTargetReduction(subGroup,
-                                       schedule,
-                                       reportStepIdx,
-                                       isInjector,
-                                       pu,
-                                       guide_rate,
-                                       wellState,
-                                       group_state,
-                                       subGroupTargetReduction);
-
-            const double subGroupEfficiency = subGroup.getGroupEfficiencyFactor();
-
-            // accumulate group contribution from sub group
-            if (isInjector) {
-                const Phase all[] = {Phase::WATER, Phase::OIL, Phase::GAS};
-                bool individual_control = false;
-                int num_group_controlled_wells = 0;
-                for (Phase phase : all) {
-                    const Group::InjectionCMode& currentGroupControl
-                            = group_state.injection_control(subGroup.name(), phase);
-                    individual_control = individual_control || (currentGroupControl != Group::InjectionCMode::FLD
-                            && currentGroupControl != Group::InjectionCMode::NONE);
-                    num_group_controlled_wells
-                            += groupControlledWells(schedule, wellState, group_state, reportStepIdx, subGroupName, "", !isInjector, phase);
-                }
-                if (individual_control || num_group_controlled_wells == 0) {
-                    for (int phase = 0; phase < np; phase++) {
-                        groupTargetReduction[phase]
-                            += subGroupEfficiency * sumWellSurfaceRates(subGroup, schedule, wellState, reportStepIdx, phase, isInjector);
-                    }
-                } else {
-                    // The subgroup may participate in group control.
-                    bool has_guide_rate = false;
+        const auto surfaceRates = sumWellPhaseRatesInTree(false, tree, schedule, wellState, reportStepIdx, isInjector);
+        std::vector<std::vector<double>> targetReductions(tree.size(), std::vector<double>(np, 0.0));
+
+        // the subgroups come before their parent in the tree
+        for (std::size_t g = 0; g < tree.size(); ++g) {
+            const Group& group = tree.group(g);
+            auto& reduction = targetReductions[g];
+            for (const std::size_t subGroupIdx : tree.children(g)) {
+                const Group& subGroup = tree.group(subGroupIdx);
+                const std::string& subGroupName = subGroup.name();
+                const auto& subGroupTargetReduction = targetReductions[subGroupIdx];
+                const double* subGroupSurfaceRates = surfaceRates.data() + np * subGroupIdx;
+
+                const double subGroupEfficiency = subGroup.getGroupEfficiencyFactor();
+
+                // accumulate group contribution from sub group
+                if (isInjector) {
+                    const Phase all[] = {Phase::WATER, Phase::OIL, Phase::GAS};
+                    bool individual_control = false;
+                    int num_group_controlled_wells = 0;
                     for (Phase phase : all) {
-                        has_guide_rate = has_guide_rate || guide_rate.has(subGroupName, phase);
+                        const Group::InjectionCMode& currentGroupControl
+                                = group_state.injection_control(subGroup.name(), phase);
+                        individual_control = individual_control || (currentGroupControl != Group::InjectionCMode::FLD
+                                && currentGroupControl != Group::InjectionCMode::NONE);
+                        num_group_controlled_wells
+                                += groupControlledWells(schedule, wellState, group_state, reportStepIdx, subGroupName, "", !isInjector, phase);
                     }
-
-                    if (!has_guide_rate) {
-                        // Accumulate from this subgroup only if no group guide rate is set for it.
+                    if (individual_control || num_group_controlled_wells == 0) {
                         for (int phase = 0; phase < np; phase++) {
-                            groupTargetReduction[phase] += subGroupEfficiency * subGroupTargetReduction[phase];
+                            reduction[phase] += subGroupEfficiency * subGroupSurfaceRates[phase];
+                        }
+                    } else {
+                        // The subgroup may participate in group control.
+                        bool has_guide_rate = false;
+                        for (Phase phase : all) {
+                            has_guide_rate = has_guide_rate || guide_rate.has(subGroupName, phase);
+                        }
+
+                        if (!has_guide_rate) {
+                            // Accumulate from this subgroup only if no group guide rate is set for it.
+                            for (int phase = 0; phase < np; phase++) {
+                                reduction[phase] += subGroupEfficiency * subGroupTargetReduction[phase];
+                            }
                         }
-                    }
-                }
-            } else {
-                const Group::ProductionCMode& currentGroupControl = group_state.production_control(subGroupName);
-                const bool individual_control = (currentGroupControl != Group::ProductionCMode::FLD
-                                                 && currentGroupControl != Group::ProductionCMode::NONE);
-                const int num_group_controlled_wells
-                    = groupControlledWells(schedule, wellState, group_state, reportStepIdx, subGroupName, "", !isInjector, /*injectionPhaseNotUsed*/Phase::OIL);
-                if (individual_control || num_group_controlled_wells == 0) {
-                    for (int phase = 0; phase < np; phase++) {
-                        groupTargetReduction[phase]
-                            += subGroupEfficiency * sumWellSurfaceRates(subGroup, schedule, wellState, reportStepIdx, phase, isInjector);
                     }
                 } else {
-                    // The subgroup may participate in group control.
-                    if (!guide_rate.has(subGroupName)) {
-                        // Accumulate from this subgroup only if no group guide rate is set for it.
+                    const Group::ProductionCMode& currentGroupControl = group_state.production_control(subGroupName);
+                    const bool individual_control = (currentGroupControl != Group::ProductionCMode::FLD
+                                                     && currentGroupControl != Group::ProductionCMode::NONE);
+                    const int num_group_controlled_wells
+                        = groupControlledWells(schedule, wellState, group_state, reportStepIdx, subGroupName, "", !isInjector, /*injectionPhaseNotUsed*/Phase::OIL);
+                    if (individual_control || num_group_controlled_wells == 0) {
                         for (int phase = 0; phase < np; phase++) {
-                            groupTargetReduction[phase] += subGroupEfficiency * subGroupTargetReduction[phase];
+                            reduction[phase] += subGroupEfficiency * subGroupSurfaceRates[phase];
+                        }
+                    } else {
+                        // The subgroup may participate in group control.
+                        if (!guide_rate.has(subGroupName)) {
+                            // Accumulate from this subgroup only if no group guide rate is set for it.
+                            for (int phase = 0; phase < np; phase++) {
+                                reduction[phase] += subGroupEfficiency * subGroupTargetReduction[phase];
+                            }
                         }
                     }
                 }
             }
-        }
 
-        for (const std::string& wellName : group.wells()) {
-            const auto& wellTmp = schedule.getWell(wellName, reportStepIdx);
+            for (const std::size_t well_index : wellState.groupWellIndices(group)) {
+                const std::string& wellName = wellState.name(well_index);
+                if (! wellState.wellIsOwned(well_index, wellName) ) // Only sum once
+                {
+                    continue;
+                }
 
-            if (wellTmp.isProducer() && isInjector)
-                continue;
+                const auto& wellTmp = schedule.getWell(wellName, reportStepIdx);
 
-            if (wellTmp.isInjector() && !isInjector)
-                continue;
+                if (wellTmp.isProducer() && isInjector)
+                    continue;
 
-            if (wellTmp.getStatus() == Well::Status::SHUT)
-                continue;
+                if (wellTmp.isInjector() && !isInjector)
+                    continue;
 
-            const auto& well_index = wellState.index(wellName);
-            if (!well_index.has_value())
-                continue;
+                if (wellTmp.getStatus() == Well::Status::SHUT)
+                    continue;
 
-            if (! wellState.wellIsOwned(well_index.value(), wellName) ) // Only sum once
-            {
-                continue;
+                const double efficiency = wellTmp.getEfficiencyFactor();
+                // add contributino from wells not under group control
+                const auto& ws = wellState.well(well_index);
+                if (isInjector) {
+                    if (ws.injection_cmode != Well::InjectorCMode::GRUP)
+                        for (int phase = 0; phase < np; phase++) {
+                            reduction[phase] += ws.surface_rates[phase] * efficiency;
+                        }
+                } else {
+                    if (ws.production_cmode != Well::ProducerCMode::GRUP)
+                        for (int phase = 0; phase < np; phase++) {
+                            reduction[phase] -= ws.surface_rates[phase] * efficiency;
+                        }
+                }
             }
+            if (isInjector)
+                group_state.update_injection_reduction_rates(group.name(), reduction);
+            else
+                group_state.update_production_reduction_rates(group.name(), reduction);
+        }
 
-            const double efficiency = wellTmp.getEfficiencyFactor();
-            // add contributino from wells not under group control
-            const auto& ws = wellState.well(well_index.value());
-            if (isInjector) {
-                if (ws.injection_cmode != Well::InjectorCMode::GRUP)
-                    for (int phase = 0; phase < np; phase++) {
-                        groupTargetReduction[phase] += ws.surface_rates[phase] * efficiency;
-                    }
-            } else {
-                if (ws.production_cmode != Well::ProducerCMode::GRUP)
-                    for (int phase = 0; phase < np; phase++) {
-                        groupTargetReduction[phase] -= ws.surface_rates[phase] * efficiency;
-                    }
-            }
+        const auto& fieldReduction = targetReductions[tree.root()];
+        for (int phase = 0; phase < np; phase++) {
+            groupTargetReduction[phase] += fieldReduction[phase];
         }
-        if (isInjector)
-            group_state.update_injection_reduction_rates(group.name(), groupTargetReduction);
-        else
-            group_state.update_production_reduction_rates(group.name(), groupTargetReduction);
     }
 
     void updateWellRatesFromGroupTargetScale(const double scale,
@@ -462,7 +593,13 @@ namespace WellGroupHelpers
         }
 
         const int np = wellState.numPhases();
-        for (const std::string& wellName : group.wells()) {
+        for (const std::size_t well_index : wellState.groupWellIndices(group)) {
+            const std::string& wellName = wellState.name(well_index);
+            if (! wellState.wellIsOwned(well_index, wellName) ) // Only sum once
+            {
+                continue;
+            }
+
             const auto& wellTmp = schedule.getWell(wellName, reportStepIdx);
 
             if (wellTmp.isProducer() && isInjector)
@@ -474,17 +611,8 @@ namespace WellGroupHelpers
             if (wellTmp.getStatus() == Well::Status::SHUT)
                 continue;
 
-            const auto& well_index = wellState.index(wellName);
-            if (!well_index.has_value())
-                continue;
-
-            if (! wellState.wellIsOwned(well_index.value(), wellName) ) // Only sum once
-            {
-                continue;
-            }
-
             // scale rates
-            auto& ws = wellState.well(well_index.value());
+            auto& ws = wellState.well(well_index);
             if (isInjector) {
                 if (ws.injection_cmode == Well::InjectorCMode::GRUP)
                     for (int phase = 0; phase < np; phase++) {
@@ -502,76 +630,49 @@ namespace WellGroupHelpers
     }
 
 
-    void updateVREPForGroups(const Group& group,
+    void updateVREPForGroups(const GroupTree& tree,
                              const Schedule& schedule,
                              const int reportStepIdx,
                              const WellState& wellState,
                              GroupState& group_state)
     {
-        for (const std::string& groupName : group.groups()) {
-            const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
-            updateVREPForGroups(groupTmp, schedule, reportStepIdx, wellState, group_state);
-        }
         const int np = wellState.numPhases();
-        double resv = 0.0;
-        for (int phase = 0; phase < np; ++phase) {
-            resv += sumWellPhaseRates(true,
-                                      group,
-                                      schedule,
-                                      wellState,
-                                      reportStepIdx,
-                                      phase,
-                                      /*isInjector*/ false);
-        }
-        group_state.update_injection_vrep_rate(group.name(), resv);
+        const auto rates = sumWellPhaseRatesInTree(true, tree, schedule, wellState, reportStepIdx, /*isInjector*/ false);
+        for (std::size_t g = 0; g < tree.size(); ++g) {
+            double resv = 0.0;
+            for (int phase = 0; phase < np; ++phase) {
+                resv += rates[np * g + phase];
+            }
+            group_state.update_injection_vrep_rate(tree.name(g), resv);
+        }
     }
 
-    void updateReservoirRatesInjectionGroups(const Group& group,
+    void updateReservoirRatesInjectionGroups(const GroupTree& tree,
                                              const Schedule& schedule,
                                              const int reportStepIdx,
                                              const WellState& wellState,
                                              GroupState& group_state)
     {
-        for (const std::string& groupName : group.groups()) {
-            const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
-            updateReservoirRatesInjectionGroups(groupTmp, schedule, reportStepIdx, wellState, group_state);
-        }
         const int np = wellState.numPhases();
-        std::vector<double> resv(np, 0.0);
-        for (int phase = 0; phase < np; ++phase) {
-            resv[phase] = sumWellPhaseRates(true,
-                                            group,
-                                            schedule,
-                                            wellState,
-                                            reportStepIdx,
-                                            phase,
-                                            /*isInjector*/ true);
-        }
-        group_state.update_injection_reservoir_rates(group.name(), resv);
+        const auto rates = sumWellPhaseRatesInTree(true, tree, schedule, wellState, reportStepIdx, /*isInjector*/ true);
+        for (std::size_t g = 0; g < tree.size(); ++g) {
+            const std::vector<double> resv(rates.begin() + np * g, rates.begin() + np * (g + 1));
+            group_state.update_injection_reservoir_rates(tree.name(g), resv);
+        }
     }
 
-    void updateSurfaceRatesInjectionGroups(const Group& group,
+    void updateSurfaceRatesInjectionGroups(const GroupTree& tree,
                                            const Schedule& schedule,
                                            const int reportStepIdx,
                                            const WellState& wellState,
                                            GroupState& group_state)
     {
-        for (const std::string& groupName : group.groups()) {
-            const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
-            updateSurfaceRatesInjectionGroups(groupTmp, schedule, reportStepIdx, wellState, group_state);
-        }
         const int np = wellState.numPhases();
-        std::vector<double> rates(np, 0.0);
-        for (int phase = 0; phase < np; ++phase) {
-            rates[phase] = sumWellPhaseRates(false,
-                                            group,
-                                            schedule,
-                                            wellState,
-                                            reportStepIdx,
-                                            phase,
-                                            /*isInjector*/ true);
-        }
-        group_state.update_injection_surface_rates(group.name(), rates);
+        const auto rates = sumWellPhaseRatesInTree(false, tree, schedule, wellState, reportStepIdx, /*isInjector*/ true);
+        for (std::size_t g = 0; g < tree.size(); ++g) {
+            const std::vector<double> surface_rates(rates.begin() + np * g, rates.begin() + np * (g + 1));
+            group_state.update_injection_surface_rates(tree.name(g), surface_rates);
+        }
     }
 
     void updateWellRates(const Group& group,
@@ -604,26 +705,22 @@ namespace WellGroupHelpers
         }
     }
 
-    void updateGroupProductionRates(const Group& group,
+    void updateGroupProductionRates(const GroupTree& tree,
                                     const Schedule& schedule,
                                     const int reportStepIdx,
                                     const WellState& wellState,
                                     GroupState& group_state)
     {
-        for (const std::string& groupName : group.groups()) {
-            const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
-            updateGroupProductionRates(groupTmp, schedule, reportStepIdx, wellState, group_state);
-        }
         const int np = wellState.numPhases();
-        std::vector<double> rates(np, 0.0);
-        for (int phase = 0; phase < np; ++phase) {
-            rates[phase] = sumWellPhaseRates(false, group, schedule, wellState, reportStepIdx, phase, /*isInjector*/ false);
+        const auto rates = sumWellPhaseRatesInTree(false, tree, schedule, wellState, reportStepIdx, /*isInjector*/ false);
+        for (std::size_t g = 0; g < tree.size(); ++g) {
+            const std::vector<double> group_rates(rates.begin() + np * g, rates.begin() + np * (g + 1));
+            group_state.update_production_rates(tree.name(g), group_rates);
         }
-        group_state.update_production_rates(group.name(), rates);
     }
 
 
-    void updateREINForGroups(const Group& group,
+    void updateREINForGroups(const GroupTree& tree,
                              const Schedule& schedule,
                              const int reportStepIdx,
                              const PhaseUsage& pu,
@@ -632,26 +729,22 @@ namespace WellGroupHelpers
                              GroupState& group_state)
     {
         const int np = wellState.numPhases();
-        for (const std::string& groupName : group.groups()) {
-            const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
-            updateREINForGroups(groupTmp, schedule, reportStepIdx, pu, st, wellState, group_state);
-        }
-
-        std::vector<double> rein(np, 0.0);
-        for (int phase = 0; phase < np; ++phase) {
-            rein[phase] = sumWellPhaseRates(false, group, schedule, wellState, reportStepIdx, phase, /*isInjector*/ false);
-        }
-
-        // add import rate and subtract consumption rate for group for gas
-        if (schedule[reportStepIdx].gconsump().has(group.name())) {
-            const auto& gconsump = schedule[reportStepIdx].gconsump().get(group.name(), st);
-            if (pu.phase_used[BlackoilPhases::Vapour]) {
-                rein[pu.phase_pos[BlackoilPhases::Vapour]] += gconsump.import_rate;
-                rein[pu.phase_pos[BlackoilPhases::Vapour]] -= gconsump.consumption_rate;
+        const auto rates = sumWellPhaseRatesInTree(false, tree, schedule, wellState, reportStepIdx, /*isInjector*/ false);
+        for (std::size_t g = 0; g < tree.size(); ++g) {
+            const std::string& groupName = tree.name(g);
+            std::vector<double> rein(rates.begin() + np * g, rates.begin() + np * (g + 1));
+
+            // add import rate and subtract consumption rate for group for gas
+            if (schedule[reportStepIdx].gconsump().has(groupName)) {
+                const auto& gconsump = schedule[reportStepIdx].gconsump().get(groupName, st);
+                if (pu.phase_used[BlackoilPhases::Vapour]) {
+                    rein[pu.phase_pos[BlackoilPhases::Vapour]] += gconsump.import_rate;
+                    rein[pu.phase_pos[BlackoilPhases::Vapour]] -= gconsump.consumption_rate;
+                }
             }
-        }
 
-        group_state.update_injection_rein_rates(group.name(), rein);
+            group_state.update_injection_rein_rates(groupName, rein);
+        }
     }
 
 
@@ -676,47 +769,13 @@ namespace WellGroupHelpers
         // Let us first find all leaf nodes of the network. We also
         // create a vector of all nodes, ordered so that a child is
         // always after its parent.
-        std::stack<std::string> children;
         std::set<std::string> leaf_nodes;
-        std::vector<std::string> root_to_child_nodes;
-        children.push(network.root().name());
-        while (!children.empty()) {
-            const auto node = children.top();
-            children.pop();
-            root_to_child_nodes.push_back(node);
-            auto branches = network.downtree_branches(node);
-            if (branches.empty()) {
-                leaf_nodes.insert(node);
-            }
-            for (const auto& branch : branches) {
-                children.push(branch.downtree_node());
-            }
-        }
-        assert(children.empty());
+        const auto root_to_child_nodes = networkNodesRootToChild(network, leaf_nodes);
 
         // Starting with the leaf nodes of the network, get the flow rates
         // from the corresponding groups.
-        std::map<std::string, std::vector<double>> node_inflows;
-        for (const auto& node : leaf_nodes) {
-            node_inflows[node] = group_state.production_rates(node);
-            // Add the ALQ amounts to the gas rates if requested.
-            if (network.node(node).add_gas_lift_gas()) {
-                const auto& group = schedule.getGroup(node, report_time_step);
-                for (const std::string& wellname : group.wells()) {
-                    const Well& well = schedule.getWell(wellname, report_time_step);
-                    // Here we use the efficiency unconditionally, but if WEFAC item 3
-                    // for the well is false (it defaults to true) then we should NOT use
-                    // the efficiency factor. Fixing this requires not only changing the
-                    // code here, but also:
-                    //    - Adding a member to the well for this flag, and setting it in Schedule::handleWEFAC().
-                    //    - Making the wells' maximum flows (i.e. not time-averaged by using a efficiency factor)
-                    //      available and using those (for wells with WEFAC(3) true only) when accumulating group
-                    //      rates, but ONLY for network calculations.
-                    const double efficiency = well.getEfficiencyFactor();
-                    node_inflows[node][BlackoilPhases::Vapour] += well_state.getALQ(wellname) * efficiency;
-                }
-            }
-        }
+        auto node_inflows = networkLeafInflows(network, leaf_nodes, well_state, group_state,
+                                               schedule, report_time_step);
 
         // Accumulate in the network, towards the roots. Note that a
         // root (i.e. fixed pressure node) can still be contributing
@@ -752,36 +811,119 @@ namespace WellGroupHelpers
                 const auto upbranch = network.uptree_branch(node);
                 assert(upbranch);
                 const double up_press = node_pressures[(*upbranch).uptree_node()];
-                const auto vfp_table = (*upbranch).vfp_table();
-                if (vfp_table) {
-                    // The rates are here positive, but the VFP code expects the
-                    // convention that production rates are negative, so we must
-                    // take a copy and flip signs.
-                    auto rates = node_inflows[node];
-                    for (auto& r : rates) { r *= -1.0; }
-                    assert(rates.size() == 3);
-                    const double alq = 0.0; // TODO: Do not ignore ALQ
-                    node_pressures[node] = vfp_prod_props.bhp(*vfp_table,
-                                                              rates[BlackoilPhases::Aqua],
-                                                              rates[BlackoilPhases::Liquid],
-                                                              rates[BlackoilPhases::Vapour],
-                                                              up_press,
-                                                              alq);
+                node_pressures[node] = networkBranchPressure(*upbranch, node_inflows[node],
+                                                             up_press, vfp_prod_props);
 #define EXTRA_DEBUG_NETWORK 0
 #if EXTRA_DEBUG_NETWORK
-                    std::ostringstream oss;
-                    oss << "parent: " << (*upbranch).uptree_node() << "  child: " << node
-                        << "  rates = [ " << rates[0]*86400 << ", " << rates[1]*86400 << ", " << rates[2]*86400 << " ]"
-                        << "  p(parent) = " << up_press/1e5 << "  p(child) = " << node_pressures[node]/1e5 << std::endl;
-                    OpmLog::debug(oss.str());
+                const auto& rates = node_inflows[node];
+                std::ostringstream oss;
+                oss << "parent: " << (*upbranch).uptree_node() << "  child: " << node
+                    << "  rates = [ " << rates[0]*86400 << ", " << rates[1]*86400 << ", " << rates[2]*86400 << " ]"
+                    << "  p(parent) = " << up_press/1e5 << "  p(child) = " << node_pressures[node]/1e5 << std::endl;
+                OpmLog::debug(oss.str());
 #endif
-                } else {
-                    // Table number specified as 9999 in the deck, no pressure loss.
-                    node_pressures[node] = up_press;
+            }
+        }
+
+        return node_pressures;
+    }
+
+    std::map<std::string, double>
+    computeNetworkPressuresCoupled(const Opm::Network::ExtNetwork& network,
+                                   const WellState& well_state,
+                                   const GroupState& group_state,
+                                   const VFPProdProperties& vfp_prod_props,
+                                   const Schedule& schedule,
+                                   const int report_time_step,
+                                   const std::map<std::string, double>& previous_pressures,
+                                   std::map<std::string, NetworkLeafInflow>& leaf_history)
+    {
+        // The sweep gives the pressures for the current rates, it is the
+        // initial guess of the coupled solve.
+        auto node_pressures = computeNetworkPressures(network, well_state, group_state,
+                                                      vfp_prod_props, schedule, report_time_step);
+        if (node_pressures.empty()) {
+            return node_pressures;
+        }
+
+        std::set<std::string> leaf_nodes;
+        const auto root_to_child_nodes = networkNodesRootToChild(network, leaf_nodes);
+        const auto leaf_inflows = networkLeafInflows(network, leaf_nodes, well_state, group_state,
+                                                     schedule, report_time_step);
+
+        // The group rates are the response of the wells to the pressures of
+        // the previous call. Together with the response to the pressures of an
+        // earlier call they give a secant approximation of the derivative of
+        // the inflow of each leaf with respect to its pressure.
+        const double min_pressure_change = 1.0e-3 * unit::barsa;
+        std::map<std::string, int> node_index;
+        std::vector<NetworkPressureSolver::Node> nodes(root_to_child_nodes.size());
+        bool coupled = false;
+        for (std::size_t i = 0; i < root_to_child_nodes.size(); ++i) {
+            const auto& name = root_to_child_nodes[i];
+            auto& node = nodes[i];
+            node_index[name] = i;
+            node.fixed_pressure = network.node(name).terminal_pressure();
+            if (const auto upbranch = network.uptree_branch(name); upbranch) {
+                node.parent = node_index.at((*upbranch).uptree_node());
+            }
+            if (leaf_nodes.count(name) == 0) {
+                continue;
+            }
+
+            const auto& rates = leaf_inflows.at(name);
+            assert(rates.size() == 3);
+            std::copy(rates.begin(), rates.end(), node.inflow.begin());
+            const auto prev = previous_pressures.find(name);
+            if (prev == previous_pressures.end()) {
+                node.reference_pressure = node_pressures[name];
+                continue;
+            }
+            node.reference_pressure = prev->second;
+
+            auto hist = leaf_history.find(name);
+            if (hist == leaf_history.end()) {
+                leaf_history[name] = {node.reference_pressure, rates, {0.0, 0.0, 0.0}};
+                continue;
+            }
+            auto& leaf = hist->second;
+            const double dp = node.reference_pressure - leaf.pressure;
+            if (std::abs(dp) > min_pressure_change) {
+                for (std::size_t p = 0; p < rates.size(); ++p) {
+                    // A higher node pressure cannot increase the production.
+                    leaf.derivative[p] = std::min((rates[p] - leaf.rates[p]) / dp, 0.0);
                 }
+                leaf.pressure = node.reference_pressure;
+                leaf.rates = rates;
             }
+            std::copy(leaf.derivative.begin(), leaf.derivative.end(), node.inflow_derivative.begin());
+            coupled = coupled || std::any_of(leaf.derivative.begin(), leaf.derivative.end(),
+                                             [](const double d) { return d < 0.0; });
+        }
+        if (!coupled) {
+            return node_pressures;
         }
 
+        auto branch_pressure = [&network, &root_to_child_nodes, &vfp_prod_props]
+            (const int node, const NetworkPressureSolver::Rates& rates, const double up_press)
+        {
+            const auto upbranch = network.uptree_branch(root_to_child_nodes[node]);
+            return networkBranchPressure(*upbranch, std::vector<double>(rates.begin(), rates.end()),
+                                         up_press, vfp_prod_props);
+        };
+        NetworkPressureSolver solver(std::move(nodes), branch_pressure);
+        std::vector<double> pressures;
+        for (const auto& name : root_to_child_nodes) {
+            pressures.push_back(node_pressures[name]);
+        }
+        const double tolerance = 1.0e-3 * unit::barsa;
+        const int max_iterations = 20;
+        if (solver.solve(pressures, tolerance, max_iterations)) {
+            for (std::size_t i = 0; i < root_to_child_nodes.size(); ++i) {
+                node_pressures[root_to_child_nodes[i]] = pressures[i];
+            }
+        }
+        // Otherwise keep the pressures of the sweep.
         return node_pressures;
     }
 
@@ -1027,6 +1169,19 @@ namespace WellGroupHelpers
         return total_guide_rate;
     }
     double FractionCalculator::guideRate(const std::string& name, const std::string& always_included_child)
+    {
+        // The guide rates of the siblings are needed again for every level of
+        // the group chain, and those of default groups recurse down the tree.
+        CacheKey key{name, always_included_child};
+        const auto it = guide_rates_.find(key);
+        if (it != guide_rates_.end()) {
+            return it->second;
+        }
+        const double guide_rate = computeGuideRate(name, always_included_child);
+        guide_rates_.emplace(std::move(key), guide_rate);
+        return guide_rate;
+    }
+    double FractionCalculator::computeGuideRate(const std::string& name, const std::string& always_included_child)
     {
         if (schedule_.hasWell(name, report_step_)) {
             return guide_rate_->get(name, target_, getWellRateVector(well_state_, pu_, name));
@@ -1052,8 +1207,15 @@ namespace WellGroupHelpers
     int FractionCalculator::groupControlledWells(const std::string& group_name,
                                                  const std::string& always_included_child)
     {
-        return ::Opm::WellGroupHelpers::groupControlledWells(
+        CacheKey key{group_name, always_included_child};
+        const auto it = group_controlled_wells_.find(key);
+        if (it != group_controlled_wells_.end()) {
+            return it->second;
+        }
+        const int num_wells = ::Opm::WellGroupHelpers::groupControlledWells(
                                                              schedule_, well_state_, this->group_state_, report_step_, group_name, always_included_child, is_producer_, injection_phase_);
+        group_controlled_wells_.emplace(std::move(key), num_wells);
+        return num_wells;
     }
 
     GuideRate::RateVector FractionCalculator::getGroupRateVector(const std::string& group_name)
@@ -1186,6 +1348,23 @@ namespace WellGroupHelpers
             }
         }
 
+        // The number of group controlled wells below a group of the chain does not depend
+        // on the level we reduce the target at, so count them once per group.
+        std::vector<int> chain_group_controlled_wells(num_ancestors, -1);
+        auto numGroupControlledWells = [&](const size_t level) {
+            if (chain_group_controlled_wells[level] < 0) {
+                chain_group_controlled_wells[level] = groupControlledWells(schedule,
+                                                                           wellState,
+                                                                           group_state,
+                                                                           reportStepIdx,
+                                                                           chain[level],
+                                                                           "",
+                                                                           /*is_producer*/ true,
+                                                                           /*injectionPhaseNotUsed*/ Phase::OIL);
+            }
+            return chain_group_controlled_wells[level];
+        };
+
         // check whether guide rate is violated
         if (local_reduction_level > 0) {
             const auto& guided_group = chain[local_reduction_level];
@@ -1229,14 +1408,7 @@ namespace WellGroupHelpers
                     // the current well to be always included, because we
                     // want to know the situation that applied to the
                     // calculation of reductions.
-                    const int num_gr_ctrl = groupControlledWells(schedule,
-                                                                 wellState,
-                                                                 group_state,
-                                                                 reportStepIdx,
-                                                                 chain[iii],
-                                                                 "",
-                                                                 /*is_producer*/ true,
-                                                                 /*injectionPhaseNotUsed*/ Phase::OIL);
+                    const int num_gr_ctrl = numGroupControlledWells(iii);
                     if (num_gr_ctrl == 0) {
                         // We found a sub wells with no group controlled wells. We now need to adapt the reduction rate
                         // to reflect what would have happen if the current well under consideration would have been
@@ -1364,6 +1536,23 @@ namespace WellGroupHelpers
             }
         }
 
+        // The number of group controlled wells below a group of the chain does not depend
+        // on the level we reduce the target at, so count them once per group.
+        std::vector<int> chain_group_controlled_wells(num_ancestors, -1);
+        auto numGroupControlledWells = [&](const size_t level) {
+            if (chain_group_controlled_wells[level] < 0) {
+                chain_group_controlled_wells[level] = groupControlledWells(schedule,
+                                                                           wellState,
+                                                                           group_state,
+                                                                           reportStepIdx,
+                                                                           chain[level],
+                                                                           "",
+                                                                           /*is_producer*/ false,
+                                                                           injectionPhase);
+            }
+            return chain_group_controlled_wells[level];
+        };
+
         // check whether guide rate is violated
         if (local_reduction_level > 0) {
             const auto& guided_group = chain[local_reduction_level];
@@ -1407,14 +1596,7 @@ namespace WellGroupHelpers
                     // the current well to be always included, because we
                     // want to know the situation that applied to the
                     // calculation of reductions.
-                    const int num_gr_ctrl = groupControlledWells(schedule,
-                                                                 wellState,
-                                                                 group_state,
-                                                                 reportStepIdx,
-                                                                 chain[iii],
-                                                                 "",
-                                                                 /*is_producer*/ false,
-                                                                 injectionPhase);
+                    const int num_gr_ctrl = numGroupControlledWells(iii);
                     if (num_gr_ctrl == 0) {
                         // We found a sub wells with no group controlled wells. We now need to adapt the reduction rate
                         // to reflect what would have happen if the well under consideration would have been
@@ -1480,6 +1662,33 @@ namespace WellGroupHelpers
                                             const Comm& comm,
                                             GuideRate* guideRate,
                                             std::vector<double>& pot)
+    {
+        // The local potentials of all groups are summed over the processes at once,
+        // instead of one collective call per group.
+        std::vector<std::string> groupNames;
+        std::vector<double> potentials;
+        accumulateProductionGroupPotentials(group, schedule, pu, reportStepIdx, wellState,
+                                            group_state, pot, groupNames, potentials);
+        comm.sum(potentials.data(), potentials.size());
+
+        const UnitSystem& unit_system = schedule.getUnits();
+        for (std::size_t g = 0; g < groupNames.size(); ++g) {
+            const double oilPot = unit_system.from_si(UnitSystem::measure::liquid_surface_rate, potentials[3*g]);
+            const double gasPot = unit_system.from_si(UnitSystem::measure::gas_surface_rate, potentials[3*g + 1]);
+            const double waterPot = unit_system.from_si(UnitSystem::measure::liquid_surface_rate, potentials[3*g + 2]);
+            guideRate->compute(groupNames[g], reportStepIdx, simTime, oilPot, gasPot, waterPot);
+        }
+    }
+
+    void accumulateProductionGroupPotentials(const Group& group,
+                                             const Schedule& schedule,
+                                             const PhaseUsage& pu,
+                                             const int reportStepIdx,
+                                             const WellState& wellState,
+                                             const GroupState& group_state,
+                                             std::vector<double>& pot,
+                                             std::vector<std::string>& groupNames,
+                                             std::vector<double>& potentials)
     {
         const int np = pu.num_phases;
         for (const std::string& groupName : group.groups()) {
@@ -1487,7 +1696,8 @@ namespace WellGroupHelpers
             const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
 
             // Note that group effiency factors for groupTmp are applied in updateGuideRateForGroups
-            updateGuideRateForProductionGroups(groupTmp, schedule, pu, reportStepIdx, simTime, wellState, group_state, comm, guideRate, thisPot);
+            accumulateProductionGroupPotentials(groupTmp, schedule, pu, reportStepIdx, wellState,
+                                                group_state, thisPot, groupNames, potentials);
 
             // accumulate group contribution from sub group unconditionally
             const auto currentGroupControl = group_state.production_control(groupName);
@@ -1504,7 +1714,13 @@ namespace WellGroupHelpers
             }
 
         }
-        for (const std::string& wellName : group.wells()) {
+        for (const std::size_t well_index : wellState.groupWellIndices(group)) {
+            const std::string& wellName = wellState.name(well_index);
+            if (! wellState.wellIsOwned(well_index, wellName) ) // Only sum once
+            {
+                continue;
+            }
+
             const auto& wellTmp = schedule.getWell(wellName, reportStepIdx);
             const auto wefac = wellTmp.getEfficiencyFactor();
 
@@ -1513,39 +1729,19 @@ namespace WellGroupHelpers
 
             if (wellTmp.getStatus() == Well::Status::SHUT)
                 continue;
-            const auto& well_index = wellState.index(wellName);
-            if (!well_index.has_value()) // the well is not found
-                continue;
 
-            if (! wellState.wellIsOwned(well_index.value(), wellName) ) // Only sum once
-            {
-                continue;
-            }
-
-            const auto& ws = wellState.well(well_index.value());
+            const auto& ws = wellState.well(well_index);
             // add contribution from wells unconditionally
             for (int phase = 0; phase < np; phase++) {
                 pot[phase] += wefac * ws.well_potentials[phase];
             }
         }
 
-        std::array<double,3> potentials{};
-        auto& [oilPot, gasPot, waterPot] = potentials;
-        if (pu.phase_used[BlackoilPhases::Liquid])
-            oilPot = pot[pu.phase_pos[BlackoilPhases::Liquid]];
-
-        if (pu.phase_used[BlackoilPhases::Vapour])
-            gasPot = pot[pu.phase_pos[BlackoilPhases::Vapour]];
-
-        if (pu.phase_used[BlackoilPhases::Aqua])
-            waterPot = pot[pu.phase_pos[BlackoilPhases::Aqua]];
-
-        comm.sum(potentials.data(), potentials.size());
-        const UnitSystem& unit_system = schedule.getUnits();
-        oilPot = unit_system.from_si(UnitSystem::measure::liquid_surface_rate, oilPot);
-        waterPot = unit_system.from_si(UnitSystem::measure::liquid_surface_rate, waterPot);
-        gasPot = unit_system.from_si(UnitSystem::measure::gas_surface_rate, gasPot);
-        guideRate->compute(group.name(), reportStepIdx, simTime, oilPot, gasPot, waterPot);
+        // the local oil, gas and water potentials of the group
+        groupNames.push_back(group.name());
+        potentials.push_back(pu.phase_used[BlackoilPhases::Liquid] ? pot[pu.phase_pos[BlackoilPhases::Liquid]] : 0.0);
+        potentials.push_back(pu.phase_used[BlackoilPhases::Vapour] ? pot[pu.phase_pos[BlackoilPhases::Vapour]] : 0.0);
+        potentials.push_back(pu.phase_used[BlackoilPhases::Aqua] ? pot[pu.phase_pos[BlackoilPhases::Aqua]] : 0.0);
     }
 
     template <class Comm>
@@ -1557,31 +1753,35 @@ namespace WellGroupHelpers
                                   const Comm& comm,
                                   GuideRate* guideRate)
     {
-        for (const auto& well : schedule.getWells(reportStepIdx)) {
-            std::array<double,3> potentials{};
-            auto& [oilpot, gaspot, waterpot] = potentials;
-
-            const auto& well_index = wellState.index(well.name());
-            if (well_index.has_value() && wellState.wellIsOwned(well_index.value(), well.name()))
+        // The potentials of all wells are summed over the processes at once,
+        // instead of one collective call per well.
+        const auto& wells = schedule.getWells(reportStepIdx);
+        std::vector<double> potentials(3*wells.size(), 0.0);
+        for (std::size_t w = 0; w < wells.size(); ++w) {
+            const auto& well_index = wellState.index(wells[w].name());
+            if (well_index.has_value() && wellState.wellIsOwned(well_index.value(), wells[w].name()))
             {
                 // the well is found and owned
                 const auto& ws = wellState.well(well_index.value());
                 const auto& wpot = ws.well_potentials;
                 if (pu.phase_used[BlackoilPhases::Liquid] > 0)
-                    oilpot = wpot[pu.phase_pos[BlackoilPhases::Liquid]];
+                    potentials[3*w] = wpot[pu.phase_pos[BlackoilPhases::Liquid]];
 
                 if (pu.phase_used[BlackoilPhases::Vapour] > 0)
-                    gaspot = wpot[pu.phase_pos[BlackoilPhases::Vapour]];
+                    potentials[3*w + 1] = wpot[pu.phase_pos[BlackoilPhases::Vapour]];
 
                 if (pu.phase_used[BlackoilPhases::Aqua] > 0)
-                    waterpot = wpot[pu.phase_pos[BlackoilPhases::Aqua]];
+                    potentials[3*w + 2] = wpot[pu.phase_pos[BlackoilPhases::Aqua]];
             }
-            comm.sum(potentials.data(), potentials.size());
-            const UnitSystem& unit_system = schedule.getUnits();
-            oilpot = unit_system.from_si(UnitSystem::measure::liquid_surface_rate, oilpot);
-            waterpot = unit_system.from_si(UnitSystem::measure::liquid_surface_rate, waterpot);
-            gaspot = unit_system.from_si(UnitSystem::measure::gas_surface_rate, gaspot);
-            guideRate->compute(well.name(), reportStepIdx, simTime, oilpot, gaspot, waterpot);
+        }
+        comm.sum(potentials.data(), potentials.size());
+
+        const UnitSystem& unit_system = schedule.getUnits();
+        for (std::size_t w = 0; w < wells.size(); ++w) {
+            const double oilpot = unit_system.from_si(UnitSystem::measure::liquid_surface_rate, potentials[3*w]);
+            const double gaspot = unit_system.from_si(UnitSystem::measure::gas_surface_rate, potentials[3*w + 1]);
+            const double waterpot = unit_system.from_si(UnitSystem::measure::liquid_surface_rate, potentials[3*w + 2]);
+            guideRate->compute(wells[w].name(), reportStepIdx, simTime, oilpot, gaspot, waterpot);
         }
     }
 
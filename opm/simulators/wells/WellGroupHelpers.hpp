@@ -30,6 +30,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Opm
@@ -38,6 +39,7 @@ namespace Opm
 class DeferredLogger;
 class Group;
 class GroupState;
+class GroupTree;
 namespace Network { class ExtNetwork; }
 struct PhaseUsage;
 class Schedule;
@@ -86,7 +88,7 @@ namespace WellGroupHelpers
                            const int reportStepIdx,
                            const bool injector);
 
-    void updateGroupTargetReduction(const Group& group,
+    void updateGroupTargetReduction(const GroupTree& tree,
                                     const Schedule& schedule,
                                     const int reportStepIdx,
                                     const bool isInjector,
@@ -122,6 +124,18 @@ namespace WellGroupHelpers
                                             GuideRate* guideRate,
                                             std::vector<double>& pot);
 
+    /// Add the local production potentials of group to pot, and append the local
+    /// oil, gas and water potentials of group and all its subgroups, subgroups first.
+    void accumulateProductionGroupPotentials(const Group& group,
+                                             const Schedule& schedule,
+                                             const PhaseUsage& pu,
+                                             const int reportStepIdx,
+                                             const WellState& wellState,
+                                             const GroupState& group_state,
+                                             std::vector<double>& pot,
+                                             std::vector<std::string>& groupNames,
+                                             std::vector<double>& potentials);
+
     template <class Comm>
     void updateGuideRatesForWells(const Schedule& schedule,
                                   const PhaseUsage& pu,
@@ -141,19 +155,19 @@ namespace WellGroupHelpers
                                             GuideRate* guideRate,
                                             Opm::DeferredLogger& deferred_logger);
 
-    void updateVREPForGroups(const Group& group,
+    void updateVREPForGroups(const GroupTree& tree,
                              const Schedule& schedule,
                              const int reportStepIdx,
                              const WellState& wellState,
                              GroupState& group_state);
 
-    void updateReservoirRatesInjectionGroups(const Group& group,
+    void updateReservoirRatesInjectionGroups(const GroupTree& tree,
                                              const Schedule& schedule,
                                              const int reportStepIdx,
                                              const WellState& wellState,
                                              GroupState& group_state);
 
-    void updateSurfaceRatesInjectionGroups(const Group& group,
+    void updateSurfaceRatesInjectionGroups(const GroupTree& tree,
                                            const Schedule& schedule,
                                            const int reportStepIdx,
                                            const WellState& wellState,
@@ -165,7 +179,7 @@ namespace WellGroupHelpers
                          const WellState& wellStateNupcol,
                          WellState& wellState);
 
-    void updateGroupProductionRates(const Group& group,
+    void updateGroupProductionRates(const GroupTree& tree,
                                     const Schedule& schedule,
                                     const int reportStepIdx,
                                     const WellState& wellState,
@@ -179,7 +193,7 @@ namespace WellGroupHelpers
                                              const GroupState& group_state,
                                              WellState& wellState);
 
-    void updateREINForGroups(const Group& group,
+    void updateREINForGroups(const GroupTree& tree,
                              const Schedule& schedule,
                              const int reportStepIdx,
                              const PhaseUsage& pu,
@@ -273,6 +287,29 @@ namespace WellGroupHelpers
                             const Schedule& schedule,
                             const int report_time_step);
 
+    /// Inflow of a leaf node of the network, the node pressure it was
+    /// produced against and its estimated derivative with respect to that pressure
+    struct NetworkLeafInflow
+    {
+        double pressure;
+        std::vector<double> rates;
+        std::vector<double> derivative;
+    };
+
+    /// Solve for the pressures of all network nodes simultaneously, using the
+    /// response of the leaf inflows to the pressures of previous calls.
+    /// \param[in] previous_pressures   the node pressures the current rates were produced against
+    /// \param[in,out] leaf_history     the inflow of every leaf at an earlier pressure
+    std::map<std::string, double>
+    computeNetworkPressuresCoupled(const Opm::Network::ExtNetwork& network,
+                                   const WellState& well_state,
+                                   const GroupState& group_state,
+                                   const VFPProdProperties& vfp_prod_props,
+                                   const Schedule& schedule,
+                                   const int report_time_step,
+                                   const std::map<std::string, double>& previous_pressures,
+                                   std::map<std::string, NetworkLeafInflow>& leaf_history);
+
     GuideRate::RateVector
     getWellRateVector(const WellState& well_state, const PhaseUsage& pu, const std::string& name);
 
@@ -328,8 +365,10 @@ namespace WellGroupHelpers
         std::string parent(const std::string& name);
         double guideRateSum(const Group& group, const std::string& always_included_child);
         double guideRate(const std::string& name, const std::string& always_included_child);
+        double computeGuideRate(const std::string& name, const std::string& always_included_child);
         int groupControlledWells(const std::string& group_name, const std::string& always_included_child);
         GuideRate::RateVector getGroupRateVector(const std::string& group_name);
+        using CacheKey = std::pair<std::string, std::string>;
         const Schedule& schedule_;
         const WellState& well_state_;
         const GroupState& group_state_;
@@ -339,6 +378,11 @@ namespace WellGroupHelpers
         const PhaseUsage& pu_;
         bool is_producer_;
         Phase injection_phase_;
+        // The guide rates and numbers of group controlled wells already computed,
+        // by name and always included child. A calculator only lives for one
+        // group constraint evaluation, during which the states do not change.
+        std::map<CacheKey, double> guide_rates_;
+        std::map<CacheKey, int> group_controlled_wells_;
     };
 
 
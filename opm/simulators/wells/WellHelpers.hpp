@@ -33,6 +33,11 @@
 #include <dune/common/dynmatrix.hh>
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace Opm {
@@ -156,6 +161,128 @@ namespace Opm {
 
 
 
+        /// \brief Safeguarded Newton solve of f(x) = 0 in the bracket [low, high]
+        ///
+        /// The values f_low and f_high at the end points are passed in, such
+        /// that callers solving several equations in the same bracket only
+        /// evaluate them once. The slope of every Newton step is the secant
+        /// through the two latest points, and a bisection step is taken when
+        /// the Newton step leaves the bracket or does not halve the residual.
+        /// The first iterate is the guess if it lies inside the bracket,
+        /// otherwise the secant point of the end points, which is the root
+        /// if f is linear.
+        ///
+        /// \return the x with |f(x)| < tolerance, or an empty optional if
+        ///         [low, high] does not bracket a root or the solve did not
+        ///         converge within max_iteration evaluations of f
+        template <class Func>
+        std::optional<double> bracketedNewton(const Func& f,
+                                              double low, double high,
+                                              double f_low, double f_high,
+                                              const std::optional<double>& guess,
+                                              const double tolerance,
+                                              const int max_iteration)
+        {
+            if (std::fabs(f_low) < tolerance) {
+                return low;
+            }
+            if (std::fabs(f_high) < tolerance) {
+                return high;
+            }
+            if ((f_low < 0.0) == (f_high < 0.0)) {
+                return std::nullopt;
+            }
+
+            double x = low - f_low * (high - low) / (f_high - f_low);
+            if (guess.has_value() && *guess > low && *guess < high) {
+                x = *guess;
+            }
+            // the second point of the secant, initially the nearest end point
+            double x_prev = (x - low < high - x) ? low : high;
+            double f_prev = (x_prev == low) ? f_low : f_high;
+            double last_residual = std::max(std::fabs(f_low), std::fabs(f_high));
+
+            for (int iteration = 0; iteration < max_iteration; ++iteration) {
+                const double fx = f(x);
+                if (std::fabs(fx) < tolerance) {
+                    return x;
+                }
+                if ((fx < 0.0) == (f_low < 0.0)) {
+                    low = x;
+                    f_low = fx;
+                } else {
+                    high = x;
+                    f_high = fx;
+                }
+
+                double x_new = 0.5 * (low + high);
+                if (x != x_prev && fx != f_prev && std::fabs(fx) <= 0.5 * last_residual) {
+                    const double newton = x - fx * (x - x_prev) / (fx - f_prev);
+                    if (newton > low && newton < high) {
+                        x_new = newton;
+                    }
+                }
+                x_prev = x;
+                f_prev = fx;
+                last_residual = std::fabs(fx);
+                x = x_new;
+            }
+            return std::nullopt;
+        }
+
+
+        /// \brief Add the connections between all cells of every well to the
+        ///        neighbour sets of the sparsity pattern of the Jacobian.
+        ///
+        /// The naive insertion of all cells of a well into the set of each
+        /// of its cells costs a search per pair of cells. Here the cells of
+        /// every well are sorted once and inserted in increasing order with
+        /// a hint, which takes amortised constant time where the set has no
+        /// entries in between. The neighbour sets of different cells are
+        /// filled by different threads.
+        ///
+        /// \param well_cells  the cells of every well, in any order
+        /// \param neighbors   the neighbour set of every cell
+        template <class NeighborSet>
+        void addWellNeighbors(std::vector<std::vector<int>> well_cells,
+                              std::vector<NeighborSet>& neighbors)
+        {
+            // (cell, well) for every perforated cell, grouped by cell
+            std::vector<std::pair<int, int>> cell_wells;
+            for (std::size_t w = 0; w < well_cells.size(); ++w) {
+                auto& cells = well_cells[w];
+                std::sort(cells.begin(), cells.end());
+                cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+                for (const int cell : cells) {
+                    cell_wells.emplace_back(cell, w);
+                }
+            }
+            std::sort(cell_wells.begin(), cell_wells.end());
+            std::vector<std::size_t> group_start;
+            for (std::size_t k = 0; k < cell_wells.size(); ++k) {
+                if (k == 0 || cell_wells[k].first != cell_wells[k - 1].first) {
+                    group_start.push_back(k);
+                }
+            }
+            group_start.push_back(cell_wells.size());
+
+            const int num_groups = group_start.size() - 1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+            for (int g = 0; g < num_groups; ++g) {
+                auto& set = neighbors[cell_wells[group_start[g]].first];
+                for (std::size_t k = group_start[g]; k < group_start[g + 1]; ++k) {
+                    auto hint = set.begin();
+                    for (const int cell : well_cells[cell_wells[k].second]) {
+                        hint = set.insert(hint, cell);
+                        ++hint;
+                    }
+                }
+            }
+        }
+
+
         /// \brief Sums entries of the diagonal Matrix for distributed wells
         template<typename Scalar, typename Comm>
         void sumDistributedWellEntries(Dune::DynamicMatrix<Scalar>& mat, Dune::DynamicVector<Scalar>& vec,
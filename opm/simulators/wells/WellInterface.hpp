@@ -60,6 +60,7 @@ namespace Opm {
 #include <opm/simulators/timestepping/ConvergenceReport.hpp>
 
 #include <cassert>
+#include <optional>
 #include <vector>
 
 namespace Opm
@@ -150,6 +151,10 @@ public:
 
     virtual void initPrimaryVariablesEvaluation() const = 0;
 
+    /// Reset what a time step changed, such that the object can be kept for
+    /// the next time step of the same report step. init() must be called afterwards.
+    void resetForNewTimeStep();
+
     virtual ConvergenceReport getWellConvergence(const WellState& well_state, const std::vector<double>& B_avg, DeferredLogger& deferred_logger, const bool relax_tolerance) const = 0;
 
     virtual void solveEqAndUpdateWellState(WellState& well_state, DeferredLogger& deferred_logger) = 0;
@@ -174,6 +179,15 @@ public:
         double alq_value
     ) const = 0;
 
+    /// The bhp at the thp limit for every value in alq_values, wells can
+    /// override this to share the work that does not depend on the ALQ
+    virtual std::vector<std::optional<double>> computeBhpAtThpLimitProdWithAlqs(
+        const Simulator& ebos_simulator,
+        const SummaryState& summary_state,
+        DeferredLogger& deferred_logger,
+        const std::vector<double>& alq_values
+    ) const;
+
     /// using the solution x to recover the solution xw for wells and applying
     /// xw to update Well State
     virtual void recoverWellSolutionAndUpdateWellState(const BVector& x,
@@ -246,6 +260,24 @@ public:
                      /* const */ WellState& well_state, const GroupState& group_state, WellTestState& welltest_state,
                      DeferredLogger& deferred_logger);
 
+    // The two parts of wellTesting(). testWell() solves the well on a copy of
+    // well_state and only changes this well object, such that several wells can be
+    // tested concurrently. It returns the state of the reopened well, and records
+    // the completions which stay closed in welltest_state_temp, or returns nothing
+    // if the well stays closed. commitWellTest() then reopens the well.
+    std::optional<SingleWellState> testWell(const Simulator& simulator,
+                                            const double simulation_time,
+                                            const WellState& well_state,
+                                            const GroupState& group_state,
+                                            WellTestState& welltest_state_temp,
+                                            DeferredLogger& deferred_logger);
+
+    void commitWellTest(SingleWellState tested_state,
+                        const WellTestState& welltest_state_temp,
+                        WellState& well_state,
+                        WellTestState& welltest_state,
+                        DeferredLogger& deferred_logger);
+
     void checkWellOperability(const Simulator& ebos_simulator, const WellState& well_state, DeferredLogger& deferred_logger);
 
     // check whether the well is operable under the current reservoir condition
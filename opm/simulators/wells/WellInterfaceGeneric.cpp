@@ -272,6 +272,48 @@ void WellInterfaceGeneric::closeCompletions(const WellTestState& wellTestState)
     }
 }
 
+bool WellInterfaceGeneric::canBeReused(const Well& well,
+                                       const int time_step,
+                                       const std::vector<PerforationData>& perf_data) const
+{
+    if (time_step != current_step_ || &perf_data != perf_data_ ||
+        static_cast<int>(perf_data.size()) != number_of_perforations_ ||
+        !(well == well_ecl_)) {
+        return false;
+    }
+
+    for (int perf = 0; perf < number_of_perforations_; ++perf) {
+        if (perf_data[perf].cell_index != well_cells_[perf] ||
+            perf_data[perf].satnum_id != saturation_table_number_[perf]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WellInterfaceGeneric::resetForNewTimeStep()
+{
+    // the well indices are zeroed by closeCompletions() and rescaled by WELPI
+    int perf = 0;
+    for (const auto& pd : *perf_data_) {
+        well_index_[perf] = pd.connection_transmissibility_factor;
+        ++perf;
+    }
+
+    operability_status_ = OperabilityStatus{};
+
+    this->wellStatus_ = Well::Status::OPEN;
+    if (well_ecl_.getStatus() == Well::Status::STOP) {
+        this->wellStatus_ = Well::Status::STOP;
+    }
+
+    well_efficiency_factor_ = 1.0;
+    dynamic_thp_limit_.reset();
+    bhp_at_thp_limit_guess_.reset();
+    well_control_log_.clear();
+    changed_to_open_this_step_ = false;
+}
+
 void WellInterfaceGeneric::setVFPProperties(const VFPProperties* vfp_properties_arg)
 {
     vfp_properties_ = vfp_properties_arg;
@@ -25,6 +25,7 @@
 #define OPM_WELLINTERFACE_GENERIC_HEADER_INCLUDED
 
 #include <opm/input/eclipse/Schedule/Well/Well.hpp>
+#include <opm/simulators/wells/VFPProdProperties.hpp>
 
 #include <map>
 #include <optional>
@@ -92,6 +93,15 @@ public:
     void initCompletions();
     void closeCompletions(const WellTestState& wellTestState);
 
+    /// Whether the object still describes the well at the given report step,
+    /// such that it can be kept instead of constructing a new one.
+    bool canBeReused(const Well& well,
+                     const int time_step,
+                     const std::vector<PerforationData>& perf_data) const;
+
+    /// Reset what a time step changed to the state of a new object.
+    void resetForNewTimeStep();
+
     void setVFPProperties(const VFPProperties* vfp_properties_arg);
     void setGuideRate(const GuideRate* guide_rate_arg);
     void setWellEfficiencyFactor(const double efficiency_factor);
@@ -151,6 +161,16 @@ public:
         return vfp_properties_;
     }
 
+    // the interpolation cell of the last evaluation of the production VFP table
+    VFPProdProperties::EvaluationCache& vfpProdCache() const {
+        return vfp_prod_cache_;
+    }
+
+    // the last solution of the bhp at the thp limit, the initial guess of the next solve
+    std::optional<double>& bhpAtThpLimitGuess() const {
+        return bhp_at_thp_limit_guess_;
+    }
+
     const ParallelWellInfo& parallelWellInfo() const {
         return parallel_well_info_;
     }
@@ -258,6 +278,9 @@ protected:
     mutable std::vector<double> ipr_a_;
     mutable std::vector<double> ipr_b_;
 
+    mutable VFPProdProperties::EvaluationCache vfp_prod_cache_;
+    mutable std::optional<double> bhp_at_thp_limit_guess_;
+
     // cell index for each well perforation
     std::vector<int> well_cells_;
 
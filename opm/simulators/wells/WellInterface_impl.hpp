@@ -66,6 +66,25 @@ namespace Opm
     }
 
 
+
+    template<typename TypeTag>
+    void
+    WellInterface<TypeTag>::
+    resetForNewTimeStep()
+    {
+        WellInterfaceGeneric::resetForNewTimeStep();
+        changed_to_stopped_this_step_ = false;
+
+        this->wsolvent_ = 0.0;
+        if constexpr (has_solvent || has_zFraction) {
+            if (this->well_ecl_.isInjector() &&
+                this->well_ecl_.injectorType() == InjectorType::GAS) {
+                this->wsolvent_ = this->well_ecl_.getSolventFraction();
+            }
+        }
+    }
+
+
     template<typename TypeTag>
     void
     WellInterface<TypeTag>::
@@ -306,6 +325,27 @@ namespace Opm
                 const GroupState& group_state,
                 WellTestState& well_test_state,
                 DeferredLogger& deferred_logger)
+    {
+        WellTestState welltest_state_temp;
+        auto tested_state = testWell(simulator, simulation_time, well_state, group_state,
+                                     welltest_state_temp, deferred_logger);
+        if (tested_state) {
+            commitWellTest(std::move(*tested_state), welltest_state_temp, well_state,
+                           well_test_state, deferred_logger);
+        }
+    }
+
+
+
+    template<typename TypeTag>
+    std::optional<SingleWellState>
+    WellInterface<TypeTag>::
+    testWell(const Simulator& simulator,
+             const double simulation_time,
+             const WellState& well_state,
+             const GroupState& group_state,
+             WellTestState& welltest_state_temp,
+             DeferredLogger& deferred_logger)
     {
         deferred_logger.info(" well " + this->name() + " is being tested");
 
@@ -317,8 +357,6 @@ namespace Opm
         updatePrimaryVariables(well_state_copy, deferred_logger);
         initPrimaryVariablesEvaluation();
 
-        WellTestState welltest_state_temp;
-
         bool testWell = true;
         // if a well is closed because all completions are closed, we need to check each completion
         // individually. We first open all completions, then we close one by one by calling updateWellTestState
@@ -327,16 +365,14 @@ namespace Opm
             const size_t original_number_closed_completions = welltest_state_temp.num_closed_completions();
             bool converged = solveWellForTesting(simulator, well_state_copy, group_state, deferred_logger);
             if (!converged) {
-                const auto msg = fmt::format("WTEST: Well {} is not solvable (physical)", this->name());
-                deferred_logger.debug(msg);
-                return;
+                deferred_logger.debugFormat("WTEST: Well {} is not solvable (physical)", this->name());
+                return std::nullopt;
             }
 
             updateWellOperability(simulator, well_state_copy, deferred_logger);
             if ( !this->isOperableAndSolvable() ) {
-                const auto msg = fmt::format("WTEST: Well {} is not operable (physical)", this->name());
-                deferred_logger.debug(msg);
-                return;
+                deferred_logger.debugFormat("WTEST: Well {} is not operable (physical)", this->name());
+                return std::nullopt;
             }
 
             std::vector<double> potentials;
@@ -345,7 +381,7 @@ namespace Opm
             } catch (const std::exception& e) {
                 const std::string msg = std::string("well ") + this->name() + std::string(": computeWellPotentials() failed during testing for re-opening: ") + e.what();
                 deferred_logger.info(msg);
-                return;
+                return std::nullopt;
             }
             const int np = well_state_copy.numPhases();
             for (int p = 0; p < np; ++p) {
@@ -364,22 +400,37 @@ namespace Opm
             }
         }
 
-        // update wellTestState if the well test succeeds
-        if (!welltest_state_temp.well_is_closed(this->name())) {
-            well_test_state.open_well(this->name());
+        if (welltest_state_temp.well_is_closed(this->name())) {
+            return std::nullopt;
+        }
+        return std::move(ws);
+    }
 
-            std::string msg = std::string("well ") + this->name() + std::string(" is re-opened");
-            deferred_logger.info(msg);
 
-            // also reopen completions
-            for (auto& completion : this->well_ecl_.getCompletions()) {
-                if (!welltest_state_temp.completion_is_closed(this->name(), completion.first))
-                    well_test_state.open_completion(this->name(), completion.first);
-            }
-            // set the status of the well_state to open
-            ws.open();
-            well_state = well_state_copy;
+
+    template<typename TypeTag>
+    void
+    WellInterface<TypeTag>::
+    commitWellTest(SingleWellState tested_state,
+                   const WellTestState& welltest_state_temp,
+                   WellState& well_state,
+                   WellTestState& well_test_state,
+                   DeferredLogger& deferred_logger)
+    {
+        // update wellTestState since the well test succeeded
+        well_test_state.open_well(this->name());
+
+        std::string msg = std::string("well ") + this->name() + std::string(" is re-opened");
+        deferred_logger.info(msg);
+
+        // also reopen completions
+        for (auto& completion : this->well_ecl_.getCompletions()) {
+            if (!welltest_state_temp.completion_is_closed(this->name(), completion.first))
+                well_test_state.open_completion(this->name(), completion.first);
         }
+        // set the status of the well_state to open
+        tested_state.open();
+        well_state.well(this->indexOfWell()) = std::move(tested_state);
     }
 
 
@@ -415,8 +466,8 @@ namespace Opm
     solveWellForTesting(const Simulator& ebosSimulator, WellState& well_state, const GroupState& group_state,
                         DeferredLogger& deferred_logger)
     {
-        // keep a copy of the original well state
-        const WellState well_state0 = well_state;
+        // keep a copy of the original state of this well, the other wells are not changed
+        const SingleWellState ws0 = well_state.well(this->indexOfWell());
         const double dt = ebosSimulator.timeStepSize();
         const auto& summary_state = ebosSimulator.vanguard().summaryState();
         const bool has_thp_limit = this->wellHasTHPConstraints(summary_state);
@@ -433,7 +484,7 @@ namespace Opm
         const int max_iter = param_.max_welleq_iter_;
         deferred_logger.debug("WellTest: Well equation for well " + this->name() + " failed converging in "
                               + std::to_string(max_iter) + " iterations");
-        well_state = well_state0;
+        well_state.well(this->indexOfWell()) = ws0;
         return false;
     }
 
@@ -449,15 +500,15 @@ namespace Opm
         if (!this->isOperableAndSolvable())
             return;
 
-        // keep a copy of the original well state
-        const WellState well_state0 = well_state;
+        // keep a copy of the original state of this well, the other wells are not changed
+        const SingleWellState ws0 = well_state.well(this->indexOfWell());
         const double dt = ebosSimulator.timeStepSize();
         const bool converged = iterateWellEquations(ebosSimulator, dt, well_state, group_state, deferred_logger);
         if (!converged) {
             const int max_iter = param_.max_welleq_iter_;
             deferred_logger.debug("Compute initial well solution for well " + this->name() + ". Failed to converge in "
                                   + std::to_string(max_iter) + " iterations");
-            well_state = well_state0;
+            well_state.well(this->indexOfWell()) = ws0;
         }
     }
 
@@ -479,9 +530,13 @@ namespace Opm
 
         // only use inner well iterations for the first newton iterations.
         const int iteration_idx = ebosSimulator.model().newtonMethod().numIterations();
+        // The inner iterations stop right after assembling the equations of a converged
+        // well, so they only need to be assembled again if the well changed afterwards.
+        bool assembled_converged = false;
         if (iteration_idx < param_.max_niter_inner_well_iter_) {
             this->operability_status_.solvable = true;
             bool converged = this->iterateWellEquations(ebosSimulator, dt, well_state, group_state, deferred_logger);
+            assembled_converged = converged;
 
             // unsolvable wells are treated as not operable and will not be solved for in this iteration.
             if (!converged) {
@@ -490,6 +545,7 @@ namespace Opm
             }
         }
         if (this->operability_status_.has_negative_potentials) {
+            assembled_converged = false;
             auto well_state_copy = well_state;
             std::vector<double> potentials;
             try {
@@ -524,6 +580,10 @@ namespace Opm
             this->changed_to_open_this_step_ = true;
         }
 
+        if (assembled_converged && well_operable && old_well_operable) {
+            return;
+        }
+
         const auto& summary_state = ebosSimulator.vanguard().summaryState();
         const auto inj_controls = this->well_ecl_.isInjector() ? this->well_ecl_.injectionControls(summary_state) : Well::InjectionControls(0);
         const auto prod_controls = this->well_ecl_.isProducer() ? this->well_ecl_.productionControls(summary_state) : Well::ProductionControls(0);
@@ -1032,6 +1092,24 @@ namespace Opm
             }
         }
     }
+
+    template<typename TypeTag>
+    std::vector<std::optional<double>>
+    WellInterface<TypeTag>::
+    computeBhpAtThpLimitProdWithAlqs(const Simulator& ebos_simulator,
+                                     const SummaryState& summary_state,
+                                     DeferredLogger& deferred_logger,
+                                     const std::vector<double>& alq_values) const
+    {
+        std::vector<std::optional<double>> bhps;
+        bhps.reserve(alq_values.size());
+        for (const double alq : alq_values) {
+            bhps.push_back(computeBhpAtThpLimitProdWithAlq(ebos_simulator, summary_state,
+                                                           deferred_logger, alq));
+        }
+        return bhps;
+    }
+
     template<typename TypeTag>
     typename WellInterface<TypeTag>::Eval
     WellInterface<TypeTag>::getPerfCellPressure(const typename WellInterface<TypeTag>::FluidState& fs) const
@@ -23,6 +23,7 @@
 #include <opm/simulators/wells/WellState.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
+#include <opm/input/eclipse/Schedule/Group/Group.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
 #include <opm/simulators/wells/ParallelWellInfo.hpp>
 
@@ -41,6 +42,9 @@ void WellState::base_init(const std::vector<double>& cellPressures,
 {
     // clear old name mapping
     this->wells_.clear();
+    this->group_wells_.clear();
+    this->changed_wells_.clear();
+    this->wells_reinitialized_ = true;
     {
         // const int nw = wells->number_of_wells;
         const int nw = wells_ecl.size();
@@ -126,6 +130,7 @@ void WellState::init(const std::vector<double>& cellPressures,
 {
     // call init on base class
     this->base_init(cellPressures, wells_ecl, parallel_well_info, well_perf_data, summary_state);
+    this->updateGroupWells(schedule, report_step);
     this->global_well_info = std::make_optional<GlobalWellInfo>( schedule, report_step, wells_ecl );
     for (const auto& wname : schedule.wellNames(report_step))
     {
@@ -653,6 +658,94 @@ WellState::calculateSegmentRates(const std::vector<std::vector<int>>& segment_in
     }
 }
 
+std::size_t WellState::memoryBytes() const
+{
+    std::size_t bytes = 0;
+    for (std::size_t well_index = 0; well_index < this->size(); ++well_index) {
+        const auto& ws = this->wells_[well_index];
+        bytes += sizeof(SingleWellState)
+            + (ws.well_potentials.capacity() + ws.productivity_index.capacity()
+               + ws.surface_rates.capacity() + ws.reservoir_rates.capacity()) * sizeof(double)
+            + ws.perf_data.memoryBytes() + ws.segments.memoryBytes();
+    }
+    return bytes;
+}
+
+void WellState::clearChangedWells()
+{
+    this->changed_wells_.assign(this->wells_.size(), 0);
+    this->wells_reinitialized_ = false;
+}
+
+void WellState::restoreChangedWells(const WellState& checkpoint)
+{
+    if (!this->restoreChangedWellsOnly(checkpoint))
+        return;
+
+    this->phase_usage_ = checkpoint.phase_usage_;
+    this->global_well_info = checkpoint.global_well_info;
+    this->alq_state = checkpoint.alq_state;
+    this->well_rates = checkpoint.well_rates;
+}
+
+bool WellState::restoreChangedWellsOnly(const WellState& checkpoint)
+{
+    if (this->wells_reinitialized_ ||
+        this->changed_wells_.size() != this->wells_.size() ||
+        this->wells_.size() != checkpoint.wells_.size())
+    {
+        *this = checkpoint;
+        return false;
+    }
+
+    for (std::size_t w = 0; w < this->changed_wells_.size(); ++w) {
+        if (this->changed_wells_[w])
+            this->wells_[w] = checkpoint.wells_[w];
+    }
+    return true;
+}
+
+void WellState::updateGroupWells(const Schedule& schedule, const int report_step)
+{
+    this->group_wells_.clear();
+    for (const auto& gname : schedule.groupNames(report_step)) {
+        const auto& group_wells = schedule.getGroup(gname, report_step).wells();
+        auto& entry = this->group_wells_[gname];
+        entry.num_group_wells = group_wells.size();
+        for (const auto& wname : group_wells) {
+            const auto index = this->wells_.well_index(wname);
+            if (index.has_value())
+                entry.indices.push_back(index.value());
+        }
+    }
+}
+
+WellState::GroupWellIndices WellState::groupWellIndices(const Group& group) const
+{
+    const auto& group_wells = group.wells();
+    GroupWellIndices result;
+    auto iter = this->group_wells_.find(group.name());
+    if (iter != this->group_wells_.end() &&
+        iter->second.num_group_wells == group_wells.size())
+    {
+        result.cached_ = &iter->second.indices;
+        assert(std::all_of(result.begin(), result.end(),
+                           [&group_wells, this](const std::size_t index)
+                           {
+                               return std::find(group_wells.begin(), group_wells.end(),
+                                                this->wells_.well_name(index)) != group_wells.end();
+                           }));
+        return result;
+    }
+
+    for (const auto& wname : group_wells) {
+        const auto index = this->wells_.well_index(wname);
+        if (index.has_value())
+            result.computed_.push_back(index.value());
+    }
+    return result;
+}
+
 void WellState::stopWell(int well_index)
 {
     auto& ws = this->well(well_index);
@@ -679,10 +772,8 @@ void WellState::updateStatus(int well_index, Well::Status status)
 
 
 
-template<class Comm>
-void WellState::communicateGroupRates(const Comm& comm)
+std::size_t WellState::groupRatesSize() const
 {
-    // Compute the size of the data.
     std::size_t sz = 0;
     for (const auto& [_, owner_rates] : this->well_rates) {
         (void)_;
@@ -690,11 +781,11 @@ void WellState::communicateGroupRates(const Comm& comm)
         (void)__;
         sz += rates.size();
     }
-    sz += this->alq_state.pack_size();
-
+    return sz + this->alq_state.pack_size();
+}
 
-    // Make a vector and collect all data into it.
-    std::vector<double> data(sz);
+std::size_t WellState::collectGroupRates(double* data) const
+{
     std::size_t pos = 0;
     for (const auto& [_, owner_rates] : this->well_rates) {
         (void)_;
@@ -707,12 +798,12 @@ void WellState::communicateGroupRates(const Comm& comm)
         }
     }
     pos += this->alq_state.pack_data(&data[pos]);
-    assert(pos == sz);
-
-    // Communicate it with a single sum() call.
-    comm.sum(data.data(), data.size());
+    return pos;
+}
 
-    pos = 0;
+std::size_t WellState::distributeGroupRates(const double* data)
+{
+    std::size_t pos = 0;
     for (auto& [_, owner_rates] : this->well_rates) {
         (void)_;
         auto& [__, rates] = owner_rates;
@@ -721,7 +812,22 @@ void WellState::communicateGroupRates(const Comm& comm)
             value = data[pos++];
     }
     pos += this->alq_state.unpack_data(&data[pos]);
-    assert(pos == sz);
+    return pos;
+}
+
+template<class Comm>
+void WellState::communicateGroupRates(const Comm& comm)
+{
+    // Make a vector and collect all data into it.
+    std::vector<double> data(this->groupRatesSize());
+    [[maybe_unused]] std::size_t pos = this->collectGroupRates(data.data());
+    assert(pos == data.size());
+
+    // Communicate it with a single sum() call.
+    comm.sum(data.data(), data.size());
+
+    pos = this->distributeGroupRates(data.data());
+    assert(pos == data.size());
 }
 
 
@@ -41,12 +41,14 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace Opm
 {
 
+class Group;
 class ParallelWellInfo;
 class Schedule;
 
@@ -143,6 +145,13 @@ public:
     template<class Comm>
     void communicateGroupRates(const Comm& comm);
 
+    /// Number of values in the group rates exchanged between the processes.
+    std::size_t groupRatesSize() const;
+    /// Copy the exchanged group rates to data, returns the number of values.
+    std::size_t collectGroupRates(double* data) const;
+    /// Set the exchanged group rates from data, returns the number of values.
+    std::size_t distributeGroupRates(const double* data);
+
     template<class Comm>
     void updateGlobalIsGrup(const Comm& comm);
 
@@ -226,7 +235,10 @@ public:
     }
 
     /// One rate per well and phase.
-    std::vector<double>& wellRates(std::size_t well_index) { return this->wells_[well_index].surface_rates; }
+    std::vector<double>& wellRates(std::size_t well_index) {
+        this->markChanged(well_index);
+        return this->wells_[well_index].surface_rates;
+    }
     const std::vector<double>& wellRates(std::size_t well_index) const { return this->wells_[well_index].surface_rates; }
 
     const std::string& name(std::size_t well_index) const {
@@ -246,11 +258,14 @@ public:
     }
 
     SingleWellState& operator[](std::size_t well_index) {
+        this->markChanged(well_index);
         return this->wells_[well_index];
     }
 
     SingleWellState& operator[](const std::string& well_name) {
-        return this->wells_[well_name];
+        auto& ws = this->wells_[well_name];
+        this->markChanged(static_cast<std::size_t>(&ws - this->wells_.data().data()));
+        return ws;
     }
 
     const SingleWellState& well(std::size_t well_index) const {
@@ -273,6 +288,50 @@ public:
         return this->wells_.has(well_name);
     }
 
+    /// The indices of the wells of a group which are present in this
+    /// state, in the order of Group::wells(). The indices are computed
+    /// when the wells are initialized for a report step, such that the
+    /// loops over the wells of a group need not look them up by name.
+    class GroupWellIndices {
+    public:
+        const std::size_t* begin() const { return this->indices().data(); }
+        const std::size_t* end() const { return this->indices().data() + this->indices().size(); }
+        std::size_t size() const { return this->indices().size(); }
+
+    private:
+        friend class WellState;
+        const std::vector<std::size_t>& indices() const {
+            return this->cached_ ? *this->cached_ : this->computed_;
+        }
+
+        const std::vector<std::size_t>* cached_{nullptr};
+        std::vector<std::size_t> computed_;
+    };
+
+    /// If the group is not from the report step of the last init(), or
+    /// its wells changed, the indices are looked up now.
+    GroupWellIndices groupWellIndices(const Group& group) const;
+
+    /// Forget which wells were changed. Every mutable access to a well
+    /// afterwards marks that well as changed.
+    void clearChangedWells();
+
+    /// Make this state equal to checkpoint again by copying only the
+    /// wells changed since the last clearChangedWells(), and the data
+    /// which is not stored per well. This state must have been equal to
+    /// checkpoint at the time of that call. If the wells were
+    /// reinitialized in between, everything is copied.
+    void restoreChangedWells(const WellState& checkpoint);
+
+    /// As restoreChangedWells(), but the data which is not stored per
+    /// well is left alone. Suitable for scratch states of calculations
+    /// of a single well, which only change the state of that well.
+    /// \return false if everything was copied.
+    bool restoreChangedWellsOnly(const WellState& checkpoint);
+
+    /// Estimate of the bytes allocated by the data of the wells.
+    std::size_t memoryBytes() const;
+
 private:
     PhaseUsage phase_usage_;
 
@@ -295,6 +354,26 @@ private:
     // not.
     std::map<std::string, std::pair<bool, std::vector<double>>> well_rates;
 
+    // One flag per well, set by the mutable accessors of a well. This is a
+    // vector of char, such that wells can be marked from several threads.
+    std::vector<char> changed_wells_;
+    // set when the wells are reinitialized, restoreChangedWells() must copy all
+    bool wells_reinitialized_{true};
+
+    struct GroupWells {
+        std::size_t num_group_wells{0};    // the size of Group::wells()
+        std::vector<std::size_t> indices;  // local indices of the wells present in wells_
+    };
+    // All groups of the report step of the last init()
+    std::unordered_map<std::string, GroupWells> group_wells_;
+
+    void updateGroupWells(const Schedule& schedule, const int report_step);
+
+    void markChanged(std::size_t well_index) {
+        if (well_index < this->changed_wells_.size())
+            this->changed_wells_[well_index] = 1;
+    }
+
     data::Segment
     reportSegmentResults(const int         well_id,
                          const int         seg_ix,
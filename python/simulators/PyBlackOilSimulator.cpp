@@ -25,15 +25,35 @@
 #include <opm/simulators/flow/Main.hpp>
 #include <opm/simulators/flow/FlowMainEbos.hpp>
 // NOTE: EXIT_SUCCESS, EXIT_FAILURE is defined in cstdlib
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <opm/simulators/flow/python/PyBlackOilSimulator.hpp>
 
+#include <pybind11/stl.h>
+
 namespace py = pybind11;
 
 namespace Opm::Pybind {
+
+namespace {
+
+// The parameter registry, the logging and the thread setup of flow are
+// global to the process. The long running calls release the GIL, such that
+// other Python threads can continue, but the simulator objects of a process
+// still take turns.
+std::mutex& simulatorMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // anonymous namespace
+
 PyBlackOilSimulator::PyBlackOilSimulator( const std::string &deckFilename)
     : deckFilename_{deckFilename}
 {
@@ -52,6 +72,14 @@ PyBlackOilSimulator::PyBlackOilSimulator(
 {
 }
 
+PyBlackOilSimulator::~PyBlackOilSimulator()
+{
+    std::lock_guard<std::mutex> lock(simulatorMutex());
+    materialState_.reset();
+    mainEbos_.reset();
+    main_.reset();
+}
+
 const Opm::FlowMainEbos<typename Opm::Pybind::PyBlackOilSimulator::TypeTag>&
          PyBlackOilSimulator::getFlowMainEbos() const
 {
@@ -64,15 +92,147 @@ const Opm::FlowMainEbos<typename Opm::Pybind::PyBlackOilSimulator::TypeTag>&
     }
 }
 
+PyMaterialState<typename Opm::Pybind::PyBlackOilSimulator::TypeTag>&
+         PyBlackOilSimulator::getMaterialState() const
+{
+    if (this->materialState_) {
+        return *this->materialState_;
+    }
+    else {
+        throw std::runtime_error("BlackOilSimulator not initialized: "
+            "Cannot access the simulator state before step_init()" );
+    }
+}
+
+// The views keep the simulator object alive, and they are read-only since
+// writing to them would bypass the update of the intensive quantities.
+py::array_t<double> PyBlackOilSimulator::readOnlyView(
+    const double* data, std::size_t size, std::ptrdiff_t stride)
+{
+    py::array_t<double> view({static_cast<py::ssize_t>(size)},
+                             {static_cast<py::ssize_t>(stride)},
+                             data, py::cast(this));
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
+
+// The checkpoints are kept in memory, a run can be continued from one of
+// them several times.
+PyBlackOilSimulator::Checkpoint PyBlackOilSimulator::checkpoint()
+{
+    if (!hasRunInit_) {
+        throw std::logic_error("checkpoint() called before step_init()");
+    }
+    return mainEbos_->checkpoint();
+}
+
 py::array_t<double> PyBlackOilSimulator::getPorosity()
 {
     std::size_t len;
-    auto array = materialState_->getPorosity(&len);
+    auto array = getMaterialState().getPorosity(&len);
     return py::array(len, array.get());
 }
 
+py::array_t<double> PyBlackOilSimulator::getPorosityView()
+{
+    std::size_t len;
+    double* data = getMaterialState().getPorosityView(&len);
+    return py::array_t<double>({static_cast<py::ssize_t>(len)}, {}, data, py::cast(this));
+}
+
+py::array_t<double> PyBlackOilSimulator::getPressure()
+{
+    std::size_t len;
+    std::ptrdiff_t stride;
+    const double* data = getMaterialState().getPressureView(&len, &stride);
+    return readOnlyView(data, len, stride);
+}
+
+py::array_t<double> PyBlackOilSimulator::getSaturation(const std::string& phase)
+{
+    using FluidSystem = Opm::GetPropType<TypeTag, Opm::Properties::FluidSystem>;
+    unsigned phaseIdx;
+    if (phase == "water") {
+        phaseIdx = FluidSystem::waterPhaseIdx;
+    }
+    else if (phase == "oil") {
+        phaseIdx = FluidSystem::oilPhaseIdx;
+    }
+    else if (phase == "gas") {
+        phaseIdx = FluidSystem::gasPhaseIdx;
+    }
+    else {
+        throw std::invalid_argument("Unknown phase " + phase + ", expected water, oil or gas");
+    }
+    std::size_t len;
+    std::ptrdiff_t stride;
+    const double* data = getMaterialState().getSaturationView(phaseIdx, &len, &stride);
+    return readOnlyView(data, len, stride);
+}
+
+py::array_t<double> PyBlackOilSimulator::getRs()
+{
+    std::size_t len;
+    std::ptrdiff_t stride;
+    const double* data = getMaterialState().getRsView(&len, &stride);
+    return readOnlyView(data, len, stride);
+}
+
+py::array_t<double> PyBlackOilSimulator::getRv()
+{
+    std::size_t len;
+    std::ptrdiff_t stride;
+    const double* data = getMaterialState().getRvView(&len, &stride);
+    return readOnlyView(data, len, stride);
+}
+
+// The well state is rebuilt at every report step, so the rates are copied.
+// They are only a few values per well.
+py::array_t<double> PyBlackOilSimulator::getWellRates(const std::string& well)
+{
+    getMaterialState();
+    const auto& wellState = ebosSimulator_->problem().wellModel().wellState();
+    if (!wellState.has(well)) {
+        throw std::invalid_argument("Unknown well " + well);
+    }
+    const auto& rates = wellState.well(well).surface_rates;
+    return py::array(rates.size(), rates.data());
+}
+
+void PyBlackOilSimulator::restoreCheckpoint(const Checkpoint& checkpoint)
+{
+    std::lock_guard<std::mutex> lock(simulatorMutex());
+    if (!hasRunInit_) {
+        throw std::logic_error("restore_checkpoint() called before step_init()");
+    }
+    if (hasRunCleanup_) {
+        throw std::logic_error("restore_checkpoint() called after step_cleanup()");
+    }
+    mainEbos_->restoreCheckpoint(checkpoint);
+}
+
+// The members of an ensemble only differ by the multipliers, so the parsed
+// input, the grid and the partition of the first run are kept.
+int PyBlackOilSimulator::reset(
+    py::array_t<double, py::array::c_style | py::array::forcecast> porosityMultipliers,
+    py::array_t<double, py::array::c_style | py::array::forcecast> permeabilityMultipliers)
+{
+    if (!hasRunInit_) {
+        throw std::logic_error("reset() called before step_init()");
+    }
+    const std::vector<double> poro(porosityMultipliers.data(),
+                                   porosityMultipliers.data() + porosityMultipliers.size());
+    const std::vector<double> perm(permeabilityMultipliers.data(),
+                                   permeabilityMultipliers.data() + permeabilityMultipliers.size());
+    py::gil_scoped_release release;
+    std::lock_guard<std::mutex> lock(simulatorMutex());
+    hasRunCleanup_ = false;
+    return mainEbos_->executeReset(poro, perm);
+}
+
 int PyBlackOilSimulator::run()
 {
+    std::lock_guard<std::mutex> lock(simulatorMutex());
     auto mainObject = Opm::Main( deckFilename_ );
     return mainObject.runStatic<Opm::Properties::TTag::EclFlowProblem>();
 }
@@ -82,11 +242,27 @@ void PyBlackOilSimulator::setPorosity( py::array_t<double,
 {
     std::size_t size_ = array.size();
     const double *poro = array.data();
-    materialState_->setPorosity(poro, size_);
+    getMaterialState().setPorosity(poro, size_);
+}
+
+// The targets are set between two report steps, the well model keeps them
+// for the following steps.
+void PyBlackOilSimulator::setWellTargets(
+    const std::vector<std::string>& wells, const std::string& control,
+    py::array_t<double, py::array::c_style | py::array::forcecast> targets)
+{
+    getMaterialState();
+    const std::vector<double> values(targets.data(), targets.data() + targets.size());
+    py::gil_scoped_release release;
+    std::lock_guard<std::mutex> lock(simulatorMutex());
+    const int reportStep = std::max(ebosSimulator_->episodeIndex(), 0);
+    ebosSimulator_->problem().wellModel().setWellTargets(
+        reportStep, wells, control, values, ebosSimulator_->vanguard().summaryState());
 }
 
 int PyBlackOilSimulator::step()
 {
+    std::lock_guard<std::mutex> lock(simulatorMutex());
     if (!hasRunInit_) {
         throw std::logic_error("step() called before step_init()");
     }
@@ -98,13 +274,14 @@ int PyBlackOilSimulator::step()
 
 int PyBlackOilSimulator::stepCleanup()
 {
+    std::lock_guard<std::mutex> lock(simulatorMutex());
     hasRunCleanup_ = true;
     return mainEbos_->executeStepsCleanup();
 }
 
 int PyBlackOilSimulator::stepInit()
 {
-
+    std::lock_guard<std::mutex> lock(simulatorMutex());
     if (hasRunInit_) {
         // Running step_init() multiple times is not implemented yet,
         if (hasRunCleanup_) {
@@ -142,6 +319,8 @@ int PyBlackOilSimulator::stepInit()
 
 void export_PyBlackOilSimulator(py::module& m)
 {
+    py::class_<PyBlackOilSimulator::Checkpoint>(m, "Checkpoint");
+
     py::class_<PyBlackOilSimulator>(m, "BlackOilSimulator")
         .def(py::init< const std::string& >())
         .def(py::init<
@@ -149,13 +328,31 @@ void export_PyBlackOilSimulator(py::module& m)
             std::shared_ptr<Opm::EclipseState>,
             std::shared_ptr<Opm::Schedule>,
             std::shared_ptr<Opm::SummaryConfig> >())
+        .def("checkpoint", &PyBlackOilSimulator::checkpoint)
         .def("get_porosity", &PyBlackOilSimulator::getPorosity,
             py::return_value_policy::copy)
-        .def("run", &PyBlackOilSimulator::run)
+        .def("get_porosity_view", &PyBlackOilSimulator::getPorosityView)
+        .def("get_pressure", &PyBlackOilSimulator::getPressure)
+        .def("get_saturation", &PyBlackOilSimulator::getSaturation, py::arg("phase"))
+        .def("get_rs", &PyBlackOilSimulator::getRs)
+        .def("get_rv", &PyBlackOilSimulator::getRv)
+        .def("get_well_rates", &PyBlackOilSimulator::getWellRates, py::arg("well"))
+        .def("restore_checkpoint", &PyBlackOilSimulator::restoreCheckpoint, py::arg("checkpoint"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("reset", &PyBlackOilSimulator::reset,
+            py::arg("porosity_multipliers") = py::array_t<double>(),
+            py::arg("permeability_multipliers") = py::array_t<double>())
+        .def("run", &PyBlackOilSimulator::run,
+            py::call_guard<py::gil_scoped_release>())
         .def("set_porosity", &PyBlackOilSimulator::setPorosity)
-        .def("step", &PyBlackOilSimulator::step)
-        .def("step_init", &PyBlackOilSimulator::stepInit)
-        .def("step_cleanup", &PyBlackOilSimulator::stepCleanup);
+        .def("set_well_targets", &PyBlackOilSimulator::setWellTargets,
+            py::arg("wells"), py::arg("control"), py::arg("targets"))
+        .def("step", &PyBlackOilSimulator::step,
+            py::call_guard<py::gil_scoped_release>())
+        .def("step_init", &PyBlackOilSimulator::stepInit,
+            py::call_guard<py::gil_scoped_release>())
+        .def("step_cleanup", &PyBlackOilSimulator::stepCleanup,
+            py::call_guard<py::gil_scoped_release>());
 }
 
 } // namespace Opm::Pybind
@@ -1,4 +1,5 @@
 import os
+import threading
 import unittest
 from contextlib import contextmanager
 from pathlib import Path
@@ -73,3 +74,46 @@ class TestBasic(unittest.TestCase):
             poro2 = sim.get_porosity()
             self.assertAlmostEqual(poro2[0], 0.285, places=7, msg='value of porosity 2')
 
+
+            # the views follow the state of the simulator without a copy
+            pressure = sim.get_pressure()
+            sw = sim.get_saturation("water")
+            self.assertEqual(len(pressure), 300, 'length of pressure view')
+            self.assertFalse(pressure.flags.writeable, 'pressure view is read-only')
+            p0 = pressure[0]
+            sim.step()
+            self.assertNotEqual(pressure[0], p0, 'pressure view is updated by step()')
+            self.assertTrue(all(0.0 <= s <= 1.0 for s in sw), 'values of water saturation view')
+            self.assertEqual(len(sim.get_rs()), 300, 'length of Rs view')
+            poro_view = sim.get_porosity_view()
+            poro_view[0] = 0.25
+            self.assertAlmostEqual(sim.get_porosity()[0], 0.25, places=7, msg='porosity view writes through')
+            self.assertEqual(len(sim.get_well_rates("PROD")), 3, 'number of phase rates of a well')
+
+            # continue twice from the same report step
+            checkpoint = sim.checkpoint()
+            sim.step()
+            p1 = sim.get_pressure()[0]
+            sim.restore_checkpoint(checkpoint)
+            sim.step()
+            self.assertAlmostEqual(sim.get_pressure()[0], p1, places=3, msg='pressure after restoring a checkpoint')
+
+            # run the case again from the start, with a smaller porosity
+            sim.reset(porosity_multipliers=[0.9] * 300)
+            self.assertAlmostEqual(sim.get_porosity()[0], 0.27, places=7, msg='value of porosity after reset')
+            sim.step()
+
+            # step() releases the GIL while the simulator runs
+            worker = threading.Thread(target=sim.step)
+            worker.start()
+            worker.join()
+
+            # set the controls of the wells between two steps
+            sim.set_well_targets(["PROD"], "BHP", [2.0e7])
+            sim.set_well_targets(["INJ"], "RATE", [1.0])
+            with self.assertRaises(ValueError):
+                sim.set_well_targets(["INJ"], "ORAT", [1.0])
+            with self.assertRaises(ValueError):
+                sim.set_well_targets(["PROD", "INJ"], "BHP", [2.0e7])
+            sim.step()
+            sim.step_cleanup()
@@ -0,0 +1,309 @@
+#!/bin/bash
+
+# This generates synthetic black-oil decks and runs a simulator on them for
+# a range of MPI process and thread counts. The timings of the final report
+# of every run are collected into a strong scaling table (fixed deck) and a
+# weak scaling table (the cells and wells grow with the number of workers).
+# Meant to track the scaling of the simulators over time.
+
+usage() {
+  echo -e "Usage:\t$0 <options> -- [additional simulator options]"
+  echo -e "\tMandatory options:"
+  echo -e "\t\t -r <path>     Path to store decks and results in"
+  echo -e "\t\t -b <path>     Path to simulator binary"
+  echo -e "\tOptional options:"
+  echo -e "\t\t -e <filename> Simulator binary to use (default flow)"
+  echo -e "\t\t -p <list>     MPI process counts (default \"1 2 4\")"
+  echo -e "\t\t -t <list>     Threads per process (default \"1\")"
+  echo -e "\t\t -x <nx,ny,nz> Grid of the strong scaling deck, and of the weak"
+  echo -e "\t\t               scaling deck per worker along x (default 40,40,10)"
+  echo -e "\t\t -w <wells>    Number of wells, half of them injectors (default 8)"
+  echo -e "\t\t -m <wells>    Number of multisegment producers (default 2)"
+  echo -e "\t\t -c <tracers>  Number of water tracers (default 1)"
+  echo -e "\t\t -s <steps>    Number of 30 day report steps (default 12)"
+  exit 1
+}
+
+test $# -eq 0 && usage
+
+EXE_NAME=flow
+PROCS="1 2 4"
+THREADS="1"
+GRID=40,40,10
+NUM_WELLS=8
+NUM_MSW=2
+NUM_TRACERS=1
+NUM_STEPS=12
+OPTIND=1
+while getopts "r:b:e:p:t:x:w:m:c:s:" OPT
+do
+  case "${OPT}" in
+    r) RESULT_PATH=${OPTARG} ;;
+    b) BINPATH=${OPTARG} ;;
+    e) EXE_NAME=${OPTARG} ;;
+    p) PROCS=${OPTARG} ;;
+    t) THREADS=${OPTARG} ;;
+    x) GRID=${OPTARG} ;;
+    w) NUM_WELLS=${OPTARG} ;;
+    m) NUM_MSW=${OPTARG} ;;
+    c) NUM_TRACERS=${OPTARG} ;;
+    s) NUM_STEPS=${OPTARG} ;;
+    *) usage ;;
+  esac
+done
+shift $(($OPTIND-1))
+TEST_ARGS="$@"
+
+test -n "${RESULT_PATH}" -a -n "${BINPATH}" || usage
+IFS=, read NX NY NZ <<< "${GRID}"
+
+# write_deck <file> <nx> <ny> <nz> <wells> <multisegment wells> <tracers> <steps>
+write_deck() {
+  local file=$1 nx=$2 ny=$3 nz=$4 nwells=$5 nmsw=$6 ntracers=$7 nsteps=$8
+  local ncells=$((nx * ny * nz))
+  local nprod=$(((nwells + 1) / 2))
+  local ninj=$((nwells - nprod))
+  local w k t
+  test ${nmsw} -gt ${nprod} && nmsw=${nprod}
+
+  # Well w is completed in all layers of column (i, j), spread over the grid.
+  well_column() {
+    local c=$(($1 * nx * ny / nwells + (nx * ny / nwells) / 2))
+    echo "$((c % nx + 1)) $((c / nx + 1))"
+  }
+
+  {
+    echo "RUNSPEC"
+    echo "DIMENS"
+    echo " ${nx} ${ny} ${nz} /"
+    echo "OIL"
+    echo "WATER"
+    echo "GAS"
+    echo "DISGAS"
+    echo "METRIC"
+    echo "TABDIMS"
+    echo " 1 1 10 10 /"
+    echo "WELLDIMS"
+    echo " ${nwells} ${nz} 3 ${nwells} /"
+    if test ${nmsw} -gt 0; then
+      echo "WSEGDIMS"
+      echo " ${nmsw} $((nz + 1)) 1 /"
+    fi
+    if test ${ntracers} -gt 0; then
+      echo "TRACERS"
+      echo " 0 ${ntracers} 0 0 /"
+    fi
+    echo "START"
+    echo " 1 'JAN' 2020 /"
+    echo "UNIFOUT"
+
+    echo "GRID"
+    echo "DX"
+    echo " ${ncells}*100 /"
+    echo "DY"
+    echo " ${ncells}*100 /"
+    echo "DZ"
+    echo " ${ncells}*10 /"
+    echo "TOPS"
+    echo " $((nx * ny))*2000 /"
+    echo "PORO"
+    echo " ${ncells}*0.25 /"
+    echo "PERMX"
+    echo " ${ncells}*200 /"
+    echo "PERMY"
+    echo " ${ncells}*200 /"
+    echo "PERMZ"
+    echo " ${ncells}*20 /"
+
+    echo "PROPS"
+    echo "PVTW"
+    echo " 200 1.03 4.6E-5 0.3 0 /"
+    echo "ROCK"
+    echo " 200 4.9E-5 /"
+    echo "DENSITY"
+    echo " 800 1000 0.9 /"
+    echo "PVDG"
+    echo " 20 0.05 0.012"
+    echo " 100 0.01 0.015"
+    echo " 400 0.003 0.03 /"
+    echo "PVTO"
+    echo " 1.0 1.0 1.05 1.2 /"
+    echo " 50.0 100.0 1.18 0.9 /"
+    echo " 100.0 200.0 1.30 0.7"
+    echo "       400.0 1.27 0.8 /"
+    echo "/"
+    echo "SWOF"
+    echo " 0.2 0.0 1.0 0"
+    echo " 0.5 0.2 0.3 0"
+    echo " 1.0 1.0 0.0 0 /"
+    echo "SGOF"
+    echo " 0.0 0.0 1.0 0"
+    echo " 0.4 0.3 0.1 0"
+    echo " 0.8 1.0 0.0 0 /"
+    if test ${ntracers} -gt 0; then
+      echo "TRACER"
+      for t in $(seq 1 ${ntracers}); do
+        echo " 'WT${t}' 'WAT' /"
+      done
+      echo "/"
+    fi
+
+    echo "SOLUTION"
+    echo "EQUIL"
+    echo " 2000 200 $((2000 + 10 * nz + 100)) 0 1900 0 1 /"
+    echo "RSVD"
+    echo " 1800 100"
+    echo " $((2000 + 10 * nz + 200)) 100 /"
+    for t in $(seq 1 ${ntracers}); do
+      echo "TBLKFWT${t}"
+      echo " ${ncells}*0.0 /"
+    done
+
+    echo "SUMMARY"
+    echo "FOPR"
+    echo "FWIR"
+
+    echo "SCHEDULE"
+    echo "WELSPECS"
+    for w in $(seq 0 $((nwells - 1))); do
+      if test ${w} -lt ${nprod}; then
+        echo " 'P${w}' 'PROD' $(well_column ${w}) 1* 'OIL' /"
+      else
+        echo " 'I${w}' 'INJ' $(well_column ${w}) 1* 'WATER' /"
+      fi
+    done
+    echo "/"
+    echo "COMPDAT"
+    for w in $(seq 0 $((nwells - 1))); do
+      local name=P${w}
+      test ${w} -ge ${nprod} && name=I${w}
+      echo " '${name}' $(well_column ${w}) 1 ${nz} 'OPEN' 1* 1* 0.2 /"
+    done
+    echo "/"
+    if test ${nmsw} -gt 0; then
+      for w in $(seq 0 $((nmsw - 1))); do
+        echo "WELSEGS"
+        echo " 'P${w}' 2000 0 1* 'INC' /"
+        echo " 2 $((nz + 1)) 1 1 10 10 0.15 0.0001 /"
+        echo "/"
+        echo "COMPSEGS"
+        echo " 'P${w}' /"
+        local ij=$(well_column ${w})
+        for k in $(seq 1 ${nz}); do
+          echo " ${ij} ${k} 1 $((10 * (k - 1))) $((10 * k)) /"
+        done
+        echo "/"
+      done
+    fi
+    echo "WCONPROD"
+    for w in $(seq 0 $((nprod - 1))); do
+      echo " 'P${w}' 'OPEN' 'ORAT' 200 4* 100 /"
+    done
+    echo "/"
+    if test ${ninj} -gt 0; then
+      echo "WCONINJE"
+      for w in $(seq ${nprod} $((nwells - 1))); do
+        echo " 'I${w}' 'WATER' 'OPEN' 'RATE' 250 1* 400 /"
+      done
+      echo "/"
+      if test ${ntracers} -gt 0; then
+        echo "WTRACER"
+        for w in $(seq ${nprod} $((nwells - 1))); do
+          t=$(((w - nprod) % ntracers + 1))
+          echo " 'I${w}' 'WT${t}' 1.0 /"
+        done
+        echo "/"
+      fi
+    fi
+    echo "TSTEP"
+    echo " ${nsteps}*30 /"
+    echo "END"
+  } > ${file}
+}
+
+# Last value of a line of the final report, e.g. "Total time (seconds):"
+report_value() {
+  grep -F "$2" $1 | tail -n 1 | sed -e "s/.*$2//" | awk '{print $1}'
+}
+
+# Mean time of a region of the timing table, e.g. "CPR setup"
+region_mean() {
+  grep "^$2  " $1 | tail -n 1 | sed -e "s/^$2//" | awk '{print $3}'
+}
+
+# run_case <deck> <procs> <threads> <output dir>, prints a row of the table
+run_case() {
+  local deck=$1 procs=$2 threads=$3 out=$4
+  rm -Rf ${out}
+  mkdir -p ${out}
+  if (( ${procs} > 1 ))
+  then
+    OMP_NUM_THREADS=${threads} mpirun -np ${procs} ${BINPATH}/${EXE_NAME} ${deck} ${TEST_ARGS} \
+      --threads-per-process=${threads} --output-dir=${out} > ${out}/stdout.log 2>&1
+  else
+    OMP_NUM_THREADS=${threads} ${BINPATH}/${EXE_NAME} ${deck} ${TEST_ARGS} \
+      --threads-per-process=${threads} --output-dir=${out} > ${out}/stdout.log 2>&1
+  fi
+  if test $? -ne 0; then
+    echo "Run with ${procs} processes and ${threads} threads failed, see ${out}/stdout.log" >&2
+    return 1
+  fi
+  local prt=${out}/$(basename ${deck} .DATA).PRT
+  local total=$(report_value ${prt} "Total time (seconds):")
+  local assembly=$(report_value ${prt} "Assembly time (seconds):")
+  local lsetup=$(report_value ${prt} "Linear setup (seconds):")
+  local lsolve=$(report_value ${prt} "Linear solve time (seconds):")
+  local output=$(report_value ${prt} "Output write time (seconds):")
+  local linits=$(report_value ${prt} "Overall Linear Iterations:")
+  local cprsetup=$(region_mean ${prt} "CPR setup")
+  local cprapply=$(region_mean ${prt} "CPR apply")
+  echo "${procs} ${threads} ${total:-0} ${assembly:-0} ${lsetup:-0} ${lsolve:-0}" \
+       "${cprsetup:-0} ${cprapply:-0} ${output:-0} ${linits:-0}"
+}
+
+# print_table <file with rows of run_case> <title> <weak>
+# The efficiency is relative to the first row, for strong scaling
+# t1 / (n * tn) with n workers, for weak scaling t1 / tn.
+print_table() {
+  echo "=== $2 ==="
+  awk -v weak=$3 '
+    BEGIN {
+      printf "%6s %7s %10s %10s %10s %10s %10s %10s %10s %8s %8s\n",
+             "Procs", "Threads", "Total", "Assembly", "LinSetup", "LinSolve",
+             "CprSetup", "CprApply", "Output", "LinIts", "Eff(%)"
+    }
+    NR == 1 { t1 = $3; n1 = $1 * $2 }
+    {
+      n = $1 * $2 / n1
+      eff = ($3 > 0) ? (weak ? t1 / $3 : t1 / (n * $3)) * 100 : 0
+      printf "%6d %7d %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %8d %8.1f\n",
+             $1, $2, $3, $4, $5, $6, $7, $8, $9, $10, eff
+    }' $1
+}
+
+mkdir -p ${RESULT_PATH}
+cd ${RESULT_PATH}
+ecode=0
+
+STRONG_DECK=${RESULT_PATH}/STRONG_${NX}_${NY}_${NZ}.DATA
+write_deck ${STRONG_DECK} ${NX} ${NY} ${NZ} ${NUM_WELLS} ${NUM_MSW} ${NUM_TRACERS} ${NUM_STEPS}
+rm -f strong.txt weak.txt
+for p in ${PROCS}; do
+  for t in ${THREADS}; do
+    run_case ${STRONG_DECK} ${p} ${t} ${RESULT_PATH}/strong_${p}_${t} >> strong.txt || ecode=1
+
+    workers=$((p * t))
+    WEAK_DECK=${RESULT_PATH}/WEAK_$((NX * workers))_${NY}_${NZ}.DATA
+    write_deck ${WEAK_DECK} $((NX * workers)) ${NY} ${NZ} $((NUM_WELLS * workers)) \
+               $((NUM_MSW * workers)) ${NUM_TRACERS} ${NUM_STEPS}
+    run_case ${WEAK_DECK} ${p} ${t} ${RESULT_PATH}/weak_${p}_${t} >> weak.txt || ecode=1
+  done
+done
+
+{
+  print_table strong.txt "Strong scaling, ${NX}x${NY}x${NZ} cells, ${NUM_WELLS} wells" 0
+  echo
+  print_table weak.txt "Weak scaling, ${NX}x${NY}x${NZ} cells and ${NUM_WELLS} wells per worker" 1
+} | tee scaling_report.txt
+
+exit $ecode
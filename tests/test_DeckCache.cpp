@@ -0,0 +1,96 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE DeckCacheTest
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/input/eclipse/Deck/Deck.hpp>
+#include <opm/input/eclipse/Parser/InputErrorAction.hpp>
+#include <opm/input/eclipse/Parser/ParseContext.hpp>
+#include <opm/input/eclipse/Parser/Parser.hpp>
+#include <opm/simulators/utils/DeckCache.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+void writeFile(const std::filesystem::path& path, const std::string& contents)
+{
+    std::ofstream os(path);
+    os << contents;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(CacheInvalidation)
+{
+    namespace fs = std::filesystem;
+    const auto dir = fs::temp_directory_path() / "opm_deck_cache_test";
+    fs::create_directories(dir);
+    const auto deckFile = (dir / "CASE.DATA").string();
+    const auto includeFile = (dir / "props.inc").string();
+    const auto cacheFile = (dir / "CASE.cache").string();
+    fs::remove(cacheFile);
+
+    writeFile(deckFile, "RUNSPEC\nDIMENS\n 2 2 1 /\nGRID\nINCLUDE\n 'props.inc' /\n");
+    writeFile(includeFile, "PORO\n 4*0.25 /\n");
+
+    auto comm = Dune::MPIHelper::getCollectiveCommunication();
+    const Opm::ParseContext parseContext;
+    const auto deck = Opm::Parser{}.parseFile(deckFile, parseContext);
+
+    BOOST_CHECK(Opm::loadDeckCache(comm, cacheFile, deckFile, parseContext) == nullptr);
+    Opm::writeDeckCache(comm, cacheFile, deckFile, parseContext, deck);
+
+    const auto cached = Opm::loadDeckCache(comm, cacheFile, deckFile, parseContext);
+    BOOST_REQUIRE(cached != nullptr);
+    BOOST_CHECK(*cached == deck);
+
+    // the cache belongs to a different data file
+    BOOST_CHECK(Opm::loadDeckCache(comm, cacheFile, includeFile, parseContext) == nullptr);
+
+    // the cache was parsed with other input error actions
+    const Opm::ParseContext ignoreSlash({{Opm::ParseContext::PARSE_RANDOM_SLASH,
+                                          Opm::InputError::IGNORE}});
+    BOOST_CHECK(Opm::loadDeckCache(comm, cacheFile, deckFile, ignoreSlash) == nullptr);
+
+    // an edit of an included file invalidates the cache
+    writeFile(includeFile, "PORO\n 4*0.30 /\n");
+    BOOST_CHECK(Opm::loadDeckCache(comm, cacheFile, deckFile, parseContext) == nullptr);
+
+    fs::remove_all(dir);
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -0,0 +1,120 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE GeometricPartitionTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/GeometricPartition.hpp>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// centroids and columns of a nx x ny x nz box of unit cells, i fastest
+struct Box
+{
+    Box(int nx, int ny, int nz)
+    {
+        for (int k = 0; k < nz; ++k) {
+            for (int j = 0; j < ny; ++j) {
+                for (int i = 0; i < nx; ++i) {
+                    centroids.push_back({i + 0.5, j + 0.5, k + 0.5});
+                    columns.push_back(i + nx * j);
+                }
+            }
+        }
+    }
+
+    std::vector<std::array<double, 3>> centroids;
+    std::vector<int> columns;
+};
+
+std::vector<int> partSizes(const std::vector<int>& parts, int numParts)
+{
+    std::vector<int> sizes(numParts, 0);
+    for (const int part : parts) {
+        ++sizes[part];
+    }
+    return sizes;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(CoordinateBisection)
+{
+    const Box box(8, 4, 2);
+    const auto parts = Opm::geometricPartition("rcb", box.centroids, box.columns, {}, 4);
+    // 64 cells in parts of 16, first cut normal to x
+    const auto sizes = partSizes(parts, 4);
+    BOOST_CHECK(std::all_of(sizes.begin(), sizes.end(), [](int size) { return size == 16; }));
+    BOOST_CHECK_EQUAL(parts[0], 0);
+    BOOST_CHECK_EQUAL(parts[7], 3);
+
+    // a number of parts which is not a power of two
+    const auto parts3 = Opm::geometricPartition("rcb", box.centroids, box.columns, {}, 3);
+    const auto sizes3 = partSizes(parts3, 3);
+    for (const int size : sizes3) {
+        BOOST_CHECK(size >= 21 && size <= 22);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ColumnPartition)
+{
+    // tall and thin, such that the bisection of the cells would cut in z
+    const Box box(2, 2, 20);
+    const auto parts = Opm::geometricPartition("columns", box.centroids, box.columns, {}, 4);
+    for (std::size_t cell = 0; cell < parts.size(); ++cell) {
+        BOOST_CHECK_EQUAL(parts[cell], parts[box.columns[cell]]);
+    }
+    const auto sizes = partSizes(parts, 4);
+    BOOST_CHECK(std::all_of(sizes.begin(), sizes.end(), [](int size) { return size == 20; }));
+}
+
+BOOST_AUTO_TEST_CASE(WellRegions)
+{
+    const Box box(4, 1, 3);
+    // a deviated well from column 1 to column 2
+    const std::vector<std::vector<int>> wells {{1, 4 + 2, 8 + 2}};
+
+    const auto columns = Opm::geometricPartition("columns", box.centroids, box.columns, wells, 2);
+    BOOST_CHECK_EQUAL(columns[1], columns[6]);
+    BOOST_CHECK_EQUAL(columns[1], columns[10]);
+
+    const auto regions = Opm::geometricPartition("wells", box.centroids, box.columns, wells, 2);
+    // the columns 1 and 2 form one region, which is not split
+    for (std::size_t cell = 0; cell < regions.size(); ++cell) {
+        if (box.columns[cell] == 1 || box.columns[cell] == 2) {
+            BOOST_CHECK_EQUAL(regions[cell], regions[1]);
+        }
+    }
+    BOOST_CHECK(regions[0] != regions[1] || regions[3] != regions[1]);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidMethod)
+{
+    const Box box(2, 2, 2);
+    BOOST_CHECK(!Opm::isGeometricPartitionMethod("zoltan"));
+    BOOST_CHECK_THROW(Opm::geometricPartition("zoltan", box.centroids, box.columns, {}, 2),
+                      std::invalid_argument);
+}
@@ -67,6 +67,15 @@ BOOST_AUTO_TEST_CASE(GroupStateCreate) {
     TestCommunicator comm;
     gs.communicate_rates(comm);
     BOOST_CHECK(gs2 == gs);
+
+    std::vector<double> data(gs.data_size());
+    BOOST_CHECK_EQUAL(gs.collect(data.data()), 2 * rates.size());
+    GroupState gs3(num_phases);
+    gs3.update_production_rates("AGROUP", {0, 0, 0});
+    gs3.update_injection_rein_rates("CGROUP", {0, 0, 0});
+    gs3.production_control("AGROUP", Group::ProductionCMode::GRAT);
+    BOOST_CHECK_EQUAL(gs3.distribute(data.data()), data.size());
+    BOOST_CHECK(gs3 == gs);
 }
 
 
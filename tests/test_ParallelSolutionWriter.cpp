@@ -0,0 +1,155 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestParallelSolutionWriter
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/ParallelSolutionWriter.hpp>
+
+#include <opm/input/eclipse/Units/UnitSystem.hpp>
+#include <opm/output/data/Solution.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int numGlobalCells = 23;
+
+double pressure(const int globalIdx)
+{
+    return 1.0e5 + 10.0 * globalIdx;
+}
+
+double saturation(const int globalIdx)
+{
+    return 0.01 * globalIdx;
+}
+
+// The cells of a process are the global cells with index equal to its rank
+// modulo the number of processes, stored in reverse order of the global
+// index and after one cell that is not written, as an overlap cell.
+struct LocalCells
+{
+    explicit LocalCells(const Opm::Parallel::Communication& comm)
+    {
+        std::vector<int> cells;
+        for (int global = comm.rank(); global < numGlobalCells; global += comm.size()) {
+            cells.insert(cells.begin(), global);
+        }
+        std::vector<double> pres{-1.0};
+        std::vector<double> swat{-1.0};
+        for (const int global : cells) {
+            localIndex.push_back(pres.size());
+            globalIndex.push_back(global);
+            pres.push_back(pressure(global));
+            swat.push_back(saturation(global));
+        }
+        cellData.insert("PRESSURE", Opm::UnitSystem::measure::pressure, std::move(pres),
+                        Opm::data::TargetType::RESTART_SOLUTION);
+        cellData.insert("SWAT", Opm::UnitSystem::measure::identity, std::move(swat),
+                        Opm::data::TargetType::RESTART_SOLUTION);
+    }
+
+    Opm::data::Solution cellData;
+    std::vector<int> localIndex;
+    std::vector<int> globalIndex;
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+    const Opm::Parallel::Communication comm = Dune::MPIHelper::getCollectiveCommunication();
+    const LocalCells local(comm);
+    const std::string filename = "TEST_PARALLEL_SOLUTION.PSOL0001";
+
+    Opm::writeParallelSolution(comm, filename, local.cellData,
+                               local.localIndex, local.globalIndex, numGlobalCells);
+
+    const auto cellData = Opm::readParallelSolution(filename);
+    BOOST_REQUIRE_EQUAL(cellData.size(), 2U);
+    BOOST_REQUIRE(cellData.has("PRESSURE"));
+    BOOST_REQUIRE(cellData.has("SWAT"));
+    const auto& pres = cellData.at("PRESSURE");
+    const auto& swat = cellData.at("SWAT");
+    BOOST_CHECK(pres.dim == Opm::UnitSystem::measure::pressure);
+    BOOST_CHECK(swat.dim == Opm::UnitSystem::measure::identity);
+    BOOST_REQUIRE_EQUAL(pres.data.size(), std::size_t(numGlobalCells));
+    BOOST_REQUIRE_EQUAL(swat.data.size(), std::size_t(numGlobalCells));
+    for (int global = 0; global < numGlobalCells; ++global) {
+        BOOST_CHECK_EQUAL(pres.data[global], pressure(global));
+        BOOST_CHECK_EQUAL(swat.data[global], saturation(global));
+    }
+
+    comm.barrier();
+    if (comm.rank() == 0) {
+        std::remove(filename.c_str());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LongNameOnAllRanks)
+{
+    const Opm::Parallel::Communication comm = Dune::MPIHelper::getCollectiveCommunication();
+    LocalCells local(comm);
+    local.cellData.insert("PRESSURE_", Opm::UnitSystem::measure::pressure,
+                          std::vector<double>(local.localIndex.size() + 1, 0.0),
+                          Opm::data::TargetType::RESTART_SOLUTION);
+
+    BOOST_CHECK_THROW(Opm::writeParallelSolution(comm, "TEST_LONG_NAME.PSOL0001", local.cellData,
+                                                 local.localIndex, local.globalIndex,
+                                                 numGlobalCells),
+                      std::invalid_argument);
+}
+
+// Opening fails on all processes, which must all throw instead of some of
+// them waiting for the others in the next collective call.
+BOOST_AUTO_TEST_CASE(OpenFailsOnAllRanks)
+{
+    const Opm::Parallel::Communication comm = Dune::MPIHelper::getCollectiveCommunication();
+    const LocalCells local(comm);
+
+    BOOST_CHECK_THROW(Opm::writeParallelSolution(comm, "no_such_directory/TEST.PSOL0001",
+                                                 local.cellData, local.localIndex,
+                                                 local.globalIndex, numGlobalCells),
+                      std::runtime_error);
+
+    // All processes are still in step.
+    BOOST_CHECK_EQUAL(comm.sum(1), comm.size());
+}
+
+BOOST_AUTO_TEST_CASE(ReadMissingFile)
+{
+    BOOST_CHECK_THROW(Opm::readParallelSolution("no_such_directory/TEST.PSOL0001"),
+                      std::runtime_error);
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
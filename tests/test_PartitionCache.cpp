@@ -0,0 +1,90 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE PartitionCacheTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/input/eclipse/Schedule/Well/Well.hpp>
+#include <opm/simulators/utils/PartitionCache.hpp>
+
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(CacheInvalidation)
+{
+    namespace fs = std::filesystem;
+    const auto cacheFile = (fs::temp_directory_path() / "opm_partition_cache_test").string();
+    fs::remove(cacheFile);
+
+    const std::vector<int> globalCell {0, 1, 2, 4, 5, 7};
+    const std::vector<int> parts {0, 0, 1, 1, 2, 2};
+    const std::vector<Opm::Well> wells;
+    const auto key = Opm::partitionCacheKey(3, globalCell, wells, 1, 1.1, false);
+
+    BOOST_CHECK(!Opm::loadPartitionCache(cacheFile, key).has_value());
+    Opm::writePartitionCache(cacheFile, key, parts);
+
+    const auto cached = Opm::loadPartitionCache(cacheFile, key);
+    BOOST_REQUIRE(cached.has_value());
+    BOOST_CHECK_EQUAL_COLLECTIONS(cached->begin(), cached->end(), parts.begin(), parts.end());
+
+    // a different number of processes
+    BOOST_CHECK(!Opm::loadPartitionCache(cacheFile, Opm::partitionCacheKey(4, globalCell, wells, 1, 1.1, false)));
+
+    // different active cells
+    const std::vector<int> otherCells {0, 1, 2, 4, 5, 8};
+    BOOST_CHECK(!Opm::loadPartitionCache(cacheFile, Opm::partitionCacheKey(3, otherCells, wells, 1, 1.1, false)));
+
+    // different partitioning parameters
+    BOOST_CHECK(!Opm::loadPartitionCache(cacheFile, Opm::partitionCacheKey(3, globalCell, wells, 0, 1.1, false)));
+    BOOST_CHECK(!Opm::loadPartitionCache(cacheFile, Opm::partitionCacheKey(3, globalCell, wells, 1, 1.2, false)));
+    BOOST_CHECK(!Opm::loadPartitionCache(cacheFile, Opm::partitionCacheKey(3, globalCell, wells, 1, 1.1, true)));
+
+    fs::remove(cacheFile);
+}
+
+BOOST_AUTO_TEST_CASE(FailedWriteLeavesNoTemporaryFile)
+{
+    namespace fs = std::filesystem;
+    const auto dir = fs::temp_directory_path() / "opm_partition_cache_failed_write";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    // the temporary file is written, but cannot be renamed to a directory
+    const auto cacheFile = dir / "cache";
+    fs::create_directory(cacheFile);
+
+    const std::vector<int> globalCell {0, 1, 2};
+    const std::vector<int> parts {0, 1, 1};
+    const std::vector<Opm::Well> wells;
+    const auto key = Opm::partitionCacheKey(2, globalCell, wells, 1, 1.1, false);
+    BOOST_CHECK_THROW(Opm::writePartitionCache(cacheFile.string(), key, parts), std::runtime_error);
+
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        files.push_back(entry.path());
+    }
+    BOOST_REQUIRE_EQUAL(files.size(), 1U);
+    BOOST_CHECK(files[0] == cacheFile);
+
+    fs::remove_all(dir);
+}
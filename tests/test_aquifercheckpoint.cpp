@@ -0,0 +1,180 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE AquiferCheckpoint
+
+#include <opm/models/utils/propertysystem.hh>
+#include <opm/models/utils/parametersystem.hh>
+#include <ebos/eclproblem.hh>
+#include <ebos/ebos.hh>
+#include <opm/models/utils/start.hh>
+
+#include <opm/output/data/Aquifer.hpp>
+#include <opm/simulators/aquifers/BlackoilAquiferModel.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+namespace Opm::Properties {
+    namespace TTag {
+        struct TestAquiferCheckpointTypeTag {
+            using InheritsFrom = std::tuple<EbosTypeTag>;
+        };
+    }
+}
+
+template <class TypeTag>
+std::unique_ptr<Opm::GetPropType<TypeTag, Opm::Properties::Simulator>>
+initSimulator(const char *filename)
+{
+    using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+
+    std::string filename_arg = "--ecl-deck-file-name=";
+    filename_arg += filename;
+
+    const char* argv[] = {
+        "test_aquifercheckpoint",
+        filename_arg.c_str()
+    };
+
+    Opm::setupParameters_<TypeTag>(/*argc=*/sizeof(argv)/sizeof(argv[0]), argv, /*registerParams=*/true);
+
+    return std::unique_ptr<Simulator>(new Simulator);
+}
+
+namespace {
+
+// The sections of an eWoms restart file, kept in memory.
+class StreamRestarter
+{
+public:
+    void serializeSectionBegin(const std::string& name)
+    { stream_ << name << '\n'; }
+
+    std::ostream& serializeStream()
+    { return stream_; }
+
+    void serializeSectionEnd()
+    { stream_ << '\n'; }
+
+    void deserializeSectionBegin(const std::string& name)
+    {
+        std::string section;
+        stream_ >> section;
+        if (section != name) {
+            throw std::runtime_error("Expected section " + name + ", found " + section);
+        }
+    }
+
+    std::istream& deserializeStream()
+    { return stream_; }
+
+    void deserializeSectionEnd()
+    {}
+
+    std::string str() const
+    { return stream_.str(); }
+
+private:
+    std::stringstream stream_;
+};
+
+struct AquiferCheckpointFixture {
+    AquiferCheckpointFixture() {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+        Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::EclGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+        using TypeTag = Opm::Properties::TTag::TestAquiferCheckpointTypeTag;
+        Opm::registerAllParameters_<TypeTag>();
+    }
+};
+
+}
+
+BOOST_GLOBAL_FIXTURE(AquiferCheckpointFixture);
+
+BOOST_AUTO_TEST_CASE(FetkovichRoundTrip)
+{
+    using TypeTag = Opm::Properties::TTag::TestAquiferCheckpointTypeTag;
+    const std::string filename = "AQUFETP_CHECKPOINT.DATA";
+
+    // The initial aquifer pressure is computed from the equilibrium with the
+    // reservoir, which a run resumed from a checkpoint does not compute.
+    auto simulator = initSimulator<TypeTag>(filename.data());
+    simulator->model().applyInitialSolution();
+
+    StreamRestarter checkpoint;
+    simulator->problem().mutableAquiferModel().serialize(checkpoint);
+
+    auto resumed = initSimulator<TypeTag>(filename.data());
+    resumed->problem().mutableAquiferModel().deserialize(checkpoint);
+
+    const auto expected = simulator->problem().aquiferModel().aquiferData();
+    const auto restored = resumed->problem().aquiferModel().aquiferData();
+    BOOST_REQUIRE_EQUAL(expected.size(), 1U);
+    BOOST_REQUIRE_EQUAL(restored.size(), 1U);
+
+    const auto& aquifer = expected.at(1);
+    const auto& restoredAquifer = restored.at(1);
+    BOOST_CHECK_EQUAL(aquifer.volume, restoredAquifer.volume);
+    BOOST_CHECK_EQUAL(aquifer.pressure, restoredAquifer.pressure);
+    BOOST_CHECK_EQUAL(aquifer.initPressure, restoredAquifer.initPressure);
+    BOOST_CHECK(aquifer.pressure > 0.0);
+
+    // Writing the restored state gives the same checkpoint.
+    StreamRestarter rewritten;
+    resumed->problem().mutableAquiferModel().serialize(rewritten);
+    BOOST_CHECK_EQUAL(checkpoint.str(), rewritten.str());
+}
+
+BOOST_AUTO_TEST_CASE(MismatchedCheckpoint)
+{
+    using TypeTag = Opm::Properties::TTag::TestAquiferCheckpointTypeTag;
+    const std::string filename = "AQUFETP_CHECKPOINT.DATA";
+
+    // A checkpoint of a run without aquifers.
+    StreamRestarter checkpoint;
+    checkpoint.serializeSectionBegin("BlackoilAquiferModel");
+    checkpoint.serializeStream() << 0 << ' ' << 0 << ' ' << 0;
+    checkpoint.serializeSectionEnd();
+
+    auto simulator = initSimulator<TypeTag>(filename.data());
+    BOOST_CHECK_THROW(simulator->problem().mutableAquiferModel().deserialize(checkpoint),
+                      std::runtime_error);
+}
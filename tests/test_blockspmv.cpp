@@ -0,0 +1,126 @@
+/*
+  Copyright 2021 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE BlockSpMVTest
+
+#include <opm/simulators/linalg/BlockSpMV.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <boost/test/unit_test.hpp>
+
+template <int bsize>
+void testProducts()
+{
+    using Block = Opm::MatrixBlock<double, bsize, bsize>;
+    using Matrix = Dune::BCRSMatrix<Block>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bsize>>;
+
+    // tridiagonal block matrix with distinct entries
+    const int N = 100;
+    Matrix A(N, N, 3 * N, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int i = row.index();
+        if (i > 0) {
+            row.insert(i - 1);
+        }
+        row.insert(i);
+        if (i < N - 1) {
+            row.insert(i + 1);
+        }
+    }
+    double value = 0.0;
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (int ii = 0; ii < bsize; ++ii) {
+                for (int jj = 0; jj < bsize; ++jj) {
+                    value += 0.01;
+                    (*col)[ii][jj] = value * ((ii + jj) % 2 == 0 ? 1.0 : -1.0);
+                }
+            }
+        }
+    }
+
+    Vector x(N);
+    for (int i = 0; i < N; ++i) {
+        for (int ii = 0; ii < bsize; ++ii) {
+            x[i][ii] = 1.0 + 0.1 * i - 0.3 * ii;
+        }
+    }
+
+    Vector y(N), yRef(N);
+    A.mv(x, yRef);
+    y = 42.0;
+    Opm::detail::blockMv(A, x, y);
+    for (int i = 0; i < N; ++i) {
+        for (int ii = 0; ii < bsize; ++ii) {
+            BOOST_CHECK_CLOSE(y[i][ii], yRef[i][ii], 1e-12);
+        }
+    }
+
+    y = 1.0;
+    yRef = 1.0;
+    A.usmv(0.5, x, yRef);
+    Opm::detail::blockUsmv(0.5, A, x, y);
+    for (int i = 0; i < N; ++i) {
+        for (int ii = 0; ii < bsize; ++ii) {
+            BOOST_CHECK_CLOSE(y[i][ii], yRef[i][ii], 1e-12);
+        }
+    }
+
+    // only the first rows are touched
+    const int interior = N / 2;
+    y = 3.0;
+    Opm::detail::blockMv(A, x, y, interior);
+    A.mv(x, yRef);
+    for (int i = 0; i < N; ++i) {
+        for (int ii = 0; ii < bsize; ++ii) {
+            if (i < interior) {
+                BOOST_CHECK_CLOSE(y[i][ii], yRef[i][ii], 1e-12);
+            } else {
+                BOOST_CHECK_EQUAL(y[i][ii], 3.0);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BlockSize1)
+{
+    testProducts<1>();
+}
+
+BOOST_AUTO_TEST_CASE(BlockSize2)
+{
+    testProducts<2>();
+}
+
+BOOST_AUTO_TEST_CASE(BlockSize3)
+{
+    testProducts<3>();
+}
+
+BOOST_AUTO_TEST_CASE(BlockSize4)
+{
+    testProducts<4>();
+}
@@ -127,3 +127,52 @@ BOOST_AUTO_TEST_CASE(Failures)
     }
 }
 
+
+BOOST_AUTO_TEST_CASE(PrimaryVariableSwitches)
+{
+    Opm::ConvergenceReport s1;
+    BOOST_CHECK_EQUAL(s1.numSwitchedCells(), 0);
+    BOOST_CHECK_EQUAL(s1.numFrozenCells(), 0);
+
+    s1.setPrimaryVariableSwitches(12, 3);
+    BOOST_CHECK(s1.converged());
+    BOOST_CHECK_EQUAL(s1.numSwitchedCells(), 12);
+    BOOST_CHECK_EQUAL(s1.numFrozenCells(), 3);
+
+    Opm::ConvergenceReport s2;
+    s2.setPrimaryVariableSwitches(5, 1);
+    s1 += s2;
+    BOOST_CHECK_EQUAL(s1.numSwitchedCells(), 17);
+    BOOST_CHECK_EQUAL(s1.numFrozenCells(), 4);
+
+    s1.clear();
+    BOOST_CHECK_EQUAL(s1.numSwitchedCells(), 0);
+    BOOST_CHECK_EQUAL(s1.numFrozenCells(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(WorstCells)
+{
+    using CR = Opm::ConvergenceReport;
+    CR s1;
+    BOOST_CHECK(s1.worstCells().empty());
+
+    s1.setWorstCells({ CR::WorstCell{0, 17, 0, 0.5}, CR::WorstCell{0, 4, 1, 0.25} });
+    BOOST_CHECK(s1.converged());
+    BOOST_REQUIRE_EQUAL(s1.worstCells().size(), 2);
+    BOOST_CHECK_EQUAL(s1.worstCells()[0].phase(), 0);
+    BOOST_CHECK_EQUAL(s1.worstCells()[0].cell(), 17);
+    BOOST_CHECK_EQUAL(s1.worstCells()[0].rank(), 0);
+    BOOST_CHECK_EQUAL(s1.worstCells()[0].value(), 0.5);
+    BOOST_CHECK_EQUAL(s1.worstCells()[1].cell(), 4);
+    BOOST_CHECK_EQUAL(s1.worstCells()[1].rank(), 1);
+
+    CR s2;
+    s2.setWorstCells({ CR::WorstCell{1, 8, 2, 1.5} });
+    s1 += s2;
+    BOOST_REQUIRE_EQUAL(s1.worstCells().size(), 3);
+    BOOST_CHECK_EQUAL(s1.worstCells()[2].phase(), 1);
+    BOOST_CHECK_EQUAL(s1.worstCells()[2].value(), 1.5);
+
+    s1.clear();
+    BOOST_CHECK(s1.worstCells().empty());
+}
@@ -49,7 +49,7 @@ public:
 
 template <int bz>
 Dune::BlockVector<Dune::FieldVector<double, bz>>
-testCusparseSolver(const boost::property_tree::ptree& prm, const std::string& matrix_filename, const std::string& rhs_filename)
+testCusparseSolver(const boost::property_tree::ptree& prm, const std::string& matrix_filename, const std::string& rhs_filename, const std::string& linsolver)
 {
     using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bz, bz>>;
     using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
@@ -78,7 +78,6 @@ testCusparseSolver(const boost::property_tree::ptree& prm, const std::string& ma
     const int deviceID = 0;
     const std::string accelerator_mode("cusparse");
     const std::string fpga_bitstream("empty");    // unused
-    const std::string linsolver("ilu0");
     Dune::InverseOperatorResult result;
 
     Vector x(rhs.size());
@@ -102,10 +101,10 @@ testCusparseSolver(const boost::property_tree::ptree& prm, const std::string& ma
 
 namespace pt = boost::property_tree;
 
-void test3(const pt::ptree& prm)
+void test3(const pt::ptree& prm, const std::string& linsolver)
 {
     const int bz = 3;
-    auto sol = testCusparseSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+    auto sol = testCusparseSolver<bz>(prm, "matr33.txt", "rhs3.txt", linsolver);
     Dune::BlockVector<Dune::FieldVector<double, bz>> expected {{-0.0131626, -3.5826e-6, 1.138362e-9},
             {-1.25425e-3, -1.4167e-4, -0.0029366},
                 {-4.54355e-4, 1.28682e-5, 4.7644e-6}};
@@ -130,7 +129,25 @@ BOOST_AUTO_TEST_CASE(TestDefaultPreconditionerFactory)
 
     try {
         // Test with 3x3 block solvers.
-        test3(prm);
+        test3(prm, "ilu0");
+    } catch(const DeviceInitException& ) {
+        BOOST_WARN_MESSAGE(true, "Problem with initializing a device. skipping test");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestCprPreconditioner)
+{
+    pt::ptree prm;
+
+    // Read parameters.
+    {
+        std::ifstream file("options_flexiblesolver.json");
+        pt::read_json(file, prm);
+    }
+
+    try {
+        // Test with 3x3 block solvers, ilu0 and the pressure AMG.
+        test3(prm, "cpr_quasiimpes");
     } catch(const DeviceInitException& ) {
         BOOST_WARN_MESSAGE(true, "Problem with initializing a device. skipping test");
     }
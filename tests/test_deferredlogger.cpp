@@ -98,3 +98,29 @@ BOOST_AUTO_TEST_CASE(deferredlogger)
     BOOST_CHECK_EQUAL(log_stream.str(), expected);
 
 }
+
+BOOST_AUTO_TEST_CASE(discardedmessages)
+{
+    const std::string expected = Log::prefixMessage(Log::MessageType::Debug, "debug 1 of 2") + "\n"
+        + Log::prefixMessage(Log::MessageType::Info, "info 1") + "\n";
+
+    std::ostringstream log_stream;
+    initLogger(log_stream);
+    auto deferred_logger = Opm::DeferredLogger();
+    deferred_logger.debugFormat("debug {} of {}", 1, 2);
+
+    Opm::DeferredLogger::setDiscardedMessageTypes(Log::MessageType::Debug);
+    BOOST_CHECK(!Opm::DeferredLogger::isStored(Log::MessageType::Debug));
+    BOOST_CHECK(Opm::DeferredLogger::isStored(Log::MessageType::Info));
+    deferred_logger.debug("debug 2");
+    deferred_logger.debugFormat("debug {} of {}", 2, 2);
+    deferred_logger.info("info 1");
+    Opm::DeferredLogger::setDiscardedMessageTypes(0);
+
+    deferred_logger.logMessages();
+
+    auto counter = OpmLog::getBackend<CounterLog>("COUNTER");
+    BOOST_CHECK_EQUAL( 1 , counter->numMessages(Log::MessageType::Debug) );
+    BOOST_CHECK_EQUAL( 1 , counter->numMessages(Log::MessageType::Info) );
+    BOOST_CHECK_EQUAL(log_stream.str(), expected);
+}
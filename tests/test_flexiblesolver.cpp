@@ -42,7 +42,8 @@
 
 template <int bz>
 Dune::BlockVector<Dune::FieldVector<double, bz>>
-testSolver(const Opm::PropertyTree& prm, const std::string& matrix_filename, const std::string& rhs_filename)
+testSolver(const Opm::PropertyTree& prm, const std::string& matrix_filename, const std::string& rhs_filename,
+           Dune::InverseOperatorResult* result = nullptr)
 {
     using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bz, bz>>;
     using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
@@ -78,6 +79,9 @@ testSolver(const Opm::PropertyTree& prm, const std::string& matrix_filename, con
     Vector x(rhs.size());
     Dune::InverseOperatorResult res;
     solver.apply(x, rhs, res);
+    if (result != nullptr) {
+        *result = res;
+    }
     return x;
 }
 
@@ -123,6 +127,182 @@ BOOST_AUTO_TEST_CASE(TestFlexibleSolver)
     }
 }
 
+BOOST_AUTO_TEST_CASE(TestPipelinedBiCGSTAB)
+{
+    // Must give the same solution as the standard BiCGSTAB.
+    Opm::PropertyTree prm("options_flexiblesolver_pipelined.json");
+    Opm::PropertyTree prmRef("options_flexiblesolver_pipelined.json");
+    prmRef.put("solver", std::string("bicgstab"));
+
+    {
+        const int bz = 1;
+        auto sol = testSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+        auto ref = testSolver<bz>(prmRef, "matr33.txt", "rhs3.txt");
+        BOOST_REQUIRE_EQUAL(sol.size(), ref.size());
+        for (size_t i = 0; i < sol.size(); ++i) {
+            BOOST_CHECK_CLOSE(sol[i][0], ref[i][0], 1e-6);
+        }
+    }
+    {
+        const int bz = 3;
+        auto sol = testSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+        auto ref = testSolver<bz>(prmRef, "matr33.txt", "rhs3.txt");
+        BOOST_REQUIRE_EQUAL(sol.size(), ref.size());
+        for (size_t i = 0; i < sol.size(); ++i) {
+            for (int row = 0; row < bz; ++row) {
+                BOOST_CHECK_CLOSE(sol[i][row], ref[i][row], 1e-6);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestFloatMatrixCpr)
+{
+    // The residual updates inside CPR use a float copy of the matrix,
+    // the converged solution must not change.
+    Opm::PropertyTree prm("options_flexiblesolver.json");
+    prm.put("tol", 1e-10);
+    prm.put("maxiter", 200);
+    prm.put("preconditioner.verbosity", 0);
+    Opm::PropertyTree prmRef(prm);
+    prm.put("preconditioner.matrix_precision", std::string("float"));
+
+    const int bz = 3;
+    auto sol = testSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+    auto ref = testSolver<bz>(prmRef, "matr33.txt", "rhs3.txt");
+    BOOST_REQUIRE_EQUAL(sol.size(), ref.size());
+    const double scale = ref.infinity_norm();
+    for (size_t i = 0; i < sol.size(); ++i) {
+        for (int row = 0; row < bz; ++row) {
+            BOOST_CHECK_SMALL(sol[i][row] - ref[i][row], 1e-6 * scale);
+        }
+    }
+
+    prm.put("preconditioner.matrix_precision", std::string("half"));
+    BOOST_CHECK_THROW(testSolver<bz>(prm, "matr33.txt", "rhs3.txt"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestFloatPressureCpr)
+{
+    // The coarse pressure system of CPR is solved in float, the outer
+    // solver must still converge to the solution of the double version.
+    Opm::PropertyTree prm("options_flexiblesolver.json");
+    prm.put("tol", 1e-10);
+    prm.put("maxiter", 200);
+    prm.put("preconditioner.verbosity", 0);
+    Opm::PropertyTree prmRef(prm);
+    prm.put("preconditioner.pressure_precision", std::string("float"));
+
+    const int bz = 3;
+    Dune::InverseOperatorResult res;
+    Dune::InverseOperatorResult resRef;
+    auto sol = testSolver<bz>(prm, "matr33.txt", "rhs3.txt", &res);
+    auto ref = testSolver<bz>(prmRef, "matr33.txt", "rhs3.txt", &resRef);
+    BOOST_CHECK(res.converged);
+    BOOST_CHECK(resRef.converged);
+    BOOST_REQUIRE_EQUAL(sol.size(), ref.size());
+    const double scale = ref.infinity_norm();
+    for (size_t i = 0; i < sol.size(); ++i) {
+        for (int row = 0; row < bz; ++row) {
+            BOOST_CHECK_SMALL(sol[i][row] - ref[i][row], 1e-6 * scale);
+        }
+    }
+
+    prm.put("preconditioner.pressure_precision", std::string("half"));
+    BOOST_CHECK_THROW(testSolver<bz>(prm, "matr33.txt", "rhs3.txt"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestFloatCprNeedsDoubleSystem)
+{
+    // A float system has no lower precision to use inside CPR, asking for
+    // one must not be silently ignored.
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<float, 1, 1>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<float, 1>>;
+    Matrix matrix;
+    {
+        std::ifstream mfile("matr33.txt");
+        BOOST_REQUIRE(mfile);
+        readMatrixMarket(matrix, mfile);
+    }
+    auto wc = [&matrix]()
+    {
+        return Opm::Amg::getQuasiImpesWeights<Matrix, Vector>(matrix, 0, false);
+    };
+    using SeqOperatorType = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+    SeqOperatorType op(matrix);
+
+    Opm::PropertyTree prm("options_flexiblesolver.json");
+    prm.put("preconditioner.verbosity", 0);
+    using Solver = Dune::FlexibleSolver<Matrix, Vector>;
+    {
+        Opm::PropertyTree prmFloat(prm);
+        prmFloat.put("preconditioner.pressure_precision", std::string("float"));
+        BOOST_CHECK_THROW(Solver(op, prmFloat, wc, 0), std::invalid_argument);
+    }
+    {
+        Opm::PropertyTree prmFloat(prm);
+        prmFloat.put("preconditioner.matrix_precision", std::string("float"));
+        BOOST_CHECK_THROW(Solver(op, prmFloat, wc, 0), std::invalid_argument);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestRecyclingSolver)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+    Matrix matrix;
+    {
+        std::ifstream mfile("matr33.txt");
+        BOOST_REQUIRE(mfile);
+        readMatrixMarket(matrix, mfile);
+    }
+    Vector rhs;
+    {
+        std::ifstream rhsfile("rhs3.txt");
+        BOOST_REQUIRE(rhsfile);
+        readMatrixMarket(rhs, rhsfile);
+    }
+
+    Opm::PropertyTree prm("options_flexiblesolver_pipelined.json");
+    prm.put("solver", std::string("bicgstab"));
+    prm.put("recycle", 2);
+    auto wc = [&matrix]()
+    {
+        return Opm::Amg::getQuasiImpesWeights<Matrix, Vector>(matrix, 1, false);
+    };
+    using SeqOperatorType = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+    SeqOperatorType op(matrix);
+    Dune::FlexibleSolver<Matrix, Vector> solver(op, prm, wc, 1);
+
+    Vector x(rhs.size());
+    x = 0.0;
+    Vector b(rhs);
+    Dune::InverseOperatorResult res;
+    solver.apply(x, b, res);
+    BOOST_CHECK(res.converged);
+    BOOST_CHECK(res.iterations > 0);
+
+    // The solution of the same system is found in the recycled subspace.
+    Vector y(rhs.size());
+    y = 0.0;
+    b = rhs;
+    solver.apply(y, b, res);
+    BOOST_CHECK(res.converged);
+    BOOST_CHECK_EQUAL(res.iterations, 0);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        BOOST_CHECK_CLOSE(y[i][0], x[i][0], 1e-6);
+    }
+
+    // The recycled solutions can be handed to a new solver.
+    Dune::FlexibleSolver<Matrix, Vector> solver2(op, prm, wc, 1);
+    solver2.setRecycledSolutions(solver.releaseRecycledSolutions());
+    y = 0.0;
+    b = rhs;
+    solver2.apply(y, b, res);
+    BOOST_CHECK(res.converged);
+    BOOST_CHECK_EQUAL(res.iterations, 0);
+}
+
 #else
 
 // Do nothing if we do not have at least Dune 2.6.
@@ -29,6 +29,10 @@
 #include <opm/simulators/timestepping/gatherConvergenceReport.hpp>
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <opm/common/OpmLog/CounterLog.hpp>
+#include <opm/common/OpmLog/LogUtil.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
+
 #if HAVE_MPI
 struct MPIError
 {
@@ -106,6 +110,35 @@ BOOST_AUTO_TEST_CASE(EvenHaveFailure)
     }
 }
 
+BOOST_AUTO_TEST_CASE(ReportAndMessages)
+{
+    auto cc = Dune::MPIHelper::getCollectiveCommunication();
+    Opm::OpmLog::removeAllBackends();
+    auto counter = std::make_shared<Opm::CounterLog>();
+    Opm::OpmLog::addBackend("COUNTER", counter);
+
+    using CR = Opm::ConvergenceReport;
+    CR cr;
+    Opm::DeferredLogger local_deferredlogger;
+    const std::string name = "WellRank" + std::to_string(cc.rank());
+    if (cc.rank() % 2 == 1) {
+        cr.setWellFailed({CR::WellFailure::Type::ControlBHP, CR::Severity::Normal, -1, name});
+    }
+    local_deferredlogger.info("info from " + name);
+    local_deferredlogger.warning("tagme", "warning from " + name);
+
+    auto [global_cr, global_deferredlogger] = gatherConvergenceReport(cr, local_deferredlogger, cc);
+    BOOST_CHECK(global_cr.wellFailures().size() == std::size_t(cc.size() / 2));
+    if (cc.rank() % 2 == 1) {
+        BOOST_CHECK(global_cr.wellFailures()[cc.rank()/2] == cr.wellFailures()[0]);
+    }
+
+    global_deferredlogger.logMessages();
+    BOOST_CHECK_EQUAL(counter->numMessages(Opm::Log::MessageType::Info), cc.size());
+    BOOST_CHECK_EQUAL(counter->numMessages(Opm::Log::MessageType::Warning), cc.size());
+    Opm::OpmLog::removeAllBackends();
+}
+
 int main(int argc, char** argv)
 {
     Dune::MPIHelper::instance(argc, argv);
@@ -99,3 +99,47 @@ BOOST_AUTO_TEST_CASE(TestWelschPowell)
                                            graph, 0);
     checkAllIndices(newOrder);
 }
+
+BOOST_AUTO_TEST_CASE(TestReverseCuthillMcKee)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double,1,1>>;
+    using Graph = Dune::Amg::MatrixGraph<Matrix>;
+    // A chain whose vertices are numbered with a stride through the chain.
+    const int N = 20;
+    auto chainVertex = [N](int k) { return (7 * k) % N; };
+    Matrix matrix(N, N, 3, 0.4, Matrix::implicit);
+    for (int k = 0; k < N; ++k)
+    {
+        const auto index = chainVertex(k);
+        matrix.entry(index, index) = 1;
+        if ( k > 0 )
+        {
+            matrix.entry(index, chainVertex(k - 1)) = 1;
+        }
+        if ( k < N - 1 )
+        {
+            matrix.entry(index, chainVertex(k + 1)) = 1;
+        }
+    }
+    matrix.compress();
+
+    Graph graph(matrix);
+    auto newOrder = Opm::reorderVerticesReverseCuthillMcKee(graph, N);
+    checkAllIndices(newOrder);
+    // The reordered chain has bandwidth one.
+    for (int k = 1; k < N; ++k)
+    {
+        const auto first = newOrder[chainVertex(k - 1)];
+        const auto second = newOrder[chainVertex(k)];
+        BOOST_CHECK(std::max(first, second) - std::min(first, second) == 1);
+    }
+
+    // Trailing vertices, e.g. ghost rows, keep their index.
+    const std::size_t noReordered = 15;
+    newOrder = Opm::reorderVerticesReverseCuthillMcKee(graph, noReordered);
+    checkAllIndices(newOrder);
+    for (std::size_t vertex = noReordered; vertex < newOrder.size(); ++vertex)
+    {
+        BOOST_CHECK(newOrder[vertex] == vertex);
+    }
+}
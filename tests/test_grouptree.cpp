@@ -0,0 +1,122 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE GroupTreeTest
+
+#include <opm/simulators/wells/GroupTree.hpp>
+
+#include <opm/input/eclipse/Deck/Deck.hpp>
+#include <opm/input/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/input/eclipse/Parser/Parser.hpp>
+#include <opm/input/eclipse/Python/Python.hpp>
+#include <opm/input/eclipse/Schedule/Group/Group.hpp>
+#include <opm/input/eclipse/Schedule/Schedule.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+namespace {
+
+const std::string deck_string = R"(
+RUNSPEC
+OIL
+WATER
+DIMENS
+   5 5 1 /
+GRID
+DXV
+5*100.0 /
+DYV
+5*100.0 /
+DZV
+10.0 /
+TOPS
+25*1000 /
+PERMX
+25*100 /
+PERMY
+25*100 /
+PERMZ
+25*10 /
+PORO
+25*0.3 /
+SCHEDULE
+GRUPTREE
+ 'G1'  'FIELD' /
+ 'G2'  'FIELD' /
+ 'G11' 'G1' /
+ 'G12' 'G1' /
+/
+WELSPECS
+ 'P1' 'G11' 1 1 1* 'OIL' /
+ 'P2' 'G12' 5 5 1* 'OIL' /
+ 'I1' 'G2'  3 3 1* 'WATER' /
+/
+TSTEP
+ 10 /
+)";
+
+struct Setup
+{
+    Setup()
+        : deck(Opm::Parser{}.parseString(deck_string))
+        , es(deck)
+        , sched(deck, es, std::make_shared<Opm::Python>())
+    {}
+
+    Opm::Deck deck;
+    Opm::EclipseState es;
+    Opm::Schedule sched;
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(NestedGroups)
+{
+    const Setup setup;
+    const Opm::GroupTree tree(setup.sched, 0);
+
+    BOOST_CHECK_EQUAL(tree.reportStep(), 0);
+    BOOST_CHECK_EQUAL(tree.size(), 5U);
+    BOOST_CHECK_EQUAL(tree.name(tree.root()), "FIELD");
+    BOOST_CHECK_EQUAL(tree.parent(tree.root()), -1);
+    BOOST_CHECK(!tree.index("NO_SUCH_GROUP").has_value());
+
+    for (std::size_t g = 0; g < tree.size(); ++g) {
+        const auto& group = tree.group(g);
+        BOOST_CHECK_EQUAL(group.name(), tree.name(g));
+        BOOST_CHECK_EQUAL(tree.index(group.name()).value(), g);
+
+        // every group comes after its subgroups, which are the subgroups of the Schedule
+        const auto& children = tree.children(g);
+        BOOST_REQUIRE_EQUAL(children.size(), group.groups().size());
+        for (std::size_t c = 0; c < children.size(); ++c) {
+            BOOST_CHECK_LT(children[c], g);
+            BOOST_CHECK_EQUAL(tree.name(children[c]), group.groups()[c]);
+            BOOST_CHECK_EQUAL(tree.parent(children[c]), static_cast<int>(g));
+        }
+    }
+
+    const auto g1 = tree.index("G1").value();
+    BOOST_CHECK_EQUAL(tree.parent(tree.index("G11").value()), static_cast<int>(g1));
+    BOOST_CHECK_EQUAL(tree.parent(g1), static_cast<int>(tree.root()));
+}
@@ -0,0 +1,67 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE MemoryRegistryTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/MemoryRegistry.hpp>
+
+#include <vector>
+
+using Owner = Opm::MemoryRegistry::Owner;
+
+BOOST_AUTO_TEST_CASE(AccountsAddAndRemoveTheirShare)
+{
+    const auto& entry = Opm::MemoryRegistry::entry(Owner::WellState);
+    BOOST_CHECK_EQUAL(entry.current, 0u);
+
+    {
+        Opm::MemoryAccount a(Owner::WellState);
+        a.set(1000);
+        BOOST_CHECK_EQUAL(entry.current, 1000u);
+
+        // a copy is counted again
+        Opm::MemoryAccount b(a);
+        BOOST_CHECK_EQUAL(b.bytes(), 1000u);
+        BOOST_CHECK_EQUAL(entry.current, 2000u);
+
+        // shrinking keeps the peak
+        a.set(400);
+        BOOST_CHECK_EQUAL(entry.current, 1400u);
+        BOOST_CHECK_EQUAL(entry.peak, 2000u);
+
+        b = a;
+        BOOST_CHECK_EQUAL(entry.current, 800u);
+    }
+    BOOST_CHECK_EQUAL(entry.current, 0u);
+    BOOST_CHECK_EQUAL(entry.peak, 2000u);
+
+    // the other owners are untouched
+    BOOST_CHECK_EQUAL(Opm::MemoryRegistry::entry(Owner::Jacobian).peak, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(SizeOfContainers)
+{
+    std::vector<double> v;
+    v.reserve(10);
+    BOOST_CHECK_EQUAL(Opm::memoryBytes(v), 10 * sizeof(double));
+    BOOST_CHECK_GT(Opm::MemoryRegistry::peakResidentBytes(), 0u);
+}
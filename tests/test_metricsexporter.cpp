@@ -0,0 +1,105 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE MetricsExporterTest
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/timestepping/SimulatorReport.hpp>
+#include <opm/simulators/utils/MetricsExporter.hpp>
+#include <opm/simulators/utils/TimingRegistry.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace {
+
+Opm::SimulatorReportSingle substep(const double time, const double length, const bool converged)
+{
+    Opm::SimulatorReportSingle report;
+    report.global_time = time;
+    report.timestep_length = length;
+    report.converged = converged;
+    report.total_newton_iterations = 3;
+    report.total_linear_iterations = 20;
+    return report;
+}
+
+std::string readFile(const std::filesystem::path& path)
+{
+    std::ifstream is(path);
+    return {std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SnapshotAfterEverySubstep)
+{
+    namespace fs = std::filesystem;
+    const auto file = fs::temp_directory_path() / "opm_metrics_exporter_test.json";
+    fs::remove(file);
+
+    Opm::TimingRegistry::reset();
+    Opm::TimingRegistry::add(Opm::TimingRegistry::Region::Assembly, 2.0);
+
+    auto comm = Dune::MPIHelper::getCollectiveCommunication();
+    Opm::MetricsExporter exporter(comm, file.string(), 100.0);
+
+    exporter.update(substep(0.0, 10.0, true), 1);
+    BOOST_CHECK_EQUAL(exporter.substeps(), 1);
+    BOOST_CHECK_EQUAL(readFile(file), exporter.snapshot());
+    BOOST_CHECK(exporter.snapshot().find("\"simulated_time\": 10,") != std::string::npos);
+
+    // a failed substep is counted, but does not advance the simulated time
+    exporter.update(substep(10.0, 20.0, false), 1);
+    exporter.update(substep(10.0, 5.0, true), 1);
+    BOOST_CHECK_EQUAL(exporter.substeps(), 3);
+    BOOST_CHECK_EQUAL(exporter.failedSubsteps(), 1);
+
+    const auto snapshot = readFile(file);
+    BOOST_CHECK_EQUAL(snapshot, exporter.snapshot());
+    BOOST_CHECK(snapshot.find("\"simulated_time\": 15,") != std::string::npos);
+    BOOST_CHECK(snapshot.find("\"progress\": 0.150000") != std::string::npos);
+    BOOST_CHECK(snapshot.find("\"failed_substeps\": 1,") != std::string::npos);
+    BOOST_CHECK(snapshot.find("\"newton_iterations\": 9,") != std::string::npos);
+    BOOST_CHECK(snapshot.find("\"Assembly\": {\"max\": 2,") != std::string::npos);
+    // only the regions with a time are listed
+    BOOST_CHECK(snapshot.find("\"Output write\"") == std::string::npos);
+    BOOST_CHECK(!fs::exists(file.string() + ".tmp"));
+
+    fs::remove(file);
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
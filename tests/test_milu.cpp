@@ -200,3 +200,139 @@ BOOST_AUTO_TEST_CASE(MILULaplace4)
 {
     test<4>();
 }
+
+template<int bsize>
+void testLevelScheduledILU0()
+{
+    std::size_t N = 32;
+    Dune::BCRSMatrix<Dune::FieldMatrix<double, bsize, bsize> > A;
+    setupLaplacian(A, N);
+
+    Opm::detail::LevelSets lower, upper;
+    Opm::detail::computeLevelSets(A, A.N(), lower, upper);
+    // natural ordering of the 2D Laplacian gives one level per antidiagonal
+    BOOST_CHECK_EQUAL(lower.size(), 2 * N - 1);
+    BOOST_CHECK_EQUAL(upper.size(), 2 * N - 1);
+    BOOST_CHECK_EQUAL(lower.rows.size(), A.N());
+    BOOST_CHECK_EQUAL(upper.rows.size(), A.N());
+
+    auto ILU = A;
+    auto levelILU = A;
+    Opm::detail::ghost_last_bilu0_decomposition(ILU, A.N());
+    Opm::detail::level_bilu0_decomposition(levelILU, lower);
+
+    for ( auto irow = ILU.begin(), iend = ILU.end(); irow != iend; ++irow)
+    {
+        for ( auto col = irow->begin(), cend = irow->end(); col != cend; ++col)
+        {
+            auto diff = *col;
+            diff -= levelILU[irow.index()][col.index()];
+            BOOST_CHECK_EQUAL(diff.frobenius_norm(), 0.0);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LevelScheduledILU0)
+{
+    testLevelScheduledILU0<1>();
+    testLevelScheduledILU0<3>();
+}
+
+template<int bsize>
+void testILUnUpdate()
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bsize, bsize> >;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bsize> >;
+    using ILU = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector>;
+
+    std::size_t N = 8;
+    Matrix A;
+    setupLaplacian(A, N);
+
+    ILU reused(A, 1, 1.0, Opm::MILU_VARIANT::ILU);
+
+    // new values in the same sparsity pattern
+    for ( auto irow = A.begin(), iend = A.end(); irow != iend; ++irow)
+    {
+        for ( auto col = irow->begin(), cend = irow->end(); col != cend; ++col)
+        {
+            *col *= 1.0 + 0.1 * ((irow.index() + col.index()) % 3);
+        }
+    }
+    reused.update();
+    ILU fresh(A, 1, 1.0, Opm::MILU_VARIANT::ILU);
+
+    Vector d(A.N()), v1(A.N()), v2(A.N());
+    for ( std::size_t i = 0; i < d.size(); ++i)
+    {
+        d[i] = 1.0 + i;
+    }
+    v1 = 0;
+    v2 = 0;
+    reused.apply(v1, d);
+    fresh.apply(v2, d);
+    for ( std::size_t i = 0; i < v1.size(); ++i)
+    {
+        for ( int j = 0; j < bsize; ++j)
+        {
+            BOOST_CHECK_CLOSE(v1[i][j], v2[i][j], 1e-10);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ILUnUpdateReusesPattern)
+{
+    testILUnUpdate<1>();
+    testILUnUpdate<3>();
+}
+
+template<int bsize>
+void testFloatFactors()
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bsize, bsize> >;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bsize> >;
+    using ILU = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector>;
+
+    std::size_t N = 8;
+    Matrix A;
+    setupLaplacian(A, N);
+
+    ILU doubleILU(A, 0, 1.0, Opm::MILU_VARIANT::ILU);
+    ILU floatILU(A, 0, 1.0, Opm::MILU_VARIANT::ILU);
+    floatILU.setFloatFactors(true);
+
+    Vector d(A.N()), v1(A.N()), v2(A.N());
+    for ( std::size_t i = 0; i < d.size(); ++i)
+    {
+        d[i] = 1.0 + i;
+    }
+    v1 = 0;
+    v2 = 0;
+    doubleILU.apply(v1, d);
+    floatILU.apply(v2, d);
+    for ( std::size_t i = 0; i < v1.size(); ++i)
+    {
+        for ( int j = 0; j < bsize; ++j)
+        {
+            BOOST_CHECK_CLOSE(v1[i][j], v2[i][j], 1e-4);
+        }
+    }
+
+    // updates keep the single precision storage
+    floatILU.update();
+    v2 = 0;
+    floatILU.apply(v2, d);
+    for ( std::size_t i = 0; i < v1.size(); ++i)
+    {
+        for ( int j = 0; j < bsize; ++j)
+        {
+            BOOST_CHECK_CLOSE(v1[i][j], v2[i][j], 1e-4);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ILU0FloatFactors)
+{
+    testFloatFactors<1>();
+    testFloatFactors<3>();
+}
@@ -0,0 +1,155 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE MsrsbPreconditionerTest
+
+#include <opm/simulators/linalg/MsrsbPreconditioner.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/solvers.hh>
+
+#include <boost/test/unit_test.hpp>
+
+using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+
+namespace {
+
+// two point pressure equation on an n x n grid, the right half of the
+// grid has a higher permeability
+Matrix makeMatrix(const int n, const double contrast)
+{
+    const int N = n * n;
+    Matrix A(N, N, 5 * N, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int r = row.index();
+        const int i = r % n;
+        const int j = r / n;
+        if (j > 0) {
+            row.insert(r - n);
+        }
+        if (i > 0) {
+            row.insert(r - 1);
+        }
+        row.insert(r);
+        if (i < n - 1) {
+            row.insert(r + 1);
+        }
+        if (j < n - 1) {
+            row.insert(r + n);
+        }
+    }
+    const auto perm = [n, contrast](const int cell) { return (cell % n) < n / 2 ? 1.0 : contrast; };
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        const int r = row.index();
+        double diagonal = 0.0;
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            const int c = col.index();
+            if (c != r) {
+                // harmonic average
+                const double trans = 2.0 / (1.0 / perm(r) + 1.0 / perm(c));
+                *col = -trans;
+                diagonal += trans;
+            }
+        }
+        // a well in the first cell, and a little compressibility
+        A[r][r] = diagonal + (r == 0 ? 1.0 : 0.0) + 1e-4 * perm(r);
+    }
+    return A;
+}
+
+Vector makeRhs(const int n)
+{
+    Vector b(n * n);
+    b = 0.0;
+    b[n * n / 3] = 1.0;
+    b[2 * n * n / 3] = -0.5;
+    b[n * n - 1] = 1.0;
+    return b;
+}
+
+template <class Prec>
+Dune::InverseOperatorResult solve(const Matrix& A, Prec& prec, Vector& x)
+{
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    Dune::BiCGSTABSolver<Vector> solver(op, prec, 1e-8, 1000, 0);
+    Vector b = makeRhs(40);
+    x = 0.0;
+    Dune::InverseOperatorResult res;
+    solver.apply(x, b, res);
+    return res;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(FewerIterationsThanILU0)
+{
+    const int n = 40;
+    const Matrix A = makeMatrix(n, 100.0);
+    Opm::PropertyTree prm;
+    prm.put("coarse_size", 36);
+
+    Opm::MsrsbPreconditioner<Matrix, Vector> msrsb(A, prm);
+    BOOST_CHECK_GT(msrsb.numBlocks(), 1);
+    BOOST_CHECK_LT(msrsb.numBlocks(), n * n / 10);
+    BOOST_CHECK_GT(msrsb.basisIterations(), 0);
+
+    Vector x(n * n);
+    const auto res = solve(A, msrsb, x);
+    BOOST_CHECK(res.converged);
+
+    Vector r = makeRhs(n);
+    A.mmv(x, r);
+    BOOST_CHECK_LT(r.two_norm(), 1e-6 * makeRhs(n).two_norm());
+
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> ilu(A, 0, 1.0, Opm::MILU_VARIANT::ILU);
+    const auto ilu_res = solve(A, ilu, x);
+    BOOST_CHECK(ilu_res.converged);
+    BOOST_CHECK_LT(res.iterations, ilu_res.iterations);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateAfterMatrixChange)
+{
+    const int n = 40;
+    Matrix A = makeMatrix(n, 100.0);
+    Opm::PropertyTree prm;
+    prm.put("coarse_size", 36);
+    prm.put("basis_iterations", 1000);
+    Opm::MsrsbPreconditioner<Matrix, Vector> msrsb(A, prm);
+    const int first_iterations = msrsb.basisIterations();
+
+    // a small change of the matrix continues from the previous basis
+    A = makeMatrix(n, 110.0);
+    msrsb.update();
+    BOOST_CHECK_LT(msrsb.basisIterations(), first_iterations);
+
+    Vector x(n * n);
+    const auto res = solve(A, msrsb, x);
+    BOOST_CHECK(res.converged);
+    Vector r = makeRhs(n);
+    A.mmv(x, r);
+    BOOST_CHECK_LT(r.two_norm(), 1e-6 * makeRhs(n).two_norm());
+}
@@ -0,0 +1,192 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE MSWellTreeLUTest
+
+#include <opm/simulators/wells/MSWellTreeLU.hpp>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+namespace {
+
+constexpr int bs = 4;
+using Block = Dune::FieldMatrix<double, bs, bs>;
+using Matrix = Dune::BCRSMatrix<Block>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, bs>>;
+using TreeLU = Opm::MSWellTreeLU<Matrix, Vector>;
+
+// matrix with the pattern of a multisegment well, every segment is coupled to its outlet and inlets
+Matrix makeMatrix(const std::vector<int>& outlets)
+{
+    const int n = outlets.size();
+    int nnz = n;
+    for (const int outlet : outlets) {
+        nnz += (outlet >= 0) ? 2 : 0;
+    }
+    Matrix D(n, n, nnz, Matrix::row_wise);
+    for (auto row = D.createbegin(); row != D.createend(); ++row) {
+        const int seg = row.index();
+        row.insert(seg);
+        if (outlets[seg] >= 0) {
+            row.insert(outlets[seg]);
+        }
+        for (int inlet = 0; inlet < n; ++inlet) {
+            if (outlets[inlet] == seg) {
+                row.insert(inlet);
+            }
+        }
+    }
+
+    double value = 0.0;
+    for (auto row = D.begin(); row != D.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (int i = 0; i < bs; ++i) {
+                for (int j = 0; j < bs; ++j) {
+                    value += 0.017;
+                    (*col)[i][j] = ((i + j) % 3 == 0 ? 1.0 : -0.5) * (value - static_cast<int>(value));
+                    if (row.index() == col.index() && i == j) {
+                        (*col)[i][j] += 10.0;
+                    }
+                }
+            }
+        }
+    }
+    return D;
+}
+
+Vector makeVector(const int n, const double shift)
+{
+    Vector x(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < bs; ++j) {
+            x[i][j] = shift + 0.3 * i - 0.7 * j;
+        }
+    }
+    return x;
+}
+
+// reference solution with a dense solve
+Vector denseSolve(const Matrix& D, const Vector& b)
+{
+    const int n = D.N();
+    Dune::DynamicMatrix<double> dense(n * bs, n * bs, 0.0);
+    Dune::DynamicVector<double> rhs(n * bs), sol(n * bs);
+    for (auto row = D.begin(); row != D.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (int i = 0; i < bs; ++i) {
+                for (int j = 0; j < bs; ++j) {
+                    dense[row.index() * bs + i][col.index() * bs + j] = (*col)[i][j];
+                }
+            }
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < bs; ++j) {
+            rhs[i * bs + j] = b[i][j];
+        }
+    }
+    dense.solve(sol, rhs);
+    Vector x(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < bs; ++j) {
+            x[i][j] = sol[i * bs + j];
+        }
+    }
+    return x;
+}
+
+void testTree(const std::vector<int>& outlets)
+{
+    const Matrix D = makeMatrix(outlets);
+    TreeLU lu;
+    BOOST_CHECK(lu.analyze(outlets, D));
+    BOOST_CHECK(lu.factorize(D));
+    BOOST_CHECK(lu.factorized());
+
+    // the factorization is reused for several right hand sides
+    for (const double shift : {1.0, -2.5, 0.25}) {
+        const Vector b = makeVector(outlets.size(), shift);
+        const Vector ref = denseSolve(D, b);
+        Vector x = b;
+        lu.solve(x);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            for (int j = 0; j < bs; ++j) {
+                BOOST_CHECK_CLOSE(x[i][j], ref[i][j], 1e-8);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SingleSegment)
+{
+    testTree({-1});
+}
+
+BOOST_AUTO_TEST_CASE(StraightWell)
+{
+    testTree({-1, 0, 1, 2, 3, 4});
+}
+
+BOOST_AUTO_TEST_CASE(BranchedWell)
+{
+    // two laterals branching off the main bore, and an outlet with a larger index than its inlet
+    testTree({-1, 0, 1, 2, 1, 4, 7, 2, 6, 3});
+}
+
+BOOST_AUTO_TEST_CASE(InvalidPattern)
+{
+    // the pattern contains a coupling between segments 1 and 2, which are siblings
+    const std::vector<int> outlets {-1, 0, 0};
+    Matrix D(3, 3, 9, Matrix::row_wise);
+    for (auto row = D.createbegin(); row != D.createend(); ++row) {
+        for (int col = 0; col < 3; ++col) {
+            row.insert(col);
+        }
+    }
+    D = 1.0;
+    TreeLU lu;
+    BOOST_CHECK(!lu.analyze(outlets, D));
+    BOOST_CHECK(!lu.valid());
+    BOOST_CHECK(!lu.factorize(D));
+}
+
+BOOST_AUTO_TEST_CASE(SingularPivot)
+{
+    const std::vector<int> outlets {-1, 0};
+    Matrix D = makeMatrix(outlets);
+    D[1][1] = 0.0;
+    TreeLU lu;
+    BOOST_CHECK(lu.analyze(outlets, D));
+    BOOST_CHECK(!lu.factorize(D));
+    BOOST_CHECK(lu.singular());
+    lu.invalidate();
+    BOOST_CHECK(!lu.singular());
+}
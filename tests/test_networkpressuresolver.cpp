@@ -0,0 +1,128 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE NetworkPressureSolverTest
+
+#include <opm/simulators/wells/NetworkPressureSolver.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using Solver = Opm::NetworkPressureSolver;
+
+// quadratic pressure drop in the branch, with a coefficient per node
+Solver::BranchPressure quadraticBranch(const std::vector<double>& coefficients)
+{
+    return [coefficients](const int node, const Solver::Rates& rates, const double up_press) {
+        const double total = rates[0] + rates[1] + rates[2];
+        return up_press + coefficients[node] * total * total;
+    };
+}
+
+// a root with a fixed pressure, a manifold and two leaves
+std::vector<Solver::Node> makeNetwork(const double derivative)
+{
+    std::vector<Solver::Node> nodes(4);
+    nodes[0].fixed_pressure = 20.0e5;
+    nodes[1].parent = 0;
+    nodes[2].parent = 1;
+    nodes[3].parent = 1;
+    nodes[2].inflow = {0.01, 0.02, 0.03};
+    nodes[3].inflow = {0.02, 0.01, 0.04};
+    for (const int leaf : {2, 3}) {
+        nodes[leaf].reference_pressure = 30.0e5;
+        nodes[leaf].inflow_derivative = {derivative, derivative, 2.0 * derivative};
+    }
+    return nodes;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(FixedInflow)
+{
+    // without an inflow derivative the sweep is the solution
+    const std::vector<double> coefficients {0.0, 1.0e7, 2.0e7, 3.0e7};
+    Solver solver(makeNetwork(0.0), quadraticBranch(coefficients));
+    std::vector<double> pressures {20.0e5, 0.0, 0.0, 0.0};
+    pressures[1] = 20.0e5 + 1.0e7 * 0.13 * 0.13;
+    pressures[2] = pressures[1] + 2.0e7 * 0.06 * 0.06;
+    pressures[3] = pressures[1] + 3.0e7 * 0.07 * 0.07;
+    const auto sweep = pressures;
+
+    BOOST_CHECK(solver.solve(pressures, 1.0e-3, 10));
+    BOOST_CHECK_EQUAL(solver.iterations(), 0);
+    for (std::size_t i = 0; i < pressures.size(); ++i) {
+        BOOST_CHECK_EQUAL(pressures[i], sweep[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CoupledInflow)
+{
+    const std::vector<double> coefficients {0.0, 1.0e7, 2.0e7, 3.0e7};
+    Solver solver(makeNetwork(-1.0e-8), quadraticBranch(coefficients));
+    std::vector<double> pressures {20.0e5, 25.0e5, 25.0e5, 25.0e5};
+    BOOST_CHECK(solver.solve(pressures, 1.0e-3, 20));
+    BOOST_CHECK(solver.iterations() > 0);
+    BOOST_CHECK(solver.iterations() < 10);
+
+    std::vector<double> res;
+    solver.residual(pressures, res);
+    for (const double r : res) {
+        BOOST_CHECK(std::abs(r) < 1.0e-3);
+    }
+
+    // the pressure drop of the manifold is given by the rates of both leaves
+    const auto rates2 = solver.inflow(2, pressures[2]);
+    const auto rates3 = solver.inflow(3, pressures[3]);
+    BOOST_CHECK_CLOSE(rates2[1], 0.02 - 1.0e-8 * (pressures[2] - 30.0e5), 1.0e-10);
+    BOOST_CHECK_CLOSE(rates3[2], 0.04 - 2.0e-8 * (pressures[3] - 30.0e5), 1.0e-10);
+    double total = 0.0;
+    for (std::size_t p = 0; p < rates2.size(); ++p) {
+        total += rates2[p] + rates3[p];
+    }
+    BOOST_CHECK_CLOSE(pressures[1], 20.0e5 + 1.0e7 * total * total, 1.0e-6);
+}
+
+BOOST_AUTO_TEST_CASE(ClosedPhases)
+{
+    // the network pressure is high enough to stop the water and oil inflow of a leaf
+    const std::vector<double> coefficients {0.0, 1.0e8, 0.0, 0.0};
+    auto nodes = makeNetwork(-1.0e-8);
+    nodes[3].reference_pressure = 25.0e5;
+    nodes[3].inflow_derivative = {-1.0e-7, -1.0e-7, -1.0e-7};
+    Solver solver(nodes, quadraticBranch(coefficients));
+    std::vector<double> pressures {20.0e5, 20.0e5, 20.0e5, 20.0e5};
+    BOOST_CHECK(solver.solve(pressures, 1.0e-3, 50));
+
+    const auto rates = solver.inflow(3, pressures[3]);
+    BOOST_CHECK_EQUAL(rates[0], 0.0);
+    BOOST_CHECK_EQUAL(rates[1], 0.0);
+    BOOST_CHECK(rates[2] > 0.0);
+
+    std::vector<double> res;
+    solver.residual(pressures, res);
+    for (const double r : res) {
+        BOOST_CHECK(std::abs(r) < 1.0e-3);
+    }
+}
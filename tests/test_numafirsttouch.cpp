@@ -0,0 +1,89 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE NumaFirstTouchTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/NumaFirstTouch.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(ContentsAreKept)
+{
+    // several pages, with partial pages at both ends
+    std::vector<double> v(100001);
+    std::iota(v.begin(), v.end(), 0.5);
+    const auto expected = v;
+    Opm::firstTouch(v, true);
+    BOOST_CHECK(v == expected);
+
+    // released pages read as zeros
+    std::vector<double> zeros(100001, 0.0);
+    BOOST_CHECK(Opm::releasePages(zeros.data(), zeros.size() * sizeof(double), false));
+    BOOST_CHECK(std::all_of(zeros.begin(), zeros.end(), [](const double z) { return z == 0.0; }));
+
+    // too small for a whole page
+    std::vector<int> small{1, 2, 3};
+    BOOST_CHECK(!Opm::releasePages(small.data(), small.size() * sizeof(int), false));
+    Opm::firstTouch(small, true);
+    BOOST_CHECK(small == std::vector<int>({1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(MatrixAndVector)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 3, 3>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, 3>>;
+    const int n = 5000;
+    Matrix A(n, n, 3 * n, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int i = row.index();
+        if (i > 0) {
+            row.insert(i - 1);
+        }
+        row.insert(i);
+        if (i < n - 1) {
+            row.insert(i + 1);
+        }
+    }
+    Vector x(n);
+    for (int i = 0; i < n; ++i) {
+        for (auto col = A[i].begin(); col != A[i].end(); ++col) {
+            *col = 10.0 * i + col.index();
+        }
+        x[i] = i;
+    }
+
+    BOOST_CHECK(Opm::firstTouchMatrix(A, true));
+    Opm::firstTouchVector(x);
+    for (int i = 0; i < n; ++i) {
+        for (auto col = A[i].begin(); col != A[i].end(); ++col) {
+            BOOST_CHECK_EQUAL((*col)[2][1], 10.0 * i + col.index());
+        }
+        BOOST_CHECK_EQUAL(x[i][1], i);
+    }
+}
@@ -0,0 +1,196 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE OpenclSellMatrixTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/bda/opencl/OpenclSellMatrix.hpp>
+#include <opm/simulators/linalg/bda/opencl/openclKernels.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Opm::Accelerator::OpenclKernels;
+using Opm::Accelerator::OpenclSellMatrix;
+
+namespace {
+
+// BCSR pattern with rows of very different lengths, like the rows of wells and NNCs
+void buildPattern(int Nb, std::vector<int>& rows, std::vector<int>& cols)
+{
+    rows.assign(1, 0);
+    cols.clear();
+    for (int i = 0; i < Nb; ++i) {
+        const int length = (i % 7 == 3) ? 9 : 1 + i % 3;
+        for (int j = 0; j < length; ++j) {
+            cols.push_back((i + 5 * j) % Nb);
+        }
+        std::sort(cols.end() - length, cols.end());
+        cols.erase(std::unique(cols.end() - length, cols.end()), cols.end());
+        rows.push_back(cols.size());
+    }
+}
+
+// The first OpenCL device, if there is one
+struct OpenclDevice
+{
+    OpenclDevice()
+    {
+        try {
+            std::vector<cl::Platform> platforms;
+            cl::Platform::get(&platforms);
+            if (platforms.empty()) {
+                return;
+            }
+            platforms[0].getDevices(CL_DEVICE_TYPE_ALL, &devices);
+            if (devices.empty()) {
+                return;
+            }
+            devices.resize(1);
+            context = std::make_unique<cl::Context>(devices[0]);
+            queue = std::make_unique<cl::CommandQueue>(*context, devices[0]);
+            OpenclKernels::init(context.get(), queue.get(), devices, 0);
+        } catch (const std::exception& error) {
+            BOOST_WARN_MESSAGE(false, std::string("No OpenCL device: ") + error.what());
+            queue.reset();
+        }
+    }
+
+    std::vector<cl::Device> devices;
+    std::unique_ptr<cl::Context> context;
+    std::unique_ptr<cl::CommandQueue> queue;
+};
+
+template <class T>
+cl::Buffer upload(cl::Context& context, cl::CommandQueue& queue, const std::vector<T>& data)
+{
+    cl::Buffer buffer(context, CL_MEM_READ_WRITE, sizeof(T) * data.size());
+    queue.enqueueWriteBuffer(buffer, CL_TRUE, 0, sizeof(T) * data.size(), data.data());
+    return buffer;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(Layout)
+{
+    const int Nb = 50;
+    const int C = 4;
+    std::vector<int> rows, cols;
+    buildPattern(Nb, rows, cols);
+
+    const auto layout = OpenclSellMatrix::buildLayout(rows.data(), cols.data(), Nb, C, 8);
+    BOOST_CHECK_EQUAL(layout.num_slices, 13);
+    BOOST_CHECK_EQUAL(layout.rowIndices.size(), 13u * C);
+
+    // every row appears once, the padding rows are at the end
+    std::vector<int> seen(Nb, 0);
+    for (std::size_t k = 0; k < layout.rowIndices.size(); ++k) {
+        const int row = layout.rowIndices[k];
+        if (row < 0) {
+            BOOST_CHECK(k >= static_cast<std::size_t>(Nb));
+        } else {
+            ++seen[row];
+            // rows are only moved within their sorting window
+            BOOST_CHECK_EQUAL(row / 8, static_cast<int>(k) / 8);
+        }
+    }
+    BOOST_CHECK(std::all_of(seen.begin(), seen.end(), [](int s) { return s == 1; }));
+
+    // every block appears once, and the padding is not larger than the longest row of a slice
+    std::vector<int> blockSeen(cols.size(), 0);
+    for (std::size_t k = 0; k < layout.blockMap.size(); ++k) {
+        if (layout.blockMap[k] >= 0) {
+            ++blockSeen[layout.blockMap[k]];
+            BOOST_CHECK_EQUAL(layout.colIndices[k], cols[layout.blockMap[k]]);
+        } else {
+            BOOST_CHECK_EQUAL(layout.colIndices[k], -1);
+        }
+    }
+    BOOST_CHECK(std::all_of(blockSeen.begin(), blockSeen.end(), [](int s) { return s == 1; }));
+    for (int slice = 0; slice < layout.num_slices; ++slice) {
+        int width = 0;
+        for (int r = 0; r < C; ++r) {
+            const int row = layout.rowIndices[slice * C + r];
+            if (row >= 0) {
+                width = std::max(width, rows[row + 1] - rows[row]);
+            }
+        }
+        BOOST_CHECK_EQUAL(layout.slicePointers[slice + 1] - layout.slicePointers[slice], width * C);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Product)
+{
+    const int Nb = 37;
+    const int bs = 3;
+    std::vector<int> rows, cols;
+    buildPattern(Nb, rows, cols);
+
+    std::vector<double> vals(cols.size() * bs * bs);
+    for (std::size_t k = 0; k < vals.size(); ++k) {
+        vals[k] = 0.25 * (k % 17) - 1.0;
+    }
+    std::vector<double> x(Nb * bs);
+    for (int k = 0; k < Nb * bs; ++k) {
+        x[k] = 1.0 + 0.5 * (k % 5);
+    }
+
+    std::vector<double> expected(Nb * bs, 0.0);
+    for (int row = 0; row < Nb; ++row) {
+        for (int block = rows[row]; block < rows[row + 1]; ++block) {
+            for (int i = 0; i < bs; ++i) {
+                for (int c = 0; c < bs; ++c) {
+                    expected[row * bs + i] += vals[block * bs * bs + i * bs + c] * x[cols[block] * bs + c];
+                }
+            }
+        }
+    }
+
+    OpenclDevice device;
+    if (!device.queue) {
+        BOOST_WARN_MESSAGE(false, "Problem with initializing Platform. skipping test");
+        return;
+    }
+    auto& context = *device.context;
+    auto& queue = *device.queue;
+    cl::Buffer d_vals = upload(context, queue, vals);
+    cl::Buffer d_x = upload(context, queue, x);
+    cl::Buffer d_b(context, CL_MEM_READ_WRITE, sizeof(double) * Nb * bs);
+
+    for (const int C : {1, 4, 32}) {
+        for (const int sigma : {1, 16, 256}) {
+            OpenclSellMatrix sellMat(&context, &queue, rows.data(), cols.data(), Nb, bs, C, sigma);
+            sellMat.gather(d_vals);
+            OpenclKernels::spmv_sell(sellMat.nnzValues, sellMat.colIndices, sellMat.slicePointers,
+                                     sellMat.rowIndices, d_x, d_b, sellMat.num_slices,
+                                     sellMat.slice_height, bs);
+            std::vector<double> out(Nb * bs);
+            queue.enqueueReadBuffer(d_b, CL_TRUE, 0, sizeof(double) * out.size(), out.data());
+            for (int k = 0; k < Nb * bs; ++k) {
+                // the device may use fused multiply-adds
+                BOOST_CHECK_SMALL(out[k] - expected[k], 1e-12);
+            }
+        }
+    }
+}
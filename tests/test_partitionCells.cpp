@@ -0,0 +1,62 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE PartitionCellsTest
+
+#include <opm/simulators/flow/partitionCells.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(SimplePartition)
+{
+    const auto [partition, num_domains] = Opm::partitionCellsSimple(10, 3);
+    BOOST_CHECK_EQUAL(num_domains, 3);
+    const std::vector<int> expected {0, 0, 0, 0, 1, 1, 1, 2, 2, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(partition.begin(), partition.end(),
+                                  expected.begin(), expected.end());
+
+    const auto cells = Opm::domainCells(partition, num_domains);
+    BOOST_REQUIRE_EQUAL(cells.size(), 3U);
+    const std::vector<int> expected1 {4, 5, 6};
+    BOOST_CHECK_EQUAL_COLLECTIONS(cells[1].begin(), cells[1].end(),
+                                  expected1.begin(), expected1.end());
+}
+
+BOOST_AUTO_TEST_CASE(LimitedDomainCount)
+{
+    // at least one cell per subdomain
+    const auto [partition, num_domains] = Opm::partitionCellsSimple(2, 5);
+    BOOST_CHECK_EQUAL(num_domains, 2);
+    BOOST_CHECK_EQUAL(partition[0], 0);
+    BOOST_CHECK_EQUAL(partition[1], 1);
+
+    // at least one subdomain
+    const auto [single, num_single] = Opm::partitionCellsSimple(4, 0);
+    BOOST_CHECK_EQUAL(num_single, 1);
+    for (const int domain : single) {
+        BOOST_CHECK_EQUAL(domain, 0);
+    }
+
+    const auto [empty, num_empty] = Opm::partitionCellsSimple(0, 3);
+    BOOST_CHECK_EQUAL(num_empty, 0);
+    BOOST_CHECK(empty.empty());
+}
@@ -160,6 +160,25 @@ BOOST_AUTO_TEST_CASE(TestDefaultPreconditionerFactory)
 }
 
 
+BOOST_AUTO_TEST_CASE(TestRASPreconditioner)
+{
+    // Serially, RAS is its subdomain solver applied to the whole matrix.
+    Opm::PropertyTree prm;
+    prm.put("tol", 1e-12);
+    prm.put("maxiter", 200);
+    prm.put("verbosity", 0);
+    prm.put("preconditioner.type", std::string("RAS"));
+    prm.put("preconditioner.local_solver", std::string("ilu"));
+    prm.put("preconditioner.ilulevel", 1);
+
+    test1(prm);
+    test3(prm);
+
+    prm.put("preconditioner.local_solver", std::string("nonexisting"));
+    BOOST_CHECK_THROW(testPrec<3>(prm, "matr33.txt", "rhs3.txt"), std::invalid_argument);
+}
+
+
 template <int bz>
 using M = Dune::BCRSMatrix<Dune::FieldMatrix<double, bz, bz>>;
 template <int bz>
@@ -84,5 +84,11 @@ BOOST_AUTO_TEST_CASE(diagnosis)
     RelpermDiagnostics diagnostics;
     diagnostics.diagnosis(eclState, cartesianIndexMapper);
     BOOST_CHECK_EQUAL(1, counterLog->numMessages(Log::MessageType::Warning));
+
+    // the tables and the cells checked separately, as for the deferred checks
+    RelpermDiagnostics deferred;
+    BOOST_CHECK(deferred.tableDiagnosis(eclState));
+    deferred.cellDiagnosis(eclState, cartesianIndexMapper, /*threaded=*/false).logMessages();
+    BOOST_CHECK_EQUAL(2, counterLog->numMessages(Log::MessageType::Warning));
 }
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,72 @@
+/*
+  Copyright 2022 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE ResidualNormHistoryTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/flow/ResidualNormHistory.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(RingBuffer)
+{
+    Opm::ResidualNormHistory history;
+    BOOST_CHECK_EQUAL(history.size(), 0);
+
+    for (int it = 0; it < 5; ++it) {
+        history.push({1.0 * it, 10.0 * it});
+    }
+    BOOST_CHECK_EQUAL(history.size(), 5);
+    BOOST_CHECK_EQUAL(history.numNorms(), 2u);
+    for (int back = 0; back < Opm::ResidualNormHistory::capacity; ++back) {
+        BOOST_CHECK_EQUAL(history.norms(back)[0], 4.0 - back);
+        BOOST_CHECK_EQUAL(history.norms(back)[1], 40.0 - 10.0 * back);
+    }
+    const std::vector<double> expected = {0.0, 10.0, 20.0, 30.0, 40.0};
+    BOOST_CHECK_EQUAL_COLLECTIONS(history.maxNorms().begin(), history.maxNorms().end(),
+                                  expected.begin(), expected.end());
+
+    history.clear();
+    BOOST_CHECK_EQUAL(history.size(), 0);
+    history.push({2.0, 1.0, 3.0});
+    BOOST_CHECK_EQUAL(history.numNorms(), 3u);
+    BOOST_CHECK_EQUAL(history.norms()[2], 3.0);
+    BOOST_CHECK_EQUAL(history.maxNorms().back(), 3.0);
+}
+
+BOOST_AUTO_TEST_CASE(Divergence)
+{
+    Opm::ResidualNormHistory history;
+    history.push({1.0});
+    history.push({20.0});
+    BOOST_CHECK(!history.diverging(100.0));
+    history.push({200.0});
+    BOOST_CHECK(history.diverging(100.0));
+    BOOST_CHECK(!history.diverging(1000.0));
+
+    // not growing in every iteration
+    history.push({100.0});
+    BOOST_CHECK(!history.diverging(1.0));
+    history.push({1.0e5});
+    BOOST_CHECK(!history.diverging(1.0));
+    history.push({1.0e6});
+    BOOST_CHECK(history.diverging(1.0));
+}
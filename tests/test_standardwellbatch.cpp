@@ -0,0 +1,185 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE StandardWellBatchTest
+
+#include <opm/simulators/wells/StandardWellBatch.hpp>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+namespace {
+
+constexpr int numEq = 3;
+using Batch = Opm::StandardWellBatch<double, numEq>;
+using Vector = Batch::BVector;
+using WellMatrix = Dune::BCRSMatrix<Dune::DynamicMatrix<double>>;
+using WellVector = Dune::BlockVector<Dune::DynamicVector<double>>;
+
+// the matrices of one well, stored like in StandardWellGeneric
+struct TestWell
+{
+    WellMatrix B, C, invD;
+
+    TestWell(const std::vector<int>& cells, const int numCells, const int numWellEq, double& value)
+    {
+        for (WellMatrix* M : {&B, &C}) {
+            M->setBuildMode(WellMatrix::row_wise);
+            M->setSize(1, numCells, cells.size());
+            for (auto row = M->createbegin(); row != M->createend(); ++row) {
+                for (const int cell : cells) {
+                    row.insert(cell);
+                }
+            }
+            for (auto col = (*M)[0].begin(); col != (*M)[0].end(); ++col) {
+                col->resize(numWellEq, numEq);
+                for (int i = 0; i < numWellEq; ++i) {
+                    for (int j = 0; j < numEq; ++j) {
+                        value += 0.013;
+                        (*col)[i][j] = value * ((i + j) % 2 == 0 ? 1.0 : -1.0);
+                    }
+                }
+            }
+        }
+        invD.setBuildMode(WellMatrix::row_wise);
+        invD.setSize(1, 1, 1);
+        for (auto row = invD.createbegin(); row != invD.createend(); ++row) {
+            row.insert(0);
+        }
+        invD[0][0].resize(numWellEq, numWellEq);
+        for (int i = 0; i < numWellEq; ++i) {
+            for (int j = 0; j < numWellEq; ++j) {
+                value += 0.007;
+                invD[0][0][i][j] = (i == j ? 2.0 : 0.0) + value;
+            }
+        }
+    }
+
+    // y -= C^T D^-1 B x, as done by StandardWell::apply()
+    void apply(const Vector& x, Vector& y) const
+    {
+        const int numWellEq = invD[0][0].N();
+        WellVector Bx(1), invDBx(1);
+        Bx[0].resize(numWellEq);
+        invDBx[0].resize(numWellEq);
+        B.mv(x, Bx);
+        invD.mv(Bx, invDBx);
+        C.mmtv(invDBx, y);
+    }
+
+    void addTo(Batch& batch) const
+    {
+        const int numWellEq = invD[0][0].N();
+        auto storage = batch.addWell(B[0].size(), numWellEq);
+        for (auto col = B[0].begin(); col != B[0].end(); ++col) {
+            *storage.cells++ = col.index();
+            for (int i = 0; i < numWellEq; ++i) {
+                for (int j = 0; j < numEq; ++j) {
+                    *storage.B++ = (*col)[i][j];
+                }
+            }
+        }
+        for (auto col = C[0].begin(); col != C[0].end(); ++col) {
+            for (int i = 0; i < numWellEq; ++i) {
+                for (int j = 0; j < numEq; ++j) {
+                    *storage.C++ = (*col)[i][j];
+                }
+            }
+        }
+        for (int i = 0; i < numWellEq; ++i) {
+            for (int j = 0; j < numWellEq; ++j) {
+                *storage.invD++ = invD[0][0][i][j];
+            }
+        }
+    }
+};
+
+void testBatch(const std::vector<std::vector<int>>& wellCells, const std::vector<int>& numWellEqs, const int numCells)
+{
+    double value = 0.0;
+    std::vector<TestWell> wells;
+    for (std::size_t w = 0; w < wellCells.size(); ++w) {
+        wells.emplace_back(wellCells[w], numCells, numWellEqs[w], value);
+    }
+
+    Vector x(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        for (int j = 0; j < numEq; ++j) {
+            x[i][j] = 1.0 + 0.1 * i - 0.3 * j;
+        }
+    }
+
+    Vector yRef(numCells), y(numCells);
+    yRef = 1.0;
+    y = 1.0;
+    for (const auto& well : wells) {
+        well.apply(x, yRef);
+    }
+
+    Batch batch;
+    // fill the batch twice, the second time reuses the memory of the groups
+    for (int pass = 0; pass < 2; ++pass) {
+        batch.clear();
+        for (const auto& well : wells) {
+            well.addTo(batch);
+        }
+        batch.finalize();
+    }
+    BOOST_CHECK_EQUAL(batch.numWells(), static_cast<int>(wells.size()));
+    batch.apply(x, y);
+
+    for (int i = 0; i < numCells; ++i) {
+        for (int j = 0; j < numEq; ++j) {
+            BOOST_CHECK_CLOSE(y[i][j], yRef[i][j], 1e-10);
+        }
+    }
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(DisjointWells)
+{
+    // wells with different perforation counts and numbers of well equations
+    testBatch({{0, 1, 2}, {4, 5}, {7, 8, 9}, {11}}, {4, 4, 4, 3}, 12);
+}
+
+BOOST_AUTO_TEST_CASE(WellsSharingCells)
+{
+    testBatch({{0, 1, 2}, {2, 3, 4}, {0, 4, 6}}, {4, 4, 4}, 8);
+}
+
+BOOST_AUTO_TEST_CASE(ManyWells)
+{
+    // enough wells to let a group be split over threads
+    std::vector<std::vector<int>> cells;
+    std::vector<int> numWellEqs;
+    for (int w = 0; w < 200; ++w) {
+        cells.push_back({3 * w, 3 * w + 1, 3 * w + 2});
+        numWellEqs.push_back(4);
+    }
+    testBatch(cells, numWellEqs, 600);
+}
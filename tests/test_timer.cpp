@@ -28,6 +28,8 @@
 #include <opm/input/eclipse/Deck/Deck.hpp>
 #include <opm/input/eclipse/Parser/Parser.hpp>
 #include <opm/simulators/timestepping/SimulatorTimer.hpp>
+#include <opm/simulators/timestepping/AdaptiveSimulatorTimer.hpp>
+#include <opm/common/utility/parameters/ParameterGroup.hpp>
 #include <opm/input/eclipse/Units/Units.hpp>
 #include <opm/input/eclipse/Python/Python.hpp>
 #include <opm/input/eclipse/EclipseState/Grid/FieldPropsManager.hpp>
@@ -120,3 +122,35 @@ BOOST_AUTO_TEST_CASE(CreateTimer)
 
 
 }
+
+BOOST_AUTO_TEST_CASE(AdaptiveTimerSpreadsSteps)
+{
+    Opm::ParameterGroup param;
+    param.insertParameter("num_psteps", "1");
+    param.insertParameter("stepsize_days", "10");
+    Opm::SimulatorTimer simtimer;
+    simtimer.init(param);
+
+    // 4 day steps would leave a 2 day step at the end
+    {
+        Opm::AdaptiveSimulatorTimer timer(simtimer, 4 * Opm::unit::day);
+        int steps = 0;
+        while (!timer.done()) {
+            BOOST_CHECK_CLOSE(timer.currentStepLength(), 10.0 / 3.0 * Opm::unit::day, 1e-8);
+            ++timer;
+            timer.provideTimeStepEstimate(4 * Opm::unit::day);
+            ++steps;
+        }
+        BOOST_CHECK_EQUAL(steps, 3);
+    }
+
+    // the estimate may be exceeded by 5%, but not the max time step
+    {
+        Opm::AdaptiveSimulatorTimer timer(simtimer, 4.9 * Opm::unit::day);
+        BOOST_CHECK_CLOSE(timer.currentStepLength(), 5 * Opm::unit::day, 1e-8);
+    }
+    {
+        Opm::AdaptiveSimulatorTimer timer(simtimer, 4.9 * Opm::unit::day, 3 * Opm::unit::day);
+        BOOST_CHECK_CLOSE(timer.currentStepLength(), 2.5 * Opm::unit::day, 1e-8);
+    }
+}
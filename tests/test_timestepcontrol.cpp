@@ -0,0 +1,90 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE TimeStepControlTest
+
+#include <opm/simulators/timestepping/TimeStepControl.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+struct NoChange : public Opm::RelativeChangeInterface
+{
+    double relativeChange() const override
+    {
+        return 0.0;
+    }
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(ConvergenceRate)
+{
+    Opm::ConvergenceRateTimeStepControl control(4, 0.5, 2.0);
+    const NoChange change;
+    const double dt = 10.0;
+
+    // contraction factor 0.8 in 6 iterations, two more than the target
+    std::vector<double> residuals {1.0};
+    for (int it = 0; it < 6; ++it) {
+        residuals.push_back(0.8 * residuals.back());
+    }
+    control.setNonlinearResiduals(residuals);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(dt, 6, change, 0.0), dt * 0.64, 1.0e-10);
+
+    // contraction factor 0.8 in 2 iterations, two fewer than the target
+    control.setNonlinearResiduals({1.0, 0.8, 0.64});
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(dt, 2, change, 0.0), dt / 0.64, 1.0e-10);
+
+    // the change is limited by the decay and growth rates
+    control.setNonlinearResiduals({1.0, 0.1, 0.01});
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(dt, 2, change, 0.0), dt * 2.0, 1.0e-10);
+    control.setNonlinearResiduals({1.0, 1.5, 1.2, 1.1, 1.05, 1.01});
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(dt, 5, change, 0.0), dt * 0.5, 1.0e-10);
+}
+
+BOOST_AUTO_TEST_CASE(IterationCountFallback)
+{
+    Opm::ConvergenceRateTimeStepControl control(4, 0.5, 2.0);
+    const NoChange change;
+    const double dt = 10.0;
+
+    // without a residual history the iteration count decides
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(dt, 8, change, 0.0), dt * 0.5, 1.0e-10);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(dt, 1, change, 0.0), dt * 2.0, 1.0e-10);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(dt, 3, change, 0.0), dt, 1.0e-10);
+}
+
+BOOST_AUTO_TEST_CASE(FailedStep)
+{
+    Opm::ConvergenceRateTimeStepControl control(4, 0.5, 2.0);
+    const NoChange change;
+
+    // a step of 12 failed, the estimates stay below it until they outgrow it
+    control.timeStepFailed(12.0);
+    control.setNonlinearResiduals({1.0, 0.1, 0.01});
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(10.0, 2, change, 0.0), 12.0, 1.0e-10);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(12.0, 2, change, 0.0), 24.0, 1.0e-10);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(24.0, 2, change, 0.0), 48.0, 1.0e-10);
+}
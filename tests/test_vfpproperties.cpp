@@ -100,6 +100,24 @@ BOOST_AUTO_TEST_CASE(findInterpData)
     BOOST_CHECK_EQUAL(eval5.factor_, 1.0);
 }
 
+BOOST_AUTO_TEST_CASE(findInterpDataHint)
+{
+    std::vector<double> values = {1, 5, 7, 7, 9, 11, 15};
+    const int nvalues = values.size();
+
+    // any hint, valid or not, gives the same result as the search
+    for (const double value : {-1.0, 0.5, 1.0, 3.0, 5.0, 6.0, 7.0, 8.0, 9.0, 15.0, 19.0}) {
+        const Opm::detail::InterpData ref = Opm::detail::findInterpData(value, values);
+        for (int hint = -1; hint < nvalues; ++hint) {
+            const Opm::detail::InterpData eval = Opm::detail::findInterpData(value, values, hint);
+            BOOST_CHECK_EQUAL(eval.ind_[0], ref.ind_[0]);
+            BOOST_CHECK_EQUAL(eval.ind_[1], ref.ind_[1]);
+            BOOST_CHECK_EQUAL(eval.factor_, ref.factor_);
+            BOOST_CHECK_EQUAL(eval.inv_dist_, ref.inv_dist_);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // HelperTests
 
 
@@ -555,6 +573,50 @@ BOOST_AUTO_TEST_CASE(THPToBHPAndBackNonTrivial)
 
 
 
+/**
+ * Test that evaluations with a cache, and of several wells at once, give the
+ * same values as without a cache
+ */
+BOOST_AUTO_TEST_CASE(InterpolateCached)
+{
+    fillDataRandom();
+    initProperties();
+
+    Opm::VFPProdProperties::EvaluationCache cache;
+    std::vector<int> table_ids;
+    std::vector<double> aqua, liquid, vapour, thp, alq;
+    int n=4;
+    for (int i=0; i<n; ++i) {
+        // small steps, such that consecutive points are often in the same cell
+        const double x = -0.3 - 0.05 * i;
+        for (int j=0; j<n; ++j) {
+            const double y = -0.2 - 0.1 * j;
+            for (int k=0; k<n; ++k) {
+                const double z = 0.4 + 0.2 * k;
+                const double v = -0.1 - 0.02 * (i + j + k);
+                const double ref = properties->bhp(1, v, x, y, z, 0.5);
+                BOOST_CHECK_EQUAL(properties->bhp(1, v, x, y, z, 0.5, cache), ref);
+
+                table_ids.push_back(1);
+                aqua.push_back(v);
+                liquid.push_back(x);
+                vapour.push_back(y);
+                thp.push_back(z);
+                alq.push_back(0.5);
+            }
+        }
+    }
+
+    std::vector<Opm::VFPProdProperties::EvaluationCache> caches;
+    for (int pass = 0; pass < 2; ++pass) {
+        const auto bhps = properties->bhp(table_ids, aqua, liquid, vapour, thp, alq, caches);
+        BOOST_REQUIRE_EQUAL(bhps.size(), table_ids.size());
+        for (std::size_t w = 0; w < bhps.size(); ++w) {
+            BOOST_CHECK_EQUAL(bhps[w], properties->bhp(1, aqua[w], liquid[w], vapour[w], thp[w], alq[w]));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Trivial tests
 
 
@@ -0,0 +1,96 @@
+/*
+  Copyright 2022 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE WellHelpersTest
+
+#include <opm/simulators/wells/WellHelpers.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <optional>
+#include <set>
+#include <vector>
+
+using Opm::wellhelpers::bracketedNewton;
+
+BOOST_AUTO_TEST_CASE(LinearFunction)
+{
+    int evaluations = 0;
+    auto f = [&evaluations](const double x) { ++evaluations; return 3.0 * x - 1.5; };
+
+    // the secant point of the end points is the root of a linear function
+    const auto x = bracketedNewton(f, 0.0, 2.0, -1.5, 4.5, std::nullopt, 1e-12, 50);
+    BOOST_REQUIRE(x.has_value());
+    BOOST_CHECK_CLOSE(*x, 0.5, 1e-10);
+    BOOST_CHECK_EQUAL(evaluations, 1);
+}
+
+BOOST_AUTO_TEST_CASE(WarmStart)
+{
+    int evaluations = 0;
+    auto f = [&evaluations](const double x) { ++evaluations; return x * x * x - 2.0; };
+    const double root = std::cbrt(2.0);
+
+    const auto cold = bracketedNewton(f, 0.0, 4.0, -2.0, 62.0, std::nullopt, 1e-10, 50);
+    BOOST_REQUIRE(cold.has_value());
+    BOOST_CHECK_CLOSE(*cold, root, 1e-8);
+    const int cold_evaluations = evaluations;
+
+    evaluations = 0;
+    const auto warm = bracketedNewton(f, 0.0, 4.0, -2.0, 62.0, 1.26, 1e-10, 50);
+    BOOST_REQUIRE(warm.has_value());
+    BOOST_CHECK_CLOSE(*warm, root, 1e-8);
+    BOOST_CHECK_LT(evaluations, cold_evaluations);
+
+    // a guess outside the bracket is ignored
+    const auto outside = bracketedNewton(f, 0.0, 4.0, -2.0, 62.0, 10.0, 1e-10, 50);
+    BOOST_REQUIRE(outside.has_value());
+    BOOST_CHECK_CLOSE(*outside, root, 1e-8);
+}
+
+BOOST_AUTO_TEST_CASE(Failures)
+{
+    auto f = [](const double x) { return x * x * x - 2.0; };
+    // no sign change in the bracket
+    BOOST_CHECK(!bracketedNewton(f, 2.0, 4.0, 6.0, 62.0, std::nullopt, 1e-10, 50).has_value());
+
+    // a jump never reaches the tolerance
+    auto jump = [](const double x) { return x < 1.0 ? -1.0 : 1.0; };
+    BOOST_CHECK(!bracketedNewton(jump, 0.0, 4.0, -1.0, 1.0, std::nullopt, 1e-10, 50).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(WellNeighbors)
+{
+    using NeighborSet = std::set<unsigned>;
+    std::vector<NeighborSet> neighbors(6);
+    neighbors[2] = {1, 2, 3};
+    // unsorted and repeated cells, and two wells through cell 2
+    const std::vector<std::vector<int>> wells {{4, 0, 2, 0}, {5, 2}};
+    Opm::wellhelpers::addWellNeighbors(wells, neighbors);
+
+    const NeighborSet expected0 {0, 2, 4};
+    BOOST_CHECK(neighbors[0] == expected0);
+    const NeighborSet expected2 {0, 1, 2, 3, 4, 5};
+    BOOST_CHECK(neighbors[2] == expected2);
+    const NeighborSet expected5 {2, 5};
+    BOOST_CHECK(neighbors[5] == expected5);
+    BOOST_CHECK(neighbors[1].empty());
+}
@@ -40,6 +40,7 @@
 #include <opm/input/eclipse/Deck/Deck.hpp>
 #include <opm/input/eclipse/Parser/Parser.hpp>
 #include <opm/input/eclipse/Parser/ParseContext.hpp>
+#include <opm/input/eclipse/Schedule/Group/Group.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
 #include <opm/input/eclipse/Schedule/SummaryState.hpp>
 #include <opm/input/eclipse/Units/Units.hpp>
@@ -370,6 +371,57 @@ BOOST_AUTO_TEST_CASE(STOP_well)
     }
 }
 
+// ---------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(RestoreChangedWells)
+{
+    const Setup setup{ "msw.data" };
+
+    std::vector<Opm::ParallelWellInfo> pinfos;
+    auto wstate = buildWellState(setup, 0, pinfos);
+    BOOST_REQUIRE(wstate.size() >= 2);
+
+    // nothing is tracked before the first checkpoint, everything is copied
+    auto checkpoint = wstate;
+    wstate.well(0).bhp = 1.0;
+    wstate.restoreChangedWells(checkpoint);
+    BOOST_CHECK_EQUAL(wstate.well(0).bhp, checkpoint.well(0).bhp);
+
+    wstate.clearChangedWells();
+    wstate.well(0).bhp = 2.0;
+    wstate[wstate.name(1)].perf_data.pressure[0] = 3.0;
+    wstate.wellRates(1)[0] = 4.0;
+    wstate.restoreChangedWells(checkpoint);
+    BOOST_CHECK_EQUAL(wstate.well(0).bhp, checkpoint.well(0).bhp);
+    BOOST_CHECK_EQUAL(wstate.well(1).perf_data.pressure[0], checkpoint.well(1).perf_data.pressure[0]);
+    BOOST_CHECK_EQUAL(wstate.wellRates(1)[0], checkpoint.wellRates(1)[0]);
+}
+
+BOOST_AUTO_TEST_CASE(GroupWellIndices)
+{
+    const Setup setup{ "msw.data" };
+
+    std::vector<Opm::ParallelWellInfo> pinfos;
+    const auto wstate = buildWellState(setup, 0, pinfos);
+
+    const auto& group = setup.sched.getGroup("WELLS", 0);
+    std::vector<std::size_t> expected;
+    for (const auto& wname : group.wells()) {
+        const auto index = wstate.index(wname);
+        if (index.has_value())
+            expected.push_back(index.value());
+    }
+    BOOST_CHECK(!expected.empty());
+
+    const auto indices = wstate.groupWellIndices(group);
+    BOOST_CHECK_EQUAL_COLLECTIONS(indices.begin(), indices.end(),
+                                  expected.begin(), expected.end());
+
+    // FIELD only contains groups
+    const auto& field = setup.sched.getGroup("FIELD", 0);
+    BOOST_CHECK_EQUAL(wstate.groupWellIndices(field).size(), 0);
+}
+
 
 // ---------------------------------------------------------------------
 
@@ -572,6 +624,36 @@ BOOST_AUTO_TEST_CASE(TESTPerfData) {
 }
 
 
+BOOST_AUTO_TEST_CASE(TESTPerfDataCopy) {
+    Opm::PerfData pd1(3, 100, true, 2);
+    for (std::size_t i = 0; i < 3; i++) {
+        pd1.pressure[i] = i+1;
+        pd1.water_velocity[i] = 2*(i+1);
+        pd1.phase_rates[2*i + 1] = 3*(i+1);
+    }
+    BOOST_CHECK_EQUAL(pd1.phase_rates.size(), 6U);
+    BOOST_CHECK_EQUAL(pd1.water_velocity.size(), 3U);
+    BOOST_CHECK(Opm::PerfData(3, 100, false, 2).water_velocity.empty());
+
+    // the copy must have its own storage
+    Opm::PerfData pd2(pd1);
+    pd1.pressure[0] = -1;
+    BOOST_CHECK(pd2.pressure[0] == 1);
+    BOOST_CHECK(pd2.water_velocity[2] == 6);
+    BOOST_CHECK(pd2.phase_rates[5] == 9);
+
+    Opm::PerfData pd3(2, 100, false, 2);
+    pd3 = pd2;
+    BOOST_CHECK_EQUAL(pd3.size(), 3U);
+    pd2.water_velocity[1] = -1;
+    BOOST_CHECK(pd3.water_velocity[1] == 4);
+
+    Opm::PerfData pd4(std::move(pd3));
+    BOOST_CHECK_EQUAL(pd4.size(), 3U);
+    BOOST_CHECK(pd4.phase_rates[3] == 6);
+}
+
+
 BOOST_AUTO_TEST_CASE(TestSingleWellState) {
     Opm::ParallelWellInfo pinfo;
     std::vector<Opm::PerforationData> connections = {{0,1,1,0},{1,1,1,1},{2,1,1,2}};